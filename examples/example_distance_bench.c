@@ -0,0 +1,88 @@
+#include <glib.h>
+#include <numcosmo/numcosmo.h>
+
+/****************************************************************************
+ * Benchmark of the comoving distance table engines of NcDistance.
+ *
+ * Usage: example_distance_bench [zf] [nprep]
+ ****************************************************************************/
+
+static gdouble
+prepare_latency (NcDistance *dist, NcHICosmo *cosmo, const guint nprep)
+{
+  GTimer *timer = g_timer_new ();
+  gdouble elapsed;
+  guint i;
+
+  /* First preparation calibrates the quadrature node set. */
+  nc_distance_prepare (dist, cosmo);
+
+  g_timer_start (timer);
+  for (i = 0; i < nprep; i++)
+  {
+    ncm_model_orig_param_set (NCM_MODEL (cosmo), NC_HICOSMO_DE_XCDM_W, -1.0 - 0.2 * i / (1.0 * nprep));
+    nc_distance_prepare (dist, cosmo);
+  }
+  elapsed = g_timer_elapsed (timer, NULL);
+
+  g_timer_destroy (timer);
+
+  return elapsed / nprep;
+}
+
+gint
+main (gint argc, gchar *argv[])
+{
+  const gdouble zf  = (argc > 1) ? g_ascii_strtod (argv[1], NULL) : 10.0;
+  const guint nprep = (argc > 2) ? atoi (argv[2]) : 1000;
+  NcHICosmo *cosmo;
+  NcDistance *dist_ode, *dist_quad;
+
+  ncm_cfg_init ();
+
+  cosmo     = nc_hicosmo_new_from_name (NC_TYPE_HICOSMO, "NcHICosmoDEXcdm");
+  dist_ode  = nc_distance_new (zf);
+  dist_quad = nc_distance_new (zf);
+
+  nc_distance_set_table_engine (dist_quad, NC_DISTANCE_TABLE_ENGINE_QUAD);
+
+  /****************************************************************************
+   * Prepare latency of each engine.
+   ****************************************************************************/
+  {
+    const gdouble t_ode  = prepare_latency (dist_ode, cosmo, nprep);
+    const gdouble t_quad = prepare_latency (dist_quad, cosmo, nprep);
+
+    printf ("# zf = %g, %u preparations\n", zf, nprep);
+    printf ("# ODE  engine: % 12.5e s/prepare\n", t_ode);
+    printf ("# QUAD engine: % 12.5e s/prepare (%u intervals, reltol % 8.2e)\n",
+            t_quad, nc_distance_get_table_nintervals (dist_quad), nc_distance_get_table_reltol (dist_quad));
+    printf ("# Speed-up: %.2fx\n", t_ode / t_quad);
+  }
+
+  /****************************************************************************
+   * Maximum relative difference between the engines.
+   ****************************************************************************/
+  {
+    const guint N   = 10000;
+    gdouble max_rel = 0.0;
+    guint i;
+
+    for (i = 1; i < N; i++)
+    {
+      const gdouble z       = zf / (N - 1.0) * i;
+      const gdouble Dc_ode  = nc_distance_comoving (dist_ode, cosmo, z);
+      const gdouble Dc_quad = nc_distance_comoving (dist_quad, cosmo, z);
+
+      max_rel = GSL_MAX (max_rel, fabs (Dc_quad / Dc_ode - 1.0));
+    }
+
+    printf ("# Maximum relative difference: % 12.5e\n", max_rel);
+  }
+
+  nc_distance_free (dist_ode);
+  nc_distance_free (dist_quad);
+  nc_hicosmo_free (cosmo);
+
+  return 0;
+}
@@ -0,0 +1,125 @@
+#include <glib.h>
+#include <numcosmo/numcosmo.h>
+#include <time.h>
+
+/****************************************************************************
+ * Effective sample size per CPU-hour of NcmFitNested and NcmFitESMCMC
+ * using SNIa (Union 2.1) and BAO (Beutler 2011) to constrain the
+ * NcHICosmoDEXcdm parameters Omega_c, Omega_x and w.
+ *
+ * Usage: example_nested_bench [nlive] [nreplace] [nthreads] [nsteps]
+ ****************************************************************************/
+
+static gdouble
+cpu_time (void)
+{
+  return clock () * 1.0 / CLOCKS_PER_SEC;
+}
+
+gint
+main (gint argc, gchar *argv[])
+{
+  const guint nlive    = (argc > 1) ? atoi (argv[1]) : 400;
+  const guint nreplace = (argc > 2) ? atoi (argv[2]) : 1;
+  const guint nthreads = (argc > 3) ? atoi (argv[3]) : 0;
+  const guint nsteps   = (argc > 4) ? atoi (argv[4]) : 1000;
+  NcHICosmo *cosmo;
+  NcDistance *dist;
+  NcmMSet *mset;
+  NcmDataset *dset;
+  NcmLikelihood *lh;
+  NcmFit *fit;
+  NcmMSetTransKern *prior;
+
+  ncm_cfg_init ();
+
+  cosmo = nc_hicosmo_new_from_name (NC_TYPE_HICOSMO, "NcHICosmoDEXcdm");
+  dist  = nc_distance_new (2.5);
+  mset  = ncm_mset_new (cosmo, NULL);
+  dset  = ncm_dataset_new ();
+
+  ncm_model_param_set_ftype (NCM_MODEL (cosmo), NC_HICOSMO_DE_OMEGA_C, NCM_PARAM_TYPE_FREE);
+  ncm_model_param_set_ftype (NCM_MODEL (cosmo), NC_HICOSMO_DE_OMEGA_X, NCM_PARAM_TYPE_FREE);
+  ncm_model_param_set_ftype (NCM_MODEL (cosmo), NC_HICOSMO_DE_XCDM_W,  NCM_PARAM_TYPE_FREE);
+
+  {
+    NcmData *snia = NCM_DATA (nc_data_dist_mu_new_from_id (dist, NC_DATA_SNIA_SIMPLE_UNION2_1));
+    NcmData *bao  = nc_data_bao_create (dist, NC_DATA_BAO_RDV_BEUTLER2011);
+
+    ncm_dataset_append_data (dset, snia);
+    ncm_dataset_append_data (dset, bao);
+
+    ncm_data_free (snia);
+    ncm_data_free (bao);
+  }
+
+  lh  = ncm_likelihood_new (dset);
+  fit = ncm_fit_new (NCM_FIT_TYPE_NLOPT, "ln-neldermead", lh, mset, NCM_FIT_GRAD_NUMDIFF_FORWARD);
+
+  prior = NCM_MSET_TRANS_KERN (ncm_mset_trans_kern_flat_new ());
+  ncm_mset_trans_kern_set_mset (prior, mset);
+  ncm_mset_trans_kern_set_prior_from_mset (prior);
+
+  if (nthreads > 0)
+    ncm_func_eval_set_max_threads (nthreads);
+
+  /****************************************************************************
+   * Nested sampling.
+   ****************************************************************************/
+  {
+    NcmFitNested *nested = ncm_fit_nested_new (fit, prior, nlive, NCM_FIT_RUN_MSGS_SIMPLE);
+    const gdouble t0     = cpu_time ();
+    gdouble lnZ, lnZ_err, dt;
+
+    ncm_fit_nested_set_nreplace (nested, nreplace);
+    ncm_fit_nested_set_nthreads (nested, nthreads);
+
+    ncm_fit_nested_start_run (nested);
+    ncm_fit_nested_run (nested);
+    ncm_fit_nested_end_run (nested);
+
+    dt = cpu_time () - t0;
+    ncm_fit_nested_get_evidence (nested, &lnZ, &lnZ_err);
+
+    printf ("# NcmFitNested: lnZ = % 12.5g +/- % 8.2e, %lu evaluations, ESS % 12.5g, % 12.5g ESS/CPU-hour\n",
+            lnZ, lnZ_err, ncm_fit_nested_get_neval (nested), ncm_fit_nested_get_ess (nested),
+            ncm_fit_nested_get_ess (nested) / dt * 3600.0);
+
+    ncm_fit_nested_free (nested);
+  }
+
+  /****************************************************************************
+   * Ensemble sampler with the same prior for the initial points.
+   ****************************************************************************/
+  {
+    NcmFitESMCMCWalker *walker = NCM_FIT_ESMCMC_WALKER (ncm_fit_esmcmc_walker_stretch_new (nlive / 4, ncm_mset_fparams_len (mset)));
+    NcmFitESMCMC *esmcmc       = ncm_fit_esmcmc_new (fit, nlive / 4, prior, walker, NCM_FIT_RUN_MSGS_SIMPLE);
+    const gdouble t0           = cpu_time ();
+    gdouble max_ess, dt;
+
+    ncm_fit_esmcmc_set_nthreads (esmcmc, nthreads);
+
+    ncm_fit_esmcmc_start_run (esmcmc);
+    ncm_fit_esmcmc_run (esmcmc, nsteps);
+    ncm_fit_esmcmc_end_run (esmcmc);
+
+    dt = cpu_time () - t0;
+    ncm_mset_catalog_calc_max_ess_time (esmcmc->mcat, 100, &max_ess, NCM_FIT_RUN_MSGS_NONE);
+
+    printf ("# NcmFitESMCMC: %u evaluations, ESS % 12.5g, % 12.5g ESS/CPU-hour\n",
+            ncm_mset_catalog_len (esmcmc->mcat), max_ess, max_ess / dt * 3600.0);
+
+    ncm_fit_esmcmc_free (esmcmc);
+    ncm_fit_esmcmc_walker_free (walker);
+  }
+
+  ncm_mset_trans_kern_free (prior);
+  ncm_fit_free (fit);
+  ncm_likelihood_free (lh);
+  ncm_dataset_free (dset);
+  ncm_mset_free (mset);
+  nc_distance_free (dist);
+  nc_hicosmo_free (cosmo);
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <numcosmo/numcosmo.h>
+
+/****************************************************************************
+ * Start-up latency of loading a large serialized object using the text,
+ * raw binary and mapped formats of NcmSerialize.
+ *
+ * Usage: example_serialize_bench [n] [nload]
+ ****************************************************************************/
+
+typedef GObject *(*LoadFunc) (NcmSerialize *ser, const gchar *filename);
+
+static gdouble
+load_latency (NcmSerialize *ser, LoadFunc load, const gchar *filename, const guint nload)
+{
+  GTimer *timer = g_timer_new ();
+  gdouble elapsed;
+  guint i;
+
+  g_timer_start (timer);
+  for (i = 0; i < nload; i++)
+  {
+    GObject *obj = load (ser, filename);
+
+    ncm_serialize_reset (ser, TRUE);
+    g_object_unref (obj);
+  }
+  elapsed = g_timer_elapsed (timer, NULL);
+
+  g_timer_destroy (timer);
+
+  return elapsed / nload;
+}
+
+gint
+main (gint argc, gchar *argv[])
+{
+  const guint n     = (argc > 1) ? atoi (argv[1]) : 1000;
+  const guint nload = (argc > 2) ? atoi (argv[2]) : 10;
+  NcmSerialize *ser;
+  NcmMatrix *m;
+  NcmRNG *rng;
+  guint i, j;
+
+  ncm_cfg_init ();
+
+  ser = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+  rng = ncm_rng_seeded_new (NULL, 123);
+  m   = ncm_matrix_new (n, n);
+
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++)
+      ncm_matrix_set (m, i, j, ncm_rng_uniform_gen (rng, -1.0, 1.0));
+
+  ncm_serialize_to_file (ser, G_OBJECT (m), "serialize_bench.obj");
+  ncm_serialize_reset (ser, TRUE);
+  ncm_serialize_to_binfile (ser, G_OBJECT (m), "serialize_bench.bin");
+  ncm_serialize_reset (ser, TRUE);
+  ncm_serialize_to_mapped_file (ser, G_OBJECT (m), "serialize_bench.map");
+  ncm_serialize_reset (ser, TRUE);
+
+  /****************************************************************************
+   * Loading latency of each format.
+   ****************************************************************************/
+  {
+    const gdouble t_text   = load_latency (ser, &ncm_serialize_from_file, "serialize_bench.obj", nload);
+    const gdouble t_bin    = load_latency (ser, &ncm_serialize_from_binfile, "serialize_bench.bin", nload);
+    const gdouble t_mapped = load_latency (ser, &ncm_serialize_from_mapped_file, "serialize_bench.map", nload);
+
+    printf ("# %u x %u matrix, %u loads\n", n, n, nload);
+    printf ("# Text   format: % 12.5e s/load\n", t_text);
+    printf ("# Binary format: % 12.5e s/load\n", t_bin);
+    printf ("# Mapped format: % 12.5e s/load\n", t_mapped);
+    printf ("# Speed-up (mapped/text): %.2fx, (mapped/binary): %.2fx\n", t_text / t_mapped, t_bin / t_mapped);
+  }
+
+  /****************************************************************************
+   * The mapped object must reproduce the original values.
+   ****************************************************************************/
+  {
+    NcmMatrix *m_mapped = NCM_MATRIX (ncm_serialize_from_mapped_file (ser, "serialize_bench.map"));
+    gdouble max_diff    = 0.0;
+
+    for (i = 0; i < n; i++)
+      for (j = 0; j < n; j++)
+        max_diff = GSL_MAX (max_diff, fabs (ncm_matrix_get (m_mapped, i, j) - ncm_matrix_get (m, i, j)));
+
+    printf ("# Maximum difference: % 12.5e\n", max_diff);
+    ncm_matrix_free (m_mapped);
+  }
+
+  g_unlink ("serialize_bench.obj");
+  g_unlink ("serialize_bench.bin");
+  g_unlink ("serialize_bench.map");
+
+  ncm_matrix_free (m);
+  ncm_rng_free (rng);
+  ncm_serialize_free (ser);
+
+  return 0;
+}
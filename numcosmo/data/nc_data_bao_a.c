@@ -197,6 +197,9 @@ nc_data_bao_a_new_from_file (const gchar *filename)
   NcDataBaoA *bao_a = NC_DATA_BAO_A (ncm_serialize_global_from_file (filename));
   g_assert (NC_IS_DATA_BAO_A (bao_a));
 
+  ncm_data_gauss_diag_set_readonly (NCM_DATA_GAUSS_DIAG (bao_a));
+  ncm_vector_set_readonly (bao_a->x, TRUE);
+
   return bao_a;
 }
 
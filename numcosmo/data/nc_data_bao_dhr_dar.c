@@ -219,6 +219,10 @@ nc_data_bao_dhr_dar_new_from_file (const gchar *filename)
 {
   NcDataBaoDHrDAr *dhda = NC_DATA_BAO_DHR_DAR (ncm_serialize_global_from_file (filename));
   g_assert (NC_IS_DATA_BAO_DHR_DAR (dhda));
+
+  ncm_data_gauss_cov_set_readonly (NCM_DATA_GAUSS_COV (dhda));
+  ncm_vector_set_readonly (dhda->x, TRUE);
+
   return dhda;
 }
 
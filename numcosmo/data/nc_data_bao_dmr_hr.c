@@ -236,6 +236,10 @@ nc_data_bao_dmr_hr_new_from_file (const gchar *filename)
 {
   NcDataBaoDMrHr *dmh = NC_DATA_BAO_DMR_HR (ncm_serialize_global_from_file (filename));
   g_assert (NC_IS_DATA_BAO_DMR_HR (dmh));
+
+  ncm_data_gauss_cov_set_readonly (NCM_DATA_GAUSS_COV (dmh));
+  ncm_vector_set_readonly (dmh->x, TRUE);
+
   return dmh;
 }
 
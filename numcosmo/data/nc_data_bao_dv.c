@@ -207,6 +207,9 @@ nc_data_bao_dv_new_from_file (const gchar *filename)
   NcDataBaoDV *bao_dv = NC_DATA_BAO_DV (ncm_serialize_global_from_file (filename));
   g_assert (NC_IS_DATA_BAO_DV (bao_dv));
 
+  ncm_data_gauss_diag_set_readonly (NCM_DATA_GAUSS_DIAG (bao_dv));
+  ncm_vector_set_readonly (bao_dv->x, TRUE);
+
   return bao_dv;
 }
 
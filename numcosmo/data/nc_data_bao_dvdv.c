@@ -175,6 +175,8 @@ nc_data_bao_dvdv_new_from_file (const gchar *filename)
   NcDataBaoDVDV *bao_dvdv = NC_DATA_BAO_DVDV (ncm_serialize_global_from_file (filename));
   g_assert (NC_IS_DATA_BAO_DVDV (bao_dvdv));
 
+  ncm_data_gauss_diag_set_readonly (NCM_DATA_GAUSS_DIAG (bao_dvdv));
+
   return bao_dvdv;
 }
 
@@ -248,6 +248,9 @@ nc_data_bao_rdv_new_from_file (const gchar *filename)
   NcDataBaoRDV *bao_rdv = NC_DATA_BAO_RDV (ncm_serialize_global_from_file (filename));
   g_assert (NC_IS_DATA_BAO_RDV (bao_rdv));
 
+  ncm_data_gauss_set_readonly (NCM_DATA_GAUSS (bao_rdv));
+  ncm_vector_set_readonly (bao_rdv->x, TRUE);
+
   return bao_rdv;
 }
 
@@ -666,6 +666,31 @@ nc_data_cluster_ncount_set_z_true (NcDataClusterNCount *ncount, const NcmVector
   }
 }
 
+/*
+ * Read-only matrices (see ncm_matrix_set_readonly()) are kept by reference,
+ * hence the copies made by ncm_fit_clone() share the catalog.
+ */
+static void
+_nc_data_cluster_ncount_set_obs_matrix (NcmMatrix **obs, const NcmMatrix *m)
+{
+  if (ncm_matrix_is_readonly (m))
+  {
+    NcmMatrix *m_ref = ncm_matrix_ref ((NcmMatrix *) m);
+    
+    ncm_matrix_clear (obs);
+    *obs = m_ref;
+  }
+  else if ((*obs != NULL) && !ncm_matrix_is_readonly (*obs))
+  {
+    ncm_matrix_memcpy (*obs, m);
+  }
+  else
+  {
+    ncm_matrix_clear (obs);
+    *obs = ncm_matrix_dup (m);
+  }
+}
+
 /**
  * nc_data_cluster_ncount_set_lnM_obs:
  * @ncount: a #NcDataClusterNCount
@@ -682,11 +707,6 @@ nc_data_cluster_ncount_set_lnM_obs (NcDataClusterNCount *ncount, const NcmMatrix
     if (ncm_matrix_nrows (m) != ncount->np)
       g_error ("nc_data_cluster_ncount_set_lnM_obs: incompatible matrix, the data has %u clusters and the matrix has %u rows.",
                ncount->np, ncm_matrix_nrows (m));
-    if (ncount->lnM_obs != NULL)
-    {
-      ncm_matrix_memcpy (ncount->lnM_obs, m);
-      return;
-    }
   }
   else
     ncount->np = ncm_matrix_nrows (m);
@@ -694,7 +714,7 @@ nc_data_cluster_ncount_set_lnM_obs (NcDataClusterNCount *ncount, const NcmMatrix
   if (ncount->n_M_obs != ncm_matrix_ncols (m))
     g_error ("nc_data_cluster_ncount_set_lnM_obs: incompatible matrix, NcmClusterMass object has %u points per observation and the matrix has %u cols.",
              ncount->n_M_obs, ncm_matrix_ncols (m));
-  ncount->lnM_obs = ncm_matrix_dup (m);
+  _nc_data_cluster_ncount_set_obs_matrix (&ncount->lnM_obs, m);
 }
 
 /**
@@ -713,11 +733,6 @@ nc_data_cluster_ncount_set_lnM_obs_params (NcDataClusterNCount *ncount, const Nc
     if (ncm_matrix_nrows (m) != ncount->np)
       g_error ("nc_data_cluster_ncount_set_lnM_obs_params: incompatible matrix, the data has %u clusters and the matrix has %u rows.",
                ncount->np, ncm_matrix_nrows (m));
-    if (ncount->lnM_obs_params != NULL)
-    {
-      ncm_matrix_memcpy (ncount->lnM_obs_params, m);
-      return;
-    }
   }
   else
     ncount->np = ncm_matrix_nrows (m);
@@ -725,7 +740,7 @@ nc_data_cluster_ncount_set_lnM_obs_params (NcDataClusterNCount *ncount, const Nc
   if (ncount->n_M_obs != ncm_matrix_ncols (m))
     g_error ("nc_data_cluster_ncount_set_lnM_obs_params: incompatible matrix, NcmClusterMass object has %u parameters per observation and the matrix has %u cols.",
              ncount->n_M_obs_params, ncm_matrix_ncols (m));
-  ncount->lnM_obs_params = ncm_matrix_dup (m);
+  _nc_data_cluster_ncount_set_obs_matrix (&ncount->lnM_obs_params, m);
 }
 
 /**
@@ -744,11 +759,6 @@ nc_data_cluster_ncount_set_z_obs (NcDataClusterNCount *ncount, const NcmMatrix *
     if (ncm_matrix_nrows (m) != ncount->np)
       g_error ("nc_data_cluster_ncount_set_z_obs: incompatible matrix, the data has %u clusters and the matrix has %u rows.",
                ncount->np, ncm_matrix_nrows (m));
-    if (ncount->z_obs != NULL)
-    {
-      ncm_matrix_memcpy (ncount->z_obs, m);
-      return;
-    }
   }
   else
     ncount->np = ncm_matrix_nrows (m);
@@ -756,7 +766,7 @@ nc_data_cluster_ncount_set_z_obs (NcDataClusterNCount *ncount, const NcmMatrix *
   if (ncount->n_z_obs != ncm_matrix_ncols (m))
     g_error ("nc_data_cluster_ncount_set_z_obs: incompatible matrix, NcmClusterRedshift object has %u points per observation and the matrix has %u cols.",
              ncount->n_z_obs, ncm_matrix_ncols (m));
-  ncount->z_obs = ncm_matrix_dup (m);
+  _nc_data_cluster_ncount_set_obs_matrix (&ncount->z_obs, m);
 }
 
 /**
@@ -775,11 +785,6 @@ nc_data_cluster_ncount_set_z_obs_params (NcDataClusterNCount *ncount, const NcmM
     if (ncm_matrix_nrows (m) != ncount->np)
       g_error ("nc_data_cluster_ncount_set_z_obs_params: incompatible matrix, the data has %u clusters and the matrix has %u rows.",
                ncount->np, ncm_matrix_nrows (m));
-    if (ncount->z_obs_params != NULL)
-    {
-      ncm_matrix_memcpy (ncount->z_obs_params, m);
-      return;
-    }
   }
   else
     ncount->np = ncm_matrix_nrows (m);
@@ -787,7 +792,7 @@ nc_data_cluster_ncount_set_z_obs_params (NcDataClusterNCount *ncount, const NcmM
   if (ncount->n_z_obs_params != ncm_matrix_ncols (m))
     g_error ("nc_data_cluster_ncount_set_lnM_obs: incompatible matrix, NcmClusterRedshift object has %u parameters per observation and the matrix has %u cols.",
              ncount->n_z_obs_params, ncm_matrix_ncols (m));
-  ncount->z_obs_params = ncm_matrix_dup (m);
+  _nc_data_cluster_ncount_set_obs_matrix (&ncount->z_obs_params, m);
 }
 
 /**
@@ -1936,7 +1941,9 @@ nc_data_cluster_ncount_catalog_save (NcDataClusterNCount *ncount, gchar *filenam
  * @ncount: a #NcDataClusterNCount.
  * @filename: name of the file
  *
- * FIXME
+ * Loads the cluster catalog from the fits file @filename. The observables
+ * and their parameters are marked read-only, they are shared by the copies
+ * made with ncm_fit_clone() and replaced, not modified, by a resample.
  *
  */
 void
@@ -2000,9 +2007,11 @@ nc_data_cluster_ncount_catalog_load (NcDataClusterNCount *ncount, gchar *filenam
 
     fits_read_col (fptr, TDOUBLE, z_obs_i, 1, 1, ncount->np * z_obs_rp, NULL, ncm_matrix_ptr (ncount->z_obs, 0, 0), NULL, &status);
     NCM_FITS_ERROR (status);
+    ncm_matrix_set_readonly (ncount->z_obs, TRUE);
 
     fits_read_col (fptr, TDOUBLE, lnM_obs_i, 1, 1, ncount->np * lnM_obs_rp, NULL, ncm_matrix_ptr (ncount->lnM_obs, 0, 0), NULL, &status);
     NCM_FITS_ERROR (status);
+    ncm_matrix_set_readonly (ncount->lnM_obs, TRUE);
   }
 
   {
@@ -2027,6 +2036,7 @@ nc_data_cluster_ncount_catalog_load (NcDataClusterNCount *ncount, gchar *filenam
 
       fits_read_col (fptr, TDOUBLE, z_obs_params_i, 1, 1, ncount->np * z_obs_params_rp, NULL, ncm_matrix_ptr (ncount->z_obs_params, 0, 0), NULL, &status);
       NCM_FITS_ERROR (status);
+      ncm_matrix_set_readonly (ncount->z_obs_params, TRUE);
     }
 
     if (fits_get_colnum (fptr, CASESEN, "LNM_OBS_PARAMS", &lnM_obs_params_i, &status))
@@ -2045,6 +2055,7 @@ nc_data_cluster_ncount_catalog_load (NcDataClusterNCount *ncount, gchar *filenam
 
       fits_read_col (fptr, TDOUBLE, lnM_obs_params_i, 1, 1, ncount->np * lnM_obs_params_rp, NULL, ncm_matrix_ptr (ncount->lnM_obs_params, 0, 0), NULL, &status);
       NCM_FITS_ERROR (status);
+      ncm_matrix_set_readonly (ncount->lnM_obs_params, TRUE);
     }
   }
 
@@ -196,6 +196,8 @@ nc_data_cmb_dist_priors_new_from_file (const gchar *filename)
   NcDataCMBDistPriors *cmb_dist_priors = NC_DATA_CMB_DIST_PRIORS (ncm_serialize_global_from_file (filename));
   g_assert (NC_IS_DATA_CMB_DIST_PRIORS (cmb_dist_priors));
 
+  ncm_data_gauss_set_readonly (NCM_DATA_GAUSS (cmb_dist_priors));
+
   return cmb_dist_priors;
 }
 
@@ -221,6 +221,9 @@ nc_data_cmb_shift_param_new_from_file (const gchar *filename)
   NcDataCMBShiftParam *cmb_shift_param = NC_DATA_CMB_SHIFT_PARAM (ncm_serialize_global_from_file (filename));
   g_assert (NC_IS_DATA_CMB_SHIFT_PARAM (cmb_shift_param));
 
+  ncm_data_gauss_diag_set_readonly (NCM_DATA_GAUSS_DIAG (cmb_shift_param));
+  ncm_vector_set_readonly (cmb_shift_param->x, TRUE);
+
   return cmb_shift_param;
 }
 
@@ -55,8 +55,9 @@ G_DEFINE_TYPE (NcDataDistMu, nc_data_dist_mu, NCM_TYPE_DATA_GAUSS_DIAG);
 static void
 nc_data_dist_mu_init (NcDataDistMu *dist_mu)
 {
-  dist_mu->x    = NULL;
-  dist_mu->dist = NULL;
+  dist_mu->x       = NULL;
+  dist_mu->x_order = NULL;
+  dist_mu->dist    = NULL;
 }
 
 static void
@@ -79,6 +80,7 @@ nc_data_dist_mu_set_property (GObject *object, guint prop_id, const GValue *valu
       break;
     case PROP_Z:
       ncm_vector_substitute (&dist_mu->x, g_value_get_object (value), TRUE);
+      g_clear_pointer (&dist_mu->x_order, g_array_unref);
       break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -113,6 +115,7 @@ nc_data_dist_mu_dispose (GObject *object)
 
   ncm_vector_clear (&dist_mu->x);
   nc_distance_clear (&dist_mu->dist);
+  g_clear_pointer (&dist_mu->x_order, g_array_unref);
   
   /* Chain up : end */
   G_OBJECT_CLASS (nc_data_dist_mu_parent_class)->dispose (object);
@@ -126,6 +129,7 @@ nc_data_dist_mu_finalize (GObject *object)
   G_OBJECT_CLASS (nc_data_dist_mu_parent_class)->finalize (object);
 }
 
+static void _nc_data_dist_mu_begin (NcmData *data);
 static void _nc_data_dist_mu_prepare (NcmData *data, NcmMSet *mset);
 static void _nc_data_dist_mu_mean_func (NcmDataGaussDiag *diag, NcmMSet *mset, NcmVector *vp);
 static void _nc_data_dist_mu_set_size (NcmDataGaussDiag *diag, guint np);
@@ -159,11 +163,23 @@ nc_data_dist_mu_class_init (NcDataDistMuClass *klass)
                                                         G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
   
 
+  data_class->begin     = &_nc_data_dist_mu_begin;
   data_class->prepare   = &_nc_data_dist_mu_prepare;
   diag_class->mean_func = &_nc_data_dist_mu_mean_func;
   diag_class->set_size  = &_nc_data_dist_mu_set_size;
 }
 
+static void
+_nc_data_dist_mu_begin (NcmData *data)
+{
+  NcDataDistMu *dist_mu = NC_DATA_DIST_MU (data);
+
+  /* The redshifts are fixed after loading, the sorting permutation is computed once. */
+  g_clear_pointer (&dist_mu->x_order, g_array_unref);
+  if (dist_mu->x != NULL)
+    dist_mu->x_order = ncm_vector_get_sort_index (dist_mu->x);
+}
+
 static void
 _nc_data_dist_mu_prepare (NcmData *data, NcmMSet *mset)
 {
@@ -177,14 +193,8 @@ _nc_data_dist_mu_mean_func (NcmDataGaussDiag *diag, NcmMSet *mset, NcmVector *vp
 {
   NcDataDistMu *dist_mu = NC_DATA_DIST_MU (diag);
   NcHICosmo *cosmo = NC_HICOSMO (ncm_mset_peek (mset, nc_hicosmo_id ()));
-  guint i;
 
-  for (i = 0; i < diag->np; i++)
-  {
-    const gdouble z   = ncm_vector_get (dist_mu->x, i);
-    const gdouble dmu = nc_distance_dmodulus (dist_mu->dist, cosmo, z);
-    ncm_vector_set (vp, i, dmu);
-  }
+  nc_distance_dmodulus_vec (dist_mu->dist, cosmo, dist_mu->x, dist_mu->x_order, vp);
 }
 
 static void 
@@ -193,7 +203,10 @@ _nc_data_dist_mu_set_size (NcmDataGaussDiag *diag, guint np)
   NcDataDistMu *dist_mu = NC_DATA_DIST_MU (diag);
 
   if ((np == 0) || (np != diag->np))
+  {
     ncm_vector_clear (&dist_mu->x);
+    g_clear_pointer (&dist_mu->x_order, g_array_unref);
+  }
 
   if ((np != 0) && (np != diag->np))
     dist_mu->x = ncm_vector_new (np);
@@ -234,6 +247,9 @@ nc_data_dist_mu_new_from_file (const gchar *filename)
   NcDataDistMu *dist_mu = NC_DATA_DIST_MU (ncm_serialize_global_from_file (filename));
   g_assert (NC_IS_DATA_DIST_MU (dist_mu));
 
+  ncm_data_gauss_diag_set_readonly (NCM_DATA_GAUSS_DIAG (dist_mu));
+  ncm_vector_set_readonly (dist_mu->x, TRUE);
+
   return dist_mu;
 }
 
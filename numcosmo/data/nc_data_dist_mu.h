@@ -57,6 +57,7 @@ struct _NcDataDistMu
   NcmDataGaussDiag parent_instance;
   NcDistance *dist;
   NcmVector *x;
+  GArray *x_order;
 };
 
 GType nc_data_dist_mu_get_type (void) G_GNUC_CONST;
@@ -217,6 +217,9 @@ nc_data_hubble_new_from_file (const gchar *filename)
   NcDataHubble *hubble = NC_DATA_HUBBLE (ncm_serialize_global_from_file (filename));
   g_assert (NC_IS_DATA_HUBBLE (hubble));
 
+  ncm_data_gauss_diag_set_readonly (NCM_DATA_GAUSS_DIAG (hubble));
+  ncm_vector_set_readonly (hubble->x, TRUE);
+
   return hubble;
 }
 
@@ -84,6 +84,7 @@ nc_data_snia_cov_init (NcDataSNIACov *snia_cov)
   
   snia_cov->z_cmb             = NULL;
   snia_cov->z_he              = NULL;
+  snia_cov->z_cmb_order       = NULL;
 
   snia_cov->mag               = NULL;
   snia_cov->width             = NULL;
@@ -98,6 +99,7 @@ nc_data_snia_cov_init (NcDataSNIACov *snia_cov)
   snia_cov->sigma_thirdpar    = NULL;
 
   snia_cov->cov_full          = NULL;
+  snia_cov->cov_full_ro       = NULL;
   snia_cov->cov_full_diag     = NULL;
   snia_cov->cov_packed        = NULL;
 
@@ -209,7 +211,10 @@ nc_data_snia_cov_get_property (GObject *object, guint prop_id, GValue *value, GP
       g_value_take_variant (value, ncm_cfg_array_to_variant (snia_cov->dataset, G_VARIANT_TYPE ("u")));
       break;
     case PROP_COV_FULL:
-      g_value_set_object (value, nc_data_snia_cov_peek_cov_full (snia_cov));
+      if (snia_cov->cov_full_ro != NULL)
+        g_value_set_object (value, snia_cov->cov_full_ro);
+      else
+        g_value_set_object (value, nc_data_snia_cov_peek_cov_full (snia_cov));
       break;
     case PROP_HAS_COMPLETE_COV:
       g_value_set_boolean (value, snia_cov->has_complete_cov);
@@ -258,6 +263,7 @@ nc_data_snia_cov_finalize (GObject *object)
   G_OBJECT_CLASS (nc_data_snia_cov_parent_class)->finalize (object);
 }
 
+static void _nc_data_snia_cov_begin (NcmData *data);
 static void _nc_data_snia_cov_prepare (NcmData *data, NcmMSet *mset);
 static void _nc_data_snia_cov_resample (NcmData *data, NcmMSet *mset, NcmRNG *rng);
 static void _nc_data_snia_cov_mean_func (NcmDataGaussCov *gauss, NcmMSet *mset, NcmVector *vp);
@@ -357,6 +363,7 @@ nc_data_snia_cov_class_init (NcDataSNIACovClass *klass)
                                                          FALSE,
                                                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
 
+  data_class->begin      = &_nc_data_snia_cov_begin;
   data_class->resample   = &_nc_data_snia_cov_resample;
   data_class->prepare    = &_nc_data_snia_cov_prepare;
 
@@ -369,6 +376,16 @@ nc_data_snia_cov_class_init (NcDataSNIACovClass *klass)
     gauss_class->lnNorma2  = &_nc_data_snia_cov_lnNorma2;
 }
 
+static void
+_nc_data_snia_cov_begin (NcmData *data)
+{
+  NcDataSNIACov *snia_cov = NC_DATA_SNIA_COV (data);
+
+  /* The redshifts are fixed after loading, the sorting permutation is computed once. */
+  g_clear_pointer (&snia_cov->z_cmb_order, g_array_unref);
+  nc_data_snia_cov_peek_z_cmb_order (snia_cov);
+}
+
 static void
 _nc_data_snia_cov_prepare (NcmData *data, NcmMSet *mset)
 {
@@ -567,6 +584,7 @@ _nc_data_snia_cov_set_size (NcmDataGaussCov *gauss, guint mu_len)
     if (mu_len == 0 || mu_len != snia_cov->mu_len)
     {
       ncm_vector_clear (&snia_cov->z_cmb);
+      g_clear_pointer (&snia_cov->z_cmb_order, g_array_unref);
       ncm_vector_clear (&snia_cov->z_he);
 
       ncm_vector_clear (&snia_cov->mag);
@@ -584,6 +602,7 @@ _nc_data_snia_cov_set_size (NcmDataGaussCov *gauss, guint mu_len)
       ncm_vector_clear (&snia_cov->cov_packed);
       ncm_vector_clear (&snia_cov->cov_full_diag);
       ncm_matrix_clear (&snia_cov->cov_full);
+      ncm_matrix_clear (&snia_cov->cov_full_ro);
 
       ncm_matrix_clear (&snia_cov->inv_cov_mm_LU);
       ncm_matrix_clear (&snia_cov->inv_cov_mm);
@@ -640,6 +659,7 @@ _nc_data_snia_cov_set_size (NcmDataGaussCov *gauss, guint mu_len)
 }
 
 static void _nc_data_snia_cov_load_snia_data (NcDataSNIACov *snia_cov, const gchar *filename);
+static void _nc_data_snia_cov_set_cov_full_readonly (NcDataSNIACov *snia_cov);
 static void _nc_data_snia_cov_load_matrix (const gchar *filename, NcmMatrix *data);
 static void _nc_data_snia_cov_matrix_to_cov_full (NcDataSNIACov *snia_cov, NcmMatrix *cov, guint i, guint j);
 static void _nc_data_snia_cov_diag_to_full_cov (NcDataSNIACov *snia_cov, 
@@ -675,6 +695,24 @@ nc_data_snia_cov_peek_z_cmb (NcDataSNIACov *snia_cov)
   return snia_cov->z_cmb;
 }
 
+/**
+ * nc_data_snia_cov_peek_z_cmb_order:
+ * @snia_cov: a #NcDataSNIACov
+ * 
+ * Gets the permutation that sorts the $z_\mathrm{cmb}$ vector, it is
+ * computed once after the data is loaded, see ncm_vector_get_sort_index().
+ * 
+ * Returns: (transfer none) (array) (element-type guint): the $z_\mathrm{cmb}$ sorting permutation
+ */
+GArray *
+nc_data_snia_cov_peek_z_cmb_order (NcDataSNIACov *snia_cov)
+{
+  if ((snia_cov->z_cmb_order == NULL) && (snia_cov->z_cmb != NULL))
+    snia_cov->z_cmb_order = ncm_vector_get_sort_index (snia_cov->z_cmb);
+
+  return snia_cov->z_cmb_order;
+}
+
 /**
  * nc_data_snia_cov_peek_z_he:
  * @snia_cov: a #NcDataSNIACov
@@ -806,6 +844,7 @@ nc_data_snia_cov_set_z_cmb (NcDataSNIACov *snia_cov, NcmVector *z_cmb)
     ncm_vector_free (snia_cov->z_cmb);
     snia_cov->z_cmb = ncm_vector_ref (z_cmb);
   }
+  g_clear_pointer (&snia_cov->z_cmb_order, g_array_unref);
   _nc_data_snia_cov_set_data_init (snia_cov, NC_DATA_SNIA_COV_INIT_ZCMB);
 }
 
@@ -980,13 +1019,29 @@ nc_data_snia_cov_set_abs_mag_set (NcDataSNIACov *snia_cov, GArray *abs_mag_set)
   _nc_data_snia_cov_set_data_init (snia_cov, NC_DATA_SNIA_COV_INIT_ABSMAG_SET);
 }
 
+static GQuark
+_nc_data_snia_cov_packed_quark (void)
+{
+  static GQuark q = 0;
+
+  if (G_UNLIKELY (q == 0))
+    q = g_quark_from_static_string ("nc-data-snia-cov-packed");
+
+  return q;
+}
+
 /**
  * nc_data_snia_cov_set_cov_full:
  * @snia_cov: a #NcDataSNIACov
  * @cov_full: the full convariance #NcmMatrix
  * 
  * Sets the full covariance for the system, the size of @cov_full,
- * must match the system size.
+ * must match the system size. The values are copied to an internal
+ * workspace, which is decomposed in place. When @cov_full is marked
+ * read-only (see ncm_matrix_set_readonly()) it is also kept by reference
+ * and returned by the cov-full property, and the packed covariance
+ * computed from it is attached to @cov_full. Hence, copies made with
+ * ncm_fit_clone() share both instead of serializing them.
  * 
  */
 void 
@@ -994,6 +1049,7 @@ nc_data_snia_cov_set_cov_full (NcDataSNIACov *snia_cov, NcmMatrix *cov_full)
 {
   const guint mu_len  = snia_cov->mu_len;
   const guint tmu_len = 3 * mu_len;
+  NcmVector *cov_packed = NULL;
   guint i, j, ij;
   
   if (snia_cov->cov_full != cov_full)
@@ -1001,15 +1057,37 @@ nc_data_snia_cov_set_cov_full (NcDataSNIACov *snia_cov, NcmMatrix *cov_full)
     g_assert_cmpuint (ncm_matrix_nrows (cov_full), ==, tmu_len);
     g_assert_cmpuint (ncm_matrix_ncols (cov_full), ==, tmu_len);
 
+    /* cov_full is decomposed in place, the workspace must be a copy. */
     ncm_matrix_memcpy (snia_cov->cov_full, cov_full);
-/*    
-    ncm_matrix_clear (&snia_cov->cov_full);
-    snia_cov->cov_full = ncm_matrix_ref (cov_full);
-*/    
   }
 
-  /* Filling the cov_packed from cov_full. */
+  if ((snia_cov->cov_full != cov_full) && ncm_matrix_is_readonly (cov_full))
   {
+    if (snia_cov->cov_full_ro != cov_full)
+    {
+      ncm_matrix_clear (&snia_cov->cov_full_ro);
+      snia_cov->cov_full_ro = ncm_matrix_ref (cov_full);
+    }
+    cov_packed = g_object_get_qdata (G_OBJECT (cov_full), _nc_data_snia_cov_packed_quark ());
+  }
+  else
+    ncm_matrix_clear (&snia_cov->cov_full_ro);
+
+  if (cov_packed != NULL)
+  {
+    ncm_vector_substitute (&snia_cov->cov_packed, cov_packed, TRUE);
+  }
+  else
+  {
+    /* The current cov_packed may be shared with other copies. */
+    if (ncm_vector_is_readonly (snia_cov->cov_packed))
+    {
+      NcmVector *cov_packed_new = ncm_vector_new (ncm_vector_len (snia_cov->cov_packed));
+      ncm_vector_substitute (&snia_cov->cov_packed, cov_packed_new, FALSE);
+      ncm_vector_free (cov_packed_new);
+    }
+    
+    /* Filling the cov_packed from cov_full. */
     ij = 0;
     for (i = 0; i < snia_cov->mu_len; i++)
     {
@@ -1038,6 +1116,13 @@ nc_data_snia_cov_set_cov_full (NcDataSNIACov *snia_cov, NcmMatrix *cov_full)
         ij++;
       }
     }
+
+    if (snia_cov->cov_full_ro != NULL)
+    {
+      ncm_vector_set_readonly (snia_cov->cov_packed, TRUE);
+      g_object_set_qdata_full (G_OBJECT (snia_cov->cov_full_ro), _nc_data_snia_cov_packed_quark (),
+                               ncm_vector_ref (snia_cov->cov_packed), (GDestroyNotify) ncm_vector_free);
+    }
   }
   
   _nc_data_snia_cov_save_cov_lowertri (snia_cov);
@@ -1105,7 +1190,6 @@ nc_data_snia_cov_load_txt (NcDataSNIACov *snia_cov, const gchar *filename)
 
   /* Setting everything to zero */
   ncm_matrix_set_zero (snia_cov->cov_full);
-  ncm_vector_set_zero (snia_cov->cov_packed);
   
   if (!g_key_file_has_key (snia_keyfile, 
                            NC_DATA_SNIA_COV_DATA_GROUP,
@@ -1276,7 +1360,7 @@ nc_data_snia_cov_load_txt (NcDataSNIACov *snia_cov, const gchar *filename)
     }     
   }
 
-  nc_data_snia_cov_set_cov_full (snia_cov, snia_cov->cov_full);
+  _nc_data_snia_cov_set_cov_full_readonly (snia_cov);
   _nc_data_snia_cov_set_data_init (snia_cov, NC_DATA_SNIA_COV_INIT_ALL);
   ncm_matrix_clear (&cov);
   g_key_file_free (snia_keyfile);
@@ -1668,7 +1752,6 @@ nc_data_snia_cov_load (NcDataSNIACov *snia_cov, const gchar *filename)
   /* Setting everything to zero */
   ncm_matrix_set_zero (snia_cov->cov_full);
   ncm_vector_set_zero (snia_cov->cov_full_diag);
-  ncm_vector_set_zero (snia_cov->cov_packed);
   
   if (cat_version == 0)
   {
@@ -1741,7 +1824,7 @@ nc_data_snia_cov_load (NcDataSNIACov *snia_cov, const gchar *filename)
   NCM_FITS_ERROR (status);
 
   _nc_data_snia_cov_set_data_init (snia_cov, NC_DATA_SNIA_COV_INIT_ALL);
-  nc_data_snia_cov_set_cov_full (snia_cov, snia_cov->cov_full);
+  _nc_data_snia_cov_set_cov_full_readonly (snia_cov);
 }
 
 /**
@@ -2062,6 +2145,20 @@ _nc_data_snia_cov_save_cov_lowertri (NcDataSNIACov *snia_cov)
   }
 }
 
+/*
+ * The covariance read from the catalogs does not change anymore, it is
+ * marked read-only so that the copies of this object share it.
+ */
+static void
+_nc_data_snia_cov_set_cov_full_readonly (NcDataSNIACov *snia_cov)
+{
+  NcmMatrix *cov_full = ncm_matrix_dup (snia_cov->cov_full);
+
+  ncm_matrix_set_readonly (cov_full, TRUE);
+  nc_data_snia_cov_set_cov_full (snia_cov, cov_full);
+  ncm_matrix_free (cov_full);
+}
+
 static void 
 _nc_data_snia_cov_resample (NcmData *data, NcmMSet *mset, NcmRNG *rng)
 {
@@ -217,6 +217,7 @@ struct _NcDataSNIACov
   guint uppertri_len;
   NcmVector *z_cmb;
   NcmVector *z_he;
+  GArray *z_cmb_order;
   NcmVector *mag;
   NcmVector *width;
   NcmVector *colour;
@@ -228,6 +229,7 @@ struct _NcDataSNIACov
   NcmVector *sigma_thirdpar;
   NcmVector *cov_packed;
   NcmMatrix *cov_full;
+  NcmMatrix *cov_full_ro;
   NcmVector *cov_full_diag;
   NcmMatrix *inv_cov_mm;
   NcmMatrix *inv_cov_mm_LU;
@@ -252,6 +254,7 @@ guint nc_data_snia_cov_sigma_int_len (NcDataSNIACov *snia_cov);
 
 NcmVector *nc_data_snia_cov_peek_z_cmb (NcDataSNIACov *snia_cov);
 NcmVector *nc_data_snia_cov_peek_z_he (NcDataSNIACov *snia_cov);
+GArray *nc_data_snia_cov_peek_z_cmb_order (NcDataSNIACov *snia_cov);
 NcmVector *nc_data_snia_cov_peek_sigma_z (NcDataSNIACov *snia_cov);
 NcmVector *nc_data_snia_cov_peek_mag (NcDataSNIACov *snia_cov);
 NcmVector *nc_data_snia_cov_peek_width (NcDataSNIACov *snia_cov);
@@ -42,6 +42,7 @@
 #include "math/integral.h"
 #include "math/memory_pool.h"
 #include "math/ncm_cfg.h"
+#include "math/ncm_profiler.h"
 
 #include <gsl/gsl_histogram.h>
 
@@ -706,7 +707,11 @@ nc_cluster_abundance_prepare (NcClusterAbundance *cad, NcHICosmo *cosmo, NcClust
   if (cad->zi == 0.0)
     cad->zi = 1.0e-6;
 
-  cad->norma     = nc_cluster_abundance_true_n (cad, cosmo, clusterz, clusterm);
+  {
+    const gdouble t0 = ncm_profiler_start ();
+    cad->norma       = nc_cluster_abundance_true_n (cad, cosmo, clusterz, clusterm);
+    ncm_profiler_stop ("NcClusterAbundance:true_n", t0);
+  }
   cad->log_norma = log (cad->norma);
 
   ncm_model_ctrl_update (cad->ctrl_cosmo, NCM_MODEL (cosmo));
@@ -0,0 +1,526 @@
+/***************************************************************************
+ *            ncm_arena.c
+ *
+ *  Sun October 18 16:40:12 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_arena.c
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:ncm_arena
+ * @title: NcmArena
+ * @short_description: Per-thread scoped arena for temporary vectors and matrices.
+ *
+ * This module provides a per-thread stack allocator for short-lived
+ * #NcmVector and #NcmMatrix objects. A scope is opened with ncm_arena_push()
+ * and every temporary obtained afterwards, e.g., through
+ * ncm_arena_vector_new() or ncm_arena_matrix_get_row(), is released in bulk
+ * by the matching ncm_arena_pop().
+ *
+ * The data blocks are aligned to #NCM_ARENA_ALIGN bytes and carved out of
+ * memory chunks kept by the arena. The #NcmVector and #NcmMatrix objects
+ * themselves are recycled shells, they are built once and only re-pointed
+ * to the new data in the following scopes. Therefore, once the arena has
+ * grown to the size required by a code path, running it again does not
+ * touch the heap nor construct any GObject. This can be checked through
+ * the counters returned by ncm_arena_get_stats().
+ *
+ * The temporaries belong to the arena: they must not be freed, must not
+ * be referenced beyond their scope and are only valid in the thread that
+ * created them. Views (rows, columns and subvectors) do not hold a
+ * reference to their parent object, which must outlive the scope.
+ *
+ * |[<!-- language="C" -->
+ * ncm_arena_push ();
+ * for (i = 0; i < N_z; i++)
+ * {
+ *   NcmVector *row = ncm_arena_matrix_get_row (m, i);
+ *   ...
+ * }
+ * ncm_arena_pop ();
+ * ]|
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif /* HAVE_CONFIG_H */
+#include "build_cfg.h"
+
+#include "math/ncm_arena.h"
+#include "math/ncm_cfg.h"
+
+#include <string.h>
+#include <gsl/gsl_math.h>
+
+#define _NCM_ARENA_CHUNK_SIZE (1024 * 64)
+#define _NCM_ARENA_ALIGN_DOUBLES (NCM_ARENA_ALIGN / sizeof (gdouble))
+
+typedef struct _NcmArenaChunk
+{
+  gpointer mem;
+  gdouble *data;
+  gsize size;
+} NcmArenaChunk;
+
+typedef struct _NcmArenaMark
+{
+  guint chunk;
+  gsize offset;
+  guint nvec;
+  guint nmat;
+  gsize bytes_used;
+} NcmArenaMark;
+
+typedef struct _NcmArena
+{
+  GArray *chunks;
+  GPtrArray *vec_shells;
+  GPtrArray *mat_shells;
+  GArray *marks;
+  guint chunk;
+  gsize offset;
+  guint nvec;
+  guint nmat;
+  NcmArenaStats stats;
+} NcmArena;
+
+static gint _ncm_arena_total_heap_allocs = 0;
+
+static void
+_ncm_arena_chunk_clear (gpointer p)
+{
+  NcmArenaChunk *c = (NcmArenaChunk *) p;
+  g_free (c->mem);
+}
+
+static void
+_ncm_arena_free (gpointer p)
+{
+  NcmArena *arena = (NcmArena *) p;
+
+  g_array_unref (arena->chunks);
+  g_ptr_array_unref (arena->vec_shells);
+  g_ptr_array_unref (arena->mat_shells);
+  g_array_unref (arena->marks);
+  g_free (arena);
+}
+
+static GPrivate _ncm_arena_key = G_PRIVATE_INIT (_ncm_arena_free);
+
+static void
+_ncm_arena_count_heap_alloc (NcmArena *arena)
+{
+  arena->stats.nheap_allocs++;
+  g_atomic_int_inc (&_ncm_arena_total_heap_allocs);
+}
+
+static NcmArena *
+_ncm_arena_peek (void)
+{
+  NcmArena *arena = g_private_get (&_ncm_arena_key);
+
+  if (arena == NULL)
+  {
+    arena = g_new0 (NcmArena, 1);
+
+    arena->chunks     = g_array_new (FALSE, FALSE, sizeof (NcmArenaChunk));
+    arena->vec_shells = g_ptr_array_new_with_free_func ((GDestroyNotify) &ncm_vector_free);
+    arena->mat_shells = g_ptr_array_new_with_free_func ((GDestroyNotify) &ncm_matrix_free);
+    arena->marks      = g_array_sized_new (FALSE, FALSE, sizeof (NcmArenaMark), 16);
+
+    g_array_set_clear_func (arena->chunks, &_ncm_arena_chunk_clear);
+
+    g_private_set (&_ncm_arena_key, arena);
+  }
+
+  return arena;
+}
+
+static void
+_ncm_arena_assert_scope (NcmArena *arena)
+{
+  if (arena->marks->len == 0)
+    g_error ("ncm_arena: temporaries can only be requested inside a scope, see ncm_arena_push().");
+}
+
+static gdouble *
+_ncm_arena_alloc (NcmArena *arena, gsize n)
+{
+  const gsize na = ((n + _NCM_ARENA_ALIGN_DOUBLES - 1) / _NCM_ARENA_ALIGN_DOUBLES) * _NCM_ARENA_ALIGN_DOUBLES;
+
+  _ncm_arena_assert_scope (arena);
+
+  while (TRUE)
+  {
+    if (arena->chunk < arena->chunks->len)
+    {
+      NcmArenaChunk *c = &g_array_index (arena->chunks, NcmArenaChunk, arena->chunk);
+
+      if (arena->offset + na <= c->size)
+      {
+        gdouble *d = c->data + arena->offset;
+
+        arena->offset           += na;
+        arena->stats.bytes_used += na * sizeof (gdouble);
+        arena->stats.bytes_peak  = GSL_MAX (arena->stats.bytes_peak, arena->stats.bytes_used);
+
+        return d;
+      }
+      else
+      {
+        /* The remaining of the chunk is wasted until the scope is popped. */
+        arena->stats.bytes_used += (c->size - arena->offset) * sizeof (gdouble);
+        arena->chunk++;
+        arena->offset = 0;
+      }
+    }
+    else
+    {
+      NcmArenaChunk c;
+
+      c.size = GSL_MAX (_NCM_ARENA_CHUNK_SIZE, na);
+      c.mem  = g_malloc (c.size * sizeof (gdouble) + NCM_ARENA_ALIGN);
+      c.data = (gdouble *) (((guintptr) c.mem + NCM_ARENA_ALIGN - 1) & ~((guintptr) NCM_ARENA_ALIGN - 1));
+
+      g_array_append_val (arena->chunks, c);
+      arena->stats.bytes_reserved += c.size * sizeof (gdouble);
+      _ncm_arena_count_heap_alloc (arena);
+    }
+  }
+}
+
+static NcmVector *
+_ncm_arena_vector_shell (NcmArena *arena)
+{
+  NcmVector *cv;
+
+  _ncm_arena_assert_scope (arena);
+
+  if (arena->nvec < arena->vec_shells->len)
+  {
+    cv = g_ptr_array_index (arena->vec_shells, arena->nvec);
+  }
+  else
+  {
+    cv = g_object_new (NCM_TYPE_VECTOR, NULL);
+    cv->type = NCM_VECTOR_DERIVED;
+
+    g_ptr_array_add (arena->vec_shells, cv);
+    _ncm_arena_count_heap_alloc (arena);
+  }
+
+  arena->nvec++;
+  arena->stats.nvectors++;
+
+  return cv;
+}
+
+static NcmMatrix *
+_ncm_arena_matrix_shell (NcmArena *arena)
+{
+  NcmMatrix *cm;
+
+  _ncm_arena_assert_scope (arena);
+
+  if (arena->nmat < arena->mat_shells->len)
+  {
+    cm = g_ptr_array_index (arena->mat_shells, arena->nmat);
+  }
+  else
+  {
+    cm = g_object_new (NCM_TYPE_MATRIX, NULL);
+    cm->type = NCM_MATRIX_DERIVED;
+
+    g_ptr_array_add (arena->mat_shells, cm);
+    _ncm_arena_count_heap_alloc (arena);
+  }
+
+  arena->nmat++;
+  arena->stats.nmatrices++;
+
+  return cm;
+}
+
+/**
+ * ncm_arena_push:
+ *
+ * Opens a new scope in the arena of the current thread. Scopes can be
+ * nested, each one must be closed by a call to ncm_arena_pop().
+ *
+ */
+void
+ncm_arena_push (void)
+{
+  NcmArena *arena   = _ncm_arena_peek ();
+  NcmArenaMark mark = {arena->chunk, arena->offset, arena->nvec, arena->nmat, arena->stats.bytes_used};
+
+  g_array_append_val (arena->marks, mark);
+}
+
+/**
+ * ncm_arena_pop:
+ *
+ * Closes the innermost scope of the arena of the current thread, releasing
+ * all temporaries obtained since the matching ncm_arena_push(). The memory
+ * is kept by the arena to be reused by the following scopes.
+ *
+ */
+void
+ncm_arena_pop (void)
+{
+  NcmArena *arena = _ncm_arena_peek ();
+  NcmArenaMark *mark;
+  guint i;
+
+  if (arena->marks->len == 0)
+    g_error ("ncm_arena_pop: no scope to pop.");
+
+  mark = &g_array_index (arena->marks, NcmArenaMark, arena->marks->len - 1);
+
+  for (i = mark->nvec; i < arena->nvec; i++)
+  {
+    NcmVector *cv = g_ptr_array_index (arena->vec_shells, i);
+
+    if (G_OBJECT (cv)->ref_count != 1)
+      g_error ("ncm_arena_pop: a temporary vector escaped its scope (ref_count = %u).", G_OBJECT (cv)->ref_count);
+
+    memset (&cv->vv, 0, sizeof (gsl_vector_view));
+  }
+
+  for (i = mark->nmat; i < arena->nmat; i++)
+  {
+    NcmMatrix *cm = g_ptr_array_index (arena->mat_shells, i);
+
+    if (G_OBJECT (cm)->ref_count != 1)
+      g_error ("ncm_arena_pop: a temporary matrix escaped its scope (ref_count = %u).", G_OBJECT (cm)->ref_count);
+
+    memset (&cm->mv, 0, sizeof (gsl_matrix_view));
+  }
+
+  arena->chunk            = mark->chunk;
+  arena->offset           = mark->offset;
+  arena->nvec             = mark->nvec;
+  arena->nmat             = mark->nmat;
+  arena->stats.bytes_used = mark->bytes_used;
+
+  g_array_set_size (arena->marks, arena->marks->len - 1);
+}
+
+/**
+ * ncm_arena_depth:
+ *
+ * Returns: the number of open scopes in the arena of the current thread.
+ */
+guint
+ncm_arena_depth (void)
+{
+  NcmArena *arena = _ncm_arena_peek ();
+  return arena->marks->len;
+}
+
+/**
+ * ncm_arena_trim:
+ *
+ * Releases all memory and object shells kept by the arena of the current
+ * thread. It must be called outside of any scope.
+ *
+ */
+void
+ncm_arena_trim (void)
+{
+  NcmArena *arena = _ncm_arena_peek ();
+
+  if (arena->marks->len != 0)
+    g_error ("ncm_arena_trim: cannot trim the arena inside a scope.");
+
+  g_array_set_size (arena->chunks, 0);
+  g_ptr_array_set_size (arena->vec_shells, 0);
+  g_ptr_array_set_size (arena->mat_shells, 0);
+
+  arena->chunk                = 0;
+  arena->offset               = 0;
+  arena->stats.bytes_reserved = 0;
+}
+
+/**
+ * ncm_arena_alloc: (skip)
+ * @n: number of doubles
+ *
+ * Allocates @n doubles in the current scope, the block is aligned to
+ * #NCM_ARENA_ALIGN bytes.
+ *
+ * Returns: (transfer none): a pointer to the block.
+ */
+gdouble *
+ncm_arena_alloc (gsize n)
+{
+  return _ncm_arena_alloc (_ncm_arena_peek (), n);
+}
+
+/**
+ * ncm_arena_vector_new:
+ * @n: vector length
+ *
+ * Returns a temporary #NcmVector with @n (uninitialized) components,
+ * valid until the end of the current scope.
+ *
+ * Returns: (transfer none): a temporary #NcmVector.
+ */
+NcmVector *
+ncm_arena_vector_new (gsize n)
+{
+  NcmArena *arena = _ncm_arena_peek ();
+  NcmVector *cv   = _ncm_arena_vector_shell (arena);
+
+  g_assert_cmpuint (n, >, 0);
+
+  cv->vv = gsl_vector_view_array (_ncm_arena_alloc (arena, n), n);
+
+  return cv;
+}
+
+/**
+ * ncm_arena_vector_get_subvector:
+ * @cv: a #NcmVector
+ * @k: component index of the original vector
+ * @size: number of components of the subvector
+ *
+ * Returns a temporary view of the components [@k, @k + @size) of @cv,
+ * valid until the end of the current scope.
+ *
+ * Returns: (transfer none): a temporary #NcmVector.
+ */
+NcmVector *
+ncm_arena_vector_get_subvector (NcmVector *cv, gsize k, gsize size)
+{
+  NcmVector *scv = _ncm_arena_vector_shell (_ncm_arena_peek ());
+
+  scv->vv = gsl_vector_subvector (ncm_vector_gsl (cv), k, size);
+
+  return scv;
+}
+
+/**
+ * ncm_arena_matrix_new:
+ * @nrows: number of rows
+ * @ncols: number of columns
+ *
+ * Returns a temporary #NcmMatrix with @nrows x @ncols (uninitialized)
+ * elements, valid until the end of the current scope.
+ *
+ * Returns: (transfer none): a temporary #NcmMatrix.
+ */
+NcmMatrix *
+ncm_arena_matrix_new (guint nrows, guint ncols)
+{
+  NcmArena *arena = _ncm_arena_peek ();
+  NcmMatrix *cm   = _ncm_arena_matrix_shell (arena);
+
+  g_assert_cmpuint (nrows, >, 0);
+  g_assert_cmpuint (ncols, >, 0);
+
+  cm->mv = gsl_matrix_view_array (_ncm_arena_alloc (arena, nrows * ncols), nrows, ncols);
+
+  return cm;
+}
+
+/**
+ * ncm_arena_matrix_get_row:
+ * @cm: a #NcmMatrix
+ * @row: row index
+ *
+ * Returns a temporary view of the row @row of @cm, valid until the end of
+ * the current scope.
+ *
+ * Returns: (transfer none): a temporary #NcmVector.
+ */
+NcmVector *
+ncm_arena_matrix_get_row (NcmMatrix *cm, guint row)
+{
+  NcmVector *cv = _ncm_arena_vector_shell (_ncm_arena_peek ());
+
+  cv->vv = gsl_matrix_row (ncm_matrix_gsl (cm), row);
+
+  return cv;
+}
+
+/**
+ * ncm_arena_matrix_get_col:
+ * @cm: a #NcmMatrix
+ * @col: column index
+ *
+ * Returns a temporary view of the column @col of @cm, valid until the end
+ * of the current scope.
+ *
+ * Returns: (transfer none): a temporary #NcmVector.
+ */
+NcmVector *
+ncm_arena_matrix_get_col (NcmMatrix *cm, guint col)
+{
+  NcmVector *cv = _ncm_arena_vector_shell (_ncm_arena_peek ());
+
+  cv->vv = gsl_matrix_column (ncm_matrix_gsl (cm), col);
+
+  return cv;
+}
+
+/**
+ * ncm_arena_get_stats:
+ * @stats: (out caller-allocates): a #NcmArenaStats
+ *
+ * Copies the counters of the arena of the current thread to @stats.
+ *
+ */
+void
+ncm_arena_get_stats (NcmArenaStats *stats)
+{
+  NcmArena *arena = _ncm_arena_peek ();
+  *stats = arena->stats;
+}
+
+/**
+ * ncm_arena_reset_stats:
+ *
+ * Resets the counters nheap_allocs, nvectors, nmatrices and bytes_peak
+ * of the arena of the current thread.
+ *
+ */
+void
+ncm_arena_reset_stats (void)
+{
+  NcmArena *arena = _ncm_arena_peek ();
+
+  arena->stats.nheap_allocs = 0;
+  arena->stats.nvectors     = 0;
+  arena->stats.nmatrices    = 0;
+  arena->stats.bytes_peak   = arena->stats.bytes_used;
+}
+
+/**
+ * ncm_arena_get_total_heap_allocs:
+ *
+ * Returns: the number of heap allocations performed by the arenas of all threads.
+ */
+guint64
+ncm_arena_get_total_heap_allocs (void)
+{
+  return g_atomic_int_get (&_ncm_arena_total_heap_allocs);
+}
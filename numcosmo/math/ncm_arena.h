@@ -0,0 +1,80 @@
+/***************************************************************************
+ *            ncm_arena.h
+ *
+ *  Sun October 18 16:40:12 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_arena.h
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _NCM_ARENA_H_
+#define _NCM_ARENA_H_
+
+#include <glib.h>
+#include <numcosmo/build_cfg.h>
+#include <numcosmo/math/ncm_vector.h>
+#include <numcosmo/math/ncm_matrix.h>
+
+G_BEGIN_DECLS
+
+typedef struct _NcmArenaStats NcmArenaStats;
+
+/**
+ * NcmArenaStats:
+ * @nheap_allocs: number of heap allocations (memory chunks and object shells)
+ * @nvectors: number of temporary vectors handed out
+ * @nmatrices: number of temporary matrices handed out
+ * @bytes_used: bytes currently in use
+ * @bytes_peak: maximum number of bytes in use
+ * @bytes_reserved: bytes reserved by the arena
+ *
+ * Counters of the arena of the current thread.
+ */
+struct _NcmArenaStats
+{
+  guint64 nheap_allocs;
+  guint64 nvectors;
+  guint64 nmatrices;
+  gsize bytes_used;
+  gsize bytes_peak;
+  gsize bytes_reserved;
+};
+
+void ncm_arena_push (void);
+void ncm_arena_pop (void);
+guint ncm_arena_depth (void);
+void ncm_arena_trim (void);
+
+gdouble *ncm_arena_alloc (gsize n);
+
+NcmVector *ncm_arena_vector_new (gsize n);
+NcmVector *ncm_arena_vector_get_subvector (NcmVector *cv, gsize k, gsize size);
+NcmMatrix *ncm_arena_matrix_new (guint nrows, guint ncols);
+NcmVector *ncm_arena_matrix_get_row (NcmMatrix *cm, guint row);
+NcmVector *ncm_arena_matrix_get_col (NcmMatrix *cm, guint col);
+
+void ncm_arena_get_stats (NcmArenaStats *stats);
+void ncm_arena_reset_stats (void);
+guint64 ncm_arena_get_total_heap_allocs (void);
+
+#define NCM_ARENA_ALIGN (64)
+
+G_END_DECLS
+
+#endif /* _NCM_ARENA_H_ */
@@ -53,6 +53,7 @@
 #include "math/ncm_reparam_linear.h"
 #include "math/ncm_data.h"
 #include "math/ncm_stats_vec.h"
+#include "math/ncm_profiler.h"
 #include "math/ncm_fit_esmcmc_walker_stretch.h"
 #include "nc_hicosmo.h"
 #include "nc_cbe_precision.h"
@@ -299,6 +300,15 @@ ncm_cfg_init (void)
   _log_stream = stdout;
   _log_stream_err = stderr;
 
+  {
+    const gchar *prof_file = g_getenv (NCM_PROFILER_ENV);
+    if ((prof_file != NULL) && (prof_file[0] != '\0'))
+    {
+      ncm_profiler_set_report_file (prof_file);
+      ncm_profiler_enable ();
+    }
+  }
+
   _log_msg_id = g_log_set_handler (G_LOG_DOMAIN, G_LOG_LEVEL_MESSAGE | G_LOG_LEVEL_DEBUG, _ncm_cfg_log_message, NULL);
   _log_err_id = g_log_set_handler (G_LOG_DOMAIN, G_LOG_LEVEL_ERROR | G_LOG_LEVEL_CRITICAL | G_LOG_FLAG_FATAL | G_LOG_FLAG_RECURSION, _ncm_cfg_log_error, NULL);
 
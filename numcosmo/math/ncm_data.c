@@ -45,6 +45,7 @@
 
 #include "math/ncm_data.h"
 #include "math/ncm_cfg.h"
+#include "math/ncm_profiler.h"
 
 enum
 {
@@ -67,6 +68,9 @@ ncm_data_init (NcmData *data)
   data->init      = FALSE;
   data->begin     = FALSE;
   data->diff      = ncm_diff_new ();
+
+  data->prof_prepare = NULL;
+  data->prof_m2lnL   = NULL;
 }
 
 static void
@@ -151,6 +155,8 @@ _ncm_data_finalize (GObject *object)
 
   g_clear_pointer (&data->desc, g_free);
   g_clear_pointer (&data->long_desc, g_free);
+  g_clear_pointer (&data->prof_prepare, g_free);
+  g_clear_pointer (&data->prof_m2lnL, g_free);
 
   /* Chain up : end */
   G_OBJECT_CLASS (ncm_data_parent_class)->finalize (object);
@@ -248,6 +254,7 @@ ncm_data_class_init (NcmDataClass *klass)
   data_class->m2lnL_val        = NULL;
   data_class->m2lnL_grad       = NULL;
   data_class->m2lnL_val_grad   = NULL;
+  data_class->m2lnL_val_batch  = NULL;
 
   data_class->mean_vector      = NULL;
   data_class->inv_cov_UH       = NULL;
@@ -517,7 +524,20 @@ _ncm_data_prepare (NcmData *data, NcmMSet *mset)
   }
 
   if (NCM_DATA_GET_CLASS (data)->prepare != NULL)
-    NCM_DATA_GET_CLASS (data)->prepare (data, mset);
+  {
+    if (G_UNLIKELY (ncm_profiler_is_enabled ()))
+    {
+      const gdouble t0 = ncm_profiler_time ();
+
+      NCM_DATA_GET_CLASS (data)->prepare (data, mset);
+
+      if (data->prof_prepare == NULL)
+        data->prof_prepare = g_strdup_printf ("%s:prepare", G_OBJECT_TYPE_NAME (data));
+      ncm_profiler_add_call (data->prof_prepare, ncm_profiler_time () - t0);
+    }
+    else
+      NCM_DATA_GET_CLASS (data)->prepare (data, mset);
+  }
 }
 
 
@@ -752,7 +772,18 @@ ncm_data_m2lnL_val (NcmData *data, NcmMSet *mset, gdouble *m2lnL)
     g_error ("ncm_data_m2lnL_val: The data (%s) does not implement m2lnL_val.", 
              ncm_data_get_desc (data));
 
-  NCM_DATA_GET_CLASS (data)->m2lnL_val (data, mset, m2lnL);
+  if (G_UNLIKELY (ncm_profiler_is_enabled ()))
+  {
+    const gdouble t0 = ncm_profiler_time ();
+
+    NCM_DATA_GET_CLASS (data)->m2lnL_val (data, mset, m2lnL);
+
+    if (data->prof_m2lnL == NULL)
+      data->prof_m2lnL = g_strdup_printf ("%s:m2lnL_val", G_OBJECT_TYPE_NAME (data));
+    ncm_profiler_add_call (data->prof_m2lnL, ncm_profiler_time () - t0);
+  }
+  else
+    NCM_DATA_GET_CLASS (data)->m2lnL_val (data, mset, m2lnL);
 }
 
 /**
@@ -800,6 +831,79 @@ void ncm_data_m2lnL_val_grad (NcmData *data, NcmMSet *mset, gdouble *m2lnL, NcmV
   NCM_DATA_GET_CLASS (data)->m2lnL_val_grad (data, mset, m2lnL, grad);
 }
 
+/**
+ * ncm_data_has_m2lnL_val_batch:
+ * @data: a #NcmData
+ *
+ * Checks whether @data implements a vectorised #NcmDataClass.m2lnL_val_batch.
+ * When it does not, ncm_data_m2lnL_val_batch() falls back to a loop over
+ * ncm_data_m2lnL_val().
+ *
+ * Returns: whether @data implements #NcmDataClass.m2lnL_val_batch.
+ */
+gboolean
+ncm_data_has_m2lnL_val_batch (NcmData *data)
+{
+  return (NCM_DATA_GET_CLASS (data)->m2lnL_val_batch != NULL);
+}
+
+/**
+ * ncm_data_m2lnL_val_batch: (virtual m2lnL_val_batch)
+ * @data: a #NcmData
+ * @mset: a #NcmMSet
+ * @fparams: a #NcmMatrix containing one free parameter vector per row
+ * @m2lnL_v: a #NcmVector
+ *
+ * Calculates $-2\ln(L)$ as in ncm_data_m2lnL_val() for each row of @fparams,
+ * the rows are used as the free parameters of @mset (see 
+ * ncm_mset_fparams_set_vector()) and the results are stored in @m2lnL_v.
+ * Data objects can implement #NcmDataClass.m2lnL_val_batch to share work
+ * among the points, otherwise the points are evaluated one by one.
+ * 
+ * The number of columns of @fparams must be equal to the number of free
+ * parameters of @mset and the length of @m2lnL_v equal to the number of 
+ * rows of @fparams. The free parameters of @mset are restored on exit.
+ * 
+ */
+void
+ncm_data_m2lnL_val_batch (NcmData *data, NcmMSet *mset, NcmMatrix *fparams, NcmVector *m2lnL_v)
+{
+  const guint npoints = ncm_matrix_nrows (fparams);
+  NcmVector *fparams0;
+
+  if (NCM_DATA_GET_CLASS (data)->m2lnL_val == NULL)
+    g_error ("ncm_data_m2lnL_val_batch: The data (%s) does not implement m2lnL_val.", 
+             ncm_data_get_desc (data));
+
+  g_assert_cmpuint (ncm_matrix_ncols (fparams), ==, ncm_mset_fparams_len (mset));
+  g_assert_cmpuint (ncm_vector_len (m2lnL_v), ==, npoints);
+
+  fparams0 = ncm_vector_new (ncm_mset_fparams_len (mset));
+  ncm_mset_fparams_get_vector (mset, fparams0);
+
+  if (NCM_DATA_GET_CLASS (data)->m2lnL_val_batch != NULL)
+    NCM_DATA_GET_CLASS (data)->m2lnL_val_batch (data, mset, fparams, m2lnL_v);
+  else
+  {
+    guint a;
+
+    for (a = 0; a < npoints; a++)
+    {
+      NcmVector *fparams_a = ncm_matrix_get_row (fparams, a);
+      gdouble m2lnL_a;
+
+      ncm_mset_fparams_set_vector (mset, fparams_a);
+      ncm_data_m2lnL_val (data, mset, &m2lnL_a);
+      ncm_vector_set (m2lnL_v, a, m2lnL_a);
+
+      ncm_vector_free (fparams_a);
+    }
+  }
+
+  ncm_mset_fparams_set_vector (mset, fparams0);
+  ncm_vector_free (fparams0);
+}
+
 /**
  * ncm_data_mean_vector: (virtual mean_vector)
  * @data: a #NcmData
@@ -79,6 +79,8 @@ typedef void (*NcmDataFisherMatrix) (NcmData *data, NcmMSet *mset, NcmMatrix **I
  * @m2lnL_grad: evaluate the gradient of $-2\ln(L)$ with respect to the free
  * parameters in @mset.
  * @m2lnL_val_grad: evaluate the value and the gradient of $-2\ln(L)$.
+ * @m2lnL_val_batch: (optional) evaluate $-2\ln(L)$ for several values of the free
+ * parameters of @mset at once, see ncm_data_m2lnL_val_batch().
  * @mean_vector: evaluate the Gaussian mean (approximation or not)
  * @inv_cov_UH: evaluate the Gaussian inverse covariance matrix (approximation or not)
  * @fisher_matrix: calculates the Fisher matrix (based on a Gaussian approximation when it is the case) 
@@ -105,6 +107,7 @@ struct _NcmDataClass
   void (*m2lnL_val) (NcmData *data, NcmMSet *mset, gdouble *m2lnL);
   void (*m2lnL_grad) (NcmData *data, NcmMSet *mset, NcmVector *grad);
   void (*m2lnL_val_grad) (NcmData *data, NcmMSet *mset, gdouble *m2lnL, NcmVector *grad);
+  void (*m2lnL_val_batch) (NcmData *data, NcmMSet *mset, NcmMatrix *fparams, NcmVector *m2lnL_v);
   void (*mean_vector) (NcmData *data, NcmMSet *mset, NcmVector *mu);
   void (*inv_cov_UH) (NcmData *data, NcmMSet *mset, NcmMatrix *H);
   NcmDataFisherMatrix fisher_matrix;
@@ -120,6 +123,8 @@ struct _NcmData
   gboolean begin;
   NcmBootstrap *bstrap;
   NcmDiff *diff;
+  gchar *prof_prepare;
+  gchar *prof_m2lnL;
 };
 
 GType ncm_data_get_type (void) G_GNUC_CONST;
@@ -155,6 +160,8 @@ void ncm_data_leastsquares_f_J (NcmData *data, NcmMSet *mset, NcmVector *f, NcmM
 void ncm_data_m2lnL_val (NcmData *data, NcmMSet *mset, gdouble *m2lnL);
 void ncm_data_m2lnL_grad (NcmData *data, NcmMSet *mset, NcmVector *grad);
 void ncm_data_m2lnL_val_grad (NcmData *data, NcmMSet *mset, gdouble *m2lnL, NcmVector *grad);
+gboolean ncm_data_has_m2lnL_val_batch (NcmData *data);
+void ncm_data_m2lnL_val_batch (NcmData *data, NcmMSet *mset, NcmMatrix *fparams, NcmVector *m2lnL_v);
 
 void ncm_data_mean_vector (NcmData *data, NcmMSet *mset, NcmVector *mu);
 void ncm_data_sigma_vector (NcmData *data, NcmMSet *mset, NcmVector *sigma);
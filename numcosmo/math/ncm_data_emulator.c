@@ -0,0 +1,1099 @@
+/***************************************************************************
+ *            ncm_data_emulator.c
+ *
+ *  Sun October 18 18:12:41 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_data_emulator.c
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:ncm_data_emulator
+ * @title: NcmDataEmulator
+ * @short_description: Gaussian process emulator for the likelihood of a #NcmData.
+ *
+ * This object wraps any #NcmData and replaces, when possible, the evaluation
+ * of its $-2\ln(L)$ by the prediction of a Gaussian process surrogate.
+ * Every true evaluation adds the pair (free parameters, $-2\ln(L)$) to the
+ * training set. Once the training set has at least
+ * #NcmDataEmulator:min-train points a surrogate is fitted and, from then on,
+ * each call first computes the surrogate prediction and its predictive
+ * standard deviation $\sigma$; when $\sigma$ is smaller than
+ * #NcmDataEmulator:tol the prediction is returned, otherwise the wrapped
+ * #NcmData is evaluated. The surrogate is refitted every time
+ * #NcmDataEmulator:retrain new points are added, when
+ * #NcmDataEmulator:background is TRUE this is done in a separate thread and
+ * the current surrogate is used until the new one is ready.
+ *
+ * The surrogate uses a constant mean (the training set mean) and a squared
+ * exponential kernel with one length scale per parameter,
+ * $$k(x, x^\prime) = A^2\exp\left[-\frac{1}{2}\sum_i\frac{(x_i - x^\prime_i)^2}{\ell^2_i}\right].$$
+ * The length scales are proportional to the training set standard deviation
+ * of each parameter, the proportionality factor is chosen from a fixed grid
+ * by maximizing the marginal likelihood, for which the amplitude $A^2$ is
+ * computed analytically. The training set keeps at most
+ * #NcmDataEmulator:max-train points, dropping the oldest ones first.
+ *
+ * To estimate the error of the values returned by the surrogate, every
+ * #NcmDataEmulator:check-every accepted predictions the wrapped #NcmData is
+ * evaluated anyway and the difference is accumulated, see
+ * ncm_data_emulator_get_mean_error(). The hit rate, the mean error, the
+ * predictive standard deviation at the last point and whether a surrogate
+ * was available there are registered as the #NcmMSetFuncList functions 
+ * "NcmDataEmulator:hit_rate", "NcmDataEmulator:mean_error", 
+ * "NcmDataEmulator:pred_sd" and "NcmDataEmulator:trained", they can be
+ * included in the catalog of the samplers as additional values, e.g.,
+ * using ncm_fit_esmcmc_new_funcs_array(). While there is no surrogate both
+ * "NcmDataEmulator:pred_sd" and "NcmDataEmulator:trained" are zero, keeping
+ * the catalog statistics finite.
+ *
+ * The training set belongs to each #NcmDataEmulator object and it is not
+ * shared between serialized copies. Samplers that duplicate the #NcmFit for
+ * each thread or process, see ncm_fit_esmcmc_set_nthreads() and
+ * ncm_fit_esmcmc_set_nprocs(), train one independent surrogate per copy,
+ * each one seeing only the evaluations done by its copy. For this reason the
+ * emulator must be used with single-threaded sampling, where a single
+ * surrogate is trained with all evaluations.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif /* HAVE_CONFIG_H */
+#include "build_cfg.h"
+
+#include "math/ncm_data_emulator.h"
+#include "math/ncm_mset_func_list.h"
+#include "math/ncm_cfg.h"
+
+#include <gsl/gsl_blas.h>
+
+enum
+{
+  PROP_0,
+  PROP_DATA,
+  PROP_TOL,
+  PROP_MIN_TRAIN,
+  PROP_MAX_TRAIN,
+  PROP_RETRAIN,
+  PROP_CHECK_EVERY,
+  PROP_BACKGROUND,
+  PROP_SIZE,
+};
+
+G_DEFINE_TYPE (NcmDataEmulator, ncm_data_emulator, NCM_TYPE_DATA);
+
+#define NCM_DATA_EMULATOR_JITTER (1.0e-8)
+
+struct _NcmDataEmulatorGP
+{
+  guint n;
+  guint dim;
+  NcmVector *ell;
+  NcmMatrix *X;
+  NcmMatrix *U;
+  NcmVector *alpha;
+  gdouble mean;
+  gdouble amp2;
+};
+
+static void _ncm_data_emulator_gp_free (NcmDataEmulatorGP *gp);
+
+static void
+ncm_data_emulator_init (NcmDataEmulator *emu)
+{
+  emu->data          = NULL;
+  emu->tol           = 0.0;
+  emu->min_train     = 0;
+  emu->max_train     = 0;
+  emu->retrain       = 0;
+  emu->check_every   = 0;
+  emu->background    = FALSE;
+  emu->dim           = 0;
+  emu->train         = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  emu->nnew          = 0;
+  emu->gen           = 0;
+  emu->gp            = NULL;
+  emu->x             = NULL;
+  emu->ncall         = 0;
+  emu->nhit          = 0;
+  emu->ncheck        = 0;
+  emu->ntrained      = 0;
+  emu->err_sum       = 0.0;
+  emu->err_max       = 0.0;
+  emu->last_sd       = 0.0;
+  emu->last_trained  = FALSE;
+  emu->trainer       = NULL;
+  emu->train_request = FALSE;
+  emu->stop          = FALSE;
+  g_mutex_init (&emu->lock);
+  g_cond_init (&emu->train_cond);
+}
+
+static void
+_ncm_data_emulator_constructed (GObject *object)
+{
+  /* Chain up : start */
+  G_OBJECT_CLASS (ncm_data_emulator_parent_class)->constructed (object);
+  {
+    NcmDataEmulator *emu = NCM_DATA_EMULATOR (object);
+    NcmData *data        = NCM_DATA (object);
+
+    g_assert (NCM_IS_DATA (emu->data));
+
+    ncm_data_take_desc (data, g_strdup_printf ("Emulator[%s]", ncm_data_peek_desc (emu->data)));
+    ncm_data_set_init (data, TRUE);
+  }
+}
+
+static void
+_ncm_data_emulator_set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (object);
+  g_return_if_fail (NCM_IS_DATA_EMULATOR (object));
+
+  switch (prop_id)
+  {
+    case PROP_DATA:
+      emu->data = g_value_dup_object (value);
+      break;
+    case PROP_TOL:
+      ncm_data_emulator_set_tol (emu, g_value_get_double (value));
+      break;
+    case PROP_MIN_TRAIN:
+      ncm_data_emulator_set_min_train (emu, g_value_get_uint (value));
+      break;
+    case PROP_MAX_TRAIN:
+      ncm_data_emulator_set_max_train (emu, g_value_get_uint (value));
+      break;
+    case PROP_RETRAIN:
+      ncm_data_emulator_set_retrain (emu, g_value_get_uint (value));
+      break;
+    case PROP_CHECK_EVERY:
+      ncm_data_emulator_set_check_every (emu, g_value_get_uint (value));
+      break;
+    case PROP_BACKGROUND:
+      ncm_data_emulator_set_background (emu, g_value_get_boolean (value));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+_ncm_data_emulator_get_property (GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (object);
+  g_return_if_fail (NCM_IS_DATA_EMULATOR (object));
+
+  switch (prop_id)
+  {
+    case PROP_DATA:
+      g_value_set_object (value, emu->data);
+      break;
+    case PROP_TOL:
+      g_value_set_double (value, emu->tol);
+      break;
+    case PROP_MIN_TRAIN:
+      g_value_set_uint (value, emu->min_train);
+      break;
+    case PROP_MAX_TRAIN:
+      g_value_set_uint (value, emu->max_train);
+      break;
+    case PROP_RETRAIN:
+      g_value_set_uint (value, emu->retrain);
+      break;
+    case PROP_CHECK_EVERY:
+      g_value_set_uint (value, emu->check_every);
+      break;
+    case PROP_BACKGROUND:
+      g_value_set_boolean (value, emu->background);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+_ncm_data_emulator_dispose (GObject *object)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (object);
+
+  if (emu->trainer != NULL)
+  {
+    g_mutex_lock (&emu->lock);
+    emu->stop = TRUE;
+    g_cond_signal (&emu->train_cond);
+    g_mutex_unlock (&emu->lock);
+
+    g_thread_join (emu->trainer);
+    emu->trainer = NULL;
+  }
+
+  ncm_data_clear (&emu->data);
+  ncm_vector_clear (&emu->x);
+  g_clear_pointer (&emu->gp, _ncm_data_emulator_gp_free);
+
+  /* Chain up : end */
+  G_OBJECT_CLASS (ncm_data_emulator_parent_class)->dispose (object);
+}
+
+static void
+_ncm_data_emulator_finalize (GObject *object)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (object);
+
+  g_array_unref (emu->train);
+  g_mutex_clear (&emu->lock);
+  g_cond_clear (&emu->train_cond);
+
+  /* Chain up : end */
+  G_OBJECT_CLASS (ncm_data_emulator_parent_class)->finalize (object);
+}
+
+static guint _ncm_data_emulator_get_length (NcmData *data);
+static guint _ncm_data_emulator_get_dof (NcmData *data);
+static void _ncm_data_emulator_resample (NcmData *data, NcmMSet *mset, NcmRNG *rng);
+static void _ncm_data_emulator_m2lnL_val (NcmData *data, NcmMSet *mset, gdouble *m2lnL);
+
+static void _ncm_data_emulator_flist_hit_rate (NcmMSetFuncList *flist, NcmMSet *mset, const gdouble *x, gdouble *res);
+static void _ncm_data_emulator_flist_mean_error (NcmMSetFuncList *flist, NcmMSet *mset, const gdouble *x, gdouble *res);
+static void _ncm_data_emulator_flist_pred_sd (NcmMSetFuncList *flist, NcmMSet *mset, const gdouble *x, gdouble *res);
+static void _ncm_data_emulator_flist_trained (NcmMSetFuncList *flist, NcmMSet *mset, const gdouble *x, gdouble *res);
+
+static void
+ncm_data_emulator_class_init (NcmDataEmulatorClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  NcmDataClass *data_class   = NCM_DATA_CLASS (klass);
+
+  object_class->constructed  = &_ncm_data_emulator_constructed;
+  object_class->set_property = &_ncm_data_emulator_set_property;
+  object_class->get_property = &_ncm_data_emulator_get_property;
+  object_class->dispose      = &_ncm_data_emulator_dispose;
+  object_class->finalize     = &_ncm_data_emulator_finalize;
+
+  g_object_class_install_property (object_class,
+                                   PROP_DATA,
+                                   g_param_spec_object ("data",
+                                                        NULL,
+                                                        "Emulated data",
+                                                        NCM_TYPE_DATA,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_TOL,
+                                   g_param_spec_double ("tol",
+                                                        NULL,
+                                                        "Maximum predictive standard deviation of -2lnL",
+                                                        0.0, G_MAXDOUBLE, 0.1,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_MIN_TRAIN,
+                                   g_param_spec_uint ("min-train",
+                                                      NULL,
+                                                      "Minimum number of training points",
+                                                      2, G_MAXUINT32, 50,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_MAX_TRAIN,
+                                   g_param_spec_uint ("max-train",
+                                                      NULL,
+                                                      "Maximum number of training points",
+                                                      2, G_MAXUINT32, 1000,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_RETRAIN,
+                                   g_param_spec_uint ("retrain",
+                                                      NULL,
+                                                      "Number of new points before retraining",
+                                                      1, G_MAXUINT32, 25,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_CHECK_EVERY,
+                                   g_param_spec_uint ("check-every",
+                                                      NULL,
+                                                      "Number of accepted predictions between checks (zero means no checks)",
+                                                      0, G_MAXUINT32, 50,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_BACKGROUND,
+                                   g_param_spec_boolean ("background",
+                                                         NULL,
+                                                         "Whether to train in a background thread",
+                                                         TRUE,
+                                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+
+  data_class->bootstrap  = FALSE;
+  data_class->get_length = &_ncm_data_emulator_get_length;
+  data_class->get_dof    = &_ncm_data_emulator_get_dof;
+  data_class->resample   = &_ncm_data_emulator_resample;
+  data_class->m2lnL_val  = &_ncm_data_emulator_m2lnL_val;
+
+  ncm_mset_func_list_register ("hit_rate",   "r_\\mathrm{emu}",      "NcmDataEmulator", "Emulator hit rate",                        NCM_TYPE_DATA_EMULATOR, _ncm_data_emulator_flist_hit_rate,   0, 1);
+  ncm_mset_func_list_register ("mean_error", "\\epsilon_\\mathrm{emu}", "NcmDataEmulator", "Emulator mean absolute error on -2lnL",  NCM_TYPE_DATA_EMULATOR, _ncm_data_emulator_flist_mean_error, 0, 1);
+  ncm_mset_func_list_register ("pred_sd",    "\\sigma_\\mathrm{emu}",  "NcmDataEmulator", "Emulator predictive standard deviation", NCM_TYPE_DATA_EMULATOR, _ncm_data_emulator_flist_pred_sd,    0, 1);
+  ncm_mset_func_list_register ("trained",    "t_\\mathrm{emu}",       "NcmDataEmulator", "Emulator surrogate available",           NCM_TYPE_DATA_EMULATOR, _ncm_data_emulator_flist_trained,    0, 1);
+}
+
+static guint
+_ncm_data_emulator_get_length (NcmData *data)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (data);
+  return ncm_data_get_length (emu->data);
+}
+
+static guint
+_ncm_data_emulator_get_dof (NcmData *data)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (data);
+  return ncm_data_get_dof (emu->data);
+}
+
+static void
+_ncm_data_emulator_resample (NcmData *data, NcmMSet *mset, NcmRNG *rng)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (data);
+
+  ncm_data_resample (emu->data, mset, rng);
+  ncm_data_emulator_reset (emu);
+}
+
+static void
+_ncm_data_emulator_gp_free (NcmDataEmulatorGP *gp)
+{
+  ncm_vector_clear (&gp->ell);
+  ncm_matrix_clear (&gp->X);
+  ncm_matrix_clear (&gp->U);
+  ncm_vector_clear (&gp->alpha);
+  g_slice_free (NcmDataEmulatorGP, gp);
+}
+
+/*
+ * Fits the surrogate to the n rows (dim parameters followed by -2lnL)
+ * in rows. Returns NULL if the kernel matrix could not be decomposed
+ * for any of the length scales tried.
+ */
+static NcmDataEmulatorGP *
+_ncm_data_emulator_gp_new (const gdouble *rows, const guint n, const guint dim)
+{
+  const gdouble scales[] = {0.125, 0.25, 0.5, 1.0, 2.0};
+  const guint nscales    = G_N_ELEMENTS (scales);
+  const guint rlen       = dim + 1;
+  NcmVector *sd          = ncm_vector_new (dim);
+  NcmVector *dy          = ncm_vector_new (n);
+  NcmDataEmulatorGP *best = NULL;
+  gdouble best_lnL       = GSL_NEGINF;
+  gdouble mean           = 0.0;
+  guint i, j, d, s;
+
+  for (i = 0; i < n; i++)
+    mean += rows[i * rlen + dim];
+  mean = mean / n;
+
+  for (i = 0; i < n; i++)
+    ncm_vector_set (dy, i, rows[i * rlen + dim] - mean);
+
+  for (d = 0; d < dim; d++)
+  {
+    gdouble mu = 0.0, var = 0.0;
+
+    for (i = 0; i < n; i++)
+      mu += rows[i * rlen + d];
+    mu = mu / n;
+
+    for (i = 0; i < n; i++)
+      var += gsl_pow_2 (rows[i * rlen + d] - mu);
+    var = var / n;
+
+    ncm_vector_set (sd, d, (var > 0.0) ? sqrt (var) : 1.0);
+  }
+
+  for (s = 0; s < nscales; s++)
+  {
+    NcmDataEmulatorGP *gp = g_slice_new (NcmDataEmulatorGP);
+    gdouble quad, lnL, ln_det = 0.0;
+
+    gp->n     = n;
+    gp->dim   = dim;
+    gp->ell   = ncm_vector_new (dim);
+    gp->X     = ncm_matrix_new (n, dim);
+    gp->U     = ncm_matrix_new (n, n);
+    gp->alpha = ncm_vector_dup (dy);
+    gp->mean  = mean;
+    gp->amp2  = 0.0;
+
+    for (d = 0; d < dim; d++)
+      ncm_vector_set (gp->ell, d, scales[s] * ncm_vector_get (sd, d));
+
+    for (i = 0; i < n; i++)
+    {
+      for (d = 0; d < dim; d++)
+        ncm_matrix_set (gp->X, i, d, rows[i * rlen + d] / ncm_vector_get (gp->ell, d));
+    }
+
+    for (i = 0; i < n; i++)
+    {
+      ncm_matrix_set (gp->U, i, i, 1.0 + NCM_DATA_EMULATOR_JITTER);
+      for (j = i + 1; j < n; j++)
+      {
+        gdouble r2 = 0.0;
+        gdouble k_ij;
+
+        for (d = 0; d < dim; d++)
+          r2 += gsl_pow_2 (ncm_matrix_get (gp->X, i, d) - ncm_matrix_get (gp->X, j, d));
+
+        k_ij = exp (-0.5 * r2);
+        ncm_matrix_set (gp->U, i, j, k_ij);
+        ncm_matrix_set (gp->U, j, i, k_ij);
+      }
+    }
+
+    if (ncm_matrix_cholesky_decomp (gp->U, 'U') != 0)
+    {
+      _ncm_data_emulator_gp_free (gp);
+      continue;
+    }
+
+    /* K = U^T U => K^{-1} dy = U^{-1} U^{-T} dy */
+    gsl_blas_dtrsv (CblasUpper, CblasTrans, CblasNonUnit, ncm_matrix_gsl (gp->U), ncm_vector_gsl (gp->alpha));
+    gsl_blas_dtrsv (CblasUpper, CblasNoTrans, CblasNonUnit, ncm_matrix_gsl (gp->U), ncm_vector_gsl (gp->alpha));
+    gsl_blas_ddot (ncm_vector_gsl (dy), ncm_vector_gsl (gp->alpha), &quad);
+
+    for (i = 0; i < n; i++)
+      ln_det += log (ncm_matrix_get (gp->U, i, i));
+
+    /* Amplitude maximizing the marginal likelihood. */
+    gp->amp2 = GSL_MAX (quad / n, GSL_DBL_MIN);
+    lnL      = -0.5 * n * log (gp->amp2) - ln_det;
+
+    if (lnL > best_lnL)
+    {
+      if (best != NULL)
+        _ncm_data_emulator_gp_free (best);
+      best     = gp;
+      best_lnL = lnL;
+    }
+    else
+      _ncm_data_emulator_gp_free (gp);
+  }
+
+  ncm_vector_free (sd);
+  ncm_vector_free (dy);
+
+  return best;
+}
+
+static void
+_ncm_data_emulator_gp_predict (NcmDataEmulatorGP *gp, NcmVector *x, gdouble *mu, gdouble *sd)
+{
+  NcmVector *k = ncm_vector_new (gp->n);
+  gdouble kalpha, vv;
+  guint i, d;
+
+  for (i = 0; i < gp->n; i++)
+  {
+    gdouble r2 = 0.0;
+
+    for (d = 0; d < gp->dim; d++)
+      r2 += gsl_pow_2 (ncm_vector_get (x, d) / ncm_vector_get (gp->ell, d) - ncm_matrix_get (gp->X, i, d));
+
+    ncm_vector_set (k, i, exp (-0.5 * r2));
+  }
+
+  gsl_blas_ddot (ncm_vector_gsl (k), ncm_vector_gsl (gp->alpha), &kalpha);
+  gsl_blas_dtrsv (CblasUpper, CblasTrans, CblasNonUnit, ncm_matrix_gsl (gp->U), ncm_vector_gsl (k));
+  gsl_blas_ddot (ncm_vector_gsl (k), ncm_vector_gsl (k), &vv);
+
+  mu[0] = gp->mean + kalpha;
+  sd[0] = sqrt (gp->amp2 * GSL_MAX (1.0 + NCM_DATA_EMULATOR_JITTER - vv, 0.0));
+
+  ncm_vector_free (k);
+}
+
+static void
+_ncm_data_emulator_train_sync (NcmDataEmulator *emu)
+{
+  gdouble *rows;
+  guint n, dim, gen;
+
+  g_mutex_lock (&emu->lock);
+  dim       = emu->dim;
+  gen       = emu->gen;
+  n         = (dim > 0) ? emu->train->len / (dim + 1) : 0;
+  rows      = (n > 1) ? g_memdup (emu->train->data, sizeof (gdouble) * emu->train->len) : NULL;
+  emu->nnew = 0;
+  g_mutex_unlock (&emu->lock);
+
+  if (rows != NULL)
+  {
+    NcmDataEmulatorGP *gp = _ncm_data_emulator_gp_new (rows, n, dim);
+    g_free (rows);
+
+    if (gp != NULL)
+    {
+      g_mutex_lock (&emu->lock);
+      if (gen == emu->gen)
+      {
+        NcmDataEmulatorGP *old_gp = emu->gp;
+
+        emu->gp = gp;
+        gp      = old_gp;
+        emu->ntrained++;
+      }
+      g_mutex_unlock (&emu->lock);
+
+      if (gp != NULL)
+        _ncm_data_emulator_gp_free (gp);
+    }
+  }
+}
+
+static gpointer
+_ncm_data_emulator_trainer (gpointer userdata)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (userdata);
+
+  g_mutex_lock (&emu->lock);
+  while (TRUE)
+  {
+    while (!emu->train_request && !emu->stop)
+      g_cond_wait (&emu->train_cond, &emu->lock);
+
+    if (emu->stop)
+      break;
+
+    emu->train_request = FALSE;
+    g_mutex_unlock (&emu->lock);
+
+    _ncm_data_emulator_train_sync (emu);
+
+    g_mutex_lock (&emu->lock);
+  }
+  g_mutex_unlock (&emu->lock);
+
+  return NULL;
+}
+
+static void
+_ncm_data_emulator_set_dim (NcmDataEmulator *emu, const guint dim)
+{
+  ncm_vector_clear (&emu->x);
+  emu->x   = ncm_vector_new (dim);
+  emu->dim = dim;
+  ncm_data_emulator_reset (emu);
+}
+
+static void
+_ncm_data_emulator_add_train (NcmDataEmulator *emu, const gdouble m2lnL)
+{
+  const guint rlen = emu->dim + 1;
+  gboolean train   = FALSE;
+
+  if (!gsl_finite (m2lnL))
+    return;
+
+  g_mutex_lock (&emu->lock);
+  {
+    guint n;
+
+    g_array_append_vals (emu->train, ncm_vector_data (emu->x), emu->dim);
+    g_array_append_val (emu->train, m2lnL);
+
+    n = emu->train->len / rlen;
+    if (n > emu->max_train)
+      g_array_remove_range (emu->train, 0, (n - emu->max_train) * rlen);
+
+    emu->nnew++;
+    if ((n >= emu->min_train) && ((emu->gp == NULL) || (emu->nnew >= emu->retrain)))
+    {
+      if (emu->background)
+      {
+        if (emu->trainer == NULL)
+          emu->trainer = g_thread_new ("NcmDataEmulator", &_ncm_data_emulator_trainer, emu);
+
+        emu->train_request = TRUE;
+        g_cond_signal (&emu->train_cond);
+      }
+      else
+        train = TRUE;
+    }
+  }
+  g_mutex_unlock (&emu->lock);
+
+  if (train)
+    _ncm_data_emulator_train_sync (emu);
+}
+
+static gboolean
+_ncm_data_emulator_predict_x (NcmDataEmulator *emu, gdouble *mu, gdouble *sd)
+{
+  gboolean has_gp;
+
+  g_mutex_lock (&emu->lock);
+  has_gp = (emu->gp != NULL);
+  if (has_gp)
+    _ncm_data_emulator_gp_predict (emu->gp, emu->x, mu, sd);
+  g_mutex_unlock (&emu->lock);
+
+  return has_gp;
+}
+
+static void
+_ncm_data_emulator_m2lnL_val (NcmData *data, NcmMSet *mset, gdouble *m2lnL)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (data);
+  const guint dim      = ncm_mset_fparams_len (mset);
+  gdouble mu, sd;
+
+  if (dim != emu->dim)
+    _ncm_data_emulator_set_dim (emu, dim);
+
+  ncm_mset_fparams_get_vector (mset, emu->x);
+  emu->ncall++;
+
+  /* Without a surrogate the point is always evaluated, the reported sd is zero. */
+  emu->last_trained = _ncm_data_emulator_predict_x (emu, &mu, &sd);
+  emu->last_sd      = emu->last_trained ? sd : 0.0;
+
+  if (!emu->last_trained)
+    sd = GSL_POSINF;
+
+  if (sd < emu->tol)
+  {
+    if ((emu->check_every > 0) && ((emu->nhit + emu->ncheck + 1) % emu->check_every == 0))
+    {
+      ncm_data_m2lnL_val (emu->data, mset, m2lnL);
+
+      if (gsl_finite (m2lnL[0]))
+      {
+        const gdouble err = fabs (mu - m2lnL[0]);
+
+        emu->err_sum += err;
+        emu->err_max  = GSL_MAX (emu->err_max, err);
+        emu->ncheck++;
+      }
+      _ncm_data_emulator_add_train (emu, m2lnL[0]);
+    }
+    else
+    {
+      m2lnL[0] = mu;
+      emu->nhit++;
+    }
+  }
+  else
+  {
+    ncm_data_m2lnL_val (emu->data, mset, m2lnL);
+    _ncm_data_emulator_add_train (emu, m2lnL[0]);
+  }
+}
+
+static void
+_ncm_data_emulator_flist_hit_rate (NcmMSetFuncList *flist, NcmMSet *mset, const gdouble *x, gdouble *res)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (flist->obj);
+  res[0] = ncm_data_emulator_get_hit_rate (emu);
+}
+
+static void
+_ncm_data_emulator_flist_mean_error (NcmMSetFuncList *flist, NcmMSet *mset, const gdouble *x, gdouble *res)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (flist->obj);
+  res[0] = ncm_data_emulator_get_mean_error (emu);
+}
+
+static void
+_ncm_data_emulator_flist_pred_sd (NcmMSetFuncList *flist, NcmMSet *mset, const gdouble *x, gdouble *res)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (flist->obj);
+  res[0] = emu->last_sd;
+}
+
+static void
+_ncm_data_emulator_flist_trained (NcmMSetFuncList *flist, NcmMSet *mset, const gdouble *x, gdouble *res)
+{
+  NcmDataEmulator *emu = NCM_DATA_EMULATOR (flist->obj);
+  res[0] = emu->last_trained ? 1.0 : 0.0;
+}
+
+/**
+ * ncm_data_emulator_new:
+ * @data: a #NcmData
+ * @tol: maximum predictive standard deviation of $-2\ln(L)$
+ *
+ * Creates a new #NcmDataEmulator wrapping @data.
+ *
+ * Returns: (transfer full): a new #NcmDataEmulator.
+ */
+NcmDataEmulator *
+ncm_data_emulator_new (NcmData *data, gdouble tol)
+{
+  NcmDataEmulator *emu = g_object_new (NCM_TYPE_DATA_EMULATOR,
+                                       "data", data,
+                                       "tol", tol,
+                                       NULL);
+  return emu;
+}
+
+/**
+ * ncm_data_emulator_set_tol:
+ * @emu: a #NcmDataEmulator
+ * @tol: maximum predictive standard deviation of $-2\ln(L)$
+ *
+ * Sets the tolerance: the surrogate value is used only when its predictive
+ * standard deviation is smaller than @tol.
+ *
+ */
+void
+ncm_data_emulator_set_tol (NcmDataEmulator *emu, gdouble tol)
+{
+  g_assert_cmpfloat (tol, >=, 0.0);
+  emu->tol = tol;
+}
+
+/**
+ * ncm_data_emulator_set_min_train:
+ * @emu: a #NcmDataEmulator
+ * @min_train: number of points
+ *
+ * Sets the minimum number of training points before the first surrogate
+ * is fitted.
+ *
+ */
+void
+ncm_data_emulator_set_min_train (NcmDataEmulator *emu, guint min_train)
+{
+  g_assert_cmpuint (min_train, >, 1);
+  emu->min_train = min_train;
+}
+
+/**
+ * ncm_data_emulator_set_max_train:
+ * @emu: a #NcmDataEmulator
+ * @max_train: number of points
+ *
+ * Sets the maximum number of training points, the fitting cost scales as
+ * the cube of this number.
+ *
+ */
+void
+ncm_data_emulator_set_max_train (NcmDataEmulator *emu, guint max_train)
+{
+  g_assert_cmpuint (max_train, >, 1);
+  emu->max_train = max_train;
+}
+
+/**
+ * ncm_data_emulator_set_retrain:
+ * @emu: a #NcmDataEmulator
+ * @retrain: number of points
+ *
+ * Sets the number of new training points that triggers a new fit.
+ *
+ */
+void
+ncm_data_emulator_set_retrain (NcmDataEmulator *emu, guint retrain)
+{
+  g_assert_cmpuint (retrain, >, 0);
+  emu->retrain = retrain;
+}
+
+/**
+ * ncm_data_emulator_set_check_every:
+ * @emu: a #NcmDataEmulator
+ * @check_every: number of accepted predictions
+ *
+ * Sets how often an accepted prediction is checked against the wrapped
+ * #NcmData, zero disables the checks.
+ *
+ */
+void
+ncm_data_emulator_set_check_every (NcmDataEmulator *emu, guint check_every)
+{
+  emu->check_every = check_every;
+}
+
+/**
+ * ncm_data_emulator_set_background:
+ * @emu: a #NcmDataEmulator
+ * @background: whether to train in a background thread
+ *
+ * Sets whether the surrogate is fitted in a background thread or in the
+ * call that completes the training set.
+ *
+ */
+void
+ncm_data_emulator_set_background (NcmDataEmulator *emu, gboolean background)
+{
+  emu->background = background;
+}
+
+/**
+ * ncm_data_emulator_get_tol:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: the tolerance on the predictive standard deviation.
+ */
+gdouble
+ncm_data_emulator_get_tol (NcmDataEmulator *emu)
+{
+  return emu->tol;
+}
+
+/**
+ * ncm_data_emulator_get_min_train:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: the minimum number of training points.
+ */
+guint
+ncm_data_emulator_get_min_train (NcmDataEmulator *emu)
+{
+  return emu->min_train;
+}
+
+/**
+ * ncm_data_emulator_get_max_train:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: the maximum number of training points.
+ */
+guint
+ncm_data_emulator_get_max_train (NcmDataEmulator *emu)
+{
+  return emu->max_train;
+}
+
+/**
+ * ncm_data_emulator_get_retrain:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: the number of new points that triggers a new fit.
+ */
+guint
+ncm_data_emulator_get_retrain (NcmDataEmulator *emu)
+{
+  return emu->retrain;
+}
+
+/**
+ * ncm_data_emulator_get_check_every:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: the number of accepted predictions between checks.
+ */
+guint
+ncm_data_emulator_get_check_every (NcmDataEmulator *emu)
+{
+  return emu->check_every;
+}
+
+/**
+ * ncm_data_emulator_get_background:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: whether the surrogate is fitted in a background thread.
+ */
+gboolean
+ncm_data_emulator_get_background (NcmDataEmulator *emu)
+{
+  return emu->background;
+}
+
+/**
+ * ncm_data_emulator_peek_data:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: (transfer none): the wrapped #NcmData.
+ */
+NcmData *
+ncm_data_emulator_peek_data (NcmDataEmulator *emu)
+{
+  return emu->data;
+}
+
+/**
+ * ncm_data_emulator_reset:
+ * @emu: a #NcmDataEmulator
+ *
+ * Removes all training points, the current surrogate and the statistics.
+ * This is called automatically when the data is resampled.
+ *
+ */
+void
+ncm_data_emulator_reset (NcmDataEmulator *emu)
+{
+  g_mutex_lock (&emu->lock);
+
+  g_array_set_size (emu->train, 0);
+  g_clear_pointer (&emu->gp, _ncm_data_emulator_gp_free);
+
+  emu->nnew     = 0;
+  emu->ncall    = 0;
+  emu->nhit     = 0;
+  emu->ncheck   = 0;
+  emu->ntrained = 0;
+  emu->err_sum  = 0.0;
+  emu->err_max  = 0.0;
+  emu->last_sd  = 0.0;
+  emu->last_trained = FALSE;
+  emu->gen++;
+
+  g_mutex_unlock (&emu->lock);
+}
+
+/**
+ * ncm_data_emulator_train:
+ * @emu: a #NcmDataEmulator
+ *
+ * Fits the surrogate to the current training set in the calling thread.
+ *
+ */
+void
+ncm_data_emulator_train (NcmDataEmulator *emu)
+{
+  _ncm_data_emulator_train_sync (emu);
+}
+
+/**
+ * ncm_data_emulator_predict:
+ * @emu: a #NcmDataEmulator
+ * @mset: a #NcmMSet
+ * @m2lnL: (out): surrogate value of $-2\ln(L)$
+ * @sd: (out): predictive standard deviation
+ *
+ * Computes the surrogate prediction at the free parameters of @mset.
+ *
+ * Returns: whether a surrogate is available.
+ */
+gboolean
+ncm_data_emulator_predict (NcmDataEmulator *emu, NcmMSet *mset, gdouble *m2lnL, gdouble *sd)
+{
+  const guint dim = ncm_mset_fparams_len (mset);
+
+  if (dim != emu->dim)
+    return FALSE;
+
+  ncm_mset_fparams_get_vector (mset, emu->x);
+  return _ncm_data_emulator_predict_x (emu, m2lnL, sd);
+}
+
+/**
+ * ncm_data_emulator_get_ntrain:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: the current number of training points.
+ */
+guint
+ncm_data_emulator_get_ntrain (NcmDataEmulator *emu)
+{
+  guint n;
+
+  g_mutex_lock (&emu->lock);
+  n = (emu->dim > 0) ? emu->train->len / (emu->dim + 1) : 0;
+  g_mutex_unlock (&emu->lock);
+
+  return n;
+}
+
+/**
+ * ncm_data_emulator_get_ncheck:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: the number of accepted predictions checked against the wrapped #NcmData.
+ */
+gulong
+ncm_data_emulator_get_ncheck (NcmDataEmulator *emu)
+{
+  return emu->ncheck;
+}
+
+/**
+ * ncm_data_emulator_get_nfit:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: the number of surrogate fits since the last reset.
+ */
+gulong
+ncm_data_emulator_get_nfit (NcmDataEmulator *emu)
+{
+  gulong nfit;
+
+  g_mutex_lock (&emu->lock);
+  nfit = emu->ntrained;
+  g_mutex_unlock (&emu->lock);
+
+  return nfit;
+}
+
+/**
+ * ncm_data_emulator_get_hit_rate:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: the fraction of the calls answered by the surrogate.
+ */
+gdouble
+ncm_data_emulator_get_hit_rate (NcmDataEmulator *emu)
+{
+  return (emu->ncall > 0) ? (emu->nhit * 1.0 / emu->ncall) : 0.0;
+}
+
+/**
+ * ncm_data_emulator_get_mean_error:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: the mean absolute error of the accepted predictions estimated
+ * from the checks (see ncm_data_emulator_set_check_every()), or NaN if no
+ * check was done.
+ */
+gdouble
+ncm_data_emulator_get_mean_error (NcmDataEmulator *emu)
+{
+  return (emu->ncheck > 0) ? (emu->err_sum / emu->ncheck) : GSL_NAN;
+}
+
+/**
+ * ncm_data_emulator_get_max_error:
+ * @emu: a #NcmDataEmulator
+ *
+ * Returns: the largest absolute error found in the checks.
+ */
+gdouble
+ncm_data_emulator_get_max_error (NcmDataEmulator *emu)
+{
+  return emu->err_max;
+}
+
+/**
+ * ncm_data_emulator_log_info:
+ * @emu: a #NcmDataEmulator
+ *
+ * Logs the emulator statistics.
+ *
+ */
+void
+ncm_data_emulator_log_info (NcmDataEmulator *emu)
+{
+  g_message ("# %s:\n", ncm_data_peek_desc (NCM_DATA (emu)));
+  g_message ("#   training points     %u, fits %lu.\n", ncm_data_emulator_get_ntrain (emu), emu->ntrained);
+  g_message ("#   calls               %lu, hit rate %.2f%%.\n", emu->ncall, 100.0 * ncm_data_emulator_get_hit_rate (emu));
+  g_message ("#   checks              %lu, mean error % 12.5e, max error % 12.5e.\n",
+             emu->ncheck, ncm_data_emulator_get_mean_error (emu), emu->err_max);
+}
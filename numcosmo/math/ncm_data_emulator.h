@@ -0,0 +1,121 @@
+/***************************************************************************
+ *            ncm_data_emulator.h
+ *
+ *  Sun October 18 18:12:41 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_data_emulator.h
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _NCM_DATA_EMULATOR_H_
+#define _NCM_DATA_EMULATOR_H_
+
+#include <glib.h>
+#include <glib-object.h>
+#include <numcosmo/build_cfg.h>
+#include <numcosmo/math/ncm_vector.h>
+#include <numcosmo/math/ncm_matrix.h>
+#include <numcosmo/math/ncm_data.h>
+
+G_BEGIN_DECLS
+
+#define NCM_TYPE_DATA_EMULATOR             (ncm_data_emulator_get_type ())
+#define NCM_DATA_EMULATOR(obj)             (G_TYPE_CHECK_INSTANCE_CAST ((obj), NCM_TYPE_DATA_EMULATOR, NcmDataEmulator))
+#define NCM_DATA_EMULATOR_CLASS(klass)     (G_TYPE_CHECK_CLASS_CAST ((klass), NCM_TYPE_DATA_EMULATOR, NcmDataEmulatorClass))
+#define NCM_IS_DATA_EMULATOR(obj)          (G_TYPE_CHECK_INSTANCE_TYPE ((obj), NCM_TYPE_DATA_EMULATOR))
+#define NCM_IS_DATA_EMULATOR_CLASS(klass)  (G_TYPE_CHECK_CLASS_TYPE ((klass), NCM_TYPE_DATA_EMULATOR))
+#define NCM_DATA_EMULATOR_GET_CLASS(obj)   (G_TYPE_INSTANCE_GET_CLASS ((obj), NCM_TYPE_DATA_EMULATOR, NcmDataEmulatorClass))
+
+typedef struct _NcmDataEmulatorClass NcmDataEmulatorClass;
+typedef struct _NcmDataEmulator NcmDataEmulator;
+typedef struct _NcmDataEmulatorGP NcmDataEmulatorGP;
+
+struct _NcmDataEmulatorClass
+{
+  /*< private >*/
+  NcmDataClass parent_class;
+};
+
+struct _NcmDataEmulator
+{
+  /*< private >*/
+  NcmData parent_instance;
+  NcmData *data;
+  gdouble tol;
+  guint min_train;
+  guint max_train;
+  guint retrain;
+  guint check_every;
+  gboolean background;
+  guint dim;
+  GArray *train;
+  guint nnew;
+  guint gen;
+  NcmDataEmulatorGP *gp;
+  NcmVector *x;
+  gulong ncall;
+  gulong nhit;
+  gulong ncheck;
+  gulong ntrained;
+  gdouble err_sum;
+  gdouble err_max;
+  gdouble last_sd;
+  gboolean last_trained;
+  GThread *trainer;
+  gboolean train_request;
+  gboolean stop;
+  GMutex lock;
+  GCond train_cond;
+};
+
+GType ncm_data_emulator_get_type (void) G_GNUC_CONST;
+
+NcmDataEmulator *ncm_data_emulator_new (NcmData *data, gdouble tol);
+
+void ncm_data_emulator_set_tol (NcmDataEmulator *emu, gdouble tol);
+void ncm_data_emulator_set_min_train (NcmDataEmulator *emu, guint min_train);
+void ncm_data_emulator_set_max_train (NcmDataEmulator *emu, guint max_train);
+void ncm_data_emulator_set_retrain (NcmDataEmulator *emu, guint retrain);
+void ncm_data_emulator_set_check_every (NcmDataEmulator *emu, guint check_every);
+void ncm_data_emulator_set_background (NcmDataEmulator *emu, gboolean background);
+
+gdouble ncm_data_emulator_get_tol (NcmDataEmulator *emu);
+guint ncm_data_emulator_get_min_train (NcmDataEmulator *emu);
+guint ncm_data_emulator_get_max_train (NcmDataEmulator *emu);
+guint ncm_data_emulator_get_retrain (NcmDataEmulator *emu);
+guint ncm_data_emulator_get_check_every (NcmDataEmulator *emu);
+gboolean ncm_data_emulator_get_background (NcmDataEmulator *emu);
+
+NcmData *ncm_data_emulator_peek_data (NcmDataEmulator *emu);
+
+void ncm_data_emulator_reset (NcmDataEmulator *emu);
+void ncm_data_emulator_train (NcmDataEmulator *emu);
+gboolean ncm_data_emulator_predict (NcmDataEmulator *emu, NcmMSet *mset, gdouble *m2lnL, gdouble *sd);
+
+guint ncm_data_emulator_get_ntrain (NcmDataEmulator *emu);
+gulong ncm_data_emulator_get_ncheck (NcmDataEmulator *emu);
+gulong ncm_data_emulator_get_nfit (NcmDataEmulator *emu);
+gdouble ncm_data_emulator_get_hit_rate (NcmDataEmulator *emu);
+gdouble ncm_data_emulator_get_mean_error (NcmDataEmulator *emu);
+gdouble ncm_data_emulator_get_max_error (NcmDataEmulator *emu);
+void ncm_data_emulator_log_info (NcmDataEmulator *emu);
+
+G_END_DECLS
+
+#endif /* _NCM_DATA_EMULATOR_H_ */
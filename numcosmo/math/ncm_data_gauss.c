@@ -255,6 +255,14 @@ _ncm_data_gauss_resample (NcmData *data, NcmMSet *mset, NcmRNG *rng)
   }
   ncm_rng_unlock (rng);
 
+  /* The observed values may be shared with other copies, see ncm_data_gauss_set_readonly(). */
+  if (ncm_vector_is_readonly (gauss->y))
+  {
+    NcmVector *y = ncm_vector_new (gauss->np);
+    ncm_vector_substitute (&gauss->y, y, TRUE);
+    ncm_vector_free (y);
+  }
+
   /* CblasLower, CblasTrans => CblasUpper, CblasNoTrans */
   ret = gsl_blas_dtrsv (CblasUpper, CblasNoTrans, CblasNonUnit, 
                         ncm_matrix_gsl (gauss->LLT), ncm_vector_gsl (gauss->v));
@@ -431,3 +439,24 @@ ncm_data_gauss_get_size (NcmDataGauss *gauss)
 {
   return NCM_DATA_GAUSS_GET_CLASS (gauss)->get_size (gauss);
 }
+
+/**
+ * ncm_data_gauss_set_readonly:
+ * @gauss: a #NcmDataGauss
+ *
+ * Marks the observed values and, when the class does not implement
+ * inv_cov_func, the inverse covariance as read-only (see ncm_vector_set_readonly()).
+ * The copies made with ncm_fit_clone() then share them instead of
+ * duplicating them. Resampling @gauss replaces the observed values by
+ * a private vector before writing.
+ * 
+ */
+void 
+ncm_data_gauss_set_readonly (NcmDataGauss *gauss)
+{
+  g_assert (gauss->np > 0);
+
+  ncm_vector_set_readonly (gauss->y, TRUE);
+  if (NCM_DATA_GAUSS_GET_CLASS (gauss)->inv_cov_func == NULL)
+    ncm_matrix_set_readonly (gauss->inv_cov, TRUE);
+}
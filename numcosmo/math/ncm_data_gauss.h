@@ -69,6 +69,7 @@ GType ncm_data_gauss_get_type (void) G_GNUC_CONST;
 
 void ncm_data_gauss_set_size (NcmDataGauss *gauss, guint np);
 guint ncm_data_gauss_get_size (NcmDataGauss *gauss);
+void ncm_data_gauss_set_readonly (NcmDataGauss *gauss);
 
 G_END_DECLS
 
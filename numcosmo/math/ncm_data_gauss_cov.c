@@ -29,6 +29,23 @@
  * @short_description: Gaussian data -- covariance provided.
  *
  * Generic gaussian distribution which uses the covariance matrix as input.
+ * 
+ * The Cholesky decomposition of the covariance and the normalization 
+ * term (when #NcmDataGaussCov:use-norma is set and the default lnNorma2
+ * is used) are computed only when cov_func reports an update. Many mean
+ * vectors can be evaluated against the same decomposition using 
+ * ncm_data_gauss_cov_m2lnL_val_batch(). This is also used to implement
+ * ncm_data_m2lnL_val_batch() when the covariance does not depend on the
+ * models, i.e., when cov_func is not implemented.
+ * 
+ * When the covariance is block-diagonal, e.g., independent surveys or 
+ * tomographic bins, the block sizes can be set using 
+ * ncm_data_gauss_cov_set_blocks() or found from the current covariance
+ * using ncm_data_gauss_cov_detect_blocks(). In this case the Cholesky 
+ * decomposition and the triangular solves are computed block by block,
+ * the cost scales with the sum of the cubes of the block sizes instead of
+ * the cube of the data size. The covariance elements outside the diagonal
+ * blocks are ignored.
  *
  */
 
@@ -41,6 +58,7 @@
 #include "math/ncm_cfg.h"
 #include "math/ncm_data_gauss_cov.h"
 #include "math/ncm_lapack.h"
+#include "math/ncm_profiler.h"
 
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_linalg.h>
@@ -53,6 +71,7 @@ enum
   PROP_USE_NORMA,
   PROP_MEAN,
   PROP_COV,
+  PROP_BLOCKS,
   PROP_SIZE,
 };
 
@@ -68,6 +87,9 @@ ncm_data_gauss_cov_init (NcmDataGaussCov *gauss)
   gauss->LLT          = NULL;
   gauss->prepared_LLT = FALSE;
   gauss->use_norma    = FALSE;
+  gauss->lnNorma2     = 0.0;
+  gauss->prepared_lnNorma2 = FALSE;
+  gauss->blocks       = NULL;
 }
 
 static void
@@ -101,7 +123,20 @@ _ncm_data_gauss_cov_set_property (GObject *object, guint prop_id, const GValue *
     }
     case PROP_COV:
       ncm_matrix_substitute (&gauss->cov, g_value_get_object (value), TRUE);
+      gauss->prepared_LLT = FALSE;
       break;
+    case PROP_BLOCKS:
+    {
+      GVariant *var = g_value_get_variant (value);
+      if (var != NULL)
+      {
+        GArray *blocks = g_array_new (FALSE, FALSE, sizeof (guint32));
+        ncm_cfg_array_set_variant (blocks, var);
+        ncm_data_gauss_cov_set_blocks (gauss, (blocks->len > 0) ? blocks : NULL);
+        g_array_unref (blocks);
+      }
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -128,6 +163,12 @@ _ncm_data_gauss_cov_get_property (GObject *object, guint prop_id, GValue *value,
     case PROP_COV:
       g_value_set_object (value, gauss->cov);
       break;
+    case PROP_BLOCKS:
+      if (gauss->blocks != NULL)
+        g_value_take_variant (value, ncm_cfg_array_to_variant (gauss->blocks, G_VARIANT_TYPE ("u")));
+      else
+        g_value_set_variant (value, NULL);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -144,6 +185,8 @@ _ncm_data_gauss_cov_dispose (GObject *object)
   ncm_matrix_clear (&gauss->cov);
   ncm_matrix_clear (&gauss->LLT);
 
+  g_clear_pointer (&gauss->blocks, g_array_unref);
+
   /* Chain up : end */
   G_OBJECT_CLASS (ncm_data_gauss_cov_parent_class)->dispose (object);
 }
@@ -160,6 +203,7 @@ static guint _ncm_data_gauss_cov_get_length (NcmData *data);
 /* static void _ncm_data_gauss_cov_begin (NcmData *data); */
 static void _ncm_data_gauss_cov_resample (NcmData *data, NcmMSet *mset, NcmRNG *rng);
 static void _ncm_data_gauss_cov_m2lnL_val (NcmData *data, NcmMSet *mset, gdouble *m2lnL);
+static void _ncm_data_gauss_cov_m2lnL_val_batch (NcmData *data, NcmMSet *mset, NcmMatrix *fparams, NcmVector *m2lnL_v);
 static void _ncm_data_gauss_cov_leastsquares_f (NcmData *data, NcmMSet *mset, NcmVector *v);
 static void _ncm_data_gauss_cov_mean_vector (NcmData *data, NcmMSet *mset, NcmVector *mu);
 static void _ncm_data_gauss_cov_inv_cov_UH (NcmData *data, NcmMSet *mset, NcmMatrix *H);
@@ -214,6 +258,14 @@ ncm_data_gauss_cov_class_init (NcmDataGaussCovClass *klass)
                                                         NCM_TYPE_MATRIX,
                                                         G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
 
+  g_object_class_install_property (object_class,
+                                   PROP_BLOCKS,
+                                   g_param_spec_variant ("blocks",
+                                                         NULL,
+                                                         "Sizes of the covariance diagonal blocks",
+                                                         G_VARIANT_TYPE ("au"), NULL,
+                                                         G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+
   data_class->bootstrap          = TRUE;
 
   data_class->get_length         = &_ncm_data_gauss_cov_get_length;
@@ -222,6 +274,7 @@ ncm_data_gauss_cov_class_init (NcmDataGaussCovClass *klass)
 
   data_class->resample           = &_ncm_data_gauss_cov_resample;
   data_class->m2lnL_val          = &_ncm_data_gauss_cov_m2lnL_val;
+  data_class->m2lnL_val_batch    = &_ncm_data_gauss_cov_m2lnL_val_batch;
   data_class->leastsquares_f     = &_ncm_data_gauss_cov_leastsquares_f;
 
   data_class->mean_vector        = &_ncm_data_gauss_cov_mean_vector;
@@ -241,18 +294,111 @@ _ncm_data_gauss_cov_get_length (NcmData *data)
   return NCM_DATA_GAUSS_COV (data)->np;
 }
 
+static gint
+_ncm_data_gauss_cov_blocks_cholesky_decomp (NcmDataGaussCov *gauss)
+{
+  const guint nblocks = gauss->blocks->len;
+  guint k = 0;
+  guint b;
+
+  for (b = 0; b < nblocks; b++)
+    k += g_array_index (gauss->blocks, guint32, b);
+  if (k != gauss->np)
+    g_error ("_ncm_data_gauss_cov_blocks_cholesky_decomp: the sum of the block sizes (%u) differs from the data size (%u).",
+             k, gauss->np);
+  k = 0;
+
+  if (gauss->LLT == NULL)
+  {
+    gauss->LLT = ncm_matrix_new (gauss->np, gauss->np);
+    ncm_matrix_set_zero (gauss->LLT);
+  }
+
+  for (b = 0; b < nblocks; b++)
+  {
+    const guint bsize      = g_array_index (gauss->blocks, guint32, b);
+    gsl_matrix_view cov_b  = gsl_matrix_submatrix (ncm_matrix_gsl (gauss->cov), k, k, bsize, bsize);
+    gsl_matrix_view LLT_b  = gsl_matrix_submatrix (ncm_matrix_gsl (gauss->LLT), k, k, bsize, bsize);
+    gint ret;
+
+    gsl_matrix_memcpy (&LLT_b.matrix, &cov_b.matrix);
+    ret = ncm_lapack_dpotrf ('U', bsize, ncm_matrix_ptr (gauss->LLT, k, k), ncm_matrix_tda (gauss->LLT));
+    if (ret != 0)
+      return ret;
+
+    k += bsize;
+  }
+
+  return 0;
+}
+
+static gint
+_ncm_data_gauss_cov_cholesky_decomp (NcmDataGaussCov *gauss)
+{
+  if (gauss->blocks != NULL)
+    return _ncm_data_gauss_cov_blocks_cholesky_decomp (gauss);
+  else
+  {
+    if (gauss->LLT == NULL)
+      gauss->LLT = ncm_matrix_dup (gauss->cov);
+    else
+      ncm_matrix_memcpy (gauss->LLT, gauss->cov);
+
+    return ncm_matrix_cholesky_decomp (gauss->LLT, 'U');
+  }
+}
+
+/*
+ * Solves L v_out = v_in in place, where cov = L L^T, block by block
+ * when the block structure is set.
+ */
+static gint
+_ncm_data_gauss_cov_LLT_solve (NcmDataGaussCov *gauss, NcmVector *v)
+{
+  if (gauss->blocks != NULL)
+  {
+    const guint nblocks = gauss->blocks->len;
+    guint k = 0;
+    guint b;
+
+    for (b = 0; b < nblocks; b++)
+    {
+      const guint bsize     = g_array_index (gauss->blocks, guint32, b);
+      gsl_matrix_view LLT_b = gsl_matrix_submatrix (ncm_matrix_gsl (gauss->LLT), k, k, bsize, bsize);
+      gsl_vector_view v_b   = gsl_vector_subvector (ncm_vector_gsl (v), k, bsize);
+
+      /* CblasLower, CblasNoTrans => CblasUpper, CblasTrans */
+      const gint ret = gsl_blas_dtrsv (CblasUpper, CblasTrans, CblasNonUnit, &LLT_b.matrix, &v_b.vector);
+      if (ret != GSL_SUCCESS)
+        return ret;
+
+      k += bsize;
+    }
+
+    return GSL_SUCCESS;
+  }
+  else
+  {
+    /* CblasLower, CblasNoTrans => CblasUpper, CblasTrans */
+    return gsl_blas_dtrsv (CblasUpper, CblasTrans, CblasNonUnit,
+                           ncm_matrix_gsl (gauss->LLT), ncm_vector_gsl (v));
+  }
+}
+
 static void
 _ncm_data_gauss_cov_prepare_LLT (NcmData *data)
 {
   gint ret;
   NcmDataGaussCov *gauss = NCM_DATA_GAUSS_COV (data);
 
-  if (gauss->LLT == NULL)
-    gauss->LLT = ncm_matrix_dup (gauss->cov);
+  if (G_UNLIKELY (ncm_profiler_is_enabled ()))
+  {
+    const gdouble t0 = ncm_profiler_time ();
+    ret = _ncm_data_gauss_cov_cholesky_decomp (gauss);
+    ncm_profiler_add_call ("NcmDataGaussCov:cholesky_decomp", ncm_profiler_time () - t0);
+  }
   else
-    ncm_matrix_memcpy (gauss->LLT, gauss->cov);
-
-  ret = ncm_matrix_cholesky_decomp (gauss->LLT, 'U');
+    ret = _ncm_data_gauss_cov_cholesky_decomp (gauss);
   if (ret != 0) /* if different from 0, something went wrong in the Cholesky decomposition */
   {
     // g_error ("_ncm_data_gauss_cov_prepare_LLT[ncm_matrix_cholesky_decomp]: %d.", ret);
@@ -261,6 +407,8 @@ _ncm_data_gauss_cov_prepare_LLT (NcmData *data)
   }
   else
     gauss->prepared_LLT = TRUE;
+
+  gauss->prepared_lnNorma2 = FALSE;
 }
 
 static void
@@ -291,6 +439,14 @@ _ncm_data_gauss_cov_resample (NcmData *data, NcmMSet *mset, NcmRNG *rng)
                         ncm_matrix_gsl (gauss->LLT), ncm_vector_gsl (gauss->v));
   NCM_TEST_GSL_RESULT ("_ncm_data_gauss_cov_resample", ret);
 
+  /* The observed values may be shared with other copies, see ncm_data_gauss_cov_set_readonly(). */
+  if (ncm_vector_is_readonly (gauss->y))
+  {
+    NcmVector *y = ncm_vector_new (gauss->np);
+    ncm_vector_substitute (&gauss->y, y, TRUE);
+    ncm_vector_free (y);
+  }
+
   gauss_cov_class->mean_func (gauss, mset, gauss->y);
   ncm_vector_sub (gauss->y, gauss->v);
 }
@@ -336,6 +492,30 @@ _ncm_data_gauss_cov_lnNorma2_bs (NcmDataGaussCov *gauss, NcmMSet *mset, NcmBoots
   *m2lnL += gauss->np * ncm_c_ln2pi () + 2.0 * log (detL);
 }
 
+/*
+ * The default normalization depends only on the Cholesky decomposition, 
+ * so it is computed once per decomposition. Subclasses overriding lnNorma2
+ * may depend on @mset and are always called.
+ */
+static void
+_ncm_data_gauss_cov_add_lnNorma2 (NcmDataGaussCov *gauss, NcmMSet *mset, gdouble *m2lnL)
+{
+  NcmDataGaussCovClass *gauss_cov_class = NCM_DATA_GAUSS_COV_GET_CLASS (gauss);
+
+  if (gauss_cov_class->lnNorma2 == &_ncm_data_gauss_cov_lnNorma2)
+  {
+    if (!gauss->prepared_lnNorma2)
+    {
+      gauss->lnNorma2 = 0.0;
+      _ncm_data_gauss_cov_lnNorma2 (gauss, mset, &gauss->lnNorma2);
+      gauss->prepared_lnNorma2 = TRUE;
+    }
+    *m2lnL += gauss->lnNorma2;
+  }
+  else
+    gauss_cov_class->lnNorma2 (gauss, mset, m2lnL);
+}
+
 static void
 _ncm_data_gauss_cov_m2lnL_val (NcmData *data, NcmMSet *mset, gdouble *m2lnL)
 {
@@ -362,9 +542,7 @@ _ncm_data_gauss_cov_m2lnL_val (NcmData *data, NcmMSet *mset, gdouble *m2lnL)
     return;
   }
 
-  /* CblasLower, CblasNoTrans => CblasUpper, CblasTrans */
-  ret = gsl_blas_dtrsv (CblasUpper, CblasTrans, CblasNonUnit,
-                        ncm_matrix_gsl (gauss->LLT), ncm_vector_gsl (gauss->v));
+  ret = _ncm_data_gauss_cov_LLT_solve (gauss, gauss->v);
   NCM_TEST_GSL_RESULT ("_ncm_data_gauss_cov_m2lnL_val", ret);
 
   if (!ncm_data_bootstrap_enabled (data))
@@ -375,9 +553,7 @@ _ncm_data_gauss_cov_m2lnL_val (NcmData *data, NcmMSet *mset, gdouble *m2lnL)
     NCM_TEST_GSL_RESULT ("_ncm_data_gauss_cov_m2lnL_val", ret);
 
     if (gauss->use_norma)
-    {
-      gauss_cov_class->lnNorma2 (gauss, mset, m2lnL);
-    }
+      _ncm_data_gauss_cov_add_lnNorma2 (gauss, mset, m2lnL);
   }
   else
   {
@@ -396,6 +572,55 @@ _ncm_data_gauss_cov_m2lnL_val (NcmData *data, NcmMSet *mset, gdouble *m2lnL)
   }
 }
 
+static void
+_ncm_data_gauss_cov_m2lnL_val_batch (NcmData *data, NcmMSet *mset, NcmMatrix *fparams, NcmVector *m2lnL_v)
+{
+  NcmDataGaussCov *gauss = NCM_DATA_GAUSS_COV (data);
+  NcmDataGaussCovClass *gauss_cov_class = NCM_DATA_GAUSS_COV_GET_CLASS (gauss);
+  const guint npoints = ncm_matrix_nrows (fparams);
+  guint a;
+
+  /*
+   * The Cholesky decomposition can only be shared when the covariance 
+   * does not depend on the models and m2lnL_val was not overridden.
+   */
+  if ((gauss_cov_class->cov_func != NULL) || 
+      (NCM_DATA_CLASS (gauss_cov_class)->m2lnL_val != &_ncm_data_gauss_cov_m2lnL_val))
+  {
+    for (a = 0; a < npoints; a++)
+    {
+      NcmVector *fparams_a = ncm_matrix_get_row (fparams, a);
+      gdouble m2lnL_a;
+
+      ncm_mset_fparams_set_vector (mset, fparams_a);
+      ncm_data_m2lnL_val (data, mset, &m2lnL_a);
+      ncm_vector_set (m2lnL_v, a, m2lnL_a);
+
+      ncm_vector_free (fparams_a);
+    }
+  }
+  else
+  {
+    NcmMatrix *mu = ncm_matrix_new (npoints, gauss->np);
+
+    for (a = 0; a < npoints; a++)
+    {
+      NcmVector *fparams_a = ncm_matrix_get_row (fparams, a);
+      NcmVector *mu_a      = ncm_matrix_get_row (mu, a);
+
+      ncm_mset_fparams_set_vector (mset, fparams_a);
+      ncm_data_prepare (data, mset);
+      gauss_cov_class->mean_func (gauss, mset, mu_a);
+
+      ncm_vector_free (fparams_a);
+      ncm_vector_free (mu_a);
+    }
+
+    ncm_data_gauss_cov_m2lnL_val_batch (gauss, mset, mu, m2lnL_v);
+    ncm_matrix_free (mu);
+  }
+}
+
 static void
 _ncm_data_gauss_cov_leastsquares_f (NcmData *data, NcmMSet *mset, NcmVector *v)
 {
@@ -416,9 +641,7 @@ _ncm_data_gauss_cov_leastsquares_f (NcmData *data, NcmMSet *mset, NcmVector *v)
   if (cov_update || !gauss->prepared_LLT)
     _ncm_data_gauss_cov_prepare_LLT (data);
 
-  /* CblasLower, CblasNoTrans => CblasUpper, CblasTrans */
-  ret = gsl_blas_dtrsv (CblasUpper, CblasTrans, CblasNonUnit,
-                        ncm_matrix_gsl (gauss->LLT), ncm_vector_gsl (v));
+  ret = _ncm_data_gauss_cov_LLT_solve (gauss, v);
   NCM_TEST_GSL_RESULT ("_ncm_data_gauss_cov_leastsquares_f", ret);
 }
 
@@ -462,6 +685,8 @@ _ncm_data_gauss_cov_set_size (NcmDataGaussCov *gauss, guint np)
     ncm_vector_clear (&gauss->v);
     ncm_matrix_clear (&gauss->cov);
     ncm_matrix_clear (&gauss->LLT);
+    gauss->prepared_LLT      = FALSE;
+    gauss->prepared_lnNorma2 = FALSE;
     data->init = FALSE;
   }
   if ((np != 0) && (np != gauss->np))
@@ -511,3 +736,224 @@ guint ncm_data_gauss_cov_get_size (NcmDataGaussCov *gauss)
 {
   return NCM_DATA_GAUSS_COV_GET_CLASS (gauss)->get_size (gauss);
 }
+
+/**
+ * ncm_data_gauss_cov_set_readonly:
+ * @gauss: a #NcmDataGaussCov
+ *
+ * Marks the observed values and, when the class does not implement
+ * cov_func, the covariance as read-only (see ncm_vector_set_readonly()).
+ * The copies made with ncm_fit_clone() then share them instead of
+ * duplicating them. Resampling @gauss replaces the observed values by
+ * a private vector before writing.
+ *
+ */
+void 
+ncm_data_gauss_cov_set_readonly (NcmDataGaussCov *gauss)
+{
+  g_assert (gauss->np > 0);
+
+  ncm_vector_set_readonly (gauss->y, TRUE);
+  if (NCM_DATA_GAUSS_COV_GET_CLASS (gauss)->cov_func == NULL)
+    ncm_matrix_set_readonly (gauss->cov, TRUE);
+}
+
+/**
+ * ncm_data_gauss_cov_set_blocks:
+ * @gauss: a #NcmDataGaussCov
+ * @blocks: (allow-none) (array) (element-type guint32): sizes of the diagonal blocks
+ *
+ * Sets the covariance block structure, the covariance is assumed to 
+ * be block-diagonal with contiguous diagonal blocks of sizes given by @blocks. 
+ * The sum of the block sizes must be equal to the data size. When @blocks
+ * is NULL the covariance is treated as a dense matrix.
+ *
+ */
+void 
+ncm_data_gauss_cov_set_blocks (NcmDataGaussCov *gauss, GArray *blocks)
+{
+  g_clear_pointer (&gauss->blocks, g_array_unref);
+
+  if (blocks != NULL)
+  {
+    guint total = 0;
+    guint b;
+
+    for (b = 0; b < blocks->len; b++)
+    {
+      const guint bsize = g_array_index (blocks, guint32, b);
+      if (bsize == 0)
+        g_error ("ncm_data_gauss_cov_set_blocks: empty block %u.", b);
+      total += bsize;
+    }
+
+    if ((gauss->np != 0) && (total != gauss->np))
+      g_error ("ncm_data_gauss_cov_set_blocks: the sum of the block sizes (%u) differs from the data size (%u).",
+               total, gauss->np);
+
+    gauss->blocks = g_array_sized_new (FALSE, FALSE, sizeof (guint32), blocks->len);
+    g_array_append_vals (gauss->blocks, blocks->data, blocks->len);
+  }
+
+  /* The factor must be recomputed and the entries outside the blocks zeroed. */
+  ncm_matrix_clear (&gauss->LLT);
+  gauss->prepared_LLT      = FALSE;
+  gauss->prepared_lnNorma2 = FALSE;
+}
+
+/**
+ * ncm_data_gauss_cov_peek_blocks:
+ * @gauss: a #NcmDataGaussCov
+ *
+ * Gets the covariance block structure, see ncm_data_gauss_cov_set_blocks().
+ *
+ * Returns: (transfer none) (array) (element-type guint32) (allow-none): the block sizes or NULL.
+ */
+GArray *
+ncm_data_gauss_cov_peek_blocks (NcmDataGaussCov *gauss)
+{
+  return gauss->blocks;
+}
+
+/**
+ * ncm_data_gauss_cov_detect_blocks:
+ * @gauss: a #NcmDataGaussCov
+ *
+ * Finds the finest partition of the current covariance matrix in contiguous
+ * diagonal blocks, i.e., such that all elements outside the blocks are exactly
+ * zero, and sets it using ncm_data_gauss_cov_set_blocks(). If only one block is
+ * found the covariance is treated as dense. This must be called again if the
+ * sparsity pattern of the covariance changes.
+ *
+ * Returns: the number of blocks found.
+ */
+guint
+ncm_data_gauss_cov_detect_blocks (NcmDataGaussCov *gauss)
+{
+  GArray *blocks = g_array_new (FALSE, FALSE, sizeof (guint32));
+  guint start    = 0;
+  guint end      = 0;
+  guint nblocks;
+  guint i;
+
+  for (i = 0; i < gauss->np; i++)
+  {
+    guint j;
+
+    /* Last non-zero column in the upper part of row i. */
+    for (j = gauss->np - 1; j > end; j--)
+    {
+      if (ncm_matrix_get (gauss->cov, i, j) != 0.0)
+        break;
+    }
+    end = GSL_MAX (end, j);
+
+    if (i == end)
+    {
+      const guint32 bsize = end - start + 1;
+      g_array_append_val (blocks, bsize);
+      start = end = i + 1;
+    }
+  }
+
+  nblocks = blocks->len;
+  ncm_data_gauss_cov_set_blocks (gauss, (nblocks > 1) ? blocks : NULL);
+  g_array_unref (blocks);
+
+  return nblocks;
+}
+
+/**
+ * ncm_data_gauss_cov_m2lnL_val_batch:
+ * @gauss: a #NcmDataGaussCov
+ * @mset: a #NcmMSet
+ * @mu: a #NcmMatrix containing one mean vector per row
+ * @m2lnL: a #NcmVector
+ *
+ * Computes $-2\ln(L)$ for each mean vector in the rows of @mu using the
+ * data and the covariance of @gauss, the covariance is computed using 
+ * @mset. All rows are whitened by a single triangular solve (dtrsm)
+ * against the Cholesky decomposition, which is computed only if the 
+ * covariance changed. This is useful to evaluate the likelihood for
+ * several points sharing the same covariance, e.g., the walkers of an
+ * ensemble sampler. On exit @mu contains the whitened residuals.
+ *
+ * The number of columns of @mu must be equal to the data size and the
+ * length of @m2lnL equal to the number of rows of @mu.
+ *
+ */
+void 
+ncm_data_gauss_cov_m2lnL_val_batch (NcmDataGaussCov *gauss, NcmMSet *mset, NcmMatrix *mu, NcmVector *m2lnL)
+{
+  NcmData *data = NCM_DATA (gauss);
+  NcmDataGaussCovClass *gauss_cov_class = NCM_DATA_GAUSS_COV_GET_CLASS (gauss);
+  const guint nmu = ncm_matrix_nrows (mu);
+  gboolean cov_update = FALSE;
+  gdouble norma = 0.0;
+  gint ret;
+  guint a;
+
+  g_assert_cmpuint (ncm_matrix_ncols (mu), ==, gauss->np);
+  g_assert_cmpuint (ncm_vector_len (m2lnL), ==, nmu);
+
+  if (gauss_cov_class->cov_func != NULL)
+    cov_update = gauss_cov_class->cov_func (gauss, mset, gauss->cov);
+
+  if (cov_update || !gauss->prepared_LLT)
+    _ncm_data_gauss_cov_prepare_LLT (data);
+
+  if (!gauss->prepared_LLT) /* that means that the Cholesky decomposition has not worked */
+  {
+    ncm_vector_set_all (m2lnL, GSL_POSINF);
+    return;
+  }
+
+  for (a = 0; a < nmu; a++)
+  {
+    NcmVector *mu_a = ncm_matrix_get_row (mu, a);
+    ncm_vector_sub (mu_a, gauss->y);
+    ncm_vector_free (mu_a);
+  }
+
+  /* X U = (mu - y) => X = (mu - y) U^{-1}, i.e., each row is whitened by U^{-T}. */
+  ret = gsl_blas_dtrsm (CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit, 
+                        1.0, ncm_matrix_gsl (gauss->LLT), ncm_matrix_gsl (mu));
+  NCM_TEST_GSL_RESULT ("ncm_data_gauss_cov_m2lnL_val_batch", ret);
+
+  if (gauss->use_norma)
+  {
+    if (ncm_data_bootstrap_enabled (data))
+      gauss_cov_class->lnNorma2_bs (gauss, mset, data->bstrap, &norma);
+    else
+      _ncm_data_gauss_cov_add_lnNorma2 (gauss, mset, &norma);
+  }
+
+  for (a = 0; a < nmu; a++)
+  {
+    gdouble m2lnL_a = 0.0;
+
+    if (!ncm_data_bootstrap_enabled (data))
+    {
+      NcmVector *mu_a = ncm_matrix_get_row (mu, a);
+
+      ret = gsl_blas_ddot (ncm_vector_gsl (mu_a), ncm_vector_gsl (mu_a), &m2lnL_a);
+      NCM_TEST_GSL_RESULT ("ncm_data_gauss_cov_m2lnL_val_batch", ret);
+
+      ncm_vector_free (mu_a);
+    }
+    else
+    {
+      const guint bsize = ncm_bootstrap_get_bsize (data->bstrap);
+      guint i;
+
+      for (i = 0; i < bsize; i++)
+      {
+        const guint k     = ncm_bootstrap_get (data->bstrap, i);
+        const gdouble u_i = ncm_matrix_get (mu, a, k);
+        m2lnL_a += u_i * u_i;
+      }
+    }
+
+    ncm_vector_set (m2lnL, a, m2lnL_a + norma);
+  }
+}
@@ -67,12 +67,22 @@ struct _NcmDataGaussCov
   NcmMatrix *LLT;
   gboolean prepared_LLT;
   gboolean use_norma;
+  gdouble lnNorma2;
+  gboolean prepared_lnNorma2;
+  GArray *blocks;
 };
 
 GType ncm_data_gauss_cov_get_type (void) G_GNUC_CONST;
 
 void ncm_data_gauss_cov_set_size (NcmDataGaussCov *gauss, guint np);
 guint ncm_data_gauss_cov_get_size (NcmDataGaussCov *gauss);
+void ncm_data_gauss_cov_set_readonly (NcmDataGaussCov *gauss);
+
+void ncm_data_gauss_cov_set_blocks (NcmDataGaussCov *gauss, GArray *blocks);
+GArray *ncm_data_gauss_cov_peek_blocks (NcmDataGaussCov *gauss);
+guint ncm_data_gauss_cov_detect_blocks (NcmDataGaussCov *gauss);
+
+void ncm_data_gauss_cov_m2lnL_val_batch (NcmDataGaussCov *gauss, NcmMSet *mset, NcmMatrix *mu, NcmVector *m2lnL);
 
 G_END_DECLS
 
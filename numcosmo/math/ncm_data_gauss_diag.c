@@ -270,6 +270,14 @@ _ncm_data_gauss_diag_resample (NcmData *data, NcmMSet *mset, NcmRNG *rng)
   if (gauss_diag_class->sigma_func != NULL)
     gauss_diag_class->sigma_func (diag, mset, diag->sigma);
 
+  /* The observed values may be shared with other copies, see ncm_data_gauss_diag_set_readonly(). */
+  if (ncm_vector_is_readonly (diag->y))
+  {
+    NcmVector *y = ncm_vector_new (diag->np);
+    ncm_vector_substitute (&diag->y, y, TRUE);
+    ncm_vector_free (y);
+  }
+
   gauss_diag_class->mean_func (diag, mset, diag->y); 
   
   ncm_rng_lock (rng);
@@ -509,3 +517,24 @@ ncm_data_gauss_diag_get_size (NcmDataGaussDiag *diag)
 {
   return NCM_DATA_GAUSS_DIAG_GET_CLASS (diag)->get_size (diag);
 }
+
+/**
+ * ncm_data_gauss_diag_set_readonly:
+ * @diag: a #NcmDataGaussDiag
+ *
+ * Marks the observed values and, when the class does not implement
+ * sigma_func, the standard deviations as read-only (see ncm_vector_set_readonly()).
+ * The copies made with ncm_fit_clone() then share them instead of
+ * duplicating them. Resampling @diag replaces the observed values by
+ * a private vector before writing.
+ * 
+ */
+void 
+ncm_data_gauss_diag_set_readonly (NcmDataGaussDiag *diag)
+{
+  g_assert (diag->np > 0);
+
+  ncm_vector_set_readonly (diag->y, TRUE);
+  if (NCM_DATA_GAUSS_DIAG_GET_CLASS (diag)->sigma_func == NULL)
+    ncm_vector_set_readonly (diag->sigma, TRUE);
+}
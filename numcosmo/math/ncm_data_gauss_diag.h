@@ -71,6 +71,7 @@ GType ncm_data_gauss_diag_get_type (void) G_GNUC_CONST;
 
 void ncm_data_gauss_diag_set_size (NcmDataGaussDiag *diag, guint np);
 guint ncm_data_gauss_diag_get_size (NcmDataGaussDiag *diag);
+void ncm_data_gauss_diag_set_readonly (NcmDataGaussDiag *diag);
 
 G_END_DECLS
 
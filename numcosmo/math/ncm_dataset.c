@@ -807,6 +807,34 @@ ncm_dataset_has_m2lnL_val_grad (NcmDataset *dset)
   return TRUE;
 }
 
+/**
+ * ncm_dataset_has_m2lnL_val_batch:
+ * @dset: a #NcmDataset
+ *
+ * Checks whether all data in @dset implement a vectorised 
+ * #NcmDataClass.m2lnL_val_batch, see ncm_data_has_m2lnL_val_batch().
+ *
+ * Returns: whether all data in @dset implement #NcmDataClass.m2lnL_val_batch.
+ *
+ */
+gboolean
+ncm_dataset_has_m2lnL_val_batch (NcmDataset *dset)
+{
+  if (dset->oa->len == 0)
+    return FALSE;
+  else
+  {
+    guint i;
+    for (i = 0; i < dset->oa->len; i++)
+    {
+      NcmData *data = ncm_dataset_peek_data (dset, i);
+      if (!NCM_DATA_GET_CLASS (data)->m2lnL_val_batch)
+        return FALSE;
+    }
+  }
+  return TRUE;
+}
+
 /**
  * ncm_dataset_data_leastsquares_f:
  * @dset: a #NcmLikelihood.
@@ -980,6 +1008,90 @@ ncm_dataset_m2lnL_vec (NcmDataset *dset, NcmMSet *mset, NcmVector *m2lnL_v)
   return;
 }
 
+/**
+ * ncm_dataset_m2lnL_val_batch:
+ * @dset: a #NcmDataset
+ * @mset: a #NcmMSet
+ * @fparams: a #NcmMatrix containing one free parameter vector per row
+ * @m2lnL_v: a #NcmVector
+ *
+ * Calculates $-2\ln(L)$ as in ncm_dataset_m2lnL_val() for each row of 
+ * @fparams and stores the results in @m2lnL_v.
+ * 
+ * The data implementing #NcmDataClass.m2lnL_val_batch are evaluated at all
+ * points at once. The remaining data are evaluated in a single loop over the
+ * points, such that each point is set in @mset (and the models prepared) only
+ * once for all of them. The free parameters of @mset are restored on exit.
+ * 
+ */
+void
+ncm_dataset_m2lnL_val_batch (NcmDataset *dset, NcmMSet *mset, NcmMatrix *fparams, NcmVector *m2lnL_v)
+{
+  const guint npoints = ncm_matrix_nrows (fparams);
+  NcmVector *fparams0  = ncm_vector_new (ncm_mset_fparams_len (mset));
+  NcmVector *m2lnL_i_v = NULL;
+  guint nloop = 0;
+  guint i;
+
+  g_assert_cmpuint (ncm_matrix_ncols (fparams), ==, ncm_mset_fparams_len (mset));
+  g_assert_cmpuint (ncm_vector_len (m2lnL_v), ==, npoints);
+
+  ncm_mset_fparams_get_vector (mset, fparams0);
+  ncm_vector_set_zero (m2lnL_v);
+
+  for (i = 0; i < dset->oa->len; i++)
+  {
+    NcmData *data = ncm_dataset_peek_data (dset, i);
+
+    if (!NCM_DATA_GET_CLASS (data)->m2lnL_val)
+      g_error ("ncm_dataset_m2lnL_val_batch: %s dont implement m2lnL", G_OBJECT_TYPE_NAME (data));
+    else if (NCM_DATA_GET_CLASS (data)->m2lnL_val_batch != NULL)
+    {
+      if (m2lnL_i_v == NULL)
+        m2lnL_i_v = ncm_vector_new (npoints);
+
+      NCM_DATA_GET_CLASS (data)->m2lnL_val_batch (data, mset, fparams, m2lnL_i_v);
+      ncm_vector_add (m2lnL_v, m2lnL_i_v);
+    }
+    else
+      nloop++;
+  }
+
+  if (nloop > 0)
+  {
+    guint a;
+
+    for (a = 0; a < npoints; a++)
+    {
+      NcmVector *fparams_a = ncm_matrix_get_row (fparams, a);
+      gdouble m2lnL_a      = 0.0;
+
+      ncm_mset_fparams_set_vector (mset, fparams_a);
+
+      for (i = 0; i < dset->oa->len; i++)
+      {
+        NcmData *data = ncm_dataset_peek_data (dset, i);
+
+        if (NCM_DATA_GET_CLASS (data)->m2lnL_val_batch == NULL)
+        {
+          gdouble m2lnL_i;
+          ncm_data_prepare (data, mset);
+          NCM_DATA_GET_CLASS (data)->m2lnL_val (data, mset, &m2lnL_i);
+          m2lnL_a += m2lnL_i;
+        }
+      }
+
+      ncm_vector_addto (m2lnL_v, a, m2lnL_a);
+      ncm_vector_free (fparams_a);
+    }
+  }
+
+  ncm_mset_fparams_set_vector (mset, fparams0);
+
+  ncm_vector_clear (&m2lnL_i_v);
+  ncm_vector_free (fparams0);
+}
+
 /**
  * ncm_dataset_m2lnL_grad:
  * @dset: a #NcmLikelihood.
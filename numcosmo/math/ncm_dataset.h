@@ -115,6 +115,7 @@ gboolean ncm_dataset_has_leastsquares_f_J (NcmDataset *dset);
 gboolean ncm_dataset_has_m2lnL_val (NcmDataset *dset);
 gboolean ncm_dataset_has_m2lnL_grad (NcmDataset *dset);
 gboolean ncm_dataset_has_m2lnL_val_grad (NcmDataset *dset);
+gboolean ncm_dataset_has_m2lnL_val_batch (NcmDataset *dset);
 
 void ncm_dataset_leastsquares_f (NcmDataset *dset, NcmMSet *mset, NcmVector *f);
 void ncm_dataset_leastsquares_J (NcmDataset *dset, NcmMSet *mset, NcmMatrix *J);
@@ -124,6 +125,7 @@ void ncm_dataset_m2lnL_val (NcmDataset *dset, NcmMSet *mset, gdouble *m2lnL);
 void ncm_dataset_m2lnL_vec (NcmDataset *dset, NcmMSet *mset, NcmVector *m2lnL_v);
 void ncm_dataset_m2lnL_grad (NcmDataset *dset, NcmMSet *mset, NcmVector *grad);
 void ncm_dataset_m2lnL_val_grad (NcmDataset *dset, NcmMSet *mset, gdouble *m2lnL, NcmVector *grad);
+void ncm_dataset_m2lnL_val_batch (NcmDataset *dset, NcmMSet *mset, NcmMatrix *fparams, NcmVector *m2lnL_v);
 
 void ncm_dataset_m2lnL_i_val (NcmDataset *dset, NcmMSet *mset, guint i, gdouble *m2lnL_i);
 
@@ -42,6 +42,8 @@
 #include "math/ncm_util.h"
 #include "math/integral.h"
 #include "math/memory_pool.h"
+#include "math/ncm_func_eval.h"
+#include "math/ncm_serialize.h"
 #include "math/ncm_fit_gsl_ls.h"
 #include "math/ncm_fit_gsl_mm.h"
 #include "math/ncm_fit_gsl_mms.h"
@@ -539,6 +541,56 @@ ncm_fit_dup (NcmFit *fit, NcmSerialize *ser)
   return NCM_FIT (ncm_serialize_dup_obj (ser, G_OBJECT (fit)));
 }
 
+/**
+ * ncm_fit_clone:
+ * @fit: a #NcmFit
+ * @ser: a #NcmSerialize
+ * @clone_time: (out) (allow-none): time spent cloning in seconds
+ * @clone_size: (out) (allow-none): number of bytes copied
+ *
+ * Duplicates @fit as ncm_fit_dup() but sharing, by reference, the #NcmVector
+ * and #NcmMatrix objects marked as read-only (see ncm_vector_set_readonly() 
+ * and ncm_matrix_set_readonly()), i.e., only the mutable state is copied. 
+ * The shared objects are kept in @ser as named instances, so subsequent 
+ * clones using the same @ser share the same objects.
+ *
+ * The data classes mark the payloads loaded from their catalogs as
+ * read-only, see for example ncm_data_gauss_cov_set_readonly(). The clone
+ * must not change the shared objects, the Gaussian data replace the
+ * observed values by a private vector when resampled.
+ *
+ * If @clone_size is not NULL it is set to the size of the serialized 
+ * version of @fit, i.e., an estimate of the memory used by the clone 
+ * besides the shared objects.
+ *
+ * Returns: (transfer full): a clone of @fit.
+ */
+NcmFit *
+ncm_fit_clone (NcmFit *fit, NcmSerialize *ser, gdouble *clone_time, gsize *clone_size)
+{
+  const NcmSerializeOpt opts = ser->opts;
+  GTimer *timer              = g_timer_new ();
+  NcmFit *fit_clone;
+  GVariant *var;
+
+  ser->opts = opts | NCM_SERIALIZE_OPT_SHARE_READONLY;
+
+  var       = ncm_serialize_to_variant (ser, G_OBJECT (fit));
+  fit_clone = NCM_FIT (ncm_serialize_from_variant (ser, var));
+
+  ser->opts = opts;
+
+  if (clone_time != NULL)
+    *clone_time = g_timer_elapsed (timer, NULL);
+  if (clone_size != NULL)
+    *clone_size = g_variant_get_size (var);
+
+  g_variant_unref (var);
+  g_timer_destroy (timer);
+
+  return fit_clone;
+}
+
 /**
  * ncm_fit_free:
  * @fit: a #NcmFit
@@ -1580,6 +1632,99 @@ ncm_fit_fishermatrix_print (NcmFit *fit, FILE *out, gchar *header)
  * FIXME
  */
 
+typedef struct _NcmFitBatchEval
+{
+  NcmFit *fit;
+  NcmMatrix *fparams;
+  NcmVector *m2lnL_v;
+  NcmSerialize *ser;
+  NcmMemoryPool *mp;
+  GMutex dup_fit;
+} NcmFitBatchEval;
+
+static gpointer
+_ncm_fit_batch_dup_fit (gpointer userdata)
+{
+  NcmFitBatchEval *beval = (NcmFitBatchEval *) userdata;
+  g_mutex_lock (&beval->dup_fit);
+  {
+    NcmFit *fit = ncm_fit_dup (beval->fit, beval->ser);
+    ncm_serialize_reset (beval->ser, TRUE);
+    g_mutex_unlock (&beval->dup_fit);
+    return fit;
+  }
+}
+
+static void
+_ncm_fit_m2lnL_val_batch_mt_eval (glong i, glong f, gpointer data)
+{
+  NcmFitBatchEval *beval = (NcmFitBatchEval *) data;
+  NcmFit **fit_ptr       = ncm_memory_pool_get (beval->mp);
+  NcmFit *fit            = *fit_ptr;
+  NcmMatrix *fparams_if  = ncm_matrix_get_submatrix (beval->fparams, i, 0, f - i, ncm_matrix_ncols (beval->fparams));
+  NcmVector *m2lnL_if    = ncm_vector_get_subvector (beval->m2lnL_v, i, f - i);
+
+  ncm_likelihood_m2lnL_val_batch (fit->lh, fit->mset, fparams_if, m2lnL_if);
+
+  ncm_matrix_free (fparams_if);
+  ncm_vector_free (m2lnL_if);
+  ncm_memory_pool_return (fit_ptr);
+}
+
+/**
+ * ncm_fit_m2lnL_val_batch:
+ * @fit: a #NcmFit
+ * @fparams: a #NcmMatrix containing one free parameter vector per row
+ * @m2lnL_v: a #NcmVector
+ *
+ * Calculates $-2\ln(L)$ for each row of @fparams, the rows are used as the
+ * free parameters of the #NcmMSet of @fit, and stores the results in @m2lnL_v.
+ * The free parameters of @fit are left unchanged.
+ * 
+ * When all data implement #NcmDataClass.m2lnL_val_batch the points are 
+ * evaluated at once using ncm_likelihood_m2lnL_val_batch(). Otherwise, if the
+ * function evaluation thread pool has more than one thread (see 
+ * ncm_func_eval_set_max_threads()), the points are split in contiguous blocks,
+ * each one evaluated by a duplicate of @fit. The duplicates are created 
+ * from the current state of @fit at each call.
+ * 
+ */
+void
+ncm_fit_m2lnL_val_batch (NcmFit *fit, NcmMatrix *fparams, NcmVector *m2lnL_v)
+{
+  const guint npoints    = ncm_matrix_nrows (fparams);
+  const gint max_threads = g_thread_pool_get_max_threads (ncm_func_eval_get_pool ());
+  const guint nthreads   = (max_threads > 0) ? max_threads : 1;
+
+  g_assert_cmpuint (ncm_matrix_ncols (fparams), ==, ncm_mset_fparams_len (fit->mset));
+  g_assert_cmpuint (ncm_vector_len (m2lnL_v), ==, npoints);
+
+  if (ncm_dataset_has_m2lnL_val_batch (fit->lh->dset) || (nthreads < 2) || (npoints <= 2 * nthreads))
+  {
+    ncm_likelihood_m2lnL_val_batch (fit->lh, fit->mset, fparams, m2lnL_v);
+  }
+  else
+  {
+    NcmFitBatchEval beval;
+
+    beval.fit     = fit;
+    beval.fparams = fparams;
+    beval.m2lnL_v = m2lnL_v;
+    beval.ser     = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+    beval.mp      = ncm_memory_pool_new (&_ncm_fit_batch_dup_fit, &beval, 
+                                         (GDestroyNotify) &ncm_fit_free);
+    g_mutex_init (&beval.dup_fit);
+
+    ncm_func_eval_threaded_loop_nw (&_ncm_fit_m2lnL_val_batch_mt_eval, 0, npoints, &beval, nthreads);
+
+    ncm_memory_pool_free (beval.mp, TRUE);
+    ncm_serialize_free (beval.ser);
+    g_mutex_clear (&beval.dup_fit);
+  }
+
+  fit->fstate->func_eval += npoints;
+}
+
 static gdouble _ncm_fit_numdiff_m2lnL_val (NcmVector *x, gpointer user_data);
 static void _ncm_fit_numdiff_ls_f (NcmVector *x, NcmVector *y, gpointer user_data);
 
@@ -184,6 +184,7 @@ NcmFit *ncm_fit_new (NcmFitType ftype, gchar *algo_name, NcmLikelihood *lh, NcmM
 NcmFit *ncm_fit_ref (NcmFit *fit);
 NcmFit *ncm_fit_copy_new (NcmFit *fit, NcmLikelihood *lh, NcmMSet *mset, NcmFitGradType gtype);
 NcmFit *ncm_fit_dup (NcmFit *fit, NcmSerialize *ser);
+NcmFit *ncm_fit_clone (NcmFit *fit, NcmSerialize *ser, gdouble *clone_time, gsize *clone_size);
 void ncm_fit_free (NcmFit *fit);
 void ncm_fit_clear (NcmFit **fit);
 
@@ -232,6 +233,7 @@ G_INLINE_FUNC void ncm_fit_data_m2lnL_val (NcmFit *fit, gdouble *data_m2lnL);
 G_INLINE_FUNC void ncm_fit_priors_m2lnL_val (NcmFit *fit, gdouble *priors_m2lnL);
 
 G_INLINE_FUNC void ncm_fit_m2lnL_val (NcmFit *fit, gdouble *m2lnL);
+void ncm_fit_m2lnL_val_batch (NcmFit *fit, NcmMatrix *fparams, NcmVector *m2lnL_v);
 G_INLINE_FUNC void ncm_fit_ls_f (NcmFit *fit, NcmVector *f);
 
 G_INLINE_FUNC void ncm_fit_m2lnL_grad (NcmFit *fit, NcmVector *df);
@@ -29,6 +29,22 @@
  * @short_description: Ensemble sampler Markov Chain Monte Carlo analysis.
  *
  * FIXME
+ *
+ * The walkers can be evaluated in parallel using threads, see 
+ * ncm_fit_esmcmc_set_nthreads(), or using worker processes, see
+ * ncm_fit_esmcmc_set_nprocs(). In the latter, ncm_fit_esmcmc_start_run()
+ * launches the worker processes running the esmcmc_worker program, each one
+ * receives a serialized copy of the #NcmFit and of the functions array. 
+ * Therefore, all objects in the fit must be serializable and registered in
+ * the library, the worker program is found using the environment variable
+ * %NCM_FIT_ESMCMC_WORKER_ENV or in the installation libexec directory. 
+ * The master process keeps the ensemble, the 
+ * random number generator and the #NcmMSetCatalog, computes the proposals 
+ * and sends the parameter vectors to the workers, which return the 
+ * $-2\ln(L)$ and the functions values. Since all random numbers are 
+ * generated in the master in the same order, the chains are identical to
+ * the ones obtained using threads for the same seed. This is useful for
+ * likelihoods that are not thread-safe.
  * 
  */
 
@@ -40,9 +56,20 @@
 #include "math/ncm_fit_esmcmc.h"
 #include "math/ncm_cfg.h"
 #include "math/ncm_func_eval.h"
+#include "math/ncm_profiler.h"
 #include "ncm_enum_types.h"
 
 #include <gsl/gsl_statistics_double.h>
+#ifdef G_OS_UNIX
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <signal.h>
+#endif /* G_OS_UNIX */
 
 enum
 {
@@ -58,6 +85,8 @@ enum
   PROP_MAX_RUNS_TIME,
   PROP_MTYPE,
   PROP_NTHREADS,
+  PROP_NPROCS,
+  PROP_BETA,
   PROP_DATA_FILE,
   PROP_FUNCS_ARRAY,
 };
@@ -67,6 +96,14 @@ G_DEFINE_TYPE (NcmFitESMCMC, ncm_fit_esmcmc, G_TYPE_OBJECT);
 static gpointer _ncm_fit_esmcmc_worker_dup (gpointer userdata);
 static void _ncm_fit_esmcmc_worker_free (gpointer p);
 
+typedef struct _NcmFitESMCMCProc
+{
+  GPid pid;
+  gint fd;
+} NcmFitESMCMCProc;
+
+static void _ncm_fit_esmcmc_procs_stop (NcmFitESMCMC *esmcmc);
+
 static void
 ncm_fit_esmcmc_init (NcmFitESMCMC *esmcmc)
 {
@@ -107,6 +144,9 @@ ncm_fit_esmcmc_init (NcmFitESMCMC *esmcmc)
   esmcmc->funcs_oa_file   = NULL;
   
   esmcmc->nthreads        = 0;
+  esmcmc->nprocs          = 0;
+  esmcmc->procs           = g_array_new (FALSE, FALSE, sizeof (NcmFitESMCMCProc));
+  esmcmc->beta            = 1.0;
   esmcmc->n               = 0;
   esmcmc->nwalkers        = 0;
   esmcmc->cur_sample_id   = -1; /* Represents that no samples were calculated yet, i.e., id of the last added point. */
@@ -114,6 +154,7 @@ ncm_fit_esmcmc_init (NcmFitESMCMC *esmcmc)
   esmcmc->naccepted       = 0;
   esmcmc->noffboard       = 0;
   esmcmc->started         = FALSE;
+  esmcmc->profiler_report = TRUE;
 
   g_mutex_init (&esmcmc->dup_fit);
   g_mutex_init (&esmcmc->resample_lock);
@@ -240,6 +281,12 @@ ncm_fit_esmcmc_set_property (GObject *object, guint prop_id, const GValue *value
     case PROP_NTHREADS:
       ncm_fit_esmcmc_set_nthreads (esmcmc, g_value_get_uint (value));
       break;
+    case PROP_NPROCS:
+      ncm_fit_esmcmc_set_nprocs (esmcmc, g_value_get_uint (value));
+      break;
+    case PROP_BETA:
+      ncm_fit_esmcmc_set_beta (esmcmc, g_value_get_double (value));
+      break;
     case PROP_DATA_FILE:
       ncm_fit_esmcmc_set_data_file (esmcmc, g_value_get_string (value));
       break;
@@ -306,6 +353,12 @@ ncm_fit_esmcmc_get_property (GObject *object, guint prop_id, GValue *value, GPar
     case PROP_NTHREADS:
       g_value_set_uint (value, esmcmc->nthreads);
       break;
+    case PROP_NPROCS:
+      g_value_set_uint (value, esmcmc->nprocs);
+      break;
+    case PROP_BETA:
+      g_value_set_double (value, esmcmc->beta);
+      break;
     case PROP_DATA_FILE:
       g_value_set_string (value, ncm_mset_catalog_peek_filename (esmcmc->mcat));
       break;
@@ -323,6 +376,12 @@ ncm_fit_esmcmc_dispose (GObject *object)
 {
   NcmFitESMCMC *esmcmc = NCM_FIT_ESMCMC (object);
 
+  if (esmcmc->procs != NULL)
+  {
+    _ncm_fit_esmcmc_procs_stop (esmcmc);
+    g_clear_pointer (&esmcmc->procs, g_array_unref);
+  }
+
   ncm_fit_clear (&esmcmc->fit);
   ncm_mset_trans_kern_clear (&esmcmc->sampler);
   ncm_timer_clear (&esmcmc->nt);
@@ -460,6 +519,20 @@ ncm_fit_esmcmc_class_init (NcmFitESMCMCClass *klass)
                                                       "Number of threads to run",
                                                       0, G_MAXUINT32, 0,
                                                       G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_NPROCS,
+                                   g_param_spec_uint ("nprocs",
+                                                      NULL,
+                                                      "Number of worker processes to run",
+                                                      0, G_MAXUINT32, 0,
+                                                      G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_BETA,
+                                   g_param_spec_double ("beta",
+                                                        NULL,
+                                                        "Inverse temperature",
+                                                        0.0, 1.0, 1.0,
+                                                        G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
   g_object_class_install_property (object_class,
                                    PROP_DATA_FILE,
                                    g_param_spec_string ("data-file",
@@ -491,8 +564,15 @@ _ncm_fit_esmcmc_worker_dup (gpointer userdata)
   G_LOCK (dup_thread);
   {
     NcmFitESMCMCWorker *fw = g_new (NcmFitESMCMCWorker, 1);
-    
-    fw->fit = ncm_fit_dup (esmcmc->fit, esmcmc->ser);
+    gdouble clone_time     = 0.0;
+    gsize clone_size       = 0;
+
+    /* Walkers never resample the data, read-only objects can be shared. */
+    fw->fit = ncm_fit_clone (esmcmc->fit, esmcmc->ser, &clone_time, &clone_size);
+
+    if (esmcmc->mtype == NCM_FIT_RUN_MSGS_FULL)
+      g_message ("# NcmFitESMCMC: worker fit cloned in %.3f s, %.3f MiB copied.\n", 
+                 clone_time, clone_size / (1024.0 * 1024.0));
 
     if (esmcmc->funcs_oa != NULL)
       fw->funcs_array = ncm_obj_array_dup (esmcmc->funcs_oa, esmcmc->ser);    
@@ -518,6 +598,409 @@ _ncm_fit_esmcmc_worker_free (gpointer userdata)
   g_free (fw);
 }
 
+/*
+ * Worker processes
+ *
+ * The workers are fresh processes running the esmcmc_worker program, see
+ * ncm_fit_esmcmc_proc_worker(). Forking a process that already holds 
+ * threads (GLib thread pools, data emulators trainers, etc) and continuing
+ * to run the library in the child is not safe, hence the child only calls
+ * execv() after the fork.
+ *
+ * Protocol: the master first sends the length (guint64) followed by the 
+ * serialized variant "(uvv)" containing the number of free parameters, the
+ * #NcmFit and the functions #NcmObjArray. Then it sends a header 
+ * {cmd, npoints} followed by npoints parameter vectors (fparam_len doubles
+ * each), the worker answers with npoints blocks of 1 + nfuncs doubles 
+ * containing $-2\ln(L)$ and the functions values.
+ */
+
+#define NCM_FIT_ESMCMC_PROC_INIT_TYPE "(uvv)"
+
+typedef enum _NcmFitESMCMCProcCmd
+{
+  NCM_FIT_ESMCMC_PROC_CMD_QUIT = 0,
+  NCM_FIT_ESMCMC_PROC_CMD_EVAL,
+} NcmFitESMCMCProcCmd;
+
+#ifdef G_OS_UNIX
+/*
+ * A worker (or the master) dying must result in a failed write and not in a
+ * SIGPIPE killing the other end. MSG_NOSIGNAL is not available everywhere
+ * (e.g. macOS), there we use SO_NOSIGPIPE on the socket and, as a last
+ * resort, ignore SIGPIPE.
+ */
+#ifdef MSG_NOSIGNAL
+#define NCM_FIT_ESMCMC_PROC_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define NCM_FIT_ESMCMC_PROC_SEND_FLAGS 0
+#endif /* MSG_NOSIGNAL */
+
+static void
+_ncm_fit_esmcmc_proc_nosigpipe (gint fd)
+{
+#ifndef MSG_NOSIGNAL
+#ifdef SO_NOSIGPIPE
+  gint on = 1;
+
+  if (setsockopt (fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof (on)) != 0)
+    g_error ("_ncm_fit_esmcmc_proc_nosigpipe: cannot set SO_NOSIGPIPE: %s", g_strerror (errno));
+#else
+  signal (SIGPIPE, SIG_IGN);
+#endif /* SO_NOSIGPIPE */
+#endif /* MSG_NOSIGNAL */
+}
+
+static gboolean
+_ncm_fit_esmcmc_proc_write (gint fd, gconstpointer buf, gsize len)
+{
+  const gchar *cbuf = buf;
+
+  while (len > 0)
+  {
+    const gssize n = send (fd, cbuf, len, NCM_FIT_ESMCMC_PROC_SEND_FLAGS);
+    if (n < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return FALSE;
+    }
+    cbuf += n;
+    len  -= n;
+  }
+
+  return TRUE;
+}
+
+static gboolean
+_ncm_fit_esmcmc_proc_read (gint fd, gpointer buf, gsize len)
+{
+  gchar *cbuf = buf;
+
+  while (len > 0)
+  {
+    const gssize n = recv (fd, cbuf, len, 0);
+    if (n < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return FALSE;
+    }
+    else if (n == 0)
+      return FALSE;
+    cbuf += n;
+    len  -= n;
+  }
+
+  return TRUE;
+}
+
+static void
+_ncm_fit_esmcmc_proc_worker_loop (NcmFit *fit, NcmObjArray *funcs_oa, gint fd)
+{
+  const guint fparam_len = ncm_mset_fparam_len (fit->mset);
+  const guint nfuncs     = funcs_oa->len;
+  NcmVector *theta       = ncm_vector_new (fparam_len);
+  GArray *in             = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  GArray *out            = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  guint32 header[2];
+
+  while (_ncm_fit_esmcmc_proc_read (fd, header, sizeof (header)))
+  {
+    const guint npoints = header[1];
+    guint a, i, j;
+
+    if (header[0] == NCM_FIT_ESMCMC_PROC_CMD_QUIT)
+      break;
+
+    g_array_set_size (in, npoints * fparam_len);
+    g_array_set_size (out, npoints * (1 + nfuncs));
+
+    /* Read the whole batch first, so the master does not wait for the evaluations while sending. */
+    if ((npoints > 0) && !_ncm_fit_esmcmc_proc_read (fd, in->data, sizeof (gdouble) * in->len))
+      break;
+
+    for (a = 0; a < npoints; a++)
+    {
+      gdouble *out_a = &g_array_index (out, gdouble, a * (1 + nfuncs));
+
+      for (i = 0; i < fparam_len; i++)
+        ncm_vector_set (theta, i, g_array_index (in, gdouble, a * fparam_len + i));
+
+      ncm_mset_fparams_set_vector (fit->mset, theta);
+      ncm_fit_m2lnL_val (fit, &out_a[NCM_FIT_ESMCMC_M2LNL_ID]);
+
+      for (j = 0; j < nfuncs; j++)
+      {
+        if (gsl_finite (out_a[NCM_FIT_ESMCMC_M2LNL_ID]))
+        {
+          NcmMSetFunc *func = NCM_MSET_FUNC (ncm_obj_array_peek (funcs_oa, j));
+          out_a[j + 1] = ncm_mset_func_eval0 (func, fit->mset);
+        }
+        else
+          out_a[j + 1] = GSL_NAN;
+      }
+    }
+
+    if ((npoints > 0) && !_ncm_fit_esmcmc_proc_write (fd, out->data, sizeof (gdouble) * out->len))
+      break;
+  }
+
+  g_array_unref (in);
+  g_array_unref (out);
+  ncm_vector_free (theta);
+}
+
+static gchar *
+_ncm_fit_esmcmc_proc_worker_path (void)
+{
+  const gchar *worker_env = g_getenv (NCM_FIT_ESMCMC_WORKER_ENV);
+  gchar *worker_path;
+
+  if (worker_env != NULL)
+  {
+    if (!g_file_test (worker_env, G_FILE_TEST_IS_EXECUTABLE))
+      g_error ("_ncm_fit_esmcmc_proc_worker_path: the worker `%s' set in %s is not executable.", 
+               worker_env, NCM_FIT_ESMCMC_WORKER_ENV);
+    return g_strdup (worker_env);
+  }
+
+  worker_path = g_build_filename (PKGLIBEXECDIR, "esmcmc_worker", NULL);
+  if (g_file_test (worker_path, G_FILE_TEST_IS_EXECUTABLE))
+    return worker_path;
+  g_free (worker_path);
+
+  g_error ("_ncm_fit_esmcmc_proc_worker_path: cannot find the esmcmc_worker program, set %s.", 
+           NCM_FIT_ESMCMC_WORKER_ENV);
+
+  return NULL;
+}
+#endif /* G_OS_UNIX */
+
+/**
+ * ncm_fit_esmcmc_proc_worker: (skip)
+ * @fd: socket file descriptor connected to the master process
+ * 
+ * Runs the worker side of the worker processes protocol, see 
+ * ncm_fit_esmcmc_set_nprocs(). It receives the serialized #NcmFit and 
+ * functions array from the master and evaluates the points sent through
+ * @fd until the master quits. This function is called by the esmcmc_worker
+ * program and should not be used directly.
+ * 
+ */
+void
+ncm_fit_esmcmc_proc_worker (gint fd)
+{
+#ifdef G_OS_UNIX
+  NcmSerialize *ser = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+  guint64 len       = 0;
+  GVariant *init_var, *fit_var, *funcs_var;
+  NcmFit *fit;
+  NcmObjArray *funcs_oa;
+  gchar *buf;
+  guint fparam_len;
+
+  _ncm_fit_esmcmc_proc_nosigpipe (fd);
+
+  if (!_ncm_fit_esmcmc_proc_read (fd, &len, sizeof (len)))
+    g_error ("ncm_fit_esmcmc_proc_worker: cannot read the initialization from the master process.");
+
+  buf = g_malloc (len);
+  if (!_ncm_fit_esmcmc_proc_read (fd, buf, len))
+    g_error ("ncm_fit_esmcmc_proc_worker: cannot read the initialization from the master process.");
+
+  init_var = g_variant_new_from_data (G_VARIANT_TYPE (NCM_FIT_ESMCMC_PROC_INIT_TYPE), buf, len, FALSE, g_free, buf);
+  g_variant_ref_sink (init_var);
+  g_variant_get (init_var, "(uvv)", &fparam_len, &fit_var, &funcs_var);
+
+  fit      = NCM_FIT (ncm_serialize_from_variant (ser, fit_var));
+  funcs_oa = ncm_obj_array_new_from_variant (ser, funcs_var);
+
+  ncm_mset_prepare_fparam_map (fit->mset);
+  if (ncm_mset_fparam_len (fit->mset) != fparam_len)
+    g_error ("ncm_fit_esmcmc_proc_worker: the worker model set has %u free parameters but the master has %u.",
+             ncm_mset_fparam_len (fit->mset), fparam_len);
+
+  _ncm_fit_esmcmc_proc_worker_loop (fit, funcs_oa, fd);
+
+  g_variant_unref (fit_var);
+  g_variant_unref (funcs_var);
+  g_variant_unref (init_var);
+  ncm_obj_array_unref (funcs_oa);
+  ncm_fit_free (fit);
+  ncm_serialize_free (ser);
+#else
+  g_error ("ncm_fit_esmcmc_proc_worker: worker processes are not supported in this platform.");
+#endif /* G_OS_UNIX */
+}
+
+static void
+_ncm_fit_esmcmc_procs_start (NcmFitESMCMC *esmcmc)
+{
+#ifdef G_OS_UNIX
+  NcmSerialize *ser;
+  NcmObjArray *funcs_oa;
+  GVariant *fit_var, *funcs_var, *init_var;
+  gchar *worker_path;
+  gchar *worker_argv[4];
+  guint64 len;
+  guint p;
+
+  if ((esmcmc->nprocs < 2) || (esmcmc->procs->len > 0))
+    return;
+
+  ser       = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+  funcs_oa  = (esmcmc->funcs_oa != NULL) ? ncm_obj_array_ref (esmcmc->funcs_oa) : ncm_obj_array_new ();
+  fit_var   = ncm_serialize_to_variant (ser, G_OBJECT (esmcmc->fit));
+  funcs_var = ncm_obj_array_ser (funcs_oa, ser);
+  init_var  = g_variant_ref_sink (g_variant_new (NCM_FIT_ESMCMC_PROC_INIT_TYPE, esmcmc->fparam_len, fit_var, funcs_var));
+  len       = g_variant_get_size (init_var);
+
+  worker_path    = _ncm_fit_esmcmc_proc_worker_path ();
+  worker_argv[0] = worker_path;
+  worker_argv[1] = (gchar *) "--fd";
+  worker_argv[3] = NULL;
+
+  /* Avoid duplicating the buffered output in the children. */
+  fflush (NULL);
+
+  for (p = 0; p < esmcmc->nprocs; p++)
+  {
+    NcmFitESMCMCProc proc;
+    gchar *fd_str;
+    gint sv[2];
+
+    if (socketpair (AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+      g_error ("_ncm_fit_esmcmc_procs_start: cannot create socket pair: %s", g_strerror (errno));
+
+    /* The master end must not leak into the other workers. */
+    if (fcntl (sv[0], F_SETFD, FD_CLOEXEC) != 0)
+      g_error ("_ncm_fit_esmcmc_procs_start: cannot set close-on-exec: %s", g_strerror (errno));
+
+    _ncm_fit_esmcmc_proc_nosigpipe (sv[0]);
+    _ncm_fit_esmcmc_proc_nosigpipe (sv[1]);
+
+    fd_str         = g_strdup_printf ("%d", sv[1]);
+    worker_argv[2] = fd_str;
+
+    proc.pid = fork ();
+    if (proc.pid < 0)
+      g_error ("_ncm_fit_esmcmc_procs_start: cannot fork: %s", g_strerror (errno));
+
+    if (proc.pid == 0)
+    {
+      /* Only async-signal-safe calls are allowed between fork and exec. */
+      execv (worker_argv[0], worker_argv);
+      _exit (127);
+    }
+
+    g_free (fd_str);
+    close (sv[1]);
+    proc.fd = sv[0];
+    g_array_append_val (esmcmc->procs, proc);
+
+    if (!_ncm_fit_esmcmc_proc_write (proc.fd, &len, sizeof (len)) ||
+        !_ncm_fit_esmcmc_proc_write (proc.fd, g_variant_get_data (init_var), len))
+      g_error ("_ncm_fit_esmcmc_procs_start: cannot initialize the worker process `%s': %s", worker_path, g_strerror (errno));
+  }
+
+  if (esmcmc->mtype > NCM_FIT_RUN_MSGS_NONE)
+    g_message ("# NcmFitESMCMC: Started %u worker processes (%s).\n", esmcmc->procs->len, worker_path);
+
+  g_free (worker_path);
+  g_variant_unref (init_var);
+  g_variant_unref (fit_var);
+  g_variant_unref (funcs_var);
+  ncm_obj_array_unref (funcs_oa);
+  ncm_serialize_free (ser);
+#endif /* G_OS_UNIX */
+}
+
+static void
+_ncm_fit_esmcmc_procs_stop (NcmFitESMCMC *esmcmc)
+{
+#ifdef G_OS_UNIX
+  guint p;
+
+  for (p = 0; p < esmcmc->procs->len; p++)
+  {
+    NcmFitESMCMCProc *proc = &g_array_index (esmcmc->procs, NcmFitESMCMCProc, p);
+    guint32 header[2]      = {NCM_FIT_ESMCMC_PROC_CMD_QUIT, 0};
+
+    _ncm_fit_esmcmc_proc_write (proc->fd, header, sizeof (header));
+    close (proc->fd);
+    waitpid (proc->pid, NULL, 0);
+  }
+  g_array_set_size (esmcmc->procs, 0);
+#endif /* G_OS_UNIX */
+}
+
+/*
+ * Evaluates the points theta_array[k] for all k in kindex using the worker 
+ * processes, $-2\ln(L)$ and the functions values are written in 
+ * full_array[k].
+ */
+static void
+_ncm_fit_esmcmc_procs_eval (NcmFitESMCMC *esmcmc, GArray *kindex, GPtrArray *theta_array, GPtrArray *full_array)
+{
+#ifdef G_OS_UNIX
+  const guint nprocs     = esmcmc->procs->len;
+  const guint npoints    = kindex->len;
+  const guint fparam_len = esmcmc->fparam_len;
+  const guint nfuncs     = (esmcmc->funcs_oa != NULL) ? esmcmc->funcs_oa->len : 0;
+  GArray *buf            = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  guint p, a, i;
+
+  g_assert_cmpuint (nprocs, >, 0);
+
+  /* Contiguous chunks of points are sent to each process. */
+  for (p = 0; p < nprocs; p++)
+  {
+    const guint ai      = (p * npoints) / nprocs;
+    const guint af      = ((p + 1) * npoints) / nprocs;
+    NcmFitESMCMCProc *proc = &g_array_index (esmcmc->procs, NcmFitESMCMCProc, p);
+    guint32 header[2]   = {NCM_FIT_ESMCMC_PROC_CMD_EVAL, af - ai};
+
+    g_array_set_size (buf, (af - ai) * fparam_len);
+    for (a = ai; a < af; a++)
+    {
+      NcmVector *theta_k = g_ptr_array_index (theta_array, g_array_index (kindex, guint, a));
+      for (i = 0; i < fparam_len; i++)
+        g_array_index (buf, gdouble, (a - ai) * fparam_len + i) = ncm_vector_get (theta_k, i);
+    }
+
+    if (!_ncm_fit_esmcmc_proc_write (proc->fd, header, sizeof (header)) ||
+        ((buf->len > 0) && !_ncm_fit_esmcmc_proc_write (proc->fd, buf->data, sizeof (gdouble) * buf->len)))
+      g_error ("_ncm_fit_esmcmc_procs_eval: cannot send points to the worker process %u: %s", p, g_strerror (errno));
+  }
+
+  for (p = 0; p < nprocs; p++)
+  {
+    const guint ai      = (p * npoints) / nprocs;
+    const guint af      = ((p + 1) * npoints) / nprocs;
+    NcmFitESMCMCProc *proc = &g_array_index (esmcmc->procs, NcmFitESMCMCProc, p);
+
+    if (af == ai)
+      continue;
+
+    g_array_set_size (buf, (af - ai) * (1 + nfuncs));
+    if (!_ncm_fit_esmcmc_proc_read (proc->fd, buf->data, sizeof (gdouble) * buf->len))
+      g_error ("_ncm_fit_esmcmc_procs_eval: cannot receive the results of the worker process %u.", p);
+
+    for (a = ai; a < af; a++)
+    {
+      NcmVector *full_k = g_ptr_array_index (full_array, g_array_index (kindex, guint, a));
+      for (i = 0; i < 1 + nfuncs; i++)
+        ncm_vector_set (full_k, NCM_FIT_ESMCMC_M2LNL_ID + i, g_array_index (buf, gdouble, (a - ai) * (1 + nfuncs) + i));
+    }
+  }
+
+  g_array_unref (buf);
+#else
+  g_error ("_ncm_fit_esmcmc_procs_eval: worker processes are not supported in this platform.");
+#endif /* G_OS_UNIX */
+}
+
 static void 
 _ncm_fit_esmcmc_set_fit_obj (NcmFitESMCMC *esmcmc, NcmFit *fit)
 {
@@ -692,6 +1175,122 @@ ncm_fit_esmcmc_set_nthreads (NcmFitESMCMC *esmcmc, guint nthreads)
   esmcmc->nthreads = nthreads;
 }
 
+/**
+ * ncm_fit_esmcmc_set_nprocs:
+ * @esmcmc: a #NcmFitESMCMC
+ * @nprocs: numbers of worker processes
+ *
+ * Sets the number of worker processes used to evaluate the walkers, 
+ * see #NcmFitESMCMC. If @nprocs is larger than one it takes precedence 
+ * over the threads set by ncm_fit_esmcmc_set_nthreads(). The processes are
+ * created by ncm_fit_esmcmc_start_run() and finished by 
+ * ncm_fit_esmcmc_end_run(). If @nprocs is larger than nwalkers / 2, it will 
+ * be set to nwalkers / 2.
+ *
+ */
+void 
+ncm_fit_esmcmc_set_nprocs (NcmFitESMCMC *esmcmc, guint nprocs)
+{
+#ifndef G_OS_UNIX
+  if (nprocs > 1)
+    g_error ("ncm_fit_esmcmc_set_nprocs: worker processes are not supported in this platform.");
+#endif /* G_OS_UNIX */
+  if (nprocs > 0)
+  {
+    if (esmcmc->nwalkers % 2 == 1)
+      g_error ("ncm_fit_esmcmc_set_nprocs: cannot parallelize with an odd number of walkers [%u].", esmcmc->nwalkers);
+    if (nprocs > esmcmc->nwalkers / 2)
+      nprocs = esmcmc->nwalkers / 2;
+  }
+  if (esmcmc->started && (nprocs != esmcmc->nprocs))
+    g_error ("ncm_fit_esmcmc_set_nprocs: cannot change the number of processes during a run, run ncm_fit_esmcmc_end_run() first.");
+
+  esmcmc->nprocs = nprocs;
+}
+
+/**
+ * ncm_fit_esmcmc_set_beta:
+ * @esmcmc: a #NcmFitESMCMC
+ * @beta: inverse temperature $\beta \in (0, 1]$
+ *
+ * Sets the inverse temperature $\beta$, the walkers sample the tempered 
+ * distribution $P L^\beta$ within the free parameters bounds. Here $L$
+ * is the data likelihood and $P$ contains the priors added to the
+ * #NcmLikelihood, which are not tempered, see
+ * ncm_fit_esmcmc_get_m2lnL_data(). The catalog always contains the 
+ * untempered $-2\ln(PL)$ computed by ncm_fit_m2lnL_val(). The default
+ * value $\beta = 1$ samples the posterior, see #NcmFitESMCMCPT for the
+ * parallel tempering sampler.
+ *
+ */
+void 
+ncm_fit_esmcmc_set_beta (NcmFitESMCMC *esmcmc, gdouble beta)
+{
+  g_assert_cmpfloat (beta, >, 0.0);
+  g_assert_cmpfloat (beta, <=, 1.0);
+  esmcmc->beta = beta;
+}
+
+/**
+ * ncm_fit_esmcmc_get_beta:
+ * @esmcmc: a #NcmFitESMCMC
+ *
+ * Returns: the inverse temperature $\beta$.
+ */
+gdouble 
+ncm_fit_esmcmc_get_beta (NcmFitESMCMC *esmcmc)
+{
+  return esmcmc->beta;
+}
+
+static gdouble
+_ncm_fit_esmcmc_m2lnP (NcmFit *fit, NcmVector *theta)
+{
+  gdouble m2lnP = 0.0;
+
+  if (ncm_likelihood_priors_length_f (fit->lh) + ncm_likelihood_priors_length_m2lnL (fit->lh) == 0)
+    return 0.0;
+
+  ncm_mset_fparams_set_vector (fit->mset, theta);
+  ncm_likelihood_priors_m2lnL_val (fit->lh, fit->mset, &m2lnP);
+
+  return m2lnP;
+}
+
+/**
+ * ncm_fit_esmcmc_get_m2lnL_data:
+ * @esmcmc: a #NcmFitESMCMC
+ * @k: walker index
+ *
+ * Computes the data part $-2\ln(L)$ of the current value of the @k-th 
+ * walker, i.e., the value in the catalog minus the contribution of the
+ * priors added to the #NcmLikelihood. This is the term tempered by
+ * ncm_fit_esmcmc_set_beta(). It changes the free parameters of the
+ * model set of the main fit when priors are present.
+ *
+ * Returns: the data $-2\ln(L)$ of the @k-th walker.
+ */
+gdouble
+ncm_fit_esmcmc_get_m2lnL_data (NcmFitESMCMC *esmcmc, guint k)
+{
+  gdouble m2lnL;
+
+  g_assert_cmpuint (k, <, esmcmc->nwalkers);
+
+  m2lnL = ncm_vector_get (g_ptr_array_index (esmcmc->full_theta, k), NCM_FIT_ESMCMC_M2LNL_ID);
+
+  if (!gsl_finite (m2lnL))
+    return m2lnL;
+  else
+    return m2lnL - _ncm_fit_esmcmc_m2lnP (esmcmc->fit, g_ptr_array_index (esmcmc->theta, k));
+}
+
+static gdouble
+_ncm_fit_esmcmc_tempered_m2lnL (NcmFitESMCMC *esmcmc, const gdouble m2lnL, const gdouble m2lnP)
+{
+  return m2lnP + esmcmc->beta * (m2lnL - m2lnP);
+}
+
 /**
  * ncm_fit_esmcmc_set_rng:
  * @esmcmc: a #NcmFitESMCMC
@@ -956,6 +1555,60 @@ _ncm_fit_esmcmc_gen_init_points_mt_eval (glong i, glong f, gpointer data)
   ncm_memory_pool_return (fk_ptr);
 }
 
+static void 
+_ncm_fit_esmcmc_gen_init_points_procs (NcmFitESMCMC *esmcmc, guint ki, guint kf)
+{
+  NcmRNG *rng    = ncm_mset_catalog_peek_rng (esmcmc->mcat);
+  GArray *kindex = g_array_new (FALSE, FALSE, sizeof (guint));
+  GArray *failed = g_array_new (FALSE, FALSE, sizeof (guint));
+  guint k;
+
+  /*
+   * All points are sampled and evaluated in a single batch, then only the 
+   * points with a non-finite m2lnL are resampled (in index order) and sent
+   * again to the workers, until all points are valid. When no evaluation 
+   * fails the draws are the same as in the serial code.
+   */
+  for (k = ki; k < kf; k++)
+    g_array_append_val (kindex, k);
+
+  while (kindex->len > 0)
+  {
+    guint a;
+
+    for (a = 0; a < kindex->len; a++)
+    {
+      const guint k_a    = g_array_index (kindex, guint, a);
+      NcmVector *theta_k = g_ptr_array_index (esmcmc->theta, k_a);
+
+      ncm_mset_trans_kern_prior_sample (esmcmc->sampler, theta_k, rng);
+    }
+
+    _ncm_fit_esmcmc_procs_eval (esmcmc, kindex, esmcmc->theta, esmcmc->full_theta);
+
+    g_array_set_size (failed, 0);
+    for (a = 0; a < kindex->len; a++)
+    {
+      const guint k_a         = g_array_index (kindex, guint, a);
+      NcmVector *full_theta_k = g_ptr_array_index (esmcmc->full_theta, k_a);
+
+      if (gsl_finite (ncm_vector_get (full_theta_k, NCM_FIT_ESMCMC_M2LNL_ID)))
+        g_array_index (esmcmc->accepted, gboolean, k_a) = TRUE;
+      else
+        g_array_append_val (failed, k_a);
+    }
+
+    {
+      GArray *tmp = kindex;
+      kindex = failed;
+      failed = tmp;
+    }
+  }
+
+  g_array_unref (failed);
+  g_array_unref (kindex);
+}
+
 static void 
 _ncm_fit_esmcmc_gen_init_points (NcmFitESMCMC *esmcmc)
 {
@@ -964,7 +1617,12 @@ _ncm_fit_esmcmc_gen_init_points (NcmFitESMCMC *esmcmc)
   else if (esmcmc->cur_sample_id + 1 > esmcmc->nwalkers)
     g_error ("_ncm_fit_esmcmc_gen_init_points: initial points already generated.");
   
-  if (esmcmc->nthreads > 1)
+  if (esmcmc->procs->len > 0)
+  {
+    ncm_mset_catalog_set_sync_mode (esmcmc->mcat, NCM_MSET_CATALOG_SYNC_DISABLE);
+    _ncm_fit_esmcmc_gen_init_points_procs (esmcmc, esmcmc->cur_sample_id + 1, esmcmc->nwalkers);
+  }
+  else if (esmcmc->nthreads > 1)
   {
     ncm_mset_catalog_set_sync_mode (esmcmc->mcat, NCM_MSET_CATALOG_SYNC_DISABLE);
     ncm_func_eval_threaded_loop_full (&_ncm_fit_esmcmc_gen_init_points_mt_eval, esmcmc->cur_sample_id + 1, esmcmc->nwalkers, esmcmc);
@@ -1029,6 +1687,8 @@ ncm_fit_esmcmc_start_run (NcmFitESMCMC *esmcmc)
 
   esmcmc->started = TRUE;
 
+  _ncm_fit_esmcmc_procs_start (esmcmc);
+
   ncm_mset_catalog_set_sync_mode (esmcmc->mcat, NCM_MSET_CATALOG_SYNC_TIMED);
   ncm_mset_catalog_set_sync_interval (esmcmc->mcat, NCM_FIT_ESMCMC_MIN_SYNC_INTERVAL);
   
@@ -1150,6 +1810,8 @@ ncm_fit_esmcmc_end_run (NcmFitESMCMC *esmcmc)
     ncm_timer_task_end (esmcmc->nt);
 
   ncm_mset_catalog_sync (esmcmc->mcat, TRUE);
+
+  _ncm_fit_esmcmc_procs_stop (esmcmc);
   
   esmcmc->started = FALSE;
 }
@@ -1257,6 +1919,10 @@ ncm_fit_esmcmc_run (NcmFitESMCMC *esmcmc, guint n)
   _ncm_fit_esmcmc_run (esmcmc);
 
   ncm_timer_task_pause (esmcmc->nt);
+
+  /* Drivers that run the sampler step by step (e.g. #NcmFitESMCMCPT) write the report themselves. */
+  if (esmcmc->profiler_report)
+    ncm_profiler_report_if_enabled ();
 }
 
 static void 
@@ -1282,12 +1948,19 @@ _ncm_fit_esmcmc_mt_eval (glong i, glong f, gpointer data)
 
     if (ncm_mset_fparam_valid_bounds (fit_k->mset, thetastar))
     {
+      /* Only the data term is tempered, the priors are evaluated at the current point first. */
+      const gdouble m2lnP_cur = (esmcmc->beta != 1.0) ? _ncm_fit_esmcmc_m2lnP (fit_k, g_ptr_array_index (esmcmc->theta, k)) : 0.0;
+
       ncm_mset_fparams_set_vector (fit_k->mset, thetastar);
       ncm_fit_m2lnL_val (fit_k, m2lnL_star);
 
       if (gsl_finite (m2lnL_star[0]))
       {
-        prob = ncm_fit_esmcmc_walker_prob (esmcmc->walker, esmcmc->theta, thetastar, k, m2lnL_cur[0], m2lnL_star[0]);
+        const gdouble m2lnP_star = (esmcmc->beta != 1.0) ? _ncm_fit_esmcmc_m2lnP (fit_k, thetastar) : 0.0;
+
+        prob = ncm_fit_esmcmc_walker_prob (esmcmc->walker, esmcmc->theta, thetastar, k, 
+                                           _ncm_fit_esmcmc_tempered_m2lnL (esmcmc, m2lnL_cur[0], m2lnP_cur),
+                                           _ncm_fit_esmcmc_tempered_m2lnL (esmcmc, m2lnL_star[0], m2lnP_star));
         prob = GSL_MIN (prob, 1.0);
       }
     }
@@ -1319,6 +1992,60 @@ _ncm_fit_esmcmc_mt_eval (glong i, glong f, gpointer data)
   ncm_memory_pool_return (fk_ptr);
 }
 
+static void 
+_ncm_fit_esmcmc_procs_eval_block (NcmFitESMCMC *esmcmc, guint ki, guint kf)
+{
+  GArray *kindex = g_array_new (FALSE, FALSE, sizeof (guint));
+  guint k;
+
+  /* The proposals are computed by the master, as in _ncm_fit_esmcmc_mt_eval. */
+  for (k = ki; k < kf; k++)
+  {
+    NcmVector *thetastar = g_ptr_array_index (esmcmc->thetastar, k);
+
+    ncm_fit_esmcmc_walker_step (esmcmc->walker, esmcmc->theta, thetastar, k);
+
+    if (ncm_mset_fparam_valid_bounds (esmcmc->fit->mset, thetastar))
+      g_array_append_val (kindex, k);
+    else
+      g_array_index (esmcmc->offboard, gboolean, k) = TRUE;
+  }
+
+  if (kindex->len > 0)
+    _ncm_fit_esmcmc_procs_eval (esmcmc, kindex, esmcmc->thetastar, esmcmc->full_thetastar);
+
+  for (k = ki; k < kf; k++)
+  {
+    NcmVector *full_thetastar = g_ptr_array_index (esmcmc->full_thetastar, k);
+    NcmVector *full_theta_k   = g_ptr_array_index (esmcmc->full_theta, k);
+    NcmVector *thetastar      = g_ptr_array_index (esmcmc->thetastar, k);
+    const gdouble m2lnL_cur   = ncm_vector_get (full_theta_k, NCM_FIT_ESMCMC_M2LNL_ID);
+    const gdouble m2lnL_star  = ncm_vector_get (full_thetastar, NCM_FIT_ESMCMC_M2LNL_ID);
+    const gdouble jump        = ncm_vector_get (esmcmc->jumps, k);
+    gdouble prob              = 0.0;
+
+    if (!g_array_index (esmcmc->offboard, gboolean, k) && gsl_finite (m2lnL_star))
+    {
+      /* The priors are cheap, the master evaluates them for the tempered acceptance. */
+      const gdouble m2lnP_cur  = (esmcmc->beta != 1.0) ? _ncm_fit_esmcmc_m2lnP (esmcmc->fit, g_ptr_array_index (esmcmc->theta, k)) : 0.0;
+      const gdouble m2lnP_star = (esmcmc->beta != 1.0) ? _ncm_fit_esmcmc_m2lnP (esmcmc->fit, thetastar) : 0.0;
+
+      prob = ncm_fit_esmcmc_walker_prob (esmcmc->walker, esmcmc->theta, thetastar, k, 
+                                         _ncm_fit_esmcmc_tempered_m2lnL (esmcmc, m2lnL_cur, m2lnP_cur),
+                                         _ncm_fit_esmcmc_tempered_m2lnL (esmcmc, m2lnL_star, m2lnP_star));
+      prob = GSL_MIN (prob, 1.0);
+    }
+
+    if (jump < prob)
+    {
+      ncm_vector_memcpy (full_theta_k, full_thetastar);
+      g_array_index (esmcmc->accepted, gboolean, k) = TRUE;
+    }
+  }
+
+  g_array_unref (kindex);
+}
+
 static void
 _ncm_fit_esmcmc_get_jumps (NcmFitESMCMC *esmcmc, guint ki, guint kf)
 {
@@ -1340,7 +2067,48 @@ _ncm_fit_esmcmc_run (NcmFitESMCMC *esmcmc)
   gboolean mthread = (esmcmc->nthreads > 1);
   guint i;
 
-  if (mthread)
+  if (esmcmc->procs->len > 0)
+  {
+    const guint nwalkers_2 = esmcmc->nwalkers / 2;
+    guint ki = (esmcmc->cur_sample_id + 1) % esmcmc->nwalkers;
+
+    ncm_mset_catalog_set_sync_mode (esmcmc->mcat, NCM_MSET_CATALOG_SYNC_DISABLE);
+    if (esmcmc->n > 0)
+    {
+      _ncm_fit_esmcmc_get_jumps (esmcmc, ki, esmcmc->nwalkers);
+      ncm_fit_esmcmc_walker_setup (esmcmc->walker, esmcmc->theta, ki, esmcmc->nwalkers, rng);
+      
+      if (ki < nwalkers_2)
+      {
+        _ncm_fit_esmcmc_procs_eval_block (esmcmc, ki, nwalkers_2);
+        _ncm_fit_esmcmc_procs_eval_block (esmcmc, nwalkers_2, esmcmc->nwalkers);
+      }
+      else
+      {
+        _ncm_fit_esmcmc_procs_eval_block (esmcmc, ki, esmcmc->nwalkers);
+      }
+
+      ncm_fit_esmcmc_walker_clean (esmcmc->walker, ki, esmcmc->nwalkers);
+
+      _ncm_fit_esmcmc_update (esmcmc, ki, esmcmc->nwalkers);
+      ncm_mset_catalog_timed_sync (esmcmc->mcat, FALSE);
+
+      for (i = 1; i < esmcmc->n; i++)
+      {
+        _ncm_fit_esmcmc_get_jumps (esmcmc, 0, esmcmc->nwalkers);
+        ncm_fit_esmcmc_walker_setup (esmcmc->walker, esmcmc->theta, 0, esmcmc->nwalkers, rng);
+        
+        _ncm_fit_esmcmc_procs_eval_block (esmcmc, 0, nwalkers_2);
+        _ncm_fit_esmcmc_procs_eval_block (esmcmc, nwalkers_2, esmcmc->nwalkers);
+
+        ncm_fit_esmcmc_walker_clean (esmcmc->walker, 0, esmcmc->nwalkers);
+
+        _ncm_fit_esmcmc_update (esmcmc, 0, esmcmc->nwalkers);
+        ncm_mset_catalog_timed_sync (esmcmc->mcat, FALSE);
+      }
+    }
+  }
+  else if (mthread)
   {
     const guint nwalkers_2 = esmcmc->nwalkers / 2;
     guint ki = (esmcmc->cur_sample_id + 1) % esmcmc->nwalkers;
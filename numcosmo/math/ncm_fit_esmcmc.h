@@ -87,6 +87,9 @@ struct _NcmFitESMCMC
   guint nadd_vals;
   guint fparam_len;
   guint nthreads;
+  guint nprocs;
+  GArray *procs;
+  gdouble beta;
   guint n;
   gint nwalkers;
   gint cur_sample_id;
@@ -94,6 +97,7 @@ struct _NcmFitESMCMC
   guint naccepted;
   guint noffboard;
   gboolean started;
+  gboolean profiler_report;
   GMutex dup_fit;
   GMutex resample_lock;
   GMutex update_lock;
@@ -113,6 +117,10 @@ void ncm_fit_esmcmc_set_data_file (NcmFitESMCMC *esmcmc, const gchar *filename);
 void ncm_fit_esmcmc_set_sampler (NcmFitESMCMC *esmcmc, NcmMSetTransKern *sampler);
 void ncm_fit_esmcmc_set_mtype (NcmFitESMCMC *esmcmc, NcmFitRunMsgs mtype);
 void ncm_fit_esmcmc_set_nthreads (NcmFitESMCMC *esmcmc, guint nthreads);
+void ncm_fit_esmcmc_set_nprocs (NcmFitESMCMC *esmcmc, guint nprocs);
+void ncm_fit_esmcmc_set_beta (NcmFitESMCMC *esmcmc, gdouble beta);
+gdouble ncm_fit_esmcmc_get_beta (NcmFitESMCMC *esmcmc);
+gdouble ncm_fit_esmcmc_get_m2lnL_data (NcmFitESMCMC *esmcmc, guint k);
 void ncm_fit_esmcmc_set_rng (NcmFitESMCMC *esmcmc, NcmRNG *rng);
 void ncm_fit_esmcmc_set_auto_trim (NcmFitESMCMC *esmcmc, gboolean enable);
 void ncm_fit_esmcmc_set_auto_trim_div (NcmFitESMCMC *esmcmc, guint div);
@@ -136,8 +144,11 @@ NcmMSetCatalog *ncm_fit_esmcmc_get_catalog (NcmFitESMCMC *esmcmc);
 
 gboolean ncm_fit_esmcmc_validate (NcmFitESMCMC *esmcmc, gulong pi, gulong pf);
 
+void ncm_fit_esmcmc_proc_worker (gint fd);
+
 #define NCM_FIT_ESMCMC_MIN_SYNC_INTERVAL (10.0)
 #define NCM_FIT_ESMCMC_M2LNL_ID (0)
+#define NCM_FIT_ESMCMC_WORKER_ENV "NUMCOSMO_ESMCMC_WORKER"
 
 G_END_DECLS
 
@@ -0,0 +1,872 @@
+/***************************************************************************
+ *            ncm_fit_esmcmc_pt.c
+ *
+ *  Sun October 18 14:21:24 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_fit_esmcmc_pt.c
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:ncm_fit_esmcmc_pt
+ * @title: NcmFitESMCMCPT
+ * @short_description: Parallel tempering ensemble sampler.
+ *
+ * Parallel tempering built on top of #NcmFitESMCMC. The object keeps a
+ * ladder of $n_T$ ensemble samplers, the $i$-th one samples the tempered
+ * distribution $L^{\beta_i}\pi$ (see ncm_fit_esmcmc_set_beta()), where
+ * $L$ is the data likelihood and $\pi$ is the prior, i.e., the priors
+ * added to the #NcmLikelihood times the flat distribution within the free
+ * parameters bounds. Only the data term is tempered. The level
+ * $\beta_0 = 1$ is the posterior and the inverse temperatures decrease
+ * geometrically down to $\beta_{n_T-1} = 1/T_\mathrm{max}$. Each level
+ * writes its own #NcmMSetCatalog and is evaluated using its own threads
+ * or worker processes, see ncm_fit_esmcmc_set_nthreads() and
+ * ncm_fit_esmcmc_set_nprocs().
+ *
+ * After each ensemble step, the walkers of adjacent levels are paired
+ * (using a random permutation of the hotter level) and their positions
+ * are swapped with probability
+ * $$\min\left\{1, \exp\left[\frac{(\beta_i - \beta_{i+1})(-2\ln L_i + 2\ln L_{i+1})}{2}\right]\right\},$$
+ * where $-2\ln L$ is computed by ncm_fit_esmcmc_get_m2lnL_data().
+ * The catalogs contain the points before the swaps, hence, the catalog
+ * of the level $i=0$ is a valid posterior chain.
+ *
+ * When adaptation is enabled (ncm_fit_esmcmc_pt_set_adapt()) the
+ * intermediate temperatures are changed after each step to equalize the
+ * swap acceptance ratios between adjacent levels, following Vousden, Farr
+ * & Mandel (2016), keeping them ordered and below $T_\mathrm{max}$. The
+ * chains must not be used for inference while adapting, thus, the
+ * thermodynamic integration accumulators are only updated when adaptation
+ * is disabled. The evidence is then estimated by
+ * $$\ln Z = \int_0^1\mathrm{d}\beta\,\langle\ln L\rangle_\beta,$$
+ * see ncm_fit_esmcmc_pt_evidence(). This is the evidence 
+ * $Z = \int\mathrm{d}\theta\,L\pi$, which requires $\pi$ to be normalized,
+ * i.e., the likelihood priors must be normalized and contained in the
+ * parameters box.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif /* HAVE_CONFIG_H */
+#include "build_cfg.h"
+
+#include "math/ncm_fit_esmcmc_pt.h"
+#include "math/ncm_util.h"
+#include "math/ncm_cfg.h"
+#include "math/ncm_profiler.h"
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_randist.h>
+
+enum
+{
+  PROP_0,
+  PROP_ESMCMC,
+  PROP_NTEMPS,
+  PROP_TMAX,
+  PROP_ADAPT,
+  PROP_ADAPT_LAG,
+  PROP_ADAPT_TIME,
+  PROP_SIZE,
+};
+
+G_DEFINE_TYPE (NcmFitESMCMCPT, ncm_fit_esmcmc_pt, G_TYPE_OBJECT);
+
+static void
+ncm_fit_esmcmc_pt_init (NcmFitESMCMCPT *pt)
+{
+  pt->esmcmc      = NULL;
+  pt->levels      = g_ptr_array_new ();
+  pt->ntemps      = 0;
+  pt->tmax        = 0.0;
+  pt->adapt       = FALSE;
+  pt->adapt_lag   = 0.0;
+  pt->adapt_time  = 0.0;
+  pt->nadapt      = 0;
+  pt->beta        = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  pt->swap_try    = g_array_new (FALSE, FALSE, sizeof (gulong));
+  pt->swap_acc    = g_array_new (FALSE, FALSE, sizeof (gulong));
+  pt->step_acc    = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  pt->m2lnL_sum   = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  pt->m2lnL_count = g_array_new (FALSE, FALSE, sizeof (gulong));
+  pt->perm        = g_array_new (FALSE, FALSE, sizeof (guint));
+  pt->started     = FALSE;
+
+  g_ptr_array_set_free_func (pt->levels, (GDestroyNotify) ncm_fit_esmcmc_free);
+}
+
+static void
+_ncm_fit_esmcmc_pt_constructed (GObject *object)
+{
+  /* Chain up : start */
+  G_OBJECT_CLASS (ncm_fit_esmcmc_pt_parent_class)->constructed (object);
+  {
+    NcmFitESMCMCPT *pt   = NCM_FIT_ESMCMC_PT (object);
+    NcmFitESMCMC *esmcmc = pt->esmcmc;
+    guint i;
+
+    g_assert (esmcmc != NULL);
+    g_assert_cmpuint (pt->ntemps, >=, 2);
+
+    g_array_set_size (pt->beta,        pt->ntemps);
+    g_array_set_size (pt->swap_try,    pt->ntemps - 1);
+    g_array_set_size (pt->swap_acc,    pt->ntemps - 1);
+    g_array_set_size (pt->step_acc,    pt->ntemps - 1);
+    g_array_set_size (pt->m2lnL_sum,   pt->ntemps);
+    g_array_set_size (pt->m2lnL_count, pt->ntemps);
+    g_array_set_size (pt->perm,        esmcmc->nwalkers);
+
+    g_ptr_array_add (pt->levels, g_object_ref (esmcmc));
+
+    for (i = 0; i < pt->ntemps; i++)
+    {
+      const gdouble beta = pow (pt->tmax, - i / (pt->ntemps - 1.0));
+
+      if (i > 0)
+      {
+        NcmFitESMCMC *level = ncm_fit_esmcmc_new_funcs_array (esmcmc->fit, esmcmc->nwalkers,
+                                                              esmcmc->sampler, esmcmc->walker,
+                                                              NCM_FIT_RUN_MSGS_NONE, esmcmc->funcs_oa);
+
+        ncm_fit_esmcmc_set_nthreads (level, esmcmc->nthreads);
+        ncm_fit_esmcmc_set_nprocs (level, esmcmc->nprocs);
+
+        g_ptr_array_add (pt->levels, level);
+      }
+
+      g_array_index (pt->beta, gdouble, i) = beta;
+      ncm_fit_esmcmc_set_beta (g_ptr_array_index (pt->levels, i), beta);
+    }
+
+    for (i = 0; i < (guint) esmcmc->nwalkers; i++)
+      g_array_index (pt->perm, guint, i) = i;
+
+    ncm_fit_esmcmc_pt_reset_evidence (pt);
+  }
+}
+
+static void
+_ncm_fit_esmcmc_pt_set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
+{
+  NcmFitESMCMCPT *pt = NCM_FIT_ESMCMC_PT (object);
+  g_return_if_fail (NCM_IS_FIT_ESMCMC_PT (object));
+
+  switch (prop_id)
+  {
+    case PROP_ESMCMC:
+      pt->esmcmc = g_value_dup_object (value);
+      break;
+    case PROP_NTEMPS:
+      pt->ntemps = g_value_get_uint (value);
+      break;
+    case PROP_TMAX:
+      pt->tmax = g_value_get_double (value);
+      break;
+    case PROP_ADAPT:
+      ncm_fit_esmcmc_pt_set_adapt (pt, g_value_get_boolean (value));
+      break;
+    case PROP_ADAPT_LAG:
+      ncm_fit_esmcmc_pt_set_adapt_lag (pt, g_value_get_double (value));
+      break;
+    case PROP_ADAPT_TIME:
+      ncm_fit_esmcmc_pt_set_adapt_time (pt, g_value_get_double (value));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+_ncm_fit_esmcmc_pt_get_property (GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
+{
+  NcmFitESMCMCPT *pt = NCM_FIT_ESMCMC_PT (object);
+  g_return_if_fail (NCM_IS_FIT_ESMCMC_PT (object));
+
+  switch (prop_id)
+  {
+    case PROP_ESMCMC:
+      g_value_set_object (value, pt->esmcmc);
+      break;
+    case PROP_NTEMPS:
+      g_value_set_uint (value, pt->ntemps);
+      break;
+    case PROP_TMAX:
+      g_value_set_double (value, pt->tmax);
+      break;
+    case PROP_ADAPT:
+      g_value_set_boolean (value, pt->adapt);
+      break;
+    case PROP_ADAPT_LAG:
+      g_value_set_double (value, pt->adapt_lag);
+      break;
+    case PROP_ADAPT_TIME:
+      g_value_set_double (value, pt->adapt_time);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+_ncm_fit_esmcmc_pt_dispose (GObject *object)
+{
+  NcmFitESMCMCPT *pt = NCM_FIT_ESMCMC_PT (object);
+
+  ncm_fit_esmcmc_clear (&pt->esmcmc);
+
+  g_clear_pointer (&pt->levels, g_ptr_array_unref);
+  g_clear_pointer (&pt->beta, g_array_unref);
+  g_clear_pointer (&pt->swap_try, g_array_unref);
+  g_clear_pointer (&pt->swap_acc, g_array_unref);
+  g_clear_pointer (&pt->step_acc, g_array_unref);
+  g_clear_pointer (&pt->m2lnL_sum, g_array_unref);
+  g_clear_pointer (&pt->m2lnL_count, g_array_unref);
+  g_clear_pointer (&pt->perm, g_array_unref);
+
+  /* Chain up : end */
+  G_OBJECT_CLASS (ncm_fit_esmcmc_pt_parent_class)->dispose (object);
+}
+
+static void
+_ncm_fit_esmcmc_pt_finalize (GObject *object)
+{
+
+  /* Chain up : end */
+  G_OBJECT_CLASS (ncm_fit_esmcmc_pt_parent_class)->finalize (object);
+}
+
+static void
+ncm_fit_esmcmc_pt_class_init (NcmFitESMCMCPTClass *klass)
+{
+  GObjectClass* object_class = G_OBJECT_CLASS (klass);
+
+  object_class->constructed  = &_ncm_fit_esmcmc_pt_constructed;
+  object_class->set_property = &_ncm_fit_esmcmc_pt_set_property;
+  object_class->get_property = &_ncm_fit_esmcmc_pt_get_property;
+  object_class->dispose      = &_ncm_fit_esmcmc_pt_dispose;
+  object_class->finalize     = &_ncm_fit_esmcmc_pt_finalize;
+
+  g_object_class_install_property (object_class,
+                                   PROP_ESMCMC,
+                                   g_param_spec_object ("esmcmc",
+                                                        NULL,
+                                                        "Ensemble sampler at unit temperature",
+                                                        NCM_TYPE_FIT_ESMCMC,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_NTEMPS,
+                                   g_param_spec_uint ("ntemps",
+                                                      NULL,
+                                                      "Number of temperatures",
+                                                      2, G_MAXUINT32, 4,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_TMAX,
+                                   g_param_spec_double ("tmax",
+                                                        NULL,
+                                                        "Maximum temperature",
+                                                        1.0, G_MAXDOUBLE, 1.0e2,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_ADAPT,
+                                   g_param_spec_boolean ("adapt",
+                                                         NULL,
+                                                         "Whether to adapt the temperature ladder",
+                                                         FALSE,
+                                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_ADAPT_LAG,
+                                   g_param_spec_double ("adapt-lag",
+                                                        NULL,
+                                                        "Ladder adaptation lag",
+                                                        1.0, G_MAXDOUBLE, 1.0e4,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_ADAPT_TIME,
+                                   g_param_spec_double ("adapt-time",
+                                                        NULL,
+                                                        "Ladder adaptation time scale",
+                                                        1.0, G_MAXDOUBLE, 1.0e2,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+}
+
+/**
+ * ncm_fit_esmcmc_pt_new:
+ * @esmcmc: a #NcmFitESMCMC
+ * @ntemps: number of temperatures $n_T \geq 2$
+ * @tmax: maximum temperature $T_\mathrm{max}$
+ *
+ * Creates a new #NcmFitESMCMCPT using @esmcmc as the unit temperature
+ * level. The other $n_T - 1$ levels are created using the same #NcmFit,
+ * number of walkers, initial point sampler, walker, functions array and
+ * parallelization settings of @esmcmc.
+ *
+ * Returns: (transfer full): a new #NcmFitESMCMCPT.
+ */
+NcmFitESMCMCPT *
+ncm_fit_esmcmc_pt_new (NcmFitESMCMC *esmcmc, guint ntemps, gdouble tmax)
+{
+  NcmFitESMCMCPT *pt = g_object_new (NCM_TYPE_FIT_ESMCMC_PT,
+                                     "esmcmc", esmcmc,
+                                     "ntemps", ntemps,
+                                     "tmax",   tmax,
+                                     NULL);
+  return pt;
+}
+
+/**
+ * ncm_fit_esmcmc_pt_ref:
+ * @pt: a #NcmFitESMCMCPT
+ *
+ * Increases the reference count of @pt by one.
+ *
+ * Returns: (transfer full): @pt.
+ */
+NcmFitESMCMCPT *
+ncm_fit_esmcmc_pt_ref (NcmFitESMCMCPT *pt)
+{
+  return g_object_ref (pt);
+}
+
+/**
+ * ncm_fit_esmcmc_pt_free:
+ * @pt: a #NcmFitESMCMCPT
+ *
+ * Decreases the reference count of @pt by one.
+ *
+ */
+void
+ncm_fit_esmcmc_pt_free (NcmFitESMCMCPT *pt)
+{
+  g_object_unref (pt);
+}
+
+/**
+ * ncm_fit_esmcmc_pt_clear:
+ * @pt: a #NcmFitESMCMCPT
+ *
+ * If *@pt is different from NULL, decreases the reference count of
+ * *@pt by one and sets *@pt to NULL.
+ *
+ */
+void
+ncm_fit_esmcmc_pt_clear (NcmFitESMCMCPT **pt)
+{
+  g_clear_object (pt);
+}
+
+/**
+ * ncm_fit_esmcmc_pt_set_data_file:
+ * @pt: a #NcmFitESMCMCPT
+ * @filename: a filename
+ *
+ * Sets the catalog files of all levels. The unit temperature level uses
+ * @filename, the $i$-th level uses "base_T<i>.fits" where base is
+ * @filename without the fits extension.
+ *
+ */
+void
+ncm_fit_esmcmc_pt_set_data_file (NcmFitESMCMCPT *pt, const gchar *filename)
+{
+  gchar *base_name = ncm_util_basename_fits (filename);
+  guint i;
+
+  ncm_fit_esmcmc_set_data_file (g_ptr_array_index (pt->levels, 0), filename);
+
+  for (i = 1; i < pt->ntemps; i++)
+  {
+    gchar *level_filename = g_strdup_printf ("%s_T%u.fits", base_name, i);
+
+    ncm_fit_esmcmc_set_data_file (g_ptr_array_index (pt->levels, i), level_filename);
+
+    g_free (level_filename);
+  }
+
+  g_free (base_name);
+}
+
+/**
+ * ncm_fit_esmcmc_pt_set_adapt:
+ * @pt: a #NcmFitESMCMCPT
+ * @adapt: whether to adapt the temperature ladder
+ *
+ * Enables or disables the temperature ladder adaptation. Disabling
+ * the adaptation resets the thermodynamic integration accumulators,
+ * see ncm_fit_esmcmc_pt_reset_evidence().
+ *
+ */
+void
+ncm_fit_esmcmc_pt_set_adapt (NcmFitESMCMCPT *pt, gboolean adapt)
+{
+  if (pt->adapt && !adapt && pt->ntemps > 0)
+    ncm_fit_esmcmc_pt_reset_evidence (pt);
+
+  pt->adapt = adapt;
+}
+
+/**
+ * ncm_fit_esmcmc_pt_set_adapt_lag:
+ * @pt: a #NcmFitESMCMCPT
+ * @lag: adaptation lag $t_0$
+ *
+ * Sets the adaptation lag $t_0$, the amplitude of the ladder changes
+ * decays as $t_0 / (t + t_0)$ where $t$ is the number of adaptation steps.
+ *
+ */
+void
+ncm_fit_esmcmc_pt_set_adapt_lag (NcmFitESMCMCPT *pt, gdouble lag)
+{
+  g_assert_cmpfloat (lag, >, 0.0);
+  pt->adapt_lag = lag;
+}
+
+/**
+ * ncm_fit_esmcmc_pt_set_adapt_time:
+ * @pt: a #NcmFitESMCMCPT
+ * @time: adaptation time scale $\nu$
+ *
+ * Sets the adaptation time scale $\nu$, the log-temperature spacings
+ * change by $(A_i - A_{i+1})/\nu$ at the beginning of the adaptation,
+ * where $A_i$ is the swap acceptance ratio between levels $i$ and $i+1$.
+ *
+ */
+void
+ncm_fit_esmcmc_pt_set_adapt_time (NcmFitESMCMCPT *pt, gdouble time)
+{
+  g_assert_cmpfloat (time, >, 0.0);
+  pt->adapt_time = time;
+}
+
+/**
+ * ncm_fit_esmcmc_pt_get_adapt:
+ * @pt: a #NcmFitESMCMCPT
+ *
+ * Returns: whether the temperature ladder is being adapted.
+ */
+gboolean
+ncm_fit_esmcmc_pt_get_adapt (NcmFitESMCMCPT *pt)
+{
+  return pt->adapt;
+}
+
+/**
+ * ncm_fit_esmcmc_pt_get_ntemps:
+ * @pt: a #NcmFitESMCMCPT
+ *
+ * Returns: the number of temperatures $n_T$.
+ */
+guint
+ncm_fit_esmcmc_pt_get_ntemps (NcmFitESMCMCPT *pt)
+{
+  return pt->ntemps;
+}
+
+/**
+ * ncm_fit_esmcmc_pt_get_beta:
+ * @pt: a #NcmFitESMCMCPT
+ * @i: level index
+ *
+ * Returns: the current inverse temperature $\beta_i$ of the @i-th level.
+ */
+gdouble
+ncm_fit_esmcmc_pt_get_beta (NcmFitESMCMCPT *pt, guint i)
+{
+  g_assert_cmpuint (i, <, pt->ntemps);
+  return g_array_index (pt->beta, gdouble, i);
+}
+
+/**
+ * ncm_fit_esmcmc_pt_get_swap_accept_ratio:
+ * @pt: a #NcmFitESMCMCPT
+ * @i: level index
+ *
+ * Returns: the swap acceptance ratio between the levels @i and @i + 1.
+ */
+gdouble
+ncm_fit_esmcmc_pt_get_swap_accept_ratio (NcmFitESMCMCPT *pt, guint i)
+{
+  gulong ntry;
+
+  g_assert_cmpuint (i + 1, <, pt->ntemps);
+
+  ntry = g_array_index (pt->swap_try, gulong, i);
+
+  return (ntry > 0) ? g_array_index (pt->swap_acc, gulong, i) * 1.0 / ntry : 0.0;
+}
+
+/**
+ * ncm_fit_esmcmc_pt_peek_level:
+ * @pt: a #NcmFitESMCMCPT
+ * @i: level index
+ *
+ * Returns: (transfer none): the #NcmFitESMCMC of the @i-th level.
+ */
+NcmFitESMCMC *
+ncm_fit_esmcmc_pt_peek_level (NcmFitESMCMCPT *pt, guint i)
+{
+  g_assert_cmpuint (i, <, pt->ntemps);
+  return g_ptr_array_index (pt->levels, i);
+}
+
+/**
+ * ncm_fit_esmcmc_pt_start_run:
+ * @pt: a #NcmFitESMCMCPT
+ *
+ * Starts all levels, see ncm_fit_esmcmc_start_run(). Levels without
+ * a #NcmRNG receive one seeded from the unit temperature level #NcmRNG.
+ *
+ */
+void
+ncm_fit_esmcmc_pt_start_run (NcmFitESMCMCPT *pt)
+{
+  NcmFitESMCMC *esmcmc = g_ptr_array_index (pt->levels, 0);
+  NcmRNG *rng;
+  guint i;
+
+  if (pt->started)
+    g_error ("ncm_fit_esmcmc_pt_start_run: run already started, run ncm_fit_esmcmc_pt_end_run() first.");
+
+  ncm_fit_esmcmc_start_run (esmcmc);
+  rng = ncm_mset_catalog_peek_rng (esmcmc->mcat);
+
+  for (i = 1; i < pt->ntemps; i++)
+  {
+    NcmFitESMCMC *level = g_ptr_array_index (pt->levels, i);
+
+    if (ncm_mset_catalog_peek_rng (level->mcat) == NULL)
+    {
+      NcmRNG *level_rng = ncm_rng_seeded_new (ncm_rng_get_algo (rng), ncm_rng_get_seed (rng) + i);
+
+      ncm_fit_esmcmc_set_rng (level, level_rng);
+      ncm_rng_free (level_rng);
+    }
+
+    ncm_fit_esmcmc_start_run (level);
+  }
+
+  pt->started = TRUE;
+}
+
+/**
+ * ncm_fit_esmcmc_pt_end_run:
+ * @pt: a #NcmFitESMCMCPT
+ *
+ * Ends the run of all levels, see ncm_fit_esmcmc_end_run().
+ *
+ */
+void
+ncm_fit_esmcmc_pt_end_run (NcmFitESMCMCPT *pt)
+{
+  guint i;
+
+  if (!pt->started)
+    g_error ("ncm_fit_esmcmc_pt_end_run: run not started, run ncm_fit_esmcmc_pt_start_run() first.");
+
+  for (i = 0; i < pt->ntemps; i++)
+    ncm_fit_esmcmc_end_run (g_ptr_array_index (pt->levels, i));
+
+  pt->started = FALSE;
+}
+
+static void
+_ncm_fit_esmcmc_pt_swap (NcmFitESMCMCPT *pt, NcmRNG *rng)
+{
+  const guint nwalkers = pt->esmcmc->nwalkers;
+  guint *perm          = &g_array_index (pt->perm, guint, 0);
+  gint i;
+
+  ncm_rng_lock (rng);
+  for (i = pt->ntemps - 2; i >= 0; i--)
+  {
+    NcmFitESMCMC *cold  = g_ptr_array_index (pt->levels, i);
+    NcmFitESMCMC *hot   = g_ptr_array_index (pt->levels, i + 1);
+    const gdouble dbeta = g_array_index (pt->beta, gdouble, i) - g_array_index (pt->beta, gdouble, i + 1);
+    guint naccepted     = 0;
+    guint k;
+
+    gsl_ran_shuffle (rng->r, perm, nwalkers, sizeof (guint));
+
+    for (k = 0; k < nwalkers; k++)
+    {
+      NcmVector *theta_cold   = g_ptr_array_index (cold->full_theta, k);
+      NcmVector *theta_hot    = g_ptr_array_index (hot->full_theta, perm[k]);
+      const gdouble m2lnL_c   = ncm_fit_esmcmc_get_m2lnL_data (cold, k);
+      const gdouble m2lnL_h   = ncm_fit_esmcmc_get_m2lnL_data (hot, perm[k]);
+      const gdouble lnaccept  = 0.5 * dbeta * (m2lnL_c - m2lnL_h);
+
+      if (!gsl_finite (m2lnL_c) || !gsl_finite (m2lnL_h))
+        continue;
+
+      if ((lnaccept >= 0.0) || (log (gsl_rng_uniform_pos (rng->r)) < lnaccept))
+      {
+        gsl_vector_swap (ncm_vector_gsl (theta_cold), ncm_vector_gsl (theta_hot));
+        naccepted++;
+      }
+    }
+
+    g_array_index (pt->swap_try, gulong, i) += nwalkers;
+    g_array_index (pt->swap_acc, gulong, i) += naccepted;
+    g_array_index (pt->step_acc, gdouble, i) = naccepted * 1.0 / nwalkers;
+  }
+  ncm_rng_unlock (rng);
+}
+
+static void
+_ncm_fit_esmcmc_pt_adapt (NcmFitESMCMCPT *pt)
+{
+  const gdouble kappa = pt->adapt_lag / (pt->nadapt + pt->adapt_lag) / pt->adapt_time;
+  gdouble T_prev      = 1.0 / g_array_index (pt->beta, gdouble, 0);
+  gdouble T_new       = T_prev;
+  guint i;
+
+  /* The hottest temperature is kept fixed, only the intermediate spacings change. */
+  for (i = 0; i + 2 < pt->ntemps; i++)
+  {
+    const gdouble T_i  = 1.0 / g_array_index (pt->beta, gdouble, i + 1);
+    const gdouble dS   = kappa * (g_array_index (pt->step_acc, gdouble, i) - g_array_index (pt->step_acc, gdouble, i + 1));
+    const gdouble dT   = (T_i - T_prev) * exp (dS);
+
+    T_prev = T_i;
+
+    /* dT > 0 keeps the ladder ordered, the level must also stay below T_max. */
+    if (T_new + dT < pt->tmax)
+      T_new += dT;
+    else
+      T_new = sqrt (T_new * pt->tmax);
+
+    g_array_index (pt->beta, gdouble, i + 1) = 1.0 / T_new;
+  }
+
+  for (i = 1; i + 1 < pt->ntemps; i++)
+    ncm_fit_esmcmc_set_beta (g_ptr_array_index (pt->levels, i), g_array_index (pt->beta, gdouble, i));
+
+  pt->nadapt++;
+}
+
+static void
+_ncm_fit_esmcmc_pt_accumulate (NcmFitESMCMCPT *pt)
+{
+  guint i;
+
+  for (i = 0; i < pt->ntemps; i++)
+  {
+    NcmFitESMCMC *level = g_ptr_array_index (pt->levels, i);
+    gint k;
+
+    for (k = 0; k < level->nwalkers; k++)
+    {
+      const gdouble m2lnL = ncm_fit_esmcmc_get_m2lnL_data (level, k);
+
+      if (gsl_finite (m2lnL))
+      {
+        g_array_index (pt->m2lnL_sum, gdouble, i)  += m2lnL;
+        g_array_index (pt->m2lnL_count, gulong, i) += 1;
+      }
+    }
+  }
+}
+
+/**
+ * ncm_fit_esmcmc_pt_run:
+ * @pt: a #NcmFitESMCMCPT
+ * @n: total number of ensemble steps
+ *
+ * Runs all levels until they reach the @n-th ensemble step. After each
+ * step the adjacent levels exchange walkers and, if enabled, the ladder
+ * is adapted. Otherwise, the thermodynamic integration accumulators are
+ * updated with the current ensemble of each level.
+ *
+ */
+void
+ncm_fit_esmcmc_pt_run (NcmFitESMCMCPT *pt, guint n)
+{
+  NcmFitESMCMC *esmcmc      = g_ptr_array_index (pt->levels, 0);
+  const NcmFitRunMsgs mtype = esmcmc->mtype;
+  NcmRNG *rng;
+  guint t;
+
+  if (!pt->started)
+    g_error ("ncm_fit_esmcmc_pt_run: run not started, run ncm_fit_esmcmc_pt_start_run() first.");
+
+  rng = ncm_mset_catalog_peek_rng (esmcmc->mcat);
+  t   = (esmcmc->cur_sample_id + 1) / esmcmc->nwalkers;
+
+  if (mtype > NCM_FIT_RUN_MSGS_NONE)
+  {
+    ncm_cfg_msg_sepa ();
+    g_message ("# NcmFitESMCMCPT: Calculating [%06d] parallel tempering steps with %u temperatures%s.\n",
+               (n > t) ? n - t : 0, pt->ntemps, pt->adapt ? " (adapting ladder)" : "");
+  }
+
+  /* 
+   * The levels are stepped one ensemble at a time, their own messages would
+   * be too verbose and the profiler report is written once at the end.
+   */
+  ncm_fit_esmcmc_set_mtype (esmcmc, NCM_FIT_RUN_MSGS_NONE);
+  {
+    guint i;
+
+    for (i = 0; i < pt->ntemps; i++)
+      NCM_FIT_ESMCMC (g_ptr_array_index (pt->levels, i))->profiler_report = FALSE;
+  }
+
+  for (t = t + 1; t <= n; t++)
+  {
+    guint i;
+
+    for (i = 0; i < pt->ntemps; i++)
+      ncm_fit_esmcmc_run (g_ptr_array_index (pt->levels, i), t);
+
+    _ncm_fit_esmcmc_pt_swap (pt, rng);
+
+    if (pt->adapt)
+      _ncm_fit_esmcmc_pt_adapt (pt);
+    else
+      _ncm_fit_esmcmc_pt_accumulate (pt);
+  }
+
+  ncm_fit_esmcmc_set_mtype (esmcmc, mtype);
+  {
+    guint i;
+
+    for (i = 0; i < pt->ntemps; i++)
+      NCM_FIT_ESMCMC (g_ptr_array_index (pt->levels, i))->profiler_report = TRUE;
+  }
+
+  ncm_profiler_report_if_enabled ();
+
+  if (mtype > NCM_FIT_RUN_MSGS_NONE)
+  {
+    guint i;
+
+    for (i = 0; i < pt->ntemps; i++)
+    {
+      NcmFitESMCMC *level = g_ptr_array_index (pt->levels, i);
+
+      if (i + 1 < pt->ntemps)
+        g_message ("# NcmFitESMCMCPT: T[%02u] = % 12.5g, accept ratio %7.4f%%, swap ratio %7.4f%%.\n",
+                   i, 1.0 / g_array_index (pt->beta, gdouble, i),
+                   ncm_fit_esmcmc_get_accept_ratio (level) * 100.0,
+                   ncm_fit_esmcmc_pt_get_swap_accept_ratio (pt, i) * 100.0);
+      else
+        g_message ("# NcmFitESMCMCPT: T[%02u] = % 12.5g, accept ratio %7.4f%%.\n",
+                   i, 1.0 / g_array_index (pt->beta, gdouble, i),
+                   ncm_fit_esmcmc_get_accept_ratio (level) * 100.0);
+    }
+  }
+}
+
+/**
+ * ncm_fit_esmcmc_pt_reset_evidence:
+ * @pt: a #NcmFitESMCMCPT
+ *
+ * Resets the thermodynamic integration accumulators and the swap
+ * acceptance counters.
+ *
+ */
+void
+ncm_fit_esmcmc_pt_reset_evidence (NcmFitESMCMCPT *pt)
+{
+  guint i;
+
+  for (i = 0; i < pt->ntemps; i++)
+  {
+    g_array_index (pt->m2lnL_sum, gdouble, i)  = 0.0;
+    g_array_index (pt->m2lnL_count, gulong, i) = 0;
+
+    if (i + 1 < pt->ntemps)
+    {
+      g_array_index (pt->swap_try, gulong, i) = 0;
+      g_array_index (pt->swap_acc, gulong, i) = 0;
+      g_array_index (pt->step_acc, gdouble, i) = 0.0;
+    }
+  }
+}
+
+static gdouble
+_ncm_fit_esmcmc_pt_mean_lnL (NcmFitESMCMCPT *pt, guint i)
+{
+  const gulong count = g_array_index (pt->m2lnL_count, gulong, i);
+
+  if (count == 0)
+    g_error ("ncm_fit_esmcmc_pt_evidence: no samples accumulated for level %u, run without adaptation first.", i);
+
+  return -0.5 * g_array_index (pt->m2lnL_sum, gdouble, i) / count;
+}
+
+/**
+ * ncm_fit_esmcmc_pt_evidence:
+ * @pt: a #NcmFitESMCMCPT
+ * @lnZ: (out): the evidence logarithm $\ln Z$
+ * @lnZ_err: (out): the discretization error estimate
+ *
+ * Computes the evidence using thermodynamic integration, i.e., the
+ * integral of the data term $\langle\ln L\rangle_\beta$ from $\beta = 0$
+ * to $1$ using the trapezoidal rule over the ladder. The value at $\beta = 0$ is
+ * approximated by the hottest level mean. The error @lnZ_err is the
+ * difference between the estimates using all levels and every other
+ * level, and it is dominated by the ladder discretization, not by the
+ * sampling noise.
+ *
+ */
+void
+ncm_fit_esmcmc_pt_evidence (NcmFitESMCMCPT *pt, gdouble *lnZ, gdouble *lnZ_err)
+{
+  const guint top  = pt->ntemps - 1;
+  gdouble beta_top = g_array_index (pt->beta, gdouble, top);
+  gdouble lnL_top  = _ncm_fit_esmcmc_pt_mean_lnL (pt, top);
+  gdouble full     = beta_top * lnL_top;
+  gdouble half     = full;
+  gint i;
+
+  /* Full ladder: levels are ordered by decreasing beta. */
+  for (i = top - 1; i >= 0; i--)
+  {
+    const gdouble dbeta = g_array_index (pt->beta, gdouble, i) - g_array_index (pt->beta, gdouble, i + 1);
+
+    full += 0.5 * dbeta * (_ncm_fit_esmcmc_pt_mean_lnL (pt, i) + _ncm_fit_esmcmc_pt_mean_lnL (pt, i + 1));
+  }
+
+  /* Every other level, always including beta = 1. */
+  {
+    gint prev = top;
+
+    for (i = top - 2; i >= 0; i -= 2)
+    {
+      const gdouble dbeta = g_array_index (pt->beta, gdouble, i) - g_array_index (pt->beta, gdouble, prev);
+
+      half += 0.5 * dbeta * (_ncm_fit_esmcmc_pt_mean_lnL (pt, i) + _ncm_fit_esmcmc_pt_mean_lnL (pt, prev));
+      prev  = i;
+    }
+
+    if (prev != 0)
+    {
+      const gdouble dbeta = g_array_index (pt->beta, gdouble, 0) - g_array_index (pt->beta, gdouble, prev);
+
+      half += 0.5 * dbeta * (_ncm_fit_esmcmc_pt_mean_lnL (pt, 0) + _ncm_fit_esmcmc_pt_mean_lnL (pt, prev));
+    }
+  }
+
+  lnZ[0]     = full;
+  lnZ_err[0] = fabs (full - half);
+}
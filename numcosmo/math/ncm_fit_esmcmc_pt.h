@@ -0,0 +1,102 @@
+/***************************************************************************
+ *            ncm_fit_esmcmc_pt.h
+ *
+ *  Sun October 18 14:21:37 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_fit_esmcmc_pt.h
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _NCM_FIT_ESMCMC_PT_H_
+#define _NCM_FIT_ESMCMC_PT_H_
+
+#include <glib.h>
+#include <glib-object.h>
+#include <numcosmo/build_cfg.h>
+#include <numcosmo/math/ncm_fit_esmcmc.h>
+#include <numcosmo/math/ncm_rng.h>
+
+G_BEGIN_DECLS
+
+#define NCM_TYPE_FIT_ESMCMC_PT             (ncm_fit_esmcmc_pt_get_type ())
+#define NCM_FIT_ESMCMC_PT(obj)             (G_TYPE_CHECK_INSTANCE_CAST ((obj), NCM_TYPE_FIT_ESMCMC_PT, NcmFitESMCMCPT))
+#define NCM_FIT_ESMCMC_PT_CLASS(klass)     (G_TYPE_CHECK_CLASS_CAST ((klass), NCM_TYPE_FIT_ESMCMC_PT, NcmFitESMCMCPTClass))
+#define NCM_IS_FIT_ESMCMC_PT(obj)          (G_TYPE_CHECK_INSTANCE_TYPE ((obj), NCM_TYPE_FIT_ESMCMC_PT))
+#define NCM_IS_FIT_ESMCMC_PT_CLASS(klass)  (G_TYPE_CHECK_CLASS_TYPE ((klass), NCM_TYPE_FIT_ESMCMC_PT))
+#define NCM_FIT_ESMCMC_PT_GET_CLASS(obj)   (G_TYPE_INSTANCE_GET_CLASS ((obj), NCM_TYPE_FIT_ESMCMC_PT, NcmFitESMCMCPTClass))
+
+typedef struct _NcmFitESMCMCPTClass NcmFitESMCMCPTClass;
+typedef struct _NcmFitESMCMCPT NcmFitESMCMCPT;
+
+struct _NcmFitESMCMCPTClass
+{
+  /*< private >*/
+  GObjectClass parent_class;
+};
+
+struct _NcmFitESMCMCPT
+{
+  /*< private >*/
+  GObject parent_instance;
+  NcmFitESMCMC *esmcmc;
+  GPtrArray *levels;
+  guint ntemps;
+  gdouble tmax;
+  gboolean adapt;
+  gdouble adapt_lag;
+  gdouble adapt_time;
+  guint nadapt;
+  GArray *beta;
+  GArray *swap_try;
+  GArray *swap_acc;
+  GArray *step_acc;
+  GArray *m2lnL_sum;
+  GArray *m2lnL_count;
+  GArray *perm;
+  gboolean started;
+};
+
+GType ncm_fit_esmcmc_pt_get_type (void) G_GNUC_CONST;
+
+NcmFitESMCMCPT *ncm_fit_esmcmc_pt_new (NcmFitESMCMC *esmcmc, guint ntemps, gdouble tmax);
+NcmFitESMCMCPT *ncm_fit_esmcmc_pt_ref (NcmFitESMCMCPT *pt);
+void ncm_fit_esmcmc_pt_free (NcmFitESMCMCPT *pt);
+void ncm_fit_esmcmc_pt_clear (NcmFitESMCMCPT **pt);
+
+void ncm_fit_esmcmc_pt_set_data_file (NcmFitESMCMCPT *pt, const gchar *filename);
+void ncm_fit_esmcmc_pt_set_adapt (NcmFitESMCMCPT *pt, gboolean adapt);
+void ncm_fit_esmcmc_pt_set_adapt_lag (NcmFitESMCMCPT *pt, gdouble lag);
+void ncm_fit_esmcmc_pt_set_adapt_time (NcmFitESMCMCPT *pt, gdouble time);
+
+gboolean ncm_fit_esmcmc_pt_get_adapt (NcmFitESMCMCPT *pt);
+guint ncm_fit_esmcmc_pt_get_ntemps (NcmFitESMCMCPT *pt);
+gdouble ncm_fit_esmcmc_pt_get_beta (NcmFitESMCMCPT *pt, guint i);
+gdouble ncm_fit_esmcmc_pt_get_swap_accept_ratio (NcmFitESMCMCPT *pt, guint i);
+NcmFitESMCMC *ncm_fit_esmcmc_pt_peek_level (NcmFitESMCMCPT *pt, guint i);
+
+void ncm_fit_esmcmc_pt_start_run (NcmFitESMCMCPT *pt);
+void ncm_fit_esmcmc_pt_end_run (NcmFitESMCMCPT *pt);
+void ncm_fit_esmcmc_pt_run (NcmFitESMCMCPT *pt, guint n);
+
+void ncm_fit_esmcmc_pt_reset_evidence (NcmFitESMCMCPT *pt);
+void ncm_fit_esmcmc_pt_evidence (NcmFitESMCMCPT *pt, gdouble *lnZ, gdouble *lnZ_err);
+
+G_END_DECLS
+
+#endif /* _NCM_FIT_ESMCMC_PT_H_ */
@@ -39,6 +39,7 @@
 
 #include "math/ncm_fit_mc.h"
 #include "math/ncm_cfg.h"
+#include "math/ncm_profiler.h"
 #include "math/ncm_func_eval.h"
 #include "ncm_enum_types.h"
 
@@ -363,6 +364,42 @@ _ncm_fit_mc_resample (NcmFitMC *mc, NcmFit *fit)
   return mc->cur_sample_id;
 }
 
+/*
+ * When the catalog RNG supports substreams each realization is resampled
+ * using its own substream labeled by the realization index. The resampling
+ * is done in the worker NcmMSet (set to the fiducial parameters) so it 
+ * can run without holding the resample lock and the results do not 
+ * depend on the number of threads.
+ */
+static void
+_ncm_fit_mc_resample_substream (NcmFitMC *mc, NcmFit *fit, NcmRNG *sub, NcmVector *fiduc_params, gint sample_index)
+{
+  ncm_mset_param_set_vector (fit->mset, fiduc_params);
+  ncm_rng_substream_set (mc->mcat->rng, sub, sample_index);
+
+  mc->resample (fit->lh->dset, fit->mset, sub);
+
+  ncm_mset_param_set_vector (fit->mset, mc->bf);
+}
+
+static gint
+_ncm_fit_mc_resample_mt (NcmFitMC *mc, NcmFit *fit, NcmRNG *sub, NcmVector *fiduc_params)
+{
+  gint sample_index;
+
+  g_mutex_lock (&mc->resample_lock);
+  if (sub == NULL)
+    sample_index = _ncm_fit_mc_resample (mc, fit);
+  else
+    sample_index = ++mc->cur_sample_id;
+  g_mutex_unlock (&mc->resample_lock);
+
+  if (sub != NULL)
+    _ncm_fit_mc_resample_substream (mc, fit, sub, fiduc_params, sample_index);
+
+  return sample_index;
+}
+
 /**
  * ncm_fit_mc_set_rtype:
  * @mc: a #NcmFitMC
@@ -745,22 +782,38 @@ ncm_fit_mc_run (NcmFitMC *mc, guint n)
     _ncm_fit_mc_run_mt (mc);
 
   ncm_timer_task_pause (mc->nt);
+  ncm_profiler_report_if_enabled ();
 }
 
 static void 
 _ncm_fit_mc_run_single (NcmFitMC *mc)
 {
+  NcmRNG *sub             = NULL;
+  NcmVector *fiduc_params = NULL;
   guint i;
 
+  if (ncm_rng_has_substreams (mc->mcat->rng))
+  {
+    sub          = ncm_rng_substream_new (mc->mcat->rng, 0);
+    fiduc_params = ncm_vector_new (ncm_mset_total_len (mc->fiduc));
+    ncm_mset_param_get_vector (mc->fiduc, fiduc_params);
+  }
+
   for (i = 0; i < mc->n; i++)
   {
     ncm_mset_param_set_vector (mc->fit->mset, mc->bf);
-    _ncm_fit_mc_resample (mc, mc->fit);
+    if (sub == NULL)
+      _ncm_fit_mc_resample (mc, mc->fit);
+    else
+      _ncm_fit_mc_resample_substream (mc, mc->fit, sub, fiduc_params, ++mc->cur_sample_id);
     ncm_fit_run (mc->fit, NCM_FIT_RUN_MSGS_NONE);
 
     _ncm_fit_mc_update (mc, mc->fit);
     mc->write_index++;
   }
+
+  ncm_rng_clear (&sub);
+  ncm_vector_clear (&fiduc_params);
 }
 
 static gpointer
@@ -776,23 +829,41 @@ _ncm_fit_mc_dup_fit (gpointer userdata)
   }
 }
 
+static void
+_ncm_fit_mc_mt_substream_new (NcmFitMC *mc, NcmRNG **sub, NcmVector **fiduc_params)
+{
+  if (ncm_rng_has_substreams (mc->mcat->rng))
+  {
+    *sub          = ncm_rng_substream_new (mc->mcat->rng, 0);
+    *fiduc_params = ncm_vector_new (ncm_mset_total_len (mc->fiduc));
+    ncm_mset_param_get_vector (mc->fiduc, *fiduc_params);
+  }
+  else
+  {
+    *sub          = NULL;
+    *fiduc_params = NULL;
+  }
+}
+
 static void 
 _ncm_fit_mc_mt_eval_keep_order (glong i, glong f, gpointer data)
 {
   NcmFitMC *mc = NCM_FIT_MC (data);
   NcmFit **fit_ptr = ncm_memory_pool_get (mc->mp);
   NcmFit *fit = *fit_ptr;
+  NcmRNG *sub;
+  NcmVector *fiduc_params;
   guint j;
 
+  _ncm_fit_mc_mt_substream_new (mc, &sub, &fiduc_params);
+
   for (j = i; j < f; j++)
   {
     gint sample_index;
 
     ncm_mset_param_set_vector (fit->mset, mc->bf);
 
-    g_mutex_lock (&mc->resample_lock);
-    sample_index = _ncm_fit_mc_resample (mc, fit);
-    g_mutex_unlock (&mc->resample_lock);
+    sample_index = _ncm_fit_mc_resample_mt (mc, fit, sub, fiduc_params);
 
     ncm_fit_run (fit, NCM_FIT_RUN_MSGS_NONE);
 
@@ -807,6 +878,8 @@ _ncm_fit_mc_mt_eval_keep_order (glong i, glong f, gpointer data)
     g_mutex_unlock (&mc->update_lock);    
   }
 
+  ncm_rng_clear (&sub);
+  ncm_vector_clear (&fiduc_params);
   ncm_memory_pool_return (fit_ptr);
 }
 
@@ -818,15 +891,17 @@ _ncm_fit_mc_mt_eval (glong i, glong f, gpointer data)
   NcmFitMC *mc = NCM_FIT_MC (data);
   NcmFit **fit_ptr = ncm_memory_pool_get (mc->mp);
   NcmFit *fit = *fit_ptr;
+  NcmRNG *sub;
+  NcmVector *fiduc_params;
   guint j;
 
+  _ncm_fit_mc_mt_substream_new (mc, &sub, &fiduc_params);
+
   for (j = i; j < f; j++)
   {
     ncm_mset_param_set_vector (fit->mset, mc->bf);
 
-    g_mutex_lock (&mc->resample_lock);
-    _ncm_fit_mc_resample (mc, fit);
-    g_mutex_unlock (&mc->resample_lock);
+    _ncm_fit_mc_resample_mt (mc, fit, sub, fiduc_params);
 
     ncm_fit_run (fit, NCM_FIT_RUN_MSGS_NONE);
 
@@ -836,6 +911,8 @@ _ncm_fit_mc_mt_eval (glong i, glong f, gpointer data)
     G_UNLOCK (update_lock);
   }
 
+  ncm_rng_clear (&sub);
+  ncm_vector_clear (&fiduc_params);
   ncm_memory_pool_return (fit_ptr);
 }
 
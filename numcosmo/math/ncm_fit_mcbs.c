@@ -30,6 +30,21 @@
  *
  * FIXME
  * 
+ * When the number of threads is larger than one, see ncm_fit_mcbs_set_nthreads(),
+ * the Monte Carlo realizations are distributed among the threads. Each thread
+ * owns a copy of the #NcmFit, generates its realization and then runs the whole
+ * bootstrap series on the same copy. Since the bootstrap only changes the
+ * resampled index set, the prepared data, e.g., the Cholesky decomposition of
+ * the covariance in #NcmDataGaussCov, is reused by all bootstrap fits of a
+ * realization. When the realizations run serially, the bootstrap series of
+ * each realization is distributed among the bsmt threads of
+ * ncm_fit_mcbs_run() instead, each one regenerating the realization in its
+ * own copy. Each realization uses its own random number generator (a
+ * substream of the catalog #NcmRNG when it supports them, see
+ * ncm_rng_substream_new(), or a seed drawn from it before the run), and 
+ * each bootstrap a seed drawn from it, thus the results do not depend on
+ * the number of threads of either level.
+ * 
  */
 
 #ifdef HAVE_CONFIG_H
@@ -39,6 +54,8 @@
 
 #include "math/ncm_fit_mcbs.h"
 #include "math/ncm_cfg.h"
+#include "math/ncm_profiler.h"
+#include "math/ncm_func_eval.h"
 
 #include <gio/gio.h>
 
@@ -47,6 +64,7 @@ enum
   PROP_0,
   PROP_FIT,
   PROP_FILE,
+  PROP_NTHREADS,
 };
 
 G_DEFINE_TYPE (NcmFitMCBS, ncm_fit_mcbs, G_TYPE_OBJECT);
@@ -56,9 +74,14 @@ ncm_fit_mcbs_init (NcmFitMCBS *mcbs)
 {
   mcbs->fit = NULL;
   mcbs->mc_resample = NULL;
-  mcbs->mc_bstrap = NULL;
   mcbs->mcat = NULL;
   mcbs->base_name = NULL;
+  mcbs->nthreads = 0;
+  mcbs->ser = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+  mcbs->mp = NULL;
+  g_mutex_init (&mcbs->dup_fit);
+  g_mutex_init (&mcbs->update_lock);
+  g_cond_init (&mcbs->write_cond);
 }
 
 static void
@@ -72,7 +95,6 @@ ncm_fit_mcbs_set_property (GObject *object, guint prop_id, const GValue *value,
     case PROP_FIT:
       mcbs->fit = g_value_dup_object (value);
       mcbs->mc_resample = ncm_fit_mc_new (mcbs->fit, NCM_FIT_MC_RESAMPLE_FROM_MODEL, NCM_FIT_RUN_MSGS_NONE);
-      mcbs->mc_bstrap = ncm_fit_mc_new (mcbs->fit, NCM_FIT_MC_RESAMPLE_BOOTSTRAP_NOMIX, NCM_FIT_RUN_MSGS_NONE);
       mcbs->mcat = ncm_mset_catalog_new (mcbs->fit->mset, 1, 1, FALSE, 
                                          NCM_MSET_CATALOG_M2LNL_COLNAME, NCM_MSET_CATALOG_M2LNL_SYMBOL, 
                                          NULL);
@@ -81,6 +103,9 @@ ncm_fit_mcbs_set_property (GObject *object, guint prop_id, const GValue *value,
     case PROP_FILE:
       ncm_fit_mcbs_set_filename (mcbs, g_value_get_string (value));
       break;
+    case PROP_NTHREADS:
+      ncm_fit_mcbs_set_nthreads (mcbs, g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -101,6 +126,9 @@ ncm_fit_mcbs_get_property (GObject *object, guint prop_id, GValue *value, GParam
     case PROP_FILE:
       g_value_set_string (value, mcbs->mcat->file);
       break;
+    case PROP_NTHREADS:
+      g_value_set_uint (value, mcbs->nthreads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -115,9 +143,15 @@ _ncm_fit_mcbs_dispose (GObject *object)
   ncm_fit_clear (&mcbs->fit);
 
   ncm_fit_mc_clear (&mcbs->mc_resample);
-  ncm_fit_mc_clear (&mcbs->mc_bstrap);
 
   ncm_mset_catalog_clear (&mcbs->mcat);
+  ncm_serialize_clear (&mcbs->ser);
+
+  if (mcbs->mp != NULL)
+  {
+    ncm_memory_pool_free (mcbs->mp, TRUE);
+    mcbs->mp = NULL;
+  }
 
   /* Chain up : end */
   G_OBJECT_CLASS (ncm_fit_mcbs_parent_class)->dispose (object);
@@ -129,6 +163,10 @@ _ncm_fit_mcbs_finalize (GObject *object)
   NcmFitMCBS *mcbs = NCM_FIT_MCBS (object);
   
   g_clear_pointer (&mcbs->base_name, g_free);
+
+  g_mutex_clear (&mcbs->dup_fit);
+  g_mutex_clear (&mcbs->update_lock);
+  g_cond_clear (&mcbs->write_cond);
   
   /* Chain up : end */
   G_OBJECT_CLASS (ncm_fit_mcbs_parent_class)->finalize (object);
@@ -159,6 +197,14 @@ ncm_fit_mcbs_class_init (NcmFitMCBSClass *klass)
                                                         "Data filename",
                                                         NULL,
                                                         G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+
+  g_object_class_install_property (object_class,
+                                   PROP_NTHREADS,
+                                   g_param_spec_uint ("nthreads",
+                                                      NULL,
+                                                      "Number of threads used to run the realizations",
+                                                      0, G_MAXUINT, 0,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
 }
 
 /**
@@ -258,12 +304,266 @@ ncm_fit_mcbs_set_filename (NcmFitMCBS *mcbs, const gchar *filename)
 void
 ncm_fit_mcbs_set_rng (NcmFitMCBS *mcbs, NcmRNG *rng)
 {
-  if (mcbs->mc_bstrap->started)
+  if (mcbs->mc_resample->started)
     g_error ("ncm_fit_mcbs_set_rng: Cannot change the RNG object during a run.");
 
   ncm_mset_catalog_set_rng (mcbs->mcat, rng);
 }
 
+/**
+ * ncm_fit_mcbs_set_nthreads:
+ * @mcbs: a #NcmFitMCBS
+ * @nthreads: number of threads
+ *
+ * Sets the number of threads used to run the Monte Carlo realizations
+ * in ncm_fit_mcbs_run(), each thread runs a full realization including
+ * its bootstrap series. When @nthreads is at most one the realizations
+ * run serially and the bootstraps of each one are distributed among the
+ * bsmt threads of ncm_fit_mcbs_run().
+ *
+ */
+void
+ncm_fit_mcbs_set_nthreads (NcmFitMCBS *mcbs, guint nthreads)
+{
+  mcbs->nthreads = nthreads;
+}
+
+typedef struct _NcmFitMCBSRun
+{
+  NcmFitMCBS *mcbs;
+  NcmRNG *rng;
+  NcmVector *fiduc_params;
+  NcmVector *bf;
+  gulong *seeds;
+  guint ni;
+  guint nbstraps;
+  guint bsmt;
+  NcmDatasetBStrapType bstype;
+  NcmFitRunMsgs mtype;
+} NcmFitMCBSRun;
+
+typedef struct _NcmFitMCBSBStrap
+{
+  NcmFitMCBSRun *run;
+  glong l;
+  NcmVector *rbf;
+  gulong *bseeds;
+  NcmMatrix *res;
+} NcmFitMCBSBStrap;
+
+static gpointer
+_ncm_fit_mcbs_dup_fit (gpointer userdata)
+{
+  NcmFitMCBS *mcbs = NCM_FIT_MCBS (userdata);
+  g_mutex_lock (&mcbs->dup_fit);
+  {
+    NcmFit *fit = ncm_fit_dup (mcbs->fit, mcbs->ser);
+    ncm_serialize_reset (mcbs->ser, TRUE);
+    g_mutex_unlock (&mcbs->dup_fit);
+    return fit;
+  }
+}
+
+static NcmRNG *
+_ncm_fit_mcbs_rng_new (NcmFitMCBSRun *run)
+{
+  NcmRNG *rng;
+
+  g_mutex_lock (&run->mcbs->dup_fit);
+  if (run->seeds == NULL)
+    rng = ncm_rng_substream_new (run->rng, 0);
+  else
+    rng = ncm_rng_new (ncm_rng_get_algo (run->rng));
+  g_mutex_unlock (&run->mcbs->dup_fit);
+
+  return rng;
+}
+
+/*
+ * Generates the realization l in @fit. The realization l draws from its own
+ * generator, the substream l of the catalog RNG when available or a 
+ * generator seeded with the l-th seed drawn up front otherwise, hence, it
+ * can be regenerated in any fit copy.
+ */
+static void
+_ncm_fit_mcbs_resample (NcmFitMCBSRun *run, NcmFit *fit, NcmRNG *rng, glong l)
+{
+  if (run->seeds == NULL)
+    ncm_rng_substream_set (run->rng, rng, l);
+  else
+    gsl_rng_set (rng->r, run->seeds[l - run->ni]);
+
+  ncm_dataset_bootstrap_set (fit->lh->dset, NCM_DATASET_BSTRAP_DISABLE);
+  ncm_mset_param_set_vector (fit->mset, run->fiduc_params);
+  ncm_dataset_resample (fit->lh->dset, fit->mset, rng);
+}
+
+/*
+ * Runs the bootstraps [i, f) of a realization already generated in @fit.
+ * The bootstrap b uses a generator seeded with the b-th seed drawn from the
+ * realization generator, the results are written in the row b of bs->res.
+ */
+static void
+_ncm_fit_mcbs_bstrap_eval (NcmFitMCBSBStrap *bs, NcmFit *fit, NcmRNG *brng, glong i, glong f)
+{
+  glong b;
+
+  ncm_dataset_bootstrap_set (fit->lh->dset, bs->run->bstype);
+  for (b = i; b < f; b++)
+  {
+    NcmVector *row_b = ncm_matrix_get_row (bs->res, b);
+    NcmVector *p_b   = ncm_vector_get_subvector (row_b, 1, ncm_vector_len (row_b) - 1);
+
+    gsl_rng_set (brng->r, bs->bseeds[b]);
+    ncm_dataset_bootstrap_resample (fit->lh->dset, brng);
+    ncm_mset_param_set_vector (fit->mset, bs->rbf);
+    ncm_fit_run (fit, NCM_FIT_RUN_MSGS_NONE);
+
+    ncm_vector_set (row_b, 0, ncm_fit_state_get_m2lnL_curval (fit->fstate));
+    ncm_mset_param_get_vector (fit->mset, p_b);
+
+    ncm_vector_free (p_b);
+    ncm_vector_free (row_b);
+  }
+}
+
+static void
+_ncm_fit_mcbs_bstrap_mt_eval (glong i, glong f, gpointer data)
+{
+  NcmFitMCBSBStrap *bs = (NcmFitMCBSBStrap *) data;
+  NcmFit **fit_ptr     = ncm_memory_pool_get (bs->run->mcbs->mp);
+  NcmRNG *rng          = _ncm_fit_mcbs_rng_new (bs->run);
+  NcmRNG *brng         = _ncm_fit_mcbs_rng_new (bs->run);
+
+  /* The copy regenerates the same realization instead of serializing the data. */
+  _ncm_fit_mcbs_resample (bs->run, *fit_ptr, rng, bs->l);
+  _ncm_fit_mcbs_bstrap_eval (bs, *fit_ptr, brng, i, f);
+
+  ncm_rng_free (rng);
+  ncm_rng_free (brng);
+  ncm_memory_pool_return (fit_ptr);
+}
+
+/*
+ * Runs the realizations [i, f) using @fit. The serial and threaded runs
+ * share this function, hence the results do not depend on the number of
+ * threads of either level. The bootstraps of each realization are split
+ * among run->bsmt threads only when the realizations themselves run 
+ * serially, nesting both levels in the shared thread pool could deadlock.
+ */
+static void
+_ncm_fit_mcbs_eval (NcmFitMCBSRun *run, NcmFit *fit, glong i, glong f, gboolean bstrap_mt)
+{
+  NcmFitMCBS *mcbs = run->mcbs;
+  NcmFitMC *mc     = mcbs->mc_resample;
+  NcmRNG *rng      = _ncm_fit_mcbs_rng_new (run);
+  NcmRNG *brng     = _ncm_fit_mcbs_rng_new (run);
+  const guint bsmt = (bstrap_mt && (run->nbstraps > 1)) ? GSL_MIN (run->bsmt, run->nbstraps - 1) : 0;
+  NcmFitMCBSBStrap bs;
+  glong l;
+
+  bs.run    = run;
+  bs.bseeds = g_new (gulong, run->nbstraps);
+  bs.res    = ncm_matrix_new (GSL_MAX (run->nbstraps, 1), ncm_mset_total_len (fit->mset) + 1);
+  bs.rbf    = ncm_vector_new (ncm_mset_total_len (fit->mset));
+
+  for (l = i; l < f; l++)
+  {
+    NcmMSetCatalog *bs_mcat;
+    gdouble m2lnL;
+    guint b;
+
+    /* Generating the realization l and fitting it. */
+    _ncm_fit_mcbs_resample (run, fit, rng, l);
+
+    ncm_mset_param_set_vector (fit->mset, run->bf);
+    ncm_fit_run (fit, NCM_FIT_RUN_MSGS_NONE);
+
+    m2lnL = ncm_fit_state_get_m2lnL_curval (fit->fstate);
+    ncm_mset_param_get_vector (fit->mset, bs.rbf);
+
+    for (b = 0; b < run->nbstraps; b++)
+      bs.bseeds[b] = gsl_rng_get (rng->r);
+
+    /* 
+     * Bootstrap series: only the resampled index set changes, the data 
+     * prepared above are reused by all fits.
+     */
+    bs.l = l;
+    if (bsmt > 1)
+      ncm_func_eval_threaded_loop_nw (&_ncm_fit_mcbs_bstrap_mt_eval, 0, run->nbstraps, &bs, bsmt);
+    else if (run->nbstraps > 0)
+      _ncm_fit_mcbs_bstrap_eval (&bs, fit, brng, 0, run->nbstraps);
+
+    g_mutex_lock (&mcbs->dup_fit);
+    bs_mcat = ncm_mset_catalog_new (fit->mset, 1, 1, FALSE, 
+                                    NCM_MSET_CATALOG_M2LNL_COLNAME, NCM_MSET_CATALOG_M2LNL_SYMBOL, 
+                                    NULL);
+    ncm_mset_catalog_set_run_type (bs_mcat, NCM_MSET_CATALOG_RTYPE_BSTRAP_MEAN);
+    if (mcbs->base_name != NULL)
+    {
+      gchar *bstrap_str = g_strdup_printf ("%s-bstrap-%06ld.fits", mcbs->base_name, l);
+      ncm_mset_catalog_set_file (bs_mcat, bstrap_str);
+      g_free (bstrap_str);
+    }
+    g_mutex_unlock (&mcbs->dup_fit);
+
+    for (b = 0; b < run->nbstraps; b++)
+    {
+      NcmVector *row_b = ncm_matrix_get_row (bs.res, b);
+      NcmVector *p_b   = ncm_vector_get_subvector (row_b, 1, ncm_vector_len (row_b) - 1);
+
+      ncm_mset_param_set_vector (fit->mset, p_b);
+      ncm_mset_catalog_add_from_mset (bs_mcat, fit->mset, ncm_vector_get (row_b, 0), NULL);
+
+      ncm_vector_free (p_b);
+      ncm_vector_free (row_b);
+    }
+    ncm_mset_catalog_sync (bs_mcat, TRUE);
+
+    /* 
+     * The results are added to the catalogs in the realizations order,
+     * the resample catalog bookkeeping follows ncm_fit_mc_run().
+     */
+    g_mutex_lock (&mcbs->update_lock);
+    while (mc->write_index != l)
+      g_cond_wait (&mcbs->write_cond, &mcbs->update_lock);
+
+    ncm_mset_param_set_vector (fit->mset, bs.rbf);
+    ncm_mset_catalog_add_from_mset (mc->mcat, fit->mset, m2lnL, NULL);
+    mc->cur_sample_id = l;
+    mc->write_index++;
+
+    ncm_mset_catalog_add_from_vector (mcbs->mcat, bs_mcat->pstats->mean);
+    if (run->mtype > NCM_FIT_RUN_MSGS_NONE)
+      ncm_mset_catalog_log_current_stats (mcbs->mcat);
+
+    g_cond_broadcast (&mcbs->write_cond);
+    g_mutex_unlock (&mcbs->update_lock);
+
+    g_mutex_lock (&mcbs->dup_fit);
+    ncm_mset_catalog_clear (&bs_mcat);
+    g_mutex_unlock (&mcbs->dup_fit);
+  }
+
+  g_free (bs.bseeds);
+  ncm_matrix_free (bs.res);
+  ncm_vector_free (bs.rbf);
+  ncm_rng_free (rng);
+  ncm_rng_free (brng);
+}
+
+static void
+_ncm_fit_mcbs_mt_eval (glong i, glong f, gpointer data)
+{
+  NcmFitMCBSRun *run = (NcmFitMCBSRun *) data;
+  NcmFit **fit_ptr   = ncm_memory_pool_get (run->mcbs->mp);
+
+  _ncm_fit_mcbs_eval (run, *fit_ptr, i, f, FALSE);
+
+  ncm_memory_pool_return (fit_ptr);
+}
+
 /**
  * ncm_fit_mcbs_run:
  * @mcbs: a #NcmFitMCBS
@@ -273,75 +573,119 @@ ncm_fit_mcbs_set_rng (NcmFitMCBS *mcbs, NcmRNG *rng)
  * @nbstraps: FIXME
  * @rtype: FIXME
  * @mtype: FIXME
- * @bsmt: FIXME
+ * @bsmt: number of threads used to run the bootstraps of each realization
  * 
  * FIXME
  * 
- * WARNING not working correctly with bsmt > 0 FIXME
+ * The realizations are run in parallel when the number of threads,
+ * see ncm_fit_mcbs_set_nthreads(), is larger than one. Otherwise, the
+ * bootstraps of each realization are distributed among @bsmt threads.
+ * The results do not depend on the number of threads.
  *
  */
 void 
 ncm_fit_mcbs_run (NcmFitMCBS *mcbs, NcmMSet *fiduc, guint ni, guint nf, guint nbstraps, NcmFitMCResampleType rtype, NcmFitRunMsgs mtype, guint bsmt)
 {
-  guint i;
-  gboolean cat_has_rng = FALSE;
+  NcmFitMC *mc           = mcbs->mc_resample;
+  const guint nthreads   = mcbs->nthreads;
+  const guint fparam_len = ncm_mset_total_len (mcbs->fit->mset);
+  gboolean cat_has_rng   = FALSE;
+  NcmFitMCBSRun run;
 
-  ncm_fit_mc_set_rtype (mcbs->mc_resample, NCM_FIT_MC_RESAMPLE_FROM_MODEL);
-  ncm_fit_mc_set_mtype (mcbs->mc_resample, NCM_FIT_RUN_MSGS_SIMPLE);
-  ncm_fit_mc_set_fiducial (mcbs->mc_resample, fiduc);
+  if (rtype == NCM_FIT_MC_RESAMPLE_FROM_MODEL)
+    g_error ("ncm_fit_mcbs_run: the internal run must be a bootstrap: NCM_FIT_MC_RESAMPLE_BOOTSTRAP_*.");
+
+  ncm_fit_mc_set_rtype (mc, NCM_FIT_MC_RESAMPLE_FROM_MODEL);
+  ncm_fit_mc_set_mtype (mc, NCM_FIT_RUN_MSGS_SIMPLE);
+  ncm_fit_mc_set_fiducial (mc, fiduc);
 
   if (mcbs->mcat->rng != NULL)
   {
     NcmRNG *rng = ncm_rng_seeded_new (ncm_rng_get_algo (mcbs->mcat->rng), ncm_rng_get_seed (mcbs->mcat->rng));
-    ncm_fit_mc_set_rng (mcbs->mc_resample, rng);
+    ncm_fit_mc_set_rng (mc, rng);
     ncm_rng_free (rng);
     cat_has_rng = TRUE;
   }
 
-  ncm_fit_mc_start_run (mcbs->mc_resample);
+  ncm_fit_mc_start_run (mc);
 
   if (!cat_has_rng)
-    ncm_mset_catalog_set_rng (mcbs->mcat, mcbs->mc_resample->mcat->rng);
+    ncm_mset_catalog_set_rng (mcbs->mcat, mc->mcat->rng);
   
   if (ni > 0)
-    ncm_fit_mc_set_first_sample_id (mcbs->mc_resample, ni);
+    ncm_fit_mc_set_first_sample_id (mc, ni);
+
+  if (mc->write_index != (gint) ni)
+    g_error ("ncm_fit_mcbs_run: the resample catalog already contains the realizations up to %d, cannot start at %u.",
+             mc->cur_sample_id, ni);
+
+  run.mcbs         = mcbs;
+  run.rng          = mc->mcat->rng;
+  run.fiduc_params = ncm_vector_new (fparam_len);
+  run.bf           = ncm_vector_ref (mc->bf);
+  run.seeds        = NULL;
+  run.ni           = ni;
+  run.nbstraps     = nbstraps;
+  run.bsmt         = bsmt;
+  run.bstype       = (rtype == NCM_FIT_MC_RESAMPLE_BOOTSTRAP_NOMIX) ? NCM_DATASET_BSTRAP_PARTIAL : NCM_DATASET_BSTRAP_TOTAL;
+  run.mtype        = mtype;
+
+  ncm_mset_param_get_vector (mc->fiduc, run.fiduc_params);
+
+  if ((nf > ni) && !ncm_rng_has_substreams (run.rng))
+  {
+    guint i;
 
-  ncm_fit_mc_set_rtype (mcbs->mc_bstrap, rtype);
-  ncm_fit_mc_set_mtype (mcbs->mc_bstrap, mtype);
-  ncm_fit_mc_set_nthreads (mcbs->mc_bstrap, bsmt);
-  
-  if (rtype == NCM_FIT_MC_RESAMPLE_FROM_MODEL)
-    g_error ("ncm_fit_mcbs_run: the internal run must be a bootstrap: NCM_FIT_MC_RESAMPLE_BOOTSTRAP_*.");
-  
-  for (i = ni; i < nf; i++)
+    run.seeds = g_new (gulong, nf - ni);
+    ncm_rng_lock (run.rng);
+    for (i = 0; i < nf - ni; i++)
+      run.seeds[i] = gsl_rng_get (run.rng->r);
+    ncm_rng_unlock (run.rng);
+  }
+
+  if ((nthreads > 1) && (nf > ni + 1))
   {
-    ncm_dataset_bootstrap_set (mcbs->fit->lh->dset, NCM_DATASET_BSTRAP_DISABLE);
-    //ncm_fit_mc_set_first_sample_id (mcbs->mc_resample, i + 1);
-    ncm_fit_mc_run (mcbs->mc_resample, i + 1);
-    ncm_dataset_bootstrap_set (mcbs->fit->lh->dset, NCM_DATASET_BSTRAP_TOTAL); /* FIXME */
-    
-    if (mcbs->base_name != NULL)
-    {
-      gchar *bstrap_str = g_strdup_printf ("%s-bstrap-%06d.fits", mcbs->base_name, i);
-      ncm_fit_mc_set_data_file (mcbs->mc_bstrap, bstrap_str);
-      g_free (bstrap_str);
-    }
+    if (mcbs->mp != NULL)
+      ncm_memory_pool_free (mcbs->mp, TRUE);
+    mcbs->mp = ncm_memory_pool_new (&_ncm_fit_mcbs_dup_fit, mcbs, 
+                                    (GDestroyNotify) &ncm_fit_free);
+
+    ncm_func_eval_threaded_loop_full (&_ncm_fit_mcbs_mt_eval, ni, nf, &run);
 
-    ncm_fit_mc_start_run (mcbs->mc_bstrap);
-    ncm_fit_mc_run (mcbs->mc_bstrap, nbstraps);
+    ncm_memory_pool_free (mcbs->mp, TRUE);
+    mcbs->mp = NULL;
+  }
+  else if ((bsmt > 1) && (nbstraps > 2) && (nf > ni))
+  {
+    if (mcbs->mp != NULL)
+      ncm_memory_pool_free (mcbs->mp, TRUE);
+    mcbs->mp = ncm_memory_pool_new (&_ncm_fit_mcbs_dup_fit, mcbs, 
+                                    (GDestroyNotify) &ncm_fit_free);
 
-    ncm_mset_catalog_add_from_vector (mcbs->mcat, mcbs->mc_bstrap->mcat->pstats->mean);
-    ncm_mset_catalog_log_current_stats (mcbs->mcat);
+    _ncm_fit_mcbs_eval (&run, mcbs->fit, ni, nf, TRUE);
 
-    ncm_fit_mc_end_run (mcbs->mc_bstrap);
-    ncm_fit_mc_reset (mcbs->mc_bstrap);
+    ncm_memory_pool_free (mcbs->mp, TRUE);
+    mcbs->mp = NULL;
+  }
+  else if (nf > ni)
+  {
+    _ncm_fit_mcbs_eval (&run, mcbs->fit, ni, nf, FALSE);
   }
 
+  ncm_dataset_bootstrap_set (mcbs->fit->lh->dset, NCM_DATASET_BSTRAP_DISABLE);
+  ncm_mset_param_set_vector (mcbs->fit->mset, run.bf);
+
   ncm_mset_catalog_get_mean (mcbs->mcat, &mcbs->fit->fstate->fparams);
   ncm_mset_catalog_get_covar (mcbs->mcat, &mcbs->fit->fstate->covar);
   mcbs->fit->fstate->has_covar = TRUE;
   
-  ncm_fit_mc_end_run (mcbs->mc_resample);  
+  ncm_fit_mc_end_run (mc);
+
+  ncm_vector_free (run.fiduc_params);
+  ncm_vector_free (run.bf);
+  g_clear_pointer (&run.seeds, g_free);
+
+  ncm_profiler_report_if_enabled ();
 }
 
 /**
@@ -31,6 +31,8 @@
 #include <numcosmo/build_cfg.h>
 #include <numcosmo/math/ncm_fit.h>
 #include <numcosmo/math/ncm_fit_mc.h>
+#include <numcosmo/math/ncm_serialize.h>
+#include <numcosmo/math/memory_pool.h>
 
 G_BEGIN_DECLS
 
@@ -56,9 +58,14 @@ struct _NcmFitMCBS
   GObject parent_instance;
   NcmFit *fit;
   NcmFitMC *mc_resample;
-  NcmFitMC *mc_bstrap;
   NcmMSetCatalog *mcat;
   gchar *base_name;
+  guint nthreads;
+  NcmSerialize *ser;
+  NcmMemoryPool *mp;
+  GMutex dup_fit;
+  GMutex update_lock;
+  GCond write_cond;
 };
 
 GType ncm_fit_mcbs_get_type (void) G_GNUC_CONST;
@@ -69,6 +76,7 @@ void ncm_fit_mcbs_clear (NcmFitMCBS **mcbs);
 
 void ncm_fit_mcbs_set_filename (NcmFitMCBS *mcbs, const gchar *filename);
 void ncm_fit_mcbs_set_rng (NcmFitMCBS *mcbs, NcmRNG *rng);
+void ncm_fit_mcbs_set_nthreads (NcmFitMCBS *mcbs, guint nthreads);
 void ncm_fit_mcbs_run (NcmFitMCBS *mcbs, NcmMSet *fiduc, guint ni, guint nf, guint nbstraps, NcmFitMCResampleType rtype, NcmFitRunMsgs mtype, guint bsmt);
 
 NcmMSetCatalog *ncm_fit_mcbs_get_catalog (NcmFitMCBS *mcbs);
@@ -31,6 +31,22 @@
  * FIXME 
  * 
  * Metropolis–Hastings sampler.
+ *
+ * Optionally, a second #NcmFit can be used to screen the proposals
+ * (delayed acceptance, see ncm_fit_mcmc_set_screen_fit()). The screening
+ * fit must have the same free parameters as the main fit and should provide
+ * a cheap approximation of its likelihood, e.g., the same data using a
+ * #NcCBE with a low-fidelity #NcCBEPrecision (see
+ * nc_cbe_precision_new_low_fidelity()). Each proposal $\theta^\star$ is first
+ * accepted with probability
+ * $$\alpha_1 = \min\left[1, \frac{\tilde{L}(\theta^\star)}{\tilde{L}(\theta)}\right],$$
+ * where $\tilde{L}$ is the screening likelihood, and only the proposals
+ * that pass this step are evaluated with the main fit and accepted with
+ * probability
+ * $$\alpha_2 = \min\left[1, \frac{L(\theta^\star)\tilde{L}(\theta)}{L(\theta)\tilde{L}(\theta^\star)}\right].$$
+ * The resulting chain has the same stationary distribution as the
+ * one without screening. The screening fit keeps its own data objects, and
+ * therefore its own cached #NcCBE, independently of the main fit.
  * 
  */
 
@@ -42,6 +58,7 @@
 #include "math/ncm_fit_mcmc.h"
 #include "math/ncm_cfg.h"
 #include "math/ncm_func_eval.h"
+#include "math/ncm_profiler.h"
 #include "ncm_enum_types.h"
 
 #include <gsl/gsl_statistics_double.h>
@@ -54,6 +71,7 @@ enum
   PROP_MTYPE,
   PROP_NTHREADS,
   PROP_DATA_FILE,
+  PROP_SCREEN_FIT,
 };
 
 G_DEFINE_TYPE (NcmFitMCMC, ncm_fit_mcmc, G_TYPE_OBJECT);
@@ -71,6 +89,13 @@ ncm_fit_mcmc_init (NcmFitMCMC *mcmc)
   mcmc->nthreads        = 0;
   mcmc->n               = 0;
   mcmc->mp              = NULL;
+  mcmc->screen          = NULL;
+  mcmc->m2lnL_screen_cur = 0.0;
+  mcmc->nscreened       = 0;
+  mcmc->nscreen_rejected = 0;
+  mcmc->nfull           = 0;
+  mcmc->screen_time     = 0.0;
+  mcmc->full_time       = 0.0;
   mcmc->cur_sample_id   = -1; /* Represents that no samples were calculated yet. */
   mcmc->naccepted       = 0;
   mcmc->ntotal          = 0;
@@ -108,6 +133,9 @@ ncm_fit_mcmc_set_property (GObject *object, guint prop_id, const GValue *value,
     case PROP_DATA_FILE:
       ncm_fit_mcmc_set_data_file (mcmc, g_value_get_string (value));
       break;    
+    case PROP_SCREEN_FIT:
+      ncm_fit_mcmc_set_screen_fit (mcmc, g_value_get_object (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -137,6 +165,9 @@ ncm_fit_mcmc_get_property (GObject *object, guint prop_id, GValue *value, GParam
     case PROP_DATA_FILE:
       g_value_set_string (value, ncm_mset_catalog_peek_filename (mcmc->mcat));
       break;
+    case PROP_SCREEN_FIT:
+      g_value_set_object (value, mcmc->screen);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -149,6 +180,7 @@ ncm_fit_mcmc_dispose (GObject *object)
   NcmFitMCMC *mcmc = NCM_FIT_MCMC (object);
 
   ncm_fit_clear (&mcmc->fit);
+  ncm_fit_clear (&mcmc->screen);
   ncm_mset_trans_kern_clear (&mcmc->tkern);
   ncm_timer_clear (&mcmc->nt);
   ncm_serialize_clear (&mcmc->ser);
@@ -219,6 +251,13 @@ ncm_fit_mcmc_class_init (NcmFitMCMCClass *klass)
                                                       "Number of threads to run",
                                                       0, 100, 0,
                                                       G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_SCREEN_FIT,
+                                   g_param_spec_object ("screen-fit",
+                                                        NULL,
+                                                        "Fit object used to screen the proposals",
+                                                        NCM_TYPE_FIT,
+                                                        G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
 }
 
 static void 
@@ -368,6 +407,51 @@ ncm_fit_mcmc_set_rng (NcmFitMCMC *mcmc, NcmRNG *rng)
   ncm_mset_catalog_set_rng (mcmc->mcat, rng);
 }
 
+/**
+ * ncm_fit_mcmc_set_screen_fit:
+ * @mcmc: a #NcmFitMCMC
+ * @screen: (allow-none): a #NcmFit
+ *
+ * Sets the fit used to screen the proposals before evaluating the
+ * likelihood of the main fit (delayed acceptance). The free parameters
+ * of the model set of @screen must match the ones of the main fit. If
+ * @screen is NULL the screening is disabled. The screening is only
+ * implemented in the serial sampler, when a screening fit is set
+ * ncm_fit_mcmc_run() ignores ncm_fit_mcmc_set_nthreads() and runs
+ * single-threaded.
+ *
+ */
+void
+ncm_fit_mcmc_set_screen_fit (NcmFitMCMC *mcmc, NcmFit *screen)
+{
+  if (mcmc->started)
+    g_error ("ncm_fit_mcmc_set_screen_fit: Cannot change the screening fit during a run, call ncm_fit_mcmc_end_run() first.");
+
+  if (screen != NULL)
+  {
+    if (ncm_mset_fparam_len (screen->mset) != ncm_mset_fparam_len (mcmc->fit->mset))
+      g_error ("ncm_fit_mcmc_set_screen_fit: the screening fit has %u free parameters, expected %u.",
+               ncm_mset_fparam_len (screen->mset), ncm_mset_fparam_len (mcmc->fit->mset));
+
+    ncm_fit_ref (screen);
+  }
+
+  ncm_fit_clear (&mcmc->screen);
+  mcmc->screen = screen;
+}
+
+/**
+ * ncm_fit_mcmc_peek_screen_fit:
+ * @mcmc: a #NcmFitMCMC
+ *
+ * Returns: (transfer none) (allow-none): the screening fit or NULL.
+ */
+NcmFit *
+ncm_fit_mcmc_peek_screen_fit (NcmFitMCMC *mcmc)
+{
+  return mcmc->screen;
+}
+
 /**
  * ncm_fit_mcmc_get_accept_ratio:
  * @mcmc: a #NcmFitMCMC
@@ -382,6 +466,41 @@ ncm_fit_mcmc_get_accept_ratio (NcmFitMCMC *mcmc)
   return mcmc->naccepted * 1.0 / (mcmc->ntotal * 1.0);
 }
 
+/**
+ * ncm_fit_mcmc_get_screen_reject_ratio:
+ * @mcmc: a #NcmFitMCMC
+ *
+ * Gets the fraction of the proposals rejected by the screening fit
+ * in the current run.
+ *
+ * Returns: the screening rejection ratio.
+ */
+gdouble
+ncm_fit_mcmc_get_screen_reject_ratio (NcmFitMCMC *mcmc)
+{
+  return (mcmc->nscreened > 0) ? (mcmc->nscreen_rejected * 1.0 / (mcmc->nscreened * 1.0)) : 0.0;
+}
+
+/**
+ * ncm_fit_mcmc_get_screen_time_saved:
+ * @mcmc: a #NcmFitMCMC
+ *
+ * Estimates the wall-time saved by the screening in the current run, i.e.,
+ * the mean time of the main fit evaluations times the number of proposals
+ * rejected by the screening minus the total time spent in the screening
+ * evaluations. A negative value means the screening is not paying off.
+ *
+ * Returns: the time saved in seconds.
+ */
+gdouble
+ncm_fit_mcmc_get_screen_time_saved (NcmFitMCMC *mcmc)
+{
+  if (mcmc->nfull == 0)
+    return -mcmc->screen_time;
+  else
+    return mcmc->nscreen_rejected * mcmc->full_time / mcmc->nfull - mcmc->screen_time;
+}
+
 void
 _ncm_fit_mcmc_update (NcmFitMCMC *mcmc, NcmFit *fit)
 {
@@ -406,6 +525,9 @@ _ncm_fit_mcmc_update (NcmFitMCMC *mcmc, NcmFit *fit)
         /* guint acc = stepi == 0 ? step : stepi; */
         ncm_mset_catalog_log_current_stats (mcmc->mcat);
         g_message ("# NcmFitMCMC:acceptance ratio %7.4f%%.\n", ncm_fit_mcmc_get_accept_ratio (mcmc) * 100.0);
+        if (mcmc->screen != NULL)
+          g_message ("# NcmFitMCMC:screening rejection ratio %7.4f%%, time saved %.3f s.\n",
+                     ncm_fit_mcmc_get_screen_reject_ratio (mcmc) * 100.0, ncm_fit_mcmc_get_screen_time_saved (mcmc));
 
         /* ncm_timer_task_accumulate (mcmc->nt, acc); */
         ncm_timer_task_log_elapsed (mcmc->nt);
@@ -422,6 +544,9 @@ _ncm_fit_mcmc_update (NcmFitMCMC *mcmc, NcmFit *fit)
       ncm_fit_log_state (fit);
       ncm_mset_catalog_log_current_stats (mcmc->mcat);
       g_message ("# NcmFitMCMC:acceptance ratio %7.4f%%.\n", ncm_fit_mcmc_get_accept_ratio (mcmc) * 100.0);
+      if (mcmc->screen != NULL)
+        g_message ("# NcmFitMCMC:screening rejection ratio %7.4f%%, time saved %.3f s.\n",
+                   ncm_fit_mcmc_get_screen_reject_ratio (mcmc) * 100.0, ncm_fit_mcmc_get_screen_time_saved (mcmc));
       /* ncm_timer_task_increment (mcmc->nt); */
       ncm_timer_task_log_elapsed (mcmc->nt);
       ncm_timer_task_log_mean_time (mcmc->nt);
@@ -488,8 +613,13 @@ ncm_fit_mcmc_start_run (NcmFitMCMC *mcmc)
     mcmc->thetastar = ncm_vector_new (fparam_len);
   }
 
-  mcmc->naccepted = 0;
-  mcmc->ntotal = 0;
+  mcmc->naccepted        = 0;
+  mcmc->ntotal           = 0;
+  mcmc->nscreened        = 0;
+  mcmc->nscreen_rejected = 0;
+  mcmc->nfull            = 0;
+  mcmc->screen_time      = 0.0;
+  mcmc->full_time        = 0.0;
   
   ncm_mset_catalog_set_sync_mode (mcmc->mcat, NCM_MSET_CATALOG_SYNC_TIMED);
   ncm_mset_catalog_set_sync_interval (mcmc->mcat, NCM_FIT_MCMC_MIN_SYNC_INTERVAL);
@@ -520,6 +650,13 @@ ncm_fit_mcmc_start_run (NcmFitMCMC *mcmc)
       ncm_fit_state_set_m2lnL_curval (mcmc->fit->fstate, m2lnL);
     }
   }
+
+  if (mcmc->screen != NULL)
+  {
+    ncm_mset_fparams_get_vector (mcmc->fit->mset, mcmc->theta);
+    ncm_mset_fparams_set_vector (mcmc->screen->mset, mcmc->theta);
+    ncm_fit_m2lnL_val (mcmc->screen, &mcmc->m2lnL_screen_cur);
+  }
 }
 
 /**
@@ -561,6 +698,11 @@ ncm_fit_mcmc_reset (NcmFitMCMC *mcmc)
   mcmc->write_index     = 0;
   mcmc->ntotal          = 0;
   mcmc->naccepted       = 0;
+  mcmc->nscreened       = 0;
+  mcmc->nscreen_rejected = 0;
+  mcmc->nfull           = 0;
+  mcmc->screen_time     = 0.0;
+  mcmc->full_time       = 0.0;
   mcmc->started         = FALSE;  
   ncm_mset_catalog_reset (mcmc->mcat);
 }
@@ -670,10 +812,40 @@ ncm_fit_mcmc_run (NcmFitMCMC *mcmc, guint n)
 
   if (mcmc->nthreads <= 1)
     _ncm_fit_mcmc_run_single (mcmc);
+  else if (mcmc->screen != NULL)
+  {
+    if (mcmc->mtype > NCM_FIT_RUN_MSGS_NONE)
+      g_message ("# NcmFitMCMC: screening is not supported with %u threads, running single-threaded.\n", mcmc->nthreads);
+    _ncm_fit_mcmc_run_single (mcmc);
+  }
   else
     _ncm_fit_mcmc_run_mt (mcmc);
 
   ncm_timer_task_pause (mcmc->nt);
+  ncm_profiler_report_if_enabled ();
+}
+
+static gboolean
+_ncm_fit_mcmc_screen (NcmFitMCMC *mcmc, gdouble *m2lnL_screen_star)
+{
+  const gdouble t0 = ncm_profiler_time ();
+  gdouble prob;
+
+  ncm_mset_fparams_set_vector (mcmc->screen->mset, mcmc->thetastar);
+  ncm_fit_m2lnL_val (mcmc->screen, m2lnL_screen_star);
+
+  mcmc->screen_time += ncm_profiler_time () - t0;
+  mcmc->nscreened++;
+
+  prob = GSL_MIN (exp ((mcmc->m2lnL_screen_cur - m2lnL_screen_star[0]) * 0.5), 1.0);
+
+  if ((prob != 1.0) && (gsl_rng_uniform (mcmc->mcat->rng->r) > prob))
+  {
+    mcmc->nscreen_rejected++;
+    return FALSE;
+  }
+  else
+    return TRUE;
 }
 
 static void 
@@ -685,19 +857,39 @@ _ncm_fit_mcmc_run_single (NcmFitMCMC *mcmc)
   {
     gdouble m2lnL_cur = ncm_fit_state_get_m2lnL_curval (mcmc->fit->fstate);
     gdouble m2lnL_star, prob, jump = 0.0;
+    gdouble m2lnL_screen_star = 0.0;
+    gboolean accepted         = TRUE;
     
     ncm_mset_fparams_get_vector (mcmc->fit->mset, mcmc->theta);
     ncm_mset_trans_kern_generate (mcmc->tkern, mcmc->theta, mcmc->thetastar, mcmc->mcat->rng);
+
+    if ((mcmc->screen != NULL) && !_ncm_fit_mcmc_screen (mcmc, &m2lnL_screen_star))
+    {
+      /* Rejected in the first stage, the chain stays at theta. */
+      mcmc->ntotal++;
+      _ncm_fit_mcmc_update (mcmc, mcmc->fit);
+      mcmc->write_index++;
+      continue;
+    }
+
     ncm_mset_fparams_set_vector (mcmc->fit->mset, mcmc->thetastar);
 
-    ncm_fit_m2lnL_val (mcmc->fit, &m2lnL_star);
+    {
+      const gdouble t0 = ncm_profiler_time ();
+      ncm_fit_m2lnL_val (mcmc->fit, &m2lnL_star);
+      mcmc->full_time += ncm_profiler_time () - t0;
+      mcmc->nfull++;
+    }
     mcmc->ntotal++;
     mcmc->naccepted++;
 /*
     ncm_vector_log_vals (mcmc->theta, "# Theta  : ", "% 8.5g");
     ncm_vector_log_vals (mcmc->thetastar, "# Theta* : ", "% 8.5g");
 */
-    prob = GSL_MIN (exp ((m2lnL_cur - m2lnL_star) * 0.5), 1.0);
+    if (mcmc->screen != NULL)
+      prob = GSL_MIN (exp ((m2lnL_cur - m2lnL_star + m2lnL_screen_star - mcmc->m2lnL_screen_cur) * 0.5), 1.0);
+    else
+      prob = GSL_MIN (exp ((m2lnL_cur - m2lnL_star) * 0.5), 1.0);
     ncm_fit_state_set_m2lnL_curval (mcmc->fit->fstate, m2lnL_star);
     
     /*printf ("# Prob %e [% 21.16g % 21.16g] % 21.16g\n", prob, m2lnL_cur, m2lnL_star, m2lnL_cur - m2lnL_star);*/    
@@ -710,8 +902,12 @@ _ncm_fit_mcmc_run_single (NcmFitMCMC *mcmc)
         ncm_mset_fparams_set_vector (mcmc->fit->mset, mcmc->theta);
         ncm_fit_state_set_m2lnL_curval (mcmc->fit->fstate, m2lnL_cur);
         mcmc->naccepted--;
+        accepted = FALSE;
       }
     }
+
+    if ((mcmc->screen != NULL) && accepted)
+      mcmc->m2lnL_screen_cur = m2lnL_screen_star;
     
     _ncm_fit_mcmc_update (mcmc, mcmc->fit);
     mcmc->write_index++;
@@ -724,7 +920,14 @@ _ncm_fit_mcmc_dup_fit (gpointer userdata)
   NcmFitMCMC *mcmc = NCM_FIT_MCMC (userdata);
   g_mutex_lock (&mcmc->dup_fit);
   {
-    NcmFit *fit = ncm_fit_dup (mcmc->fit, mcmc->ser);
+    gdouble clone_time = 0.0;
+    gsize clone_size   = 0;
+    NcmFit *fit        = ncm_fit_clone (mcmc->fit, mcmc->ser, &clone_time, &clone_size);
+
+    if (mcmc->mtype == NCM_FIT_RUN_MSGS_FULL)
+      g_message ("# NcmFitMCMC: worker fit cloned in %.3f s, %.3f MiB copied.\n", 
+                 clone_time, clone_size / (1024.0 * 1024.0));
+
     ncm_serialize_reset (mcmc->ser, TRUE);
     g_mutex_unlock (&mcmc->dup_fit);
     return fit;
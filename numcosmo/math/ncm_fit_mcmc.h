@@ -72,6 +72,13 @@ struct _NcmFitMCMC
   guint nthreads;
   guint n;
   NcmMemoryPool *mp;
+  NcmFit *screen;
+  gdouble m2lnL_screen_cur;
+  guint nscreened;
+  guint nscreen_rejected;
+  guint nfull;
+  gdouble screen_time;
+  gdouble full_time;
   gint write_index;
   gint cur_sample_id;
   guint naccepted;
@@ -96,8 +103,12 @@ void ncm_fit_mcmc_set_trans_kern (NcmFitMCMC *mcmc, NcmMSetTransKern *tkern);
 void ncm_fit_mcmc_set_nthreads (NcmFitMCMC *mcmc, guint nthreads);
 void ncm_fit_mcmc_set_fiducial (NcmFitMCMC *mcmc, NcmMSet *fiduc);
 void ncm_fit_mcmc_set_rng (NcmFitMCMC *mcmc, NcmRNG *rng);
+void ncm_fit_mcmc_set_screen_fit (NcmFitMCMC *mcmc, NcmFit *screen);
+NcmFit *ncm_fit_mcmc_peek_screen_fit (NcmFitMCMC *mcmc);
 
 gdouble ncm_fit_mcmc_get_accept_ratio (NcmFitMCMC *mcmc);
+gdouble ncm_fit_mcmc_get_screen_reject_ratio (NcmFitMCMC *mcmc);
+gdouble ncm_fit_mcmc_get_screen_time_saved (NcmFitMCMC *mcmc);
 
 void ncm_fit_mcmc_start_run (NcmFitMCMC *mcmc);
 void ncm_fit_mcmc_end_run (NcmFitMCMC *mcmc);
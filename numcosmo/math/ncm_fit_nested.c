@@ -0,0 +1,1219 @@
+/***************************************************************************
+ *            ncm_fit_nested.c
+ *
+ *  Sun October 18 16:02:55 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_fit_nested.c
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:ncm_fit_nested
+ * @title: NcmFitNested
+ * @short_description: Nested sampling for evidence computation.
+ *
+ * Nested sampling (Skilling 2006) driver using the likelihood of a #NcmFit
+ * and a #NcmMSetTransKern as the prior $\pi$. The object keeps $N$ live
+ * points sampled from $\pi$, in each iteration the $k$ points with the
+ * lowest likelihood are removed and replaced by new points drawn from
+ * $\pi$ restricted to $L > L_\star$, where $L_\star$ is the largest
+ * likelihood among the removed points. Removing the $j$-th worst point
+ * ($j = 0, \dots, k-1$) shrinks the prior volume by $\exp[-1/(N - j)]$,
+ * hence $k = 1$ is the usual algorithm, while $k > 1$ allows the $k$
+ * replacements to be computed in parallel using the #NcmFunc thread pool
+ * (see ncm_fit_nested_set_nreplace() and ncm_fit_nested_set_nthreads()).
+ *
+ * Each new point is obtained by a constrained random walk of
+ * ncm_fit_nested_set_nsteps() steps starting from a random surviving live
+ * point. The proposal is a Gaussian with the live points covariance,
+ * its scale is adapted to keep the acceptance ratio around 50%. Each walk
+ * has its own #NcmRNG seeded by the main #NcmRNG, therefore, the results
+ * do not depend on the number of threads.
+ *
+ * The run stops when the remaining prior volume can change $\ln Z$ by
+ * less than ncm_fit_nested_set_dlnZ(), and the live points are then added
+ * as the last dead points. The dead points are written to a weighted
+ * #NcmMSetCatalog with the posterior weights $w_i = L_i\Delta X_i / Z$.
+ * Since the weights depend on the final evidence, the points are kept in
+ * memory during the run and written when it finishes.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif /* HAVE_CONFIG_H */
+#include "build_cfg.h"
+
+#include "math/ncm_fit_nested.h"
+#include "math/ncm_func_eval.h"
+#include "math/ncm_cfg.h"
+#include "math/ncm_profiler.h"
+#include "ncm_enum_types.h"
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_linalg.h>
+#include <string.h>
+
+enum
+{
+  PROP_0,
+  PROP_FIT,
+  PROP_PRIOR,
+  PROP_NLIVE,
+  PROP_NREPLACE,
+  PROP_NSTEPS,
+  PROP_MAX_ITER,
+  PROP_NTHREADS,
+  PROP_DLNZ,
+  PROP_MTYPE,
+  PROP_DATA_FILE,
+  PROP_SIZE,
+};
+
+G_DEFINE_TYPE (NcmFitNested, ncm_fit_nested, G_TYPE_OBJECT);
+
+static gpointer _ncm_fit_nested_dup_fit (gpointer userdata);
+
+static void
+ncm_fit_nested_init (NcmFitNested *nested)
+{
+  nested->fit        = NULL;
+  nested->prior      = NULL;
+  nested->mcat       = NULL;
+  nested->mtype      = NCM_FIT_RUN_MSGS_NONE;
+  nested->ser        = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+  nested->fit_pool   = ncm_memory_pool_new (&_ncm_fit_nested_dup_fit, nested,
+                                            (GDestroyNotify) &ncm_fit_free);
+  nested->nt         = ncm_timer_new ();
+  nested->fparam_len = 0;
+  nested->nlive      = 0;
+  nested->nreplace   = 0;
+  nested->nsteps     = 0;
+  nested->max_iter   = 0;
+  nested->nthreads   = 0;
+  nested->dlnZ       = 0.0;
+  nested->scale      = 1.0;
+  nested->live       = g_ptr_array_new ();
+  nested->live_m2lnL = NULL;
+  nested->chol       = NULL;
+  nested->mean       = NULL;
+  nested->new_points = g_ptr_array_new ();
+  nested->new_m2lnL  = NULL;
+  nested->order      = g_array_new (FALSE, FALSE, sizeof (gsize));
+  nested->start      = g_array_new (FALSE, FALSE, sizeof (guint));
+  nested->naccepted  = g_array_new (FALSE, FALSE, sizeof (guint));
+  nested->nevals     = g_array_new (FALSE, FALSE, sizeof (guint));
+  nested->rngs       = g_ptr_array_new ();
+  nested->dead       = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  nested->m2lnL_star = GSL_POSINF;
+  nested->lnX        = 0.0;
+  nested->lnZ        = GSL_NEGINF;
+  nested->H          = 0.0;
+  nested->niter      = 0;
+  nested->neval      = 0;
+  nested->ntry       = 0;
+  nested->naccept    = 0;
+  nested->started    = FALSE;
+  nested->finished   = FALSE;
+
+  g_ptr_array_set_free_func (nested->live, (GDestroyNotify) &ncm_vector_free);
+  g_ptr_array_set_free_func (nested->new_points, (GDestroyNotify) &ncm_vector_free);
+  g_ptr_array_set_free_func (nested->rngs, (GDestroyNotify) &ncm_rng_free);
+
+  g_mutex_init (&nested->dup_fit);
+  g_mutex_init (&nested->prior_lock);
+}
+
+static void
+_ncm_fit_nested_constructed (GObject *object)
+{
+  /* Chain up : start */
+  G_OBJECT_CLASS (ncm_fit_nested_parent_class)->constructed (object);
+  {
+    NcmFitNested *nested = NCM_FIT_NESTED (object);
+    guint k;
+
+    g_assert (nested->fit != NULL);
+    g_assert (nested->prior != NULL);
+    g_assert_cmpuint (nested->nlive, >, 1);
+
+    nested->fparam_len = ncm_mset_fparam_len (nested->fit->mset);
+    g_assert_cmpuint (nested->fparam_len, >, 0);
+
+    nested->mcat = ncm_mset_catalog_new (nested->fit->mset, 1, 1, TRUE,
+                                         NCM_MSET_CATALOG_M2LNL_COLNAME, NCM_MSET_CATALOG_M2LNL_SYMBOL,
+                                         NULL);
+    ncm_mset_catalog_set_run_type (nested->mcat, "Nested Sampling");
+
+    for (k = 0; k < nested->nlive; k++)
+      g_ptr_array_add (nested->live, ncm_vector_new (nested->fparam_len));
+
+    nested->live_m2lnL = ncm_vector_new (nested->nlive);
+    nested->chol       = ncm_matrix_new (nested->fparam_len, nested->fparam_len);
+    nested->mean       = ncm_vector_new (nested->fparam_len);
+
+    g_array_set_size (nested->order, nested->nlive);
+  }
+}
+
+static void
+_ncm_fit_nested_set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
+{
+  NcmFitNested *nested = NCM_FIT_NESTED (object);
+  g_return_if_fail (NCM_IS_FIT_NESTED (object));
+
+  switch (prop_id)
+  {
+    case PROP_FIT:
+      nested->fit = g_value_dup_object (value);
+      break;
+    case PROP_PRIOR:
+      nested->prior = g_value_dup_object (value);
+      break;
+    case PROP_NLIVE:
+      nested->nlive = g_value_get_uint (value);
+      break;
+    case PROP_NREPLACE:
+      ncm_fit_nested_set_nreplace (nested, g_value_get_uint (value));
+      break;
+    case PROP_NSTEPS:
+      ncm_fit_nested_set_nsteps (nested, g_value_get_uint (value));
+      break;
+    case PROP_MAX_ITER:
+      ncm_fit_nested_set_max_iter (nested, g_value_get_uint (value));
+      break;
+    case PROP_NTHREADS:
+      ncm_fit_nested_set_nthreads (nested, g_value_get_uint (value));
+      break;
+    case PROP_DLNZ:
+      ncm_fit_nested_set_dlnZ (nested, g_value_get_double (value));
+      break;
+    case PROP_MTYPE:
+      ncm_fit_nested_set_mtype (nested, g_value_get_enum (value));
+      break;
+    case PROP_DATA_FILE:
+      ncm_fit_nested_set_data_file (nested, g_value_get_string (value));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+_ncm_fit_nested_get_property (GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
+{
+  NcmFitNested *nested = NCM_FIT_NESTED (object);
+  g_return_if_fail (NCM_IS_FIT_NESTED (object));
+
+  switch (prop_id)
+  {
+    case PROP_FIT:
+      g_value_set_object (value, nested->fit);
+      break;
+    case PROP_PRIOR:
+      g_value_set_object (value, nested->prior);
+      break;
+    case PROP_NLIVE:
+      g_value_set_uint (value, nested->nlive);
+      break;
+    case PROP_NREPLACE:
+      g_value_set_uint (value, nested->nreplace);
+      break;
+    case PROP_NSTEPS:
+      g_value_set_uint (value, nested->nsteps);
+      break;
+    case PROP_MAX_ITER:
+      g_value_set_uint (value, nested->max_iter);
+      break;
+    case PROP_NTHREADS:
+      g_value_set_uint (value, nested->nthreads);
+      break;
+    case PROP_DLNZ:
+      g_value_set_double (value, nested->dlnZ);
+      break;
+    case PROP_MTYPE:
+      g_value_set_enum (value, nested->mtype);
+      break;
+    case PROP_DATA_FILE:
+      g_value_set_string (value, ncm_mset_catalog_peek_filename (nested->mcat));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+_ncm_fit_nested_dispose (GObject *object)
+{
+  NcmFitNested *nested = NCM_FIT_NESTED (object);
+
+  if (nested->fit_pool != NULL)
+  {
+    ncm_memory_pool_free (nested->fit_pool, TRUE);
+    nested->fit_pool = NULL;
+  }
+
+  ncm_fit_clear (&nested->fit);
+  ncm_mset_trans_kern_clear (&nested->prior);
+  ncm_mset_catalog_clear (&nested->mcat);
+  ncm_serialize_clear (&nested->ser);
+  ncm_timer_clear (&nested->nt);
+
+  ncm_vector_clear (&nested->live_m2lnL);
+  ncm_vector_clear (&nested->new_m2lnL);
+  ncm_vector_clear (&nested->mean);
+  ncm_matrix_clear (&nested->chol);
+
+  g_clear_pointer (&nested->live, g_ptr_array_unref);
+  g_clear_pointer (&nested->new_points, g_ptr_array_unref);
+  g_clear_pointer (&nested->rngs, g_ptr_array_unref);
+  g_clear_pointer (&nested->order, g_array_unref);
+  g_clear_pointer (&nested->start, g_array_unref);
+  g_clear_pointer (&nested->naccepted, g_array_unref);
+  g_clear_pointer (&nested->nevals, g_array_unref);
+  g_clear_pointer (&nested->dead, g_array_unref);
+
+  /* Chain up : end */
+  G_OBJECT_CLASS (ncm_fit_nested_parent_class)->dispose (object);
+}
+
+static void
+_ncm_fit_nested_finalize (GObject *object)
+{
+  NcmFitNested *nested = NCM_FIT_NESTED (object);
+
+  g_mutex_clear (&nested->dup_fit);
+  g_mutex_clear (&nested->prior_lock);
+
+  /* Chain up : end */
+  G_OBJECT_CLASS (ncm_fit_nested_parent_class)->finalize (object);
+}
+
+static void
+ncm_fit_nested_class_init (NcmFitNestedClass *klass)
+{
+  GObjectClass* object_class = G_OBJECT_CLASS (klass);
+
+  object_class->constructed  = &_ncm_fit_nested_constructed;
+  object_class->set_property = &_ncm_fit_nested_set_property;
+  object_class->get_property = &_ncm_fit_nested_get_property;
+  object_class->dispose      = &_ncm_fit_nested_dispose;
+  object_class->finalize     = &_ncm_fit_nested_finalize;
+
+  g_object_class_install_property (object_class,
+                                   PROP_FIT,
+                                   g_param_spec_object ("fit",
+                                                        NULL,
+                                                        "Fitter object",
+                                                        NCM_TYPE_FIT,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_PRIOR,
+                                   g_param_spec_object ("prior",
+                                                        NULL,
+                                                        "Prior distribution",
+                                                        NCM_TYPE_MSET_TRANS_KERN,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_NLIVE,
+                                   g_param_spec_uint ("nlive",
+                                                      NULL,
+                                                      "Number of live points",
+                                                      2, G_MAXUINT32, 400,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_NREPLACE,
+                                   g_param_spec_uint ("nreplace",
+                                                      NULL,
+                                                      "Number of live points replaced per iteration",
+                                                      1, G_MAXUINT32, 1,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_NSTEPS,
+                                   g_param_spec_uint ("nsteps",
+                                                      NULL,
+                                                      "Number of constrained random walk steps",
+                                                      1, G_MAXUINT32, 25,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_MAX_ITER,
+                                   g_param_spec_uint ("max-iter",
+                                                      NULL,
+                                                      "Maximum number of iterations (zero means no limit)",
+                                                      0, G_MAXUINT32, 0,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_NTHREADS,
+                                   g_param_spec_uint ("nthreads",
+                                                      NULL,
+                                                      "Number of threads to run",
+                                                      0, G_MAXUINT32, 0,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_DLNZ,
+                                   g_param_spec_double ("dlnZ",
+                                                        NULL,
+                                                        "Stopping tolerance on the evidence logarithm",
+                                                        0.0, G_MAXDOUBLE, 0.1,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_MTYPE,
+                                   g_param_spec_enum ("mtype",
+                                                      NULL,
+                                                      "Run messages type",
+                                                      NCM_TYPE_FIT_RUN_MSGS, NCM_FIT_RUN_MSGS_NONE,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_DATA_FILE,
+                                   g_param_spec_string ("data-file",
+                                                        NULL,
+                                                        "Data filename",
+                                                        NULL,
+                                                        G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+}
+
+static gpointer
+_ncm_fit_nested_dup_fit (gpointer userdata)
+{
+  NcmFitNested *nested = NCM_FIT_NESTED (userdata);
+  g_mutex_lock (&nested->dup_fit);
+  {
+    gdouble clone_time = 0.0;
+    gsize clone_size   = 0;
+    NcmFit *fit        = ncm_fit_clone (nested->fit, nested->ser, &clone_time, &clone_size);
+
+    if (nested->mtype == NCM_FIT_RUN_MSGS_FULL)
+      g_message ("# NcmFitNested: worker fit cloned in %.3f s, %.3f MiB copied.\n",
+                 clone_time, clone_size / (1024.0 * 1024.0));
+
+    ncm_serialize_reset (nested->ser, TRUE);
+    g_mutex_unlock (&nested->dup_fit);
+    return fit;
+  }
+}
+
+/**
+ * ncm_fit_nested_new:
+ * @fit: a #NcmFit
+ * @prior: a #NcmMSetTransKern
+ * @nlive: number of live points
+ * @mtype: a #NcmFitRunMsgs
+ *
+ * Creates a new #NcmFitNested, the points are sampled from the prior
+ * using ncm_mset_trans_kern_prior_sample() and the prior density is
+ * obtained from ncm_mset_trans_kern_prior_pdf(). The priors included in
+ * the #NcmLikelihood of @fit are treated as part of the likelihood.
+ *
+ * Returns: (transfer full): a new #NcmFitNested.
+ */
+NcmFitNested *
+ncm_fit_nested_new (NcmFit *fit, NcmMSetTransKern *prior, guint nlive, NcmFitRunMsgs mtype)
+{
+  NcmFitNested *nested = g_object_new (NCM_TYPE_FIT_NESTED,
+                                       "fit",   fit,
+                                       "prior", prior,
+                                       "nlive", nlive,
+                                       "mtype", mtype,
+                                       NULL);
+  return nested;
+}
+
+/**
+ * ncm_fit_nested_ref:
+ * @nested: a #NcmFitNested
+ *
+ * Increases the reference count of @nested by one.
+ *
+ * Returns: (transfer full): @nested.
+ */
+NcmFitNested *
+ncm_fit_nested_ref (NcmFitNested *nested)
+{
+  return g_object_ref (nested);
+}
+
+/**
+ * ncm_fit_nested_free:
+ * @nested: a #NcmFitNested
+ *
+ * Decreases the reference count of @nested by one.
+ *
+ */
+void
+ncm_fit_nested_free (NcmFitNested *nested)
+{
+  g_object_unref (nested);
+}
+
+/**
+ * ncm_fit_nested_clear:
+ * @nested: a #NcmFitNested
+ *
+ * If *@nested is different from NULL, decreases the reference count of
+ * *@nested by one and sets *@nested to NULL.
+ *
+ */
+void
+ncm_fit_nested_clear (NcmFitNested **nested)
+{
+  g_clear_object (nested);
+}
+
+/**
+ * ncm_fit_nested_set_data_file:
+ * @nested: a #NcmFitNested
+ * @filename: a filename
+ *
+ * Sets the catalog file where the dead points are written.
+ *
+ */
+void
+ncm_fit_nested_set_data_file (NcmFitNested *nested, const gchar *filename)
+{
+  if (nested->started)
+    g_error ("ncm_fit_nested_set_data_file: Cannot change data file during a run, call ncm_fit_nested_end_run() first.");
+
+  if (filename == NULL)
+    return;
+
+  ncm_mset_catalog_set_file (nested->mcat, filename);
+}
+
+/**
+ * ncm_fit_nested_set_mtype:
+ * @nested: a #NcmFitNested
+ * @mtype: a #NcmFitRunMsgs
+ *
+ * Sets the messages level.
+ *
+ */
+void
+ncm_fit_nested_set_mtype (NcmFitNested *nested, NcmFitRunMsgs mtype)
+{
+  nested->mtype = mtype;
+}
+
+/**
+ * ncm_fit_nested_set_rng:
+ * @nested: a #NcmFitNested
+ * @rng: a #NcmRNG
+ *
+ * Sets the main #NcmRNG, it is used to sample the initial live points
+ * and to seed the random walks.
+ *
+ */
+void
+ncm_fit_nested_set_rng (NcmFitNested *nested, NcmRNG *rng)
+{
+  if (nested->started)
+    g_error ("ncm_fit_nested_set_rng: Cannot change the RNG object during a run, call ncm_fit_nested_end_run() first.");
+
+  ncm_mset_catalog_set_rng (nested->mcat, rng);
+}
+
+/**
+ * ncm_fit_nested_set_nreplace:
+ * @nested: a #NcmFitNested
+ * @nreplace: number of live points replaced per iteration
+ *
+ * Sets the number of live points replaced in each iteration. The
+ * replacements are computed in parallel, it must be at most half of the
+ * number of live points, in practice it should be a small fraction of it
+ * since each removed point reduces the effective number of live points
+ * used in that iteration.
+ *
+ */
+void
+ncm_fit_nested_set_nreplace (NcmFitNested *nested, guint nreplace)
+{
+  if (nested->started)
+    g_error ("ncm_fit_nested_set_nreplace: Cannot change the number of replacements during a run, call ncm_fit_nested_end_run() first.");
+
+  g_assert_cmpuint (nreplace, >, 0);
+  nested->nreplace = nreplace;
+}
+
+/**
+ * ncm_fit_nested_set_nsteps:
+ * @nested: a #NcmFitNested
+ * @nsteps: number of random walk steps
+ *
+ * Sets the number of constrained random walk steps used to generate each
+ * new live point.
+ *
+ */
+void
+ncm_fit_nested_set_nsteps (NcmFitNested *nested, guint nsteps)
+{
+  g_assert_cmpuint (nsteps, >, 0);
+  nested->nsteps = nsteps;
+}
+
+/**
+ * ncm_fit_nested_set_max_iter:
+ * @nested: a #NcmFitNested
+ * @max_iter: maximum number of iterations
+ *
+ * Sets the maximum number of iterations, zero means no limit.
+ *
+ */
+void
+ncm_fit_nested_set_max_iter (NcmFitNested *nested, guint max_iter)
+{
+  nested->max_iter = max_iter;
+}
+
+/**
+ * ncm_fit_nested_set_nthreads:
+ * @nested: a #NcmFitNested
+ * @nthreads: number of threads
+ *
+ * Sets the number of threads, when larger than one the live point
+ * evaluations and replacements are computed using the #NcmFunc thread
+ * pool.
+ *
+ */
+void
+ncm_fit_nested_set_nthreads (NcmFitNested *nested, guint nthreads)
+{
+  nested->nthreads = nthreads;
+}
+
+/**
+ * ncm_fit_nested_set_dlnZ:
+ * @nested: a #NcmFitNested
+ * @dlnZ: tolerance
+ *
+ * Sets the stopping tolerance, the run ends when
+ * $\ln(Z + L_\mathrm{max}X) - \ln Z <$ @dlnZ, where $L_\mathrm{max}$ is
+ * the largest live likelihood and $X$ the remaining prior volume.
+ *
+ */
+void
+ncm_fit_nested_set_dlnZ (NcmFitNested *nested, gdouble dlnZ)
+{
+  g_assert_cmpfloat (dlnZ, >=, 0.0);
+  nested->dlnZ = dlnZ;
+}
+
+static gdouble
+_ncm_fit_nested_lnaddexp (const gdouble a, const gdouble b)
+{
+  if (a == GSL_NEGINF)
+    return b;
+  else if (b == GSL_NEGINF)
+    return a;
+  else if (a > b)
+    return a + log1p (exp (b - a));
+  else
+    return b + log1p (exp (a - b));
+}
+
+static void
+_ncm_fit_nested_run_mt (NcmFitNested *nested, NcmFuncEvalLoop lfunc, glong i, glong f)
+{
+  if (nested->nthreads > 1)
+    ncm_func_eval_threaded_loop_full (lfunc, i, f, nested);
+  else
+    lfunc (i, f, nested);
+}
+
+static void
+_ncm_fit_nested_live_mt_eval (glong i, glong f, gpointer data)
+{
+  NcmFitNested *nested = NCM_FIT_NESTED (data);
+  NcmFit **fit_ptr     = ncm_memory_pool_get (nested->fit_pool);
+  NcmFit *fit_k        = *fit_ptr;
+  glong k;
+
+  for (k = i; k < f; k++)
+  {
+    NcmVector *theta_k = g_ptr_array_index (nested->live, k);
+    gdouble *m2lnL     = ncm_vector_ptr (nested->live_m2lnL, k);
+
+    if (gsl_finite (m2lnL[0]))
+      continue;
+
+    if (ncm_mset_fparam_valid_bounds (fit_k->mset, theta_k))
+    {
+      ncm_mset_fparams_set_vector (fit_k->mset, theta_k);
+      ncm_fit_m2lnL_val (fit_k, m2lnL);
+    }
+  }
+
+  ncm_memory_pool_return (fit_ptr);
+}
+
+static gdouble
+_ncm_fit_nested_prior_pdf (NcmFitNested *nested, NcmVector *theta)
+{
+  gdouble pdf;
+
+  g_mutex_lock (&nested->prior_lock);
+  pdf = ncm_mset_trans_kern_prior_pdf (nested->prior, theta);
+  g_mutex_unlock (&nested->prior_lock);
+
+  return pdf;
+}
+
+static void
+_ncm_fit_nested_walk_mt_eval (glong i, glong f, gpointer data)
+{
+  NcmFitNested *nested = NCM_FIT_NESTED (data);
+  NcmFit **fit_ptr     = ncm_memory_pool_get (nested->fit_pool);
+  NcmFit *fit_k        = *fit_ptr;
+  NcmVector *thetastar = ncm_vector_new (nested->fparam_len);
+  NcmVector *z         = ncm_vector_new (nested->fparam_len);
+  glong j;
+
+  for (j = i; j < f; j++)
+  {
+    const guint start = g_array_index (nested->start, guint, j);
+    NcmRNG *rng_j     = g_ptr_array_index (nested->rngs, j);
+    NcmVector *theta  = g_ptr_array_index (nested->new_points, j);
+    gdouble m2lnL     = ncm_vector_get (nested->live_m2lnL, start);
+    gdouble prior_cur;
+    guint naccepted   = 0;
+    guint nevals      = 0;
+    guint s;
+
+    ncm_vector_memcpy (theta, g_ptr_array_index (nested->live, start));
+    prior_cur = _ncm_fit_nested_prior_pdf (nested, theta);
+
+    for (s = 0; s < nested->nsteps; s++)
+    {
+      gdouble prior_star, m2lnL_star;
+      guint a, b;
+
+      for (a = 0; a < nested->fparam_len; a++)
+        ncm_vector_set (z, a, gsl_ran_ugaussian (rng_j->r));
+
+      for (a = 0; a < nested->fparam_len; a++)
+      {
+        gdouble theta_a = ncm_vector_get (theta, a);
+
+        for (b = 0; b <= a; b++)
+          theta_a += nested->scale * ncm_matrix_get (nested->chol, a, b) * ncm_vector_get (z, b);
+
+        ncm_vector_set (thetastar, a, theta_a);
+      }
+
+      if (!ncm_mset_fparam_valid_bounds (fit_k->mset, thetastar))
+        continue;
+
+      prior_star = _ncm_fit_nested_prior_pdf (nested, thetastar);
+
+      if (!(prior_star > 0.0))
+        continue;
+
+      if ((prior_star < prior_cur) && (gsl_rng_uniform (rng_j->r) > prior_star / prior_cur))
+        continue;
+
+      ncm_mset_fparams_set_vector (fit_k->mset, thetastar);
+      ncm_fit_m2lnL_val (fit_k, &m2lnL_star);
+      nevals++;
+
+      if (gsl_finite (m2lnL_star) && (m2lnL_star < nested->m2lnL_star))
+      {
+        ncm_vector_memcpy (theta, thetastar);
+        m2lnL     = m2lnL_star;
+        prior_cur = prior_star;
+        naccepted++;
+      }
+    }
+
+    ncm_vector_set (nested->new_m2lnL, j, m2lnL);
+    g_array_index (nested->naccepted, guint, j) = naccepted;
+    g_array_index (nested->nevals, guint, j)    = nevals;
+  }
+
+  ncm_vector_free (thetastar);
+  ncm_vector_free (z);
+  ncm_memory_pool_return (fit_ptr);
+}
+
+/**
+ * ncm_fit_nested_start_run:
+ * @nested: a #NcmFitNested
+ *
+ * Samples the initial live points from the prior, points with non-finite
+ * $-2\ln(L)$ are resampled.
+ *
+ */
+void
+ncm_fit_nested_start_run (NcmFitNested *nested)
+{
+  NcmRNG *rng;
+  guint k;
+
+  if (nested->started)
+    g_error ("ncm_fit_nested_start_run: run already started, run ncm_fit_nested_end_run() first.");
+
+  g_assert_cmpuint (nested->nreplace, <=, nested->nlive / 2);
+
+  switch (nested->mtype)
+  {
+    default:
+    case NCM_FIT_RUN_MSGS_FULL:
+      ncm_cfg_msg_sepa ();
+      g_message ("# NcmFitNested: Starting Nested Sampling...\n");
+      ncm_dataset_log_info (nested->fit->lh->dset);
+      ncm_cfg_msg_sepa ();
+      g_message ("# NcmFitNested: Model set:\n");
+      ncm_mset_pretty_log (nested->fit->mset);
+      break;
+    case NCM_FIT_RUN_MSGS_SIMPLE:
+      break;
+    case NCM_FIT_RUN_MSGS_NONE:
+      break;
+  }
+
+  if (ncm_mset_catalog_peek_rng (nested->mcat) == NULL)
+  {
+    NcmRNG *rng = ncm_rng_new (NULL);
+
+    ncm_rng_set_random_seed (rng, FALSE);
+    ncm_fit_nested_set_rng (nested, rng);
+
+    if (nested->mtype > NCM_FIT_RUN_MSGS_NONE)
+      g_message ("# NcmFitNested: No RNG was defined, using algorithm: `%s' and seed: %lu.\n",
+                 ncm_rng_get_algo (rng), ncm_rng_get_seed (rng));
+
+    ncm_rng_free (rng);
+  }
+  rng = ncm_mset_catalog_peek_rng (nested->mcat);
+
+  g_ptr_array_set_size (nested->new_points, 0);
+  g_ptr_array_set_size (nested->rngs, 0);
+  for (k = 0; k < nested->nreplace; k++)
+  {
+    g_ptr_array_add (nested->new_points, ncm_vector_new (nested->fparam_len));
+    g_ptr_array_add (nested->rngs, ncm_rng_new (ncm_rng_get_algo (rng)));
+  }
+  ncm_vector_clear (&nested->new_m2lnL);
+  nested->new_m2lnL = ncm_vector_new (nested->nreplace);
+  g_array_set_size (nested->start,     nested->nreplace);
+  g_array_set_size (nested->naccepted, nested->nreplace);
+  g_array_set_size (nested->nevals,    nested->nreplace);
+
+  ncm_vector_set_all (nested->live_m2lnL, GSL_POSINF);
+  nested->neval = 0;
+
+  while (TRUE)
+  {
+    guint nresample = 0;
+
+    /* The kernels lock the RNG themselves when needed. */
+    for (k = 0; k < nested->nlive; k++)
+    {
+      if (!gsl_finite (ncm_vector_get (nested->live_m2lnL, k)))
+      {
+        ncm_mset_trans_kern_prior_sample (nested->prior, g_ptr_array_index (nested->live, k), rng);
+        nresample++;
+      }
+    }
+
+    if (nresample == 0)
+      break;
+
+    nested->neval += nresample;
+    _ncm_fit_nested_run_mt (nested, &_ncm_fit_nested_live_mt_eval, 0, nested->nlive);
+  }
+
+  g_array_set_size (nested->dead, 0);
+  nested->scale      = 1.0;
+  nested->m2lnL_star = GSL_POSINF;
+  nested->lnX        = 0.0;
+  nested->lnZ        = GSL_NEGINF;
+  nested->H          = 0.0;
+  nested->niter      = 0;
+  nested->ntry       = 0;
+  nested->naccept    = 0;
+  nested->started    = TRUE;
+  nested->finished   = FALSE;
+
+  ncm_timer_start (nested->nt);
+}
+
+/**
+ * ncm_fit_nested_end_run:
+ * @nested: a #NcmFitNested
+ *
+ * Ends the run and synchronizes the catalog file.
+ *
+ */
+void
+ncm_fit_nested_end_run (NcmFitNested *nested)
+{
+  if (!nested->started)
+    g_error ("ncm_fit_nested_end_run: run not started, run ncm_fit_nested_start_run() first.");
+
+  ncm_timer_stop (nested->nt);
+  ncm_mset_catalog_sync (nested->mcat, TRUE);
+
+  nested->started = FALSE;
+}
+
+static void
+_ncm_fit_nested_add_dead (NcmFitNested *nested, guint k, const gdouble lnw)
+{
+  const guint row_len = nested->fparam_len + 2;
+  const gdouble m2lnL = ncm_vector_get (nested->live_m2lnL, k);
+  const gdouble lnL   = -0.5 * m2lnL;
+  const gdouble lnZ   = _ncm_fit_nested_lnaddexp (nested->lnZ, lnw);
+  NcmVector *theta_k  = g_ptr_array_index (nested->live, k);
+  const guint len     = nested->dead->len;
+  guint a;
+
+  if (nested->lnZ == GSL_NEGINF)
+    nested->H = lnL - lnZ;
+  else
+    nested->H = exp (lnw - lnZ) * lnL + exp (nested->lnZ - lnZ) * (nested->H + nested->lnZ) - lnZ;
+
+  nested->lnZ = lnZ;
+
+  g_array_set_size (nested->dead, len + row_len);
+  g_array_index (nested->dead, gdouble, len + 0) = m2lnL;
+  g_array_index (nested->dead, gdouble, len + 1) = lnw;
+  for (a = 0; a < nested->fparam_len; a++)
+    g_array_index (nested->dead, gdouble, len + 2 + a) = ncm_vector_get (theta_k, a);
+}
+
+static void
+_ncm_fit_nested_prepare_proposal (NcmFitNested *nested, const guint nsurv)
+{
+  const gsize *order = &g_array_index (nested->order, gsize, 0);
+  const guint d      = nested->fparam_len;
+  gint ret;
+  guint a, b, l;
+
+  ncm_vector_set_zero (nested->mean);
+  ncm_matrix_set_zero (nested->chol);
+
+  for (l = 0; l < nsurv; l++)
+  {
+    NcmVector *theta_l = g_ptr_array_index (nested->live, order[l]);
+
+    for (a = 0; a < d; a++)
+      ncm_vector_addto (nested->mean, a, ncm_vector_get (theta_l, a) / nsurv);
+  }
+
+  for (l = 0; l < nsurv; l++)
+  {
+    NcmVector *theta_l = g_ptr_array_index (nested->live, order[l]);
+
+    for (a = 0; a < d; a++)
+    {
+      const gdouble da = ncm_vector_get (theta_l, a) - ncm_vector_get (nested->mean, a);
+
+      for (b = 0; b <= a; b++)
+      {
+        const gdouble db = ncm_vector_get (theta_l, b) - ncm_vector_get (nested->mean, b);
+
+        ncm_matrix_addto (nested->chol, a, b, da * db / (nsurv - 1.0));
+      }
+    }
+  }
+
+  for (a = 0; a < d; a++)
+    for (b = 0; b < a; b++)
+      ncm_matrix_set (nested->chol, b, a, ncm_matrix_get (nested->chol, a, b));
+
+  ret = gsl_linalg_cholesky_decomp (ncm_matrix_gsl (nested->chol));
+
+  if (ret != GSL_SUCCESS)
+  {
+    /* Degenerated live points, use only the variances. */
+    ncm_matrix_set_zero (nested->chol);
+    for (a = 0; a < d; a++)
+    {
+      gdouble var_a = 0.0;
+
+      for (l = 0; l < nsurv; l++)
+        var_a += gsl_pow_2 (ncm_vector_get (g_ptr_array_index (nested->live, order[l]), a) - ncm_vector_get (nested->mean, a)) / (nsurv - 1.0);
+
+      ncm_matrix_set (nested->chol, a, a, sqrt (var_a));
+    }
+  }
+}
+
+static void
+_ncm_fit_nested_log_iter (NcmFitNested *nested)
+{
+  g_message ("# NcmFitNested: iter %8u, -2lnL* = % 20.15g, lnX = % 12.5g, lnZ = % 20.15g, accept = %6.2f%%, evals = %lu\n",
+             nested->niter, nested->m2lnL_star, nested->lnX, nested->lnZ,
+             ncm_fit_nested_get_accept_ratio (nested) * 100.0, nested->neval);
+}
+
+static void
+_ncm_fit_nested_write_catalog (NcmFitNested *nested)
+{
+  const guint row_len = nested->fparam_len + 2;
+  const guint ndead   = nested->dead->len / row_len;
+  NcmVector *row      = ncm_vector_new (row_len);
+  guint i;
+
+  for (i = 0; i < ndead; i++)
+  {
+    gdouble *dead_i = &g_array_index (nested->dead, gdouble, i * row_len);
+
+    /* Catalog layout: -2lnL, weight, parameters. */
+    ncm_vector_set (row, 0, dead_i[0]);
+    ncm_vector_set (row, 1, exp (dead_i[1] - nested->lnZ));
+    memcpy (ncm_vector_ptr (row, 2), &dead_i[2], sizeof (gdouble) * nested->fparam_len);
+
+    ncm_mset_catalog_add_from_vector (nested->mcat, row);
+  }
+
+  ncm_vector_free (row);
+}
+
+/**
+ * ncm_fit_nested_run:
+ * @nested: a #NcmFitNested
+ *
+ * Runs the nested sampling until the stopping criterion
+ * (ncm_fit_nested_set_dlnZ()) or the maximum number of iterations
+ * (ncm_fit_nested_set_max_iter()) is reached. The remaining live points
+ * are then added to the dead points and all points are written to the
+ * catalog.
+ *
+ */
+void
+ncm_fit_nested_run (NcmFitNested *nested)
+{
+  NcmRNG *rng;
+  const guint nlive = nested->nlive;
+  const guint nrep  = nested->nreplace;
+  const guint nsurv = nlive - nrep;
+  gsize *order;
+  guint j, k;
+
+  if (!nested->started)
+    g_error ("ncm_fit_nested_run: run not started, run ncm_fit_nested_start_run() first.");
+
+  if (nested->finished)
+  {
+    if (nested->mtype > NCM_FIT_RUN_MSGS_NONE)
+      g_message ("# NcmFitNested: Nothing to do, run already finished.\n");
+    return;
+  }
+
+  rng   = ncm_mset_catalog_peek_rng (nested->mcat);
+  order = &g_array_index (nested->order, gsize, 0);
+
+  if (nested->mtype > NCM_FIT_RUN_MSGS_NONE)
+  {
+    ncm_cfg_msg_sepa ();
+    g_message ("# NcmFitNested: Running with %u live points, replacing %u per iteration with %u random walk steps.\n",
+               nlive, nrep, nested->nsteps);
+  }
+
+  while ((nested->max_iter == 0) || (nested->niter < nested->max_iter))
+  {
+    guint nacc = 0;
+
+    /* Ascending -2lnL: order[0] is the best point and the last nrep are removed. */
+    gsl_sort_index (order, ncm_vector_data (nested->live_m2lnL), ncm_vector_stride (nested->live_m2lnL), nlive);
+
+    {
+      const gdouble lnL_max = -0.5 * ncm_vector_get (nested->live_m2lnL, order[0]);
+
+      if ((nested->lnZ > GSL_NEGINF) &&
+          (_ncm_fit_nested_lnaddexp (nested->lnZ, lnL_max + nested->lnX) - nested->lnZ < nested->dlnZ))
+        break;
+    }
+
+    for (j = 0; j < nrep; j++)
+    {
+      const guint k_j      = order[nlive - 1 - j];
+      const gdouble lnL_j  = -0.5 * ncm_vector_get (nested->live_m2lnL, k_j);
+      const gdouble lnX_j  = nested->lnX - 1.0 / (nlive - j);
+      const gdouble lnw_j  = lnL_j + nested->lnX + log1p (-exp (lnX_j - nested->lnX));
+
+      _ncm_fit_nested_add_dead (nested, k_j, lnw_j);
+      nested->lnX = lnX_j;
+    }
+    nested->m2lnL_star = ncm_vector_get (nested->live_m2lnL, order[nsurv]);
+
+    _ncm_fit_nested_prepare_proposal (nested, nsurv);
+
+    ncm_rng_lock (rng);
+    for (j = 0; j < nrep; j++)
+    {
+      g_array_index (nested->start, guint, j) = order[gsl_rng_uniform_int (rng->r, nsurv)];
+      ncm_rng_set_seed (g_ptr_array_index (nested->rngs, j), gsl_rng_get (rng->r));
+    }
+    ncm_rng_unlock (rng);
+
+    _ncm_fit_nested_run_mt (nested, &_ncm_fit_nested_walk_mt_eval, 0, nrep);
+
+    for (j = 0; j < nrep; j++)
+    {
+      const guint k_j = order[nlive - 1 - j];
+
+      ncm_vector_memcpy (g_ptr_array_index (nested->live, k_j), g_ptr_array_index (nested->new_points, j));
+      ncm_vector_set (nested->live_m2lnL, k_j, ncm_vector_get (nested->new_m2lnL, j));
+
+      nacc          += g_array_index (nested->naccepted, guint, j);
+      nested->neval += g_array_index (nested->nevals, guint, j);
+    }
+
+    nested->ntry    += nrep * nested->nsteps;
+    nested->naccept += nacc;
+    nested->scale   *= exp (nacc * 1.0 / (nrep * nested->nsteps) - 0.5);
+    nested->niter++;
+
+    if ((nested->mtype == NCM_FIT_RUN_MSGS_FULL) && (nested->niter % nlive == 0))
+      _ncm_fit_nested_log_iter (nested);
+  }
+
+  /* The remaining live points share the remaining prior volume. */
+  for (k = 0; k < nlive; k++)
+  {
+    const gdouble lnL_k = -0.5 * ncm_vector_get (nested->live_m2lnL, k);
+
+    _ncm_fit_nested_add_dead (nested, k, lnL_k + nested->lnX - log (nlive));
+  }
+  nested->finished = TRUE;
+
+  _ncm_fit_nested_write_catalog (nested);
+
+  if (nested->mtype > NCM_FIT_RUN_MSGS_NONE)
+  {
+    gdouble lnZ, lnZ_err;
+
+    ncm_fit_nested_get_evidence (nested, &lnZ, &lnZ_err);
+
+    _ncm_fit_nested_log_iter (nested);
+    ncm_cfg_msg_sepa ();
+    g_message ("# NcmFitNested: lnZ = % 20.15g +/- % 8.5e, information H = % 12.5g nats.\n",
+               lnZ, lnZ_err, nested->H);
+    {
+      gchar *elapsed = ncm_timer_elapsed_dhms_str (nested->nt);
+
+      g_message ("# NcmFitNested: %u dead points, effective sample size % 12.5g, %lu likelihood evaluations in %s.\n",
+                 ncm_mset_catalog_len (nested->mcat), ncm_fit_nested_get_ess (nested), nested->neval,
+                 elapsed);
+      g_free (elapsed);
+    }
+    ncm_mset_catalog_log_current_stats (nested->mcat);
+  }
+
+  ncm_profiler_report_if_enabled ();
+}
+
+/**
+ * ncm_fit_nested_get_evidence:
+ * @nested: a #NcmFitNested
+ * @lnZ: (out): evidence logarithm
+ * @lnZ_err: (out): evidence logarithm error
+ *
+ * Gets the evidence logarithm and its statistical error
+ * $\sqrt{H/N}$, where $H$ is the information and $N$ the number of live
+ * points.
+ *
+ */
+void
+ncm_fit_nested_get_evidence (NcmFitNested *nested, gdouble *lnZ, gdouble *lnZ_err)
+{
+  lnZ[0]     = nested->lnZ;
+  lnZ_err[0] = sqrt (GSL_MAX (nested->H, 0.0) / nested->nlive);
+}
+
+/**
+ * ncm_fit_nested_get_information:
+ * @nested: a #NcmFitNested
+ *
+ * Returns: the information (Kullback-Leibler divergence from prior to posterior) $H$ in nats.
+ */
+gdouble
+ncm_fit_nested_get_information (NcmFitNested *nested)
+{
+  return nested->H;
+}
+
+/**
+ * ncm_fit_nested_get_ess:
+ * @nested: a #NcmFitNested
+ *
+ * Computes the Kish effective sample size $(\sum_i w_i)^2/\sum_i w_i^2$
+ * of the dead points.
+ *
+ * Returns: the effective sample size.
+ */
+gdouble
+ncm_fit_nested_get_ess (NcmFitNested *nested)
+{
+  const guint row_len = nested->fparam_len + 2;
+  const guint ndead   = nested->dead->len / row_len;
+  gdouble sum_w       = 0.0;
+  gdouble sum_w2      = 0.0;
+  guint i;
+
+  for (i = 0; i < ndead; i++)
+  {
+    const gdouble w_i = exp (g_array_index (nested->dead, gdouble, i * row_len + 1) - nested->lnZ);
+
+    sum_w  += w_i;
+    sum_w2 += w_i * w_i;
+  }
+
+  return (sum_w2 > 0.0) ? sum_w * sum_w / sum_w2 : 0.0;
+}
+
+/**
+ * ncm_fit_nested_get_accept_ratio:
+ * @nested: a #NcmFitNested
+ *
+ * Returns: the acceptance ratio of the constrained random walks.
+ */
+gdouble
+ncm_fit_nested_get_accept_ratio (NcmFitNested *nested)
+{
+  return (nested->ntry > 0) ? nested->naccept * 1.0 / nested->ntry : 0.0;
+}
+
+/**
+ * ncm_fit_nested_get_neval:
+ * @nested: a #NcmFitNested
+ *
+ * Returns: the number of likelihood evaluations.
+ */
+gulong
+ncm_fit_nested_get_neval (NcmFitNested *nested)
+{
+  return nested->neval;
+}
+
+/**
+ * ncm_fit_nested_get_catalog:
+ * @nested: a #NcmFitNested
+ *
+ * Returns: (transfer full): the weighted #NcmMSetCatalog with the dead points.
+ */
+NcmMSetCatalog *
+ncm_fit_nested_get_catalog (NcmFitNested *nested)
+{
+  return ncm_mset_catalog_ref (nested->mcat);
+}
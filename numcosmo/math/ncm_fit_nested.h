@@ -0,0 +1,131 @@
+/***************************************************************************
+ *            ncm_fit_nested.h
+ *
+ *  Sun October 18 16:03:12 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_fit_nested.h
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _NCM_FIT_NESTED_H_
+#define _NCM_FIT_NESTED_H_
+
+#include <glib.h>
+#include <glib-object.h>
+#include <numcosmo/build_cfg.h>
+#include <numcosmo/math/ncm_fit.h>
+#include <numcosmo/math/ncm_mset_catalog.h>
+#include <numcosmo/math/ncm_mset_trans_kern.h>
+#include <numcosmo/math/ncm_timer.h>
+#include <numcosmo/math/memory_pool.h>
+
+G_BEGIN_DECLS
+
+#define NCM_TYPE_FIT_NESTED             (ncm_fit_nested_get_type ())
+#define NCM_FIT_NESTED(obj)             (G_TYPE_CHECK_INSTANCE_CAST ((obj), NCM_TYPE_FIT_NESTED, NcmFitNested))
+#define NCM_FIT_NESTED_CLASS(klass)     (G_TYPE_CHECK_CLASS_CAST ((klass), NCM_TYPE_FIT_NESTED, NcmFitNestedClass))
+#define NCM_IS_FIT_NESTED(obj)          (G_TYPE_CHECK_INSTANCE_TYPE ((obj), NCM_TYPE_FIT_NESTED))
+#define NCM_IS_FIT_NESTED_CLASS(klass)  (G_TYPE_CHECK_CLASS_TYPE ((klass), NCM_TYPE_FIT_NESTED))
+#define NCM_FIT_NESTED_GET_CLASS(obj)   (G_TYPE_INSTANCE_GET_CLASS ((obj), NCM_TYPE_FIT_NESTED, NcmFitNestedClass))
+
+typedef struct _NcmFitNestedClass NcmFitNestedClass;
+typedef struct _NcmFitNested NcmFitNested;
+
+struct _NcmFitNestedClass
+{
+  /*< private >*/
+  GObjectClass parent_class;
+};
+
+struct _NcmFitNested
+{
+  /*< private >*/
+  GObject parent_instance;
+  NcmFit *fit;
+  NcmMSetTransKern *prior;
+  NcmMSetCatalog *mcat;
+  NcmFitRunMsgs mtype;
+  NcmSerialize *ser;
+  NcmMemoryPool *fit_pool;
+  NcmTimer *nt;
+  guint fparam_len;
+  guint nlive;
+  guint nreplace;
+  guint nsteps;
+  guint max_iter;
+  guint nthreads;
+  gdouble dlnZ;
+  gdouble scale;
+  GPtrArray *live;
+  NcmVector *live_m2lnL;
+  NcmMatrix *chol;
+  NcmVector *mean;
+  GPtrArray *new_points;
+  NcmVector *new_m2lnL;
+  GArray *order;
+  GArray *start;
+  GArray *naccepted;
+  GArray *nevals;
+  GPtrArray *rngs;
+  GArray *dead;
+  gdouble m2lnL_star;
+  gdouble lnX;
+  gdouble lnZ;
+  gdouble H;
+  guint niter;
+  gulong neval;
+  gulong ntry;
+  gulong naccept;
+  gboolean started;
+  gboolean finished;
+  GMutex dup_fit;
+  GMutex prior_lock;
+};
+
+GType ncm_fit_nested_get_type (void) G_GNUC_CONST;
+
+NcmFitNested *ncm_fit_nested_new (NcmFit *fit, NcmMSetTransKern *prior, guint nlive, NcmFitRunMsgs mtype);
+NcmFitNested *ncm_fit_nested_ref (NcmFitNested *nested);
+void ncm_fit_nested_free (NcmFitNested *nested);
+void ncm_fit_nested_clear (NcmFitNested **nested);
+
+void ncm_fit_nested_set_data_file (NcmFitNested *nested, const gchar *filename);
+void ncm_fit_nested_set_mtype (NcmFitNested *nested, NcmFitRunMsgs mtype);
+void ncm_fit_nested_set_rng (NcmFitNested *nested, NcmRNG *rng);
+void ncm_fit_nested_set_nreplace (NcmFitNested *nested, guint nreplace);
+void ncm_fit_nested_set_nsteps (NcmFitNested *nested, guint nsteps);
+void ncm_fit_nested_set_max_iter (NcmFitNested *nested, guint max_iter);
+void ncm_fit_nested_set_nthreads (NcmFitNested *nested, guint nthreads);
+void ncm_fit_nested_set_dlnZ (NcmFitNested *nested, gdouble dlnZ);
+
+void ncm_fit_nested_start_run (NcmFitNested *nested);
+void ncm_fit_nested_run (NcmFitNested *nested);
+void ncm_fit_nested_end_run (NcmFitNested *nested);
+
+void ncm_fit_nested_get_evidence (NcmFitNested *nested, gdouble *lnZ, gdouble *lnZ_err);
+gdouble ncm_fit_nested_get_information (NcmFitNested *nested);
+gdouble ncm_fit_nested_get_ess (NcmFitNested *nested);
+gdouble ncm_fit_nested_get_accept_ratio (NcmFitNested *nested);
+gulong ncm_fit_nested_get_neval (NcmFitNested *nested);
+
+NcmMSetCatalog *ncm_fit_nested_get_catalog (NcmFitNested *nested);
+
+G_END_DECLS
+
+#endif /* _NCM_FIT_NESTED_H_ */
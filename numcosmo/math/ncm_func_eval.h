@@ -32,6 +32,7 @@ G_BEGIN_DECLS
 
 typedef void (*NcmFuncEvalLoop) (glong i, glong f, gpointer data);
 
+GThreadPool *ncm_func_eval_get_pool (void);
 void ncm_func_eval_set_max_threads (gint mt);
 void ncm_func_eval_threaded_loop_nw (NcmFuncEvalLoop lfunc, glong i, glong f, gpointer data, guint nworkers);
 void ncm_func_eval_threaded_loop (NcmFuncEvalLoop lfunc, glong i, glong f, gpointer data);
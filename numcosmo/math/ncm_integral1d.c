@@ -42,6 +42,7 @@
 #include "math/ncm_integral1d.h"
 #include "math/ncm_c.h"
 #include "math/ncm_cfg.h"
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_cdf.h>
 #include <gsl/gsl_integration.h>
 #include <gsl/gsl_errno.h>
@@ -446,6 +447,312 @@ ncm_integral1d_eval (NcmIntegral1d *int1d, const gdouble xi, const gdouble xf, g
   return result;
 }
 
+/*
+ * 21 points Gauss-Kronrod rule, the abscissas and weights are the same
+ * used by QUADPACK (and gsl_integration_qk21). The Gauss nodes are the
+ * odd entries of _ncm_integral1d_xgk.
+ */
+#define _NCM_INTEGRAL1D_VEC_NGK 21
+static const gdouble _ncm_integral1d_xgk[11] =
+{
+  0.995657163025808080735527280689003,
+  0.973906528517171720077964012084452,
+  0.930157491355708226001207180059508,
+  0.865063366688984510732096688423493,
+  0.780817726586416897063717578345042,
+  0.679409568299024406234327365114874,
+  0.562757134668604683339000099272694,
+  0.433395394129247190799265943165784,
+  0.294392862701460198131126603103866,
+  0.148874338981631210884826001129720,
+  0.000000000000000000000000000000000
+};
+
+static const gdouble _ncm_integral1d_wg[5] =
+{
+  0.066671344308688137593568809893332,
+  0.149451349150580593145776339657697,
+  0.219086362515982043995534934228163,
+  0.269266719309996355091226921569469,
+  0.295524224714752870173892994651338
+};
+
+static const gdouble _ncm_integral1d_wgk[11] =
+{
+  0.011694638867371874278064396062192,
+  0.032558162307964727478818972459390,
+  0.054755896574351996031381300244580,
+  0.075039674810919952767043140916190,
+  0.093125454583697605535065465083366,
+  0.109387158802297641899210590325805,
+  0.123491976262065851077208746882693,
+  0.134709217311473325928054001771707,
+  0.142775938577060080797094273138717,
+  0.147739104901338491374841515972068,
+  0.149445554002916905664936468389821
+};
+
+static void
+_ncm_integral1d_vec_nodes (const gdouble a, const gdouble b, gdouble *x)
+{
+  const gdouble center = 0.5 * (a + b);
+  const gdouble hlength = 0.5 * (b - a);
+  guint j;
+
+  for (j = 0; j < 10; j++)
+  {
+    x[2 * j]     = center - hlength * _ncm_integral1d_xgk[j];
+    x[2 * j + 1] = center + hlength * _ncm_integral1d_xgk[j];
+  }
+  x[20] = center;
+}
+
+static gdouble
+_ncm_integral1d_vec_rescale_error (gdouble err, const gdouble resabs, const gdouble resasc)
+{
+  err = fabs (err);
+
+  if ((resasc != 0.0) && (err != 0.0))
+  {
+    const gdouble scale = pow ((200.0 * err / resasc), 1.5);
+    err = (scale < 1.0) ? resasc * scale : resasc;
+  }
+
+  if (resabs > GSL_DBL_MIN / (50.0 * GSL_DBL_EPSILON))
+  {
+    const gdouble min_err = 50.0 * GSL_DBL_EPSILON * resabs;
+    err = GSL_MAX (err, min_err);
+  }
+
+  return err;
+}
+
+/*
+ * Applies the 21 points rule to all components using the integrand
+ * values fval computed at the nodes given by _ncm_integral1d_vec_nodes.
+ */
+static void
+_ncm_integral1d_vec_qk21 (const gdouble a, const gdouble b, const guint dim, const gdouble *fval, gdouble *res, gdouble *err)
+{
+  const gdouble hlength  = 0.5 * (b - a);
+  const gdouble abs_hlen = fabs (hlength);
+  guint k;
+
+  for (k = 0; k < dim; k++)
+  {
+    const gdouble fc = fval[20 * dim + k];
+    gdouble result_gauss   = 0.0;
+    gdouble result_kronrod = fc * _ncm_integral1d_wgk[10];
+    gdouble result_abs     = fabs (result_kronrod);
+    gdouble result_asc, mean;
+    guint j;
+
+    for (j = 0; j < 10; j++)
+    {
+      const gdouble f1 = fval[(2 * j) * dim + k];
+      const gdouble f2 = fval[(2 * j + 1) * dim + k];
+
+      if (j & 1)
+        result_gauss += _ncm_integral1d_wg[j / 2] * (f1 + f2);
+      result_kronrod += _ncm_integral1d_wgk[j] * (f1 + f2);
+      result_abs     += _ncm_integral1d_wgk[j] * (fabs (f1) + fabs (f2));
+    }
+
+    mean       = 0.5 * result_kronrod;
+    result_asc = _ncm_integral1d_wgk[10] * fabs (fc - mean);
+    for (j = 0; j < 10; j++)
+      result_asc += _ncm_integral1d_wgk[j] * (fabs (fval[(2 * j) * dim + k] - mean) + fabs (fval[(2 * j + 1) * dim + k] - mean));
+
+    res[k] = result_kronrod * hlength;
+    err[k] = _ncm_integral1d_vec_rescale_error ((result_kronrod - result_gauss) * hlength, result_abs * abs_hlen, result_asc * abs_hlen);
+  }
+}
+
+/*
+ * A component is converged when its error is within the tolerance. An
+ * identically zero component (zero result and zero error) is always
+ * converged, even when abstol is zero.
+ */
+static gboolean
+_ncm_integral1d_vec_converged (NcmIntegral1d *int1d, const gdouble res, const gdouble err)
+{
+  if ((res == 0.0) && (err == 0.0))
+    return TRUE;
+  else
+  {
+    const gdouble tol = GSL_MAX (int1d->priv->abstol, int1d->priv->reltol * fabs (res));
+    return (err <= tol);
+  }
+}
+
+typedef struct _NcmIntegral1dVecInterval
+{
+  gdouble a;
+  gdouble b;
+  gdouble *res;
+  gdouble *err;
+} NcmIntegral1dVecInterval;
+
+/**
+ * ncm_integral1d_eval_vec:
+ * @int1d: a #NcmIntegral1d
+ * @xi: inferior integration limit $x_i$
+ * @xf: superior integration limit $x_f$
+ * @result: a #NcmVector
+ * @err: a #NcmVector
+ *
+ * Evaluates the family of integrals $I_{F_k}(x_i, x_f) = \int_{x_i}^{x_f}F_k(x)\mathrm{d}x$,
+ * for $k = 0, \dots, N-1$ where $N$ is the length of @result. The integrand must
+ * implement the vector interface #NcmIntegral1dVecF, which computes all $N$
+ * components at a batch of nodes at once, e.g., see ncm_integral1d_ptr_new_vec().
+ *
+ * All components share the same adaptive subdivision. In each step the interval
+ * where the worst component, relative to its own tolerance, has the largest error
+ * is bisected and the nodes of both halves are evaluated in a single batch. The
+ * integration stops when every component satisfies the absolute or the relative
+ * tolerance, components that are identically zero are considered converged even
+ * when the absolute tolerance is zero. Hence, a family of integrals costs about the same as the hardest
+ * one instead of $N$ separated integrations.
+ *
+ */
+void
+ncm_integral1d_eval_vec (NcmIntegral1d *int1d, const gdouble xi, const gdouble xf, NcmVector *result, NcmVector *err)
+{
+  const guint dim = ncm_vector_len (result);
+  GArray *ivals   = g_array_new (FALSE, FALSE, sizeof (NcmIntegral1dVecInterval));
+  gdouble *x      = g_new (gdouble, 2 * _NCM_INTEGRAL1D_VEC_NGK);
+  gdouble *fval   = g_new (gdouble, 2 * _NCM_INTEGRAL1D_VEC_NGK * dim);
+  gdouble *tot    = g_new0 (gdouble, dim);
+  gdouble *tot_e  = g_new0 (gdouble, dim);
+  guint k, l;
+
+  if (NCM_INTEGRAL1D_GET_CLASS (int1d)->integrand_vec == NULL)
+    g_error ("ncm_integral1d_eval_vec: object `%s' does not implement the vector integrand.", G_OBJECT_TYPE_NAME (int1d));
+
+  g_assert_cmpuint (dim, >, 0);
+  g_assert_cmpuint (ncm_vector_len (err), ==, dim);
+
+  {
+    NcmIntegral1dVecInterval ival = {xi, xf, g_new (gdouble, dim), g_new (gdouble, dim)};
+
+    _ncm_integral1d_vec_nodes (xi, xf, x);
+    ncm_integral1d_integrand_vec (int1d, x, _NCM_INTEGRAL1D_VEC_NGK, dim, fval);
+    _ncm_integral1d_vec_qk21 (xi, xf, dim, fval, ival.res, ival.err);
+
+    for (k = 0; k < dim; k++)
+    {
+      tot[k]   = ival.res[k];
+      tot_e[k] = ival.err[k];
+    }
+
+    g_array_append_val (ivals, ival);
+  }
+
+  while (TRUE)
+  {
+    gdouble worst   = 0.0;
+    guint worst_i   = 0;
+    gboolean done   = TRUE;
+
+    for (k = 0; k < dim; k++)
+    {
+      if (!_ncm_integral1d_vec_converged (int1d, tot[k], tot_e[k]))
+      {
+        done = FALSE;
+        break;
+      }
+    }
+
+    if (done)
+      break;
+
+    if (ivals->len >= int1d->priv->partition)
+      g_error ("ncm_integral1d_eval_vec: maximum number of subdivisions reached (%u).", int1d->priv->partition);
+
+    for (l = 0; l < ivals->len; l++)
+    {
+      NcmIntegral1dVecInterval *ival = &g_array_index (ivals, NcmIntegral1dVecInterval, l);
+      gdouble ival_worst = 0.0;
+
+      for (k = 0; k < dim; k++)
+      {
+        const gdouble tol = GSL_MAX (int1d->priv->abstol, int1d->priv->reltol * fabs (tot[k]));
+        const gdouble r   = (tol > 0.0) ? ival->err[k] / tol : ival->err[k];
+
+        ival_worst = GSL_MAX (ival_worst, r);
+      }
+
+      if (ival_worst > worst)
+      {
+        worst   = ival_worst;
+        worst_i = l;
+      }
+    }
+
+    {
+      NcmIntegral1dVecInterval *ival = &g_array_index (ivals, NcmIntegral1dVecInterval, worst_i);
+      const gdouble a  = ival->a;
+      const gdouble b  = ival->b;
+      const gdouble m  = 0.5 * (a + b);
+      NcmIntegral1dVecInterval ival_u = {m, b, g_new (gdouble, dim), g_new (gdouble, dim)};
+
+      if ((m <= a) || (m >= b))
+        g_error ("ncm_integral1d_eval_vec: interval [% 22.15g, % 22.15g] cannot be bisected.", a, b);
+
+      _ncm_integral1d_vec_nodes (a, m, x);
+      _ncm_integral1d_vec_nodes (m, b, &x[_NCM_INTEGRAL1D_VEC_NGK]);
+      ncm_integral1d_integrand_vec (int1d, x, 2 * _NCM_INTEGRAL1D_VEC_NGK, dim, fval);
+
+      for (k = 0; k < dim; k++)
+      {
+        tot[k]   -= ival->res[k];
+        tot_e[k] -= ival->err[k];
+      }
+
+      ival->b = m;
+      _ncm_integral1d_vec_qk21 (a, m, dim, fval, ival->res, ival->err);
+      _ncm_integral1d_vec_qk21 (m, b, dim, &fval[_NCM_INTEGRAL1D_VEC_NGK * dim], ival_u.res, ival_u.err);
+
+      for (k = 0; k < dim; k++)
+      {
+        tot[k]   += ival->res[k] + ival_u.res[k];
+        tot_e[k] += ival->err[k] + ival_u.err[k];
+      }
+
+      g_array_append_val (ivals, ival_u);
+    }
+  }
+
+  /* Sums again to avoid the accumulated cancellation in the running totals. */
+  for (k = 0; k < dim; k++)
+  {
+    gdouble sum = 0.0, sum_e = 0.0;
+
+    for (l = 0; l < ivals->len; l++)
+    {
+      NcmIntegral1dVecInterval *ival = &g_array_index (ivals, NcmIntegral1dVecInterval, l);
+      sum   += ival->res[k];
+      sum_e += ival->err[k];
+    }
+
+    ncm_vector_set (result, k, sum);
+    ncm_vector_set (err, k, sum_e);
+  }
+
+  for (l = 0; l < ivals->len; l++)
+  {
+    NcmIntegral1dVecInterval *ival = &g_array_index (ivals, NcmIntegral1dVecInterval, l);
+    g_free (ival->res);
+    g_free (ival->err);
+  }
+
+  g_array_unref (ivals);
+  g_free (x);
+  g_free (fval);
+  g_free (tot);
+  g_free (tot_e);
+}
+
 /**
  * ncm_integral1d_eval_gauss_hermite_p:
  * @int1d: a #NcmIntegral1d
@@ -29,6 +29,7 @@
 #include <glib.h>
 #include <glib-object.h>
 #include <numcosmo/build_cfg.h>
+#include <numcosmo/math/ncm_vector.h>
 
 G_BEGIN_DECLS
 
@@ -44,13 +45,15 @@ typedef struct _NcmIntegral1d NcmIntegral1d;
 typedef struct _NcmIntegral1dPrivate NcmIntegral1dPrivate;
 
 typedef gdouble (*NcmIntegral1dF) (NcmIntegral1d *int1d, const gdouble x, const gdouble w);
+typedef void (*NcmIntegral1dVecF) (NcmIntegral1d *int1d, const gdouble *x, const guint len, const guint dim, gdouble *fval);
 
 struct _NcmIntegral1dClass
 {
   /*< private >*/
   GObjectClass parent_class;
   NcmIntegral1dF integrand;
-  gpointer padding[9];
+  NcmIntegral1dVecF integrand_vec;
+  gpointer padding[8];
 };
 
 struct _NcmIntegral1d
@@ -77,8 +80,10 @@ gdouble ncm_integral1d_get_reltol (NcmIntegral1d *int1d);
 gdouble ncm_integral1d_get_abstol (NcmIntegral1d *int1d);
 
 G_INLINE_FUNC gdouble ncm_integral1d_integrand (NcmIntegral1d *int1d, const gdouble x, const gdouble w);
+G_INLINE_FUNC void ncm_integral1d_integrand_vec (NcmIntegral1d *int1d, const gdouble *x, const guint len, const guint dim, gdouble *fval);
 
 gdouble ncm_integral1d_eval (NcmIntegral1d *int1d, const gdouble xi, const gdouble xf, gdouble *err);
+void ncm_integral1d_eval_vec (NcmIntegral1d *int1d, const gdouble xi, const gdouble xf, NcmVector *result, NcmVector *err);
 gdouble ncm_integral1d_eval_gauss_hermite_p (NcmIntegral1d *int1d, gdouble *err);
 gdouble ncm_integral1d_eval_gauss_hermite (NcmIntegral1d *int1d, gdouble *err);
 gdouble ncm_integral1d_eval_gauss_hermite_r_p (NcmIntegral1d *int1d, const gdouble r, gdouble *err);
@@ -108,6 +113,12 @@ ncm_integral1d_integrand (NcmIntegral1d *int1d, const gdouble x, const gdouble w
   return NCM_INTEGRAL1D_GET_CLASS (int1d)->integrand (int1d, x, w);  
 }
 
+G_INLINE_FUNC void
+ncm_integral1d_integrand_vec (NcmIntegral1d *int1d, const gdouble *x, const guint len, const guint dim, gdouble *fval)
+{
+  NCM_INTEGRAL1D_GET_CLASS (int1d)->integrand_vec (int1d, x, len, dim, fval);
+}
+
 G_END_DECLS
 
 #endif /* NUMCOSMO_HAVE_INLINE */
@@ -44,6 +44,7 @@
 struct _NcmIntegral1dPtrPrivate
 {
    NcmIntegral1dF F;
+   NcmIntegral1dPtrVecF Fvec;
    gpointer userdata;
    GDestroyNotify userfree;
 };
@@ -52,6 +53,7 @@ enum
 {
   PROP_0,
   PROP_INTEGRAND,
+  PROP_INTEGRAND_VEC,
   PROP_USERDATA,
   PROP_USERFREE,
 };
@@ -63,6 +65,7 @@ ncm_integral1d_ptr_init (NcmIntegral1dPtr *int1d_ptr)
 {
   int1d_ptr->priv            = G_TYPE_INSTANCE_GET_PRIVATE (int1d_ptr, NCM_TYPE_INTEGRAL1D_PTR, NcmIntegral1dPtrPrivate);
   int1d_ptr->priv->F         = NULL;
+  int1d_ptr->priv->Fvec      = NULL;
   int1d_ptr->priv->userdata  = NULL;
   int1d_ptr->priv->userfree = NULL;
 }
@@ -78,6 +81,9 @@ _ncm_integral1d_ptr_set_property (GObject *object, guint prop_id, const GValue *
     case PROP_INTEGRAND:
       int1d_ptr->priv->F = g_value_get_pointer (value);
       break;
+    case PROP_INTEGRAND_VEC:
+      int1d_ptr->priv->Fvec = g_value_get_pointer (value);
+      break;
     case PROP_USERDATA:
       ncm_integral1d_ptr_set_userdata (int1d_ptr, g_value_get_pointer (value));
       break;
@@ -101,6 +107,9 @@ _ncm_integral1d_ptr_get_property (GObject *object, guint prop_id, GValue *value,
     case PROP_INTEGRAND:
       g_value_set_pointer (value, int1d_ptr->priv->F);
       break;
+    case PROP_INTEGRAND_VEC:
+      g_value_set_pointer (value, int1d_ptr->priv->Fvec);
+      break;
     case PROP_USERDATA:
       g_value_set_pointer (value, int1d_ptr->priv->userdata);
       break;
@@ -122,6 +131,7 @@ _ncm_integral1d_ptr_finalize (GObject *object)
 }
 
 static gdouble _ncm_integral1d_ptr_integrand (NcmIntegral1d *int1d, const gdouble x, const gdouble w);
+static void _ncm_integral1d_ptr_integrand_vec (NcmIntegral1d *int1d, const gdouble *x, const guint len, const guint dim, gdouble *fval);
 
 static void
 ncm_integral1d_ptr_class_init (NcmIntegral1dPtrClass *klass)
@@ -141,6 +151,12 @@ ncm_integral1d_ptr_class_init (NcmIntegral1dPtrClass *klass)
                                                          NULL,
                                                          "Integrand function pointer",
                                                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_INTEGRAND_VEC,
+                                   g_param_spec_pointer ("integrand-vec",
+                                                         NULL,
+                                                         "Vector integrand function pointer",
+                                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
   g_object_class_install_property (object_class,
                                    PROP_USERDATA,
                                    g_param_spec_pointer ("userdata",
@@ -154,7 +170,8 @@ ncm_integral1d_ptr_class_init (NcmIntegral1dPtrClass *klass)
                                                          "Integrand function user data free function",
                                                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
 
-  int1d_class->integrand = &_ncm_integral1d_ptr_integrand;
+  int1d_class->integrand     = &_ncm_integral1d_ptr_integrand;
+  int1d_class->integrand_vec = &_ncm_integral1d_ptr_integrand_vec;
 }
 
 static gdouble 
@@ -164,6 +181,17 @@ _ncm_integral1d_ptr_integrand (NcmIntegral1d *int1d, const gdouble x, const gdou
   return int1d_ptr->priv->F (int1d_ptr->priv->userdata, x, w);
 }
 
+static void 
+_ncm_integral1d_ptr_integrand_vec (NcmIntegral1d *int1d, const gdouble *x, const guint len, const guint dim, gdouble *fval)
+{
+  NcmIntegral1dPtr *int1d_ptr = NCM_INTEGRAL1D_PTR (int1d);
+
+  if (int1d_ptr->priv->Fvec == NULL)
+    g_error ("_ncm_integral1d_ptr_integrand_vec: vector integrand not set, see ncm_integral1d_ptr_new_vec().");
+
+  int1d_ptr->priv->Fvec (int1d_ptr->priv->userdata, x, len, dim, fval);
+}
+
 /**
  * ncm_integral1d_ptr_new:
  * @F: (scope notified): a #NcmIntegral1dPtrF
@@ -183,6 +211,28 @@ ncm_integral1d_ptr_new (NcmIntegral1dPtrF F, GDestroyNotify userfree)
   return int1d_ptr;
 }
 
+/**
+ * ncm_integral1d_ptr_new_vec:
+ * @Fvec: (scope notified): a #NcmIntegral1dPtrVecF
+ * @userfree: (scope notified): #GDestroyNotify 
+ * 
+ * Creates a new #NcmIntegral1dPtr object for the vector integrand @Fvec,
+ * see ncm_integral1d_eval_vec(). The function @Fvec must fill the 
+ * row-major array fval with the dim components at each of the len
+ * nodes x.
+ * 
+ * Returns: (transfer full): the new #NcmIntegral1dPtr object. 
+ */
+NcmIntegral1dPtr *
+ncm_integral1d_ptr_new_vec (NcmIntegral1dPtrVecF Fvec, GDestroyNotify userfree)
+{
+  NcmIntegral1dPtr *int1d_ptr = g_object_new (NCM_TYPE_INTEGRAL1D_PTR,
+                                              "integrand-vec", Fvec,
+                                              "userfree",      userfree,
+                                              NULL);
+  return int1d_ptr;
+}
+
 /**
  * ncm_integral1d_ptr_new_full:
  * @F: (scope notified): a #NcmIntegral1dPtrF
@@ -44,6 +44,7 @@ typedef struct _NcmIntegral1dPtrClass NcmIntegral1dPtrClass;
 typedef struct _NcmIntegral1dPtr NcmIntegral1dPtr;
 typedef struct _NcmIntegral1dPtrPrivate NcmIntegral1dPtrPrivate;
 typedef gdouble (*NcmIntegral1dPtrF) (gpointer userdata, const gdouble x, const gdouble w);
+typedef void (*NcmIntegral1dPtrVecF) (gpointer userdata, const gdouble *x, const guint len, const guint dim, gdouble *fval);
 
 struct _NcmIntegral1dPtrClass
 {
@@ -61,6 +62,7 @@ struct _NcmIntegral1dPtr
 GType ncm_integral1d_ptr_get_type (void) G_GNUC_CONST;
 
 NcmIntegral1dPtr *ncm_integral1d_ptr_new (NcmIntegral1dPtrF F, GDestroyNotify userfree);
+NcmIntegral1dPtr *ncm_integral1d_ptr_new_vec (NcmIntegral1dPtrVecF Fvec, GDestroyNotify userfree);
 NcmIntegral1dPtr *ncm_integral1d_ptr_new_full (NcmIntegral1dPtrF F, GDestroyNotify userfree, const gdouble reltol, const gdouble abstol, const guint partition, const guint rule);
 
 NcmIntegral1dPtr *ncm_integral1d_ptr_ref (NcmIntegral1dPtr *int1d_ptr);
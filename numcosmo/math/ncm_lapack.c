@@ -167,7 +167,7 @@ ncm_lapack_dpotrf (gchar uplo, guint size, gdouble *a, guint lda)
 #elif defined (HAVE_CLAPACK) && defined (NUMCOSMO_PREFER_LAPACKE)
   gint ret = clapack_dpotrf (CblasRowMajor, 
                              uplo == 'U' ? CblasUpper : CblasLower, 
-                             size, a, size);
+                             size, a, lda);
   if (ret < 0)
     g_error ("ncm_lapack_dpotrf: invalid parameter %d", -ret);
   else if (ret > 0)
@@ -217,7 +217,7 @@ ncm_lapack_dpotri (gchar uplo, guint size, gdouble *a, guint lda)
 #elif defined (HAVE_CLAPACK) && defined (NUMCOSMO_PREFER_LAPACKE)
   gint ret = clapack_dpotri (CblasRowMajor, 
                              uplo == 'U' ? CblasUpper : CblasLower, 
-                             size, a, size);
+                             size, a, lda);
   if (ret < 0)
     g_error ("ncm_lapack_dpotrf: invalid parameter %d", -ret);
   else if (ret > 0)
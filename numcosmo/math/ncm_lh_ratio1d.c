@@ -41,7 +41,10 @@
 
 #include "math/ncm_c.h"
 #include "math/ncm_cfg.h"
+#include "math/ncm_profiler.h"
 #include "math/ncm_util.h"
+#include "math/ncm_func_eval.h"
+#include "math/ncm_serialize.h"
 
 #include <gsl/gsl_cdf.h>
 #include <gsl/gsl_roots.h>
@@ -53,6 +56,7 @@ enum
   PROP_FIT,
   PROP_PI,
   PROP_CONSTRAINT,
+  PROP_NTHREADS,
   PROP_SIZE,
 };
 
@@ -73,8 +77,10 @@ ncm_lh_ratio1d_init (NcmLHRatio1d *lhr1d)
   lhr1d->niter       = 0;
   lhr1d->func_eval   = 0;
   lhr1d->grad_eval   = 0;
+  lhr1d->nthreads    = 0;
   lhr1d->mtype       = NCM_FIT_RUN_MSGS_NONE;
   lhr1d->rtype       = NCM_LH_RATIO1D_ROOT_BRACKET;
+  lhr1d->log_dot     = FALSE;
 }
 
 static void
@@ -134,6 +140,9 @@ ncm_lh_ratio1d_set_property (GObject *object, guint prop_id, const GValue *value
     case PROP_CONSTRAINT:
       lhr1d->constraint = g_value_dup_object (value);
       break;
+    case PROP_NTHREADS:
+      ncm_lh_ratio1d_set_nthreads (lhr1d, g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -160,6 +169,9 @@ ncm_lh_ratio1d_get_property (GObject *object, guint prop_id, GValue *value, GPar
     case PROP_CONSTRAINT:
       g_value_set_object (value, lhr1d->constraint);
       break;
+    case PROP_NTHREADS:
+      g_value_set_uint (value, lhr1d->nthreads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -220,6 +232,13 @@ ncm_lh_ratio1d_class_init (NcmLHRatio1dClass *klass)
                                                         "Constraint",
                                                         NCM_TYPE_MSET_FUNC,
                                                         G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_NTHREADS,
+                                   g_param_spec_uint ("nthreads",
+                                                      NULL,
+                                                      "Number of threads to run",
+                                                      0, G_MAXUINT32, 0,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
 }
 
 
@@ -295,7 +314,45 @@ ncm_lh_ratio1d_set_pindex (NcmLHRatio1d *lhr1d, NcmMSetPIndex *pi)
   lhr1d->bf = ncm_mset_param_get (lhr1d->fit->mset, pi->mid, pi->pid);
 }
 
-static gboolean _ncm_lh_ratio1d_log_dot = FALSE;
+/**
+ * ncm_lh_ratio1d_set_nthreads:
+ * @lhr1d: a #NcmLHRatio1d
+ * @nthreads: number of threads
+ *
+ * Sets the number of threads, when larger than one the lower and upper
+ * bounds are searched at the same time using the #NcmFunc thread pool,
+ * each one using its own copy of the constrained #NcmFit.
+ *
+ */
+void
+ncm_lh_ratio1d_set_nthreads (NcmLHRatio1d *lhr1d, guint nthreads)
+{
+  lhr1d->nthreads = nthreads;
+}
+
+/**
+ * ncm_lh_ratio1d_get_nthreads:
+ * @lhr1d: a #NcmLHRatio1d
+ *
+ * Returns: the number of threads used by ncm_lh_ratio1d_find_bounds().
+ */
+guint
+ncm_lh_ratio1d_get_nthreads (NcmLHRatio1d *lhr1d)
+{
+  return lhr1d->nthreads;
+}
+
+typedef struct _NcmLHRatio1dSide
+{
+  NcmLHRatio1d *lhr1d;
+  NcmFit *constrained;
+  NcmFitRunMsgs mtype;
+  gdouble r;
+  gdouble bound;
+  guint niter;
+  guint func_eval;
+  guint grad_eval;
+} NcmLHRatio1dSide;
 
 static void
 ncm_lh_ratio1d_log_start (NcmLHRatio1d *lhr1d, gdouble clevel)
@@ -308,76 +365,76 @@ ncm_lh_ratio1d_log_start (NcmLHRatio1d *lhr1d, gdouble clevel)
     if (lhr1d->mtype == NCM_FIT_RUN_MSGS_SIMPLE)
     {
       g_message ("#");
-      _ncm_lh_ratio1d_log_dot = TRUE;
+      lhr1d->log_dot = TRUE;
     }
   }
 }
 
 static void
-ncm_lh_ratio1d_log_param_val (NcmLHRatio1d *lhr1d, gdouble p, gdouble val)
+ncm_lh_ratio1d_log_param_val (NcmLHRatio1dSide *side, gdouble p, gdouble val)
 {
-  if (lhr1d->mtype > NCM_FIT_RUN_MSGS_NONE)
+  if (side->mtype > NCM_FIT_RUN_MSGS_NONE)
   {
-    if (lhr1d->mtype == NCM_FIT_RUN_MSGS_SIMPLE)
+    if (side->mtype == NCM_FIT_RUN_MSGS_SIMPLE)
     {
-      if (!_ncm_lh_ratio1d_log_dot)
+      if (!side->lhr1d->log_dot)
       {
         g_message ("#");
-        _ncm_lh_ratio1d_log_dot = TRUE;
+        side->lhr1d->log_dot = TRUE;
       }
       g_message (".");
     }
     else
       g_message ("#  parameter % 12.8g likelihood ratio % 12.8g.\n", 
-                 lhr1d->bf + p, val);
+                 side->lhr1d->bf + p, val);
   }
 }
 
 static void
-ncm_lh_ratio1d_log_root_start (NcmLHRatio1d *lhr1d, gdouble pl, gdouble pu)
+ncm_lh_ratio1d_log_root_start (NcmLHRatio1dSide *side, gdouble pl, gdouble pu)
 {
-  if (lhr1d->mtype > NCM_FIT_RUN_MSGS_NONE)
+  if (side->mtype > NCM_FIT_RUN_MSGS_NONE)
   {
-    if (_ncm_lh_ratio1d_log_dot)
+    if (side->lhr1d->log_dot)
     {
       g_message ("\n");
-      _ncm_lh_ratio1d_log_dot = FALSE;
+      side->lhr1d->log_dot = FALSE;
     }
     g_message ("#  looking for a root in interval [% 12.8g % 12.8g]:\n", 
-               lhr1d->bf + pl, lhr1d->bf + pu);
-    if (lhr1d->mtype == NCM_FIT_RUN_MSGS_SIMPLE)
+               side->lhr1d->bf + pl, side->lhr1d->bf + pu);
+    if (side->mtype == NCM_FIT_RUN_MSGS_SIMPLE)
     {
       g_message ("#");
-      _ncm_lh_ratio1d_log_dot = TRUE;
+      side->lhr1d->log_dot = TRUE;
     }
   }
 }
 
 static void
-ncm_lh_ratio1d_log_root_step (NcmLHRatio1d *lhr1d, gdouble pl, gdouble pu)
+ncm_lh_ratio1d_log_root_step (NcmLHRatio1dSide *side, gdouble pl, gdouble pu)
 {
-  if (lhr1d->mtype > NCM_FIT_RUN_MSGS_NONE)
+  if (side->mtype > NCM_FIT_RUN_MSGS_NONE)
   {
-    if (lhr1d->mtype == NCM_FIT_RUN_MSGS_SIMPLE)
+    if (side->mtype == NCM_FIT_RUN_MSGS_SIMPLE)
       g_message (".");
     else
       g_message ("#  parameter root bounds [% 12.8g % 12.8g].\n", 
-                 lhr1d->bf + pl, lhr1d->bf + pu);
+                 side->lhr1d->bf + pl, side->lhr1d->bf + pu);
   }
 }
 
 static void
-ncm_lh_ratio1d_log_root_finish (NcmLHRatio1d *lhr1d, gdouble pr, gdouble prec)
+ncm_lh_ratio1d_log_root_finish (NcmLHRatio1dSide *side, gdouble pr, gdouble prec)
 {
-  if (lhr1d->mtype > NCM_FIT_RUN_MSGS_NONE)
+  if (side->mtype > NCM_FIT_RUN_MSGS_NONE)
   {
-    if (_ncm_lh_ratio1d_log_dot)
+    if (side->lhr1d->log_dot)
     {
       g_message ("\n");
-      _ncm_lh_ratio1d_log_dot = FALSE;
+      side->lhr1d->log_dot = FALSE;
     }
     g_message ("#  root found at % 12.8g with precision %1.8e.\n", 
-               lhr1d->bf + pr, prec);
+               side->lhr1d->bf + pr, prec);
   }  
 }
 
@@ -386,10 +443,10 @@ ncm_lh_ratio1d_log_finish (NcmLHRatio1d *lhr1d, gdouble pl, gdouble pu)
 {
   if (lhr1d->mtype > NCM_FIT_RUN_MSGS_NONE)
   {
-    if (_ncm_lh_ratio1d_log_dot)
+    if (lhr1d->log_dot)
     {
       g_message ("\n");
-      _ncm_lh_ratio1d_log_dot = FALSE;
+      lhr1d->log_dot = FALSE;
     }
     g_message ("#  lower and upper bounds found [% 12.8g % 12.8g].\n", 
                lhr1d->bf + pl, lhr1d->bf + pu);
@@ -403,19 +460,20 @@ ncm_lh_ratio1d_log_finish (NcmLHRatio1d *lhr1d, gdouble pl, gdouble pu)
 static gdouble
 ncm_lh_ratio1d_f (gdouble x, gpointer ptr)
 {
-  NcmLHRatio1d *lhr1d = NCM_LH_RATIO1D (ptr);
+  NcmLHRatio1dSide *side = (NcmLHRatio1dSide *) ptr;
+  NcmLHRatio1d *lhr1d    = side->lhr1d;
   gdouble p = lhr1d->bf + x;
 
   p = GSL_MAX (p, lhr1d->lb);
   p = GSL_MIN (p, lhr1d->ub);
 
-  ncm_mset_param_set (lhr1d->constrained->mset, lhr1d->pi.mid, lhr1d->pi.pid, p);
+  ncm_mset_param_set (side->constrained->mset, lhr1d->pi.mid, lhr1d->pi.pid, p);
 
-  ncm_fit_run (lhr1d->constrained, NCM_FIT_RUN_MSGS_NONE);
+  ncm_fit_run (side->constrained, NCM_FIT_RUN_MSGS_NONE);
 
-  lhr1d->niter     += lhr1d->constrained->fstate->niter;
-  lhr1d->func_eval += lhr1d->constrained->fstate->func_eval;
-  lhr1d->grad_eval += lhr1d->constrained->fstate->grad_eval;
+  side->niter     += side->constrained->fstate->niter;
+  side->func_eval += side->constrained->fstate->func_eval;
+  side->grad_eval += side->constrained->fstate->grad_eval;
 
   if (p == lhr1d->lb)
   {
@@ -429,14 +487,14 @@ ncm_lh_ratio1d_f (gdouble x, gpointer ptr)
   }
 
   {
-    const gdouble m2lnL_const = ncm_fit_state_get_m2lnL_curval (lhr1d->constrained->fstate);
+    const gdouble m2lnL_const = ncm_fit_state_get_m2lnL_curval (side->constrained->fstate);
     const gdouble m2lnL = ncm_fit_state_get_m2lnL_curval (lhr1d->fit->fstate);
     return m2lnL_const - (m2lnL + lhr1d->chisquare);
   }
 }
 
 static gdouble
-ncm_lh_ratio1d_root_brent (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x)
+ncm_lh_ratio1d_root_brent (NcmLHRatio1dSide *side, gdouble x0, gdouble x)
 {
   gint status;
   gint iter = 0, max_iter = 1000000;
@@ -446,13 +504,13 @@ ncm_lh_ratio1d_root_brent (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x)
   gdouble prec = 1e-5, x1 = x;
 
   F.function = &ncm_lh_ratio1d_f;
-  F.params   = lhr1d;
+  F.params   = side;
 
   T = gsl_root_fsolver_brent;
   s = gsl_root_fsolver_alloc (T);
   gsl_root_fsolver_set (s, &F, x0, x1);
 
-  ncm_lh_ratio1d_log_root_start (lhr1d, x0, x);
+  ncm_lh_ratio1d_log_root_start (side, x0, x);
 
   do
   {
@@ -470,9 +528,9 @@ ncm_lh_ratio1d_root_brent (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x)
     x1 = gsl_root_fsolver_x_upper (s);
     status = gsl_root_test_interval (x0, x1, 0, prec);
 
-    ncm_lh_ratio1d_log_root_step (lhr1d, x0, x1);
+    ncm_lh_ratio1d_log_root_step (side, x0, x1);
 
-    if (!gsl_finite (ncm_lh_ratio1d_f (x, lhr1d)))
+    if (!gsl_finite (ncm_lh_ratio1d_f (x, side)))
     {
       g_debug ("Ops");
       x = GSL_NAN;
@@ -482,7 +540,7 @@ ncm_lh_ratio1d_root_brent (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x)
   while (status == GSL_CONTINUE && iter < max_iter);
 
   gsl_root_fsolver_free (s);
-  ncm_lh_ratio1d_log_root_finish (lhr1d, x, prec);
+  ncm_lh_ratio1d_log_root_finish (side, x, prec);
 
   return x;
 }
@@ -490,10 +548,10 @@ ncm_lh_ratio1d_root_brent (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x)
 static gdouble
 ncm_lh_ratio1d_numdiff_df (gdouble x, gpointer p)
 {
-  NcmLHRatio1d *lhr1d = NCM_LH_RATIO1D (p);
+  NcmLHRatio1dSide *side = (NcmLHRatio1dSide *) p;
   gdouble res, err;
 
-  res = ncm_diff_rf_d1_1_to_1 (lhr1d->fit->diff, x, ncm_lh_ratio1d_f, p, &err);
+  res = ncm_diff_rf_d1_1_to_1 (side->constrained->diff, x, ncm_lh_ratio1d_f, p, &err);
 
   return res;
 }
@@ -508,7 +566,7 @@ ncm_lh_ratio1d_numdiff_fdf (gdouble x, gpointer p, gdouble *y, gdouble *dy)
 
 
 static gdouble
-ncm_lh_ratio1d_root_steffenson (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x1)
+ncm_lh_ratio1d_root_steffenson (NcmLHRatio1dSide *side, gdouble x0, gdouble x1)
 {
   gint status;
   gint iter = 0, max_iter = 1000000;
@@ -521,13 +579,13 @@ ncm_lh_ratio1d_root_steffenson (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x1)
   F.f = &ncm_lh_ratio1d_f;
   F.df = &ncm_lh_ratio1d_numdiff_df;
   F.fdf = &ncm_lh_ratio1d_numdiff_fdf;
-  F.params = lhr1d;
+  F.params = side;
 
   T = gsl_root_fdfsolver_steffenson;
   s = gsl_root_fdfsolver_alloc (T);
   gsl_root_fdfsolver_set (s, &F, x);
 
-  ncm_lh_ratio1d_log_root_start (lhr1d, x0, x);
+  ncm_lh_ratio1d_log_root_start (side, x0, x);
   
   do
   {
@@ -545,9 +603,9 @@ ncm_lh_ratio1d_root_steffenson (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x1)
     x = gsl_root_fdfsolver_root (s);
     status = gsl_root_test_delta (x, x0, 0, prec);
 
-    ncm_lh_ratio1d_log_root_step (lhr1d, x, x0);
+    ncm_lh_ratio1d_log_root_step (side, x, x0);
 
-    if (!gsl_finite (ncm_lh_ratio1d_f (x, lhr1d)))
+    if (!gsl_finite (ncm_lh_ratio1d_f (x, side)))
     {
       g_debug ("Ops");
       x = GSL_NAN;
@@ -556,7 +614,7 @@ ncm_lh_ratio1d_root_steffenson (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x1)
   }
   while (status == GSL_CONTINUE && iter < max_iter);
 
-  ncm_lh_ratio1d_log_root_finish (lhr1d, x, prec);
+  ncm_lh_ratio1d_log_root_finish (side, x, prec);
     
   gsl_root_fdfsolver_free (s);
   return x;
@@ -564,6 +622,54 @@ ncm_lh_ratio1d_root_steffenson (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x1)
 
 #define NCM_LH_RATIO1D_SCALE_INCR (1.1)
 
+static void
+_ncm_lh_ratio1d_side_solve (NcmLHRatio1dSide *side)
+{
+  gdouble (*root) (NcmLHRatio1dSide *side, gdouble x0, gdouble x) = NULL;
+  gdouble r = 0.0;
+  gdouble val;
+
+  switch (side->lhr1d->rtype)
+  {
+    case NCM_LH_RATIO1D_ROOT_BRACKET:
+      root = ncm_lh_ratio1d_root_brent;
+      break;
+    case NCM_LH_RATIO1D_ROOT_NUMDIFF:
+      root = ncm_lh_ratio1d_root_steffenson;
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+
+  /*
+   * Each refit starts from the constrained best fit of the previous 
+   * point on the same side, since side->constrained is not reset
+   * between calls.
+   */
+  while ((val = ncm_lh_ratio1d_f (side->r, side)) < 0.0)
+  {
+    ncm_lh_ratio1d_log_param_val (side, side->r, val);
+    r = side->r;
+    side->r *= NCM_LH_RATIO1D_SCALE_INCR;
+  }
+
+  if (side->r < 0.0)
+    side->bound = root (side, side->r, r);
+  else
+    side->bound = root (side, r, side->r);
+}
+
+static void
+_ncm_lh_ratio1d_side_solve_mt (glong i, glong f, gpointer data)
+{
+  NcmLHRatio1dSide *sides = (NcmLHRatio1dSide *) data;
+  glong k;
+
+  for (k = i; k < f; k++)
+    _ncm_lh_ratio1d_side_solve (&sides[k]);
+}
+
 /**
  * ncm_lh_ratio1d_find_bounds:
  * @lhr1d: a #NcmLHRatio1d
@@ -572,14 +678,21 @@ ncm_lh_ratio1d_root_steffenson (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x1)
  * @lb: (out): lower bound
  * @ub: (out): upper bound 
  * 
- * FIXME
+ * Finds the lower and upper bounds of the profile likelihood ratio 
+ * confidence interval. When the number of threads is larger than one
+ * (see ncm_lh_ratio1d_set_nthreads()) both bounds are searched 
+ * at the same time, each one using a duplicate of the constrained 
+ * #NcmFit warm-started from the best fit, in this case only the 
+ * final results are logged.
  * 
  */
 void 
 ncm_lh_ratio1d_find_bounds (NcmLHRatio1d *lhr1d, gdouble clevel, NcmFitRunMsgs mtype, gdouble *lb, gdouble *ub)
 {
-  gdouble scale, r, r_min, r_max, val;
-  static gdouble (*root) (NcmLHRatio1d *lhr1d, gdouble x0, gdouble x);
+  NcmLHRatio1dSide sides[2];
+  gdouble scale, r_min, r_max;
+  const gboolean threaded = (lhr1d->nthreads > 1);
+  gint i;
 
   g_assert_cmpfloat (clevel, >, 0.0);
   g_assert_cmpfloat (clevel, <, 1.0);
@@ -589,8 +702,6 @@ ncm_lh_ratio1d_find_bounds (NcmLHRatio1d *lhr1d, gdouble clevel, NcmFitRunMsgs m
   scale = sqrt (lhr1d->chisquare) * 
     ncm_fit_covar_sd (lhr1d->fit, lhr1d->pi.mid, lhr1d->pi.pid);
 
-  r = 0.0;
-
   r_min = -scale;
   r_max =  scale;
 
@@ -600,43 +711,59 @@ ncm_lh_ratio1d_find_bounds (NcmLHRatio1d *lhr1d, gdouble clevel, NcmFitRunMsgs m
   if ((lhr1d->bf + r_max) > lhr1d->ub)
     r_max = lhr1d->ub - lhr1d->bf;
 
-  switch (lhr1d->rtype)
+  lhr1d->mtype = mtype;
+
+  for (i = 0; i < 2; i++)
   {
-    case NCM_LH_RATIO1D_ROOT_BRACKET:
-      root = ncm_lh_ratio1d_root_brent;
-      break;
-    case NCM_LH_RATIO1D_ROOT_NUMDIFF:
-      root = ncm_lh_ratio1d_root_steffenson;
-      break;
-    default:
-      g_assert_not_reached ();
-      break;
+    sides[i].lhr1d       = lhr1d;
+    sides[i].constrained = NULL;
+    sides[i].mtype       = threaded ? NCM_FIT_RUN_MSGS_NONE : mtype;
+    sides[i].r           = (i == 0) ? r_min : r_max;
+    sides[i].bound       = 0.0;
+    sides[i].niter       = 0;
+    sides[i].func_eval   = 0;
+    sides[i].grad_eval   = 0;
   }
 
-  lhr1d->mtype = mtype;
-
   ncm_lh_ratio1d_log_start (lhr1d, clevel);
-  
-  while ((val = ncm_lh_ratio1d_f (r_min, lhr1d)) < 0.0)
+
+  if (threaded)
   {
-    ncm_lh_ratio1d_log_param_val (lhr1d, r_min, val);
-    r = r_min;
-    r_min *= NCM_LH_RATIO1D_SCALE_INCR;
+    NcmSerialize *ser = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+
+    for (i = 0; i < 2; i++)
+    {
+      sides[i].constrained = ncm_fit_dup (lhr1d->constrained, ser);
+      ncm_mset_param_set_mset (sides[i].constrained->mset, lhr1d->fit->mset);
+      ncm_serialize_reset (ser, TRUE);
+    }
+    ncm_serialize_free (ser);
+
+    ncm_func_eval_threaded_loop_full (&_ncm_lh_ratio1d_side_solve_mt, 0, 2, sides);
+
+    ncm_fit_free (sides[0].constrained);
+    ncm_fit_free (sides[1].constrained);
+  }
+  else
+  {
+    sides[0].constrained = lhr1d->constrained;
+    sides[1].constrained = lhr1d->constrained;
+
+    _ncm_lh_ratio1d_side_solve (&sides[0]);
+    ncm_mset_param_set_mset (lhr1d->constrained->mset, lhr1d->fit->mset);
+    _ncm_lh_ratio1d_side_solve (&sides[1]);
   }
-  r_min = root (lhr1d, r_min, r);
 
-  r = 0.0;
-  while ((val = ncm_lh_ratio1d_f (r_max, lhr1d)) < 0.0)
+  for (i = 0; i < 2; i++)
   {
-    ncm_lh_ratio1d_log_param_val (lhr1d, r_max, val);
-    r = r_max;
-    r_max *= NCM_LH_RATIO1D_SCALE_INCR;
+    lhr1d->niter     += sides[i].niter;
+    lhr1d->func_eval += sides[i].func_eval;
+    lhr1d->grad_eval += sides[i].grad_eval;
   }
-  r_max = root (lhr1d, r, r_max);
 
-  *lb = r_min;
-  *ub = r_max;
+  *lb = sides[0].bound;
+  *ub = sides[1].bound;
 
-  ncm_lh_ratio1d_log_finish (lhr1d, r_min, r_max);
+  ncm_lh_ratio1d_log_finish (lhr1d, sides[0].bound, sides[1].bound);
+  ncm_profiler_report_if_enabled ();
 }
-
@@ -41,8 +41,12 @@
 
 #include "math/ncm_c.h"
 #include "math/ncm_cfg.h"
+#include "math/ncm_profiler.h"
 #include "math/ncm_matrix.h"
 #include "math/ncm_util.h"
+#include "math/ncm_func_eval.h"
+#include "math/ncm_serialize.h"
+#include "math/memory_pool.h"
 
 #include <gsl/gsl_cdf.h>
 #include <gsl/gsl_roots.h>
@@ -56,6 +60,7 @@ enum
   PROP_PI1,
   PROP_PI2,
   PROP_BORDER_PREC,
+  PROP_NTHREADS,
   PROP_SIZE,
 };
 
@@ -83,7 +88,12 @@ ncm_lh_ratio2d_init (NcmLHRatio2d *lhr2d)
   lhr2d->shift[1]    = 0.0;
   lhr2d->border_prec = 0.0;
   lhr2d->angular     = FALSE;
+  lhr2d->nthreads    = 0;
   lhr2d->diff        = ncm_diff_new ();
+  lhr2d->log_dot     = FALSE;
+  lhr2d->border      = g_array_new (FALSE, FALSE, sizeof (NcmLHRatio2dPoint));
+  lhr2d->clevel      = 0.0;
+  g_mutex_init (&lhr2d->update);
 }
 
 static void
@@ -112,6 +122,9 @@ ncm_lh_ratio2d_set_property (GObject *object, guint prop_id, const GValue *value
     case PROP_BORDER_PREC:
       lhr2d->border_prec = g_value_get_double (value);
       break;
+    case PROP_NTHREADS:
+      ncm_lh_ratio2d_set_nthreads (lhr2d, g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -141,6 +154,9 @@ ncm_lh_ratio2d_get_property (GObject *object, guint prop_id, GValue *value, GPar
     case PROP_BORDER_PREC:
       g_value_set_double (value, lhr2d->border_prec);
       break;
+    case PROP_NTHREADS:
+      g_value_set_uint (value, lhr2d->nthreads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -210,6 +226,10 @@ ncm_lh_ratio2d_dispose (GObject *object)
 static void
 ncm_lh_ratio2d_finalize (GObject *object)
 {
+  NcmLHRatio2d *lhr2d = NCM_LH_RATIO2D (object);
+
+  g_array_unref (lhr2d->border);
+  g_mutex_clear (&lhr2d->update);
 
   /* Chain up : end */
   G_OBJECT_CLASS (ncm_lh_ratio2d_parent_class)->finalize (object);
@@ -256,6 +276,13 @@ ncm_lh_ratio2d_class_init (NcmLHRatio2dClass *klass)
                                                         "Border precision",
                                                         1.0e-16, 1.0e3, 1.0e-5,
                                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_NTHREADS,
+                                   g_param_spec_uint ("nthreads",
+                                                      NULL,
+                                                      "Number of threads to run",
+                                                      0, G_MAXUINT32, 0,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
 }
 
 /**
@@ -395,7 +422,33 @@ ncm_lh_ratio2d_set_pindex (NcmLHRatio2d *lhr2d, NcmMSetPIndex *pi1, NcmMSetPInde
   _ncm_lh_ratio2d_prepare_coords (lhr2d);
 }
 
-static gboolean _ncm_lh_ratio2d_log_dot = FALSE;
+/**
+ * ncm_lh_ratio2d_set_nthreads:
+ * @lhr2d: a #NcmLHRatio2d
+ * @nthreads: number of threads
+ *
+ * Sets the number of threads, when larger than one the border directions
+ * in ncm_lh_ratio2d_conf_region_radial() are solved at the same time
+ * using the #NcmFunc thread pool.
+ *
+ */
+void
+ncm_lh_ratio2d_set_nthreads (NcmLHRatio2d *lhr2d, guint nthreads)
+{
+  lhr2d->nthreads = nthreads;
+}
+
+/**
+ * ncm_lh_ratio2d_get_nthreads:
+ * @lhr2d: a #NcmLHRatio2d
+ *
+ * Returns: the number of threads used by ncm_lh_ratio2d_conf_region_radial().
+ */
+guint
+ncm_lh_ratio2d_get_nthreads (NcmLHRatio2d *lhr2d)
+{
+  return lhr2d->nthreads;
+}
 
 static void
 ncm_lh_ratio2d_log_start (NcmLHRatio2d *lhr2d, gdouble clevel)
@@ -408,7 +461,7 @@ ncm_lh_ratio2d_log_start (NcmLHRatio2d *lhr2d, gdouble clevel)
     if (lhr2d->mtype == NCM_FIT_RUN_MSGS_SIMPLE)
     {
       g_message ("#");
-      _ncm_lh_ratio2d_log_dot = TRUE;
+      lhr2d->log_dot = TRUE;
     }
   }
 }
@@ -420,10 +473,10 @@ ncm_lh_ratio2d_log_param_val (NcmLHRatio2d *lhr2d, gdouble r, gdouble val)
   {
     if (lhr2d->mtype == NCM_FIT_RUN_MSGS_SIMPLE)
     {
-      if (!_ncm_lh_ratio2d_log_dot)
+      if (!lhr2d->log_dot)
       {
         g_message ("#");
-        _ncm_lh_ratio2d_log_dot = TRUE;
+        lhr2d->log_dot = TRUE;
       }
       g_message (".");
     }
@@ -437,16 +490,16 @@ ncm_lh_ratio2d_log_root_start (NcmLHRatio2d *lhr2d, gdouble pl, gdouble pu)
 {
   if (lhr2d->mtype > NCM_FIT_RUN_MSGS_NONE)
   {
-    if (_ncm_lh_ratio2d_log_dot)
+    if (lhr2d->log_dot)
     {
       g_message ("\n");
-      _ncm_lh_ratio2d_log_dot = FALSE;
+      lhr2d->log_dot = FALSE;
     }
     g_message ("#  looking root in interval [% 12.8g % 12.8g]:\n", pl, pu);
     if (lhr2d->mtype == NCM_FIT_RUN_MSGS_SIMPLE)
     {
       g_message ("#");
-      _ncm_lh_ratio2d_log_dot = TRUE;
+      lhr2d->log_dot = TRUE;
     }
   }
 }
@@ -468,10 +521,10 @@ ncm_lh_ratio2d_log_root_finish (NcmLHRatio2d *lhr2d, gdouble pr, gdouble prec)
 {
   if (lhr2d->mtype > NCM_FIT_RUN_MSGS_NONE)
   {
-    if (_ncm_lh_ratio2d_log_dot)
+    if (lhr2d->log_dot)
     {
       g_message ("\n");
-      _ncm_lh_ratio2d_log_dot = FALSE;
+      lhr2d->log_dot = FALSE;
     }
     g_message ("#  root found at % 12.8g with precision %1.8e.\n", pr, prec);
   }  
@@ -482,10 +535,10 @@ ncm_lh_ratio2d_log_border_found (NcmLHRatio2d *lhr2d, gdouble r)
 {
   if (lhr2d->mtype > NCM_FIT_RUN_MSGS_NONE)
   {
-    if (_ncm_lh_ratio2d_log_dot)
+    if (lhr2d->log_dot)
     {
       g_message ("\n");
-      _ncm_lh_ratio2d_log_dot = FALSE;
+      lhr2d->log_dot = FALSE;
     }
     g_message ("#  border found at % 12.8g.\n", r);
   }  
@@ -1023,6 +1076,7 @@ ncm_lh_ratio2d_conf_region (NcmLHRatio2d *lhr2d, gdouble clevel, gdouble expecte
 
   /* total_time += g_timer_elapsed (iter_timer, NULL); */
   g_timer_destroy (iter_timer);
+  ncm_profiler_report_if_enabled ();
   
   {
     NcmLHRatio2dRegion *rg = ncm_lh_ratio2d_points_to_region (final_points, clevel);
@@ -1031,6 +1085,502 @@ ncm_lh_ratio2d_conf_region (NcmLHRatio2d *lhr2d, gdouble clevel, gdouble expecte
   }
 }
 
+typedef struct _NcmLHRatio2dDir
+{
+  gdouble theta;
+  gdouble r;
+  gdouble p[2];
+  gint nb;
+  gboolean found;
+  NcmVector *x;
+} NcmLHRatio2dDir;
+
+typedef struct _NcmLHRatio2dTracer
+{
+  NcmLHRatio2d *lhr2d;
+  NcmSerialize *ser;
+  NcmMemoryPool *fit_pool;
+  NcmLHRatio2dDir *dirs;
+  GArray *todo;
+  guint ndirs;
+  guint nfound;
+  GMutex dup_fit;
+} NcmLHRatio2dTracer;
+
+typedef struct _NcmLHRatio2dRay
+{
+  NcmLHRatio2d *lhr2d;
+  NcmFit *constrained;
+  NcmLHRatio2dDir *dir;
+  guint niter;
+  guint func_eval;
+  guint grad_eval;
+} NcmLHRatio2dRay;
+
+#define NCM_LH_RATIO2D_RAY_INCR (1.1)
+#define NCM_LH_RATIO2D_RAY_MIN_DIRS (8)
+
+static gpointer
+_ncm_lh_ratio2d_tracer_dup_fit (gpointer userdata)
+{
+  NcmLHRatio2dTracer *tracer = (NcmLHRatio2dTracer *) userdata;
+  g_mutex_lock (&tracer->dup_fit);
+  {
+    NcmFit *fit = ncm_fit_clone (tracer->lhr2d->constrained, tracer->ser, NULL, NULL);
+
+    ncm_serialize_reset (tracer->ser, TRUE);
+    g_mutex_unlock (&tracer->dup_fit);
+    return fit;
+  }
+}
+
+static void
+_ncm_lh_ratio2d_ray_tofparam (NcmLHRatio2d *lhr2d, const gdouble theta, const gdouble r, gdouble *p)
+{
+  const gdouble alpha = r * cos (theta);
+  const gdouble beta  = r * sin (theta);
+
+  p[0] = lhr2d->bf[0] + alpha * ncm_matrix_get (lhr2d->e_vec, 0, 0) + beta * ncm_matrix_get (lhr2d->e_vec, 0, 1);
+  p[1] = lhr2d->bf[1] + alpha * ncm_matrix_get (lhr2d->e_vec, 1, 0) + beta * ncm_matrix_get (lhr2d->e_vec, 1, 1);
+}
+
+static gdouble
+_ncm_lh_ratio2d_ray_f (gdouble r, gpointer ptr)
+{
+  NcmLHRatio2dRay *ray = (NcmLHRatio2dRay *) ptr;
+  NcmLHRatio2d *lhr2d  = ray->lhr2d;
+  gdouble p[2];
+
+  _ncm_lh_ratio2d_ray_tofparam (lhr2d, ray->dir->theta, r, p);
+
+  if (!_ncm_lh_ratio2d_inside_interval (&p[0], lhr2d->lb[0], lhr2d->ub[0], 1e-4) ||
+      !_ncm_lh_ratio2d_inside_interval (&p[1], lhr2d->lb[1], lhr2d->ub[1], 1e-4))
+    return 1.0e5;
+
+  ncm_mset_param_set_pi (ray->constrained->mset, lhr2d->pi, p, 2);
+  ncm_fit_run (ray->constrained, NCM_FIT_RUN_MSGS_NONE);
+
+  ray->niter     += ray->constrained->fstate->niter;
+  ray->func_eval += ray->constrained->fstate->func_eval;
+  ray->grad_eval += ray->constrained->fstate->grad_eval;
+
+  {
+    const gdouble m2lnL_const = ncm_fit_state_get_m2lnL_curval (ray->constrained->fstate);
+    const gdouble m2lnL = ncm_fit_state_get_m2lnL_curval (lhr2d->fit->fstate);
+    return m2lnL_const - (m2lnL + lhr2d->chisquare);
+  }
+}
+
+static gdouble
+_ncm_lh_ratio2d_ray_df (gdouble r, gpointer ptr)
+{
+  NcmLHRatio2dRay *ray = (NcmLHRatio2dRay *) ptr;
+  gdouble err;
+
+  return ncm_diff_rf_d1_1_to_1 (ray->constrained->diff, r, &_ncm_lh_ratio2d_ray_f, ptr, &err);
+}
+
+static void
+_ncm_lh_ratio2d_ray_fdf (gdouble r, gpointer ptr, gdouble *y, gdouble *dy)
+{
+  *dy = _ncm_lh_ratio2d_ray_df (r, ptr);
+  *y  = _ncm_lh_ratio2d_ray_f (r, ptr);
+}
+
+static gdouble
+_ncm_lh_ratio2d_ray_root_brent (NcmLHRatio2dRay *ray, gdouble r0, gdouble r1)
+{
+  gsl_root_fsolver *s = gsl_root_fsolver_alloc (gsl_root_fsolver_brent);
+  gint iter = 0, max_iter = 1000000;
+  gdouble r = 0.5 * (r0 + r1);
+  gsl_function F;
+  gint status;
+
+  F.function = &_ncm_lh_ratio2d_ray_f;
+  F.params   = ray;
+
+  gsl_root_fsolver_set (s, &F, r0, r1);
+
+  do
+  {
+    iter++;
+    status = gsl_root_fsolver_iterate (s);
+    if (status)
+    {
+      g_warning ("%s", gsl_strerror (status));
+      r = GSL_NAN;
+      break;
+    }
+
+    r      = gsl_root_fsolver_root (s);
+    r0     = gsl_root_fsolver_x_lower (s);
+    r1     = gsl_root_fsolver_x_upper (s);
+    status = gsl_root_test_interval (r0, r1, 0, ray->lhr2d->border_prec);
+  }
+  while (status == GSL_CONTINUE && iter < max_iter);
+
+  gsl_root_fsolver_free (s);
+
+  /* Leaves the constrained fit at the border point. */
+  if (gsl_finite (r) && !gsl_finite (_ncm_lh_ratio2d_ray_f (r, ray)))
+    r = GSL_NAN;
+
+  return r;
+}
+
+static gdouble
+_ncm_lh_ratio2d_ray_root_steffenson (NcmLHRatio2dRay *ray, gdouble r0, gdouble r1)
+{
+  gsl_root_fdfsolver *s = gsl_root_fdfsolver_alloc (gsl_root_fdfsolver_steffenson);
+  gint iter = 0, max_iter = 1000000;
+  gdouble r = 0.5 * (r0 + r1);
+  gsl_function_fdf F;
+  gint status;
+
+  F.f      = &_ncm_lh_ratio2d_ray_f;
+  F.df     = &_ncm_lh_ratio2d_ray_df;
+  F.fdf    = &_ncm_lh_ratio2d_ray_fdf;
+  F.params = ray;
+
+  gsl_root_fdfsolver_set (s, &F, r);
+
+  do
+  {
+    iter++;
+    status = gsl_root_fdfsolver_iterate (s);
+    if (status)
+    {
+      g_warning ("%s", gsl_strerror (status));
+      r = GSL_NAN;
+      break;
+    }
+
+    r0     = r;
+    r      = gsl_root_fdfsolver_root (s);
+    status = gsl_root_test_delta (r, r0, 0, ray->lhr2d->border_prec);
+  }
+  while (status == GSL_CONTINUE && iter < max_iter);
+
+  gsl_root_fdfsolver_free (s);
+
+  if (gsl_finite (r) && !gsl_finite (_ncm_lh_ratio2d_ray_f (r, ray)))
+    r = GSL_NAN;
+
+  return r;
+}
+
+static void
+_ncm_lh_ratio2d_tracer_solve (NcmLHRatio2dTracer *tracer, NcmFit *constrained, NcmLHRatio2dDir *dir)
+{
+  NcmLHRatio2d *lhr2d       = tracer->lhr2d;
+  const NcmLHRatio2dDir *nb = ((dir->nb >= 0) && tracer->dirs[dir->nb].found) ? &tracer->dirs[dir->nb] : NULL;
+  NcmLHRatio2dRay ray       = {lhr2d, constrained, dir, 0, 0, 0};
+  gdouble r0 = 0.0, r1, r = GSL_NAN;
+
+  /*
+   * Warm start: the constrained refits along this direction start from the
+   * constrained best fit found at the neighbouring border point, or from 
+   * the global best fit when there is none.
+   */
+  if (nb != NULL)
+  {
+    ncm_mset_fparams_set_vector (constrained->mset, nb->x);
+    r1 = nb->r;
+  }
+  else
+  {
+    ncm_mset_param_set_mset (constrained->mset, lhr2d->fit->mset);
+    r1 = sqrt (lhr2d->chisquare);
+  }
+
+  if (_ncm_lh_ratio2d_ray_f (r1, &ray) < 0.0)
+  {
+    do
+    {
+      r0  = r1;
+      r1 *= NCM_LH_RATIO2D_RAY_INCR;
+    } while (_ncm_lh_ratio2d_ray_f (r1, &ray) < 0.0);
+  }
+  else
+  {
+    r0 = r1 / NCM_LH_RATIO2D_RAY_INCR;
+    while (_ncm_lh_ratio2d_ray_f (r0, &ray) > 0.0)
+    {
+      r1  = r0;
+      r0 /= NCM_LH_RATIO2D_RAY_INCR;
+    }
+  }
+
+  switch (lhr2d->rtype)
+  {
+    case NCM_LH_RATIO2D_ROOT_BRACKET:
+      r = _ncm_lh_ratio2d_ray_root_brent (&ray, r0, r1);
+      break;
+    case NCM_LH_RATIO2D_ROOT_NUMDIFF:
+      r = _ncm_lh_ratio2d_ray_root_steffenson (&ray, r0, r1);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+
+  if (gsl_finite (r))
+  {
+    dir->r     = r;
+    dir->found = TRUE;
+    _ncm_lh_ratio2d_ray_tofparam (lhr2d, dir->theta, r, dir->p);
+    ncm_mset_fparams_get_vector (constrained->mset, dir->x);
+  }
+
+  g_mutex_lock (&lhr2d->update);
+  lhr2d->niter     += ray.niter;
+  lhr2d->func_eval += ray.func_eval;
+  lhr2d->grad_eval += ray.grad_eval;
+
+  if (dir->found)
+  {
+    NcmLHRatio2dPoint point;
+
+    point.x     = dir->r * cos (dir->theta);
+    point.y     = dir->r * sin (dir->theta);
+    point.theta = ncm_c_radian_0_2pi (dir->theta);
+    point.p1    = dir->p[0];
+    point.p2    = dir->p[1];
+
+    g_array_append_val (lhr2d->border, point);
+
+    tracer->nfound++;
+    if (lhr2d->mtype == NCM_FIT_RUN_MSGS_SIMPLE)
+    {
+      if (!lhr2d->log_dot)
+      {
+        g_message ("#");
+        lhr2d->log_dot = TRUE;
+      }
+      g_message (".");
+    }
+    else if (lhr2d->mtype == NCM_FIT_RUN_MSGS_FULL)
+      g_message ("#  border point [% 12.8g % 12.8g] at % 8.3f degrees, %u of %u.\n", 
+                 dir->p[0], dir->p[1], ncm_c_radian_to_degree (ncm_c_radian_0_2pi (dir->theta)),
+                 tracer->nfound, tracer->ndirs);
+  }
+  g_mutex_unlock (&lhr2d->update);
+}
+
+static void
+_ncm_lh_ratio2d_tracer_mt (glong i, glong f, gpointer data)
+{
+  NcmLHRatio2dTracer *tracer = (NcmLHRatio2dTracer *) data;
+  NcmFit **fit_ptr = ncm_memory_pool_get (tracer->fit_pool);
+  glong k;
+
+  for (k = i; k < f; k++)
+  {
+    const guint j = g_array_index (tracer->todo, guint, k);
+    _ncm_lh_ratio2d_tracer_solve (tracer, *fit_ptr, &tracer->dirs[j]);
+  }
+
+  ncm_memory_pool_return (fit_ptr);
+}
+
+static void
+_ncm_lh_ratio2d_tracer_run (NcmLHRatio2dTracer *tracer)
+{
+  if ((tracer->lhr2d->nthreads > 1) && (tracer->todo->len > 1))
+    ncm_func_eval_threaded_loop_full (&_ncm_lh_ratio2d_tracer_mt, 0, tracer->todo->len, tracer);
+  else
+    _ncm_lh_ratio2d_tracer_mt (0, tracer->todo->len, tracer);
+}
+
+/**
+ * ncm_lh_ratio2d_conf_region_radial:
+ * @lhr2d: a #NcmLHRatio2d
+ * @clevel: the confidence level (0,1)
+ * @expected_np: number of border points, if lesser than 1 it uses the default value of 100
+ * @mtype: a #NcmFitRunMsgs
+ *
+ * Computes the likelihood ratio confidence region border solving, for
+ * @expected_np equally spaced directions around the best fit (in the 
+ * coordinates of the Fisher matrix eigenvectors), the radius where the 
+ * profile likelihood ratio reaches the value corresponding to @clevel.
+ * Differently from ncm_lh_ratio2d_conf_region(), each direction is an
+ * independent one dimensional root search, therefore the directions can 
+ * be solved at the same time, see ncm_lh_ratio2d_set_nthreads().
+ *
+ * The directions are solved by successive refinement, first a coarse set
+ * of directions starting from the best fit and then, halving the angular 
+ * step at each pass, the directions in between. Every direction after the 
+ * first pass starts its constrained fits and its radius bracket from the 
+ * border point already found in the neighbouring direction. Each border 
+ * point is appended to @lhr2d as soon as it is found, see 
+ * ncm_lh_ratio2d_get_border(). Directions where the border could not 
+ * be determined are omitted from the region.
+ *
+ * The border must be star-shaped with respect to the best fit, for other
+ * regions use ncm_lh_ratio2d_conf_region().
+ *
+ * Returns: (transfer full): a #NcmLHRatio2dRegion.
+ */
+NcmLHRatio2dRegion *
+ncm_lh_ratio2d_conf_region_radial (NcmLHRatio2d *lhr2d, gdouble clevel, gdouble expected_np, NcmFitRunMsgs mtype)
+{
+  NcmLHRatio2dTracer tracer;
+  const guint nfree     = ncm_mset_fparams_len (lhr2d->constrained->mset);
+  const guint nmin      = GSL_MAX (NCM_LH_RATIO2D_RAY_MIN_DIRS, lhr2d->nthreads);
+  const gdouble theta0  = gsl_rng_uniform (lhr2d->rng->r) * 2.0 * M_PI;
+  guint stride          = 1;
+  guint j, s;
+
+  g_assert_cmpfloat (clevel, >, 0.0);
+  g_assert_cmpfloat (clevel, <, 1.0);
+
+  if (expected_np <= 1.0)
+    expected_np = 100.0;
+
+  lhr2d->mtype     = mtype;
+  lhr2d->chisquare = gsl_cdf_chisq_Qinv (1.0 - clevel, 2);
+  ncm_lh_ratio2d_log_start (lhr2d, clevel);
+
+  g_mutex_lock (&lhr2d->update);
+  lhr2d->clevel = clevel;
+  g_array_set_size (lhr2d->border, 0);
+  g_mutex_unlock (&lhr2d->update);
+
+  tracer.lhr2d    = lhr2d;
+  tracer.ser      = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+  tracer.fit_pool = ncm_memory_pool_new (&_ncm_lh_ratio2d_tracer_dup_fit, &tracer, (GDestroyNotify) &ncm_fit_free);
+  tracer.ndirs    = GSL_MAX ((guint) expected_np, 3);
+  tracer.nfound   = 0;
+  tracer.dirs     = g_new (NcmLHRatio2dDir, tracer.ndirs);
+  tracer.todo     = g_array_new (FALSE, FALSE, sizeof (guint));
+  g_mutex_init (&tracer.dup_fit);
+
+  for (j = 0; j < tracer.ndirs; j++)
+  {
+    NcmLHRatio2dDir *dir = &tracer.dirs[j];
+
+    dir->theta = theta0 + 2.0 * M_PI * j / tracer.ndirs;
+    dir->r     = GSL_NAN;
+    dir->p[0]  = GSL_NAN;
+    dir->p[1]  = GSL_NAN;
+    dir->nb    = -1;
+    dir->found = FALSE;
+    dir->x     = ncm_vector_new (nfree);
+  }
+
+  while (tracer.ndirs >= 2 * stride * nmin)
+    stride *= 2;
+
+  for (j = 0; j < tracer.ndirs; j += stride)
+    g_array_append_val (tracer.todo, j);
+  _ncm_lh_ratio2d_tracer_run (&tracer);
+
+  for (s = stride / 2; s > 0; s /= 2)
+  {
+    g_array_set_size (tracer.todo, 0);
+    for (j = s; j < tracer.ndirs; j += 2 * s)
+    {
+      tracer.dirs[j].nb = j - s;
+      g_array_append_val (tracer.todo, j);
+    }
+    _ncm_lh_ratio2d_tracer_run (&tracer);
+  }
+
+  if (lhr2d->mtype > NCM_FIT_RUN_MSGS_NONE)
+  {
+    if (lhr2d->log_dot)
+    {
+      g_message ("\n");
+      lhr2d->log_dot = FALSE;
+    }
+    g_message ("#  border points found  [%06u] of [%06u]\n", tracer.nfound, tracer.ndirs);
+    g_message ("#  iteration            [%06u]\n", lhr2d->niter);
+    g_message ("#  function evaluations [%06u]\n", lhr2d->func_eval);
+    g_message ("#  gradient evaluations [%06u]\n", lhr2d->grad_eval);
+  }
+
+  if (tracer.nfound == 0)
+    g_error ("ncm_lh_ratio2d_conf_region_radial: no border point found.");
+
+  for (j = 0; j < tracer.ndirs; j++)
+    ncm_vector_free (tracer.dirs[j].x);
+
+  ncm_memory_pool_free (tracer.fit_pool, TRUE);
+  ncm_serialize_free (tracer.ser);
+  g_array_unref (tracer.todo);
+  g_free (tracer.dirs);
+  g_mutex_clear (&tracer.dup_fit);
+
+  ncm_profiler_report_if_enabled ();
+
+  return ncm_lh_ratio2d_get_border (lhr2d);
+}
+
+static gint
+_ncm_lh_ratio2d_point_cmp_theta (gconstpointer a, gconstpointer b)
+{
+  const NcmLHRatio2dPoint *pa = (const NcmLHRatio2dPoint *) a;
+  const NcmLHRatio2dPoint *pb = (const NcmLHRatio2dPoint *) b;
+
+  return (pa->theta > pb->theta) - (pa->theta < pb->theta);
+}
+
+/**
+ * ncm_lh_ratio2d_get_border:
+ * @lhr2d: a #NcmLHRatio2d
+ *
+ * Builds a #NcmLHRatio2dRegion from the border points found so far by
+ * ncm_lh_ratio2d_conf_region_radial(), ordered by their angle around 
+ * the best fit. The points are appended as soon as they are found, 
+ * hence this function can be called from another thread while the 
+ * border is being computed to obtain the partial region. After the
+ * computation it returns the same region returned by 
+ * ncm_lh_ratio2d_conf_region_radial().
+ *
+ * Returns: (transfer full) (nullable): a #NcmLHRatio2dRegion or NULL if no border point was found.
+ */
+NcmLHRatio2dRegion *
+ncm_lh_ratio2d_get_border (NcmLHRatio2d *lhr2d)
+{
+  NcmLHRatio2dRegion *rg = NULL;
+  GArray *border;
+  guint i;
+
+  g_mutex_lock (&lhr2d->update);
+  border = g_array_sized_new (FALSE, FALSE, sizeof (NcmLHRatio2dPoint), lhr2d->border->len);
+  g_array_append_vals (border, lhr2d->border->data, lhr2d->border->len);
+
+  if (border->len > 0)
+  {
+    rg         = g_slice_new0 (NcmLHRatio2dRegion);
+    rg->np     = border->len + 1;
+    rg->p1     = ncm_vector_new (rg->np);
+    rg->p2     = ncm_vector_new (rg->np);
+    rg->clevel = lhr2d->clevel;
+  }
+  g_mutex_unlock (&lhr2d->update);
+
+  g_array_sort (border, &_ncm_lh_ratio2d_point_cmp_theta);
+
+  /* The last point closes the border. */
+  for (i = 0; i < border->len; i++)
+  {
+    const NcmLHRatio2dPoint *p = &g_array_index (border, NcmLHRatio2dPoint, i);
+
+    ncm_vector_set (rg->p1, i, p->p1);
+    ncm_vector_set (rg->p2, i, p->p2);
+  }
+  if (rg != NULL)
+  {
+    ncm_vector_set (rg->p1, border->len, ncm_vector_get (rg->p1, 0));
+    ncm_vector_set (rg->p2, border->len, ncm_vector_get (rg->p2, 0));
+  }
+
+  g_array_unref (border);
+
+  return rg;
+}
+
 /**
  * ncm_lh_ratio2d_fisher_border:
  * @lhr2d: a #NcmFit.
@@ -85,7 +85,12 @@ struct _NcmLHRatio2d
   guint niter;
   guint func_eval;
   guint grad_eval;
+  guint nthreads;
   NcmDiff *diff;
+  gboolean log_dot;
+  GArray *border;
+  gdouble clevel;
+  GMutex update;
 };
 
 typedef struct _NcmLHRatio2dPoint NcmLHRatio2dPoint;
@@ -133,8 +138,12 @@ void ncm_lh_ratio2d_free (NcmLHRatio2d *lhr2d);
 void ncm_lh_ratio2d_clear (NcmLHRatio2d **lhr2d);
 
 void ncm_lh_ratio2d_set_pindex (NcmLHRatio2d *lhr2d, NcmMSetPIndex *pi1, NcmMSetPIndex *pi2);
+void ncm_lh_ratio2d_set_nthreads (NcmLHRatio2d *lhr2d, guint nthreads);
+guint ncm_lh_ratio2d_get_nthreads (NcmLHRatio2d *lhr2d);
 
 NcmLHRatio2dRegion *ncm_lh_ratio2d_conf_region (NcmLHRatio2d *lhr2d, gdouble clevel, gdouble expected_np, NcmFitRunMsgs mtype);
+NcmLHRatio2dRegion *ncm_lh_ratio2d_conf_region_radial (NcmLHRatio2d *lhr2d, gdouble clevel, gdouble expected_np, NcmFitRunMsgs mtype);
+NcmLHRatio2dRegion *ncm_lh_ratio2d_get_border (NcmLHRatio2d *lhr2d);
 NcmLHRatio2dRegion *ncm_lh_ratio2d_fisher_border (NcmLHRatio2d *lhr2d, gdouble clevel, gdouble expected_np, NcmFitRunMsgs mtype);
 NcmLHRatio2dRegion *ncm_lh_ratio2d_region_dup (NcmLHRatio2dRegion *rg);
 void ncm_lh_ratio2d_region_free (NcmLHRatio2dRegion *rg);
@@ -776,3 +776,48 @@ ncm_likelihood_m2lnL_val_grad (NcmLikelihood *lh, NcmMSet *mset, gdouble *m2lnL,
 
   ncm_dataset_m2lnL_val_grad (lh->dset, mset, m2lnL, grad);
 }
+
+/**
+ * ncm_likelihood_m2lnL_val_batch:
+ * @lh: a #NcmLikelihood
+ * @mset: a #NcmMSet
+ * @fparams: a #NcmMatrix containing one free parameter vector per row
+ * @m2lnL_v: a #NcmVector
+ *
+ * Calculates $-2\ln(L)$ as in ncm_likelihood_m2lnL_val() for each row of 
+ * @fparams and stores the results in @m2lnL_v. The data part is computed
+ * using ncm_dataset_m2lnL_val_batch() and the priors are added point by point.
+ * The free parameters of @mset are restored on exit.
+ * 
+ */
+void
+ncm_likelihood_m2lnL_val_batch (NcmLikelihood *lh, NcmMSet *mset, NcmMatrix *fparams, NcmVector *m2lnL_v)
+{
+  const guint npoints      = ncm_matrix_nrows (fparams);
+  const guint prior_length = lh->priors_f->len + lh->priors_m2lnL->len;
+
+  ncm_dataset_m2lnL_val_batch (lh->dset, mset, fparams, m2lnL_v);
+
+  if (prior_length > 0)
+  {
+    NcmVector *fparams0 = ncm_vector_new (ncm_mset_fparams_len (mset));
+    guint a;
+
+    ncm_mset_fparams_get_vector (mset, fparams0);
+
+    for (a = 0; a < npoints; a++)
+    {
+      NcmVector *fparams_a = ncm_matrix_get_row (fparams, a);
+      gdouble priors_m2lnL;
+
+      ncm_mset_fparams_set_vector (mset, fparams_a);
+      ncm_likelihood_priors_m2lnL_val (lh, mset, &priors_m2lnL);
+      ncm_vector_addto (m2lnL_v, a, priors_m2lnL);
+
+      ncm_vector_free (fparams_a);
+    }
+
+    ncm_mset_fparams_set_vector (mset, fparams0);
+    ncm_vector_free (fparams0);
+  }
+}
@@ -100,6 +100,7 @@ void ncm_likelihood_priors_m2lnL_vec (NcmLikelihood *lh, NcmMSet *mset, NcmVecto
 void ncm_likelihood_m2lnL_val (NcmLikelihood *lh, NcmMSet *mset, gdouble *m2lnL);
 void ncm_likelihood_m2lnL_grad (NcmLikelihood *lh, NcmMSet *mset, NcmVector *grad);
 void ncm_likelihood_m2lnL_val_grad (NcmLikelihood *lh, NcmMSet *mset, gdouble *m2lnL, NcmVector *grad);
+void ncm_likelihood_m2lnL_val_batch (NcmLikelihood *lh, NcmMSet *mset, NcmMatrix *fparams, NcmVector *m2lnL_v);
 
 G_END_DECLS
 
@@ -62,6 +62,7 @@ ncm_matrix_init (NcmMatrix *m)
   m->pdata = NULL;
   m->pfree = NULL;
   m->type = 0;
+  m->readonly = FALSE;
 }
 
 static void
@@ -772,6 +773,32 @@ ncm_matrix_substitute (NcmMatrix **cm, NcmMatrix *nm, gboolean check_size)
     *cm = ncm_matrix_ref (nm);
 }
 
+/**
+ * ncm_matrix_set_readonly:
+ * @cm: a #NcmMatrix
+ * @readonly: a boolean
+ *
+ * Marks @cm as read-only, see ncm_vector_set_readonly().
+ *
+ */
+void
+ncm_matrix_set_readonly (NcmMatrix *cm, gboolean readonly)
+{
+  cm->readonly = readonly;
+}
+
+/**
+ * ncm_matrix_is_readonly:
+ * @cm: a #NcmMatrix
+ *
+ * Returns: whether @cm is marked as read-only, see ncm_matrix_set_readonly().
+ */
+gboolean
+ncm_matrix_is_readonly (const NcmMatrix *cm)
+{
+  return cm->readonly;
+}
+
 /**
  * ncm_matrix_add_mul:
  * @cm: FIXME
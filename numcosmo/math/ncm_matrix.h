@@ -84,6 +84,7 @@ struct _NcmMatrix
   gpointer pdata;
   GDestroyNotify pfree;
   NcmMatrixInternal type;
+  gboolean readonly;
 };
 
 GType ncm_matrix_get_type (void) G_GNUC_CONST;
@@ -155,6 +156,8 @@ G_INLINE_FUNC const gdouble *ncm_matrix_const_data (const NcmMatrix *cm);
 
 NcmMatrix *ncm_matrix_dup (const NcmMatrix *cm);
 void ncm_matrix_substitute (NcmMatrix **cm, NcmMatrix *nm, gboolean check_size);
+void ncm_matrix_set_readonly (NcmMatrix *cm, gboolean readonly);
+gboolean ncm_matrix_is_readonly (const NcmMatrix *cm);
 void ncm_matrix_add_mul (NcmMatrix *cm, const gdouble alpha, NcmMatrix *b);
 
 void ncm_matrix_free (NcmMatrix *cm);
@@ -38,6 +38,7 @@
 
 #include "math/ncm_model_ctrl.h"
 #include "math/ncm_cfg.h"
+#include "math/ncm_profiler.h"
 
 enum
 {
@@ -320,3 +321,20 @@ ncm_model_ctrl_clear (NcmModelCtrl **ctrl)
 {
   g_clear_object (ctrl);
 }
+
+/**
+ * _ncm_model_ctrl_profile_update: (skip)
+ * @model: a #NcmModel
+ * @up: whether @model required an update
+ *
+ * Registers the result of an update check of @model in the
+ * profiler, see ncm_profiler_add_hit(). Nothing is done if
+ * the profiler is disabled.
+ *
+ */
+void
+_ncm_model_ctrl_profile_update (NcmModel *model, gboolean up)
+{
+  if (G_UNLIKELY (ncm_profiler_is_enabled ()))
+    ncm_profiler_add_hit (G_OBJECT_TYPE_NAME (model), up);
+}
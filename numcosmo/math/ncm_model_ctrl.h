@@ -76,6 +76,8 @@ G_INLINE_FUNC gboolean ncm_model_ctrl_model_last_update (NcmModelCtrl *ctrl);
 G_INLINE_FUNC gboolean ncm_model_ctrl_model_has_submodel (NcmModelCtrl *ctrl, NcmModelID mid);
 G_INLINE_FUNC gboolean ncm_model_ctrl_submodel_last_update (NcmModelCtrl *ctrl, NcmModelID mid);
 
+void _ncm_model_ctrl_profile_update (NcmModel *model, gboolean up);
+
 G_END_DECLS
 
 #endif /* _NCM_MODEL_CTRL_H_ */
@@ -141,6 +143,8 @@ ncm_model_ctrl_update (NcmModelCtrl *ctrl, NcmModel *model)
     g_ptr_array_set_size (ctrl->submodel_ctrl, n);
   }
 
+  _ncm_model_ctrl_profile_update (model, up);
+
   ncm_model_clear (&ctrl_model);
   return up;
 }
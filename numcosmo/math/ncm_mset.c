@@ -1953,22 +1953,59 @@ ncm_mset_param_get_ftype (NcmMSet *mset, NcmModelID mid, guint pid)
   return ncm_model_param_get_ftype (model, pid);
 }
 
+/*
+ * Bulk parameter update: the values are written directly into the models'
+ * parameter vectors and each model is updated (pkey bump and reparametrization)
+ * only once after all its parameters were written. Since the update depends
+ * only on the final parameter vector, the result is identical to calling
+ * ncm_mset_param_set() for each parameter.
+ */
+static void
+_ncm_mset_param_set_pi_data (NcmMSet *mset, const NcmMSetPIndex *pi, const gdouble *x, const gsize stride, const guint n)
+{
+  NcmModel *model = NULL;
+  NcmModelID mid  = -1;
+  guint fpi;
+
+  for (fpi = 0; fpi < n; fpi++)
+  {
+    if (pi[fpi].mid != mid)
+    {
+      NcmModel *next_model;
+
+      mid        = pi[fpi].mid;
+      next_model = ncm_mset_peek (mset, mid);
+
+      if (next_model != model)
+      {
+        if (model != NULL)
+          ncm_model_params_update (model);
+        model = next_model;
+      }
+    }
+    ncm_vector_set (model->p, pi[fpi].pid, x[fpi * stride]);
+  }
+
+  if (model != NULL)
+    ncm_model_params_update (model);
+}
+
 /**
  * ncm_mset_param_set_pi:
  * @mset: a #NcmMSet
- * @pi: a #NcmMSetPIndex
- * @x: FIXME
- * @n: FIXME
+ * @pi: (array length=n): an array of #NcmMSetPIndex
+ * @x: (array length=n) (element-type double): parameter values
+ * @n: number of parameters
  *
- * FIXME
+ * Sets the parameters described by @pi to the values in @x. Consecutive
+ * entries of @pi belonging to the same model are applied together, updating
+ * the model only once.
  *
  */
 void
 ncm_mset_param_set_pi (NcmMSet *mset, NcmMSetPIndex *pi, const gdouble *x, guint n)
 {
-  guint fpi;
-  for (fpi = 0; fpi < n; fpi++)
-    ncm_mset_param_set (mset, pi[fpi].mid, pi[fpi].pid, x[fpi]);
+  _ncm_mset_param_set_pi_data (mset, pi, x, 1, n);
 }
 
 /**
@@ -2035,19 +2072,19 @@ ncm_mset_fparams_get_vector_offset (NcmMSet *mset, NcmVector *x, guint offset)
  * @mset: a #NcmMSet
  * @x: a #NcmVector
  *
- * FIXME
+ * Sets the free parameters to the values in @x.
+ * All free parameters are written before any model is updated, each model
+ * has its parameter key incremented and its reparametrization applied only
+ * once.
  *
  */
 void
 ncm_mset_fparams_set_vector (NcmMSet *mset, const NcmVector *x)
 {
-  guint fpi;
-
-  for (fpi = 0; fpi < mset->fparam_len; fpi++)
-  {
-    const NcmMSetPIndex pi = g_array_index (mset->pi_array, NcmMSetPIndex, fpi);
-    ncm_mset_param_set (mset, pi.mid, pi.pid, ncm_vector_get (x, fpi));
-  }
+  g_assert_cmpuint (ncm_vector_len (x), >=, mset->fparam_len);
+  _ncm_mset_param_set_pi_data (mset, (NcmMSetPIndex *) mset->pi_array->data,
+                               ncm_vector_const_data (x), ncm_vector_stride (x),
+                               mset->fparam_len);
 }
 
 /**
@@ -2056,38 +2093,33 @@ ncm_mset_fparams_set_vector (NcmMSet *mset, const NcmVector *x)
  * @x: a #NcmVector
  * @offset: starting index
  *
- * FIXME
+ * Sets the free parameters to the values in @x starting from @offset.
+ * See ncm_mset_fparams_set_vector().
  *
  */
 void
 ncm_mset_fparams_set_vector_offset (NcmMSet *mset, const NcmVector *x, guint offset)
 {
-  guint fpi;
-
-  for (fpi = 0; fpi < mset->fparam_len; fpi++)
-  {
-    const NcmMSetPIndex pi = g_array_index (mset->pi_array, NcmMSetPIndex, fpi);
-    ncm_mset_param_set (mset, pi.mid, pi.pid, ncm_vector_get (x, fpi + offset));
-  }
+  g_assert_cmpuint (ncm_vector_len (x), >=, mset->fparam_len + offset);
+  _ncm_mset_param_set_pi_data (mset, (NcmMSetPIndex *) mset->pi_array->data,
+                               ncm_vector_const_data (x) + offset * ncm_vector_stride (x), ncm_vector_stride (x),
+                               mset->fparam_len);
 }
 
 /**
  * ncm_mset_fparams_set_array:
  * @mset: a #NcmMSet
- * @x: (array) (element-type double): FIXME
+ * @x: (array) (element-type double): free parameters values
  *
- * FIXME
+ * Sets the free parameters to the values in @x.
+ * See ncm_mset_fparams_set_vector().
  *
  */
 void
 ncm_mset_fparams_set_array (NcmMSet *mset, const gdouble *x)
 {
-  guint fpi;
-  for (fpi = 0; fpi < mset->fparam_len; fpi++)
-  {
-    const NcmMSetPIndex pi = g_array_index (mset->pi_array, NcmMSetPIndex, fpi);
-    ncm_mset_param_set (mset, pi.mid, pi.pid, x[fpi]);
-  }
+  _ncm_mset_param_set_pi_data (mset, (NcmMSetPIndex *) mset->pi_array->data,
+                               x, 1, mset->fparam_len);
 }
 
 /**
@@ -2101,12 +2133,9 @@ ncm_mset_fparams_set_array (NcmMSet *mset, const gdouble *x)
 void
 ncm_mset_fparams_set_gsl_vector (NcmMSet *mset, const gsl_vector *x)
 {
-  guint fpi;
-  for (fpi = 0; fpi < mset->fparam_len; fpi++)
-  {
-    const NcmMSetPIndex pi = g_array_index (mset->pi_array, NcmMSetPIndex, fpi);
-    ncm_mset_param_set (mset, pi.mid, pi.pid, gsl_vector_get (x, fpi));
-  }
+  g_assert_cmpuint (x->size, >=, mset->fparam_len);
+  _ncm_mset_param_set_pi_data (mset, (NcmMSetPIndex *) mset->pi_array->data,
+                               x->data, x->stride, mset->fparam_len);
 }
 
 /**
@@ -54,6 +54,8 @@
 #include "math/ncm_mset_catalog.h"
 #include "math/ncm_cfg.h"
 #include "math/ncm_func_eval.h"
+#include "math/ncm_serialize.h"
+#include "math/memory_pool.h"
 #include "ncm_enum_types.h"
 
 #include <gsl/gsl_statistics_double.h>
@@ -78,6 +80,7 @@ enum
   PROP_SYNC_MODE,
   PROP_SYNC_INTERVAL,
   PROP_READONLY,
+  PROP_NTHREADS,
 };
 
 static void
@@ -130,6 +133,7 @@ ncm_mset_catalog_init (NcmMSetCatalog *mcat)
   mcat->h_pdf          = NULL;
   mcat->params_max     = NULL;
   mcat->params_min     = NULL;
+  mcat->nthreads       = 0;
 
   mcat->constructed    = FALSE;
 }
@@ -148,6 +152,13 @@ _ncm_mset_catalog_constructed_alloc_chains (NcmMSetCatalog *mcat)
 
   mcat->pstats     = ncm_stats_vec_new (total, NCM_STATS_VEC_COV, TRUE);
   mcat->params_max = ncm_vector_new (total);
+
+  /* 
+   * The convergence diagnostics use pstats for single chains and 
+   * e_mean_stats otherwise, keep their lagged sums updated as rows arrive.
+   */
+  if (mcat->nchains == 1)
+    ncm_stats_vec_enable_lag_windows (mcat->pstats, NCM_MSET_CATALOG_DIAG_MAX_LAG, 0);
   mcat->params_min = ncm_vector_new (total);
 
   ncm_vector_set_all (mcat->params_max, GSL_NEGINF);
@@ -163,6 +174,8 @@ _ncm_mset_catalog_constructed_alloc_chains (NcmMSetCatalog *mcat)
     mcat->mean_pstats   = ncm_stats_vec_new (free_params_len, NCM_STATS_VEC_COV, FALSE);
     mcat->e_stats       = ncm_stats_vec_new (total, NCM_STATS_VEC_VAR, FALSE);
     mcat->e_mean_stats  = ncm_stats_vec_new (total, NCM_STATS_VEC_VAR, TRUE);
+
+    ncm_stats_vec_enable_lag_windows (mcat->e_mean_stats, NCM_MSET_CATALOG_DIAG_MAX_LAG, 0);
     
     mcat->chain_means   = ncm_vector_new (mcat->nchains);
     mcat->chain_vars    = ncm_vector_new (mcat->nchains);
@@ -309,6 +322,9 @@ _ncm_mset_catalog_set_property (GObject *object, guint prop_id, const GValue *va
     case PROP_READONLY:
       mcat->readonly = g_value_get_boolean (value);
       break;
+    case PROP_NTHREADS:
+      ncm_mset_catalog_set_nthreads (mcat, g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -389,6 +405,9 @@ _ncm_mset_catalog_get_property (GObject *object, guint prop_id, GValue *value, G
     case PROP_READONLY:
       g_value_set_boolean (value, mcat->readonly);
       break;
+    case PROP_NTHREADS:
+      g_value_set_uint (value, ncm_mset_catalog_get_nthreads (mcat));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -583,6 +602,13 @@ ncm_mset_catalog_class_init (NcmMSetCatalogClass *klass)
                                                          "If the fits catalogue must be open in the readonly mode",
                                                          FALSE,
                                                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_NTHREADS,
+                                   g_param_spec_uint ("nthreads",
+                                                      NULL,
+                                                      "Number of threads used to evaluate functions over the catalog rows",
+                                                      0, G_MAXUINT32, 0,
+                                                      G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
 }
 
 /**
@@ -2203,6 +2229,37 @@ ncm_mset_catalog_get_tau_method (NcmMSetCatalog *mcat)
   return mcat->tau_method;
 }
 
+/**
+ * ncm_mset_catalog_set_nthreads:
+ * @mcat: a #NcmMSetCatalog
+ * @nthreads: number of threads
+ * 
+ * Sets the number of threads used to evaluate #NcmMSetFunc's over the 
+ * catalog rows, see ncm_mset_catalog_calc_func_rows(). When @nthreads 
+ * is larger than one, each thread uses its own copy of the catalog 
+ * #NcmMSet and of the function, obtained through #NcmSerialize, hence
+ * the function must be serializable. These evaluations must not be 
+ * called from a thread of the library thread pool.
+ *
+ */
+void 
+ncm_mset_catalog_set_nthreads (NcmMSetCatalog *mcat, guint nthreads)
+{
+  mcat->nthreads = nthreads;
+}
+
+/**
+ * ncm_mset_catalog_get_nthreads:
+ * @mcat: a #NcmMSetCatalog
+ * 
+ * Returns: the number of threads used by @mcat to evaluate functions.
+ */
+guint 
+ncm_mset_catalog_get_nthreads (NcmMSetCatalog *mcat)
+{
+  return mcat->nthreads;
+}
+
 static void
 _ncm_mset_catalog_post_update (NcmMSetCatalog *mcat, NcmVector *x)
 {
@@ -2729,7 +2786,10 @@ ncm_mset_catalog_estimate_autocorrelation_tau (NcmMSetCatalog *mcat, gboolean fo
       case NCM_MSET_CATALOG_TAU_METHOD_ACOR:
         for (p = 0; p < total; p++)
         {
-          const gdouble tau = ncm_stats_vec_get_subsample_autocorr_tau (mcat->pstats, p, mcat->nchains, 0);
+          /* The ensemble means are the nchains subsamples of pstats. */
+          const gdouble tau = ncm_stats_vec_has_lag_windows (mcat->e_mean_stats) ? 
+            ncm_stats_vec_get_autocorr_tau (mcat->e_mean_stats, p, 0) :
+            ncm_stats_vec_get_subsample_autocorr_tau (mcat->pstats, p, mcat->nchains, 0);
           ncm_vector_set (mcat->tau, p, tau);
         }
         break;
@@ -2985,6 +3045,247 @@ ncm_mset_catalog_param_pdf_pvalue (NcmMSetCatalog *mcat, gdouble pvalue, gboolea
   }
 }
 
+#define _NCM_MSET_CATALOG_FUNC_BLOCK_SIZE (1024 * 16)
+
+typedef struct _NcmMSetCatalogFuncWorker
+{
+  NcmMSet *mset;
+  NcmMSetFunc *func;
+} NcmMSetCatalogFuncWorker;
+
+struct _NcmMSetCatalogFuncEval
+{
+  NcmMSetCatalog *mcat;
+  NcmMSetFunc *func;
+  NcmVector *x_v;
+  NcmMatrix *res;
+  guint row_i;
+  NcmSerialize *ser;
+  NcmMemoryPool *mp;
+  GMutex dup_lock;
+};
+
+static gpointer
+_ncm_mset_catalog_func_worker_dup (gpointer userdata)
+{
+  NcmMSetCatalogFuncEval *fe  = (NcmMSetCatalogFuncEval *) userdata;
+  NcmMSetCatalogFuncWorker *fw = g_new (NcmMSetCatalogFuncWorker, 1);
+
+  g_mutex_lock (&fe->dup_lock);
+  fw->mset = ncm_mset_dup (fe->mcat->mset, fe->ser);
+  fw->func = NCM_MSET_FUNC (ncm_serialize_dup_obj (fe->ser, G_OBJECT (fe->func)));
+  ncm_serialize_reset (fe->ser, TRUE);
+  g_mutex_unlock (&fe->dup_lock);
+
+  return fw;
+}
+
+static void
+_ncm_mset_catalog_func_worker_free (gpointer p)
+{
+  NcmMSetCatalogFuncWorker *fw = (NcmMSetCatalogFuncWorker *) p;
+
+  ncm_mset_free (fw->mset);
+  ncm_mset_func_free (fw->func);
+  g_free (fw);
+}
+
+static void
+_ncm_mset_catalog_func_eval_init (NcmMSetCatalogFuncEval *fe, NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVector *x_v)
+{
+  fe->mcat  = mcat;
+  fe->func  = func;
+  fe->x_v   = x_v;
+  fe->res   = NULL;
+  fe->row_i = 0;
+  fe->ser   = NULL;
+  fe->mp    = NULL;
+  g_mutex_init (&fe->dup_lock);
+
+  if (mcat->nthreads > 1)
+  {
+    fe->ser = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+    fe->mp  = ncm_memory_pool_new (&_ncm_mset_catalog_func_worker_dup, fe, &_ncm_mset_catalog_func_worker_free);
+  }
+}
+
+static void
+_ncm_mset_catalog_func_eval_clear (NcmMSetCatalogFuncEval *fe)
+{
+  if (fe->mp != NULL)
+    ncm_memory_pool_free (fe->mp, TRUE);
+  fe->mp = NULL;
+  ncm_serialize_clear (&fe->ser);
+  g_mutex_clear (&fe->dup_lock);
+}
+
+static void
+_ncm_mset_catalog_func_eval_row (NcmMSetCatalogFuncEval *fe, NcmMSet *mset, NcmMSetFunc *func, guint l)
+{
+  NcmVector *row = ncm_mset_catalog_peek_row (fe->mcat, fe->row_i + l);
+
+  ncm_mset_fparams_set_vector_offset (mset, row, fe->mcat->nadd_vals);
+
+  if (fe->x_v != NULL)
+  {
+    const guint len = ncm_vector_len (fe->x_v);
+    guint j;
+
+    for (j = 0; j < len; j++)
+      ncm_mset_func_eval (func, mset, ncm_vector_ptr (fe->x_v, j), ncm_matrix_ptr (fe->res, l, j));
+  }
+  else
+    ncm_mset_func_eval (func, mset, NULL, ncm_matrix_ptr (fe->res, l, 0));
+}
+
+static void
+_ncm_mset_catalog_func_eval_mt (glong i, glong f, gpointer data)
+{
+  NcmMSetCatalogFuncEval *fe         = (NcmMSetCatalogFuncEval *) data;
+  NcmMSetCatalogFuncWorker **fw_ptr = ncm_memory_pool_get (fe->mp);
+  NcmMSetCatalogFuncWorker *fw      = *fw_ptr;
+  glong l;
+
+  for (l = i; l < f; l++)
+    _ncm_mset_catalog_func_eval_row (fe, fw->mset, fw->func, l);
+
+  ncm_memory_pool_return (fw_ptr);
+}
+
+/*
+ * Evaluates the function in the rows [row_i, row_i + nrows) storing
+ * the results in the first nrows rows of res. The mset parameters
+ * are changed in the serial path, the caller must save/restore them.
+ */
+static void
+_ncm_mset_catalog_func_eval_block (NcmMSetCatalogFuncEval *fe, guint row_i, guint nrows, NcmMatrix *res)
+{
+  fe->row_i = row_i;
+  fe->res   = res;
+
+  g_assert_cmpuint (nrows, <=, ncm_matrix_nrows (res));
+
+  if ((fe->mp != NULL) && (nrows > fe->mcat->nthreads))
+  {
+    ncm_func_eval_threaded_loop_nw (&_ncm_mset_catalog_func_eval_mt, 0, nrows, fe, fe->mcat->nthreads);
+  }
+  else
+  {
+    guint l;
+    for (l = 0; l < nrows; l++)
+      _ncm_mset_catalog_func_eval_row (fe, fe->mcat->mset, fe->func, l);
+  }
+}
+
+/**
+ * ncm_mset_catalog_func_eval_new: (skip)
+ * @mcat: a #NcmMSetCatalog
+ * @func: a #NcmMSetFunc
+ * @x_v: (allow-none): #NcmVector of arguments of @func
+ *
+ * Creates a context to evaluate @func in the rows of @mcat, see
+ * ncm_mset_catalog_func_eval_rows(). When the number of threads of @mcat
+ * is larger than one, the copies of the #NcmMSet and of @func used by
+ * each thread are created once and reused by every call to
+ * ncm_mset_catalog_func_eval_rows(). For this reason, the context must be
+ * used only while @mcat, its #NcmMSet and @func are not modified.
+ *
+ * Returns: (transfer full): a new #NcmMSetCatalogFuncEval.
+ */
+NcmMSetCatalogFuncEval *
+ncm_mset_catalog_func_eval_new (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVector *x_v)
+{
+  NcmMSetCatalogFuncEval *fe = g_new (NcmMSetCatalogFuncEval, 1);
+
+  _ncm_mset_catalog_func_eval_init (fe,
+                                    ncm_mset_catalog_ref (mcat),
+                                    ncm_mset_func_ref (func),
+                                    (x_v != NULL) ? ncm_vector_ref (x_v) : NULL);
+
+  return fe;
+}
+
+/**
+ * ncm_mset_catalog_func_eval_free: (skip)
+ * @fe: a #NcmMSetCatalogFuncEval
+ *
+ * Releases @fe and the thread copies it holds.
+ *
+ */
+void
+ncm_mset_catalog_func_eval_free (NcmMSetCatalogFuncEval *fe)
+{
+  _ncm_mset_catalog_func_eval_clear (fe);
+
+  ncm_mset_catalog_free (fe->mcat);
+  ncm_mset_func_free (fe->func);
+  if (fe->x_v != NULL)
+    ncm_vector_free (fe->x_v);
+
+  g_free (fe);
+}
+
+/**
+ * ncm_mset_catalog_func_eval_rows: (skip)
+ * @fe: a #NcmMSetCatalogFuncEval
+ * @row_i: first catalog row
+ * @res: a #NcmMatrix
+ *
+ * Evaluates the function of @fe in the catalog rows starting at @row_i,
+ * see ncm_mset_catalog_calc_func_rows(). The free parameters of the
+ * catalog #NcmMSet are restored before returning.
+ *
+ */
+void
+ncm_mset_catalog_func_eval_rows (NcmMSetCatalogFuncEval *fe, guint row_i, NcmMatrix *res)
+{
+  NcmMSetCatalog *mcat   = fe->mcat;
+  const guint nrows      = ncm_matrix_nrows (res);
+  NcmVector *save_params = ncm_vector_new (ncm_mset_fparams_len (mcat->mset));
+
+  g_assert_cmpuint (row_i + nrows, <=, ncm_mset_catalog_len (mcat));
+  if (fe->x_v != NULL)
+    g_assert_cmpuint (ncm_matrix_ncols (res), ==, ncm_vector_len (fe->x_v));
+  else
+    g_assert_cmpuint (ncm_matrix_ncols (res), ==, ncm_mset_func_get_dim (fe->func));
+
+  ncm_mset_fparams_get_vector (mcat->mset, save_params);
+  _ncm_mset_catalog_func_eval_block (fe, row_i, nrows, res);
+  ncm_mset_fparams_set_vector (mcat->mset, save_params);
+
+  ncm_vector_free (save_params);
+}
+
+/**
+ * ncm_mset_catalog_calc_func_rows:
+ * @mcat: a #NcmMSetCatalog
+ * @func: a #NcmMSetFunc
+ * @x_v: (allow-none): #NcmVector of arguments of @func
+ * @row_i: first catalog row
+ * @res: a #NcmMatrix
+ *
+ * Evaluates @func in the catalog rows starting at @row_i, one row of
+ * @res for each catalog row. If @x_v is not NULL, @func must be of type 
+ * n-n and each column of @res contains the value of @func at the respective 
+ * element of @x_v. Otherwise, @func is evaluated with no arguments and @res 
+ * must have ncm_mset_func_get_dim() columns.
+ * 
+ * The rows are evaluated in parallel when the number of threads is larger 
+ * than one, see ncm_mset_catalog_set_nthreads(), the results are identical
+ * to the serial evaluation. Each call creates the thread copies of the
+ * #NcmMSet and @func, when evaluating the catalog in several blocks use
+ * ncm_mset_catalog_func_eval_new() instead.
+ *
+ */
+void
+ncm_mset_catalog_calc_func_rows (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVector *x_v, guint row_i, NcmMatrix *res)
+{
+  NcmMSetCatalogFuncEval *fe = ncm_mset_catalog_func_eval_new (mcat, func, x_v);
+
+  ncm_mset_catalog_func_eval_rows (fe, row_i, res);
+  ncm_mset_catalog_func_eval_free (fe);
+}
+
 /**
  * ncm_mset_catalog_calc_ci_direct:
  * @mcat: a #NcmMSetCatalog
@@ -3031,15 +3332,15 @@ ncm_mset_catalog_calc_ci_direct (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVec
     ncm_vector_clear (&mcat->quantile_ws);
     mcat->quantile_ws = ncm_vector_new (cat_len * dim);
 
-    for (i = 0; i < cat_len; i++)
     {
-      NcmVector *row = ncm_mset_catalog_peek_row (mcat, i);
-      NcmVector *qws = ncm_vector_get_subvector (mcat->quantile_ws, i * dim, dim);
-      ncm_mset_fparams_set_vector_offset (mcat->mset, row, mcat->nadd_vals);
+      NcmMatrix *qws = ncm_matrix_new_data_static (ncm_vector_data (mcat->quantile_ws), cat_len, dim);
+      NcmMSetCatalogFuncEval fe;
 
-      ncm_mset_func_eval_vector (func, mcat->mset, x_v, qws);
+      _ncm_mset_catalog_func_eval_init (&fe, mcat, func, x_v);
+      _ncm_mset_catalog_func_eval_block (&fe, 0, cat_len, qws);
+      _ncm_mset_catalog_func_eval_clear (&fe);
 
-      ncm_vector_free (qws);
+      ncm_matrix_free (qws);
     }
 
     for (i = 0; i < dim; i++)
@@ -3113,19 +3414,13 @@ ncm_mset_catalog_calc_ci_interp (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVec
     NcmVector *save_params = ncm_vector_new (ncm_mset_fparams_len (mcat->mset));
     const guint cat_len    = ncm_mset_catalog_len (mcat);
     GPtrArray *epdf_a      = g_ptr_array_sized_new (dim);
+    const guint block_len  = GSL_MAX (GSL_MIN (cat_len, _NCM_MSET_CATALOG_FUNC_BLOCK_SIZE), 1);
+    NcmMatrix *block       = ncm_matrix_new (block_len, dim);
+    NcmMSetCatalogFuncEval fe;
     guint i, j;
 
     ncm_mset_fparams_get_vector (mcat->mset, save_params);
-
-    if (mcat->quantile_ws == NULL)
-    {
-      mcat->quantile_ws = ncm_vector_new (dim);
-    }
-    else if (ncm_vector_len (mcat->quantile_ws) != dim)
-    {
-      ncm_vector_clear (&mcat->quantile_ws);
-      mcat->quantile_ws = ncm_vector_new (dim);
-    }
+    _ncm_mset_catalog_func_eval_init (&fe, mcat, func, x_v);
 
     g_ptr_array_set_free_func (epdf_a, (GDestroyNotify) ncm_stats_dist1d_free);
     for (i = 0; i < dim; i++)
@@ -3144,16 +3439,15 @@ ncm_mset_catalog_calc_ci_interp (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVec
 
     for (i = 0; i < cat_len; i++)
     {
-      NcmVector *row = ncm_mset_catalog_peek_row (mcat, i);
-
-      ncm_mset_fparams_set_vector_offset (mcat->mset, row, mcat->nadd_vals);
+      const guint bi = i % block_len;
 
-      ncm_mset_func_eval_vector (func, mcat->mset, x_v, mcat->quantile_ws);
+      if (bi == 0)
+        _ncm_mset_catalog_func_eval_block (&fe, i, GSL_MIN (block_len, cat_len - i), block);
 
       for (j = 0; j < dim; j++)
       {
         NcmStatsDist1dEPDF *epdf = g_ptr_array_index (epdf_a, j);
-        ncm_stats_dist1d_epdf_add_obs (epdf, ncm_vector_get (mcat->quantile_ws, j));
+        ncm_stats_dist1d_epdf_add_obs (epdf, ncm_matrix_get (block, bi, j));
       }
       if (i % (cat_len / 100) == 0)
       {
@@ -3197,6 +3491,8 @@ ncm_mset_catalog_calc_ci_interp (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVec
       }
     }
 
+    _ncm_mset_catalog_func_eval_clear (&fe);
+    ncm_matrix_free (block);
     g_ptr_array_unref (epdf_a);
     ncm_mset_fparams_set_vector (mcat->mset, save_params);
     ncm_vector_free (save_params);
@@ -3236,19 +3532,13 @@ ncm_mset_catalog_calc_pvalue (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVector
     NcmVector *save_params = ncm_vector_new (ncm_mset_fparams_len (mcat->mset));
     const guint cat_len    = ncm_mset_catalog_len (mcat);
     GPtrArray *epdf_a      = g_ptr_array_sized_new (dim);
+    const guint block_len  = GSL_MAX (GSL_MIN (cat_len, _NCM_MSET_CATALOG_FUNC_BLOCK_SIZE), 1);
+    NcmMatrix *block       = ncm_matrix_new (block_len, dim);
+    NcmMSetCatalogFuncEval fe;
     guint i, j;
 
     ncm_mset_fparams_get_vector (mcat->mset, save_params);
-
-    if (mcat->quantile_ws == NULL)
-    {
-      mcat->quantile_ws = ncm_vector_new (dim);
-    }
-    else if (ncm_vector_len (mcat->quantile_ws) != dim)
-    {
-      ncm_vector_clear (&mcat->quantile_ws);
-      mcat->quantile_ws = ncm_vector_new (dim);
-    }
+    _ncm_mset_catalog_func_eval_init (&fe, mcat, func, x_v);
 
     g_ptr_array_set_free_func (epdf_a, (GDestroyNotify) ncm_stats_dist1d_free);
     for (i = 0; i < dim; i++)
@@ -3267,16 +3557,15 @@ ncm_mset_catalog_calc_pvalue (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVector
 
     for (i = 0; i < cat_len; i++)
     {
-      NcmVector *row = ncm_mset_catalog_peek_row (mcat, i);
-
-      ncm_mset_fparams_set_vector_offset (mcat->mset, row, mcat->nadd_vals);
+      const guint bi = i % block_len;
 
-      ncm_mset_func_eval_vector (func, mcat->mset, x_v, mcat->quantile_ws);
+      if (bi == 0)
+        _ncm_mset_catalog_func_eval_block (&fe, i, GSL_MIN (block_len, cat_len - i), block);
 
       for (j = 0; j < dim; j++)
       {
         NcmStatsDist1dEPDF *epdf = g_ptr_array_index (epdf_a, j);
-        ncm_stats_dist1d_epdf_add_obs (epdf, ncm_vector_get (mcat->quantile_ws, j));
+        ncm_stats_dist1d_epdf_add_obs (epdf, ncm_matrix_get (block, bi, j));
       }
       if (i % (cat_len / 100) == 0)
       {
@@ -3321,6 +3610,8 @@ ncm_mset_catalog_calc_pvalue (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVector
       }
     }
 
+    _ncm_mset_catalog_func_eval_clear (&fe);
+    ncm_matrix_free (block);
     g_ptr_array_unref (epdf_a);
     ncm_mset_fparams_set_vector (mcat->mset, save_params);
     ncm_vector_free (save_params);
@@ -3350,9 +3641,13 @@ ncm_mset_catalog_calc_distrib (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmFitRu
     NcmStatsDist1dEPDF *epdf1d = ncm_stats_dist1d_epdf_new (NCM_MSET_CATALOG_DIST_EST_SD_SCALE);
     NcmVector *save_params = ncm_vector_new (ncm_mset_fparams_len (mcat->mset));
     const guint cat_len = ncm_mset_catalog_len (mcat);
+    const guint block_len = GSL_MAX (GSL_MIN (cat_len, _NCM_MSET_CATALOG_FUNC_BLOCK_SIZE), 1);
+    NcmMatrix *block = ncm_matrix_new (block_len, 1);
+    NcmMSetCatalogFuncEval fe;
     guint i;
 
     ncm_mset_fparams_get_vector (mcat->mset, save_params);
+    _ncm_mset_catalog_func_eval_init (&fe, mcat, func, NULL);
 
     if (mtype > NCM_FIT_RUN_MSGS_NONE)
     {
@@ -3364,12 +3659,12 @@ ncm_mset_catalog_calc_distrib (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmFitRu
 
     for (i = 0; i < cat_len; i++)
     {
-      NcmVector *row = ncm_mset_catalog_peek_row (mcat, i);
-      gdouble x;
+      const guint bi = i % block_len;
 
-      ncm_mset_fparams_set_vector_offset (mcat->mset, row, mcat->nadd_vals);
-      x = ncm_mset_func_eval0 (func, mcat->mset);
-      ncm_stats_dist1d_epdf_add_obs (epdf1d, x);
+      if (bi == 0)
+        _ncm_mset_catalog_func_eval_block (&fe, i, GSL_MIN (block_len, cat_len - i), block);
+
+      ncm_stats_dist1d_epdf_add_obs (epdf1d, ncm_matrix_get (block, bi, 0));
 
       if (i % (cat_len / 100) == 0)
       {
@@ -3392,6 +3687,8 @@ ncm_mset_catalog_calc_distrib (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmFitRu
 
     ncm_stats_dist1d_prepare (NCM_STATS_DIST1D (epdf1d));
 
+    _ncm_mset_catalog_func_eval_clear (&fe);
+    ncm_matrix_free (block);
     ncm_mset_fparams_set_vector (mcat->mset, save_params);
     ncm_vector_free (save_params);
     return NCM_STATS_DIST1D (epdf1d);
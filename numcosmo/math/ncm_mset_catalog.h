@@ -50,6 +50,7 @@ G_BEGIN_DECLS
 
 typedef struct _NcmMSetCatalogClass NcmMSetCatalogClass;
 typedef struct _NcmMSetCatalog NcmMSetCatalog;
+typedef struct _NcmMSetCatalogFuncEval NcmMSetCatalogFuncEval;
 
 struct _NcmMSetCatalogClass
 {
@@ -155,6 +156,7 @@ struct _NcmMSetCatalog
   glong pdf_i;
   gsl_histogram *h;
   gsl_histogram_pdf *h_pdf;
+  guint nthreads;
   gboolean constructed;
 };
 
@@ -200,6 +202,9 @@ glong ncm_mset_catalog_get_burnin (NcmMSetCatalog *mcat);
 void ncm_mset_catalog_set_tau_method (NcmMSetCatalog *mcat, NcmMSetCatalogTauMethod tau_method);
 NcmMSetCatalogTauMethod ncm_mset_catalog_get_tau_method (NcmMSetCatalog *mcat);
 
+void ncm_mset_catalog_set_nthreads (NcmMSetCatalog *mcat, guint nthreads);
+guint ncm_mset_catalog_get_nthreads (NcmMSetCatalog *mcat);
+
 void ncm_mset_catalog_add_from_mset (NcmMSetCatalog *mcat, NcmMSet *mset, ...) G_GNUC_NULL_TERMINATED;
 void ncm_mset_catalog_add_from_mset_array (NcmMSetCatalog *mcat, NcmMSet *mset, gdouble *ax);
 void ncm_mset_catalog_add_from_vector (NcmMSetCatalog *mcat, NcmVector *vals);
@@ -229,6 +234,11 @@ gdouble ncm_mset_catalog_get_shrink_factor (NcmMSetCatalog *mcat);
 void ncm_mset_catalog_param_pdf (NcmMSetCatalog *mcat, guint i);
 gdouble ncm_mset_catalog_param_pdf_pvalue (NcmMSetCatalog *mcat, gdouble pvalue, gboolean both);
 
+NcmMSetCatalogFuncEval *ncm_mset_catalog_func_eval_new (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVector *x_v);
+void ncm_mset_catalog_func_eval_free (NcmMSetCatalogFuncEval *fe);
+void ncm_mset_catalog_func_eval_rows (NcmMSetCatalogFuncEval *fe, guint row_i, NcmMatrix *res);
+
+void ncm_mset_catalog_calc_func_rows (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVector *x_v, guint row_i, NcmMatrix *res);
 NcmMatrix *ncm_mset_catalog_calc_ci_direct (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVector *x_v, GArray *p_val);
 NcmMatrix *ncm_mset_catalog_calc_ci_interp (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVector *x_v, GArray *p_val, guint nodes, NcmFitRunMsgs mtype);
 NcmMatrix *ncm_mset_catalog_calc_pvalue (NcmMSetCatalog *mcat, NcmMSetFunc *func, NcmVector *x_v, GArray *lim, guint nodes, NcmFitRunMsgs mtype);
@@ -268,6 +278,7 @@ guint ncm_mset_catalog_heidel_diag_by_chain (NcmMSetCatalog *mcat, const guint n
 #define NCM_MSET_CATALOG_FSYMB_LABEL "FSYMB"
 #define NCM_MSET_CATALOG_ASYMB_LABEL "ASYMB"
 #define NCM_MSET_CATALOG_DIST_EST_SD_SCALE (1.0e-3)
+#define NCM_MSET_CATALOG_DIAG_MAX_LAG (256)
 
 G_END_DECLS
 
@@ -60,6 +60,7 @@
 #include "math/ncm_powspec_filter.h"
 #include "math/ncm_spline_cubic_notaknot.h"
 #include "math/ncm_spline2d_bicubic.h"
+#include "math/ncm_arena.h"
 #include "ncm_enum_types.h"
 
 enum
@@ -477,11 +478,14 @@ ncm_powspec_filter_prepare (NcmPowspecFilter *psf, NcmModel *model)
     lnvar   = ncm_matrix_new (N_z, N_k);
     dlnvar  = ncm_matrix_new (N_z, N_k);
     lnr_vec = ncm_fftlog_get_vector_lnr (psf->fftlog);
-        
+
     for (i = 0; i < N_z; i++)
     {
-      NcmVector *var_z  = ncm_matrix_get_row (lnvar, i);
-      NcmVector *dvar_z = ncm_matrix_get_row (dlnvar, i);
+      NcmVector *var_z, *dvar_z;
+
+      ncm_arena_push ();
+      var_z  = ncm_arena_matrix_get_row (lnvar, i);
+      dvar_z = ncm_arena_matrix_get_row (dlnvar, i);
 
       arg.z = ncm_vector_get (z_vec, i);
       ncm_fftlog_eval_by_gsl_function (psf->fftlog, &F);
@@ -490,9 +494,7 @@ ncm_powspec_filter_prepare (NcmPowspecFilter *psf, NcmModel *model)
       ncm_vector_memcpy (dvar_z, ncm_fftlog_peek_output_vector (psf->fftlog, 1));
 
       /*ncm_vector_log_vals (var_z, "NADA: ", "% 11.5e");*/
-
-      ncm_vector_free (var_z);
-      ncm_vector_free (dvar_z);
+      ncm_arena_pop ();
     }
 
     ncm_spline2d_set (psf->var, lnr_vec, z_vec, lnvar, TRUE);
@@ -515,14 +517,18 @@ ncm_powspec_filter_prepare (NcmPowspecFilter *psf, NcmModel *model)
 
     for (i = 0; i < N_z; i++)
     {
-      NcmVector *var_z  = ncm_matrix_get_row (lnvar, i);
-      NcmVector *dvar_z = ncm_matrix_get_row (dlnvar, i);
+      NcmVector *var_z, *dvar_z;
+
+      ncm_arena_push ();
+      var_z  = ncm_arena_matrix_get_row (lnvar, i);
+      dvar_z = ncm_arena_matrix_get_row (dlnvar, i);
 
       arg.z = ncm_vector_get (psf->var->yv, i);
       ncm_fftlog_eval_by_gsl_function (psf->fftlog, &F);
 
       ncm_vector_memcpy (var_z, ncm_fftlog_peek_output_vector (psf->fftlog, 0));
       ncm_vector_memcpy (dvar_z, ncm_fftlog_peek_output_vector (psf->fftlog, 1));
+      ncm_arena_pop ();
     }
 
     ncm_spline2d_prepare (psf->var);
@@ -0,0 +1,551 @@
+/***************************************************************************
+ *            ncm_profiler.c
+ *
+ *  Sun October 18 10:12:43 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_profiler.c
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:ncm_profiler
+ * @title: NcmProfiler
+ * @short_description: Opt-in hot-path profiler for likelihood evaluations.
+ *
+ * This module implements a process-wide registry of named timing entries.
+ * When enabled (see ncm_profiler_enable() or the environment variable
+ * NUMCOSMO_PROFILE), the #NcmData methods prepare and m2lnL_val, the
+ * #NcmModelCtrl update checks and the main numerical kernels (distance
+ * tables, covariance factorizations, Boltzmann solver stages and cluster
+ * abundance integrals) register their call counts and latencies here.
+ *
+ * Each entry keeps the number of calls, the cumulative time, minimum,
+ * maximum and the running 50%, 90% and 99% latency percentiles. For the
+ * model control entries the number of hits (no update needed) and misses
+ * (update needed) is also recorded.
+ *
+ * The report is written in JSON format by ncm_profiler_report_to_file().
+ * The top-level drivers, e.g., ncm_fit_mc_run(), ncm_fit_mcmc_run(),
+ * ncm_fit_esmcmc_run() and ncm_fit_nested_run(), call
+ * ncm_profiler_report_if_enabled() at the end of their runs, which writes
+ * the report to the file set by ncm_profiler_set_report_file() (or the
+ * value of NUMCOSMO_PROFILE). The inner refits, i.e., ncm_fit_run(), do
+ * not write the report, call ncm_profiler_report_if_enabled() after a
+ * standalone fit.
+ *
+ * When disabled, the instrumented code pays only the cost of
+ * ncm_profiler_is_enabled(), i.e., a function call and an atomic read.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif /* HAVE_CONFIG_H */
+#include "build_cfg.h"
+
+#include "math/ncm_profiler.h"
+#include "math/ncm_timer.h"
+#include "math/ncm_cfg.h"
+#include "math/ncm_util.h"
+#include "math/gsl_rstat.h"
+
+#include <math.h>
+#include <gsl/gsl_math.h>
+
+typedef struct _NcmProfilerEntry
+{
+  gchar *name;
+  GMutex update;
+  guint64 ncalls;
+  guint64 nhits;
+  guint64 nmisses;
+  gdouble total;
+  gdouble min;
+  gdouble max;
+  gsl_rstat_quantile_workspace *p50;
+  gsl_rstat_quantile_workspace *p90;
+  gsl_rstat_quantile_workspace *p99;
+} NcmProfilerEntry;
+
+static gint _ncm_profiler_enabled    = 0;
+static GHashTable *_ncm_profiler_tab = NULL;
+static NcmTimer *_ncm_profiler_nt    = NULL;
+static gchar *_ncm_profiler_file     = NULL;
+static GRWLock _ncm_profiler_tab_lock;
+static GPrivate _ncm_profiler_gt     = G_PRIVATE_INIT ((GDestroyNotify) g_timer_destroy);
+
+G_LOCK_DEFINE_STATIC (profiler_cfg);
+
+static NcmProfilerEntry *
+_ncm_profiler_entry_new (const gchar *name)
+{
+  NcmProfilerEntry *entry = g_slice_new0 (NcmProfilerEntry);
+
+  entry->name = g_strdup (name);
+  entry->min  = GSL_POSINF;
+  entry->max  = 0.0;
+  entry->p50  = gsl_rstat_quantile_alloc (0.50);
+  entry->p90  = gsl_rstat_quantile_alloc (0.90);
+  entry->p99  = gsl_rstat_quantile_alloc (0.99);
+
+  g_mutex_init (&entry->update);
+
+  return entry;
+}
+
+static void
+_ncm_profiler_entry_free (NcmProfilerEntry *entry)
+{
+  g_free (entry->name);
+  gsl_rstat_quantile_free (entry->p50);
+  gsl_rstat_quantile_free (entry->p90);
+  gsl_rstat_quantile_free (entry->p99);
+  g_mutex_clear (&entry->update);
+
+  g_slice_free (NcmProfilerEntry, entry);
+}
+
+static void
+_ncm_profiler_entry_reset (NcmProfilerEntry *entry)
+{
+  g_mutex_lock (&entry->update);
+
+  entry->ncalls  = 0;
+  entry->nhits   = 0;
+  entry->nmisses = 0;
+  entry->total   = 0.0;
+  entry->min     = GSL_POSINF;
+  entry->max     = 0.0;
+
+  gsl_rstat_quantile_free (entry->p50);
+  gsl_rstat_quantile_free (entry->p90);
+  gsl_rstat_quantile_free (entry->p99);
+  entry->p50 = gsl_rstat_quantile_alloc (0.50);
+  entry->p90 = gsl_rstat_quantile_alloc (0.90);
+  entry->p99 = gsl_rstat_quantile_alloc (0.99);
+
+  g_mutex_unlock (&entry->update);
+}
+
+static NcmProfilerEntry *
+_ncm_profiler_peek_entry (const gchar *name)
+{
+  NcmProfilerEntry *entry;
+
+  g_rw_lock_reader_lock (&_ncm_profiler_tab_lock);
+  entry = (_ncm_profiler_tab != NULL) ? g_hash_table_lookup (_ncm_profiler_tab, name) : NULL;
+  g_rw_lock_reader_unlock (&_ncm_profiler_tab_lock);
+
+  if (entry == NULL)
+  {
+    g_rw_lock_writer_lock (&_ncm_profiler_tab_lock);
+    if (_ncm_profiler_tab == NULL)
+      _ncm_profiler_tab = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) _ncm_profiler_entry_free);
+
+    entry = g_hash_table_lookup (_ncm_profiler_tab, name);
+    if (entry == NULL)
+    {
+      entry = _ncm_profiler_entry_new (name);
+      g_hash_table_insert (_ncm_profiler_tab, entry->name, entry);
+    }
+    g_rw_lock_writer_unlock (&_ncm_profiler_tab_lock);
+  }
+
+  return entry;
+}
+
+/**
+ * ncm_profiler_enable:
+ *
+ * Enables the profiler, all instrumented code paths start to
+ * register their timings. The wall-clock used to compute the
+ * fractions in the report starts at the first call.
+ *
+ */
+void
+ncm_profiler_enable (void)
+{
+  G_LOCK (profiler_cfg);
+  if (_ncm_profiler_nt == NULL)
+  {
+    _ncm_profiler_nt = ncm_timer_new ();
+    ncm_timer_set_name (_ncm_profiler_nt, "NcmProfiler");
+    ncm_timer_start (_ncm_profiler_nt);
+  }
+  G_UNLOCK (profiler_cfg);
+
+  g_atomic_int_set (&_ncm_profiler_enabled, 1);
+}
+
+/**
+ * ncm_profiler_disable:
+ *
+ * Disables the profiler. The entries already collected are kept
+ * until ncm_profiler_reset() is called.
+ *
+ */
+void
+ncm_profiler_disable (void)
+{
+  g_atomic_int_set (&_ncm_profiler_enabled, 0);
+}
+
+/**
+ * ncm_profiler_is_enabled:
+ *
+ * Returns: whether the profiler is enabled.
+ */
+gboolean
+ncm_profiler_is_enabled (void)
+{
+  return g_atomic_int_get (&_ncm_profiler_enabled);
+}
+
+/**
+ * ncm_profiler_reset:
+ *
+ * Zeroes the counters of all entries and restarts the profiler
+ * wall-clock. The entries themselves are kept alive, since other
+ * threads may still be holding them, and are omitted from the report
+ * until they are used again.
+ *
+ */
+void
+ncm_profiler_reset (void)
+{
+  g_rw_lock_reader_lock (&_ncm_profiler_tab_lock);
+  if (_ncm_profiler_tab != NULL)
+  {
+    GHashTableIter iter;
+    gpointer key, value;
+
+    g_hash_table_iter_init (&iter, _ncm_profiler_tab);
+    while (g_hash_table_iter_next (&iter, &key, &value))
+      _ncm_profiler_entry_reset (value);
+  }
+  g_rw_lock_reader_unlock (&_ncm_profiler_tab_lock);
+
+  G_LOCK (profiler_cfg);
+  if (_ncm_profiler_nt != NULL)
+    ncm_timer_start (_ncm_profiler_nt);
+  G_UNLOCK (profiler_cfg);
+}
+
+/**
+ * ncm_profiler_set_report_file:
+ * @filename: (allow-none): report file name
+ *
+ * Sets the file used by ncm_profiler_report_if_enabled(). If
+ * @filename is NULL no report is automatically written.
+ *
+ */
+void
+ncm_profiler_set_report_file (const gchar *filename)
+{
+  G_LOCK (profiler_cfg);
+  g_clear_pointer (&_ncm_profiler_file, g_free);
+  _ncm_profiler_file = g_strdup (filename);
+  G_UNLOCK (profiler_cfg);
+}
+
+/**
+ * ncm_profiler_peek_report_file:
+ *
+ * Returns: (transfer none) (allow-none): the current report file name.
+ */
+const gchar *
+ncm_profiler_peek_report_file (void)
+{
+  return _ncm_profiler_file;
+}
+
+/**
+ * ncm_profiler_time:
+ *
+ * Gets the current value of the calling thread timer. The differences
+ * between two calls, in the same thread, are the values expected by
+ * ncm_profiler_add_call().
+ *
+ * Returns: the elapsed time in seconds since the first call in the
+ * current thread.
+ */
+gdouble
+ncm_profiler_time (void)
+{
+  GTimer *gt = g_private_get (&_ncm_profiler_gt);
+
+  if (G_UNLIKELY (gt == NULL))
+  {
+    gt = g_timer_new ();
+    g_private_set (&_ncm_profiler_gt, gt);
+  }
+
+  return g_timer_elapsed (gt, NULL);
+}
+
+/**
+ * ncm_profiler_add_call:
+ * @name: entry name
+ * @elapsed: call duration in seconds
+ *
+ * Registers one call of @name lasting @elapsed seconds. The entry is
+ * created on the first call. This function is thread safe.
+ *
+ */
+void
+ncm_profiler_add_call (const gchar *name, const gdouble elapsed)
+{
+  NcmProfilerEntry *entry = _ncm_profiler_peek_entry (name);
+
+  g_mutex_lock (&entry->update);
+
+  entry->ncalls++;
+  entry->total += elapsed;
+  entry->min    = GSL_MIN (entry->min, elapsed);
+  entry->max    = GSL_MAX (entry->max, elapsed);
+
+  gsl_rstat_quantile_add (elapsed, entry->p50);
+  gsl_rstat_quantile_add (elapsed, entry->p90);
+  gsl_rstat_quantile_add (elapsed, entry->p99);
+
+  g_mutex_unlock (&entry->update);
+}
+
+/**
+ * ncm_profiler_add_hit:
+ * @name: entry name
+ * @miss: whether the cached state had to be recomputed
+ *
+ * Registers one cache check of @name, it is accounted as
+ * a miss if @miss is TRUE and as a hit otherwise.
+ *
+ */
+void
+ncm_profiler_add_hit (const gchar *name, gboolean miss)
+{
+  NcmProfilerEntry *entry = _ncm_profiler_peek_entry (name);
+
+  g_mutex_lock (&entry->update);
+  if (miss)
+    entry->nmisses++;
+  else
+    entry->nhits++;
+  g_mutex_unlock (&entry->update);
+}
+
+/**
+ * ncm_profiler_start:
+ *
+ * Convenience function to be used together with ncm_profiler_stop()
+ * around a kernel. When the profiler is disabled it returns a negative
+ * number and ncm_profiler_stop() does nothing.
+ *
+ * Returns: the start time or -1.0 if the profiler is disabled.
+ */
+gdouble
+ncm_profiler_start (void)
+{
+  if (ncm_profiler_is_enabled ())
+    return ncm_profiler_time ();
+  else
+    return -1.0;
+}
+
+/**
+ * ncm_profiler_stop:
+ * @name: entry name
+ * @t0: start time obtained from ncm_profiler_start()
+ *
+ * Registers one call of @name started at @t0. Nothing is done
+ * if @t0 is negative, i.e., the profiler was disabled when the
+ * kernel started.
+ *
+ */
+void
+ncm_profiler_stop (const gchar *name, const gdouble t0)
+{
+  if (t0 >= 0.0)
+    ncm_profiler_add_call (name, ncm_profiler_time () - t0);
+}
+
+static gint
+_ncm_profiler_cmp_total (gconstpointer a, gconstpointer b)
+{
+  const NcmProfilerEntry *ea = *(NcmProfilerEntry **) a;
+  const NcmProfilerEntry *eb = *(NcmProfilerEntry **) b;
+
+  if (ea->total > eb->total)
+    return -1;
+  else if (ea->total < eb->total)
+    return 1;
+  else
+    return g_strcmp0 (ea->name, eb->name);
+}
+
+static void
+_ncm_profiler_json_double (GString *json, const gchar *key, gdouble val)
+{
+  gchar buf[G_ASCII_DTOSTR_BUF_SIZE];
+
+  if (!gsl_finite (val))
+    val = 0.0;
+  g_string_append_printf (json, "\"%s\": %s", key, g_ascii_formatd (buf, G_ASCII_DTOSTR_BUF_SIZE, "%.9e", val));
+}
+
+static void
+_ncm_profiler_json_string (GString *json, const gchar *str)
+{
+  g_string_append_c (json, '"');
+  for (; *str != '\0'; str++)
+  {
+    if ((*str == '"') || (*str == '\\'))
+      g_string_append_c (json, '\\');
+    g_string_append_c (json, *str);
+  }
+  g_string_append_c (json, '"');
+}
+
+/**
+ * ncm_profiler_report_json:
+ *
+ * Builds a JSON report containing all entries sorted by
+ * cumulative time. Times are given in seconds.
+ *
+ * Returns: (transfer full): the report as a JSON string.
+ */
+gchar *
+ncm_profiler_report_json (void)
+{
+  GString *json     = g_string_new ("{\n");
+  GPtrArray *sorted = g_ptr_array_new ();
+  gdouble wall      = 0.0;
+  guint i;
+
+  G_LOCK (profiler_cfg);
+  if (_ncm_profiler_nt != NULL)
+    wall = ncm_timer_elapsed (_ncm_profiler_nt);
+  G_UNLOCK (profiler_cfg);
+
+  g_rw_lock_reader_lock (&_ncm_profiler_tab_lock);
+  if (_ncm_profiler_tab != NULL)
+  {
+    GHashTableIter iter;
+    gpointer key, value;
+
+    g_hash_table_iter_init (&iter, _ncm_profiler_tab);
+    while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      NcmProfilerEntry *entry = value;
+      gboolean used;
+
+      g_mutex_lock (&entry->update);
+      used = (entry->ncalls + entry->nhits + entry->nmisses) > 0;
+      g_mutex_unlock (&entry->update);
+
+      if (used)
+        g_ptr_array_add (sorted, entry);
+    }
+  }
+  g_ptr_array_sort (sorted, _ncm_profiler_cmp_total);
+
+  g_string_append (json, "  ");
+  _ncm_profiler_json_double (json, "wall-time", wall);
+  g_string_append (json, ",\n  \"entries\": [");
+
+  for (i = 0; i < sorted->len; i++)
+  {
+    NcmProfilerEntry *entry = g_ptr_array_index (sorted, i);
+
+    g_mutex_lock (&entry->update);
+
+    g_string_append_printf (json, "%s\n    {\"name\": ", (i == 0) ? "" : ",");
+    _ncm_profiler_json_string (json, entry->name);
+    g_string_append_printf (json, ", \"ncalls\": %" G_GUINT64_FORMAT, entry->ncalls);
+    g_string_append_printf (json, ", \"hits\": %" G_GUINT64_FORMAT, entry->nhits);
+    g_string_append_printf (json, ", \"misses\": %" G_GUINT64_FORMAT ", ", entry->nmisses);
+    _ncm_profiler_json_double (json, "total", entry->total);
+    g_string_append (json, ", ");
+    _ncm_profiler_json_double (json, "fraction", (wall > 0.0) ? entry->total / wall : 0.0);
+    g_string_append (json, ", ");
+    _ncm_profiler_json_double (json, "mean", (entry->ncalls > 0) ? entry->total / entry->ncalls : 0.0);
+    g_string_append (json, ", ");
+    _ncm_profiler_json_double (json, "min", (entry->ncalls > 0) ? entry->min : 0.0);
+    g_string_append (json, ", ");
+    _ncm_profiler_json_double (json, "max", entry->max);
+    g_string_append (json, ", ");
+    _ncm_profiler_json_double (json, "p50", (entry->ncalls > 0) ? gsl_rstat_quantile_get (entry->p50) : 0.0);
+    g_string_append (json, ", ");
+    _ncm_profiler_json_double (json, "p90", (entry->ncalls > 0) ? gsl_rstat_quantile_get (entry->p90) : 0.0);
+    g_string_append (json, ", ");
+    _ncm_profiler_json_double (json, "p99", (entry->ncalls > 0) ? gsl_rstat_quantile_get (entry->p99) : 0.0);
+    g_string_append (json, "}");
+
+    g_mutex_unlock (&entry->update);
+  }
+  g_rw_lock_reader_unlock (&_ncm_profiler_tab_lock);
+
+  g_string_append (json, "\n  ]\n}\n");
+  g_ptr_array_unref (sorted);
+
+  return g_string_free (json, FALSE);
+}
+
+/**
+ * ncm_profiler_report_to_file:
+ * @filename: report file name
+ *
+ * Writes the JSON report (see ncm_profiler_report_json()) to @filename.
+ *
+ */
+void
+ncm_profiler_report_to_file (const gchar *filename)
+{
+  GError *error = NULL;
+  gchar *json   = ncm_profiler_report_json ();
+
+  if (!g_file_set_contents (filename, json, -1, &error))
+    g_error ("ncm_profiler_report_to_file: cannot write report `%s': %s", filename, error->message);
+
+  g_free (json);
+}
+
+/**
+ * ncm_profiler_report_if_enabled:
+ *
+ * Writes the report to the file set by ncm_profiler_set_report_file()
+ * if the profiler is enabled and a file was set, otherwise does nothing.
+ *
+ */
+void
+ncm_profiler_report_if_enabled (void)
+{
+  if (ncm_profiler_is_enabled ())
+  {
+    gchar *filename;
+
+    G_LOCK (profiler_cfg);
+    filename = g_strdup (_ncm_profiler_file);
+    G_UNLOCK (profiler_cfg);
+
+    if (filename != NULL)
+      ncm_profiler_report_to_file (filename);
+
+    g_free (filename);
+  }
+}
@@ -0,0 +1,57 @@
+/***************************************************************************
+ *            ncm_profiler.h
+ *
+ *  Sun October 18 10:12:43 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_profiler.h
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _NCM_PROFILER_H_
+#define _NCM_PROFILER_H_
+
+#include <glib.h>
+#include <numcosmo/build_cfg.h>
+
+G_BEGIN_DECLS
+
+void ncm_profiler_enable (void);
+void ncm_profiler_disable (void);
+gboolean ncm_profiler_is_enabled (void);
+void ncm_profiler_reset (void);
+
+void ncm_profiler_set_report_file (const gchar *filename);
+const gchar *ncm_profiler_peek_report_file (void);
+
+gdouble ncm_profiler_time (void);
+void ncm_profiler_add_call (const gchar *name, const gdouble elapsed);
+void ncm_profiler_add_hit (const gchar *name, gboolean miss);
+
+gdouble ncm_profiler_start (void);
+void ncm_profiler_stop (const gchar *name, const gdouble t0);
+
+gchar *ncm_profiler_report_json (void);
+void ncm_profiler_report_to_file (const gchar *filename);
+void ncm_profiler_report_if_enabled (void);
+
+#define NCM_PROFILER_ENV "NUMCOSMO_PROFILE"
+
+G_END_DECLS
+
+#endif /* _NCM_PROFILER_H_ */
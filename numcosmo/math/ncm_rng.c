@@ -31,6 +31,16 @@
  * This object encapsulates the GSL pseudo random number generator (PRNG). The purpose is to
  * add support for saving and loading state and multhreading.
  * 
+ * Besides the GSL algorithms, the counter-based generator Philox4x32-10 is also
+ * available under the name #NCM_RNG_PHILOX4X32_NAME. Its state is just a key and
+ * a counter, for this reason it supports cheap reproducible substreams, see
+ * ncm_rng_substream_new() and ncm_rng_substream_set(). The substream @stream of a
+ * master #NcmRNG uses the master key and a disjoint counter range labeled by
+ * @stream, therefore, it depends only on the master state (as returned by
+ * ncm_rng_get_state()) and on @stream. This allows each thread to draw from its own
+ * generator without locking the master, while the results do not depend on the
+ * number of threads or on the thread scheduling.
+ * 
  */
 
 #ifdef HAVE_CONFIG_H
@@ -51,6 +61,115 @@ enum
 
 G_DEFINE_TYPE (NcmRNG, ncm_rng, G_TYPE_OBJECT);
 
+/*
+ * Philox4x32-10 counter-based generator, see
+ * Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11 (2011).
+ */
+
+#define _NCM_RNG_PHILOX_M0 (0xD2511F53U)
+#define _NCM_RNG_PHILOX_M1 (0xCD9E8D57U)
+#define _NCM_RNG_PHILOX_W0 (0x9E3779B9U)
+#define _NCM_RNG_PHILOX_W1 (0xBB67AE85U)
+#define _NCM_RNG_PHILOX_ROUNDS (10)
+
+typedef struct _NcmRNGPhiloxState
+{
+  guint32 key[2];
+  guint32 ctr[4];
+  guint32 out[4];
+  guint32 pos;
+} NcmRNGPhiloxState;
+
+static guint64
+_ncm_rng_splitmix64 (guint64 x)
+{
+  x += G_GUINT64_CONSTANT (0x9E3779B97F4A7C15);
+  x  = (x ^ (x >> 30)) * G_GUINT64_CONSTANT (0xBF58476D1CE4E5B9);
+  x  = (x ^ (x >> 27)) * G_GUINT64_CONSTANT (0x94D049BB133111EB);
+  return x ^ (x >> 31);
+}
+
+static void
+_ncm_rng_philox_block (NcmRNGPhiloxState *state)
+{
+  guint32 k0 = state->key[0];
+  guint32 k1 = state->key[1];
+  guint32 c0 = state->ctr[0];
+  guint32 c1 = state->ctr[1];
+  guint32 c2 = state->ctr[2];
+  guint32 c3 = state->ctr[3];
+  guint r;
+
+  for (r = 0; r < _NCM_RNG_PHILOX_ROUNDS; r++)
+  {
+    const guint64 p0 = ((guint64) _NCM_RNG_PHILOX_M0) * c0;
+    const guint64 p1 = ((guint64) _NCM_RNG_PHILOX_M1) * c2;
+
+    c0 = ((guint32) (p1 >> 32)) ^ c1 ^ k0;
+    c1 = (guint32) p1;
+    c2 = ((guint32) (p0 >> 32)) ^ c3 ^ k1;
+    c3 = (guint32) p0;
+
+    k0 += _NCM_RNG_PHILOX_W0;
+    k1 += _NCM_RNG_PHILOX_W1;
+  }
+
+  state->out[0] = c0;
+  state->out[1] = c1;
+  state->out[2] = c2;
+  state->out[3] = c3;
+
+  /* The first two words are the counter inside a substream, the last two label the substream. */
+  if (++state->ctr[0] == 0)
+    ++state->ctr[1];
+}
+
+static void
+_ncm_rng_philox_set (void *vstate, unsigned long int s)
+{
+  NcmRNGPhiloxState *state = (NcmRNGPhiloxState *) vstate;
+  const guint64 key        = _ncm_rng_splitmix64 (s);
+
+  state->key[0] = (guint32) key;
+  state->key[1] = (guint32) (key >> 32);
+  state->ctr[0] = 0;
+  state->ctr[1] = 0;
+  state->ctr[2] = 0;
+  state->ctr[3] = 0;
+  state->pos    = 4;
+}
+
+static unsigned long int
+_ncm_rng_philox_get (void *vstate)
+{
+  NcmRNGPhiloxState *state = (NcmRNGPhiloxState *) vstate;
+
+  if (state->pos == 4)
+  {
+    _ncm_rng_philox_block (state);
+    state->pos = 0;
+  }
+
+  return state->out[state->pos++];
+}
+
+static double
+_ncm_rng_philox_get_double (void *vstate)
+{
+  return _ncm_rng_philox_get (vstate) / 4294967296.0;
+}
+
+static const gsl_rng_type _ncm_rng_philox4x32_type =
+{
+  NCM_RNG_PHILOX4X32_NAME,
+  0xFFFFFFFFUL,
+  0,
+  sizeof (NcmRNGPhiloxState),
+  &_ncm_rng_philox_set,
+  &_ncm_rng_philox_get,
+  &_ncm_rng_philox_get_double
+};
+
 static void
 ncm_rng_init (NcmRNG *rng)
 {
@@ -324,7 +443,11 @@ ncm_rng_set_algo (NcmRNG *rng, const gchar *algo)
   const gsl_rng_type *type;
   gboolean found = FALSE;
   
-  if (algo != NULL)
+  if ((algo != NULL) && (strcmp (algo, _ncm_rng_philox4x32_type.name) == 0))
+  {
+    type = &_ncm_rng_philox4x32_type;
+  }
+  else if (algo != NULL)
   {
     const gsl_rng_type **t;
     const gsl_rng_type **t0;
@@ -497,6 +620,84 @@ ncm_rng_pool_get (const gchar *name)
   return rng;
 }
 
+/**
+ * ncm_rng_has_substreams:
+ * @rng: a #NcmRNG
+ * 
+ * Checks whether @rng uses a counter-based algorithm and, therefore,
+ * supports substreams.
+ * 
+ * Returns: whether @rng supports substreams.
+ */
+gboolean 
+ncm_rng_has_substreams (NcmRNG *rng)
+{
+  return (strcmp (gsl_rng_name (rng->r), _ncm_rng_philox4x32_type.name) == 0);
+}
+
+/**
+ * ncm_rng_substream_set:
+ * @rng: a #NcmRNG
+ * @sub: a #NcmRNG
+ * @stream: substream index
+ * 
+ * Sets the state of @sub to the substream @stream of @rng. Both
+ * @rng and @sub must support substreams, see ncm_rng_has_substreams().
+ * The master @rng is only read, its state is not changed and there is no
+ * need to lock it. Setting a substream costs the same as drawing one
+ * random number, so it is cheap to use one substream per task.
+ * 
+ */
+void 
+ncm_rng_substream_set (NcmRNG *rng, NcmRNG *sub, guint64 stream)
+{
+  NcmRNGPhiloxState *master_state;
+  NcmRNGPhiloxState *sub_state;
+
+  if (!ncm_rng_has_substreams (rng))
+    g_error ("ncm_rng_substream_set: the algorithm `%s' does not support substreams, use `%s'.",
+             ncm_rng_get_algo (rng), NCM_RNG_PHILOX4X32_NAME);
+  g_assert (ncm_rng_has_substreams (sub));
+  g_assert (stream < G_MAXUINT64);
+
+  master_state = (NcmRNGPhiloxState *) gsl_rng_state (rng->r);
+  sub_state    = (NcmRNGPhiloxState *) gsl_rng_state (sub->r);
+
+  /* stream + 1 keeps the substreams disjoint from the master stream. */
+  sub_state->key[0] = master_state->key[0];
+  sub_state->key[1] = master_state->key[1];
+  sub_state->ctr[0] = 0;
+  sub_state->ctr[1] = 0;
+  sub_state->ctr[2] = (guint32) (stream + 1);
+  sub_state->ctr[3] = (guint32) ((stream + 1) >> 32);
+  sub_state->pos    = 4;
+
+  sub->seed_val = rng->seed_val;
+  sub->seed_set = TRUE;
+}
+
+/**
+ * ncm_rng_substream_new:
+ * @rng: a #NcmRNG
+ * @stream: substream index
+ * 
+ * Creates a new #NcmRNG set to the substream @stream of @rng,
+ * see ncm_rng_substream_set().
+ * 
+ * Returns: (transfer full): a new #NcmRNG.
+ */
+NcmRNG *
+ncm_rng_substream_new (NcmRNG *rng, guint64 stream)
+{
+  NcmRNG *sub = g_object_new (NCM_TYPE_RNG, 
+                              "algorithm", NCM_RNG_PHILOX4X32_NAME, 
+                              NULL);
+
+  ncm_rng_substream_set (rng, sub, stream);
+
+  return sub;
+}
+
 /**
  * ncm_rng_uniform_gen:
  * @rng: a #NcmRNG
@@ -84,6 +84,10 @@ void ncm_rng_set_random_seed (NcmRNG *rng, gboolean allow_colisions);
 
 NcmRNG *ncm_rng_pool_get (const gchar *name);
 
+gboolean ncm_rng_has_substreams (NcmRNG *rng);
+NcmRNG *ncm_rng_substream_new (NcmRNG *rng, guint64 stream);
+void ncm_rng_substream_set (NcmRNG *rng, NcmRNG *sub, guint64 stream);
+
 G_INLINE_FUNC gdouble ncm_rng_uniform_gen (NcmRNG *rng, const gdouble xl, const gdouble xu); 
 G_INLINE_FUNC gdouble ncm_rng_gaussian_gen (NcmRNG *rng, const gdouble mu, const gdouble sigma); 
 G_INLINE_FUNC gdouble ncm_rng_gaussian_tail_gen (NcmRNG *rng, const gdouble a, const gdouble sigma); 
@@ -93,6 +97,8 @@ G_INLINE_FUNC gdouble ncm_rng_exppow_gen (NcmRNG *rng, const gdouble a, const gd
 G_INLINE_FUNC gdouble ncm_rng_beta_gen (NcmRNG *rng, const gdouble a, const gdouble b);
 G_INLINE_FUNC gdouble ncm_rng_gamma_gen (NcmRNG *rng, const gdouble a, const gdouble b);
 
+#define NCM_RNG_PHILOX4X32_NAME "philox4x32"
+
 G_END_DECLS
 
 #endif /* _NCM_RNG_H_ */
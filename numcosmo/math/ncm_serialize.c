@@ -30,6 +30,19 @@
  *
  * FIXME
  *
+ * Besides the text (ncm_serialize_to_file()) and raw #GVariant 
+ * (ncm_serialize_to_binfile()) formats, objects can be saved in a versioned
+ * binary container using ncm_serialize_to_mapped_file(). The container has a
+ * 64 bytes header (magic #NCM_SERIALIZE_MAPPED_MAGIC, format version, byte 
+ * order mark, payload offset and size) followed by the #GVariant serialized
+ * object. The payload starts at a 64 bytes boundary and the #GVariant format 
+ * aligns the arrays of doubles, hence ncm_serialize_from_mapped_file() can 
+ * mmap the file and the #NcmVector and #NcmMatrix objects are created 
+ * pointing to the mapped memory, without parsing or copying their values. 
+ * The mapping is private (copy-on-write), changing these objects never 
+ * changes the file. ncm_serialize_from_file() recognizes this format and 
+ * uses ncm_serialize_from_mapped_file() automatically.
+ *
  */
 
 #ifdef HAVE_CONFIG_H
@@ -44,6 +57,11 @@
 #include "math/ncm_matrix.h"
 #include "ncm_enum_types.h"
 #include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 enum
 {
@@ -71,6 +89,8 @@ ncm_serialize_init (NcmSerialize *ser)
   ser->is_named_regex  = g_regex_new ("^\\s*([A-Za-z][A-Za-z0-9\\+\\_]+)\\s*\\[([A-Za-z0-9\\:]+)\\]\\s*$", 0, 0, &error);
   ser->parse_obj_regex = g_regex_new ("^\\s*([A-Za-z][A-Za-z0-9\\+\\_]+\\s*(?:\\[[A-Za-z0-9\\:]+\\])?)\\s*([\\{]?.*[\\}]?)\\s*$", 0, 0, &error);
   ser->autosave_count  = 0;
+  ser->zero_copy       = 0;
+  ser->shared_count    = 0;
 }
 
 static void
@@ -830,6 +850,10 @@ ncm_serialize_from_file (NcmSerialize *ser, const gchar *filename)
   GObject *obj = NULL;
 
   g_assert (filename != NULL);
+
+  if (ncm_serialize_is_mapped_file (filename))
+    return ncm_serialize_from_mapped_file (ser, filename);
+
   if (!g_file_get_contents (filename, &file, &length, &error))
     g_error ("ncm_serialize_from_file: cannot open file %s: %s",
              filename, error->message);
@@ -885,6 +909,224 @@ ncm_serialize_from_binfile (NcmSerialize *ser, const gchar *filename)
   return obj;
 }
 
+/*
+ * Inside ncm_serialize_from_mapped_file() vectors and matrices wrap the
+ * memory of their variants (the mapped file) instead of copying it.
+ */
+static NcmVector *
+_ncm_serialize_vector_new_variant (NcmSerialize *ser, GVariant *val)
+{
+  if (ser->zero_copy > 0)
+  {
+    gsize n          = 0;
+    const gdouble *d = g_variant_get_fixed_array (val, &n, sizeof (gdouble));
+
+    if ((n > 0) && (((guintptr) d) % sizeof (gdouble) == 0))
+    {
+      NcmVector *v = NCM_VECTOR (ncm_vector_const_new_data (d, n, 1));
+
+      v->pdata = g_variant_ref (val);
+      v->pfree = (GDestroyNotify) &g_variant_unref;
+
+      return v;
+    }
+  }
+
+  return ncm_vector_new_variant (val);
+}
+
+static NcmMatrix *
+_ncm_serialize_matrix_new_variant (NcmSerialize *ser, GVariant *val)
+{
+  const gsize nrows = g_variant_n_children (val);
+
+  if ((ser->zero_copy > 0) && (nrows > 0))
+  {
+    const gdouble *d    = NULL;
+    gsize ncols         = 0;
+    gboolean contiguous = TRUE;
+    gsize i;
+
+    /* The rows can only be wrapped if they are stored one after the other. */
+    for (i = 0; (i < nrows) && contiguous; i++)
+    {
+      GVariant *row           = g_variant_get_child_value (val, i);
+      gsize ncols_i           = 0;
+      const gdouble *row_data = g_variant_get_fixed_array (row, &ncols_i, sizeof (gdouble));
+
+      if (i == 0)
+      {
+        d     = row_data;
+        ncols = ncols_i;
+      }
+      contiguous = (ncols_i == ncols) && (row_data == d + i * ncols);
+
+      g_variant_unref (row);
+    }
+
+    if (contiguous && (ncols > 0) && (((guintptr) d) % sizeof (gdouble) == 0))
+    {
+      NcmMatrix *m = NCM_MATRIX (ncm_matrix_const_new_data (d, nrows, ncols));
+
+      m->pdata = g_variant_ref (val);
+      m->pfree = (GDestroyNotify) &g_variant_unref;
+
+      return m;
+    }
+  }
+
+  return ncm_matrix_new_variant (val);
+}
+
+/*
+ * Header of the mapped container, the payload (a #GVariant of type 
+ * NCM_SERIALIZE_OBJECT_TYPE) starts at offset and has length bytes.
+ */
+typedef struct _NcmSerializeMappedHeader
+{
+  gchar magic[8];
+  guint32 version;
+  guint32 bom;
+  guint64 offset;
+  guint64 length;
+  guint8 reserved[32];
+} NcmSerializeMappedHeader;
+
+#define _NCM_SERIALIZE_MAPPED_BOM (0x01020304)
+
+G_STATIC_ASSERT (sizeof (NcmSerializeMappedHeader) == 64);
+G_STATIC_ASSERT (sizeof (NCM_SERIALIZE_MAPPED_MAGIC) == 8);
+
+/**
+ * ncm_serialize_is_mapped_file:
+ * @filename: a file name
+ *
+ * Checks whether @filename starts with the magic of the container written by
+ * ncm_serialize_to_mapped_file().
+ *
+ * Returns: TRUE if @filename is a mapped serialization container.
+ */
+gboolean
+ncm_serialize_is_mapped_file (const gchar *filename)
+{
+  FILE *f = g_fopen (filename, "rb");
+  gboolean is_mapped = FALSE;
+
+  if (f != NULL)
+  {
+    gchar magic[8];
+
+    if (fread (magic, sizeof (magic), 1, f) == 1)
+      is_mapped = (memcmp (magic, NCM_SERIALIZE_MAPPED_MAGIC, sizeof (magic)) == 0);
+
+    fclose (f);
+  }
+
+  return is_mapped;
+}
+
+/**
+ * ncm_serialize_from_mapped_file:
+ * @ser: a #NcmSerialize
+ * @filename: File containing the object saved by ncm_serialize_to_mapped_file()
+ *
+ * Maps @filename in memory and deserializes the object. The #NcmVector and 
+ * #NcmMatrix objects created in the process point to the mapped memory (they
+ * keep the mapping alive), so their values are neither parsed nor copied. 
+ * The file is opened read-only and mapped privately (copy-on-write): only 
+ * the memory pages changed by these objects are copied and the changes are
+ * never written to the file. Files written in a machine with a different 
+ * byte order are byte swapped in memory.
+ *
+ * Returns: (transfer full): A new #GObject.
+ */
+GObject *
+ncm_serialize_from_mapped_file (NcmSerialize *ser, const gchar *filename)
+{
+  GError *error      = NULL;
+  GMappedFile *mfile = NULL;
+  GObject *obj       = NULL;
+  const NcmSerializeMappedHeader *header;
+  gboolean swap;
+  guint32 version;
+  guint64 offset, length;
+  gsize flen;
+
+  g_assert (filename != NULL);
+
+  /*
+   * The file is opened read-only and mapped privately with write access,
+   * the pages are copied by the system only when an object changes them.
+   */
+  {
+    gint fd = g_open (filename, O_RDONLY, 0);
+
+    if (fd < 0)
+      g_error ("ncm_serialize_from_mapped_file: cannot open file %s: %s",
+               filename, g_strerror (errno));
+
+    mfile = g_mapped_file_new_from_fd (fd, TRUE, &error);
+    close (fd);
+
+    if (mfile == NULL)
+      g_error ("ncm_serialize_from_mapped_file: cannot map file %s: %s",
+               filename, error->message);
+  }
+
+  flen   = g_mapped_file_get_length (mfile);
+  header = (const NcmSerializeMappedHeader *) g_mapped_file_get_contents (mfile);
+
+  if ((flen < sizeof (NcmSerializeMappedHeader)) || 
+      (memcmp (header->magic, NCM_SERIALIZE_MAPPED_MAGIC, sizeof (header->magic)) != 0))
+    g_error ("ncm_serialize_from_mapped_file: file %s is not a mapped serialization container.", filename);
+
+  if (header->bom == _NCM_SERIALIZE_MAPPED_BOM)
+    swap = FALSE;
+  else if (header->bom == GUINT32_SWAP_LE_BE (_NCM_SERIALIZE_MAPPED_BOM))
+    swap = TRUE;
+  else
+  {
+    g_error ("ncm_serialize_from_mapped_file: file %s has an invalid byte order mark.", filename);
+    return NULL;
+  }
+
+  version = swap ? GUINT32_SWAP_LE_BE (header->version) : header->version;
+  offset  = swap ? GUINT64_SWAP_LE_BE (header->offset)  : header->offset;
+  length  = swap ? GUINT64_SWAP_LE_BE (header->length)  : header->length;
+
+  if (version > NCM_SERIALIZE_MAPPED_VERSION)
+    g_error ("ncm_serialize_from_mapped_file: file %s has format version %u, this version of NumCosmo reads up to %u.",
+             filename, version, NCM_SERIALIZE_MAPPED_VERSION);
+
+  if ((offset < sizeof (NcmSerializeMappedHeader)) || (length == 0) || (offset + length > flen))
+    g_error ("ncm_serialize_from_mapped_file: file %s is truncated or corrupted.", filename);
+
+  {
+    GBytes *bytes     = g_mapped_file_get_bytes (mfile);
+    GBytes *payload   = g_bytes_new_from_bytes (bytes, offset, length);
+    GVariant *obj_ser = g_variant_ref_sink (g_variant_new_from_bytes (G_VARIANT_TYPE (NCM_SERIALIZE_OBJECT_TYPE), payload, FALSE));
+
+    if (swap)
+    {
+      GVariant *obj_ser_swap = g_variant_ref_sink (g_variant_byteswap (obj_ser));
+      g_variant_unref (obj_ser);
+      obj_ser = obj_ser_swap;
+    }
+
+    ser->zero_copy++;
+    obj = ncm_serialize_from_variant (ser, obj_ser);
+    ser->zero_copy--;
+
+    g_variant_unref (obj_ser);
+    g_bytes_unref (payload);
+    g_bytes_unref (bytes);
+  }
+
+  g_mapped_file_unref (mfile);
+
+  return obj;
+}
+
 /**
  * ncm_serialize_from_name_params:
  * @ser: a #NcmSerialize.
@@ -947,6 +1189,21 @@ ncm_serialize_from_name_params (NcmSerialize *ser, const gchar *obj_name, GVaria
 
   g_assert (params == NULL || g_variant_is_of_type (params, G_VARIANT_TYPE (NCM_SERIALIZE_PROPERTIES_TYPE)));
 
+  if ((ser->zero_copy > 0) && (name == NULL) && (nprop == 1) && 
+      ((gtype == NCM_TYPE_VECTOR) || (gtype == NCM_TYPE_MATRIX)))
+  {
+    const gboolean is_vec = (gtype == NCM_TYPE_VECTOR);
+    GVariant *values      = g_variant_lookup_value (params, "values", 
+                                                    G_VARIANT_TYPE (is_vec ? NCM_SERIALIZE_VECTOR_TYPE : NCM_SERIALIZE_MATRIX_TYPE));
+
+    if (values != NULL)
+    {
+      obj = is_vec ? G_OBJECT (_ncm_serialize_vector_new_variant (ser, values)) : G_OBJECT (_ncm_serialize_matrix_new_variant (ser, values));
+      g_variant_unref (values);
+      return obj;
+    }
+  }
+
   if (params != NULL)
   {
     GVariantIter *p_iter  = g_variant_iter_new (params);
@@ -965,7 +1222,7 @@ ncm_serialize_from_name_params (NcmSerialize *ser, const gchar *obj_name, GVaria
 
       if (g_variant_is_of_type (val, G_VARIANT_TYPE (NCM_SERIALIZE_VECTOR_TYPE)) && !is_NcmVector)
       {
-        NcmVector *vec = ncm_vector_new_variant (val);
+        NcmVector *vec = _ncm_serialize_vector_new_variant (ser, val);
         GValue lval = G_VALUE_INIT;
         g_value_init (&lval, G_TYPE_OBJECT);
         gprop[i].value = lval;
@@ -973,7 +1230,7 @@ ncm_serialize_from_name_params (NcmSerialize *ser, const gchar *obj_name, GVaria
       }
       else if (g_variant_is_of_type (val, G_VARIANT_TYPE (NCM_SERIALIZE_MATRIX_TYPE)) && !is_NcmMatrix)
       {
-        NcmMatrix *mat = ncm_matrix_new_variant (val);
+        NcmMatrix *mat = _ncm_serialize_matrix_new_variant (ser, val);
         GValue lval = G_VALUE_INIT;
         g_value_init (&lval, G_TYPE_OBJECT);
         gprop[i].value = lval;
@@ -1218,6 +1475,17 @@ ncm_serialize_gvalue_to_gvariant (NcmSerialize *ser, GValue *val)
   return var;
 }
 
+static gboolean
+_ncm_serialize_is_readonly (GObject *obj)
+{
+  if (NCM_IS_VECTOR (obj))
+    return ncm_vector_is_readonly (NCM_VECTOR (obj));
+  else if (NCM_IS_MATRIX (obj))
+    return ncm_matrix_is_readonly (NCM_MATRIX (obj));
+  else
+    return FALSE;
+}
+
 /**
  * ncm_serialize_to_variant:
  * @ser: a #NcmSerialize.
@@ -1249,6 +1517,23 @@ ncm_serialize_to_variant (NcmSerialize *ser, GObject *obj)
     ser_var = g_variant_ref_sink (g_variant_new (NCM_SERIALIZE_OBJECT_TYPE, fname, NULL));
     g_free (fname);
   }
+  else if ((ser->opts & NCM_SERIALIZE_OPT_SHARE_READONLY) && _ncm_serialize_is_readonly (obj))
+  {
+    /* 
+     * Read-only objects become named instances, the deserialization returns
+     * the same instance. These names are not removed by ncm_serialize_reset()
+     * with autosave_only == TRUE, hence they are shared by all duplicates.
+     */
+    gchar *name  = g_strdup_printf (NCM_SERIALIZE_SHARED_NAME NCM_SERIALIZE_AUTOSAVE_NFORMAT, ser->shared_count);
+    gchar *fname = g_strdup_printf ("%s[%s]", obj_name, name);
+
+    ncm_serialize_set (ser, obj, name, FALSE);
+    ser->shared_count++;
+
+    ser_var = g_variant_ref_sink (g_variant_new (NCM_SERIALIZE_OBJECT_TYPE, fname, NULL));
+    g_free (fname);
+    g_free (name);
+  }
   else
   {
     GObjectClass *klass = G_OBJECT_GET_CLASS (obj);
@@ -1416,6 +1701,51 @@ ncm_serialize_to_binfile (NcmSerialize *ser, GObject *obj, const gchar *filename
   g_variant_unref (obj_ser);
 }
 
+/**
+ * ncm_serialize_to_mapped_file:
+ * @ser: a #NcmSerialize
+ * @obj: a #GObject
+ * @filename: File where to save the serialized version of the object
+ * 
+ * Serializes @obj and saves it in @filename using the versioned binary 
+ * container described in #NcmSerialize. The object can be loaded using 
+ * ncm_serialize_from_mapped_file() or ncm_serialize_from_file().
+ * 
+ */
+void
+ncm_serialize_to_mapped_file (NcmSerialize *ser, GObject *obj, const gchar *filename)
+{
+  GVariant *obj_ser = g_variant_ref_sink (ncm_serialize_to_variant (ser, obj));
+  const gsize length = g_variant_get_size (obj_ser);
+  NcmSerializeMappedHeader header;
+  FILE *f;
+
+  g_assert (filename != NULL);
+
+  memset (&header, 0, sizeof (NcmSerializeMappedHeader));
+  memcpy (header.magic, NCM_SERIALIZE_MAPPED_MAGIC, sizeof (header.magic));
+  header.version = NCM_SERIALIZE_MAPPED_VERSION;
+  header.bom     = _NCM_SERIALIZE_MAPPED_BOM;
+  header.offset  = sizeof (NcmSerializeMappedHeader);
+  header.length  = length;
+
+  f = g_fopen (filename, "wb");
+  if (f == NULL)
+    g_error ("ncm_serialize_to_mapped_file: cannot open file %s: %s",
+             filename, g_strerror (errno));
+
+  if ((fwrite (&header, sizeof (NcmSerializeMappedHeader), 1, f) != 1) ||
+      (fwrite (g_variant_get_data (obj_ser), 1, length, f) != length))
+    g_error ("ncm_serialize_to_mapped_file: cannot write to file %s: %s",
+             filename, g_strerror (errno));
+
+  if (fclose (f) != 0)
+    g_error ("ncm_serialize_to_mapped_file: cannot close file %s: %s",
+             filename, g_strerror (errno));
+
+  g_variant_unref (obj_ser);
+}
+
 /**
  * ncm_serialize_dup_obj:
  * @ser: a #NcmSerialize.
@@ -1766,6 +2096,23 @@ ncm_serialize_global_from_binfile (const gchar *filename)
   return ret;
 }
 
+/**
+ * ncm_serialize_global_from_mapped_file:
+ * @filename: File containing the serialized version of the object.
+ *
+ * Global version of ncm_serialize_from_mapped_file().
+ *
+ * Returns: (transfer full): A new #GObject.
+ */
+GObject *
+ncm_serialize_global_from_mapped_file (const gchar *filename)
+{
+  NcmSerialize *ser = ncm_serialize_global ();
+  GObject *ret = ncm_serialize_from_mapped_file (ser, filename);
+  ncm_serialize_unref (ser);
+  return ret;
+}
+
 /**
  * ncm_serialize_global_from_name_params:
  * @obj_name: string containing the object name.
@@ -1868,6 +2215,22 @@ ncm_serialize_global_to_binfile (GObject *obj, const gchar *filename)
   ncm_serialize_unref (ser);
 }
 
+/**
+ * ncm_serialize_global_to_mapped_file:
+ * @obj: a #GObject.
+ * @filename: File where to save the serialized version of the object
+ * 
+ * Global version of ncm_serialize_to_mapped_file().
+ * 
+ */
+void
+ncm_serialize_global_to_mapped_file (GObject *obj, const gchar *filename)
+{
+  NcmSerialize *ser = ncm_serialize_global ();
+  ncm_serialize_to_mapped_file (ser, obj, filename);
+  ncm_serialize_unref (ser);
+}
+
 /**
  * ncm_serialize_global_dup_obj:
  * @obj: a #GObject.
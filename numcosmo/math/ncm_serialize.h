@@ -55,6 +55,7 @@ struct _NcmSerializeClass
  * @NCM_SERIALIZE_OPT_AUTOSAVE_SER: Whether to automatically include named deserialized objects in the named instances.
  * @NCM_SERIALIZE_OPT_AUTONAME_SER: Whether to automatically name objects on serialization.
  * @NCM_SERIALIZE_OPT_CLEAN_DUP: Combination of NCM_SERIALIZE_OPT_AUTOSAVE_SER and NCM_SERIALIZE_OPT_AUTONAME_SER
+ * @NCM_SERIALIZE_OPT_SHARE_READONLY: Whether to serialize read-only #NcmVector and #NcmMatrix as named instances, so that duplicates share them by reference.
  *
  * Options for serialization.
  *
@@ -65,6 +66,7 @@ typedef enum _NcmSerializeOpt
   NCM_SERIALIZE_OPT_AUTOSAVE_SER = 1 << 0,
   NCM_SERIALIZE_OPT_AUTONAME_SER = 1 << 1,
   NCM_SERIALIZE_OPT_CLEAN_DUP    = NCM_SERIALIZE_OPT_AUTOSAVE_SER | NCM_SERIALIZE_OPT_AUTONAME_SER,
+  NCM_SERIALIZE_OPT_SHARE_READONLY = 1 << 2,
 } NcmSerializeOpt;
 
 struct _NcmSerialize
@@ -79,6 +81,8 @@ struct _NcmSerialize
   GRegex *parse_obj_regex;
   NcmSerializeOpt opts;
   guint autosave_count;
+  guint zero_copy;
+  guint shared_count;
 };
 
 GType ncm_serialize_get_type (void) G_GNUC_CONST;
@@ -114,11 +118,14 @@ GObject *ncm_serialize_from_name_params (NcmSerialize *ser, const gchar *obj_nam
 GObject *ncm_serialize_from_string (NcmSerialize *ser, const gchar *obj_ser);
 GObject *ncm_serialize_from_file (NcmSerialize *ser, const gchar *filename);
 GObject *ncm_serialize_from_binfile (NcmSerialize *ser, const gchar *filename);
+GObject *ncm_serialize_from_mapped_file (NcmSerialize *ser, const gchar *filename);
 GVariant *ncm_serialize_gvalue_to_gvariant (NcmSerialize *ser, GValue *val);
 GVariant *ncm_serialize_to_variant (NcmSerialize *ser, GObject *obj);
 gchar *ncm_serialize_to_string (NcmSerialize *ser, GObject *obj, gboolean valid_variant);
 void ncm_serialize_to_file (NcmSerialize *ser, GObject *obj, const gchar *filename);
 void ncm_serialize_to_binfile (NcmSerialize *ser, GObject *obj, const gchar *filename);
+void ncm_serialize_to_mapped_file (NcmSerialize *ser, GObject *obj, const gchar *filename);
+gboolean ncm_serialize_is_mapped_file (const gchar *filename);
 GObject *ncm_serialize_dup_obj (NcmSerialize *ser, GObject *obj);
 
 /* Global NcmSerialize object */
@@ -148,11 +155,13 @@ GObject *ncm_serialize_global_from_name_params (const gchar *obj_name, GVariant
 GObject *ncm_serialize_global_from_string (const gchar *obj_ser);
 GObject *ncm_serialize_global_from_file (const gchar *filename);
 GObject *ncm_serialize_global_from_binfile (const gchar *filename);
+GObject *ncm_serialize_global_from_mapped_file (const gchar *filename);
 GVariant *ncm_serialize_global_gvalue_to_gvariant (GValue *val);
 GVariant *ncm_serialize_global_to_variant (GObject *obj);
 gchar *ncm_serialize_global_to_string (GObject *obj, gboolean valid_variant);
 void ncm_serialize_global_to_file (GObject *obj, const gchar *filename);
 void ncm_serialize_global_to_binfile (GObject *obj, const gchar *filename);
+void ncm_serialize_global_to_mapped_file (GObject *obj, const gchar *filename);
 GObject *ncm_serialize_global_dup_obj (GObject *obj);
 
 #define NCM_SERIALIZE_PROPERTY_TYPE "{sv}"
@@ -162,8 +171,11 @@ GObject *ncm_serialize_global_dup_obj (GObject *obj);
 #define NCM_SERIALIZE_VECTOR_TYPE "ad"
 #define NCM_SERIALIZE_MATRIX_TYPE "aad"
 #define NCM_SERIALIZE_STRV_TYPE "as"
+#define NCM_SERIALIZE_MAPPED_MAGIC "NCMSMAP"
+#define NCM_SERIALIZE_MAPPED_VERSION 1
 #define NCM_SERIALIZE_AUTOSAVE_NAME "S"
 #define NCM_SERIALIZE_AUTOSAVE_NFORMAT "%u"
+#define NCM_SERIALIZE_SHARED_NAME "R"
 
 G_END_DECLS
 
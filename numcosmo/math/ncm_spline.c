@@ -164,6 +164,8 @@ _ncm_spline_finalize (GObject *object)
   G_OBJECT_CLASS (ncm_spline_parent_class)->finalize (object);
 }
 
+static void _ncm_spline_eval_vec (const NcmSpline *s, const NcmVector *x, const GArray *order, NcmVector *y);
+
 static void
 ncm_spline_class_init (NcmSplineClass *klass)
 {
@@ -208,6 +210,17 @@ ncm_spline_class_init (NcmSplineClass *klass)
   klass->deriv = NULL;
   klass->deriv2 = NULL;
   klass->integ = NULL;  
+  klass->eval_vec = &_ncm_spline_eval_vec;
+}
+
+static void 
+_ncm_spline_eval_vec (const NcmSpline *s, const NcmVector *x, const GArray *order, NcmVector *y)
+{
+  const guint n = ncm_vector_len (x);
+  guint i;
+
+  for (i = 0; i < n; i++)
+    ncm_vector_set (y, i, ncm_spline_eval (s, ncm_vector_get (x, i)));
 }
 
 /**
@@ -610,6 +623,27 @@ ncm_spline_get_bounds (NcmSpline *s, gdouble *lb, gdouble *ub)
   *ub = ncm_vector_get (s->xv, s->len - 1);
 }
 
+/**
+ * ncm_spline_eval_vec: (virtual eval_vec)
+ * @s: a #NcmSpline
+ * @x: a #NcmVector
+ * @order: (allow-none) (array) (element-type guint): the sorting permutation of @x
+ * @y: a #NcmVector
+ *
+ * Evaluates the spline @s at each component of @x and stores the results in @y.
+ * When @order is not NULL it must contain the permutation that sorts @x, see 
+ * ncm_vector_get_sort_index(), which allows the implementations to walk the knots 
+ * in a single pass instead of searching the interval for each point. When @order
+ * is NULL the points are visited in the order they appear in @x.
+ * 
+ */
+void 
+ncm_spline_eval_vec (const NcmSpline *s, const NcmVector *x, const GArray *order, NcmVector *y)
+{
+  g_assert_cmpuint (ncm_vector_len (x), ==, ncm_vector_len (y));
+  NCM_SPLINE_GET_CLASS (s)->eval_vec (s, x, order, y);
+}
+
 /**
  * ncm_spline_prepare:
  * @s: a #NcmSpline
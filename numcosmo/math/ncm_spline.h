@@ -57,6 +57,7 @@ struct _NcmSplineClass
   gdouble (*deriv2) (const NcmSpline *s, const gdouble x);
   gdouble (*deriv_nmax) (const NcmSpline *s, const gdouble x);
   gdouble (*integ) (const NcmSpline *s, const gdouble xi, const gdouble xf);
+  void (*eval_vec) (const NcmSpline *s, const NcmVector *x, const GArray *order, NcmVector *y);
   NcmSpline *(*copy_empty) (const NcmSpline *s);
 };
 
@@ -96,6 +97,8 @@ NcmVector *ncm_spline_get_xv (NcmSpline *s);
 NcmVector *ncm_spline_get_yv (NcmSpline *s);
 void ncm_spline_get_bounds (NcmSpline *s, gdouble *lb, gdouble *ub);
 
+void ncm_spline_eval_vec (const NcmSpline *s, const NcmVector *x, const GArray *order, NcmVector *y);
+
 void ncm_spline_free (NcmSpline *s);
 void ncm_spline_clear (NcmSpline **s);
 
@@ -74,6 +74,7 @@ static gdouble _ncm_spline_cubic_deriv (const NcmSpline *s, const gdouble x);
 static gdouble _ncm_spline_cubic_deriv2 (const NcmSpline *s, const gdouble x);
 static gdouble _ncm_spline_cubic_deriv_nmax (const NcmSpline *s, const gdouble x);
 static gdouble _ncm_spline_cubic_integ (const NcmSpline *s, const gdouble x0, const gdouble x1);
+static void _ncm_spline_cubic_eval_vec (const NcmSpline *s, const NcmVector *x, const GArray *order, NcmVector *y);
 
 static void
 ncm_spline_cubic_class_init (NcmSplineCubicClass *klass)
@@ -89,6 +90,7 @@ ncm_spline_cubic_class_init (NcmSplineCubicClass *klass)
 	s_class->deriv2       = &_ncm_spline_cubic_deriv2;
   s_class->deriv_nmax   = &_ncm_spline_cubic_deriv_nmax;
 	s_class->integ        = &_ncm_spline_cubic_integ;
+  s_class->eval_vec     = &_ncm_spline_cubic_eval_vec;
 }
 
 static void
@@ -170,6 +172,48 @@ _ncm_spline_cubic_eval (const NcmSpline *s, const gdouble x)
 	}
 }
 
+/*
+ * Visiting the points in ascending order the interval index only moves 
+ * forward, the search is done only when a point is smaller than the 
+ * current interval.
+ */
+static void
+_ncm_spline_cubic_eval_vec (const NcmSpline *s, const NcmVector *x, const GArray *order, NcmVector *y)
+{
+  const NcmSplineCubic *sc = NCM_SPLINE_CUBIC (s);
+  const guint n            = ncm_vector_len (x);
+  const guint imax         = s->len - 2;
+  guint i = 0;
+  guint l;
+
+  for (l = 0; l < n; l++)
+  {
+    const guint a      = (order != NULL) ? g_array_index (order, guint, l) : l;
+    const gdouble x_a  = ncm_vector_get (x, a);
+
+    if ((i > 0) && (x_a < ncm_vector_get (s->xv, i)))
+      i = ncm_spline_get_index (s, x_a);
+    else
+    {
+      while ((i < imax) && (x_a >= ncm_vector_get (s->xv, i + 1)))
+        i++;
+    }
+
+    {
+      const gdouble delx = x_a - ncm_vector_get (s->xv, i);
+      const gdouble a_i  = ncm_vector_get (s->yv, i);
+      const gdouble b_i  = ncm_vector_fast_get (sc->b, i);
+      const gdouble c_i  = ncm_vector_fast_get (sc->c, i);
+      const gdouble d_i  = ncm_vector_fast_get (sc->d, i);
+#ifdef HAVE_FMA
+      ncm_vector_set (y, a, fma (fma (fma (d_i, delx, c_i), delx, b_i), delx, a_i));
+#else
+      ncm_vector_set (y, a, a_i + delx * (b_i + delx * (c_i + delx * d_i)));
+#endif /* HAVE_FMA */
+    }
+  }
+}
+
 static gdouble
 _ncm_spline_cubic_deriv (const NcmSpline *s, const gdouble x)
 {
@@ -41,6 +41,7 @@
 #include "math/ncm_spline_func.h"
 #include "math/ncm_cfg.h"
 #include "math/ncm_util.h"
+#include "math/ncm_func_eval.h"
 
 #include <gsl/gsl_poly.h>
 
@@ -241,39 +242,95 @@ ncm_spline_new_function_2x2 (NcmSpline *s, gsl_function *F, gdouble xi, gdouble
   return;
 }
 
+typedef enum _NcmSplineFuncKnot
+{
+  _NCM_SPLINE_FUNC_KNOT_LINEAR,
+  _NCM_SPLINE_FUNC_KNOT_LN,
+  _NCM_SPLINE_FUNC_KNOT_SINH,
+} NcmSplineFuncKnot;
+
+static gdouble
+_ncm_spline_func_knot_to (const NcmSplineFuncKnot ktype, const gdouble x)
+{
+  switch (ktype)
+  {
+    case _NCM_SPLINE_FUNC_KNOT_LN:
+      return log (x);
+    case _NCM_SPLINE_FUNC_KNOT_SINH:
+      return asinh (x);
+    default:
+      return x;
+  }
+}
+
+static gdouble
+_ncm_spline_func_knot_from (const NcmSplineFuncKnot ktype, const gdouble u)
+{
+  switch (ktype)
+  {
+    case _NCM_SPLINE_FUNC_KNOT_LN:
+      return exp (u);
+    case _NCM_SPLINE_FUNC_KNOT_SINH:
+      return sinh (u);
+    default:
+      return u;
+  }
+}
+
+/*
+ * Refines the knots of @s in passes. Each pass collects the midpoints
+ * (in the knot variable) of all intervals not yet accepted, evaluates
+ * them in a single call to Fb and then compares, for each interval,
+ * the function and its Simpson integral against the spline of the
+ * previous pass. Since the spline is only rebuilt at the end of each
+ * pass, the knots are identical to the ones obtained evaluating the
+ * midpoints one at a time.
+ */
 static void
-ncm_spline_new_function_spline (NcmSpline *s, gsl_function *F, gdouble xi, gdouble xf, gsize max_nodes, gdouble rel_error)
+_ncm_spline_func_refine (NcmSpline *s, const NcmSplineFuncKnot ktype, NcmSplineFuncBatchF Fb, gpointer userdata, gdouble xi, gdouble xf, gsize max_nodes, const gdouble rel_error)
 {
   GArray *x_array  = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
   GArray *y_array  = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
+  GArray *o_array  = g_array_sized_new (FALSE, FALSE, sizeof (gint), 1000);
   GArray *xt_array = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
   GArray *yt_array = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
-  GList *nodes = NULL, *wnodes = NULL;
+  GArray *ot_array = g_array_sized_new (FALSE, FALSE, sizeof (gint), 1000);
+  GArray *c_array  = g_array_sized_new (FALSE, FALSE, sizeof (guint), 1000);
+  GArray *xm_array = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
+  GArray *ym_array = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
+  const gdouble ui = _ncm_spline_func_knot_to (ktype, xi);
+  const gdouble uf = _ncm_spline_func_knot_to (ktype, xf);
   gsize n = ncm_spline_min_size (s);
   guint i;
 
   n = (n < 3) ? 3 : n;
 
+  max_nodes = (max_nodes <= 0) ? G_MAXUINT64 : max_nodes;
+
   ncm_assert_cmpdouble_e (xf, >, xi, DBL_EPSILON, 0.0);
 
-  max_nodes = (max_nodes <= 0) ? G_MAXUINT64 : max_nodes;
+  if (ktype == _NCM_SPLINE_FUNC_KNOT_LN)
+    g_assert (xi > 0.0 && xf > xi);
 
-  g_array_set_size (xt_array, n);
-  g_array_set_size (yt_array, n);
+  g_array_set_size (x_array, n);
+  g_array_set_size (y_array, n);
+  g_array_set_size (o_array, n);
 
   for (i = 0; i < n; i++)
   {
-    const gdouble x = xi + (xf - xi) / (n - 1.0) * i;
-    /*const gdouble x = 0.5 * (xi + xf) - 0.5 * (xf - xi) * cos ((2.0 * i + 1.0) * M_PI / (2.0 * n));*/
-    const gdouble y = GSL_FN_EVAL (F, x);
+    g_array_index (x_array, gdouble, i) = _ncm_spline_func_knot_from (ktype, ui + (uf - ui) / (n - 1.0) * i);
+    g_array_index (o_array, gint, i)    = 0;
+  }
 
-    BIVEC_LIST_APPEND (nodes, x, y);
-    BIVEC_LIST_OK (nodes) = 0;
+  Fb (userdata, &g_array_index (x_array, gdouble, 0), &g_array_index (y_array, gdouble, 0), n);
 
-    g_array_append_val (x_array, x);
-    g_array_append_val (y_array, y);
-    g_assert (gsl_finite (x));
-    g_assert (gsl_finite (y));
+  if (ktype == _NCM_SPLINE_FUNC_KNOT_LINEAR)
+  {
+    for (i = 0; i < n; i++)
+    {
+      g_assert (gsl_finite (g_array_index (x_array, gdouble, i)));
+      g_assert (gsl_finite (g_array_index (y_array, gdouble, i)));
+    }
   }
 
   ncm_spline_set_array (s, x_array, y_array, TRUE);
@@ -284,67 +341,96 @@ ncm_spline_new_function_spline (NcmSpline *s, gsl_function *F, gdouble xi, gdoub
   while (TRUE)
   {
     gsize improves = 0;
-    wnodes = nodes;
+    guint j = 0;
+
+    /* Collects all candidate midpoints of this pass. */
+    g_array_set_size (c_array, 0);
+    g_array_set_size (xm_array, 0);
+
+    for (i = 0; i + 1 < x_array->len; i++)
+    {
+      if (g_array_index (o_array, gint, i) != 1)
+      {
+        const gdouble u0 = _ncm_spline_func_knot_to (ktype, g_array_index (x_array, gdouble, i));
+        const gdouble u1 = _ncm_spline_func_knot_to (ktype, g_array_index (x_array, gdouble, i + 1));
+        const gdouble x  = _ncm_spline_func_knot_from (ktype, (u0 + u1) / 2.0);
+
+        g_array_append_val (c_array, i);
+        g_array_append_val (xm_array, x);
+      }
+    }
+
+    g_array_set_size (ym_array, xm_array->len);
+    if (xm_array->len > 0)
+      Fb (userdata, &g_array_index (xm_array, gdouble, 0), &g_array_index (ym_array, gdouble, 0), xm_array->len);
+
+    /* Tests the candidates against the spline of the previous pass and merges the knots. */
     g_array_set_size (xt_array, 0);
     g_array_set_size (yt_array, 0);
-    do
+    g_array_set_size (ot_array, 0);
+
+    for (i = 0; i < x_array->len; i++)
     {
-      g_array_append_val (xt_array, BIVEC_LIST_X (wnodes));
-      g_array_append_val (yt_array, BIVEC_LIST_Y (wnodes));
+      g_array_append_val (xt_array, g_array_index (x_array, gdouble, i));
+      g_array_append_val (yt_array, g_array_index (y_array, gdouble, i));
+      g_array_append_val (ot_array, g_array_index (o_array, gint, i));
 
-      if (BIVEC_LIST_OK (wnodes) == 1)
-        continue;
-      else
+      if ((j < c_array->len) && (g_array_index (c_array, guint, j) == i))
       {
-        const gdouble x0  = BIVEC_LIST_X (wnodes);
-        const gdouble x1  = BIVEC_LIST_X (wnodes->next);
-        const gdouble y0  = BIVEC_LIST_Y (wnodes);
-        const gdouble y1  = BIVEC_LIST_Y (wnodes->next);
-        const gdouble x   = (x0 + x1) / 2.0;
-        const gdouble y   = GSL_FN_EVAL (F, x);
+        const gdouble x0  = g_array_index (x_array, gdouble, i);
+        const gdouble x1  = g_array_index (x_array, gdouble, i + 1);
+        const gdouble y0  = g_array_index (y_array, gdouble, i);
+        const gdouble y1  = g_array_index (y_array, gdouble, i + 1);
+        const gdouble x   = g_array_index (xm_array, gdouble, j);
+        const gdouble y   = g_array_index (ym_array, gdouble, j);
         const gdouble ys  = ncm_spline_eval (s, x);
-        const gdouble Iyc = (x1 - x0) * (y1 + y0 + 4.0 * y) / 6.0;
         const gdouble Iys = ncm_spline_eval_integ (s, x0, x1);
-        const gboolean test_p = (TEST_CMP(y, ys) < rel_error);
-        const gboolean test_I = (TEST_CMP(Iyc, Iys) < rel_error);
+        gint o            = g_array_index (o_array, gint, i);
+        gdouble Iyc;
+        gboolean test_p, test_I;
+
+        if (ktype == _NCM_SPLINE_FUNC_KNOT_LINEAR)
+        {
+          Iyc = (x1 - x0) * (y1 + y0 + 4.0 * y) / 6.0;
+        }
+        else
+        {
+          const gdouble delta = (x - 0.5 * (x1 + x0)) / (0.5 * (x1 - x0));
+          Iyc = (x1 - x0) * (y1 * (3.0 - 2.0 / (1.0 - delta)) + y0 * (3.0 - 2.0 / (1.0 + delta)) + 4.0 * y / (1.0 - delta * delta)) / 6.0;
+        }
+
+        test_p = (TEST_CMP(y, ys) < rel_error);
+        test_I = (TEST_CMP(Iyc, Iys) < rel_error);
 #ifdef _NCM_SPLINE_TEST_DIFF
-        const gdouble dyc = (y1 - y0) / (x1 - x0);
-        const gdouble dys = ncm_spline_eval_deriv (s, x);
-        const gboolean test_d = (TEST_CMP(dyc, dys) < rel_error);
+        {
+          const gdouble dyc = (y1 - y0) / (x1 - x0);
+          const gdouble dys = ncm_spline_eval_deriv (s, x);
+          test_p = test_p && (TEST_CMP(dyc, dys) < rel_error);
+        }
 #endif /* _NCM_SPLINE_TEST_DIFF */
 
-        if (fabs ((x - x0)/x) < NCM_SPLINE_KNOT_DIFF_TOL)
+        if ((ktype == _NCM_SPLINE_FUNC_KNOT_LINEAR) && (fabs ((x - x0) / x) < NCM_SPLINE_KNOT_DIFF_TOL))
           g_error ("Tolerance of the difference between knots was reached. Interpolated function is probably discontinuous at % 20.15g."
                    "Function value at f(x0) = % 22.15g and f(x) = % 22.15g.", x, y0, y);
 
-        BIVEC_LIST_INSERT_BEFORE (nodes, wnodes->next, x, y);
-        wnodes = g_list_next (wnodes);
-        g_array_append_val (xt_array, BIVEC_LIST_X (wnodes));
-        g_array_append_val (yt_array, BIVEC_LIST_Y (wnodes));
-        BIVEC_LIST_OK (wnodes) = BIVEC_LIST_OK (wnodes->prev);
-
-#ifdef _NCM_SPLINE_TEST_DIFF
-        if (test_p && test_I && test_d)
-#else
-          if (test_p && test_I)
-#endif /* _NCM_SPLINE_TEST_DIFF */
+        if (test_p && test_I)
         {
-          BIVEC_LIST_OK(wnodes->prev)++;
-          BIVEC_LIST_OK(wnodes)++;
+          g_array_index (ot_array, gint, ot_array->len - 1)++;
+          o++;
         }
         else
           improves++;
-      }
-    } while ((wnodes = g_list_next (wnodes)) && wnodes->next);
 
-    if (wnodes != NULL)
-    {
-      g_array_append_val (xt_array, BIVEC_LIST_X (wnodes));
-      g_array_append_val (yt_array, BIVEC_LIST_Y (wnodes));
+        g_array_append_val (xt_array, x);
+        g_array_append_val (yt_array, y);
+        g_array_append_val (ot_array, o);
+        j++;
+      }
     }
 
     SWAP_PTR (x_array, xt_array);
     SWAP_PTR (y_array, yt_array);
+    SWAP_PTR (o_array, ot_array);
 
     ncm_spline_set_array (s, x_array, y_array, TRUE);
     if (x_array->len > max_nodes)
@@ -356,259 +442,76 @@ ncm_spline_new_function_spline (NcmSpline *s, gsl_function *F, gdouble xi, gdoub
     if (improves == 0)
       break;
   }
-  g_list_free_full (nodes, _BIVec_free);
 
   g_array_unref (x_array);
   g_array_unref (xt_array);
   g_array_unref (y_array);
   g_array_unref (yt_array);
+  g_array_unref (o_array);
+  g_array_unref (ot_array);
+  g_array_unref (c_array);
+  g_array_unref (xm_array);
+  g_array_unref (ym_array);
 
   return;
 }
 
 static void
-ncm_spline_new_function_spline_lnknot (NcmSpline *s, gsl_function *F, gdouble xi, gdouble xf, gsize max_nodes, gdouble rel_error)
+_ncm_spline_func_batch_serial (gpointer userdata, const gdouble *x, gdouble *y, const guint len)
 {
-  GArray *x_array = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
-  GArray *y_array = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
-  GArray *xt_array = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
-  GArray *yt_array = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
-  GList *nodes = NULL, *wnodes = NULL;
-  gsize n = ncm_spline_min_size (s);
+  gsl_function *F = (gsl_function *) userdata;
   guint i;
-  const gdouble lnxi = log (xi);
-  const gdouble lnxf = log (xf);
 
-  n = (n < 3) ? 3 : n;
-  
-  max_nodes = (max_nodes <= 0) ? G_MAXUINT64 : max_nodes;
-
-  g_assert (xi > 0.0 && xf > xi);
-
-  g_array_set_size (xt_array, n);
-  g_array_set_size (yt_array, n);
-  for (i = 0; i < n; i++)
-  {
-    gdouble x = exp (lnxi + (lnxf - lnxi) / (n - 1.0) * i);
-    gdouble y = GSL_FN_EVAL (F, x);
-    BIVEC_LIST_APPEND (nodes, x, y);
-    BIVEC_LIST_OK (nodes) = 0;
-    g_array_append_val (x_array, x);
-    g_array_append_val (y_array, y);
-  }
-  ncm_spline_set_array (s, x_array, y_array, TRUE);
-
-#define TEST_CMP(a,b) ((a) != 0.0 ? fabs(((b)-(a))/(a)) : fabs((b)-(a)))
-#define SWAP_PTR(a,b) do { const gpointer tmp = (b); (b) = (a); (a) = tmp; } while (FALSE)
-
-  while (TRUE)
-  {
-    gsize improves = 0;
-    wnodes = nodes;
-    g_array_set_size (xt_array, 0);
-    g_array_set_size (yt_array, 0);
-
-    do
-    {
-      g_array_append_val (xt_array, BIVEC_LIST_X (wnodes));
-      g_array_append_val (yt_array, BIVEC_LIST_Y (wnodes));
-
-      if (BIVEC_LIST_OK (wnodes) == 1)
-        continue;
-      else
-      {
-        const gdouble x0    = BIVEC_LIST_X(wnodes);
-        const gdouble x1    = BIVEC_LIST_X(wnodes->next);
-        const gdouble lnx0  = log (x0);
-        const gdouble lnx1  = log (x1);
-        const gdouble y0    = BIVEC_LIST_Y(wnodes);
-        const gdouble y1    = BIVEC_LIST_Y(wnodes->next);
-        const gdouble lnx   = (lnx0 + lnx1) / 2.0;
-        const gdouble x     = exp (lnx);
-        const gdouble y     = GSL_FN_EVAL (F, x);
-        const gdouble ys    = ncm_spline_eval (s, x);
-        const gdouble delta = (x - 0.5 * (x1 + x0)) / (0.5 * (x1 - x0));
-        const gdouble Iyc   = (x1 - x0) * (y1 * (3.0 - 2.0 / (1.0 - delta)) + y0 * (3.0 - 2.0 / (1.0 + delta)) + 4.0 * y / (1.0 - delta * delta)) / 6.0;
-        /*const gdouble Iyc   = (x1 - x0) * (x1 * y1 + x0 * y0 + 4.0 * x * y) / 6.0;*/
-        const gdouble Iys   = ncm_spline_eval_integ (s, x0, x1);
-        const gboolean test_p = (TEST_CMP(y, ys) < rel_error);
-        const gboolean test_I = (TEST_CMP(Iyc, Iys) < rel_error);
-#ifdef _NCM_SPLINE_TEST_DIFF
-        const gdouble dyc = (y1 - y0) / (x1 - x0);
-        const gdouble dys = ncm_spline_eval_deriv (s, x);
-        const gboolean test_d = (TEST_CMP(dyc, dys) < rel_error);
-#endif /* _NCM_SPLINE_TEST_DIFF */
-
-        BIVEC_LIST_INSERT_BEFORE (nodes, wnodes->next, x, y);
-        wnodes = g_list_next (wnodes);
-        g_array_append_val(xt_array, BIVEC_LIST_X(wnodes));
-        g_array_append_val(yt_array, BIVEC_LIST_Y(wnodes));
-        BIVEC_LIST_OK(wnodes) = BIVEC_LIST_OK(wnodes->prev);
-
-#ifdef _NCM_SPLINE_TEST_DIFF
-        if (test_p && test_I && test_d)
-#else
-          if (test_p && test_I)
-#endif /* _NCM_SPLINE_TEST_DIFF */
-        {
-          BIVEC_LIST_OK(wnodes->prev)++;
-          BIVEC_LIST_OK(wnodes)++;
-        }
-        else
-          improves++;
-      }
-    } while ((wnodes = g_list_next (wnodes)) && wnodes->next);
-
-    if (wnodes != NULL)
-    {
-      g_array_append_val (xt_array, BIVEC_LIST_X (wnodes));
-      g_array_append_val (yt_array, BIVEC_LIST_Y (wnodes));
-    }
-    
-    SWAP_PTR (x_array, xt_array);
-    SWAP_PTR (y_array, yt_array);
-
-    ncm_spline_set_array (s, x_array, y_array, TRUE);
-    if (x_array->len > max_nodes)
-    {
-      g_warning ("ncm_spline_new_function_spline: cannot achive requested precision with at most %zu nodes", max_nodes);
-      break;
-    }
+  for (i = 0; i < len; i++)
+    y[i] = GSL_FN_EVAL (F, x[i]);
+}
 
-    if (improves == 0)
-      break;
-  }
-  g_list_free_full (nodes, _BIVec_free);
+typedef struct _NcmSplineFuncBatchMT
+{
+  gsl_function *F;
+  const gdouble *x;
+  gdouble *y;
+} NcmSplineFuncBatchMT;
 
-  g_array_unref (x_array);
-  g_array_unref (xt_array);
-  g_array_unref (y_array);
-  g_array_unref (yt_array);
+static void
+_ncm_spline_func_batch_mt_eval (glong i, glong f, gpointer data)
+{
+  NcmSplineFuncBatchMT *bmt = (NcmSplineFuncBatchMT *) data;
+  glong l;
 
-  return;
+  for (l = i; l < f; l++)
+    bmt->y[l] = GSL_FN_EVAL (bmt->F, bmt->x[l]);
 }
 
 static void
-ncm_spline_new_function_spline_sinhknot (NcmSpline *s, gsl_function *F, gdouble xi, gdouble xf, gsize max_nodes, const gdouble rel_error)
+_ncm_spline_func_batch_mt (gpointer userdata, const gdouble *x, gdouble *y, const guint len)
 {
-  GArray *x_array  = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
-  GArray *y_array  = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
-  GArray *xt_array = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
-  GArray *yt_array = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 1000);
-  GList *nodes = NULL, *wnodes = NULL;
-  gsize n = ncm_spline_min_size (s);
-  guint i;
-  const gdouble axi = asinh (xi);
-  const gdouble axf = asinh (xf);
-
-  n = (n < 3) ? 3 : n;
-
-  max_nodes = (max_nodes <= 0) ? G_MAXUINT64 : max_nodes;
-
-  g_array_set_size (xt_array, n);
-  g_array_set_size (yt_array, n);
+  const guint nthreads = g_thread_pool_get_max_threads (ncm_func_eval_get_pool ());
 
-  for (i = 0; i < n; i++)
+  if ((nthreads > 1) && (len > 2 * nthreads))
   {
-    gdouble x = sinh (axi + (axf - axi) / (n - 1.0) * i);
-    gdouble y = GSL_FN_EVAL (F, x);
-
-    BIVEC_LIST_APPEND (nodes, x, y);
-    BIVEC_LIST_OK (nodes) = 0;
-
-    g_array_append_val (x_array, x);
-    g_array_append_val (y_array, y);
+    NcmSplineFuncBatchMT bmt = {(gsl_function *) userdata, x, y};
+    ncm_func_eval_threaded_loop (&_ncm_spline_func_batch_mt_eval, 0, len, &bmt);
   }
-  ncm_spline_set_array (s, x_array, y_array, TRUE);
-
-#define TEST_CMP(a,b) ((a) != 0.0 ? fabs(((b)-(a))/(a)) : fabs((b)-(a)))
-#define SWAP_PTR(a,b) do { const gpointer tmp = (b); (b) = (a); (a) = tmp; } while (FALSE)
+  else
+    _ncm_spline_func_batch_serial (userdata, x, y, len);
+}
 
-  while (TRUE)
+static NcmSplineFuncKnot
+_ncm_spline_func_type_to_knot (NcmSplineFuncType ftype)
+{
+  switch (ftype)
   {
-    gsize improves = 0;
-    wnodes = nodes;
-    g_array_set_size (xt_array, 0);
-    g_array_set_size (yt_array, 0);
-
-    do
-    {
-      g_array_append_val (xt_array, BIVEC_LIST_X (wnodes));
-      g_array_append_val (yt_array, BIVEC_LIST_Y (wnodes));
-
-      if (BIVEC_LIST_OK (wnodes) == 1)
-        continue;
-      else
-      {
-        const gdouble x0    = BIVEC_LIST_X(wnodes);
-        const gdouble x1    = BIVEC_LIST_X(wnodes->next);
-        const gdouble ax0   = asinh (x0);
-        const gdouble ax1   = asinh (x1);
-        const gdouble y0    = BIVEC_LIST_Y(wnodes);
-        const gdouble y1    = BIVEC_LIST_Y(wnodes->next);
-        const gdouble ax    = (ax0 + ax1) / 2.0;
-        const gdouble x     = sinh (ax);
-        const gdouble y     = GSL_FN_EVAL (F, x);
-        const gdouble ys    = ncm_spline_eval (s, x);
-        const gdouble delta = (x - 0.5 * (x1 + x0)) / (0.5 * (x1 - x0));
-        const gdouble Iyc   = (x1 - x0) * (y1 * (3.0 - 2.0 / (1.0 - delta)) + y0 * (3.0 - 2.0 / (1.0 + delta)) + 4.0 * y / (1.0 - delta * delta)) / 6.0;
-        const gdouble Iys = ncm_spline_eval_integ (s, x0, x1);
-        /*printf ("NEW KNOT (% 22.15g % 22.15g % 22.15g) = [% 22.15g (% 22.15g <=> % 22.15g) % 22.15g] %e %e\n", x0, x, x1, y0, y, ys, y1, TEST_CMP(y, ys), TEST_CMP(Iyc, Iys));*/
-        const gboolean test_p = (TEST_CMP(y, ys) < rel_error);
-        const gboolean test_I = (TEST_CMP(Iyc, Iys) < rel_error);
-#ifdef _NCM_SPLINE_TEST_DIFF
-        const gdouble dyc = (y1 - y0) / (x1 - x0);
-        const gdouble dys = ncm_spline_eval_deriv (s, x);
-        const gboolean test_d = (TEST_CMP(dyc, dys) < rel_error);
-#endif /* _NCM_SPLINE_TEST_DIFF */
-
-        BIVEC_LIST_INSERT_BEFORE (nodes, wnodes->next, x, y);
-        wnodes = g_list_next (wnodes);
-        g_array_append_val(xt_array, BIVEC_LIST_X(wnodes));
-        g_array_append_val(yt_array, BIVEC_LIST_Y(wnodes));
-        BIVEC_LIST_OK(wnodes) = BIVEC_LIST_OK(wnodes->prev);
-
-#ifdef _NCM_SPLINE_TEST_DIFF
-        if (test_p && test_I && test_d)
-#else
-          if (test_p && test_I)
-#endif /* _NCM_SPLINE_TEST_DIFF */
-        {
-          BIVEC_LIST_OK(wnodes->prev)++;
-          BIVEC_LIST_OK(wnodes)++;
-        }
-        else
-          improves++;
-      }
-    } while ((wnodes = g_list_next (wnodes)) && wnodes->next);
-
-    if (wnodes != NULL)
-    {
-      g_array_append_val (xt_array, BIVEC_LIST_X (wnodes));
-      g_array_append_val (yt_array, BIVEC_LIST_Y (wnodes));
-    }
-    
-    SWAP_PTR (x_array, xt_array);
-    SWAP_PTR (y_array, yt_array);
-
-    ncm_spline_set_array (s, x_array, y_array, TRUE);
-    if (x_array->len > max_nodes)
-    {
-      g_warning ("ncm_spline_new_function_spline: cannot achive requested precision with at most %zu nodes", max_nodes);
-      break;
-    }
-
-    if (improves == 0)
-      break;
+    case NCM_SPLINE_FUNCTION_SPLINE:
+      return _NCM_SPLINE_FUNC_KNOT_LINEAR;
+    case NCM_SPLINE_FUNCTION_SPLINE_LNKNOT:
+      return _NCM_SPLINE_FUNC_KNOT_LN;
+    case NCM_SPLINE_FUNCTION_SPLINE_SINHKNOT:
+      return _NCM_SPLINE_FUNC_KNOT_SINH;
+    default:
+      g_error ("ncm_spline_set_func: batched evaluation is not available for the function type %d.", ftype);
+      return _NCM_SPLINE_FUNC_KNOT_LINEAR;
   }
-  g_list_free_full (nodes, _BIVec_free);
-
-  g_array_unref (x_array);
-  g_array_unref (xt_array);
-  g_array_unref (y_array);
-  g_array_unref (yt_array);
-
-  return;
 }
 
 /**
@@ -638,16 +541,64 @@ ncm_spline_set_func (NcmSpline *s, NcmSplineFuncType ftype, gsl_function *F, gdo
       ncm_spline_new_function_2x2 (s, F, xi, xf, max_nodes, rel_error);
       break;
     case NCM_SPLINE_FUNCTION_SPLINE:
-      ncm_spline_new_function_spline (s, F, xi, xf, max_nodes, rel_error);
-      break;
     case NCM_SPLINE_FUNCTION_SPLINE_LNKNOT:
-      ncm_spline_new_function_spline_lnknot (s, F, xi, xf, max_nodes, rel_error);
-      break;
     case NCM_SPLINE_FUNCTION_SPLINE_SINHKNOT:
-      ncm_spline_new_function_spline_sinhknot (s, F, xi, xf, max_nodes, rel_error);
+      _ncm_spline_func_refine (s, _ncm_spline_func_type_to_knot (ftype), &_ncm_spline_func_batch_serial, F, xi, xf, max_nodes, rel_error);
       break;
     default:
       g_assert_not_reached ();
       return;
   }
 }
+
+/**
+ * ncm_spline_set_func_batch: (skip)
+ * @s: a #NcmSpline.
+ * @ftype: a #NcmSplineFuncType.
+ * @Fb: a #NcmSplineFuncBatchF.
+ * @userdata: user data passed to @Fb.
+ * @xi: lower knot.
+ * @xf: upper knot.
+ * @max_nodes: maximum number of knots.
+ * @rel_error: relative error between the function to be interpolated and the spline result.
+ *
+ * Same as ncm_spline_set_func() but the function is evaluated through
+ * @Fb, which receives all new knots of each refinement pass at once.
+ * This allows @Fb to share expensive sub-computations between the points
+ * or to evaluate them in parallel. For a deterministic function the knots
+ * are identical to the ones obtained by ncm_spline_set_func(). Only the
+ * types #NCM_SPLINE_FUNCTION_SPLINE, #NCM_SPLINE_FUNCTION_SPLINE_LNKNOT
+ * and #NCM_SPLINE_FUNCTION_SPLINE_SINHKNOT are supported.
+ *
+ */
+void
+ncm_spline_set_func_batch (NcmSpline *s, NcmSplineFuncType ftype, NcmSplineFuncBatchF Fb, gpointer userdata, gdouble xi, gdouble xf, gsize max_nodes, gdouble rel_error)
+{
+  ncm_assert_cmpdouble_e (xf, >, xi, DBL_EPSILON, 0.0);
+
+  _ncm_spline_func_refine (s, _ncm_spline_func_type_to_knot (ftype), Fb, userdata, xi, xf, max_nodes, rel_error);
+}
+
+/**
+ * ncm_spline_set_func_mt: (skip)
+ * @s: a #NcmSpline.
+ * @ftype: a #NcmSplineFuncType.
+ * @F: function to be approximated by spline functions.
+ * @xi: lower knot.
+ * @xf: upper knot.
+ * @max_nodes: maximum number of knots.
+ * @rel_error: relative error between the function to be interpolated and the spline result.
+ *
+ * Same as ncm_spline_set_func() but the new knots of each refinement pass
+ * are evaluated using the library thread pool, see ncm_func_eval_threaded_loop().
+ * The function @F must be reentrant and this function should not be called
+ * from a thread of the pool itself.
+ *
+ */
+void
+ncm_spline_set_func_mt (NcmSpline *s, NcmSplineFuncType ftype, gsl_function *F, gdouble xi, gdouble xf, gsize max_nodes, gdouble rel_error)
+{
+  ncm_assert_cmpdouble_e (xf, >, xi, DBL_EPSILON, 0.0);
+
+  _ncm_spline_func_refine (s, _ncm_spline_func_type_to_knot (ftype), &_ncm_spline_func_batch_mt, F, xi, xf, max_nodes, rel_error);
+}
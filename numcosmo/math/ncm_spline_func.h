@@ -52,7 +52,21 @@ typedef enum _NcmSplineFuncType
   NCM_SPLINE_FUNCTION_SPLINE_SINHKNOT,
 } NcmSplineFuncType;
 
+/**
+ * NcmSplineFuncBatchF:
+ * @userdata: user data
+ * @x: points where to evaluate the function
+ * @y: (out): function values at @x
+ * @len: number of points
+ *
+ * Computes the function at the @len points @x storing the results in @y.
+ *
+ */
+typedef void (*NcmSplineFuncBatchF) (gpointer userdata, const gdouble *x, gdouble *y, const guint len);
+
 void ncm_spline_set_func (NcmSpline *s, NcmSplineFuncType ftype, gsl_function *F, gdouble xi, gdouble xf, gsize max_nodes, gdouble rel_error);
+void ncm_spline_set_func_batch (NcmSpline *s, NcmSplineFuncType ftype, NcmSplineFuncBatchF Fb, gpointer userdata, gdouble xi, gdouble xf, gsize max_nodes, gdouble rel_error);
+void ncm_spline_set_func_mt (NcmSpline *s, NcmSplineFuncType ftype, gsl_function *F, gdouble xi, gdouble xf, gsize max_nodes, gdouble rel_error);
 
 #define NCM_SPLINE_FUNC_DEFAULT_MAX_NODES 10000000
 #define NCM_SPLINE_KNOT_DIFF_TOL (GSL_DBL_EPSILON * 1.0e2)
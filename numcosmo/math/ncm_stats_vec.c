@@ -80,6 +80,7 @@
 
 #include "math/ncm_stats_vec.h"
 #include "math/ncm_cfg.h"
+#include "math/ncm_func_eval.h"
 #include "ncm_enum_types.h"
 
 #include <math.h>
@@ -128,6 +129,18 @@ ncm_stats_vec_init (NcmStatsVec *svec)
 
   svec->q_array  = g_ptr_array_new ();
   g_ptr_array_set_free_func (svec->q_array, (GDestroyNotify) gsl_rstat_quantile_free);
+
+  svec->lag_max   = 0;
+  svec->lag_nwin  = 0;
+  svec->lag_block = 1;
+  svec->lag_n     = 0;
+  svec->lag_valid = FALSE;
+  svec->lag_ring  = NULL;
+  svec->lag_win   = NULL;
+  svec->bm_nlev   = 0;
+  svec->bm_data   = NULL;
+  svec->bm_count  = NULL;
+  svec->bm_pend   = NULL;
   
 #ifdef NUMCOSMO_HAVE_FFTW3
   svec->fft_size       = 0;
@@ -160,6 +173,7 @@ _ncm_stats_vec_dispose (GObject *object)
   }
 
   g_clear_pointer (&svec->q_array, g_ptr_array_unref);
+  g_clear_pointer (&svec->lag_win, g_ptr_array_unref);
 
   /* Chain up : end */
   G_OBJECT_CLASS (ncm_stats_vec_parent_class)->dispose (object);
@@ -170,6 +184,11 @@ _ncm_stats_vec_finalize (GObject *object)
 {
   NcmStatsVec *svec = NCM_STATS_VEC (object);
 
+  g_clear_pointer (&svec->lag_ring, g_free);
+  g_clear_pointer (&svec->bm_data,  g_free);
+  g_clear_pointer (&svec->bm_count, g_free);
+  g_clear_pointer (&svec->bm_pend,  g_free);
+
 #ifdef NUMCOSMO_HAVE_FFTW3
   g_clear_pointer (&svec->param_fft,  fftw_free);
   g_clear_pointer (&svec->param_data, fftw_free);
@@ -184,6 +203,8 @@ _ncm_stats_vec_finalize (GObject *object)
 static void _ncm_stats_vec_update_from_vec_weight_cov (NcmStatsVec *svec, const gdouble w, NcmVector *x);
 static void _ncm_stats_vec_update_from_vec_weight_var (NcmStatsVec *svec, const gdouble w, NcmVector *x);
 static void _ncm_stats_vec_update_from_vec_weight_mean (NcmStatsVec *svec, const gdouble w, NcmVector *x);
+static void _ncm_stats_vec_lag_update (NcmStatsVec *svec, NcmVector *x);
+static void _ncm_stats_vec_lag_reset (NcmStatsVec *svec);
 
 static void
 _ncm_stats_vec_constructed (GObject *object)
@@ -427,6 +448,9 @@ ncm_stats_vec_reset (NcmStatsVec *svec, gboolean rm_saved)
   svec->bias_wt  = 0.0;
   svec->nitens   = 0;
 
+  if (svec->lag_win != NULL)
+    _ncm_stats_vec_lag_reset (svec);
+
   switch (svec->t)
   {
     case NCM_STATS_VEC_COV:
@@ -597,6 +621,8 @@ void
 ncm_stats_vec_update_weight (NcmStatsVec *svec, const gdouble w)
 {
   svec->update (svec, w, svec->x);
+  if (svec->lag_win != NULL)
+    _ncm_stats_vec_lag_update (svec, svec->x);
   if (svec->save_x)
   {
     NcmVector *v = ncm_vector_dup (svec->x);
@@ -623,6 +649,8 @@ void
 ncm_stats_vec_append_weight (NcmStatsVec *svec, NcmVector *x, gdouble w, gboolean dup)
 {
   svec->update (svec, w, x);
+  if (svec->lag_win != NULL)
+    _ncm_stats_vec_lag_update (svec, x);
   if (svec->save_x)
   {
     if (dup)
@@ -651,6 +679,7 @@ void
 ncm_stats_vec_prepend_weight (NcmStatsVec *svec, NcmVector *x, gdouble w, gboolean dup)
 {
   svec->update (svec, w, x);
+  svec->lag_valid = FALSE;
 
   if (svec->save_x)
   {
@@ -731,6 +760,8 @@ ncm_stats_vec_append_data (NcmStatsVec *svec, GPtrArray *data, gboolean dup)
   {
     NcmVector *x = g_ptr_array_index (data, i);
     svec->update (svec, 1.0, x);
+    if (svec->lag_win != NULL)
+      _ncm_stats_vec_lag_update (svec, x);
     if (svec->save_x)
     {
       if (dup)
@@ -761,6 +792,8 @@ ncm_stats_vec_prepend_data (NcmStatsVec *svec, GPtrArray *data, gboolean dup)
 {
   guint i;
 
+  svec->lag_valid = FALSE;
+
   if (svec->save_x)
   {
     const guint cp_len  = data->len;
@@ -892,6 +925,412 @@ ncm_stats_vec_get_quantile_spread (NcmStatsVec *svec, guint i)
   }
 }
 
+/*
+ * Lagged-product windows.
+ *
+ * Each window starts at a row $t_0$ and keeps, for every component, the sum
+ * of $y_t = x_t - x_{t_0}$, the lagged products
+ * $S_k = \sum_t y_t y_{t+k}$ for $0 \le k \le$ max_lag and the first
+ * max_lag values of $y_t$. The last max_lag rows are shared by all windows
+ * through a ring buffer (component-major). With these quantities the
+ * autocovariance of the rows $[t_0, n)$ is recovered in $O(\text{max\_lag})$
+ * without touching the saved rows.
+ */
+
+typedef struct _NcmStatsVecLagWin
+{
+  guint start;
+  guint n;
+  gdouble *shift;
+  gdouble *sum;
+  gdouble *S;
+  gdouble *head;
+} NcmStatsVecLagWin;
+
+static NcmStatsVecLagWin *
+_ncm_stats_vec_lag_win_new (NcmStatsVec *svec, const guint start)
+{
+  NcmStatsVecLagWin *win = g_new (NcmStatsVecLagWin, 1);
+  const guint len        = svec->len;
+  const guint L          = svec->lag_max;
+
+  win->start = start;
+  win->n     = 0;
+  win->shift = g_new0 (gdouble, len * (2 * L + 3));
+  win->sum   = win->shift + len;
+  win->S     = win->sum + len;
+  win->head  = win->S + len * (L + 1);
+
+  return win;
+}
+
+static void
+_ncm_stats_vec_lag_win_free (NcmStatsVecLagWin *win)
+{
+  g_free (win->shift);
+  g_free (win);
+}
+
+static void
+_ncm_stats_vec_lag_reset (NcmStatsVec *svec)
+{
+  g_ptr_array_set_size (svec->lag_win, 0);
+  svec->lag_block = 1;
+  svec->lag_n     = 0;
+  svec->lag_valid = TRUE;
+
+  memset (svec->bm_data,  0, sizeof (gdouble)  * svec->len * (3 * svec->bm_nlev + 1));
+  memset (svec->bm_count, 0, sizeof (gulong)   * svec->bm_nlev);
+  memset (svec->bm_pend,  0, sizeof (gboolean) * svec->bm_nlev);
+}
+
+/*
+ * Multiscale batch means.
+ *
+ * For each level l the rows are grouped in consecutive batches of size 2^l
+ * and the mean and the sum of squared deviations of the complete batch means
+ * are accumulated (Welford). A batch of level l + 1 is formed by two
+ * consecutive batches of level l, so each row costs O(1) amortized. The
+ * layout of bm_data is: means (len x nlev), M2 (len x nlev), pending sums
+ * (len x nlev) and a len sized scratch area.
+ */
+
+#define NCM_STATS_VEC_BM_NLEV (48)
+#define NCM_STATS_VEC_BM_MIN_BATCHES (32)
+
+static void
+_ncm_stats_vec_bm_update (NcmStatsVec *svec, NcmVector *x)
+{
+  const guint len   = svec->len;
+  const guint nlev  = svec->bm_nlev;
+  gdouble *bm_mean  = svec->bm_data;
+  gdouble *bm_M2    = bm_mean + len * nlev;
+  gdouble *bm_psum  = bm_M2 + len * nlev;
+  gdouble *s        = bm_psum + len * nlev;
+  guint l           = 0;
+  guint p;
+
+  for (p = 0; p < len; p++)
+    s[p] = ncm_vector_fast_get (x, p);
+
+  while (TRUE)
+  {
+    const gdouble b = ldexp (1.0, l);
+    const gulong nb = ++svec->bm_count[l];
+
+    for (p = 0; p < len; p++)
+    {
+      const guint i    = p * nlev + l;
+      const gdouble m  = s[p] / b;
+      const gdouble dm = m - bm_mean[i];
+
+      bm_mean[i] += dm / nb;
+      bm_M2[i]   += dm * (m - bm_mean[i]);
+    }
+
+    if (l + 1 == nlev)
+      break;
+
+    if (svec->bm_pend[l + 1])
+    {
+      for (p = 0; p < len; p++)
+        s[p] += bm_psum[p * nlev + l + 1];
+
+      svec->bm_pend[l + 1] = FALSE;
+      l++;
+    }
+    else
+    {
+      for (p = 0; p < len; p++)
+        bm_psum[p * nlev + l + 1] = s[p];
+
+      svec->bm_pend[l + 1] = TRUE;
+      break;
+    }
+  }
+}
+
+static void
+_ncm_stats_vec_lag_update (NcmStatsVec *svec, NcmVector *x)
+{
+  const guint len  = svec->len;
+  const guint L    = svec->lag_max;
+  const guint t    = svec->lag_n;
+  const guint slot = t % L;
+  guint w, p;
+
+  if ((t % svec->lag_block) == 0)
+    g_ptr_array_add (svec->lag_win, _ncm_stats_vec_lag_win_new (svec, t));
+
+  for (w = 0; w < svec->lag_win->len; w++)
+  {
+    NcmStatsVecLagWin *win = g_ptr_array_index (svec->lag_win, w);
+    const guint kmax       = GSL_MIN (win->n, L);
+    const guint k1         = GSL_MIN (kmax, slot);
+
+    for (p = 0; p < len; p++)
+    {
+      const gdouble x_p     = ncm_vector_fast_get (x, p);
+      const gdouble *ring_p = &svec->lag_ring[p * L];
+      gdouble *S_p          = &win->S[p * (L + 1)];
+      gdouble shift_p, y;
+      guint k;
+
+      if (win->n == 0)
+        win->shift[p] = x_p;
+
+      shift_p = win->shift[p];
+      y       = x_p - shift_p;
+
+      win->sum[p] += y;
+      if (win->n < L)
+        win->head[p * L + win->n] = y;
+
+      S_p[0] += y * y;
+      for (k = 1; k <= k1; k++)
+        S_p[k] += y * (ring_p[slot - k] - shift_p);
+      for (k = k1 + 1; k <= kmax; k++)
+        S_p[k] += y * (ring_p[slot + L - k] - shift_p);
+    }
+
+    win->n++;
+  }
+
+  for (p = 0; p < len; p++)
+    svec->lag_ring[p * L + slot] = ncm_vector_fast_get (x, p);
+
+  svec->lag_n++;
+
+  _ncm_stats_vec_bm_update (svec, x);
+
+  if (svec->lag_win->len > 2 * svec->lag_nwin)
+  {
+    svec->lag_block *= 2;
+
+    w = 0;
+    while (w < svec->lag_win->len)
+    {
+      NcmStatsVecLagWin *win = g_ptr_array_index (svec->lag_win, w);
+
+      if ((win->start % svec->lag_block) != 0)
+        g_ptr_array_remove_index (svec->lag_win, w);
+      else
+        w++;
+    }
+  }
+}
+
+/*
+ * Fills gamma[0..K] with the (unnormalized) autocovariance of the component
+ * p in the window win and returns K = min (max_lag, n - 1).
+ */
+static guint
+_ncm_stats_vec_lag_win_autocov (NcmStatsVec *svec, NcmStatsVecLagWin *win, const guint p, gdouble *gamma)
+{
+  const guint L         = svec->lag_max;
+  const guint n         = win->n;
+  const guint K         = GSL_MIN (L, n - 1);
+  const guint last      = (svec->lag_n - 1) % L;
+  const gdouble mu      = win->sum[p] / n;
+  const gdouble *S_p    = &win->S[p * (L + 1)];
+  const gdouble *head_p = &win->head[p * L];
+  const gdouble *ring_p = &svec->lag_ring[p * L];
+  gdouble F = 0.0, G = 0.0;
+  guint k;
+
+  gamma[0] = S_p[0] - n * mu * mu;
+  for (k = 1; k <= K; k++)
+  {
+    F += head_p[k - 1];
+    G += ring_p[(last + L - (k - 1)) % L] - win->shift[p];
+
+    gamma[k] = S_p[k] - mu * (2.0 * win->sum[p] - F - G) + (n - k) * mu * mu;
+  }
+
+  return K;
+}
+
+/**
+ * ncm_stats_vec_enable_lag_windows:
+ * @svec: a #NcmStatsVec
+ * @max_lag: maximum lag kept
+ * @nwin: minimum number of windows, if zero the default 10 is used
+ *
+ * Enables the lagged-product windows. Once enabled, every appended row
+ * updates, for a set of starting points $t_i$, the sums necessary to
+ * compute the autocovariance of the rows $[t_i, n)$ up to lag @max_lag.
+ * The starting points are the multiples of a block size which is doubled
+ * whenever there are more than 2@nwin windows, i.e., there are always
+ * between @nwin and 2@nwin roughly evenly spaced windows.
+ *
+ * These windows are used by ncm_stats_vec_max_ess_time() and
+ * ncm_stats_vec_heidel_diag() to obtain the AR fits without rebuilding
+ * the chunks, the cost per appended row is proportional to @nwin times @max_lag for
+ * each component. The AR order used in these fits is bounded by @max_lag.
+ * The windows disregard the weights, as the AR estimates do, and are
+ * invalidated by ncm_stats_vec_prepend() and friends until the next
+ * ncm_stats_vec_reset().
+ *
+ * Together with the windows a multiscale batch means summary is kept,
+ * see ncm_stats_vec_get_batch_means_tau(). The memory used by both is 
+ * bounded and independent of the number of rows. Hence, a #NcmStatsVec
+ * created with save_x == FALSE and with the windows enabled works in 
+ * streaming mode, ncm_stats_vec_get_autocorr(), 
+ * ncm_stats_vec_get_autocorr_tau(), ncm_stats_vec_ar_ess() and 
+ * ncm_stats_vec_max_ess_time() are answered from these summaries.
+ *
+ * If @svec already contains data it must have been created with
+ * save_x == TRUE, in this case the saved rows are used to build the windows.
+ *
+ */
+void
+ncm_stats_vec_enable_lag_windows (NcmStatsVec *svec, const guint max_lag, const guint nwin)
+{
+  g_assert_cmpuint (max_lag, >, 0);
+  g_assert (svec->save_x || (svec->nitens == 0));
+
+  ncm_stats_vec_disable_lag_windows (svec);
+
+  svec->lag_max  = max_lag;
+  svec->lag_nwin = (nwin == 0) ? 10 : nwin;
+  svec->lag_ring = g_new0 (gdouble, svec->len * max_lag);
+  svec->lag_win  = g_ptr_array_new ();
+  svec->bm_nlev  = NCM_STATS_VEC_BM_NLEV;
+  svec->bm_data  = g_new0 (gdouble, svec->len * (3 * svec->bm_nlev + 1));
+  svec->bm_count = g_new0 (gulong, svec->bm_nlev);
+  svec->bm_pend  = g_new0 (gboolean, svec->bm_nlev);
+  g_ptr_array_set_free_func (svec->lag_win, (GDestroyNotify) _ncm_stats_vec_lag_win_free);
+
+  _ncm_stats_vec_lag_reset (svec);
+
+  if (svec->save_x)
+  {
+    guint i;
+    for (i = 0; i < svec->saved_x->len; i++)
+      _ncm_stats_vec_lag_update (svec, g_ptr_array_index (svec->saved_x, i));
+  }
+}
+
+/**
+ * ncm_stats_vec_disable_lag_windows:
+ * @svec: a #NcmStatsVec
+ *
+ * Disables the lagged-product windows, see ncm_stats_vec_enable_lag_windows().
+ *
+ */
+void
+ncm_stats_vec_disable_lag_windows (NcmStatsVec *svec)
+{
+  g_clear_pointer (&svec->lag_win, g_ptr_array_unref);
+  g_clear_pointer (&svec->lag_ring, g_free);
+  g_clear_pointer (&svec->bm_data,  g_free);
+  g_clear_pointer (&svec->bm_count, g_free);
+  g_clear_pointer (&svec->bm_pend,  g_free);
+
+  svec->bm_nlev   = 0;
+  svec->lag_max   = 0;
+  svec->lag_nwin  = 0;
+  svec->lag_block = 1;
+  svec->lag_n     = 0;
+  svec->lag_valid = FALSE;
+}
+
+/**
+ * ncm_stats_vec_has_lag_windows:
+ * @svec: a #NcmStatsVec
+ *
+ * Returns: whether the lagged-product windows are enabled and valid.
+ */
+gboolean
+ncm_stats_vec_has_lag_windows (NcmStatsVec *svec)
+{
+  return (svec->lag_win != NULL) && svec->lag_valid && (svec->lag_n == svec->nitens);
+}
+
+/**
+ * ncm_stats_vec_get_batch_means_tau:
+ * @svec: a #NcmStatsVec
+ * @p: parameter id
+ *
+ * Estimates the integrated autocorrelation time of the component @p
+ * using the multiscale batch means kept along with the lagged-product 
+ * windows, see ncm_stats_vec_enable_lag_windows(). For batches of size
+ * $b$ the estimate is $\tau_b = b\,\mathrm{Var}(\bar{x}_b)/\mathrm{Var}(x)$,
+ * which approaches $\tau$ when $b \gg \tau$. The batch size is doubled 
+ * until $b \geq 10\tau_b$ or until fewer than 32 batches are available.
+ *
+ * It uses $O(\log n)$ memory and time and does not require the saved rows.
+ *
+ * Returns: the integrated autocorrelation time estimate.
+ */
+gdouble
+ncm_stats_vec_get_batch_means_tau (NcmStatsVec *svec, const guint p)
+{
+  const guint nlev     = svec->bm_nlev;
+  const gdouble *bm_M2 = svec->bm_data + svec->len * nlev;
+  gdouble tau          = 1.0;
+  gdouble var;
+  guint l;
+
+  g_assert (ncm_stats_vec_has_lag_windows (svec));
+  g_assert_cmpuint (p, <, svec->len);
+  g_assert_cmpuint (svec->bm_count[0], >, 1);
+
+  var = bm_M2[p * nlev] / (svec->bm_count[0] - 1.0);
+  if (var <= 0.0)
+    return tau;
+
+  for (l = 1; l < nlev; l++)
+  {
+    const gulong nb = svec->bm_count[l];
+    const gdouble b = ldexp (1.0, l);
+
+    if (nb < NCM_STATS_VEC_BM_MIN_BATCHES)
+      break;
+
+    tau = b * (bm_M2[p * nlev + l] / (nb - 1.0)) / var;
+
+    if (b >= 10.0 * tau)
+      break;
+  }
+
+  return tau;
+}
+
+/*
+ * Integrated autocorrelation time summing the first max_lag autocorrelations
+ * of the window containing all rows. When the sum is truncated by the
+ * windows' max_lag and the truncation is too short compared to the 
+ * estimate (M < 5 tau) the batch means estimate is used instead.
+ */
+static gdouble
+_ncm_stats_vec_lag_autocorr_tau (NcmStatsVec *svec, const guint p, const guint max_lag)
+{
+  NcmStatsVecLagWin *win = g_ptr_array_index (svec->lag_win, 0);
+  gdouble *gamma         = g_new (gdouble, svec->lag_max + 1);
+  const guint K          = _ncm_stats_vec_lag_win_autocov (svec, win, p, gamma);
+  const guint Fmax_lag   = GSL_MIN (max_lag, K);
+  gdouble tau            = 0.0;
+  guint i;
+
+  g_assert_cmpuint (Fmax_lag, >, 0);
+
+  if (gamma[0] > 0.0)
+  {
+    for (i = 1; i < Fmax_lag + 1; i++)
+      tau += gamma[i] / gamma[0];
+  }
+
+  tau = 1.0 + 2.0 * tau;
+
+  if ((Fmax_lag < max_lag) && (Fmax_lag < 5.0 * tau))
+    tau = ncm_stats_vec_get_batch_means_tau (svec, p);
+
+  g_free (gamma);
+
+  return tau;
+}
+
 static void
 _ncm_stats_vec_get_autocorr_alloc (NcmStatsVec *svec, guint size)
 {
@@ -1004,11 +1443,27 @@ _ncm_stats_vec_get_autocov (NcmStatsVec *svec, guint p, guint subsample, guint p
  * The returning vector use the internal memory allocation and will
  * change with subsequent calls to ncm_stats_vec_get_autocorr().
  *
+ * If @svec does not save the rows but has the lagged-product windows
+ * enabled, see ncm_stats_vec_enable_lag_windows(), only the first 
+ * max_lag + 1 autocorrelations are returned.
+ *
  * Returns: (transfer full): the autocorrelation vector.
  */
 NcmVector *
 ncm_stats_vec_get_autocorr (NcmStatsVec *svec, guint p)
 {
+  if (!svec->save_x && ncm_stats_vec_has_lag_windows (svec))
+  {
+    NcmStatsVecLagWin *win = g_ptr_array_index (svec->lag_win, 0);
+    NcmVector *autocor     = ncm_vector_new (svec->lag_max + 1);
+    const guint K          = _ncm_stats_vec_lag_win_autocov (svec, win, p, ncm_vector_data (autocor));
+    NcmVector *autocor_K   = ncm_vector_get_subvector (autocor, 0, K + 1);
+
+    ncm_vector_scale (autocor_K, 1.0 / ncm_vector_get (autocor_K, 0));
+    ncm_vector_free (autocor);
+
+    return autocor_K;
+  }
 #ifdef NUMCOSMO_HAVE_FFTW3
   _ncm_stats_vec_get_autocov (svec, p, 1, 0);
   {
@@ -1235,6 +1690,134 @@ ncm_stats_vec_fit_ar_model (NcmStatsVec *svec, guint p, const guint order, NcmSt
 #endif /* NUMCOSMO_HAVE_FFTW3 */
 }
 
+static gdouble
+_ncm_stats_vec_ar_crit (const NcmStatsVecARType ar_crit, const gdouble n, const gdouble var, const gdouble p)
+{
+  switch (ar_crit)
+  {
+    case NCM_STATS_VEC_AR_NONE:
+      return -p;
+    case NCM_STATS_VEC_AR_FPE:
+      return var * (n + p) / (n - p);
+    case NCM_STATS_VEC_AR_AIC:
+      return n * log (var) + 2.0 * (p + 1.0);
+    case NCM_STATS_VEC_AR_AICC:
+      return n * log (var) + 2.0 * n * (p + 1.0) / (n - p - 2.0);
+    default:
+      g_assert_not_reached ();
+      return 0.0;
+  }
+}
+
+/*
+ * Fits the AR model using the Levinson-Durbin recursion on the
+ * autocovariances gamma[0..kmax]. The recursion is extended one order at a
+ * time while evaluating @ar_crit. Whenever the criterion is minimized at the
+ * largest order tried, the maximum order is doubled and the recursion
+ * continues from where it stopped, instead of refitting from scratch.
+ * Only the sum of the AR coefficients is necessary for the spectral density
+ * at zero, which satisfies $\Sigma_m = \Sigma_{m-1}(1 - \kappa_m) + \kappa_m$
+ * where $\kappa_m$ is the m-th partial autocorrelation.
+ */
+static gdouble
+_ncm_stats_vec_ar_ess_lev (const gdouble *gamma, const guint kmax, const guint nitens, const gdouble var, const NcmStatsVecARType ar_crit, gdouble *spec0, guint *c_order)
+{
+  const gdouble n       = nitens;
+  const guint max_order = (nitens > 3) ? GSL_MIN (kmax, nitens - 3) : 0;
+  guint aorder          = GSL_MIN (max_order, floor (10.0 * log10 (n)));
+  gdouble *phi          = g_new (gdouble, aorder + 1);
+  gdouble v             = gamma[0];
+  gdouble var_m         = var;
+  gdouble sum_m         = 0.0;
+  gdouble ivar          = var;
+  gdouble best_sum      = 0.0;
+  gdouble min_crit      = _ncm_stats_vec_ar_crit (ar_crit, n, var, 0.0);
+  gboolean stop         = FALSE;
+  guint m               = 0;
+
+  c_order[0] = 0;
+
+  if ((gamma[0] <= 0.0) || (var <= 0.0))
+  {
+    g_free (phi);
+    spec0[0] = 0.0;
+    return n;
+  }
+
+  while (TRUE)
+  {
+    for (; m < aorder; m++)
+    {
+      const guint o = m + 1;
+      gdouble acc   = gamma[o];
+      gdouble kappa, crit;
+      guint j;
+
+      for (j = 1; j < o; j++)
+        acc -= phi[j] * gamma[o - j];
+
+      kappa = acc / v;
+      if (fabs (kappa) >= 1.0)
+      {
+        stop = TRUE;
+        break;
+      }
+
+      for (j = 1; 2 * j < o; j++)
+      {
+        const gdouble a = phi[j];
+        const gdouble b = phi[o - j];
+
+        phi[j]     = a - kappa * b;
+        phi[o - j] = b - kappa * a;
+      }
+      if (o % 2 == 0)
+        phi[o / 2] *= 1.0 - kappa;
+      phi[o] = kappa;
+
+      v     *= 1.0 - kappa * kappa;
+      var_m *= 1.0 - kappa * kappa;
+      sum_m  = sum_m * (1.0 - kappa) + kappa;
+      crit   = _ncm_stats_vec_ar_crit (ar_crit, n, var_m, o);
+
+      if (crit < min_crit)
+      {
+        min_crit   = crit;
+        c_order[0] = o;
+        ivar       = var_m;
+        best_sum   = sum_m;
+      }
+    }
+
+    if (!stop && (aorder > 0) && (c_order[0] == aorder) && (aorder < max_order) && (2 * c_order[0] + 1 < nitens))
+    {
+      aorder = GSL_MIN (2 * aorder, max_order);
+      phi    = g_renew (gdouble, phi, aorder + 1);
+    }
+    else
+      break;
+  }
+
+  g_free (phi);
+
+  ivar    *= (n - 1.0) / (n - (c_order[0] + 1.0));
+  spec0[0] = ivar / gsl_pow_2 (1.0 - best_sum);
+
+  return n * var / spec0[0];
+}
+
+/*
+ * AR effective sample size of the component p in the window win
+ * using the lagged-product sums, gamma must have max_lag + 1 elements.
+ */
+static gdouble
+_ncm_stats_vec_lag_win_ar_ess (NcmStatsVec *svec, NcmStatsVecLagWin *win, const guint p, NcmStatsVecARType ar_crit, gdouble *gamma, gdouble *spec0, guint *c_order)
+{
+  const guint K = _ncm_stats_vec_lag_win_autocov (svec, win, p, gamma);
+  
+  return _ncm_stats_vec_ar_ess_lev (gamma, K, win->n, gamma[0] / (win->n - 1.0), ar_crit, spec0, c_order);
+}
+
 /**
  * ncm_stats_vec_ar_ess:
  * @svec: a #NcmStatsVec
@@ -1244,34 +1827,43 @@ ncm_stats_vec_fit_ar_model (NcmStatsVec *svec, guint p, const guint order, NcmSt
  * @c_order: (out): @ar_crit determined order
  *
  * Calculates the effective sample size for the parameter @p.
+ * The autocovariance is computed once and the AR order is
+ * increased incrementally through the Levinson-Durbin recursion.
+ *
+ * If the lagged-product windows are enabled, see 
+ * ncm_stats_vec_enable_lag_windows(), the autocovariance is obtained
+ * from the window containing all rows in $O(\text{max\_lag})$, without
+ * accessing the saved rows, and the AR order is bounded by max_lag.
  *
  * Returns: the effective sample size.
  */
 gdouble 
 ncm_stats_vec_ar_ess (NcmStatsVec *svec, guint p, NcmStatsVecARType ar_crit, gdouble *spec0, guint *c_order)
 {
-  NcmVector *rho = NULL, *pacf = NULL;
-  gdouble ivar  = 0.0;
-  guint order = 0;
-
   g_assert_cmpuint (p, <, svec->len);
-  
-  while (ncm_stats_vec_fit_ar_model (svec, p, order, ar_crit, &rho, &pacf, &ivar, c_order) && (2 * c_order[0] + 1 < svec->nitens))
-  {
-    ncm_vector_clear (&rho);
-    ncm_vector_clear (&pacf);
 
-    order = 2 * c_order[0];
-  }
+  if (ncm_stats_vec_has_lag_windows (svec))
+  {
+    NcmStatsVecLagWin *win = g_ptr_array_index (svec->lag_win, 0);
+    gdouble *gamma         = g_new (gdouble, svec->lag_max + 1);
+    const gdouble ess      = _ncm_stats_vec_lag_win_ar_ess (svec, win, p, ar_crit, gamma, spec0, c_order);
 
-  spec0[0] = ivar;
-  if (c_order[0] > 0)
-    spec0[0] *= 1.0 / gsl_pow_2 (1.0 - ncm_vector_sum_cpts (rho));
+    g_free (gamma);
 
-  ncm_vector_clear (&rho);
-  ncm_vector_clear (&pacf);
+    return ess;
+  }
+  else
+  {
+#ifdef NUMCOSMO_HAVE_FFTW3
+    _ncm_stats_vec_get_autocov (svec, p, 1, 0);
 
-  return svec->nitens * ncm_stats_vec_get_var (svec, p) / spec0[0];
+    return _ncm_stats_vec_ar_ess_lev (svec->param_data, svec->nitens - 1, svec->nitens, 
+                                      ncm_stats_vec_get_var (svec, p), ar_crit, spec0, c_order);
+#else
+    g_error ("ncm_stats_vec_ar_ess: recompile NumCosmo with fftw support.");
+    return 0.0;
+#endif /* NUMCOSMO_HAVE_FFTW3 */
+  }
 }
 
 static gdouble
@@ -1302,6 +1894,60 @@ _ncm_stats_vec_heidel_diag_pcramer (const gdouble q)
   return GSL_MIN (GSL_MAX (p * ffac, 0.0), 1.0);
 }
 
+typedef struct _NcmStatsVecHeidelEval
+{
+  NcmStatsVec *svec;
+  GArray *tests;
+  NcmVector *spec0;
+  NcmMatrix *pvals;
+} NcmStatsVecHeidelEval;
+
+/*
+ * Computes the Cramer-von Mises statistic for all tests in a single backward
+ * pass through the rows. For the chunk $[i, n)$ with cumulative sums $C_j$
+ * (from the end) and mean $\mu_i = C_i / n_i$ we have
+ * $\sum_j (C_j - n_j\mu_i)^2 = \sum_j C^2_j - 2\mu_i\sum_j n_jC_j + \mu_i^2\sum_j n_j^2$,
+ * the statistic is invariant under shifts of the component so we use the
+ * full sample mean to reduce the cancellation.
+ */
+static void
+_ncm_stats_vec_heidel_diag_eval (glong i, glong f, gpointer data)
+{
+  NcmStatsVecHeidelEval *eval = (NcmStatsVecHeidelEval *) data;
+  NcmStatsVec *svec           = eval->svec;
+  const gint nitens           = svec->nitens;
+  glong p;
+
+  for (p = i; p < f; p++)
+  {
+    const gdouble shift   = ncm_stats_vec_get_mean (svec, p);
+    const gdouble spec0_p = ncm_vector_get (eval->spec0, p);
+    gdouble C = 0.0, SC2 = 0.0, SnC = 0.0, Sn2 = 0.0;
+    guint t   = 0;
+    gint j;
+
+    for (j = nitens - 1; t < eval->tests->len; j--)
+    {
+      const gdouble n = nitens - j;
+
+      C   += ncm_stats_vec_get_param_at (svec, j, p) - shift;
+      SC2 += C * C;
+      SnC += n * C;
+      Sn2 += n * n;
+
+      if (j == g_array_index (eval->tests, gint, t))
+      {
+        const gdouble mu   = C / n;
+        const gdouble Ival = (SC2 - 2.0 * mu * SnC + mu * mu * Sn2) / (n * n * spec0_p);
+        const gdouble pval = ((spec0_p > 0.0) && (Ival > 0.0)) ? _ncm_stats_vec_heidel_diag_pcramer (Ival) : 0.0;
+
+        ncm_matrix_set (eval->pvals, t, p, pval);
+        t++;
+      }
+    }
+  }
+}
+
 /**
  * ncm_stats_vec_heidel_diag:
  * @svec: a #NcmStatsVec
@@ -1321,6 +1967,13 @@ _ncm_stats_vec_heidel_diag_pcramer (const gdouble q)
  * If the test is not satisfied by any index @bindex will contain
  * -1 and the return vector the p-values considering the whole system.
  * 
+ * The spectral densities at zero are obtained from the AR fits of 
+ * the second half of the sample. When the lagged-product windows
+ * are enabled, see ncm_stats_vec_enable_lag_windows(), the window
+ * starting closest to the middle of the sample is used instead.
+ * The test statistics of all tests are computed in a single pass
+ * through the saved rows, in parallel over the components.
+ * 
  * See: 
  * - [Heidelberger (1981)][XHeidelberger1981]
  * - [Schruben (1982)][XSchruben1982]
@@ -1331,107 +1984,109 @@ _ncm_stats_vec_heidel_diag_pcramer (const gdouble q)
 NcmVector *
 ncm_stats_vec_heidel_diag (NcmStatsVec *svec, const guint ntests, const gdouble pvalue, gint *bindex, guint *wp, guint *wp_order, gdouble *wp_pvalue)
 {
-  NcmStatsVec *chunk   = ncm_stats_vec_new (svec->len, NCM_STATS_VEC_VAR, TRUE);
   const gint half_size = svec->nitens / 2;
   const gint block     = (ntests == 0) ? ((half_size - 1) / 10 + 1) : ((half_size - 1) / ntests + 1);
   const gdouble onepv  = (pvalue == 0.0) ? 0.95 : (1.0 - pvalue);
   NcmVector *pvals     = ncm_vector_new (svec->len);
-  NcmVector *Ivals     = ncm_vector_new (svec->len);
-  NcmVector *spec0     = ncm_vector_new (svec->len);
-  NcmVector *cumsum    = ncm_vector_new (svec->len);
   GArray *ar_order     = g_array_new (FALSE, FALSE, sizeof (guint));
-  guint c_order        = 0;
+  NcmStatsVecHeidelEval eval;
+  guint p, t;
   gint i;
   
   g_assert_cmpuint (svec->nitens, >=, 10);
   g_assert_cmpfloat (pvalue, <, 1.0);
   g_assert (svec->save_x);
 
-  for (i = svec->nitens - 1; i >= half_size; i--)
-  {
-    NcmVector *row = ncm_stats_vec_peek_row (svec, i);
-    ncm_stats_vec_append (chunk, row, FALSE);
-  }
+  eval.svec  = svec;
+  eval.tests = g_array_new (FALSE, FALSE, sizeof (gint));
+  eval.spec0 = ncm_vector_new (svec->len);
 
-  for (i = 0; i < svec->len; i++)
+  for (i = half_size - 1; i >= 0; i--)
   {
-    ncm_stats_vec_ar_ess (chunk, i, NCM_STATS_VEC_AR_AICC, ncm_vector_ptr (spec0, i), &c_order);
-    g_array_append_val (ar_order, c_order);
+    if ((i % block) == 0)
+      g_array_append_val (eval.tests, i);
   }
 
-  bindex[0] = -1;
-  wp[0]     = 0;
-  
-  for (i = half_size - 1; i >= 0; i--)
+  eval.pvals = ncm_matrix_new (eval.tests->len, svec->len);
+  g_array_set_size (ar_order, svec->len);
+
+  if (ncm_stats_vec_has_lag_windows (svec))
   {
-    NcmVector *row = ncm_stats_vec_peek_row (svec, i);
-    ncm_stats_vec_append (chunk, row, FALSE);
+    NcmStatsVecLagWin *win = NULL;
+    gdouble *gamma         = g_new (gdouble, svec->lag_max + 1);
+    guint w;
 
-    if ((i % block) == 0)
+    for (w = 0; w < svec->lag_win->len; w++)
     {
-      const guint nitens = svec->nitens - i;
-      gint j, p;
+      NcmStatsVecLagWin *win_w = g_ptr_array_index (svec->lag_win, w);
 
-      ncm_vector_set_zero (cumsum);
-      ncm_vector_set_zero (Ivals);
+      if (win_w->n < 10)
+        continue;
 
-      for (j = svec->nitens - 1; j >= i; j--)
-      {
-        NcmVector *row  = ncm_stats_vec_peek_row (svec, j);
-        const gdouble n = (svec->nitens - j);
+      if ((win == NULL) || (ABS ((gint) win_w->start - half_size) < ABS ((gint) win->start - half_size)))
+        win = win_w;
+    }
+    g_assert (win != NULL);
 
-        for (p = 0; p < svec->len; p++)
-        {
-          const gdouble mean_p_n = ncm_stats_vec_get_mean (chunk, p) * n;
-          const gdouble cumsum_p = ncm_vector_get (cumsum, p) + ncm_vector_get (row, p);
+    for (p = 0; p < svec->len; p++)
+      _ncm_stats_vec_lag_win_ar_ess (svec, win, p, NCM_STATS_VEC_AR_AICC, gamma, ncm_vector_ptr (eval.spec0, p), &g_array_index (ar_order, guint, p));
 
-          ncm_vector_set (cumsum, p, cumsum_p);
-          ncm_vector_addto (Ivals, p, gsl_pow_2 (cumsum_p - mean_p_n));
-        }
-      }
+    g_free (gamma);
+  }
+  else
+  {
+    NcmStatsVec *chunk = ncm_stats_vec_new (svec->len, NCM_STATS_VEC_VAR, TRUE);
 
-      {
-        gdouble max_pval = 0.0;
-        gint lwp = 0;
+    for (i = svec->nitens - 1; i >= half_size; i--)
+    {
+      NcmVector *row = ncm_stats_vec_peek_row (svec, i);
+      ncm_stats_vec_append (chunk, row, FALSE);
+    }
 
-        for (p = 0; p < svec->len; p++)
-        {
-          const gdouble Ival_p = ncm_vector_get (Ivals, p) / (gsl_pow_2 (nitens) * ncm_vector_get (spec0, p));
-          const gdouble pval_p = _ncm_stats_vec_heidel_diag_pcramer (Ival_p);
+    for (p = 0; p < svec->len; p++)
+      ncm_stats_vec_ar_ess (chunk, p, NCM_STATS_VEC_AR_AICC, ncm_vector_ptr (eval.spec0, p), &g_array_index (ar_order, guint, p));
 
-          ncm_vector_set (Ivals, p, pval_p);
-          if (pval_p > max_pval)
-          {
-            max_pval = pval_p;
-            lwp      = p;
-          }
-        }
+    ncm_stats_vec_clear (&chunk);
+  }
 
-        if (max_pval <= onepv)
-        {
-          bindex[0] = i;
-          wp[0]     = lwp;
+  ncm_func_eval_threaded_loop_full (&_ncm_stats_vec_heidel_diag_eval, 0, svec->len, &eval);
 
-          ncm_vector_memcpy (pvals, Ivals);
-        }
-      }
+  bindex[0] = -1;
+  wp[0]     = 0;
+
+  for (t = 0; t < eval.tests->len; t++)
+  {
+    NcmVector *pvals_t = ncm_matrix_get_row (eval.pvals, t);
+    const guint lwp    = ncm_vector_get_max_index (pvals_t);
+
+    if (ncm_vector_get (pvals_t, lwp) <= onepv)
+    {
+      bindex[0] = g_array_index (eval.tests, gint, t);
+      wp[0]     = lwp;
+
+      ncm_vector_memcpy (pvals, pvals_t);
     }
+
+    ncm_vector_free (pvals_t);
   }
 
   if (bindex[0] == -1)
   {
-    ncm_vector_memcpy (pvals, Ivals);
+    NcmVector *pvals_t = ncm_matrix_get_row (eval.pvals, eval.tests->len - 1);
+
+    ncm_vector_memcpy (pvals, pvals_t);
     wp[0] = ncm_vector_get_max_index (pvals);
+
+    ncm_vector_free (pvals_t);
   }
 
   wp_pvalue[0] = ncm_vector_get (pvals, wp[0]);
   wp_order[0]  = g_array_index (ar_order, guint, wp[0]);
   
-  ncm_vector_clear (&spec0);
-  ncm_vector_clear (&cumsum);
-  ncm_vector_clear (&Ivals);
-  
-  ncm_stats_vec_clear (&chunk);
+  ncm_vector_clear (&eval.spec0);
+  ncm_matrix_clear (&eval.pvals);
+  g_array_unref (eval.tests);
+  g_array_unref (ar_order);
 
   return pvals;
 }
@@ -1489,23 +2144,106 @@ ncm_stats_vec_visual_heidel_diag (NcmStatsVec *svec, const guint p, const guint
   return cumsum_v;
 }
 
-/**
- * ncm_stats_vec_max_ess_time:
- * @svec: a #NcmStatsVec
- * @ntests: number of tests
- * @bindex: (out): time index of the best ESS's
- * @wp: (out): worst parameter index
- * @wp_order: (out): worst parameter AR fit order
- * @wp_ess: (out): worst parameter ESS
- *
- * Calculates the time $t_m$ that maximizes the Effective Sample Size (ESS). 
- * The variable @ntests control the number of divisions where the ESS
- * will be calculated, if it is zero the default 10 tests will be used.
- * 
- * Returns: (transfer full): a #NcmVector containing the best ess.
- */
-NcmVector *
-ncm_stats_vec_max_ess_time (NcmStatsVec *svec, const guint ntests, gint *bindex, guint *wp, guint *wp_order, gdouble *wp_ess)
+typedef struct _NcmStatsVecESSEval
+{
+  NcmStatsVec *svec;
+  GPtrArray *wins;
+  NcmMatrix *esss;
+  GArray *order;
+} NcmStatsVecESSEval;
+
+static void
+_ncm_stats_vec_max_ess_time_eval (glong i, glong f, gpointer data)
+{
+  NcmStatsVecESSEval *eval = (NcmStatsVecESSEval *) data;
+  NcmStatsVec *svec        = eval->svec;
+  gdouble *gamma           = g_new (gdouble, svec->lag_max + 1);
+  glong k;
+
+  for (k = i; k < f; k++)
+  {
+    const guint w          = k / svec->len;
+    const guint p          = k % svec->len;
+    NcmStatsVecLagWin *win = g_ptr_array_index (eval->wins, w);
+    gdouble spec0          = 0.0;
+    const gdouble ess      = _ncm_stats_vec_lag_win_ar_ess (svec, win, p, NCM_STATS_VEC_AR_AICC, gamma, &spec0, &g_array_index (eval->order, guint, k));
+
+    ncm_matrix_set (eval->esss, w, p, ess);
+  }
+
+  g_free (gamma);
+}
+
+static NcmVector *
+_ncm_stats_vec_max_ess_time_lag (NcmStatsVec *svec, gint *bindex, guint *wp, guint *wp_order, gdouble *wp_ess)
+{
+  NcmVector *esss   = ncm_vector_new (svec->len);
+  gdouble max_t_ess = 0.0;
+  NcmStatsVecESSEval eval;
+  guint k;
+  gint w;
+
+  eval.svec = svec;
+  eval.wins = g_ptr_array_new ();
+
+  for (k = 0; k < svec->lag_win->len; k++)
+  {
+    NcmStatsVecLagWin *win = g_ptr_array_index (svec->lag_win, k);
+
+    if ((k == 0) || (win->n >= 100))
+      g_ptr_array_add (eval.wins, win);
+  }
+
+  eval.esss  = ncm_matrix_new (eval.wins->len, svec->len);
+  eval.order = g_array_new (FALSE, FALSE, sizeof (guint));
+  g_array_set_size (eval.order, eval.wins->len * svec->len);
+
+  ncm_func_eval_threaded_loop_full (&_ncm_stats_vec_max_ess_time_eval, 0, eval.wins->len * svec->len, &eval);
+
+  bindex[0]   = -1;
+  wp[0]       = 0;
+  wp_order[0] = 0;
+
+  for (w = eval.wins->len - 1; w >= 0; w--)
+  {
+    NcmStatsVecLagWin *win = g_ptr_array_index (eval.wins, w);
+    gdouble min_ess        = GSL_POSINF;
+    guint lwp              = 0;
+
+    for (k = 0; k < svec->len; k++)
+    {
+      const gdouble c_ess = GSL_MIN (win->n, ncm_matrix_get (eval.esss, w, k));
+
+      if (c_ess < min_ess)
+      {
+        min_ess = c_ess;
+        lwp     = k;
+      }
+    }
+
+    if (min_ess > max_t_ess)
+    {
+      max_t_ess   = min_ess;
+      bindex[0]   = win->start;
+      wp[0]       = lwp;
+      wp_order[0] = g_array_index (eval.order, guint, w * svec->len + lwp);
+
+      for (k = 0; k < svec->len; k++)
+        ncm_vector_set (esss, k, ncm_matrix_get (eval.esss, w, k));
+    }
+  }
+
+  wp_ess[0] = ncm_vector_get (esss, wp[0]);
+
+  ncm_matrix_clear (&eval.esss);
+  g_array_unref (eval.order);
+  g_ptr_array_unref (eval.wins);
+
+  return esss;
+}
+
+static NcmVector *
+_ncm_stats_vec_max_ess_time_chunk (NcmStatsVec *svec, const guint ntests, gint *bindex, guint *wp, guint *wp_order, gdouble *wp_ess)
 {
   NcmStatsVec *chunk  = ncm_stats_vec_new (svec->len, NCM_STATS_VEC_VAR, TRUE);
   const gint size     = svec->nitens;
@@ -1518,7 +2256,9 @@ ncm_stats_vec_max_ess_time (NcmStatsVec *svec, const guint ntests, gint *bindex,
   g_assert_cmpuint (svec->nitens, >=, 10);
   g_assert (svec->save_x);
 
-  bindex[0] = -1;
+  bindex[0]   = -1;
+  wp[0]       = 0;
+  wp_order[0] = 0;
   for (i = size - 1; i >= 0; i--)
   {
     NcmVector *row_i = ncm_stats_vec_peek_row (svec, i);
@@ -1534,14 +2274,16 @@ ncm_stats_vec_max_ess_time (NcmStatsVec *svec, const guint ntests, gint *bindex,
       for (k = 0; k < svec->len; k++)
       {
         gdouble spec0       = 0.0;
-        const gdouble ess   = ncm_stats_vec_ar_ess (chunk, k, NCM_STATS_VEC_AR_AICC, &spec0, &lwp_order);
+        guint k_order       = 0;
+        const gdouble ess   = ncm_stats_vec_ar_ess (chunk, k, NCM_STATS_VEC_AR_AICC, &spec0, &k_order);
         const gdouble c_ess = GSL_MIN (cur_size, ess);
 
         ncm_vector_set (esss_tmp, k, ess);
         if (c_ess < min_ess)
         {
-          min_ess = c_ess;
-          lwp     = k;
+          min_ess   = c_ess;
+          lwp       = k;
+          lwp_order = k_order;
         }
       }
       if (min_ess > max_t_ess)
@@ -1565,6 +2307,38 @@ ncm_stats_vec_max_ess_time (NcmStatsVec *svec, const guint ntests, gint *bindex,
   return esss;
 }
 
+/**
+ * ncm_stats_vec_max_ess_time:
+ * @svec: a #NcmStatsVec
+ * @ntests: number of tests
+ * @bindex: (out): time index of the best ESS's
+ * @wp: (out): worst parameter index
+ * @wp_order: (out): worst parameter AR fit order
+ * @wp_ess: (out): worst parameter ESS
+ *
+ * Calculates the time $t_m$ that maximizes the Effective Sample Size (ESS). 
+ * The variable @ntests control the number of divisions where the ESS
+ * will be calculated, if it is zero the default 10 tests will be used.
+ * 
+ * When the lagged-product windows are enabled, see 
+ * ncm_stats_vec_enable_lag_windows(), the tests are performed at the 
+ * windows' starting points instead (@ntests is ignored) and the AR fits 
+ * are computed in parallel for all windows and components without 
+ * accessing the saved rows.
+ * 
+ * Returns: (transfer full): a #NcmVector containing the best ess.
+ */
+NcmVector *
+ncm_stats_vec_max_ess_time (NcmStatsVec *svec, const guint ntests, gint *bindex, guint *wp, guint *wp_order, gdouble *wp_ess)
+{
+  g_assert_cmpuint (svec->nitens, >=, 10);
+
+  if (ncm_stats_vec_has_lag_windows (svec))
+    return _ncm_stats_vec_max_ess_time_lag (svec, bindex, wp, wp_order, wp_ess);
+  else
+    return _ncm_stats_vec_max_ess_time_chunk (svec, ntests, bindex, wp, wp_order, wp_ess);
+}
+
 /**
  * ncm_stats_vec_dup_saved_x:
  * @svec: a #NcmStatsVec
@@ -1610,11 +2384,25 @@ ncm_stats_vec_dup_saved_x (NcmStatsVec *svec)
  * If @max_lag is 0 or larger than the current number of itens than it use
  * the current number of itens as @max_lag.
  *
+ * When the lagged-product windows are enabled, see 
+ * ncm_stats_vec_enable_lag_windows(), the autocorrelations are always 
+ * obtained from the windows in $O(\text{max\_lag})$, without the FFT of 
+ * the whole history, even if @svec saves the rows. If the lags necessary 
+ * are larger than the windows' max_lag, the estimate from 
+ * ncm_stats_vec_get_batch_means_tau() is used instead.
+ *
  * Returns: the integrated autocorrelation time of the whole data.
  */
 gdouble
 ncm_stats_vec_get_autocorr_tau (NcmStatsVec *svec, const guint p, const guint max_lag)
 {
+  if (ncm_stats_vec_has_lag_windows (svec))
+  {
+    const guint Imax_lag = (max_lag == 0) ? svec->nitens / 10 : max_lag;
+    const guint Fmax_lag = (Imax_lag > 1000) ? 1000 : Imax_lag;
+
+    return _ncm_stats_vec_lag_autocorr_tau (svec, p, Fmax_lag);
+  }
 #ifdef NUMCOSMO_HAVE_FFTW3
   guint i;
   gdouble tau = 0.0;
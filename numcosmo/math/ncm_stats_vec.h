@@ -99,6 +99,17 @@ struct _NcmStatsVec
   NcmMatrix *real_cov;
   GPtrArray *saved_x;
   GPtrArray *q_array;
+  guint lag_max;
+  guint lag_nwin;
+  guint lag_block;
+  guint lag_n;
+  gboolean lag_valid;
+  gdouble *lag_ring;
+  GPtrArray *lag_win;
+  guint bm_nlev;
+  gdouble *bm_data;
+  gulong *bm_count;
+  gboolean *bm_pend;
 #ifdef NUMCOSMO_HAVE_FFTW3
   guint fft_size;
   guint fft_plan_size;
@@ -151,6 +162,11 @@ void ncm_stats_vec_disable_quantile (NcmStatsVec *svec);
 gdouble ncm_stats_vec_get_quantile (NcmStatsVec *svec, guint i);
 gdouble ncm_stats_vec_get_quantile_spread (NcmStatsVec *svec, guint i);
 
+void ncm_stats_vec_enable_lag_windows (NcmStatsVec *svec, const guint max_lag, const guint nwin);
+void ncm_stats_vec_disable_lag_windows (NcmStatsVec *svec);
+gboolean ncm_stats_vec_has_lag_windows (NcmStatsVec *svec);
+gdouble ncm_stats_vec_get_batch_means_tau (NcmStatsVec *svec, const guint p);
+
 NcmVector *ncm_stats_vec_get_autocorr (NcmStatsVec *svec, guint p);
 NcmVector *ncm_stats_vec_get_subsample_autocorr (NcmStatsVec *svec, guint p, guint subsample);
 gdouble ncm_stats_vec_get_autocorr_tau (NcmStatsVec *svec, guint p, const guint max_lag);
@@ -53,6 +53,7 @@
 #  endif
 #endif
 
+#include <gsl/gsl_sort.h>
 #include <complex.h>
 #ifdef NUMCOSMO_HAVE_FFTW3
 #include <fftw3.h>
@@ -403,6 +404,36 @@ ncm_vector_substitute (NcmVector **cv, NcmVector *nv, gboolean check_size)
     *cv = ncm_vector_ref (nv);
 }
 
+/**
+ * ncm_vector_set_readonly:
+ * @cv: a #NcmVector
+ * @readonly: a boolean
+ *
+ * Marks @cv as read-only, i.e., the caller promises that its contents will 
+ * not change anymore. A #NcmSerialize with #NCM_SERIALIZE_OPT_SHARE_READONLY
+ * shares read-only vectors by reference instead of copying them when 
+ * duplicating objects. Note that this is not enforced by the functions
+ * that change @cv.
+ *
+ */
+void
+ncm_vector_set_readonly (NcmVector *cv, gboolean readonly)
+{
+  cv->readonly = readonly;
+}
+
+/**
+ * ncm_vector_is_readonly:
+ * @cv: a #NcmVector
+ *
+ * Returns: whether @cv is marked as read-only, see ncm_vector_set_readonly().
+ */
+gboolean
+ncm_vector_is_readonly (const NcmVector *cv)
+{
+  return cv->readonly;
+}
+
 /**
  * ncm_vector_get_subvector:
  * @cv: a #NcmVector
@@ -923,6 +954,35 @@ ncm_vector_get_absminmax (const NcmVector *cv, gdouble *absmin, gdouble *absmax)
   }
 }
 
+/**
+ * ncm_vector_get_sort_index:
+ * @cv: a @NcmVector.
+ *
+ * Computes the permutation that sorts the components of @cv in 
+ * ascending order, i.e., the component $p_i$ of the returned array
+ * is the index of the $i$-th smallest component of @cv.
+ *
+ * Returns: (transfer full) (array) (element-type guint): the sorting permutation.
+ */
+GArray *
+ncm_vector_get_sort_index (const NcmVector *cv)
+{
+  const guint size = ncm_vector_len (cv);
+  GArray *order    = g_array_sized_new (FALSE, FALSE, sizeof (guint), size);
+  size_t *p        = g_new (size_t, size);
+  guint i;
+
+  gsl_sort_index (p, ncm_vector_const_data (cv), ncm_vector_stride (cv), size);
+
+  g_array_set_size (order, size);
+  for (i = 0; i < size; i++)
+    g_array_index (order, guint, i) = p[i];
+
+  g_free (p);
+
+  return order;
+}
+
 /**
  * ncm_vector_set_from_variant:
  * @cv: a #NcmVector
@@ -1309,6 +1369,7 @@ ncm_vector_init (NcmVector *v)
   v->pdata = NULL;
   v->pfree = NULL;
   v->type = 0;
+  v->readonly = FALSE;
   memset (&v->vv, 0, sizeof (gsl_vector_view));
 }
 
@@ -78,6 +78,7 @@ struct _NcmVector
   gpointer pdata;
   GDestroyNotify pfree;
   NcmVectorInternal type;
+  gboolean readonly;
 };
 
 typedef gdouble (*NcmVectorCompFunc) (gdouble v_i, guint i, gpointer user_data);
@@ -163,9 +164,12 @@ G_INLINE_FUNC gsize ncm_vector_get_min_index (const NcmVector *cv);
 G_INLINE_FUNC void ncm_vector_get_minmax (const NcmVector *cv, gdouble *min, gdouble *max);
 
 void ncm_vector_get_absminmax (const NcmVector *cv, gdouble *absmin, gdouble *absmax);
+GArray *ncm_vector_get_sort_index (const NcmVector *cv);
 
 NcmVector *ncm_vector_dup (const NcmVector *cv);
 void ncm_vector_substitute (NcmVector **cv, NcmVector *nv, gboolean check_size);
+void ncm_vector_set_readonly (NcmVector *cv, gboolean readonly);
+gboolean ncm_vector_is_readonly (const NcmVector *cv);
 void ncm_vector_free (NcmVector *cv);
 void ncm_vector_clear (NcmVector **cv);
 void ncm_vector_const_free (const NcmVector *cv);
@@ -445,6 +445,10 @@ _nc_hicosmo_de_prepare (NcHICosmoDE *cosmo_de)
         NcHICosmoDENuInt nu_int = {cosmo_de, xi2_0, yi};
         gsl_function F;
 
+        /* Zero chemical potential species use the process-wide tables. */
+        if (yi == 0.0)
+          continue;
+
         F.params   = &nu_int;
 
         F.function = &_nc_hicosmo_de_nu_rho_f;
@@ -718,6 +722,179 @@ _nc_hicosmo_de_neutrino_p_integrand (gpointer userdata, const gdouble u, const g
   return u4 / (3.0 * sqrt (u2 + nudata->xi2)) * (1.0 / (w + exp_myi) + 1.0 / (w + exp_yi));
 }
 
+/*
+ * Process-wide tables of the momentum integrals as functions of
+ * $\xi = m / T$. For a vanishing chemical potential they do not depend
+ * on any other parameter, hence they are computed once and shared by
+ * all instances. The tables interpolate $\ln I(\ln\xi)$, below the
+ * table range the integrals are constant up to $\mathcal{O}(\xi^2)$
+ * and above it they follow the non-relativistic limits
+ * $I_\rho \propto \xi$ and $I_p \propto 1/\xi$.
+ */
+#define _NC_HICOSMO_DE_NU_TABLE_LNXI_MIN (-15.0)
+#define _NC_HICOSMO_DE_NU_TABLE_LNXI_MAX (+15.0)
+#define _NC_HICOSMO_DE_NU_TABLE_PREC (1.0e-10)
+
+typedef struct _NcHICosmoDENuTable
+{
+  NcmSpline *lnI_rho;
+  NcmSpline *lnI_p;
+} NcHICosmoDENuTable;
+
+static gdouble
+_nc_hicosmo_de_nu_table_lnI (gdouble lnxi, gpointer userdata)
+{
+  NcmIntegral1dPtr *int1d_ptr = NCM_INTEGRAL1D_PTR (userdata);
+  const gdouble xi            = exp (lnxi);
+  neutrino_int nudata         = { xi * xi, 0.0 };
+  gdouble err                 = 0.0;
+
+  ncm_integral1d_ptr_set_userdata (int1d_ptr, &nudata);
+
+  return log (ncm_integral1d_eval_gauss_laguerre (NCM_INTEGRAL1D (int1d_ptr), &err));
+}
+
+static NcmSpline *
+_nc_hicosmo_de_nu_table_new (NcmIntegral1dPtrF F)
+{
+  NcmIntegral1dPtr *int1d_ptr = ncm_integral1d_ptr_new (F, NULL);
+  NcmSpline *lnI              = ncm_spline_cubic_notaknot_new ();
+  gsl_function lnI_F;
+
+  ncm_integral1d_set_reltol (NCM_INTEGRAL1D (int1d_ptr), _NC_HICOSMO_DE_NU_TABLE_PREC * 1.0e-2);
+  ncm_integral1d_set_rule (NCM_INTEGRAL1D (int1d_ptr), 1);
+
+  lnI_F.function = &_nc_hicosmo_de_nu_table_lnI;
+  lnI_F.params   = int1d_ptr;
+
+  ncm_spline_set_func (lnI, NCM_SPLINE_FUNCTION_SPLINE, &lnI_F,
+                       _NC_HICOSMO_DE_NU_TABLE_LNXI_MIN, _NC_HICOSMO_DE_NU_TABLE_LNXI_MAX,
+                       0, _NC_HICOSMO_DE_NU_TABLE_PREC);
+
+  ncm_integral1d_ptr_free (int1d_ptr);
+
+  return lnI;
+}
+
+static const NcHICosmoDENuTable *
+_nc_hicosmo_de_nu_table_peek (void)
+{
+  static gsize init = 0;
+  static NcHICosmoDENuTable nu_table = {NULL, NULL};
+
+  if (g_once_init_enter (&init))
+  {
+    nu_table.lnI_rho = _nc_hicosmo_de_nu_table_new (&_nc_hicosmo_de_neutrino_rho_integrand);
+    nu_table.lnI_p   = _nc_hicosmo_de_nu_table_new (&_nc_hicosmo_de_neutrino_p_integrand);
+
+    g_once_init_leave (&init, 1);
+  }
+
+  return &nu_table;
+}
+
+/* s is the slope of ln(I) with respect to ln(xi) in the non-relativistic limit. */
+static gdouble
+_nc_hicosmo_de_nu_table_eval (NcmSpline *lnI, const gdouble s, const gdouble xi)
+{
+  const gdouble lnxi = log (xi);
+
+  if (lnxi < _NC_HICOSMO_DE_NU_TABLE_LNXI_MIN)
+    return exp (ncm_spline_eval (lnI, _NC_HICOSMO_DE_NU_TABLE_LNXI_MIN));
+  else if (lnxi > _NC_HICOSMO_DE_NU_TABLE_LNXI_MAX)
+    return exp (ncm_spline_eval (lnI, _NC_HICOSMO_DE_NU_TABLE_LNXI_MAX) + s * (lnxi - _NC_HICOSMO_DE_NU_TABLE_LNXI_MAX));
+  else
+    return exp (ncm_spline_eval (lnI, lnxi));
+}
+
+static gdouble
+_nc_hicosmo_de_nu_table_eval_dxi (NcmSpline *lnI, const gdouble s, const gdouble xi)
+{
+  const gdouble lnxi = log (xi);
+
+  if (lnxi < _NC_HICOSMO_DE_NU_TABLE_LNXI_MIN)
+    return 0.0;
+  else if (lnxi > _NC_HICOSMO_DE_NU_TABLE_LNXI_MAX)
+    return s * _nc_hicosmo_de_nu_table_eval (lnI, s, xi) / xi;
+  else
+    return ncm_spline_eval_deriv (lnI, lnxi) * exp (ncm_spline_eval (lnI, lnxi)) / xi;
+}
+
+/**
+ * nc_hicosmo_de_nu_table_eval:
+ * @xi: the ratio $\xi = m / T$
+ * @int_rho: (out): the energy density integral $I_\rho(\xi)$
+ * @int_p: (out): the pressure integral $I_p(\xi)$
+ *
+ * Computes the Fermi-Dirac momentum integrals of a massive neutrino
+ * and its antiparticle with vanishing chemical potential,
+ * $$I_\rho(\xi) = 2\int_0^\infty\frac{u^2\sqrt{u^2+\xi^2}}{e^u+1}\mathrm{d}u, \qquad
+ * I_p(\xi) = 2\int_0^\infty\frac{u^4}{3\sqrt{u^2+\xi^2}(e^u+1)}\mathrm{d}u,$$
+ * using a process-wide table built on the first call.
+ *
+ */
+void
+nc_hicosmo_de_nu_table_eval (const gdouble xi, gdouble *int_rho, gdouble *int_p)
+{
+  const NcHICosmoDENuTable *nu_table = _nc_hicosmo_de_nu_table_peek ();
+
+  int_rho[0] = _nc_hicosmo_de_nu_table_eval (nu_table->lnI_rho, +1.0, xi);
+  int_p[0]   = _nc_hicosmo_de_nu_table_eval (nu_table->lnI_p,   -1.0, xi);
+}
+
+/**
+ * nc_hicosmo_de_nu_table_eval_dxi:
+ * @xi: the ratio $\xi = m / T$
+ * @dint_rho: (out): $dI_\rho/d\xi$
+ * @dint_p: (out): $dI_p/d\xi$
+ *
+ * Computes the derivatives with respect to $\xi$ of the integrals
+ * described in nc_hicosmo_de_nu_table_eval().
+ *
+ */
+void
+nc_hicosmo_de_nu_table_eval_dxi (const gdouble xi, gdouble *dint_rho, gdouble *dint_p)
+{
+  const NcHICosmoDENuTable *nu_table = _nc_hicosmo_de_nu_table_peek ();
+
+  dint_rho[0] = _nc_hicosmo_de_nu_table_eval_dxi (nu_table->lnI_rho, +1.0, xi);
+  dint_p[0]   = _nc_hicosmo_de_nu_table_eval_dxi (nu_table->lnI_p,   -1.0, xi);
+}
+
+static gdouble
+_nc_hicosmo_de_nu_int_rho (NcHICosmoDE *cosmo_de, const guint n, const gdouble z, const gdouble T)
+{
+  NcmModel *model  = NCM_MODEL (cosmo_de);
+  const gdouble yi = ncm_model_orig_vparam_get (model, NC_HICOSMO_DE_MASSNU_MU, n);
+
+  if (yi == 0.0)
+  {
+    const gdouble m  = ncm_model_orig_vparam_get (model, NC_HICOSMO_DE_MASSNU_M, n);
+    const gdouble xi = m * ncm_c_eV () / (ncm_c_kb () * T);
+
+    return _nc_hicosmo_de_nu_table_eval (_nc_hicosmo_de_nu_table_peek ()->lnI_rho, +1.0, xi);
+  }
+  else
+    return ncm_spline_eval (cosmo_de->priv->nu_rho_s[n], z > cosmo_de->priv->zmax ? cosmo_de->priv->zmax : z);
+}
+
+static gdouble
+_nc_hicosmo_de_nu_int_p (NcHICosmoDE *cosmo_de, const guint n, const gdouble z, const gdouble T)
+{
+  NcmModel *model  = NCM_MODEL (cosmo_de);
+  const gdouble yi = ncm_model_orig_vparam_get (model, NC_HICOSMO_DE_MASSNU_MU, n);
+
+  if (yi == 0.0)
+  {
+    const gdouble m  = ncm_model_orig_vparam_get (model, NC_HICOSMO_DE_MASSNU_M, n);
+    const gdouble xi = m * ncm_c_eV () / (ncm_c_kb () * T);
+
+    return _nc_hicosmo_de_nu_table_eval (_nc_hicosmo_de_nu_table_peek ()->lnI_p, -1.0, xi);
+  }
+  else
+    return ncm_spline_eval (cosmo_de->priv->nu_p_s[n], z > cosmo_de->priv->zmax ? cosmo_de->priv->zmax : z);
+}
+
 typedef struct _NcHICosmoDENeutrinoparams
 {
   NcHICosmoDE *cosmo_de;
@@ -762,7 +939,7 @@ _nc_hicosmo_de_E2Omega_mnu_n (NcHICosmo *cosmo, const guint n, const gdouble z)
   _nc_hicosmo_de_prepare (NC_HICOSMO_DE (cosmo_de));
 
   {
-    const gdouble int_Ef       = ncm_spline_eval (cosmo_de->priv->nu_rho_s[n], z > cosmo_de->priv->zmax ? cosmo_de->priv->zmax : z);
+    const gdouble int_Ef       = _nc_hicosmo_de_nu_int_rho (cosmo_de, n, z, T);
     const gdouble Omega_mnu0_n = ffac * g * gsl_pow_4 (T) * ncm_c_blackbody_per_crit_density_h2 () / h2 * int_Ef;
     
     return Omega_mnu0_n;
@@ -783,7 +960,7 @@ _nc_hicosmo_de_E2Press_mnu_n (NcHICosmo *cosmo, const guint n, const gdouble z)
   _nc_hicosmo_de_prepare (NC_HICOSMO_DE (cosmo_de));
 
   {
-    const gdouble int_pf       = ncm_spline_eval (cosmo_de->priv->nu_p_s[n], z > cosmo_de->priv->zmax ? cosmo_de->priv->zmax : z);
+    const gdouble int_pf       = _nc_hicosmo_de_nu_int_p (cosmo_de, n, z, T);
     const gdouble Press_mnu0_n = ffac * g * gsl_pow_4 (T) * ncm_c_blackbody_per_crit_density_h2 () / h2 * int_pf;
 
     return Press_mnu0_n;
@@ -809,7 +986,7 @@ _nc_hicosmo_de_E2Omega_mnu (NcHICosmo *cosmo, const gdouble z)
   {
     const gdouble T            = ncm_model_orig_vparam_get (model, NC_HICOSMO_DE_MASSNU_T, n) * Tgamma;
     const gdouble g            = ncm_model_orig_vparam_get (model, NC_HICOSMO_DE_MASSNU_G, n);
-    const gdouble int_Ef       = ncm_spline_eval (cosmo_de->priv->nu_rho_s[n], z > cosmo_de->priv->zmax ? cosmo_de->priv->zmax : z);
+    const gdouble int_Ef       = _nc_hicosmo_de_nu_int_rho (cosmo_de, n, z, T);
     const gdouble Omega_mnu0_n = ffac * g * gsl_pow_4 (T) * ncm_c_blackbody_per_crit_density_h2 () / h2 * int_Ef;
 
     Omega_mnu0 += Omega_mnu0_n;
@@ -836,7 +1013,7 @@ _nc_hicosmo_de_E2Press_mnu (NcHICosmo *cosmo, const gdouble z)
   {
     const gdouble T            = ncm_model_orig_vparam_get (model, NC_HICOSMO_DE_MASSNU_T, n) * Tgamma;
     const gdouble g            = ncm_model_orig_vparam_get (model, NC_HICOSMO_DE_MASSNU_G, n);
-    const gdouble int_pf       = ncm_spline_eval (cosmo_de->priv->nu_p_s[n], z > cosmo_de->priv->zmax ? cosmo_de->priv->zmax : z);
+    const gdouble int_pf       = _nc_hicosmo_de_nu_int_p (cosmo_de, n, z, T);
     const gdouble Press_mnu0_n = ffac * g * gsl_pow_4 (T) * ncm_c_blackbody_per_crit_density_h2 () / h2 * int_pf;
 
     Press_mnu0 += Press_mnu0_n;
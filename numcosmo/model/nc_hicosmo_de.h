@@ -147,6 +147,9 @@ void nc_hicosmo_de_omega_x2omega_k (NcHICosmoDE *cosmo_de);
 void nc_hicosmo_de_cmb_params (NcHICosmoDE *cosmo_de);
 void nc_hicosmo_de_new_add_bbn (NcmLikelihood *lh);
 
+void nc_hicosmo_de_nu_table_eval (const gdouble xi, gdouble *int_rho, gdouble *int_p);
+void nc_hicosmo_de_nu_table_eval_dxi (const gdouble xi, gdouble *dint_rho, gdouble *dint_p);
+
 void nc_hicosmo_de_set_E2Omega_de_impl (NcHICosmoDEClass *cosmo_de_class, NcHICosmoDEFunc1 f);
 void nc_hicosmo_de_set_dE2Omega_de_dz_impl (NcHICosmoDEClass *cosmo_de_class, NcHICosmoDEFunc1 f);
 void nc_hicosmo_de_set_d2E2Omega_de_dz2_impl (NcHICosmoDEClass *cosmo_de_class, NcHICosmoDEFunc1 f);
@@ -52,6 +52,7 @@
 
 #include "math/ncm_spline2d_bicubic.h"
 #include "math/ncm_spline_cubic_notaknot.h"
+#include "math/ncm_profiler.h"
 #include "model/nc_hicosmo_de.h"
 #include "model/nc_hicosmo_de_xcdm.h"
 #include "model/nc_hicosmo_de_cpl.h"
@@ -1553,8 +1554,12 @@ _nc_cbe_call_bg (NcCBE* cbe, NcHICosmo* cosmo)
 	struct precision* ppr = (struct precision*)cbe->prec->priv;
 
 	_nc_cbe_set_bg (cbe, cosmo);
-	if (background_init (ppr, &cbe->priv->pba) == _FAILURE_)
-		g_error ("_nc_cbe_call_bg: Error running background_init `%s'\n", cbe->priv->pba.error_message);
+	{
+		const gdouble t0 = ncm_profiler_start ();
+		if (background_init (ppr, &cbe->priv->pba) == _FAILURE_)
+			g_error ("_nc_cbe_call_bg: Error running background_init `%s'\n", cbe->priv->pba.error_message);
+		ncm_profiler_stop ("NcCBE:background_init", t0);
+	}
 }
 
 static void
@@ -1565,8 +1570,12 @@ _nc_cbe_call_thermo (NcCBE* cbe, NcHICosmo* cosmo)
 	_nc_cbe_call_bg (cbe, cosmo);
 
 	_nc_cbe_set_thermo (cbe, cosmo);
-	if (thermodynamics_init (ppr, &cbe->priv->pba, &cbe->priv->pth) == _FAILURE_)
-		g_error ("_nc_cbe_call_thermo: Error running thermodynamics_init `%s'\n", cbe->priv->pth.error_message);
+	{
+		const gdouble t0 = ncm_profiler_start ();
+		if (thermodynamics_init (ppr, &cbe->priv->pba, &cbe->priv->pth) == _FAILURE_)
+			g_error ("_nc_cbe_call_thermo: Error running thermodynamics_init `%s'\n", cbe->priv->pth.error_message);
+		ncm_profiler_stop ("NcCBE:thermodynamics_init", t0);
+	}
 }
 
 static void
@@ -1578,8 +1587,12 @@ _nc_cbe_call_pert (NcCBE* cbe, NcHICosmo* cosmo)
 	cbe->free = &_nc_cbe_free_pert;
 
 	_nc_cbe_set_pert (cbe, cosmo);
-	if (perturb_init (ppr, &cbe->priv->pba, &cbe->priv->pth, &cbe->priv->ppt) == _FAILURE_)
-		g_error ("_nc_cbe_call_pert: Error running perturb_init `%s'\n", cbe->priv->ppt.error_message);
+	{
+		const gdouble t0 = ncm_profiler_start ();
+		if (perturb_init (ppr, &cbe->priv->pba, &cbe->priv->pth, &cbe->priv->ppt) == _FAILURE_)
+			g_error ("_nc_cbe_call_pert: Error running perturb_init `%s'\n", cbe->priv->ppt.error_message);
+		ncm_profiler_stop ("NcCBE:perturb_init", t0);
+	}
 }
 
 static void
@@ -1591,8 +1604,12 @@ _nc_cbe_call_prim (NcCBE* cbe, NcHICosmo* cosmo)
 	cbe->free = &_nc_cbe_free_prim;
 
 	_nc_cbe_set_prim (cbe, cosmo);
-	if (primordial_init (ppr, &cbe->priv->ppt, &cbe->priv->ppm) == _FAILURE_)
-		g_error ("_nc_cbe_call_prim: Error running primordial_init `%s'\n", cbe->priv->ppm.error_message);
+	{
+		const gdouble t0 = ncm_profiler_start ();
+		if (primordial_init (ppr, &cbe->priv->ppt, &cbe->priv->ppm) == _FAILURE_)
+			g_error ("_nc_cbe_call_prim: Error running primordial_init `%s'\n", cbe->priv->ppm.error_message);
+		ncm_profiler_stop ("NcCBE:primordial_init", t0);
+	}
 }
 
 static void
@@ -1604,8 +1621,12 @@ _nc_cbe_call_nonlin (NcCBE* cbe, NcHICosmo* cosmo)
 	cbe->free = &_nc_cbe_free_nonlin;
 
 	_nc_cbe_set_nonlin (cbe, cosmo);
-	if (nonlinear_init (ppr, &cbe->priv->pba, &cbe->priv->pth, &cbe->priv->ppt, &cbe->priv->ppm, &cbe->priv->pnl) == _FAILURE_)
-		g_error ("_nc_cbe_call_nonlin: Error running nonlinear_init `%s'\n", cbe->priv->pnl.error_message);
+	{
+		const gdouble t0 = ncm_profiler_start ();
+		if (nonlinear_init (ppr, &cbe->priv->pba, &cbe->priv->pth, &cbe->priv->ppt, &cbe->priv->ppm, &cbe->priv->pnl) == _FAILURE_)
+			g_error ("_nc_cbe_call_nonlin: Error running nonlinear_init `%s'\n", cbe->priv->pnl.error_message);
+		ncm_profiler_stop ("NcCBE:nonlinear_init", t0);
+	}
 }
 
 static void
@@ -1617,8 +1638,12 @@ _nc_cbe_call_transfer (NcCBE* cbe, NcHICosmo* cosmo)
 	cbe->free = &_nc_cbe_free_transfer;
 
 	_nc_cbe_set_transfer (cbe, cosmo);
-	if (transfer_init (ppr, &cbe->priv->pba, &cbe->priv->pth, &cbe->priv->ppt, &cbe->priv->pnl, &cbe->priv->ptr) == _FAILURE_)
-		g_error ("_nc_cbe_call_transfer: Error running transfer_init `%s'\n", cbe->priv->ptr.error_message);
+	{
+		const gdouble t0 = ncm_profiler_start ();
+		if (transfer_init (ppr, &cbe->priv->pba, &cbe->priv->pth, &cbe->priv->ppt, &cbe->priv->pnl, &cbe->priv->ptr) == _FAILURE_)
+			g_error ("_nc_cbe_call_transfer: Error running transfer_init `%s'\n", cbe->priv->ptr.error_message);
+		ncm_profiler_stop ("NcCBE:transfer_init", t0);
+	}
 }
 
 static void
@@ -1630,8 +1655,12 @@ _nc_cbe_call_spectra (NcCBE* cbe, NcHICosmo* cosmo)
 	cbe->free = &_nc_cbe_free_spectra;
 
 	_nc_cbe_set_spectra (cbe, cosmo);
-	if (spectra_init (ppr, &cbe->priv->pba, &cbe->priv->ppt, &cbe->priv->ppm, &cbe->priv->pnl, &cbe->priv->ptr, &cbe->priv->psp) == _FAILURE_)
-		g_error ("_nc_cbe_call_spectra: Error running spectra_init `%s'\n", cbe->priv->psp.error_message);
+	{
+		const gdouble t0 = ncm_profiler_start ();
+		if (spectra_init (ppr, &cbe->priv->pba, &cbe->priv->ppt, &cbe->priv->ppm, &cbe->priv->pnl, &cbe->priv->ptr, &cbe->priv->psp) == _FAILURE_)
+			g_error ("_nc_cbe_call_spectra: Error running spectra_init `%s'\n", cbe->priv->psp.error_message);
+		ncm_profiler_stop ("NcCBE:spectra_init", t0);
+	}
 }
 
 static void
@@ -1643,8 +1672,12 @@ _nc_cbe_call_lensing (NcCBE* cbe, NcHICosmo* cosmo)
 	cbe->free = &_nc_cbe_free_lensing;
 
 	_nc_cbe_set_lensing (cbe, cosmo);
-	if (lensing_init (ppr, &cbe->priv->ppt, &cbe->priv->psp, &cbe->priv->pnl, &cbe->priv->ple) == _FAILURE_)
-		g_error ("_nc_cbe_call_lensing: Error running lensing_init `%s'\n", cbe->priv->ple.error_message);
+	{
+		const gdouble t0 = ncm_profiler_start ();
+		if (lensing_init (ppr, &cbe->priv->ppt, &cbe->priv->psp, &cbe->priv->pnl, &cbe->priv->ple) == _FAILURE_)
+			g_error ("_nc_cbe_call_lensing: Error running lensing_init `%s'\n", cbe->priv->ple.error_message);
+		ncm_profiler_stop ("NcCBE:lensing_init", t0);
+	}
 }
 
 static void
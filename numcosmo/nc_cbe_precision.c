@@ -2289,6 +2289,35 @@ nc_cbe_precision_new (void)
   return cbe_prec;
 }
 
+/**
+ * nc_cbe_precision_new_low_fidelity: (constructor)
+ *
+ * Creates a new #NcCBEPrecision with a coarser sampling in $k$, $\ell$ and
+ * $q$ and shorter Boltzmann hierarchies than the CLASS defaults. The
+ * resulting spectra are not accurate enough for inference but they are
+ * considerably cheaper to compute, so a #NcCBE using this object can be
+ * used to screen proposals, see ncm_fit_mcmc_set_screen_fit().
+ *
+ * Returns: (transfer full): a new #NcCBEPrecision
+ */
+NcCBEPrecision*
+nc_cbe_precision_new_low_fidelity (void)
+{
+  NcCBEPrecision* cbe_prec = g_object_new (NC_TYPE_CBE_PRECISION,
+                                           "k-step-sub",           0.1,
+                                           "k-step-super",         0.004,
+                                           "k-per-decade-for-pk",  5.0,
+                                           "k-per-decade-for-bao", 35.0,
+                                           "l-max-g",              8,
+                                           "l-max-pol-g",          6,
+                                           "l-max-ur",             10,
+                                           "l-logstep",            1.25,
+                                           "l-linstep",            60,
+                                           "q-linstep",            0.9,
+                                           NULL);
+  return cbe_prec;
+}
+
 /**
  * nc_cbe_precision_ref:
  * @cbe_prec: a #NcCBEPrecision.
@@ -61,6 +61,7 @@ GType nc_cbe_precision_get_type (void) G_GNUC_CONST;
 
 NcCBEPrecision *nc_cbe_precision_ref (NcCBEPrecision *cbe_prec);
 NcCBEPrecision *nc_cbe_precision_new (void);
+NcCBEPrecision *nc_cbe_precision_new_low_fidelity (void);
 void nc_cbe_precision_free (NcCBEPrecision *cbe_prec);
 void nc_cbe_precision_clear (NcCBEPrecision **cbe_prec);
 void nc_cbe_precision_assert_default (NcCBEPrecision *cbe_prec);
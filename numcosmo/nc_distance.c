@@ -102,9 +102,11 @@
 #include "build_cfg.h"
 
 #include "nc_distance.h"
+#include "nc_enum_types.h"
 #include "math/integral.h"
 #include "math/ncm_c.h"
 #include "math/ncm_cfg.h"
+#include "math/ncm_profiler.h"
 #include "math/ncm_spline_cubic_notaknot.h"
 #include "math/ncm_mset_func_list.h"
 
@@ -118,6 +120,8 @@ enum
   PROP_0,
   PROP_ZF,
   PROP_RECOMB,
+  PROP_TABLE_ENGINE,
+  PROP_TABLE_RELTOL,
   PROP_SIZE,
 };
 
@@ -139,6 +143,17 @@ nc_distance_init (NcDistance *dist)
   dist->comoving_distance_spline = NULL;
 
   dist->recomb                   = NULL;
+
+  dist->table_engine             = NC_DISTANCE_TABLE_ENGINE_ODE;
+  dist->table_reltol             = NC_DISTANCE_TABLE_DEFAULT_RELTOL;
+  dist->table_nint               = 0;
+  dist->table_nodes              = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  dist->table_weights            = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  dist->table_z                  = NULL;
+  dist->table_Dc                 = NULL;
+  dist->table_check_p            = NULL;
+  dist->table_check_type         = G_TYPE_INVALID;
+  dist->comoving_distance_table  = ncm_spline_cubic_notaknot_new ();
   
   dist->ctrl = ncm_model_ctrl_new (NULL);
 }
@@ -152,12 +167,19 @@ _nc_distance_set_property (GObject *object, guint prop_id, const GValue *value,
   switch (prop_id)
   {
     case PROP_ZF:
-      dist->zf = g_value_get_double (value);
+      dist->zf         = g_value_get_double (value);
+      dist->table_nint = 0;
       ncm_model_ctrl_force_update (dist->ctrl);
       break;
     case PROP_RECOMB:
       nc_distance_set_recomb (dist, g_value_get_object (value));
       break;
+    case PROP_TABLE_ENGINE:
+      nc_distance_set_table_engine (dist, g_value_get_enum (value));
+      break;
+    case PROP_TABLE_RELTOL:
+      nc_distance_set_table_reltol (dist, g_value_get_double (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -178,6 +200,12 @@ _nc_distance_get_property (GObject *object, guint prop_id, GValue *value, GParam
     case PROP_RECOMB:
       g_value_set_object (value, dist->recomb);
       break;
+    case PROP_TABLE_ENGINE:
+      g_value_set_enum (value, dist->table_engine);
+      break;
+    case PROP_TABLE_RELTOL:
+      g_value_set_double (value, dist->table_reltol);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -207,6 +235,11 @@ _nc_distance_dispose (GObject *object)
 
   ncm_ode_spline_clear (&dist->comoving_distance_spline);
 
+  ncm_spline_clear (&dist->comoving_distance_table);
+  ncm_vector_clear (&dist->table_z);
+  ncm_vector_clear (&dist->table_Dc);
+  ncm_vector_clear (&dist->table_check_p);
+
   ncm_model_ctrl_clear (&dist->ctrl);
 
   /* Chain up : end */
@@ -216,6 +249,10 @@ _nc_distance_dispose (GObject *object)
 static void
 _nc_distance_finalize (GObject *object)
 {
+  NcDistance *dist = NC_DISTANCE (object);
+
+  g_array_unref (dist->table_nodes);
+  g_array_unref (dist->table_weights);
 
   /* Chain up : end */
   G_OBJECT_CLASS (nc_distance_parent_class)->finalize (object);
@@ -248,6 +285,22 @@ nc_distance_class_init (NcDistanceClass *klass)
                                                         "Recombination object",
                                                         NC_TYPE_RECOMB,
                                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_TABLE_ENGINE,
+                                   g_param_spec_enum ("table-engine",
+                                                      NULL,
+                                                      "Comoving distance table engine",
+                                                      NC_TYPE_DISTANCE_TABLE_ENGINE, NC_DISTANCE_TABLE_ENGINE_ODE,
+                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  g_object_class_install_property (object_class,
+                                   PROP_TABLE_RELTOL,
+                                   g_param_spec_double ("table-reltol",
+                                                        NULL,
+                                                        "Relative tolerance of the quadrature distance table",
+                                                        GSL_DBL_EPSILON,
+                                                        1.0,
+                                                        NC_DISTANCE_TABLE_DEFAULT_RELTOL,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
 }
 
 /**
@@ -319,7 +372,8 @@ nc_distance_require_zf (NcDistance *dist, const gdouble zf)
   if (zf > dist->zf)
   {
     ncm_ode_spline_clear (&dist->comoving_distance_spline);
-    dist->zf = zf;
+    dist->zf         = zf;
+    dist->table_nint = 0;
 
     ncm_model_ctrl_force_update (dist->ctrl);
   }
@@ -341,6 +395,311 @@ nc_distance_set_recomb (NcDistance *dist, NcRecomb *recomb)
   }
 }
 
+/**
+ * nc_distance_set_table_engine:
+ * @dist: a #NcDistance
+ * @engine: a #NcDistanceTableEngine
+ *
+ * Sets the method used to tabulate the comoving distance in the
+ * interval $[0, z_f]$. The ODE engine integrates $dD_c/dz$ with
+ * CVODE and lets the integrator choose the knots. The quadrature engine
+ * uses a fixed set of knots equally spaced in $\ln(1+z)$ and computes
+ * the cumulative integral with a Gauss-Legendre rule in each interval,
+ * evaluating $E^2(z)$ in a single sweep over a cached node set. The number
+ * of intervals is calibrated on the first preparation such that both the
+ * quadrature and the interpolation errors are below the relative tolerance
+ * set by nc_distance_set_table_reltol(). The node set is kept until
+ * $z_f$ or the tolerance change. When the cosmological parameters move
+ * away from the ones used in the last error estimate, the error is
+ * estimated again and the number of intervals is increased if needed.
+ *
+ */
+void
+nc_distance_set_table_engine (NcDistance *dist, NcDistanceTableEngine engine)
+{
+  g_assert_cmpint (engine, <, NC_DISTANCE_TABLE_ENGINE_LEN);
+
+  if (dist->table_engine != engine)
+  {
+    dist->table_engine = engine;
+    ncm_model_ctrl_force_update (dist->ctrl);
+  }
+}
+
+/**
+ * nc_distance_get_table_engine:
+ * @dist: a #NcDistance
+ *
+ * Returns: the #NcDistanceTableEngine used by @dist.
+ */
+NcDistanceTableEngine
+nc_distance_get_table_engine (NcDistance *dist)
+{
+  return dist->table_engine;
+}
+
+/**
+ * nc_distance_set_table_reltol:
+ * @dist: a #NcDistance
+ * @reltol: relative tolerance
+ *
+ * Sets the relative tolerance used to calibrate the node set of the
+ * quadrature engine, see nc_distance_set_table_engine().
+ *
+ */
+void
+nc_distance_set_table_reltol (NcDistance *dist, const gdouble reltol)
+{
+  g_assert_cmpfloat (reltol, >, 0.0);
+
+  if (dist->table_reltol != reltol)
+  {
+    dist->table_reltol = reltol;
+    dist->table_nint   = 0;
+    ncm_model_ctrl_force_update (dist->ctrl);
+  }
+}
+
+/**
+ * nc_distance_get_table_reltol:
+ * @dist: a #NcDistance
+ *
+ * Returns: the relative tolerance of the quadrature engine.
+ */
+gdouble
+nc_distance_get_table_reltol (NcDistance *dist)
+{
+  return dist->table_reltol;
+}
+
+/**
+ * nc_distance_get_table_nintervals:
+ * @dist: a #NcDistance
+ *
+ * Returns: the number of intervals used by the quadrature engine or
+ * zero if its node set was not calibrated yet.
+ */
+guint
+nc_distance_get_table_nintervals (NcDistance *dist)
+{
+  return dist->table_nint;
+}
+
+/*
+ * Four points Gauss-Legendre rule in [-1, 1], the table below
+ * contains the positive abscissas and their weights.
+ */
+#define _NC_DISTANCE_GL_N 4
+#define _NC_DISTANCE_GL_N2 (_NC_DISTANCE_GL_N / 2)
+static const gdouble _nc_distance_gl_x[_NC_DISTANCE_GL_N2] = {0.3399810435848562648026658, 0.8611363115940525752239465};
+static const gdouble _nc_distance_gl_w[_NC_DISTANCE_GL_N2] = {0.6521451548625461426269361, 0.3478548451374538573730639};
+
+#define _NC_DISTANCE_TABLE_MIN_NINT 16
+#define _NC_DISTANCE_TABLE_MAX_NINT (1 << 16)
+#define _NC_DISTANCE_TABLE_RECHECK_DELTA (0.05)
+
+/*
+ * Appends the nodes and weights of the Gauss-Legendre rule in the
+ * interval [x0, x1] of x = ln (1 + z). The weights include the
+ * Jacobian dz/dx = 1 + z.
+ */
+static void
+_nc_distance_table_append_rule (GArray *nodes, GArray *weights, const gdouble x0, const gdouble x1)
+{
+  const gdouble xm = 0.5 * (x1 + x0);
+  const gdouble dx = 0.5 * (x1 - x0);
+  guint j;
+
+  for (j = 0; j < _NC_DISTANCE_GL_N2; j++)
+  {
+    const gdouble xl = xm - dx * _nc_distance_gl_x[j];
+    const gdouble xu = xm + dx * _nc_distance_gl_x[j];
+    const gdouble zl = expm1 (xl);
+    const gdouble zu = expm1 (xu);
+    const gdouble wl = dx * _nc_distance_gl_w[j] * (1.0 + zl);
+    const gdouble wu = dx * _nc_distance_gl_w[j] * (1.0 + zu);
+
+    g_array_append_val (nodes, zl);
+    g_array_append_val (nodes, zu);
+    g_array_append_val (weights, wl);
+    g_array_append_val (weights, wu);
+  }
+}
+
+static void
+_nc_distance_table_set_nodes (NcDistance *dist, const guint nint)
+{
+  const gdouble xf = log1p (dist->zf);
+  const gdouble dx = xf / nint;
+  guint k;
+
+  g_array_set_size (dist->table_nodes, 0);
+  g_array_set_size (dist->table_weights, 0);
+
+  ncm_vector_clear (&dist->table_z);
+  ncm_vector_clear (&dist->table_Dc);
+
+  dist->table_z  = ncm_vector_new (nint + 1);
+  dist->table_Dc = ncm_vector_new (nint + 1);
+
+  for (k = 0; k < nint; k++)
+    _nc_distance_table_append_rule (dist->table_nodes, dist->table_weights, dx * k, (k + 1 == nint) ? xf : dx * (k + 1));
+
+  ncm_vector_set (dist->table_z, 0, 0.0);
+  for (k = 1; k < nint; k++)
+    ncm_vector_set (dist->table_z, k, expm1 (dx * k));
+  ncm_vector_set (dist->table_z, nint, dist->zf);
+
+  dist->table_nint = nint;
+  ncm_spline_set (dist->comoving_distance_table, dist->table_z, dist->table_Dc, FALSE);
+}
+
+static gdouble
+_nc_distance_table_sum (NcHICosmo *cosmo, const gdouble *nodes, const gdouble *weights, const guint n)
+{
+  gdouble sum = 0.0;
+  guint j;
+
+  for (j = 0; j < n; j++)
+    sum += weights[j] / sqrt (nc_hicosmo_E2 (cosmo, nodes[j]));
+
+  return sum;
+}
+
+static void
+_nc_distance_table_build (NcDistance *dist, NcHICosmo *cosmo)
+{
+  const gdouble *nodes   = &g_array_index (dist->table_nodes, gdouble, 0);
+  const gdouble *weights = &g_array_index (dist->table_weights, gdouble, 0);
+  gdouble Dc = 0.0;
+  guint k;
+
+  ncm_vector_set (dist->table_Dc, 0, 0.0);
+  for (k = 0; k < dist->table_nint; k++)
+  {
+    Dc += _nc_distance_table_sum (cosmo, &nodes[k * _NC_DISTANCE_GL_N], &weights[k * _NC_DISTANCE_GL_N], _NC_DISTANCE_GL_N);
+    ncm_vector_set (dist->table_Dc, k + 1, Dc);
+  }
+
+  if (!gsl_finite (Dc))
+    g_error ("nc_distance_prepare: not finite integrand in [0, % 22.15g].", dist->zf);
+
+  ncm_spline_prepare (dist->comoving_distance_table);
+}
+
+/*
+ * Estimates the relative error of the table comparing, in each
+ * interval, the spline at the midpoint and the full interval
+ * integral against the rule applied to both halves.
+ */
+static gdouble
+_nc_distance_table_error (NcDistance *dist, NcHICosmo *cosmo)
+{
+  GArray *nodes    = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 2 * _NC_DISTANCE_GL_N);
+  GArray *weights  = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), 2 * _NC_DISTANCE_GL_N);
+  gdouble max_err  = 0.0;
+  guint k;
+
+  for (k = 0; k < dist->table_nint; k++)
+  {
+    const gdouble x0  = log1p (ncm_vector_get (dist->table_z, k));
+    const gdouble x1  = log1p (ncm_vector_get (dist->table_z, k + 1));
+    const gdouble xm  = x0 + 0.5 * (x1 - x0);
+    const gdouble Dc0 = ncm_vector_get (dist->table_Dc, k);
+    const gdouble Dc1 = ncm_vector_get (dist->table_Dc, k + 1);
+    gdouble I_l, I_u, Dc_m, err_s, err_q;
+
+    g_array_set_size (nodes, 0);
+    g_array_set_size (weights, 0);
+    _nc_distance_table_append_rule (nodes, weights, x0, xm);
+    _nc_distance_table_append_rule (nodes, weights, xm, x1);
+
+    I_l  = _nc_distance_table_sum (cosmo, &g_array_index (nodes, gdouble, 0), &g_array_index (weights, gdouble, 0), _NC_DISTANCE_GL_N);
+    I_u  = _nc_distance_table_sum (cosmo, &g_array_index (nodes, gdouble, _NC_DISTANCE_GL_N), &g_array_index (weights, gdouble, _NC_DISTANCE_GL_N), _NC_DISTANCE_GL_N);
+    Dc_m = Dc0 + I_l;
+
+    err_s = fabs (ncm_spline_eval (dist->comoving_distance_table, expm1 (xm)) / Dc_m - 1.0);
+    err_q = fabs ((Dc1 - Dc0) - (I_l + I_u)) / Dc1;
+
+    max_err = GSL_MAX (max_err, GSL_MAX (err_s, err_q));
+  }
+
+  g_array_unref (nodes);
+  g_array_unref (weights);
+
+  return max_err;
+}
+
+/*
+ * The error is estimated again when any parameter moved by more than
+ * _NC_DISTANCE_TABLE_RECHECK_DELTA times its value (plus its scale)
+ * since the last estimate, or when the model changes.
+ */
+static gboolean
+_nc_distance_table_needs_check (NcDistance *dist, NcHICosmo *cosmo)
+{
+  NcmModel *model = NCM_MODEL (cosmo);
+  NcmVector *p    = ncm_model_orig_params_peek_vector (model);
+  guint i;
+
+  if ((dist->table_check_p == NULL) || 
+      (dist->table_check_type != G_OBJECT_TYPE (cosmo)) || 
+      (ncm_vector_len (dist->table_check_p) != ncm_vector_len (p)))
+    return TRUE;
+
+  for (i = 0; i < ncm_vector_len (p); i++)
+  {
+    const gdouble p0_i = ncm_vector_get (dist->table_check_p, i);
+    const gdouble tol  = _NC_DISTANCE_TABLE_RECHECK_DELTA * (fabs (p0_i) + ncm_model_orig_param_get_scale (model, i));
+
+    if (fabs (ncm_vector_get (p, i) - p0_i) > tol)
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+/*
+ * Calibrates the number of intervals starting from the current node
+ * set, the number of intervals is only increased after the first
+ * calibration, so the table is accurate for all cosmologies checked.
+ */
+static void
+_nc_distance_table_calibrate (NcDistance *dist, NcHICosmo *cosmo)
+{
+  NcmVector *p = ncm_model_orig_params_peek_vector (NCM_MODEL (cosmo));
+  guint nint   = (dist->table_nint == 0) ? _NC_DISTANCE_TABLE_MIN_NINT : dist->table_nint;
+
+  while (TRUE)
+  {
+    if (nint != dist->table_nint)
+      _nc_distance_table_set_nodes (dist, nint);
+    _nc_distance_table_build (dist, cosmo);
+
+    if (_nc_distance_table_error (dist, cosmo) < dist->table_reltol)
+      break;
+
+    if (nint >= _NC_DISTANCE_TABLE_MAX_NINT)
+    {
+      g_warning ("nc_distance_prepare: cannot reach the relative tolerance % 8.5e with %u intervals, using the last table.",
+                 dist->table_reltol, nint);
+      break;
+    }
+
+    nint *= 2;
+  }
+
+  if ((dist->table_check_p == NULL) || (ncm_vector_len (dist->table_check_p) != ncm_vector_len (p)))
+  {
+    ncm_vector_clear (&dist->table_check_p);
+    dist->table_check_p = ncm_vector_dup (p);
+  }
+  else
+    ncm_vector_memcpy (dist->table_check_p, p);
+
+  dist->table_check_type = G_OBJECT_TYPE (cosmo);
+}
+
 static gdouble dcddz (gdouble y, gdouble x, gpointer userdata);
 
 /**
@@ -361,16 +720,41 @@ nc_distance_prepare (NcDistance *dist, NcHICosmo *cosmo)
 
   dist->sound_horizon_cache->clear = TRUE;
 
-  if (dist->comoving_distance_spline == NULL)
+  switch (dist->table_engine)
   {
-    NcmSpline *s = ncm_spline_cubic_notaknot_new ();
-    dist->comoving_distance_spline =
-      ncm_ode_spline_new_full (s, dcddz, 0.0, 0.0, dist->zf);
+    case NC_DISTANCE_TABLE_ENGINE_ODE:
+    {
+      const gdouble t0 = ncm_profiler_start ();
 
-    ncm_spline_free (s);
-  }
+      if (dist->comoving_distance_spline == NULL)
+      {
+        NcmSpline *s = ncm_spline_cubic_notaknot_new ();
+        dist->comoving_distance_spline =
+          ncm_ode_spline_new_full (s, dcddz, 0.0, 0.0, dist->zf);
+
+        ncm_spline_free (s);
+      }
+
+      ncm_ode_spline_prepare (dist->comoving_distance_spline, cosmo);
+      ncm_profiler_stop ("NcDistance:comoving_distance_spline", t0);
+      break;
+    }
+    case NC_DISTANCE_TABLE_ENGINE_QUAD:
+    {
+      const gdouble t0 = ncm_profiler_start ();
 
-  ncm_ode_spline_prepare (dist->comoving_distance_spline, cosmo);
+      if ((dist->table_nint == 0) || _nc_distance_table_needs_check (dist, cosmo))
+        _nc_distance_table_calibrate (dist, cosmo);
+      else
+        _nc_distance_table_build (dist, cosmo);
+
+      ncm_profiler_stop ("NcDistance:comoving_distance_table", t0);
+      break;
+    }
+    default:
+      g_assert_not_reached ();
+      break;
+  }
 
   if (dist->recomb != NULL)
     nc_recomb_prepare_if_needed (dist->recomb, cosmo);
@@ -380,6 +764,15 @@ nc_distance_prepare (NcDistance *dist, NcHICosmo *cosmo)
   return;
 }
 
+static NcmSpline *
+_nc_distance_peek_Dc_spline (NcDistance *dist)
+{
+  if (dist->table_engine == NC_DISTANCE_TABLE_ENGINE_QUAD)
+    return dist->comoving_distance_table;
+  else
+    return dist->comoving_distance_spline->s;
+}
+
 /**
  * nc_distance_hubble:
  * @dist: a #NcDistance
@@ -421,7 +814,7 @@ nc_distance_comoving (NcDistance *dist, NcHICosmo *cosmo, gdouble z)
     return nc_hicosmo_Dc (cosmo, z);
 
   if (z <= dist->zf)
-    return ncm_spline_eval (dist->comoving_distance_spline->s, z);
+    return ncm_spline_eval (_nc_distance_peek_Dc_spline (dist), z);
 
   F.function = &comoving_distance_integral_argument;
   F.params = cosmo;
@@ -1060,6 +1453,215 @@ nc_distance_DA_r (NcDistance *dist, NcHICosmo *cosmo, gdouble z)
   return DA / r_zd;
 }
 
+/***************************************************************************
+ * Redshift dependent 'distances' -- vector versions
+ ****************************************************************************/
+
+/**
+ * nc_distance_comoving_vec:
+ * @dist: a #NcDistance
+ * @cosmo: a #NcHICosmo
+ * @z: a #NcmVector of redshifts
+ * @order: (allow-none) (array) (element-type guint): the sorting permutation of @z
+ * @Dc: a #NcmVector
+ *
+ * Computes the comoving distance [nc_distance_comoving()] at each 
+ * redshift in @z and stores the results in @Dc. The preparation check
+ * is done only once and the spline is evaluated in a single pass using
+ * @order, see ncm_spline_eval_vec(). The permutation @order can be obtained
+ * from ncm_vector_get_sort_index() and should be computed only once 
+ * for a fixed set of redshifts.
+ *
+ */
+void
+nc_distance_comoving_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z, GArray *order, NcmVector *Dc)
+{
+  const guint n = ncm_vector_len (z);
+  guint i;
+
+  g_assert_cmpuint (n, ==, ncm_vector_len (Dc));
+
+  nc_distance_prepare_if_needed (dist, cosmo);
+
+  if (ncm_model_check_impl_opt (NCM_MODEL (cosmo), NC_HICOSMO_IMPL_Dc))
+  {
+    for (i = 0; i < n; i++)
+      ncm_vector_set (Dc, i, nc_hicosmo_Dc (cosmo, ncm_vector_get (z, i)));
+    return;
+  }
+
+  ncm_spline_eval_vec (_nc_distance_peek_Dc_spline (dist), z, order, Dc);
+
+  /* Points outside the spline range are computed by direct integration. */
+  for (i = 0; i < n; i++)
+  {
+    const gdouble z_i = ncm_vector_get (z, i);
+    if (z_i > dist->zf)
+      ncm_vector_set (Dc, i, nc_distance_comoving (dist, cosmo, z_i));
+  }
+}
+
+/**
+ * nc_distance_transverse_vec:
+ * @dist: a #NcDistance
+ * @cosmo: a #NcHICosmo
+ * @z: a #NcmVector of redshifts
+ * @order: (allow-none) (array) (element-type guint): the sorting permutation of @z
+ * @Dt: a #NcmVector
+ *
+ * Computes the transverse comoving distance [nc_distance_transverse()] 
+ * at each redshift in @z, see nc_distance_comoving_vec().
+ *
+ */
+void
+nc_distance_transverse_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z, GArray *order, NcmVector *Dt)
+{
+  const gdouble Omega_k0      = nc_hicosmo_Omega_k0 (cosmo);
+  const gdouble sqrt_Omega_k0 = sqrt (fabs (Omega_k0));
+  const gint k                = fabs (Omega_k0) < NCM_ZERO_LIMIT ? 0 : (Omega_k0 > 0.0 ? -1 : 1);
+  const guint n               = ncm_vector_len (z);
+  guint i;
+
+  nc_distance_comoving_vec (dist, cosmo, z, order, Dt);
+
+  switch (k)
+  {
+    case 0:
+      break;
+    case -1:
+      for (i = 0; i < n; i++)
+      {
+        const gdouble Dc = ncm_vector_get (Dt, i);
+        if (!gsl_isinf (Dc))
+          ncm_vector_set (Dt, i, sinh (sqrt_Omega_k0 * Dc) / sqrt_Omega_k0);
+      }
+      break;
+    case 1:
+      for (i = 0; i < n; i++)
+      {
+        const gdouble Dc = ncm_vector_get (Dt, i);
+        if (!gsl_isinf (Dc))
+          ncm_vector_set (Dt, i, fabs (sin (sqrt_Omega_k0 * Dc) / sqrt_Omega_k0));
+      }
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+/**
+ * nc_distance_luminosity_vec:
+ * @dist: a #NcDistance
+ * @cosmo: a #NcHICosmo
+ * @z: a #NcmVector of redshifts
+ * @order: (allow-none) (array) (element-type guint): the sorting permutation of @z
+ * @Dl: a #NcmVector
+ *
+ * Computes the luminosity distance [nc_distance_luminosity()] 
+ * at each redshift in @z, see nc_distance_comoving_vec().
+ *
+ */
+void
+nc_distance_luminosity_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z, GArray *order, NcmVector *Dl)
+{
+  const guint n = ncm_vector_len (z);
+  guint i;
+
+  nc_distance_transverse_vec (dist, cosmo, z, order, Dl);
+
+  for (i = 0; i < n; i++)
+    ncm_vector_set (Dl, i, (1.0 + ncm_vector_get (z, i)) * ncm_vector_get (Dl, i));
+}
+
+/**
+ * nc_distance_dmodulus_vec:
+ * @dist: a #NcDistance
+ * @cosmo: a #NcHICosmo
+ * @z: a #NcmVector of redshifts
+ * @order: (allow-none) (array) (element-type guint): the sorting permutation of @z
+ * @dmu: a #NcmVector
+ *
+ * Computes the distance modulus [nc_distance_dmodulus()] 
+ * at each redshift in @z, see nc_distance_comoving_vec().
+ *
+ */
+void
+nc_distance_dmodulus_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z, GArray *order, NcmVector *dmu)
+{
+  const guint n = ncm_vector_len (z);
+  guint i;
+
+  nc_distance_luminosity_vec (dist, cosmo, z, order, dmu);
+
+  for (i = 0; i < n; i++)
+  {
+    const gdouble Dl = ncm_vector_get (dmu, i);
+    if (gsl_finite (Dl))
+      ncm_vector_set (dmu, i, 5.0 * log10 (Dl) + 25.0);
+  }
+}
+
+/**
+ * nc_distance_dmodulus_hef_vec:
+ * @dist: a #NcDistance
+ * @cosmo: a #NcHICosmo
+ * @z_he: a #NcmVector of redshifts $z_{he}$ in our local frame
+ * @z_cmb: a #NcmVector of redshifts $z_{CMB}$ in the CMB frame
+ * @order: (allow-none) (array) (element-type guint): the sorting permutation of @z_cmb
+ * @dmu: a #NcmVector
+ *
+ * Computes the frame corrected distance modulus [nc_distance_dmodulus_hef()] 
+ * for each pair ($z_{he}$, $z_{CMB}$), see nc_distance_comoving_vec().
+ *
+ */
+void
+nc_distance_dmodulus_hef_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z_he, NcmVector *z_cmb, GArray *order, NcmVector *dmu)
+{
+  const guint n = ncm_vector_len (z_cmb);
+  guint i;
+
+  g_assert_cmpuint (n, ==, ncm_vector_len (z_he));
+
+  nc_distance_transverse_vec (dist, cosmo, z_cmb, order, dmu);
+
+  for (i = 0; i < n; i++)
+  {
+    const gdouble Dl = (1.0 + ncm_vector_get (z_he, i)) * ncm_vector_get (dmu, i);
+    ncm_vector_set (dmu, i, gsl_finite (Dl) ? (5.0 * log10 (Dl) + 25.0) : Dl);
+  }
+}
+
+/**
+ * nc_distance_dilation_scale_vec:
+ * @dist: a #NcDistance
+ * @cosmo: a #NcHICosmo
+ * @z: a #NcmVector of redshifts
+ * @order: (allow-none) (array) (element-type guint): the sorting permutation of @z
+ * @Dv: a #NcmVector
+ *
+ * Computes the dilation scale [nc_distance_dilation_scale()] 
+ * at each redshift in @z, see nc_distance_comoving_vec().
+ *
+ */
+void
+nc_distance_dilation_scale_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z, GArray *order, NcmVector *Dv)
+{
+  const guint n = ncm_vector_len (z);
+  guint i;
+
+  nc_distance_transverse_vec (dist, cosmo, z, order, Dv);
+
+  for (i = 0; i < n; i++)
+  {
+    const gdouble z_i = ncm_vector_get (z, i);
+    const gdouble Dt  = ncm_vector_get (Dv, i);
+    const gdouble E   = sqrt (nc_hicosmo_E2 (cosmo, z_i));
+
+    ncm_vector_set (Dv, i, cbrt (Dt * Dt * z_i / E));
+  }
+}
+
 /***************************************************************************
  *            cosmic_time.c
  *
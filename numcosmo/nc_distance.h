@@ -31,6 +31,7 @@
 #include <numcosmo/nc_hicosmo.h>
 #include <numcosmo/nc_recomb.h>
 #include <numcosmo/math/ncm_ode_spline.h>
+#include <numcosmo/math/ncm_spline.h>
 #include <numcosmo/math/ncm_model_ctrl.h>
 #include <numcosmo/math/function_cache.h>
 
@@ -48,6 +49,23 @@ typedef struct _NcDistance NcDistance;
 typedef gdouble (*NcDistanceFunc0) (NcDistance *dist, NcHICosmo *cosmo);
 typedef gdouble (*NcDistanceFunc1) (NcDistance *dist, NcHICosmo *cosmo, gdouble z);
 
+/**
+ * NcDistanceTableEngine:
+ * @NC_DISTANCE_TABLE_ENGINE_ODE: integrates $dD_c/dz = 1/E(z)$ with CVODE using #NcmOdeSpline
+ * @NC_DISTANCE_TABLE_ENGINE_QUAD: cumulative Gauss-Legendre quadrature on a cached node set
+ *
+ * Methods used by nc_distance_prepare() to tabulate the comoving distance
+ * in the interval $[0, z_f]$.
+ *
+ */
+typedef enum _NcDistanceTableEngine
+{
+  NC_DISTANCE_TABLE_ENGINE_ODE = 0,
+  NC_DISTANCE_TABLE_ENGINE_QUAD,
+  /* < private > */
+  NC_DISTANCE_TABLE_ENGINE_LEN, /*< skip >*/
+} NcDistanceTableEngine;
+
 struct _NcDistanceClass
 {
   /*< private >*/
@@ -68,6 +86,16 @@ struct _NcDistance
   gdouble zf;
   gboolean use_cache;
   NcRecomb *recomb;
+  NcDistanceTableEngine table_engine;
+  gdouble table_reltol;
+  guint table_nint;
+  GArray *table_nodes;
+  GArray *table_weights;
+  NcmVector *table_z;
+  NcmVector *table_Dc;
+  NcmVector *table_check_p;
+  GType table_check_type;
+  NcmSpline *comoving_distance_table;
 };
 
 typedef struct _NcDistanceFunc
@@ -93,6 +121,11 @@ NcDistance *nc_distance_ref (NcDistance *dist);
 
 void nc_distance_require_zf (NcDistance *dist, const gdouble zf);
 void nc_distance_set_recomb (NcDistance *dist, NcRecomb *recomb);
+void nc_distance_set_table_engine (NcDistance *dist, NcDistanceTableEngine engine);
+NcDistanceTableEngine nc_distance_get_table_engine (NcDistance *dist);
+void nc_distance_set_table_reltol (NcDistance *dist, const gdouble reltol);
+gdouble nc_distance_get_table_reltol (NcDistance *dist);
+guint nc_distance_get_table_nintervals (NcDistance *dist);
 
 void nc_distance_prepare (NcDistance *dist, NcHICosmo *cosmo);
 G_INLINE_FUNC void nc_distance_prepare_if_needed (NcDistance *dist, NcHICosmo *cosmo);
@@ -136,6 +169,17 @@ gdouble nc_distance_bao_r_Dv (NcDistance *dist, NcHICosmo *cosmo, gdouble z);
 gdouble nc_distance_DH_r (NcDistance *dist, NcHICosmo *cosmo, gdouble z);
 gdouble nc_distance_DA_r (NcDistance *dist, NcHICosmo *cosmo, gdouble z);
 
+/***************************************************************************
+ * Redshift dependent 'distances' -- vector versions
+ ****************************************************************************/
+
+void nc_distance_comoving_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z, GArray *order, NcmVector *Dc);
+void nc_distance_transverse_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z, GArray *order, NcmVector *Dt);
+void nc_distance_luminosity_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z, GArray *order, NcmVector *Dl);
+void nc_distance_dmodulus_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z, GArray *order, NcmVector *dmu);
+void nc_distance_dmodulus_hef_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z_he, NcmVector *z_cmb, GArray *order, NcmVector *dmu);
+void nc_distance_dilation_scale_vec (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z, GArray *order, NcmVector *Dv);
+
 /***************************************************************************
  *            cosmic_time.h
  *
@@ -149,6 +193,8 @@ gdouble nc_distance_lookback_time (NcDistance *dist, NcHICosmo *cosmo, gdouble z
 gdouble nc_distance_conformal_time (NcDistance *dist, NcHICosmo *cosmo, gdouble z);
 gdouble nc_distance_conformal_lookback_time (NcDistance *dist, NcHICosmo *cosmo, gdouble z);
 
+#define NC_DISTANCE_TABLE_DEFAULT_RELTOL (1.0e-10)
+
 G_END_DECLS
 
 #endif /* _NC_DISTANCE_INLINE_H_ */
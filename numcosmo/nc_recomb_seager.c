@@ -91,6 +91,33 @@
  * where the numerical integration will start. The integration is performed considering all
  * components without any switching or approximation.
  *
+ * # Recombination table #
+ *
+ * Since the ionization history depends, to a very good approximation, only on
+ * $\Omega_{b0}h^2$, $\Omega_{c0}h^2$, $Y_p$, $T_{\gamma0}$ and $N_\mathrm{eff}$,
+ * it is possible to replace the integration by an interpolation in this
+ * five-dimensional space. The function nc_recomb_seager_build_table()
+ * integrates the system above on a tensor product of Chebyshev-Lobatto nodes,
+ * whose ranges are set by nc_recomb_seager_set_table_axis(), and stores
+ * $X_\e$, $X_\HyII$ and $X_\HeII$ on a fixed $\lambda$ grid. When the table
+ * is enabled (see nc_recomb_seager_set_use_table()) the preparation uses the
+ * barycentric Lagrange interpolation of these values whenever the cosmology
+ * falls inside the table, falling back to the integration otherwise. The
+ * optical depth and the visibility function are then computed from the
+ * interpolated $X_\e$ exactly as in the integration case, so that the
+ * reionization model is still applied on top of it.
+ *
+ * The remaining parameters of the cosmology used to build the table
+ * (e.g., $H_0$ and the dark energy parameters) are kept fixed, they only
+ * affect the ionization history through the late time expansion, after the
+ * residual ionization freezes out. The maximum relative error in $X_\e$ found
+ * comparing the interpolation with the integration at a set of test points
+ * is available through nc_recomb_seager_get_table_accuracy(). The table is
+ * disabled by default. The default axes are $\Omega_{b0}h^2 \in [0.020, 0.025]$
+ * and $\Omega_{c0}h^2 \in [0.09, 0.15]$ with five nodes, $Y_p \in [0.22, 0.28]$
+ * and $N_\mathrm{eff} \in [2.5, 3.5]$ with three nodes and $T_{\gamma0}$ fixed
+ * at the value of the cosmology used to build the table.
+ *
  */
 
 #ifdef HAVE_CONFIG_H
@@ -104,6 +131,7 @@
 #include "nc_enum_types.h"
 #include "nc_recomb.h"
 #include "nc_recomb_seager.h"
+#include "model/nc_hicosmo_de.h"
 
 #include <gsl/gsl_sf_exp.h>
 #include <gsl/gsl_sf_hyperg.h>
@@ -115,6 +143,7 @@ enum
 {
   PROP_0,
   PROP_OPTS,
+  PROP_USE_TABLE,
   PROP_SIZE,
 };
 
@@ -182,6 +211,20 @@ nc_recomb_seager_init (NcRecombSeager *recomb_seager)
   recomb_seager->Xe_recomb_s           = ncm_spline_cubic_notaknot_new ();
   recomb_seager->XHII_s                = ncm_spline_cubic_notaknot_new ();
   recomb_seager->XHeII_s               = ncm_spline_cubic_notaknot_new ();
+
+  recomb_seager->use_table             = FALSE;
+  recomb_seager->table_nlambda         = 3000;
+  recomb_seager->table_lambdai         = 0.0;
+  recomb_seager->table_accuracy        = GSL_NAN;
+  recomb_seager->table_lambda          = NULL;
+  recomb_seager->table                 = NULL;
+  recomb_seager->table_res             = NULL;
+
+  nc_recomb_seager_set_table_axis (recomb_seager, NC_RECOMB_SEAGER_TABLE_OMEGA_B0H2, 0.020, 0.025, 5);
+  nc_recomb_seager_set_table_axis (recomb_seager, NC_RECOMB_SEAGER_TABLE_OMEGA_C0H2, 0.090, 0.150, 5);
+  nc_recomb_seager_set_table_axis (recomb_seager, NC_RECOMB_SEAGER_TABLE_YP,         0.220, 0.280, 3);
+  nc_recomb_seager_set_table_axis (recomb_seager, NC_RECOMB_SEAGER_TABLE_T_GAMMA0,   GSL_NAN, GSL_NAN, 1);
+  nc_recomb_seager_set_table_axis (recomb_seager, NC_RECOMB_SEAGER_TABLE_NEFF,       2.5, 3.5, 3);
 }
 
 static void
@@ -195,6 +238,9 @@ _nc_recomb_seager_set_property (GObject* object, guint prop_id, const GValue* va
     case PROP_OPTS:
       nc_recomb_seager_set_options (recomb_seager, g_value_get_flags (value));
       break;
+    case PROP_USE_TABLE:
+      nc_recomb_seager_set_use_table (recomb_seager, g_value_get_boolean (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -212,6 +258,9 @@ _nc_recomb_seager_get_property (GObject* object, guint prop_id, GValue* value, G
     case PROP_OPTS:
       g_value_set_flags (value, nc_recomb_seager_get_options (recomb_seager));
       break;
+    case PROP_USE_TABLE:
+      g_value_set_boolean (value, nc_recomb_seager_get_use_table (recomb_seager));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -238,6 +287,8 @@ _nc_recomb_seager_dispose (GObject* object)
   ncm_spline_clear (&recomb_seager->XHII_s);
   ncm_spline_clear (&recomb_seager->XHeII_s);
 
+  nc_recomb_seager_clear_table (recomb_seager);
+
   /* Chain up : end */
   G_OBJECT_CLASS (nc_recomb_seager_parent_class)->dispose (object);
 }
@@ -287,6 +338,20 @@ nc_recomb_seager_class_init (NcRecombSeagerClass *klass)
                                                        "Integration options",
                                                        NC_TYPE_RECOMB_SEAGER_OPT, NC_RECOM_SEAGER_OPT_ALL,
                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
+  /**
+   * NcRecombSeager:use-table:
+   *
+   * Whether to use the recombination table, when available, instead of
+   * integrating the system.
+   *
+   */
+  g_object_class_install_property (object_class,
+                                   PROP_USE_TABLE,
+                                   g_param_spec_boolean ("use-table",
+                                                         NULL,
+                                                         "Whether to use the recombination table",
+                                                         FALSE,
+                                                         G_PARAM_READWRITE | G_PARAM_STATIC_NAME | G_PARAM_STATIC_BLURB));
 
   recomb_class->prepare = &_nc_recomb_seager_prepare;
   recomb_class->Xe      = &_nc_recomb_seager_Xe;
@@ -584,8 +649,11 @@ _nc_recomb_Xe_reion (gdouble lambda, gpointer p)
   return Xe_reion;
 }
 
+/*
+ * Integrates the ionization history and sets Xe_recomb_s, XHII_s and XHeII_s.
+ */
 static void
-_nc_recomb_seager_prepare (NcRecomb *recomb, NcHICosmo *cosmo)
+_nc_recomb_seager_prepare_ode (NcRecomb *recomb, NcHICosmo *cosmo)
 {
   NcRecombSeager *recomb_seager = NC_RECOMB_SEAGER (recomb);
   const gdouble XHe          = nc_hicosmo_XHe (cosmo);
@@ -593,7 +661,6 @@ _nc_recomb_seager_prepare (NcRecomb *recomb, NcHICosmo *cosmo)
   const gdouble lambdai      = recomb->lambdai;
   const gdouble lambda_HeIII = -log (x_HeIII);
   const gdouble lambdaf      = -log (1.0);
-  NcHIReion *reion           = NC_HIREION (ncm_model_peek_submodel_by_mid (NCM_MODEL (cosmo), nc_hireion_id ()));
   NcRecombSeagerParams pparams = { recomb_seager, cosmo };
   gsl_function F;
 
@@ -749,30 +816,45 @@ _nc_recomb_seager_prepare (NcRecomb *recomb, NcHICosmo *cosmo)
     ncm_spline_set_array (recomb_seager->XHII_s,      lambda_a, XHII_a, TRUE);
     ncm_spline_set_array (recomb_seager->XHeII_s,     lambda_a, XHeII_a, TRUE);
 
-    if (reion != NULL)
-    {
-      gpointer m[3] = {recomb, cosmo, reion};
-
-      F.function = &_nc_recomb_Xe_reion;
-      F.params   = m;
-            
-      ncm_spline_set_func (recomb_seager->Xe_reion_s, NCM_SPLINE_FUNCTION_SPLINE,
-                           &F, lambdai, lambdaf, 0, recomb->prec);
-
-      ncm_spline_clear (&recomb_seager->Xe_s);
-      recomb_seager->Xe_s = ncm_spline_ref (recomb_seager->Xe_reion_s);
-    }
-    else
-    {
-      ncm_spline_clear (&recomb_seager->Xe_s);
-      recomb_seager->Xe_s = ncm_spline_ref (recomb_seager->Xe_recomb_s);
-    }  
-    
     g_array_unref (lambda_a);
     g_array_unref (Xe_a);
     g_array_unref (XHII_a);
     g_array_unref (XHeII_a);
   }
+}
+
+static gboolean _nc_recomb_seager_prepare_table (NcRecomb *recomb, NcHICosmo *cosmo);
+
+static void
+_nc_recomb_seager_prepare (NcRecomb *recomb, NcHICosmo *cosmo)
+{
+  NcRecombSeager *recomb_seager = NC_RECOMB_SEAGER (recomb);
+  const gdouble lambdai         = recomb->lambdai;
+  const gdouble lambdaf         = -log (1.0);
+  NcHIReion *reion              = NC_HIREION (ncm_model_peek_submodel_by_mid (NCM_MODEL (cosmo), nc_hireion_id ()));
+
+  if (!(recomb_seager->use_table && _nc_recomb_seager_prepare_table (recomb, cosmo)))
+    _nc_recomb_seager_prepare_ode (recomb, cosmo);
+
+  if (reion != NULL)
+  {
+    gpointer m[3] = {recomb, cosmo, reion};
+    gsl_function F;
+
+    F.function = &_nc_recomb_Xe_reion;
+    F.params   = m;
+          
+    ncm_spline_set_func (recomb_seager->Xe_reion_s, NCM_SPLINE_FUNCTION_SPLINE,
+                         &F, lambdai, lambdaf, 0, recomb->prec);
+
+    ncm_spline_clear (&recomb_seager->Xe_s);
+    recomb_seager->Xe_s = ncm_spline_ref (recomb_seager->Xe_reion_s);
+  }
+  else
+  {
+    ncm_spline_clear (&recomb_seager->Xe_s);
+    recomb_seager->Xe_s = ncm_spline_ref (recomb_seager->Xe_recomb_s);
+  }  
 
   recomb->tau_s          = ncm_spline_copy_empty (recomb_seager->Xe_s);
   recomb->dtau_dlambda_s = ncm_spline_copy_empty (recomb_seager->Xe_s);
@@ -781,6 +863,176 @@ _nc_recomb_seager_prepare (NcRecomb *recomb, NcHICosmo *cosmo)
   _nc_recomb_prepare_redshifts (recomb, cosmo);
 }
 
+static void
+_nc_recomb_seager_table_key (NcHICosmo *cosmo, gdouble *p)
+{
+  p[NC_RECOMB_SEAGER_TABLE_OMEGA_B0H2] = nc_hicosmo_Omega_b0h2 (cosmo);
+  p[NC_RECOMB_SEAGER_TABLE_OMEGA_C0H2] = nc_hicosmo_Omega_c0h2 (cosmo);
+  p[NC_RECOMB_SEAGER_TABLE_YP]         = nc_hicosmo_Yp_4He (cosmo);
+  p[NC_RECOMB_SEAGER_TABLE_T_GAMMA0]   = nc_hicosmo_T_gamma0 (cosmo);
+  p[NC_RECOMB_SEAGER_TABLE_NEFF]       = nc_hicosmo_Neff (cosmo);
+}
+
+/*
+ * Chebyshev-Lobatto nodes mapped to [lb, ub].
+ */
+static gdouble
+_nc_recomb_seager_table_node (NcRecombSeager *recomb_seager, const guint d, const guint j)
+{
+  const guint n = recomb_seager->table_n[d];
+
+  if (n == 1)
+    return recomb_seager->table_lb[d];
+  else
+  {
+    const gdouble t = cos (M_PI * j / (n - 1.0));
+    return 0.5 * (recomb_seager->table_lb[d] + recomb_seager->table_ub[d]) + 0.5 * (recomb_seager->table_lb[d] - recomb_seager->table_ub[d]) * t;
+  }
+}
+
+/*
+ * Computes the tensor product barycentric Lagrange interpolation at p,
+ * returns FALSE if p is outside the table.
+ */
+static gboolean
+_nc_recomb_seager_table_interp (NcRecombSeager *recomb_seager, const gdouble *p, NcmVector *res)
+{
+  gdouble lw[NC_RECOMB_SEAGER_TABLE_LEN][NC_RECOMB_SEAGER_TABLE_MAX_NODES];
+  const guint nnodes = ncm_matrix_nrows (recomb_seager->table);
+  guint d, k;
+
+  for (d = 0; d < NC_RECOMB_SEAGER_TABLE_LEN; d++)
+  {
+    const guint n    = recomb_seager->table_n[d];
+    const gdouble lb = recomb_seager->table_lb[d];
+    const gdouble ub = recomb_seager->table_ub[d];
+
+    if (n == 1)
+    {
+      if (ncm_cmp (p[d], lb, 1.0e-10, 0.0) != 0)
+        return FALSE;
+
+      lw[d][0] = 1.0;
+    }
+    else
+    {
+      gboolean on_node = FALSE;
+      gdouble sum      = 0.0;
+      guint j;
+
+      if ((p[d] < lb) || (p[d] > ub))
+        return FALSE;
+
+      for (j = 0; j < n; j++)
+      {
+        const gdouble dp = p[d] - _nc_recomb_seager_table_node (recomb_seager, d, j);
+        const gdouble wj = ((j % 2 == 0) ? 1.0 : -1.0) * (((j == 0) || (j == n - 1)) ? 0.5 : 1.0);
+
+        if (dp == 0.0)
+        {
+          guint l;
+          for (l = 0; l < n; l++)
+            lw[d][l] = 0.0;
+          lw[d][j] = 1.0;
+          on_node  = TRUE;
+          break;
+        }
+
+        lw[d][j] = wj / dp;
+        sum     += lw[d][j];
+      }
+
+      if (!on_node)
+      {
+        for (j = 0; j < n; j++)
+          lw[d][j] = lw[d][j] / sum;
+      }
+    }
+  }
+
+  ncm_vector_set_zero (res);
+
+  for (k = 0; k < nnodes; k++)
+  {
+    gdouble w = 1.0;
+    guint r   = k;
+
+    for (d = 0; d < NC_RECOMB_SEAGER_TABLE_LEN; d++)
+    {
+      const guint n = recomb_seager->table_n[d];
+      w *= lw[d][r % n];
+      r /= n;
+    }
+
+    if (w != 0.0)
+    {
+      NcmVector *row = ncm_matrix_get_row (recomb_seager->table, k);
+      ncm_vector_axpy (res, w, row);
+      ncm_vector_free (row);
+    }
+  }
+
+  return TRUE;
+}
+
+/*
+ * Samples Xe_recomb_s, XHII_s and XHeII_s on the table grid.
+ */
+static void
+_nc_recomb_seager_table_sample (NcRecombSeager *recomb_seager, NcmVector *res)
+{
+  const guint nlambda = ncm_vector_len (recomb_seager->table_lambda);
+  guint i;
+
+  for (i = 0; i < nlambda; i++)
+  {
+    const gdouble lambda = ncm_vector_get (recomb_seager->table_lambda, i);
+
+    ncm_vector_set (res, i,               ncm_spline_eval (recomb_seager->Xe_recomb_s, lambda));
+    ncm_vector_set (res, nlambda + i,     ncm_spline_eval (recomb_seager->XHII_s, lambda));
+    ncm_vector_set (res, 2 * nlambda + i, ncm_spline_eval (recomb_seager->XHeII_s, lambda));
+  }
+}
+
+static gboolean
+_nc_recomb_seager_prepare_table (NcRecomb *recomb, NcHICosmo *cosmo)
+{
+  NcRecombSeager *recomb_seager = NC_RECOMB_SEAGER (recomb);
+  gdouble p[NC_RECOMB_SEAGER_TABLE_LEN];
+
+  if ((recomb_seager->table == NULL) || (recomb_seager->table_lambdai != recomb->lambdai))
+    return FALSE;
+
+  _nc_recomb_seager_table_key (cosmo, p);
+
+  if (!_nc_recomb_seager_table_interp (recomb_seager, p, recomb_seager->table_res))
+    return FALSE;
+  else
+  {
+    const guint nlambda = ncm_vector_len (recomb_seager->table_lambda);
+    const gdouble *res  = ncm_vector_data (recomb_seager->table_res);
+    GArray *lambda_a    = ncm_vector_dup_array (recomb_seager->table_lambda);
+    GArray *Xe_a        = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), nlambda);
+    GArray *XHII_a      = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), nlambda);
+    GArray *XHeII_a     = g_array_sized_new (FALSE, FALSE, sizeof (gdouble), nlambda);
+
+    g_array_append_vals (Xe_a,    &res[0],           nlambda);
+    g_array_append_vals (XHII_a,  &res[nlambda],     nlambda);
+    g_array_append_vals (XHeII_a, &res[2 * nlambda], nlambda);
+
+    ncm_spline_set_array (recomb_seager->Xe_recomb_s, lambda_a, Xe_a, TRUE);
+    ncm_spline_set_array (recomb_seager->XHII_s,      lambda_a, XHII_a, TRUE);
+    ncm_spline_set_array (recomb_seager->XHeII_s,     lambda_a, XHeII_a, TRUE);
+
+    g_array_unref (lambda_a);
+    g_array_unref (Xe_a);
+    g_array_unref (XHII_a);
+    g_array_unref (XHeII_a);
+  }
+
+  return TRUE;
+}
+
 static gdouble
 nc_recomb_seager_HII_ion_rate (NcRecombSeager *recomb_seager, NcHICosmo *cosmo, const gdouble XHI, const gdouble XHII, const gdouble Tm, const gdouble XHeI, const gdouble XHeII, const gdouble x)
 {
@@ -1181,6 +1433,7 @@ void nc_recomb_seager_set_options (NcRecombSeager *recomb_seager, NcRecombSeager
       recomb_seager->KX_HeI_2p_3Pmean_grad = NULL;
     }
 
+    nc_recomb_seager_clear_table (recomb_seager);
     ncm_model_ctrl_force_update (recomb->ctrl_cosmo);
     recomb_seager->opts = opts;
   }
@@ -1264,6 +1517,305 @@ nc_recomb_seager_get_options (NcRecombSeager *recomb_seager)
   return recomb_seager->opts;
 }
 
+/**
+ * nc_recomb_seager_set_table_axis:
+ * @recomb_seager: a #NcRecombSeager
+ * @p: a #NcRecombSeagerTableParam
+ * @lb: lower bound
+ * @ub: upper bound
+ * @n: number of nodes
+ *
+ * Sets the range $[@lb, @ub]$ and the number of Chebyshev-Lobatto nodes @n
+ * of the table axis @p. If @n is one the axis is fixed at @lb and the
+ * table is used only when the parameter matches @lb, if moreover @lb is 
+ * NaN the axis is fixed at the value of the cosmology passed to
+ * nc_recomb_seager_build_table(). Any previously built table is discarded.
+ *
+ */
+void
+nc_recomb_seager_set_table_axis (NcRecombSeager *recomb_seager, NcRecombSeagerTableParam p, gdouble lb, gdouble ub, guint n)
+{
+  g_assert_cmpuint (p, <, NC_RECOMB_SEAGER_TABLE_LEN);
+  g_assert_cmpuint (n, >, 0);
+  g_assert_cmpuint (n, <=, NC_RECOMB_SEAGER_TABLE_MAX_NODES);
+
+  if (n > 1)
+    g_assert_cmpfloat (lb, <, ub);
+
+  nc_recomb_seager_clear_table (recomb_seager);
+
+  recomb_seager->table_lb[p]   = lb;
+  recomb_seager->table_ub[p]   = (n > 1) ? ub : lb;
+  recomb_seager->table_n[p]    = n;
+  recomb_seager->table_tmpl[p] = (n == 1) && gsl_isnan (lb);
+}
+
+/**
+ * nc_recomb_seager_set_table_nlambda:
+ * @recomb_seager: a #NcRecombSeager
+ * @nlambda: number of $\lambda$ knots
+ *
+ * Sets the number of knots of the $\lambda$ grid where the table values are
+ * stored, most of them are placed in the range $z < 10^5$. Any previously
+ * built table is discarded.
+ *
+ */
+void
+nc_recomb_seager_set_table_nlambda (NcRecombSeager *recomb_seager, guint nlambda)
+{
+  g_assert_cmpuint (nlambda, >=, 100);
+
+  nc_recomb_seager_clear_table (recomb_seager);
+  recomb_seager->table_nlambda = nlambda;
+}
+
+static void
+_nc_recomb_seager_table_set_cosmo (NcHICosmo *cosmo, const gdouble *p, const gdouble h2, const gdouble ENnu0, const gdouble Neff0)
+{
+  NcmModel *model = NCM_MODEL (cosmo);
+  gdouble q[NC_RECOMB_SEAGER_TABLE_LEN];
+  guint d;
+
+  ncm_model_orig_param_set (model, NC_HICOSMO_DE_OMEGA_B,   p[NC_RECOMB_SEAGER_TABLE_OMEGA_B0H2] / h2);
+  ncm_model_orig_param_set (model, NC_HICOSMO_DE_OMEGA_C,   p[NC_RECOMB_SEAGER_TABLE_OMEGA_C0H2] / h2);
+  ncm_model_orig_param_set (model, NC_HICOSMO_DE_HE_YP,     p[NC_RECOMB_SEAGER_TABLE_YP]);
+  ncm_model_orig_param_set (model, NC_HICOSMO_DE_T_GAMMA0,  p[NC_RECOMB_SEAGER_TABLE_T_GAMMA0]);
+  ncm_model_orig_param_set (model, NC_HICOSMO_DE_ENNU,      ENnu0 + p[NC_RECOMB_SEAGER_TABLE_NEFF] - Neff0);
+
+  _nc_recomb_seager_table_key (cosmo, q);
+
+  for (d = 0; d < NC_RECOMB_SEAGER_TABLE_LEN; d++)
+  {
+    if (ncm_cmp (p[d], q[d], 1.0e-7, 0.0) != 0)
+      g_error ("nc_recomb_seager_build_table: cannot set the table parameter %u to % 22.15g, got % 22.15g.", d, p[d], q[d]);
+  }
+}
+
+static gdouble
+_nc_recomb_seager_table_check (NcRecombSeager *recomb_seager, NcHICosmo *cosmo, const gdouble *p, const gdouble h2, const gdouble ENnu0, const gdouble Neff0, NcmVector *ode_res)
+{
+  const guint nlambda = ncm_vector_len (recomb_seager->table_lambda);
+  gdouble err         = 0.0;
+  guint i;
+
+  _nc_recomb_seager_table_set_cosmo (cosmo, p, h2, ENnu0, Neff0);
+  _nc_recomb_seager_prepare_ode (NC_RECOMB (recomb_seager), cosmo);
+  _nc_recomb_seager_table_sample (recomb_seager, ode_res);
+
+  if (!_nc_recomb_seager_table_interp (recomb_seager, p, recomb_seager->table_res))
+    g_assert_not_reached ();
+
+  for (i = 0; i < nlambda; i++)
+    err = GSL_MAX (err, fabs (ncm_vector_get (recomb_seager->table_res, i) / ncm_vector_get (ode_res, i) - 1.0));
+
+  return err;
+}
+
+/**
+ * nc_recomb_seager_build_table:
+ * @recomb_seager: a #NcRecombSeager
+ * @cosmo: a #NcHICosmo
+ *
+ * Builds the recombination table integrating the ionization history at
+ * every node defined by nc_recomb_seager_set_table_axis(). The parameters
+ * of @cosmo that are not table axes are kept fixed, the same holds for the
+ * axes set with a NaN fixed value, @cosmo itself is not
+ * modified. Currently @cosmo must be a #NcHICosmoDE, whose parameters are
+ * used to move along the table axes.
+ *
+ * After building, the interpolation is compared to the integration at the
+ * center of the table and, for each axis, between the two first and the
+ * two last nodes. The largest relative error in $X_\e$ is available through
+ * nc_recomb_seager_get_table_accuracy(). The table is used only after
+ * calling nc_recomb_seager_set_use_table().
+ *
+ */
+void
+nc_recomb_seager_build_table (NcRecombSeager *recomb_seager, NcHICosmo *cosmo)
+{
+  NcRecomb *recomb        = NC_RECOMB (recomb_seager);
+  const guint nlambda     = recomb_seager->table_nlambda;
+  const gdouble lambdai   = recomb->lambdai;
+  const gdouble lambdaf   = -log (1.0);
+  const gdouble lambda_s  = GSL_MAX (-log (1.0 + 1.0e5), lambdai);
+  const guint ncoarse     = (lambda_s > lambdai) ? nlambda / 20 : 0;
+  const guint nfine       = nlambda - ncoarse;
+  NcmSerialize *ser       = ncm_serialize_new (NCM_SERIALIZE_OPT_NONE);
+  NcHICosmo *cosmo_dup;
+  gdouble p[NC_RECOMB_SEAGER_TABLE_LEN];
+  gdouble h2, ENnu0, Neff0;
+  guint nnodes = 1;
+  guint d, i, k;
+
+  if (!NC_IS_HICOSMO_DE (cosmo))
+    g_error ("nc_recomb_seager_build_table: the table can only be built using a NcHICosmoDE model, got `%s'.",
+             G_OBJECT_TYPE_NAME (cosmo));
+
+  nc_recomb_seager_clear_table (recomb_seager);
+
+  cosmo_dup = NC_HICOSMO (ncm_model_dup (NCM_MODEL (cosmo), ser));
+  h2        = nc_hicosmo_h2 (cosmo_dup);
+  ENnu0     = ncm_model_orig_param_get (NCM_MODEL (cosmo_dup), NC_HICOSMO_DE_ENNU);
+  Neff0     = nc_hicosmo_Neff (cosmo_dup);
+
+  /* The axes fixed at the template value. */
+  _nc_recomb_seager_table_key (cosmo_dup, p);
+  for (d = 0; d < NC_RECOMB_SEAGER_TABLE_LEN; d++)
+  {
+    if (recomb_seager->table_tmpl[d])
+    {
+      recomb_seager->table_lb[d] = p[d];
+      recomb_seager->table_ub[d] = p[d];
+    }
+  }
+
+  for (d = 0; d < NC_RECOMB_SEAGER_TABLE_LEN; d++)
+    nnodes *= recomb_seager->table_n[d];
+
+  recomb_seager->table_lambda  = ncm_vector_new (nlambda);
+  recomb_seager->table         = ncm_matrix_new (nnodes, 3 * nlambda);
+  recomb_seager->table_res     = ncm_vector_new (3 * nlambda);
+  recomb_seager->table_lambdai = lambdai;
+
+  /* Coarse grid before He recombination and a fine one after. */
+  for (i = 0; i < ncoarse; i++)
+    ncm_vector_set (recomb_seager->table_lambda, i, lambdai + (lambda_s - lambdai) * i / (1.0 * ncoarse));
+  for (i = 0; i < nfine; i++)
+    ncm_vector_set (recomb_seager->table_lambda, ncoarse + i, lambda_s + (lambdaf - lambda_s) * i / (nfine - 1.0));
+
+  for (k = 0; k < nnodes; k++)
+  {
+    NcmVector *row = ncm_matrix_get_row (recomb_seager->table, k);
+    guint r        = k;
+
+    for (d = 0; d < NC_RECOMB_SEAGER_TABLE_LEN; d++)
+    {
+      const guint n = recomb_seager->table_n[d];
+      p[d] = _nc_recomb_seager_table_node (recomb_seager, d, r % n);
+      r   /= n;
+    }
+
+    _nc_recomb_seager_table_set_cosmo (cosmo_dup, p, h2, ENnu0, Neff0);
+    _nc_recomb_seager_prepare_ode (recomb, cosmo_dup);
+    _nc_recomb_seager_table_sample (recomb_seager, row);
+
+    ncm_vector_free (row);
+  }
+
+  {
+    NcmVector *ode_res = ncm_vector_new (3 * nlambda);
+    gdouble pc[NC_RECOMB_SEAGER_TABLE_LEN];
+    gdouble err;
+
+    for (d = 0; d < NC_RECOMB_SEAGER_TABLE_LEN; d++)
+      pc[d] = 0.5 * (recomb_seager->table_lb[d] + recomb_seager->table_ub[d]);
+
+    err = _nc_recomb_seager_table_check (recomb_seager, cosmo_dup, pc, h2, ENnu0, Neff0, ode_res);
+
+    for (d = 0; d < NC_RECOMB_SEAGER_TABLE_LEN; d++)
+    {
+      const guint n = recomb_seager->table_n[d];
+
+      if (n > 1)
+      {
+        memcpy (p, pc, sizeof (gdouble) * NC_RECOMB_SEAGER_TABLE_LEN);
+
+        p[d] = 0.5 * (_nc_recomb_seager_table_node (recomb_seager, d, 0) + _nc_recomb_seager_table_node (recomb_seager, d, 1));
+        err  = GSL_MAX (err, _nc_recomb_seager_table_check (recomb_seager, cosmo_dup, p, h2, ENnu0, Neff0, ode_res));
+
+        p[d] = 0.5 * (_nc_recomb_seager_table_node (recomb_seager, d, n - 2) + _nc_recomb_seager_table_node (recomb_seager, d, n - 1));
+        err  = GSL_MAX (err, _nc_recomb_seager_table_check (recomb_seager, cosmo_dup, p, h2, ENnu0, Neff0, ode_res));
+      }
+    }
+
+    recomb_seager->table_accuracy = err;
+    ncm_vector_free (ode_res);
+  }
+
+  /* The splines now hold the last test point. */
+  ncm_model_ctrl_force_update (recomb->ctrl_cosmo);
+
+  ncm_model_free (NCM_MODEL (cosmo_dup));
+  ncm_serialize_free (ser);
+}
+
+/**
+ * nc_recomb_seager_clear_table:
+ * @recomb_seager: a #NcRecombSeager
+ *
+ * Discards the recombination table.
+ *
+ */
+void
+nc_recomb_seager_clear_table (NcRecombSeager *recomb_seager)
+{
+  ncm_vector_clear (&recomb_seager->table_lambda);
+  ncm_matrix_clear (&recomb_seager->table);
+  ncm_vector_clear (&recomb_seager->table_res);
+
+  recomb_seager->table_accuracy = GSL_NAN;
+}
+
+/**
+ * nc_recomb_seager_set_use_table:
+ * @recomb_seager: a #NcRecombSeager
+ * @use_table: whether to use the recombination table
+ *
+ * Enables or disables the use of the recombination table, see
+ * nc_recomb_seager_build_table(). When enabled and the cosmology is outside
+ * the table the ionization history is integrated as usual.
+ *
+ */
+void
+nc_recomb_seager_set_use_table (NcRecombSeager *recomb_seager, gboolean use_table)
+{
+  if (recomb_seager->use_table != use_table)
+  {
+    recomb_seager->use_table = use_table;
+    ncm_model_ctrl_force_update (NC_RECOMB (recomb_seager)->ctrl_cosmo);
+  }
+}
+
+/**
+ * nc_recomb_seager_get_use_table:
+ * @recomb_seager: a #NcRecombSeager
+ *
+ * Returns: whether the recombination table is enabled.
+ */
+gboolean
+nc_recomb_seager_get_use_table (NcRecombSeager *recomb_seager)
+{
+  return recomb_seager->use_table;
+}
+
+/**
+ * nc_recomb_seager_has_table:
+ * @recomb_seager: a #NcRecombSeager
+ *
+ * Returns: whether the recombination table was built.
+ */
+gboolean
+nc_recomb_seager_has_table (NcRecombSeager *recomb_seager)
+{
+  return (recomb_seager->table != NULL);
+}
+
+/**
+ * nc_recomb_seager_get_table_accuracy:
+ * @recomb_seager: a #NcRecombSeager
+ *
+ * Gets the largest relative error in $X_\e$ between the table interpolation
+ * and the integration found when the table was built, see
+ * nc_recomb_seager_build_table().
+ *
+ * Returns: the table accuracy or NaN if no table was built.
+ */
+gdouble
+nc_recomb_seager_get_table_accuracy (NcRecombSeager *recomb_seager)
+{
+  return recomb_seager->table_accuracy;
+}
+
 
 /**
  * nc_recomb_seager_pequignot_HI_case_B:
@@ -74,6 +74,28 @@ typedef enum _NcRecombSeagerOpt
   NC_RECOM_SEAGER_OPT_LEN,                                  /*< skip >*/
 } NcRecombSeagerOpt;
 
+/**
+ * NcRecombSeagerTableParam:
+ * @NC_RECOMB_SEAGER_TABLE_OMEGA_B0H2: baryon density $\Omega_{b0}h^2$.
+ * @NC_RECOMB_SEAGER_TABLE_OMEGA_C0H2: cold dark matter density $\Omega_{c0}h^2$.
+ * @NC_RECOMB_SEAGER_TABLE_YP: primordial helium mass fraction $Y_p$.
+ * @NC_RECOMB_SEAGER_TABLE_T_GAMMA0: photon temperature today $T_{\gamma0}$.
+ * @NC_RECOMB_SEAGER_TABLE_NEFF: effective number of neutrinos $N_\mathrm{eff}$.
+ *
+ * Parameters used as the axes of the recombination table, see
+ * nc_recomb_seager_build_table().
+ *
+ */
+typedef enum _NcRecombSeagerTableParam
+{
+  NC_RECOMB_SEAGER_TABLE_OMEGA_B0H2 = 0,
+  NC_RECOMB_SEAGER_TABLE_OMEGA_C0H2,
+  NC_RECOMB_SEAGER_TABLE_YP,
+  NC_RECOMB_SEAGER_TABLE_T_GAMMA0,
+  NC_RECOMB_SEAGER_TABLE_NEFF, /*< private >*/
+  NC_RECOMB_SEAGER_TABLE_LEN,  /*< skip >*/
+} NcRecombSeagerTableParam;
+
 typedef gdouble (*NcRecombSeagerKHI2p2Pmean) (NcRecombSeager *recomb_seager, NcHICosmo *cosmo, const gdouble x, const gdouble H);
 typedef gdouble (*NcRecombSeagerKHeI2p) (NcRecombSeager *recomb_seager, NcHICosmo *cosmo, const gdouble x, const gdouble XHI, const gdouble T, const gdouble XHeI, const gdouble H, const gdouble n_H);
 typedef void (*NcRecombSeagerKHeI2pGrad) (NcRecombSeager *recomb_seager, NcHICosmo *cosmo, const gdouble x, const gdouble XHI, const gdouble T, const gdouble XHeI, const gdouble H, const gdouble n_H, gdouble grad[3]);
@@ -109,6 +131,17 @@ struct _NcRecombSeager
   NcmSpline *Xe_recomb_s;
   NcmSpline *XHII_s;
   NcmSpline *XHeII_s;
+  gboolean use_table;
+  gdouble table_lb[NC_RECOMB_SEAGER_TABLE_LEN];
+  gdouble table_ub[NC_RECOMB_SEAGER_TABLE_LEN];
+  guint table_n[NC_RECOMB_SEAGER_TABLE_LEN];
+  gboolean table_tmpl[NC_RECOMB_SEAGER_TABLE_LEN];
+  guint table_nlambda;
+  gdouble table_lambdai;
+  gdouble table_accuracy;
+  NcmVector *table_lambda;
+  NcmMatrix *table;
+  NcmVector *table_res;
 };
 
 GType nc_recomb_seager_get_type (void) G_GNUC_CONST;
@@ -123,6 +156,15 @@ void nc_recomb_seager_set_options (NcRecombSeager *recomb_seager, NcRecombSeager
 void nc_recomb_seager_set_switch (NcRecombSeager *recomb_seager, guint H_switch, guint He_switch);
 NcRecombSeagerOpt nc_recomb_seager_get_options (NcRecombSeager *recomb_seager);
 
+void nc_recomb_seager_set_table_axis (NcRecombSeager *recomb_seager, NcRecombSeagerTableParam p, gdouble lb, gdouble ub, guint n);
+void nc_recomb_seager_set_table_nlambda (NcRecombSeager *recomb_seager, guint nlambda);
+void nc_recomb_seager_build_table (NcRecombSeager *recomb_seager, NcHICosmo *cosmo);
+void nc_recomb_seager_clear_table (NcRecombSeager *recomb_seager);
+void nc_recomb_seager_set_use_table (NcRecombSeager *recomb_seager, gboolean use_table);
+gboolean nc_recomb_seager_get_use_table (NcRecombSeager *recomb_seager);
+gboolean nc_recomb_seager_has_table (NcRecombSeager *recomb_seager);
+gdouble nc_recomb_seager_get_table_accuracy (NcRecombSeager *recomb_seager);
+
 gdouble nc_recomb_seager_pequignot_HI_case_B (NcRecombSeager *recomb_seager, NcHICosmo *cosmo, const gdouble Tm);
 gdouble nc_recomb_seager_pequignot_HI_case_B_dTm (NcRecombSeager *recomb_seager, NcHICosmo *cosmo, const gdouble Tm);
 gdouble nc_recomb_seager_hummer_HeI_case_B (NcRecombSeager *recomb_seager, NcHICosmo *cosmo, const gdouble Tm);
@@ -137,6 +179,8 @@ gdouble nc_recomb_seager_hummer_HeI_case_B_trip_dTm (NcRecombSeager *recomb_seag
 #define NC_RECOMB_SEAGER_HUMMER_HEI_CASE_B_P_TRIP (0.761)
 #define NC_RECOMB_SEAGER_HUMMER_HEI_CASE_B_Q_TRIP (pow (10.0, -16.306))
 
+#define NC_RECOMB_SEAGER_TABLE_MAX_NODES (32)
+
 G_END_DECLS
 
 #endif /* _NC_RECOMB_SEAGER_H_ */
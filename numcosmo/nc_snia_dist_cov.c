@@ -506,23 +506,27 @@ nc_snia_dist_cov_mean (NcSNIADistCov *dcov, NcHICosmo *cosmo, NcDataSNIACov *sni
     const gdouble DH    = nc_distance_hubble (dcov->dist, cosmo);
     const gdouble Mcal1 = ABSMAG1 + 5.0 * log10 (DH);
     const gdouble Mcal2 = ABSMAG2 + 5.0 * log10 (DH);
+    NcmVector *dmu_v    = ncm_vector_get_subvector (y, 0, snia_cov->mu_len);
     guint i;
 
     g_assert (NCM_DATA (snia_cov)->init);
 
+    nc_distance_dmodulus_hef_vec (dcov->dist, cosmo, snia_cov->z_he, snia_cov->z_cmb, 
+                                  nc_data_snia_cov_peek_z_cmb_order (snia_cov), dmu_v);
+
     for (i = 0; i < snia_cov->mu_len; i++)
     {
-      const gdouble z_cmb    = ncm_vector_get (snia_cov->z_cmb, i);
-      const gdouble z_he     = ncm_vector_get (snia_cov->z_he, i);
       const gdouble width    = ncm_vector_get (snia_cov->width, i);
       const gdouble colour   = ncm_vector_get (snia_cov->colour, i);
       const gdouble thirdpar = ncm_vector_get (snia_cov->thirdpar, i);
-      const gdouble dmu      = nc_distance_dmodulus_hef (dcov->dist, cosmo, z_he, z_cmb);
+      const gdouble dmu      = ncm_vector_get (dmu_v, i);
       const gdouble mag_th   = dmu - alpha * (width - 1.0) + beta * colour + ((thirdpar < 10.0) ? Mcal1 : Mcal2);
       const gdouble y_i      = mag_th;
 
       ncm_vector_set (y, i, y_i);
     }
+
+    ncm_vector_free (dmu_v);
   }
 }
 
@@ -588,20 +592,22 @@ nc_snia_dist_cov_mag_to_width_colour (NcSNIADistCov *dcov, NcHICosmo *cosmo, NcD
   const gdouble Mcal1 = ABSMAG1 + 5.0 * log10 (DH);
   const gdouble Mcal2 = ABSMAG2 + 5.0 * log10 (DH);
   const guint mu_len = snia_cov->mu_len;
+  NcmVector *dmu_v   = ncm_vector_new (mu_len);
   guint i;
 
   g_assert (NCM_DATA (snia_cov)->init);
 
   ncm_matrix_set_zero (X);
 
+  nc_distance_dmodulus_hef_vec (dcov->dist, cosmo, snia_cov->z_he, snia_cov->z_cmb,
+                                nc_data_snia_cov_peek_z_cmb_order (snia_cov), dmu_v);
+
   if (colmajor)
   {
     for (i = 0; i < mu_len; i++)
     {
-      const gdouble z_cmb    = ncm_vector_get (snia_cov->z_cmb, i);
-      const gdouble z_he     = ncm_vector_get (snia_cov->z_he, i);
       const gdouble thirdpar = ncm_vector_get (snia_cov->thirdpar, i);
-      const gdouble dmu      = nc_distance_dmodulus_hef (dcov->dist, cosmo, z_he, z_cmb);
+      const gdouble dmu      = ncm_vector_get (dmu_v, i);
       const gdouble M        = ((thirdpar < 10.0) ? Mcal1 : Mcal2);
       const gdouble m_obs_i  = ncm_vector_get (snia_cov->mag, i);
       const gdouble w_obs_i  = ncm_vector_get (snia_cov->width, i);
@@ -621,10 +627,8 @@ nc_snia_dist_cov_mag_to_width_colour (NcSNIADistCov *dcov, NcHICosmo *cosmo, NcD
   {
     for (i = 0; i < mu_len; i++)
     {
-      const gdouble z_cmb    = ncm_vector_get (snia_cov->z_cmb, i);
-      const gdouble z_he     = ncm_vector_get (snia_cov->z_he, i);
       const gdouble thirdpar = ncm_vector_get (snia_cov->thirdpar, i);
-      const gdouble dmu      = nc_distance_dmodulus_hef (dcov->dist, cosmo, z_he, z_cmb);
+      const gdouble dmu      = ncm_vector_get (dmu_v, i);
       const gdouble M        = ((thirdpar < 10.0) ? Mcal1 : Mcal2);
       const gdouble m_obs_i  = ncm_vector_get (snia_cov->mag, i);
       const gdouble w_obs_i  = ncm_vector_get (snia_cov->width, i);
@@ -640,6 +644,8 @@ nc_snia_dist_cov_mag_to_width_colour (NcSNIADistCov *dcov, NcHICosmo *cosmo, NcD
       ncm_matrix_set (X, i + 2 * mu_len, i + 1 * mu_len, 1.0);
     }
   }
+
+  ncm_vector_free (dmu_v);
 }
 
 /**
@@ -47,6 +47,7 @@
 
 #include "math/integral.h"
 #include "math/memory_pool.h"
+#include "math/ncm_integral1d_ptr.h"
 #include "math/ncm_cfg.h"
 #include "math/ncm_serialize.h"
 #include "xcor/nc_xcor.h"
@@ -423,52 +424,56 @@ typedef struct _xcor_limber_gsl
 
 	NcXcorLimberKernel* xclk1;
 	NcXcorLimberKernel* xclk2;
-	guint l;
+	guint lmin;
+	gboolean isauto;
 
 	gdouble RH;
 
 } xcor_limber_gsl;
 
-static gdouble
-_xcor_limber_gsl_cross_int (gdouble z, gpointer ptr)
+/*
+ * Integrands for all multipoles lmin, ..., lmin + dim - 1 at once, the
+ * distance and the Hubble function are computed once per node.
+ */
+static void
+_xcor_limber_gsl_int_vec (gpointer ptr, const gdouble* z, const guint len, const guint dim, gdouble* fval)
 {
 	xcor_limber_gsl* xclki = (xcor_limber_gsl*)ptr;
-	const gdouble xi_z = nc_distance_comoving (xclki->dist, xclki->cosmo, z); // in units of Hubble radius
-	const gdouble xi_z_phys = xi_z * xclki->RH; // in Mpc
-	const gdouble E_z = nc_hicosmo_E (xclki->cosmo, z);
-	const NcXcorKinetic xck = { xi_z, E_z };
-	const gdouble k = (xclki->l + 0.5) / (xi_z_phys); // in Mpc-1
-	const gdouble power_spec = ncm_powspec_eval (NCM_POWSPEC (xclki->ps), NCM_MODEL (xclki->cosmo), z, k);
-
-	const gdouble k1z = nc_xcor_limber_kernel_eval (xclki->xclk1, xclki->cosmo, z, &xck, xclki->l);
-	const gdouble k2z = nc_xcor_limber_kernel_eval (xclki->xclk2, xclki->cosmo, z, &xck, xclki->l);
-
-	return E_z * k1z * k2z * power_spec / (xi_z * xi_z);
-}
+	guint i, j;
 
-static gdouble
-_xcor_limber_gsl_auto_int (gdouble z, gpointer ptr)
-{
-	xcor_limber_gsl* xclki = (xcor_limber_gsl*)ptr;
-	const gdouble xi_z = nc_distance_comoving (xclki->dist, xclki->cosmo, z); // in units of Hubble radius
-	const gdouble xi_z_phys = xi_z * xclki->RH; // in Mpc
-	const gdouble E_z = nc_hicosmo_E (xclki->cosmo, z);
-	const NcXcorKinetic xck = { xi_z, E_z };
-	const gdouble k = (xclki->l + 0.5) / (xi_z_phys); // in Mpc-1
-	const gdouble power_spec = ncm_powspec_eval (NCM_POWSPEC (xclki->ps), NCM_MODEL (xclki->cosmo), z, k);
-	const gdouble k1z = nc_xcor_limber_kernel_eval (xclki->xclk1, xclki->cosmo, z, &xck, xclki->l);
+	for (i = 0; i < len; i++)
+	{
+		const gdouble xi_z = nc_distance_comoving (xclki->dist, xclki->cosmo, z[i]); // in units of Hubble radius
+		const gdouble xi_z_phys = xi_z * xclki->RH; // in Mpc
+		const gdouble E_z = nc_hicosmo_E (xclki->cosmo, z[i]);
+		const NcXcorKinetic xck = { xi_z, E_z };
 
-	return E_z * gsl_pow_2 (k1z / xi_z) * power_spec;
+		for (j = 0; j < dim; j++)
+		{
+			const guint l = xclki->lmin + j;
+			const gdouble k = (l + 0.5) / (xi_z_phys); // in Mpc-1
+			const gdouble power_spec = ncm_powspec_eval (NCM_POWSPEC (xclki->ps), NCM_MODEL (xclki->cosmo), z[i], k);
+			const gdouble k1z = nc_xcor_limber_kernel_eval (xclki->xclk1, xclki->cosmo, z[i], &xck, l);
+
+			if (xclki->isauto)
+			{
+				fval[i * dim + j] = E_z * gsl_pow_2 (k1z / xi_z) * power_spec;
+			}
+			else
+			{
+				const gdouble k2z = nc_xcor_limber_kernel_eval (xclki->xclk2, xclki->cosmo, z[i], &xck, l);
+				fval[i * dim + j] = E_z * k1z * k2z * power_spec / (xi_z * xi_z);
+			}
+		}
+	}
 }
 
 static void
 _nc_xcor_limber_gsl (NcXcor* xc, NcXcorLimberKernel* xclk1, NcXcorLimberKernel* xclk2, NcHICosmo* cosmo, guint lmin, guint lmax, gdouble zmin, gdouble zmax, gboolean isauto, NcmVector* vp)
 {
+	NcmIntegral1dPtr* int1d = ncm_integral1d_ptr_new_vec (&_xcor_limber_gsl_int_vec, NULL);
+	NcmVector* err = ncm_vector_new (lmax - lmin + 1);
 	xcor_limber_gsl xclki;
-	gdouble r, err;
-	gsl_function F;
-	guint i;
-	gint ret;
 
 	xclki.xclk1 = xclk1;
 	xclki.xclk2 = xclk2;
@@ -476,31 +481,19 @@ _nc_xcor_limber_gsl (NcXcor* xc, NcXcorLimberKernel* xclk1, NcXcorLimberKernel*
 	xclki.dist = xc->dist;
 	xclki.ps = xc->ps;
 	xclki.RH = xc->RH;
+	xclki.lmin = lmin;
+	xclki.isauto = isauto;
 
-	if (isauto)
-	{
-		F.function = &_xcor_limber_gsl_auto_int;
-	}
-	else
-	{
-		F.function = &_xcor_limber_gsl_cross_int;
-	}
-
-	F.params = &xclki;
-
-	gsl_integration_workspace** w = ncm_integral_get_workspace ();
+	ncm_integral1d_ptr_set_userdata (int1d, &xclki);
+	ncm_integral1d_set_reltol (NCM_INTEGRAL1D (int1d), NCM_DEFAULT_PRECISION);
+	ncm_integral1d_set_abstol (NCM_INTEGRAL1D (int1d), 0.0);
+	ncm_integral1d_set_partition (NCM_INTEGRAL1D (int1d), NCM_INTEGRAL_PARTITION);
 
-	for (i = 0; i < lmax - lmin + 1; i++)
-	{
-		xclki.l = lmin + i;
-		ret = gsl_integration_qag (&F, zmin, zmax, 0.0, NCM_DEFAULT_PRECISION, NCM_INTEGRAL_PARTITION, 6, *w, &r, &err);
-		if (ret != GSL_SUCCESS)
-			g_error ("_nc_xcor_limber_gsl: %s.", gsl_strerror (ret));
-
-		ncm_vector_set (vp, i, r);
-	}
+	/* All multipoles share a single adaptive subdivision. */
+	ncm_integral1d_eval_vec (NCM_INTEGRAL1D (int1d), zmin, zmax, vp, err);
 
-	ncm_memory_pool_return (w);
+	ncm_vector_free (err);
+	ncm_integral1d_ptr_free (int1d);
 }
 
 
@@ -0,0 +1,275 @@
+/***************************************************************************
+ *            ncm_model_mvnd_test.c
+ *
+ *  Sun October 18 21:02:15 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_model_mvnd_test.c
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Test model and data used by the samplers tests. The model has a single
+ * vector parameter $\mu$ of length dim with flat bounds
+ * [NCM_MODEL_MVND_TEST_LB, NCM_MODEL_MVND_TEST_UB], the data is a
+ * #NcmDataGaussCov with mean $\mu$, observed value zero and covariance
+ * $C_{ij} = \sigma^2\rho^{\vert i-j\vert}$. When the normalization is
+ * included the likelihood integrates to one in $\mu$, therefore the
+ * evidence with the flat prior in the bounds box is
+ * $-d\ln(\mathrm{UB}-\mathrm{LB})$ up to the (negligible) mass outside the box.
+ * The #NcmDataGaussDiag variant has the same mean and observed value with
+ * covariance $\sigma^2 I$, it does not implement the batched likelihood.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+#include "ncm_model_mvnd_test.h"
+
+#include <gsl/gsl_math.h>
+
+G_DEFINE_TYPE (NcmModelMVNDTest, ncm_model_mvnd_test, NCM_TYPE_MODEL);
+G_DEFINE_TYPE (NcmDataGaussCovMVNDTest, ncm_data_gauss_cov_mvnd_test, NCM_TYPE_DATA_GAUSS_COV);
+G_DEFINE_TYPE (NcmDataGaussDiagMVNDTest, ncm_data_gauss_diag_mvnd_test, NCM_TYPE_DATA_GAUSS_DIAG);
+
+enum
+{
+  PROP_0,
+  PROP_SIZE,
+};
+
+static void
+ncm_model_mvnd_test_init (NcmModelMVNDTest *mvnd)
+{
+}
+
+static void
+ncm_model_mvnd_test_finalize (GObject *object)
+{
+  /* Chain up : end */
+  G_OBJECT_CLASS (ncm_model_mvnd_test_parent_class)->finalize (object);
+}
+
+NCM_MSET_MODEL_REGISTER_ID (ncm_model_mvnd_test, NCM_TYPE_MODEL_MVND_TEST);
+
+static void
+ncm_model_mvnd_test_class_init (NcmModelMVNDTestClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  NcmModelClass *model_class = NCM_MODEL_CLASS (klass);
+
+  object_class->finalize = &ncm_model_mvnd_test_finalize;
+
+  ncm_model_class_set_name_nick (model_class, "Multivariate normal test model", "NcmModelMVNDTest");
+  ncm_model_class_add_params (model_class, 0, NCM_MODEL_MVND_TEST_VPARAM_LEN, PROP_SIZE);
+
+  ncm_mset_model_register_id (model_class,
+                              "NcmModelMVNDTest",
+                              "Multivariate normal test model",
+                              NULL,
+                              FALSE,
+                              NCM_MSET_MODEL_MAIN);
+
+  ncm_model_class_set_vparam (model_class, NCM_MODEL_MVND_TEST_MU, 2, "\\mu", "mu",
+                              NCM_MODEL_MVND_TEST_LB, NCM_MODEL_MVND_TEST_UB, 1.0,
+                              0.0, 0.0,
+                              NCM_PARAM_TYPE_FREE);
+
+  ncm_model_class_check_params_info (model_class);
+}
+
+NcmModelMVNDTest *
+ncm_model_mvnd_test_new (guint dim)
+{
+  return g_object_new (NCM_TYPE_MODEL_MVND_TEST,
+                       "mu-length", dim,
+                       NULL);
+}
+
+static void
+ncm_data_gauss_cov_mvnd_test_init (NcmDataGaussCovMVNDTest *data_mvnd)
+{
+}
+
+static void
+ncm_data_gauss_cov_mvnd_test_finalize (GObject *object)
+{
+  /* Chain up : end */
+  G_OBJECT_CLASS (ncm_data_gauss_cov_mvnd_test_parent_class)->finalize (object);
+}
+
+static void _ncm_data_gauss_cov_mvnd_test_prepare (NcmData *data, NcmMSet *mset);
+static void _ncm_data_gauss_cov_mvnd_test_mean_func (NcmDataGaussCov *gauss, NcmMSet *mset, NcmVector *vp);
+
+static void
+ncm_data_gauss_cov_mvnd_test_class_init (NcmDataGaussCovMVNDTestClass *klass)
+{
+  GObjectClass *object_class        = G_OBJECT_CLASS (klass);
+  NcmDataClass *data_class          = NCM_DATA_CLASS (klass);
+  NcmDataGaussCovClass *gauss_class = NCM_DATA_GAUSS_COV_CLASS (klass);
+
+  object_class->finalize = &ncm_data_gauss_cov_mvnd_test_finalize;
+
+  data_class->prepare    = &_ncm_data_gauss_cov_mvnd_test_prepare;
+  gauss_class->mean_func = &_ncm_data_gauss_cov_mvnd_test_mean_func;
+  gauss_class->cov_func  = NULL;
+}
+
+static void
+_ncm_data_gauss_cov_mvnd_test_prepare (NcmData *data, NcmMSet *mset)
+{
+}
+
+static void
+_ncm_data_gauss_cov_mvnd_test_mean_func (NcmDataGaussCov *gauss, NcmMSet *mset, NcmVector *vp)
+{
+  NcmModel *model = ncm_mset_peek (mset, ncm_model_mvnd_test_id ());
+
+  ncm_vector_memcpy (vp, ncm_model_orig_params_peek_vector (model));
+}
+
+NcmData *
+ncm_data_gauss_cov_mvnd_test_new (guint dim, const gdouble sigma, const gdouble rho)
+{
+  NcmDataGaussCov *gauss = g_object_new (NCM_TYPE_DATA_GAUSS_COV_MVND_TEST,
+                                         "n-points",  dim,
+                                         "use-norma", TRUE,
+                                         NULL);
+  guint i, j;
+
+  g_assert_cmpfloat (sigma, >, 0.0);
+  g_assert_cmpfloat (fabs (rho), <, 1.0);
+
+  ncm_vector_set_zero (gauss->y);
+  for (i = 0; i < dim; i++)
+  {
+    for (j = 0; j < dim; j++)
+      ncm_matrix_set (gauss->cov, i, j, sigma * sigma * gsl_pow_int (rho, ABS ((gint) i - (gint) j)));
+  }
+
+  ncm_data_set_init (NCM_DATA (gauss), TRUE);
+
+  return NCM_DATA (gauss);
+}
+
+static void
+ncm_data_gauss_diag_mvnd_test_init (NcmDataGaussDiagMVNDTest *diag_mvnd)
+{
+}
+
+static void
+ncm_data_gauss_diag_mvnd_test_finalize (GObject *object)
+{
+  /* Chain up : end */
+  G_OBJECT_CLASS (ncm_data_gauss_diag_mvnd_test_parent_class)->finalize (object);
+}
+
+static void _ncm_data_gauss_diag_mvnd_test_mean_func (NcmDataGaussDiag *diag, NcmMSet *mset, NcmVector *vp);
+
+static void
+ncm_data_gauss_diag_mvnd_test_class_init (NcmDataGaussDiagMVNDTestClass *klass)
+{
+  GObjectClass *object_class        = G_OBJECT_CLASS (klass);
+  NcmDataClass *data_class          = NCM_DATA_CLASS (klass);
+  NcmDataGaussDiagClass *diag_class = NCM_DATA_GAUSS_DIAG_CLASS (klass);
+
+  object_class->finalize = &ncm_data_gauss_diag_mvnd_test_finalize;
+
+  data_class->prepare    = &_ncm_data_gauss_cov_mvnd_test_prepare;
+  diag_class->mean_func  = &_ncm_data_gauss_diag_mvnd_test_mean_func;
+  diag_class->sigma_func = NULL;
+}
+
+static void
+_ncm_data_gauss_diag_mvnd_test_mean_func (NcmDataGaussDiag *diag, NcmMSet *mset, NcmVector *vp)
+{
+  NcmModel *model = ncm_mset_peek (mset, ncm_model_mvnd_test_id ());
+
+  ncm_vector_memcpy (vp, ncm_model_orig_params_peek_vector (model));
+}
+
+NcmData *
+ncm_data_gauss_diag_mvnd_test_new (guint dim, const gdouble sigma)
+{
+  NcmDataGaussDiag *diag = g_object_new (NCM_TYPE_DATA_GAUSS_DIAG_MVND_TEST,
+                                         "n-points", dim,
+                                         NULL);
+
+  g_assert_cmpfloat (sigma, >, 0.0);
+
+  ncm_vector_set_zero (diag->y);
+  ncm_vector_set_all (diag->sigma, sigma);
+
+  ncm_data_set_init (NCM_DATA (diag), TRUE);
+
+  return NCM_DATA (diag);
+}
+
+NcmMSet *
+ncm_data_gauss_cov_mvnd_test_mset_new (NcmData *data)
+{
+  NcmModelMVNDTest *mvnd = ncm_model_mvnd_test_new (ncm_data_get_length (data));
+  NcmMSet *mset          = ncm_mset_new (mvnd, NULL);
+
+  ncm_mset_prepare_fparam_map (mset);
+  ncm_model_free (NCM_MODEL (mvnd));
+
+  return mset;
+}
+
+NcmFit *
+ncm_data_gauss_cov_mvnd_test_fit_new (NcmData *data, NcmMSet *mset)
+{
+  NcmDataset *dset  = ncm_dataset_new ();
+  NcmLikelihood *lh;
+  NcmFit *fit;
+
+  ncm_dataset_append_data (dset, data);
+  lh  = ncm_likelihood_new (dset);
+  fit = ncm_fit_new (NCM_FIT_TYPE_GSL_MMS, NULL, lh, mset, NCM_FIT_GRAD_NUMDIFF_FORWARD);
+
+  ncm_likelihood_free (lh);
+  ncm_dataset_free (dset);
+
+  return fit;
+}
+
+NcmMatrix *
+ncm_model_mvnd_test_catalog_to_matrix (NcmMSetCatalog *mcat)
+{
+  const guint len = ncm_mset_catalog_len (mcat);
+  NcmMatrix *res  = NULL;
+  guint i;
+
+  for (i = 0; i < len; i++)
+  {
+    NcmVector *row = ncm_mset_catalog_peek_row (mcat, i);
+    NcmVector *res_i;
+
+    if (res == NULL)
+      res = ncm_matrix_new (len, ncm_vector_len (row));
+
+    res_i = ncm_matrix_get_row (res, i);
+    ncm_vector_memcpy (res_i, row);
+    ncm_vector_free (res_i);
+  }
+
+  return res;
+}
@@ -0,0 +1,125 @@
+/***************************************************************************
+ *            ncm_model_mvnd_test.h
+ *
+ *  Sun October 18 21:02:15 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * ncm_model_mvnd_test.h
+ * Copyright (C) 2026 Sandro Dias Pinto Vitenti <sandro@isoftware.com.br>
+ *
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _NCM_MODEL_MVND_TEST_H_
+#define _NCM_MODEL_MVND_TEST_H_
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define NCM_TYPE_MODEL_MVND_TEST             (ncm_model_mvnd_test_get_type ())
+#define NCM_MODEL_MVND_TEST(obj)             (G_TYPE_CHECK_INSTANCE_CAST ((obj), NCM_TYPE_MODEL_MVND_TEST, NcmModelMVNDTest))
+#define NCM_MODEL_MVND_TEST_CLASS(klass)     (G_TYPE_CHECK_CLASS_CAST ((klass), NCM_TYPE_MODEL_MVND_TEST, NcmModelMVNDTestClass))
+#define NCM_IS_MODEL_MVND_TEST(obj)          (G_TYPE_CHECK_INSTANCE_TYPE ((obj), NCM_TYPE_MODEL_MVND_TEST))
+#define NCM_IS_MODEL_MVND_TEST_CLASS(klass)  (G_TYPE_CHECK_CLASS_TYPE ((klass), NCM_TYPE_MODEL_MVND_TEST))
+#define NCM_MODEL_MVND_TEST_GET_CLASS(obj)   (G_TYPE_INSTANCE_GET_CLASS ((obj), NCM_TYPE_MODEL_MVND_TEST, NcmModelMVNDTestClass))
+
+#define NCM_TYPE_DATA_GAUSS_COV_MVND_TEST             (ncm_data_gauss_cov_mvnd_test_get_type ())
+#define NCM_DATA_GAUSS_COV_MVND_TEST(obj)             (G_TYPE_CHECK_INSTANCE_CAST ((obj), NCM_TYPE_DATA_GAUSS_COV_MVND_TEST, NcmDataGaussCovMVNDTest))
+#define NCM_DATA_GAUSS_COV_MVND_TEST_CLASS(klass)     (G_TYPE_CHECK_CLASS_CAST ((klass), NCM_TYPE_DATA_GAUSS_COV_MVND_TEST, NcmDataGaussCovMVNDTestClass))
+#define NCM_IS_DATA_GAUSS_COV_MVND_TEST(obj)          (G_TYPE_CHECK_INSTANCE_TYPE ((obj), NCM_TYPE_DATA_GAUSS_COV_MVND_TEST))
+#define NCM_IS_DATA_GAUSS_COV_MVND_TEST_CLASS(klass)  (G_TYPE_CHECK_CLASS_TYPE ((klass), NCM_TYPE_DATA_GAUSS_COV_MVND_TEST))
+#define NCM_DATA_GAUSS_COV_MVND_TEST_GET_CLASS(obj)   (G_TYPE_INSTANCE_GET_CLASS ((obj), NCM_TYPE_DATA_GAUSS_COV_MVND_TEST, NcmDataGaussCovMVNDTestClass))
+
+#define NCM_TYPE_DATA_GAUSS_DIAG_MVND_TEST             (ncm_data_gauss_diag_mvnd_test_get_type ())
+#define NCM_DATA_GAUSS_DIAG_MVND_TEST(obj)             (G_TYPE_CHECK_INSTANCE_CAST ((obj), NCM_TYPE_DATA_GAUSS_DIAG_MVND_TEST, NcmDataGaussDiagMVNDTest))
+#define NCM_DATA_GAUSS_DIAG_MVND_TEST_CLASS(klass)     (G_TYPE_CHECK_CLASS_CAST ((klass), NCM_TYPE_DATA_GAUSS_DIAG_MVND_TEST, NcmDataGaussDiagMVNDTestClass))
+#define NCM_IS_DATA_GAUSS_DIAG_MVND_TEST(obj)          (G_TYPE_CHECK_INSTANCE_TYPE ((obj), NCM_TYPE_DATA_GAUSS_DIAG_MVND_TEST))
+#define NCM_IS_DATA_GAUSS_DIAG_MVND_TEST_CLASS(klass)  (G_TYPE_CHECK_CLASS_TYPE ((klass), NCM_TYPE_DATA_GAUSS_DIAG_MVND_TEST))
+#define NCM_DATA_GAUSS_DIAG_MVND_TEST_GET_CLASS(obj)   (G_TYPE_INSTANCE_GET_CLASS ((obj), NCM_TYPE_DATA_GAUSS_DIAG_MVND_TEST, NcmDataGaussDiagMVNDTestClass))
+
+typedef struct _NcmModelMVNDTestClass NcmModelMVNDTestClass;
+typedef struct _NcmModelMVNDTest NcmModelMVNDTest;
+typedef struct _NcmDataGaussCovMVNDTestClass NcmDataGaussCovMVNDTestClass;
+typedef struct _NcmDataGaussCovMVNDTest NcmDataGaussCovMVNDTest;
+typedef struct _NcmDataGaussDiagMVNDTestClass NcmDataGaussDiagMVNDTestClass;
+typedef struct _NcmDataGaussDiagMVNDTest NcmDataGaussDiagMVNDTest;
+
+struct _NcmModelMVNDTestClass
+{
+  NcmModelClass parent_class;
+};
+
+struct _NcmModelMVNDTest
+{
+  NcmModel parent_instance;
+};
+
+struct _NcmDataGaussCovMVNDTestClass
+{
+  NcmDataGaussCovClass parent_class;
+};
+
+struct _NcmDataGaussCovMVNDTest
+{
+  NcmDataGaussCov parent_instance;
+};
+
+struct _NcmDataGaussDiagMVNDTestClass
+{
+  NcmDataGaussDiagClass parent_class;
+};
+
+struct _NcmDataGaussDiagMVNDTest
+{
+  NcmDataGaussDiag parent_instance;
+};
+
+/**
+ * NcmModelMVNDTestVParams:
+ * @NCM_MODEL_MVND_TEST_MU: the mean vector
+ *
+ * Vector parameters of the test model.
+ *
+ */
+typedef enum _NcmModelMVNDTestVParams
+{
+  NCM_MODEL_MVND_TEST_MU = 0,
+  /* < private > */
+  NCM_MODEL_MVND_TEST_VPARAM_LEN, /*< skip >*/
+} NcmModelMVNDTestVParams;
+
+#define NCM_MODEL_MVND_TEST_LB (-10.0)
+#define NCM_MODEL_MVND_TEST_UB ( 10.0)
+
+GType ncm_model_mvnd_test_get_type (void) G_GNUC_CONST;
+GType ncm_data_gauss_cov_mvnd_test_get_type (void) G_GNUC_CONST;
+GType ncm_data_gauss_diag_mvnd_test_get_type (void) G_GNUC_CONST;
+
+NCM_MSET_MODEL_DECLARE_ID (ncm_model_mvnd_test);
+
+NcmModelMVNDTest *ncm_model_mvnd_test_new (guint dim);
+
+NcmData *ncm_data_gauss_cov_mvnd_test_new (guint dim, const gdouble sigma, const gdouble rho);
+NcmData *ncm_data_gauss_diag_mvnd_test_new (guint dim, const gdouble sigma);
+NcmMSet *ncm_data_gauss_cov_mvnd_test_mset_new (NcmData *data);
+NcmFit *ncm_data_gauss_cov_mvnd_test_fit_new (NcmData *data, NcmMSet *mset);
+
+NcmMatrix *ncm_model_mvnd_test_catalog_to_matrix (NcmMSetCatalog *mcat);
+
+G_END_DECLS
+
+#endif /* _NCM_MODEL_MVND_TEST_H_ */
@@ -61,6 +61,8 @@ void test_nc_data_bao_rdv_set_sample_blake2012 (TestNcDataBaoRDV *test, gconstpo
 void test_nc_data_bao_rdv_new_kazin2014 (TestNcDataBaoRDV *test, gconstpointer pdata);
 void test_nc_data_bao_rdv_set_sample_kazin2014 (TestNcDataBaoRDV *test, gconstpointer pdata);
 
+void test_nc_data_bao_rdv_m2lnL_batch (TestNcDataBaoRDV *test, gconstpointer pdata);
+
 gint
 main (gint argc, gchar *argv[])
 {
@@ -97,6 +99,11 @@ main (gint argc, gchar *argv[])
               &test_nc_data_bao_rdv_set_sample_kazin2014,
               &test_nc_data_bao_rdv_free);
 
+  g_test_add ("/nc/data_bao_rdv/m2lnL_batch", TestNcDataBaoRDV, NULL,
+              &test_nc_data_bao_rdv_new_percival2010,
+              &test_nc_data_bao_rdv_m2lnL_batch,
+              &test_nc_data_bao_rdv_free);
+
   g_test_run ();
 }
 
@@ -472,3 +479,77 @@ test_nc_data_bao_rdv_set_sample_kazin2014 (TestNcDataBaoRDV *test, gconstpointer
   ncm_assert_cmpdouble (ncm_matrix_get (gauss->inv_cov, 2, 1), ==, icov21);
   ncm_assert_cmpdouble (ncm_matrix_get (gauss->inv_cov, 2, 2), ==, icov22);
 }
+
+/* Batched evaluation */
+
+void
+test_nc_data_bao_rdv_m2lnL_batch (TestNcDataBaoRDV *test, gconstpointer pdata)
+{
+  NcmData *data       = NCM_DATA (test->rdv);
+  NcHICosmo *cosmo    = nc_hicosmo_new_from_name (NC_TYPE_HICOSMO, "NcHICosmoDEXcdm");
+  NcmMSet *mset       = ncm_mset_new (cosmo, NULL);
+  NcmDataset *dset    = ncm_dataset_new ();
+  const guint npoints = 50;
+  NcmMatrix *fparams;
+  NcmVector *fparams0, *m2lnL_v, *fit_m2lnL_v;
+  NcmLikelihood *lh;
+  NcmFit *fit;
+  guint a, i;
+
+  ncm_mset_param_set_ftype (mset, nc_hicosmo_id (), NC_HICOSMO_DE_OMEGA_C, NCM_PARAM_TYPE_FREE);
+  ncm_mset_param_set_ftype (mset, nc_hicosmo_id (), NC_HICOSMO_DE_OMEGA_X, NCM_PARAM_TYPE_FREE);
+  ncm_mset_prepare_fparam_map (mset);
+
+  fparams     = ncm_matrix_new (npoints, ncm_mset_fparams_len (mset));
+  fparams0    = ncm_vector_new (ncm_mset_fparams_len (mset));
+  m2lnL_v     = ncm_vector_new (npoints);
+  fit_m2lnL_v = ncm_vector_new (npoints);
+
+  ncm_mset_fparams_get_vector (mset, fparams0);
+  for (a = 0; a < npoints; a++)
+  {
+    for (i = 0; i < ncm_mset_fparams_len (mset); i++)
+      ncm_matrix_set (fparams, a, i, ncm_vector_get (fparams0, i) * (1.0 + g_test_rand_double_range (-0.1, 0.1)));
+  }
+
+  ncm_data_m2lnL_val_batch (data, mset, fparams, m2lnL_v);
+
+  for (i = 0; i < ncm_mset_fparams_len (mset); i++)
+    ncm_assert_cmpdouble (ncm_mset_fparam_get (mset, i), ==, ncm_vector_get (fparams0, i));
+
+  for (a = 0; a < npoints; a++)
+  {
+    NcmVector *fparams_a = ncm_matrix_get_row (fparams, a);
+    gdouble m2lnL_a;
+
+    ncm_mset_fparams_set_vector (mset, fparams_a);
+    ncm_data_m2lnL_val (data, mset, &m2lnL_a);
+    /* The batch uses dtrsm and the scalar path dtrsv, the sums may be reordered. */
+    ncm_assert_cmpdouble_e (ncm_vector_get (m2lnL_v, a), ==, m2lnL_a, 1.0e-13, 0.0);
+
+    ncm_vector_free (fparams_a);
+  }
+  ncm_mset_fparams_set_vector (mset, fparams0);
+
+  ncm_dataset_append_data (dset, data);
+  lh  = ncm_likelihood_new (dset);
+  fit = ncm_fit_new (NCM_FIT_TYPE_NLOPT, "ln-neldermead", lh, mset, NCM_FIT_GRAD_NUMDIFF_CENTRAL);
+
+  ncm_fit_m2lnL_val_batch (fit, fparams, fit_m2lnL_v);
+
+  for (a = 0; a < npoints; a++)
+    ncm_assert_cmpdouble_e (ncm_vector_get (fit_m2lnL_v, a), ==, ncm_vector_get (m2lnL_v, a), 1.0e-12, 0.0);
+
+  for (i = 0; i < ncm_mset_fparams_len (mset); i++)
+    ncm_assert_cmpdouble (ncm_mset_fparam_get (mset, i), ==, ncm_vector_get (fparams0, i));
+
+  ncm_fit_free (fit);
+  ncm_likelihood_free (lh);
+  ncm_dataset_free (dset);
+  ncm_mset_free (mset);
+  nc_hicosmo_free (cosmo);
+  ncm_matrix_free (fparams);
+  ncm_vector_free (fparams0);
+  ncm_vector_free (m2lnL_v);
+  ncm_vector_free (fit_m2lnL_v);
+}
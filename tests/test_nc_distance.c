@@ -0,0 +1,219 @@
+/***************************************************************************
+ *            test_nc_distance.c
+ *
+ *  Sun October 18 22:10:31 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+
+
+#define TEST_NC_DISTANCE_NZ 500
+
+typedef struct _TestNcDistance
+{
+  NcDistance *dist;
+  NcHICosmo *cosmo;
+  NcmVector *z;
+  NcmVector *z_he;
+  GArray *order;
+} TestNcDistance;
+
+void test_nc_distance_new (TestNcDistance *test, gconstpointer pdata);
+void test_nc_distance_free (TestNcDistance *test, gconstpointer pdata);
+
+void test_nc_distance_vec (TestNcDistance *test, gconstpointer pdata);
+void test_nc_distance_table_quad (TestNcDistance *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add ("/nc/distance/vec", TestNcDistance, NULL,
+              &test_nc_distance_new,
+              &test_nc_distance_vec,
+              &test_nc_distance_free);
+
+  g_test_add ("/nc/distance/table/quad", TestNcDistance, NULL,
+              &test_nc_distance_new,
+              &test_nc_distance_table_quad,
+              &test_nc_distance_free);
+
+  g_test_run ();
+}
+
+void
+test_nc_distance_new (TestNcDistance *test, gconstpointer pdata)
+{
+  guint i;
+
+  test->dist  = nc_distance_new (2.0);
+  test->cosmo = NC_HICOSMO (nc_hicosmo_de_xcdm_new ());
+  test->z     = ncm_vector_new (TEST_NC_DISTANCE_NZ);
+  test->z_he  = ncm_vector_new (TEST_NC_DISTANCE_NZ);
+
+  nc_hicosmo_de_omega_x2omega_k (NC_HICOSMO_DE (test->cosmo));
+
+  /* Unsorted redshifts with repeated values, some of them beyond the distance table. */
+  for (i = 0; i < TEST_NC_DISTANCE_NZ; i++)
+  {
+    if ((i > 0) && (g_test_rand_int_range (0, 5) == 0))
+      ncm_vector_set (test->z, i, ncm_vector_get (test->z, g_test_rand_int_range (0, i)));
+    else
+      ncm_vector_set (test->z, i, g_test_rand_double_range (1.0e-3, 3.0));
+
+    ncm_vector_set (test->z_he, i, ncm_vector_get (test->z, i) * (1.0 + g_test_rand_double_range (-1.0e-3, 1.0e-3)));
+  }
+
+  test->order = ncm_vector_get_sort_index (test->z);
+}
+
+void
+test_nc_distance_free (TestNcDistance *test, gconstpointer pdata)
+{
+  NCM_TEST_FREE (nc_distance_free, test->dist);
+  NCM_TEST_FREE (nc_hicosmo_free, test->cosmo);
+  ncm_vector_free (test->z);
+  ncm_vector_free (test->z_he);
+  g_array_unref (test->order);
+}
+
+typedef gdouble (*TestNcDistanceFunc) (NcDistance *dist, NcHICosmo *cosmo, gdouble z);
+typedef void (*TestNcDistanceFuncVec) (NcDistance *dist, NcHICosmo *cosmo, NcmVector *z, GArray *order, NcmVector *res);
+
+static void
+_test_nc_distance_cmp_vec (TestNcDistance *test, TestNcDistanceFunc f, TestNcDistanceFuncVec f_vec)
+{
+  NcmVector *res        = ncm_vector_new (TEST_NC_DISTANCE_NZ);
+  NcmVector *res_nosort = ncm_vector_new (TEST_NC_DISTANCE_NZ);
+  guint i;
+
+  f_vec (test->dist, test->cosmo, test->z, test->order, res);
+  f_vec (test->dist, test->cosmo, test->z, NULL, res_nosort);
+
+  for (i = 0; i < TEST_NC_DISTANCE_NZ; i++)
+  {
+    const gdouble res_i = f (test->dist, test->cosmo, ncm_vector_get (test->z, i));
+
+    ncm_assert_cmpdouble_e (ncm_vector_get (res, i), ==, res_i, 1.0e-14, 0.0);
+    ncm_assert_cmpdouble_e (ncm_vector_get (res_nosort, i), ==, res_i, 1.0e-14, 0.0);
+  }
+
+  ncm_vector_free (res);
+  ncm_vector_free (res_nosort);
+}
+
+void
+test_nc_distance_vec (TestNcDistance *test, gconstpointer pdata)
+{
+  const gdouble Omega_k0[3] = {0.0, 0.1, -0.1};
+  guint j;
+
+  for (j = 0; j < G_N_ELEMENTS (Omega_k0); j++)
+  {
+    ncm_model_param_set (NCM_MODEL (test->cosmo), NC_HICOSMO_DE_OMEGA_X, Omega_k0[j]);
+    ncm_model_param_set (NCM_MODEL (test->cosmo), NC_HICOSMO_DE_XCDM_W, g_test_rand_double_range (-1.2, -0.8));
+
+    _test_nc_distance_cmp_vec (test, &nc_distance_comoving, &nc_distance_comoving_vec);
+    _test_nc_distance_cmp_vec (test, &nc_distance_transverse, &nc_distance_transverse_vec);
+    _test_nc_distance_cmp_vec (test, &nc_distance_luminosity, &nc_distance_luminosity_vec);
+    _test_nc_distance_cmp_vec (test, &nc_distance_dmodulus, &nc_distance_dmodulus_vec);
+    _test_nc_distance_cmp_vec (test, &nc_distance_dilation_scale, &nc_distance_dilation_scale_vec);
+
+    {
+      NcmVector *dmu = ncm_vector_new (TEST_NC_DISTANCE_NZ);
+      guint i;
+
+      nc_distance_dmodulus_hef_vec (test->dist, test->cosmo, test->z_he, test->z, test->order, dmu);
+
+      for (i = 0; i < TEST_NC_DISTANCE_NZ; i++)
+      {
+        const gdouble dmu_i = nc_distance_dmodulus_hef (test->dist, test->cosmo, ncm_vector_get (test->z_he, i), ncm_vector_get (test->z, i));
+
+        ncm_assert_cmpdouble_e (ncm_vector_get (dmu, i), ==, dmu_i, 1.0e-14, 0.0);
+      }
+
+      ncm_vector_free (dmu);
+    }
+  }
+}
+
+static void
+_test_nc_distance_table_cmp (TestNcDistance *test, NcDistance *dist_quad)
+{
+  guint i;
+
+  for (i = 0; i < TEST_NC_DISTANCE_NZ; i++)
+  {
+    const gdouble z = ncm_vector_get (test->z, i);
+
+    ncm_assert_cmpdouble_e (nc_distance_comoving (dist_quad, test->cosmo, z), ==,
+                            nc_distance_comoving (test->dist, test->cosmo, z),
+                            1.0e-7, 0.0);
+  }
+}
+
+void
+test_nc_distance_table_quad (TestNcDistance *test, gconstpointer pdata)
+{
+  NcDistance *dist_quad = nc_distance_new (test->dist->zf);
+  NcmModel *model       = NCM_MODEL (test->cosmo);
+  guint nint, i;
+
+  nc_distance_set_table_engine (dist_quad, NC_DISTANCE_TABLE_ENGINE_QUAD);
+  g_assert_cmpint (nc_distance_get_table_engine (test->dist), ==, NC_DISTANCE_TABLE_ENGINE_ODE);
+  g_assert_cmpuint (nc_distance_get_table_nintervals (dist_quad), ==, 0);
+
+  /* Calibrated on a smooth cosmology. */
+  ncm_model_param_set (model, NC_HICOSMO_DE_OMEGA_X, 0.0);
+  ncm_model_param_set (model, NC_HICOSMO_DE_XCDM_W, -1.0);
+  _test_nc_distance_table_cmp (test, dist_quad);
+
+  nint = nc_distance_get_table_nintervals (dist_quad);
+  g_assert_cmpuint (nint, >, 0);
+
+  /* Cosmologies away from the calibration one. */
+  for (i = 0; i < 10; i++)
+  {
+    ncm_model_param_set (model, NC_HICOSMO_DE_H0, g_test_rand_double_range (60.0, 80.0));
+    ncm_model_param_set (model, NC_HICOSMO_DE_OMEGA_C, g_test_rand_double_range (0.1, 0.5));
+    ncm_model_param_set (model, NC_HICOSMO_DE_OMEGA_X, g_test_rand_double_range (-0.3, 0.3));
+    ncm_model_param_set (model, NC_HICOSMO_DE_XCDM_W, g_test_rand_double_range (-2.0, -0.3));
+
+    _test_nc_distance_table_cmp (test, dist_quad);
+
+    /* The node set is only refined. */
+    g_assert_cmpuint (nc_distance_get_table_nintervals (dist_quad), >=, nint);
+    nint = nc_distance_get_table_nintervals (dist_quad);
+  }
+
+  NCM_TEST_FREE (nc_distance_free, dist_quad);
+}
@@ -27,6 +27,7 @@
 #undef GSL_RANGE_CHECK_OFF
 #endif /* HAVE_CONFIG_H */
 #include <numcosmo/numcosmo.h>
+#include <gsl/gsl_sf_zeta.h>
 
 typedef struct _TestNcHICosmoDE
 {
@@ -37,6 +38,7 @@ void test_nc_hicosmo_de_xcdm_new (TestNcHICosmoDE *test, gconstpointer pdata);
 void test_nc_hicosmo_de_free (TestNcHICosmoDE *test, gconstpointer pdata);
 
 void test_nc_hicosmo_de_omega_x2omega_k (TestNcHICosmoDE *test, gconstpointer pdata);
+void test_nc_hicosmo_de_nu_table (TestNcHICosmoDE *test, gconstpointer pdata);
 
 gint
 main (gint argc, gchar *argv[])
@@ -50,6 +52,11 @@ main (gint argc, gchar *argv[])
               &test_nc_hicosmo_de_omega_x2omega_k,
               &test_nc_hicosmo_de_free);
 
+  g_test_add ("/nc/hicosmo_de/nu_table", TestNcHICosmoDE, NULL,
+              &test_nc_hicosmo_de_xcdm_new,
+              &test_nc_hicosmo_de_nu_table,
+              &test_nc_hicosmo_de_free);
+
   g_test_run ();
 }
 
@@ -99,3 +106,33 @@ test_nc_hicosmo_de_omega_x2omega_k (TestNcHICosmoDE *test, gconstpointer pdata)
     ncm_assert_cmpdouble_e (Omega_k0, ==, 0.0, 1.0e-7, 0.0);
   }
 }
+
+void
+test_nc_hicosmo_de_nu_table (TestNcHICosmoDE *test, gconstpointer pdata)
+{
+  gdouble int_rho, int_p;
+
+  /* Ultra-relativistic limit */
+  nc_hicosmo_de_nu_table_eval (1.0e-8, &int_rho, &int_p);
+  ncm_assert_cmpdouble_e (int_rho, ==, 7.0 * gsl_pow_4 (M_PI) / 60.0, 1.0e-8, 0.0);
+  ncm_assert_cmpdouble_e (int_p, ==, 7.0 * gsl_pow_4 (M_PI) / 180.0, 1.0e-8, 0.0);
+
+  /* Non-relativistic limit */
+  nc_hicosmo_de_nu_table_eval (1.0e8, &int_rho, &int_p);
+  ncm_assert_cmpdouble_e (int_rho, ==, 3.0 * gsl_sf_zeta_int (3) * 1.0e8, 1.0e-8, 0.0);
+  ncm_assert_cmpdouble_e (int_p, ==, 15.0 * gsl_sf_zeta_int (5) / 1.0e8, 1.0e-8, 0.0);
+
+  /* Derivatives against finite differences */
+  {
+    const gdouble xi = 2.0;
+    const gdouble h  = 1.0e-4;
+    gdouble int_rho_p, int_p_p, int_rho_m, int_p_m, dint_rho, dint_p;
+
+    nc_hicosmo_de_nu_table_eval (xi + h, &int_rho_p, &int_p_p);
+    nc_hicosmo_de_nu_table_eval (xi - h, &int_rho_m, &int_p_m);
+    nc_hicosmo_de_nu_table_eval_dxi (xi, &dint_rho, &dint_p);
+
+    ncm_assert_cmpdouble_e (dint_rho, ==, (int_rho_p - int_rho_m) / (2.0 * h), 1.0e-6, 0.0);
+    ncm_assert_cmpdouble_e (dint_p, ==, (int_p_p - int_p_m) / (2.0 * h), 1.0e-6, 0.0);
+  }
+}
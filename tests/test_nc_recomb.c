@@ -31,6 +31,8 @@
 void test_nc_recomb_seager_new (void);
 void test_nc_recomb_seager_wmap_zstar (void);
 void test_nc_recomb_seager_Xe_ini (void);
+void test_nc_recomb_seager_table (void);
+void test_nc_recomb_seager_table_default (void);
 
 gint
 main (gint argc, gchar *argv[])
@@ -42,6 +44,8 @@ main (gint argc, gchar *argv[])
   g_test_add_func ("/nc/recomb/seager/new", &test_nc_recomb_seager_new);
   g_test_add_func ("/nc/recomb/seager/wmap/zstar", &test_nc_recomb_seager_wmap_zstar);
   g_test_add_func ("/nc/recomb/seager/wmap/Xe_ini", &test_nc_recomb_seager_Xe_ini);
+  g_test_add_func ("/nc/recomb/seager/table", &test_nc_recomb_seager_table);
+  g_test_add_func ("/nc/recomb/seager/table/default", &test_nc_recomb_seager_table_default);
 
   g_test_run ();
 }
@@ -125,3 +129,72 @@ test_nc_recomb_seager_Xe_ini (void)
   nc_hicosmo_free (cosmo);
   nc_recomb_free (recomb);
 }
+
+void
+test_nc_recomb_seager_table (void)
+{
+  NcRecombSeager *recomb_seager = nc_recomb_seager_new ();
+  NcRecomb *recomb              = NC_RECOMB (recomb_seager);
+  NcHICosmo *cosmo              = nc_hicosmo_new_from_name (NC_TYPE_HICOSMO, "NcHICosmoDEXcdm");
+  const gdouble omega_b0        = nc_hicosmo_Omega_b0h2 (cosmo);
+  gdouble zstar;
+
+  nc_recomb_seager_set_table_axis (recomb_seager, NC_RECOMB_SEAGER_TABLE_OMEGA_B0H2, 0.9 * omega_b0, 1.1 * omega_b0, 5);
+  nc_recomb_seager_set_table_axis (recomb_seager, NC_RECOMB_SEAGER_TABLE_OMEGA_C0H2, nc_hicosmo_Omega_c0h2 (cosmo), 0.0, 1);
+  nc_recomb_seager_set_table_axis (recomb_seager, NC_RECOMB_SEAGER_TABLE_YP,         nc_hicosmo_Yp_4He (cosmo), 0.0, 1);
+  nc_recomb_seager_set_table_axis (recomb_seager, NC_RECOMB_SEAGER_TABLE_T_GAMMA0,   nc_hicosmo_T_gamma0 (cosmo), 0.0, 1);
+  nc_recomb_seager_set_table_axis (recomb_seager, NC_RECOMB_SEAGER_TABLE_NEFF,       nc_hicosmo_Neff (cosmo), 0.0, 1);
+
+  nc_recomb_seager_build_table (recomb_seager, cosmo);
+  g_assert (nc_recomb_seager_has_table (recomb_seager));
+  g_assert_cmpfloat (nc_recomb_seager_get_table_accuracy (recomb_seager), <, 1.0e-3);
+
+  ncm_model_orig_param_set (NCM_MODEL (cosmo), NC_HICOSMO_DE_OMEGA_B, 1.03 * ncm_model_orig_param_get (NCM_MODEL (cosmo), NC_HICOSMO_DE_OMEGA_B));
+
+  nc_recomb_prepare (recomb, cosmo);
+  zstar = nc_recomb_get_tau_z (recomb, cosmo);
+
+  nc_recomb_seager_set_use_table (recomb_seager, TRUE);
+  nc_recomb_prepare_if_needed (recomb, cosmo);
+  ncm_assert_cmpdouble_e (nc_recomb_get_tau_z (recomb, cosmo), ==, zstar, 1.0e-4, 0.0);
+
+  /* Outside the table, falls back to the integration. */
+  ncm_model_orig_param_set (NCM_MODEL (cosmo), NC_HICOSMO_DE_HE_YP, 1.1 * nc_hicosmo_Yp_4He (cosmo));
+  nc_recomb_seager_set_use_table (recomb_seager, FALSE);
+  nc_recomb_prepare (recomb, cosmo);
+  zstar = nc_recomb_get_tau_z (recomb, cosmo);
+
+  nc_recomb_seager_set_use_table (recomb_seager, TRUE);
+  nc_recomb_prepare_if_needed (recomb, cosmo);
+  ncm_assert_cmpdouble (nc_recomb_get_tau_z (recomb, cosmo), ==, zstar);
+
+  nc_hicosmo_free (cosmo);
+  nc_recomb_free (recomb);
+}
+
+void
+test_nc_recomb_seager_table_default (void)
+{
+  NcRecombSeager *recomb_seager = nc_recomb_seager_new ();
+  NcRecomb *recomb              = NC_RECOMB (recomb_seager);
+  NcHICosmo *cosmo              = nc_hicosmo_new_from_name (NC_TYPE_HICOSMO, "NcHICosmoDEXcdm");
+  gdouble zstar;
+
+  /* Default axes, T_gamma0 must be taken from the template cosmology. */
+  nc_recomb_seager_build_table (recomb_seager, cosmo);
+  g_assert (nc_recomb_seager_has_table (recomb_seager));
+  ncm_assert_cmpdouble (recomb_seager->table_lb[NC_RECOMB_SEAGER_TABLE_T_GAMMA0], ==, nc_hicosmo_T_gamma0 (cosmo));
+  g_assert_cmpfloat (nc_recomb_seager_get_table_accuracy (recomb_seager), <, 1.0e-3);
+
+  nc_recomb_prepare (recomb, cosmo);
+  zstar = nc_recomb_get_tau_z (recomb, cosmo);
+
+  /* The interpolated history differs (slightly) from the integrated one. */
+  nc_recomb_seager_set_use_table (recomb_seager, TRUE);
+  nc_recomb_prepare_if_needed (recomb, cosmo);
+  g_assert_cmpfloat (nc_recomb_get_tau_z (recomb, cosmo), !=, zstar);
+  ncm_assert_cmpdouble_e (nc_recomb_get_tau_z (recomb, cosmo), ==, zstar, 1.0e-4, 0.0);
+
+  nc_hicosmo_free (cosmo);
+  nc_recomb_free (recomb);
+}
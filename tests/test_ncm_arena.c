@@ -0,0 +1,200 @@
+/***************************************************************************
+ *            test_ncm_arena.c
+ *
+ *  Sun October 18 16:40:12 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+
+void test_ncm_arena_align (void);
+void test_ncm_arena_views (void);
+void test_ncm_arena_steady_state (void);
+void test_ncm_arena_traps (void);
+void test_ncm_arena_invalid_no_scope (void);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add_func ("/ncm/arena/align", &test_ncm_arena_align);
+  g_test_add_func ("/ncm/arena/views", &test_ncm_arena_views);
+  g_test_add_func ("/ncm/arena/steady_state", &test_ncm_arena_steady_state);
+#if GLIB_CHECK_VERSION(2,38,0)
+  g_test_add_func ("/ncm/arena/traps", &test_ncm_arena_traps);
+  g_test_add_func ("/ncm/arena/invalid/no_scope/subprocess", &test_ncm_arena_invalid_no_scope);
+#endif
+
+  g_test_run ();
+}
+
+void
+test_ncm_arena_align (void)
+{
+  guint i;
+
+  ncm_arena_push ();
+  for (i = 1; i < 100; i++)
+  {
+    NcmVector *v = ncm_arena_vector_new (i);
+    NcmMatrix *m = ncm_arena_matrix_new (i, 3);
+
+    g_assert_cmpuint (ncm_vector_len (v), ==, i);
+    g_assert_cmpuint (ncm_matrix_nrows (m), ==, i);
+    g_assert_cmpuint (ncm_matrix_ncols (m), ==, 3);
+    g_assert_cmpuint (((guintptr) ncm_vector_data (v)) % NCM_ARENA_ALIGN, ==, 0);
+    g_assert_cmpuint (((guintptr) ncm_matrix_data (m)) % NCM_ARENA_ALIGN, ==, 0);
+
+    ncm_vector_set_all (v, i);
+    ncm_matrix_set_all (m, i);
+  }
+  g_assert_cmpuint (ncm_arena_depth (), ==, 1);
+  ncm_arena_pop ();
+  g_assert_cmpuint (ncm_arena_depth (), ==, 0);
+}
+
+void
+test_ncm_arena_views (void)
+{
+  NcmMatrix *m = ncm_matrix_new (10, 7);
+  guint i, j;
+
+  for (i = 0; i < 10; i++)
+    for (j = 0; j < 7; j++)
+      ncm_matrix_set (m, i, j, i * 7 + j);
+
+  ncm_arena_push ();
+  for (i = 0; i < 10; i++)
+  {
+    NcmVector *row = ncm_arena_matrix_get_row (m, i);
+    NcmVector *sub = ncm_arena_vector_get_subvector (row, 2, 3);
+
+    g_assert_cmpuint (ncm_vector_len (row), ==, 7);
+    g_assert_cmpuint (ncm_vector_len (sub), ==, 3);
+    for (j = 0; j < 7; j++)
+      g_assert_cmpfloat (ncm_vector_get (row, j), ==, i * 7 + j);
+    for (j = 0; j < 3; j++)
+      g_assert_cmpfloat (ncm_vector_get (sub, j), ==, i * 7 + j + 2);
+  }
+
+  ncm_arena_push ();
+  for (j = 0; j < 7; j++)
+  {
+    NcmVector *col = ncm_arena_matrix_get_col (m, j);
+
+    ncm_vector_scale (col, 2.0);
+  }
+  ncm_arena_pop ();
+  ncm_arena_pop ();
+
+  for (i = 0; i < 10; i++)
+    for (j = 0; j < 7; j++)
+      g_assert_cmpfloat (ncm_matrix_get (m, i, j), ==, 2.0 * (i * 7 + j));
+
+  ncm_matrix_free (m);
+}
+
+static gdouble
+_test_ncm_arena_work (NcmMatrix *m)
+{
+  const guint nrows = ncm_matrix_nrows (m);
+  gdouble res = 0.0;
+  guint i;
+
+  ncm_arena_push ();
+  {
+    NcmVector *tmp = ncm_arena_vector_new (ncm_matrix_ncols (m));
+    NcmMatrix *big = ncm_arena_matrix_new (nrows, 1000);
+
+    ncm_matrix_set_all (big, 1.0);
+    for (i = 0; i < nrows; i++)
+    {
+      NcmVector *row = ncm_arena_matrix_get_row (m, i);
+
+      ncm_vector_memcpy (tmp, row);
+      res += ncm_vector_get (tmp, 0) + ncm_matrix_get (big, i, 999);
+    }
+  }
+  ncm_arena_pop ();
+
+  return res;
+}
+
+void
+test_ncm_arena_steady_state (void)
+{
+  NcmMatrix *m = ncm_matrix_new (200, 5);
+  NcmArenaStats stats;
+  gdouble res0;
+  guint i;
+
+  ncm_matrix_set_all (m, 1.0);
+
+  /* First run grows the arena. */
+  res0 = _test_ncm_arena_work (m);
+
+  ncm_arena_reset_stats ();
+  for (i = 0; i < 100; i++)
+  {
+    const gdouble res = _test_ncm_arena_work (m);
+    g_assert_cmpfloat (res, ==, res0);
+  }
+  ncm_arena_get_stats (&stats);
+
+  g_assert_cmpuint (stats.nheap_allocs, ==, 0);
+  g_assert_cmpuint (stats.nvectors, ==, 100 * 201);
+  g_assert_cmpuint (stats.nmatrices, ==, 100);
+  g_assert_cmpuint (stats.bytes_used, ==, 0);
+  g_assert_cmpuint (stats.bytes_peak, >=, 200 * 1000 * sizeof (gdouble));
+  g_assert_cmpuint (stats.bytes_reserved, >=, stats.bytes_peak);
+
+  ncm_arena_trim ();
+  ncm_arena_get_stats (&stats);
+  g_assert_cmpuint (stats.bytes_reserved, ==, 0);
+
+  ncm_matrix_free (m);
+}
+
+void
+test_ncm_arena_traps (void)
+{
+#if GLIB_CHECK_VERSION(2,38,0)
+  g_test_trap_subprocess ("/ncm/arena/invalid/no_scope/subprocess", 0, 0);
+  g_test_trap_assert_failed ();
+#endif
+}
+
+void
+test_ncm_arena_invalid_no_scope (void)
+{
+  NcmVector *v = ncm_arena_vector_new (10);
+  ncm_vector_set_all (v, 1.0);
+}
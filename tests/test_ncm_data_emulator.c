@@ -0,0 +1,279 @@
+/***************************************************************************
+ *            test_ncm_data_emulator.c
+ *
+ *  Mon October 19 02:18:09 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+
+#include "ncm_model_mvnd_test.h"
+
+#define TEST_NCM_DATA_EMULATOR_DIM 2
+#define TEST_NCM_DATA_EMULATOR_BOX 3.0
+
+typedef struct _TestNcmDataEmulator
+{
+  NcmData *data;
+  NcmDataEmulator *emu;
+  NcmMSet *mset;
+  NcmRNG *rng;
+} TestNcmDataEmulator;
+
+void test_ncm_data_emulator_new (TestNcmDataEmulator *test, gconstpointer pdata);
+void test_ncm_data_emulator_free (TestNcmDataEmulator *test, gconstpointer pdata);
+
+void test_ncm_data_emulator_accuracy (TestNcmDataEmulator *test, gconstpointer pdata);
+void test_ncm_data_emulator_fallback (TestNcmDataEmulator *test, gconstpointer pdata);
+void test_ncm_data_emulator_checks (TestNcmDataEmulator *test, gconstpointer pdata);
+void test_ncm_data_emulator_pred_sd (TestNcmDataEmulator *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add ("/ncm/data/emulator/accuracy", TestNcmDataEmulator, NULL,
+              &test_ncm_data_emulator_new,
+              &test_ncm_data_emulator_accuracy,
+              &test_ncm_data_emulator_free);
+
+  g_test_add ("/ncm/data/emulator/fallback", TestNcmDataEmulator, NULL,
+              &test_ncm_data_emulator_new,
+              &test_ncm_data_emulator_fallback,
+              &test_ncm_data_emulator_free);
+
+  g_test_add ("/ncm/data/emulator/checks", TestNcmDataEmulator, NULL,
+              &test_ncm_data_emulator_new,
+              &test_ncm_data_emulator_checks,
+              &test_ncm_data_emulator_free);
+
+  g_test_add ("/ncm/data/emulator/pred_sd", TestNcmDataEmulator, NULL,
+              &test_ncm_data_emulator_new,
+              &test_ncm_data_emulator_pred_sd,
+              &test_ncm_data_emulator_free);
+
+  g_test_run ();
+}
+
+void
+test_ncm_data_emulator_new (TestNcmDataEmulator *test, gconstpointer pdata)
+{
+  test->data = ncm_data_gauss_cov_mvnd_test_new (TEST_NCM_DATA_EMULATOR_DIM, 1.0, 0.3);
+  test->emu  = ncm_data_emulator_new (test->data, 0.0);
+  test->mset = ncm_data_gauss_cov_mvnd_test_mset_new (test->data);
+  test->rng  = ncm_rng_seeded_new (NCM_RNG_PHILOX4X32_NAME, g_test_rand_int ());
+
+  /* Training in the calling thread makes the counters deterministic. */
+  ncm_data_emulator_set_background (test->emu, FALSE);
+
+  g_assert (NCM_IS_DATA_EMULATOR (test->emu));
+  g_assert (ncm_data_emulator_peek_data (test->emu) == test->data);
+}
+
+void
+test_ncm_data_emulator_free (TestNcmDataEmulator *test, gconstpointer pdata)
+{
+  NCM_TEST_FREE (ncm_data_free, NCM_DATA (test->emu));
+  NCM_TEST_FREE (ncm_data_free, test->data);
+  NCM_TEST_FREE (ncm_mset_free, test->mset);
+  ncm_rng_free (test->rng);
+}
+
+static void
+_test_ncm_data_emulator_set_point (TestNcmDataEmulator *test, const gdouble xl, const gdouble xu)
+{
+  guint i;
+
+  for (i = 0; i < TEST_NCM_DATA_EMULATOR_DIM; i++)
+    ncm_mset_fparam_set (test->mset, i, ncm_rng_uniform_gen (test->rng, xl, xu));
+}
+
+static void
+_test_ncm_data_emulator_fill (TestNcmDataEmulator *test, const guint n)
+{
+  guint i;
+
+  for (i = 0; i < n; i++)
+  {
+    gdouble m2lnL_emu, m2lnL;
+
+    _test_ncm_data_emulator_set_point (test, -TEST_NCM_DATA_EMULATOR_BOX, TEST_NCM_DATA_EMULATOR_BOX);
+
+    ncm_data_m2lnL_val (NCM_DATA (test->emu), test->mset, &m2lnL_emu);
+    ncm_data_m2lnL_val (test->data, test->mset, &m2lnL);
+
+    ncm_assert_cmpdouble (m2lnL_emu, ==, m2lnL);
+  }
+}
+
+void
+test_ncm_data_emulator_accuracy (TestNcmDataEmulator *test, gconstpointer pdata)
+{
+  const guint ntrain = 200;
+  const guint ntests = 100;
+  gdouble err_sum    = 0.0;
+  guint i;
+
+  ncm_data_emulator_set_min_train (test->emu, 50);
+  ncm_data_emulator_set_retrain (test->emu, 25);
+
+  /* With zero tolerance every call evaluates the data and trains. */
+  _test_ncm_data_emulator_fill (test, ntrain);
+
+  g_assert_cmpuint (ncm_data_emulator_get_ntrain (test->emu), ==, ntrain);
+  g_assert_cmpuint (ncm_data_emulator_get_nfit (test->emu), ==, 1 + (ntrain - 50) / 25);
+  ncm_assert_cmpdouble (ncm_data_emulator_get_hit_rate (test->emu), ==, 0.0);
+
+  for (i = 0; i < ntests; i++)
+  {
+    const gdouble box = 0.8 * TEST_NCM_DATA_EMULATOR_BOX;
+    gdouble m2lnL_emu, sd, m2lnL;
+
+    _test_ncm_data_emulator_set_point (test, -box, box);
+
+    g_assert (ncm_data_emulator_predict (test->emu, test->mset, &m2lnL_emu, &sd));
+    ncm_data_m2lnL_val (test->data, test->mset, &m2lnL);
+
+    g_assert_cmpfloat (sd, >=, 0.0);
+    g_assert_cmpfloat (fabs (m2lnL_emu - m2lnL), <, 0.5);
+    err_sum += fabs (m2lnL_emu - m2lnL);
+  }
+
+  g_assert_cmpfloat (err_sum / ntests, <, 5.0e-2);
+}
+
+void
+test_ncm_data_emulator_fallback (TestNcmDataEmulator *test, gconstpointer pdata)
+{
+  const guint ntrain = 100;
+  const gdouble tol  = 1.0e-2;
+  guint i;
+
+  ncm_data_emulator_set_min_train (test->emu, 50);
+  ncm_data_emulator_set_retrain (test->emu, 1000);
+
+  _test_ncm_data_emulator_fill (test, ntrain);
+  ncm_data_emulator_set_tol (test->emu, tol);
+
+  /* Far from the training set the surrogate is not trusted. */
+  for (i = 0; i < 10; i++)
+  {
+    gdouble m2lnL_emu, m2lnL, mu, sd;
+
+    _test_ncm_data_emulator_set_point (test, 2.0 * TEST_NCM_DATA_EMULATOR_BOX, 3.0 * TEST_NCM_DATA_EMULATOR_BOX);
+
+    g_assert (ncm_data_emulator_predict (test->emu, test->mset, &mu, &sd));
+    g_assert_cmpfloat (sd, >, tol);
+
+    ncm_data_m2lnL_val (NCM_DATA (test->emu), test->mset, &m2lnL_emu);
+    ncm_data_m2lnL_val (test->data, test->mset, &m2lnL);
+
+    ncm_assert_cmpdouble (m2lnL_emu, ==, m2lnL);
+    g_assert_cmpuint (ncm_data_emulator_get_ntrain (test->emu), ==, ntrain + i + 1);
+  }
+
+  ncm_assert_cmpdouble (ncm_data_emulator_get_hit_rate (test->emu), ==, 0.0);
+  g_assert_cmpuint (ncm_data_emulator_get_nfit (test->emu), ==, 1);
+  g_assert_cmpuint (ncm_data_emulator_get_ncheck (test->emu), ==, 0);
+}
+
+void
+test_ncm_data_emulator_checks (TestNcmDataEmulator *test, gconstpointer pdata)
+{
+  const guint min_train   = 20;
+  const guint retrain     = 10;
+  const guint check_every = 5;
+  const guint ncalls      = 100;
+  guint i;
+
+  ncm_data_emulator_set_min_train (test->emu, min_train);
+  ncm_data_emulator_set_retrain (test->emu, retrain);
+  ncm_data_emulator_set_check_every (test->emu, check_every);
+
+  /* Before the first fit there is no surrogate, every call trains. */
+  _test_ncm_data_emulator_fill (test, min_train);
+  g_assert_cmpuint (ncm_data_emulator_get_nfit (test->emu), ==, 1);
+  g_assert (gsl_isnan (ncm_data_emulator_get_mean_error (test->emu)));
+
+  /* Every prediction is accepted, one in check_every is checked. */
+  ncm_data_emulator_set_tol (test->emu, 1.0e10);
+  for (i = 0; i < ncalls; i++)
+  {
+    gdouble m2lnL_emu;
+
+    _test_ncm_data_emulator_set_point (test, -TEST_NCM_DATA_EMULATOR_BOX, TEST_NCM_DATA_EMULATOR_BOX);
+    ncm_data_m2lnL_val (NCM_DATA (test->emu), test->mset, &m2lnL_emu);
+
+    g_assert (gsl_finite (m2lnL_emu));
+  }
+
+  /* Each check adds a training point and every retrain points refit. */
+  g_assert_cmpuint (ncm_data_emulator_get_ncheck (test->emu), ==, ncalls / check_every);
+  g_assert_cmpuint (ncm_data_emulator_get_ntrain (test->emu), ==, min_train + ncalls / check_every);
+  g_assert_cmpuint (ncm_data_emulator_get_nfit (test->emu), ==, 1 + (ncalls / check_every) / retrain);
+
+  ncm_assert_cmpdouble_e (ncm_data_emulator_get_hit_rate (test->emu), ==,
+                          (ncalls - ncalls / check_every) * 1.0 / (min_train + ncalls), 1.0e-15, 0.0);
+
+  g_assert (gsl_finite (ncm_data_emulator_get_mean_error (test->emu)));
+  g_assert_cmpfloat (ncm_data_emulator_get_max_error (test->emu), >=, ncm_data_emulator_get_mean_error (test->emu));
+
+  /* Reset removes the training set and the counters. */
+  ncm_data_emulator_reset (test->emu);
+  g_assert_cmpuint (ncm_data_emulator_get_ntrain (test->emu), ==, 0);
+  g_assert_cmpuint (ncm_data_emulator_get_nfit (test->emu), ==, 0);
+  g_assert_cmpuint (ncm_data_emulator_get_ncheck (test->emu), ==, 0);
+}
+
+void
+test_ncm_data_emulator_pred_sd (TestNcmDataEmulator *test, gconstpointer pdata)
+{
+  NcmMSetFunc *pred_sd = NCM_MSET_FUNC (ncm_mset_func_list_new ("NcmDataEmulator:pred_sd", G_OBJECT (test->emu)));
+  NcmMSetFunc *trained = NCM_MSET_FUNC (ncm_mset_func_list_new ("NcmDataEmulator:trained", G_OBJECT (test->emu)));
+
+  ncm_data_emulator_set_min_train (test->emu, 50);
+  ncm_data_emulator_set_retrain (test->emu, 25);
+
+  /* Before the first surrogate the values must be finite (zero). */
+  _test_ncm_data_emulator_fill (test, 10);
+  g_assert_cmpuint (ncm_data_emulator_get_nfit (test->emu), ==, 0);
+  ncm_assert_cmpdouble (ncm_mset_func_eval0 (pred_sd, test->mset), ==, 0.0);
+  ncm_assert_cmpdouble (ncm_mset_func_eval0 (trained, test->mset), ==, 0.0);
+
+  _test_ncm_data_emulator_fill (test, 50);
+  g_assert_cmpuint (ncm_data_emulator_get_nfit (test->emu), ==, 1);
+  g_assert (gsl_finite (ncm_mset_func_eval0 (pred_sd, test->mset)));
+  g_assert_cmpfloat (ncm_mset_func_eval0 (pred_sd, test->mset), >=, 0.0);
+  ncm_assert_cmpdouble (ncm_mset_func_eval0 (trained, test->mset), ==, 1.0);
+
+  NCM_TEST_FREE (ncm_mset_func_free, pred_sd);
+  NCM_TEST_FREE (ncm_mset_func_free, trained);
+}
@@ -31,6 +31,7 @@
 #include <gsl/gsl_statistics_double.h>
 
 #include "ncm_data_gauss_cov_test.h"
+#include "ncm_model_mvnd_test.h"
 
 typedef struct _TestNcmDataGaussCovTest
 {
@@ -42,6 +43,9 @@ void test_ncm_data_gauss_cov_test_new (TestNcmDataGaussCovTest *test, gconstpoin
 void test_ncm_data_gauss_cov_test_free (TestNcmDataGaussCovTest *test, gconstpointer pdata);
 void test_ncm_data_gauss_cov_test_sanity (TestNcmDataGaussCovTest *test, gconstpointer pdata);
 void test_ncm_data_gauss_cov_test_resample (TestNcmDataGaussCovTest *test, gconstpointer pdata);
+void test_ncm_data_gauss_cov_test_m2lnL_batch (TestNcmDataGaussCovTest *test, gconstpointer pdata);
+void test_ncm_data_gauss_cov_test_blocks (TestNcmDataGaussCovTest *test, gconstpointer pdata);
+void test_ncm_data_gauss_cov_mvnd_m2lnL_val_batch (TestNcmDataGaussCovTest *test, gconstpointer pdata);
 
 gint
 main (gint argc, gchar *argv[])
@@ -60,6 +64,21 @@ main (gint argc, gchar *argv[])
               &test_ncm_data_gauss_cov_test_resample,
               &test_ncm_data_gauss_cov_test_free);
 
+  g_test_add ("/ncm/data_gauss_cov_test/m2lnL_batch", TestNcmDataGaussCovTest, NULL,
+              &test_ncm_data_gauss_cov_test_new,
+              &test_ncm_data_gauss_cov_test_m2lnL_batch,
+              &test_ncm_data_gauss_cov_test_free);
+
+  g_test_add ("/ncm/data_gauss_cov_test/blocks", TestNcmDataGaussCovTest, NULL,
+              &test_ncm_data_gauss_cov_test_new,
+              &test_ncm_data_gauss_cov_test_blocks,
+              &test_ncm_data_gauss_cov_test_free);
+
+  g_test_add ("/ncm/data_gauss_cov_mvnd/m2lnL_val_batch", TestNcmDataGaussCovTest, NULL,
+              &test_ncm_data_gauss_cov_test_new,
+              &test_ncm_data_gauss_cov_mvnd_m2lnL_val_batch,
+              &test_ncm_data_gauss_cov_test_free);
+
   g_test_run ();
 }
 
@@ -160,3 +179,162 @@ test_ncm_data_gauss_cov_test_resample (TestNcmDataGaussCovTest *test, gconstpoin
   ncm_stats_vec_clear (&stat);
   ncm_vector_clear (&mean);
 }
+
+void
+test_ncm_data_gauss_cov_test_m2lnL_batch (TestNcmDataGaussCovTest *test, gconstpointer pdata)
+{
+  NcmDataGaussCov *gauss = NCM_DATA_GAUSS_COV (test->data);
+  const guint nmu        = g_test_rand_int_range (2, 10);
+  NcmMatrix *mu          = ncm_matrix_new (nmu, gauss->np);
+  NcmVector *m2lnL       = ncm_vector_new (nmu);
+  NcmVector *a_k         = ncm_vector_new (nmu);
+  const gdouble a0       = test->gcov_test->a;
+  guint k;
+
+  g_object_set (test->data, "use-norma", TRUE, NULL);
+
+  for (k = 0; k < nmu; k++)
+  {
+    NcmVector *mu_k = ncm_matrix_get_row (mu, k);
+
+    test->gcov_test->a = a0 * (1.0 + g_test_rand_double_range (-1.0e-3, 1.0e-3));
+    ncm_vector_set (a_k, k, test->gcov_test->a);
+    ncm_data_gauss_cov_test_mean_func (gauss, NULL, mu_k);
+    ncm_vector_free (mu_k);
+  }
+
+  ncm_data_gauss_cov_m2lnL_val_batch (gauss, NULL, mu, m2lnL);
+
+  for (k = 0; k < nmu; k++)
+  {
+    gdouble m2lnL_k;
+
+    test->gcov_test->a = ncm_vector_get (a_k, k);
+    ncm_data_m2lnL_val (test->data, NULL, &m2lnL_k);
+
+    ncm_assert_cmpdouble_e (ncm_vector_get (m2lnL, k), ==, m2lnL_k, 1.0e-10, 0.0);
+  }
+
+  test->gcov_test->a = a0;
+
+  ncm_matrix_free (mu);
+  ncm_vector_free (m2lnL);
+  ncm_vector_free (a_k);
+}
+
+void
+test_ncm_data_gauss_cov_test_blocks (TestNcmDataGaussCovTest *test, gconstpointer pdata)
+{
+  NcmDataGaussCov *gauss = NCM_DATA_GAUSS_COV (test->data);
+  const guint b1         = g_test_rand_int_range (1, gauss->np - 1);
+  gdouble m2lnL_dense, m2lnL_blocks;
+  guint i, j;
+
+  for (i = 0; i < b1; i++)
+  {
+    for (j = b1; j < gauss->np; j++)
+    {
+      ncm_matrix_set (gauss->cov, i, j, 0.0);
+      ncm_matrix_set (gauss->cov, j, i, 0.0);
+    }
+  }
+
+  g_object_set (test->data, "use-norma", TRUE, NULL);
+  test->gcov_test->a *= 1.0 + 1.0e-3;
+
+  ncm_data_gauss_cov_set_blocks (gauss, NULL);
+  ncm_data_m2lnL_val (test->data, NULL, &m2lnL_dense);
+
+  g_assert_cmpuint (ncm_data_gauss_cov_detect_blocks (gauss), >=, 2);
+  g_assert (ncm_data_gauss_cov_peek_blocks (gauss) != NULL);
+  ncm_data_m2lnL_val (test->data, NULL, &m2lnL_blocks);
+
+  ncm_assert_cmpdouble_e (m2lnL_blocks, ==, m2lnL_dense, 1.0e-10, 0.0);
+}
+
+static void
+_test_ncm_data_gauss_cov_assert_batch (NcmData *data, NcmMSet *mset, NcmMatrix *fparams)
+{
+  const guint npoints     = ncm_matrix_nrows (fparams);
+  const guint fparams_len = ncm_mset_fparams_len (mset);
+  NcmVector *fparams0     = ncm_vector_new (fparams_len);
+  NcmVector *m2lnL_v      = ncm_vector_new (npoints);
+  guint a, i;
+
+  ncm_mset_fparams_get_vector (mset, fparams0);
+
+  g_assert (ncm_data_has_m2lnL_val_batch (data));
+  ncm_data_m2lnL_val_batch (data, mset, fparams, m2lnL_v);
+
+  for (i = 0; i < fparams_len; i++)
+    ncm_assert_cmpdouble (ncm_mset_fparam_get (mset, i), ==, ncm_vector_get (fparams0, i));
+
+  for (a = 0; a < npoints; a++)
+  {
+    NcmVector *fparams_a = ncm_matrix_get_row (fparams, a);
+    gdouble m2lnL_a;
+
+    ncm_mset_fparams_set_vector (mset, fparams_a);
+    ncm_data_m2lnL_val (data, mset, &m2lnL_a);
+
+    ncm_assert_cmpdouble_e (ncm_vector_get (m2lnL_v, a), ==, m2lnL_a, 1.0e-12, 0.0);
+
+    ncm_vector_free (fparams_a);
+  }
+
+  ncm_mset_fparams_set_vector (mset, fparams0);
+
+  ncm_vector_free (fparams0);
+  ncm_vector_free (m2lnL_v);
+}
+
+void
+test_ncm_data_gauss_cov_mvnd_m2lnL_val_batch (TestNcmDataGaussCovTest *test, gconstpointer pdata)
+{
+  const guint dim        = g_test_rand_int_range (4, 10);
+  const guint npoints    = g_test_rand_int_range (5, 50);
+  NcmData *data          = ncm_data_gauss_cov_mvnd_test_new (dim, 1.5, 0.4);
+  NcmDataGaussCov *gauss = NCM_DATA_GAUSS_COV (data);
+  NcmMSet *mset          = ncm_data_gauss_cov_mvnd_test_mset_new (data);
+  NcmMatrix *fparams     = ncm_matrix_new (npoints, ncm_mset_fparams_len (mset));
+  NcmRNG *rng            = ncm_rng_seeded_new (NULL, g_test_rand_int ());
+  const guint b1         = g_test_rand_int_range (1, dim - 1);
+  guint a, i, j;
+
+  for (a = 0; a < npoints; a++)
+  {
+    for (i = 0; i < ncm_matrix_ncols (fparams); i++)
+      ncm_matrix_set (fparams, a, i, g_test_rand_double_range (-3.0, 3.0));
+  }
+
+  /* Dense covariance, with and without bootstrap. */
+  _test_ncm_data_gauss_cov_assert_batch (data, mset, fparams);
+
+  ncm_data_bootstrap_create (data);
+  ncm_data_bootstrap_resample (data, rng);
+  _test_ncm_data_gauss_cov_assert_batch (data, mset, fparams);
+  ncm_data_bootstrap_remove (data);
+
+  /* Block-diagonal covariance, with and without bootstrap. */
+  for (i = 0; i < b1; i++)
+  {
+    for (j = b1; j < dim; j++)
+    {
+      ncm_matrix_set (gauss->cov, i, j, 0.0);
+      ncm_matrix_set (gauss->cov, j, i, 0.0);
+    }
+  }
+
+  g_assert_cmpuint (ncm_data_gauss_cov_detect_blocks (gauss), >=, 2);
+  _test_ncm_data_gauss_cov_assert_batch (data, mset, fparams);
+
+  ncm_data_bootstrap_create (data);
+  ncm_data_bootstrap_resample (data, rng);
+  _test_ncm_data_gauss_cov_assert_batch (data, mset, fparams);
+  ncm_data_bootstrap_remove (data);
+
+  ncm_rng_free (rng);
+  ncm_matrix_free (fparams);
+  NCM_TEST_FREE (ncm_mset_free, mset);
+  NCM_TEST_FREE (ncm_data_free, data);
+}
@@ -0,0 +1,385 @@
+/***************************************************************************
+ *            test_ncm_fit.c
+ *
+ *  Sun October 18 22:58:41 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+
+#include "ncm_model_mvnd_test.h"
+
+#define TEST_NCM_FIT_BATCH_NPOINTS 57
+#define TEST_NCM_FIT_NTHREADS      4
+
+typedef struct _TestNcmFit
+{
+  NcmData *data_cov;
+  NcmData *data_diag;
+  NcmMSet *mset;
+  NcmFit *fit_cov;
+  NcmFit *fit_mixed;
+  NcmMatrix *fparams;
+  NcmVector *p0;
+} TestNcmFit;
+
+void test_ncm_fit_new (TestNcmFit *test, gconstpointer pdata);
+void test_ncm_fit_free (TestNcmFit *test, gconstpointer pdata);
+
+void test_ncm_fit_m2lnL_val_batch_vectorised (TestNcmFit *test, gconstpointer pdata);
+void test_ncm_fit_m2lnL_val_batch_mixed (TestNcmFit *test, gconstpointer pdata);
+void test_ncm_fit_m2lnL_val_batch_threaded (TestNcmFit *test, gconstpointer pdata);
+void test_ncm_fit_clone_shared (TestNcmFit *test, gconstpointer pdata);
+void test_ncm_fit_clone_shared_loaded (TestNcmFit *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add ("/ncm/fit/m2lnL_val_batch/vectorised", TestNcmFit, NULL,
+              &test_ncm_fit_new,
+              &test_ncm_fit_m2lnL_val_batch_vectorised,
+              &test_ncm_fit_free);
+
+  g_test_add ("/ncm/fit/m2lnL_val_batch/mixed", TestNcmFit, NULL,
+              &test_ncm_fit_new,
+              &test_ncm_fit_m2lnL_val_batch_mixed,
+              &test_ncm_fit_free);
+
+  g_test_add ("/ncm/fit/m2lnL_val_batch/threaded", TestNcmFit, NULL,
+              &test_ncm_fit_new,
+              &test_ncm_fit_m2lnL_val_batch_threaded,
+              &test_ncm_fit_free);
+
+  g_test_add ("/ncm/fit/clone/shared", TestNcmFit, NULL,
+              &test_ncm_fit_new,
+              &test_ncm_fit_clone_shared,
+              &test_ncm_fit_free);
+
+  g_test_add ("/ncm/fit/clone/shared/loaded", TestNcmFit, NULL,
+              &test_ncm_fit_new,
+              &test_ncm_fit_clone_shared_loaded,
+              &test_ncm_fit_free);
+
+  g_test_run ();
+}
+
+void
+test_ncm_fit_new (TestNcmFit *test, gconstpointer pdata)
+{
+  const guint dim = g_test_rand_int_range (2, 6);
+  NcmDataset *dset;
+  NcmLikelihood *lh;
+  guint a, i;
+
+  test->data_cov  = ncm_data_gauss_cov_mvnd_test_new (dim, 1.0, 0.3);
+  test->data_diag = ncm_data_gauss_diag_mvnd_test_new (dim, 2.0);
+  test->mset      = ncm_data_gauss_cov_mvnd_test_mset_new (test->data_cov);
+  test->fit_cov   = ncm_data_gauss_cov_mvnd_test_fit_new (test->data_cov, test->mset);
+
+  /* A non-vectorised data, a vectorised one and a prior. */
+  dset = ncm_dataset_new ();
+  ncm_dataset_append_data (dset, test->data_diag);
+  ncm_dataset_append_data (dset, test->data_cov);
+  lh = ncm_likelihood_new (dset);
+  {
+    NcmModel *mvnd = ncm_mset_peek (test->mset, ncm_model_mvnd_test_id ());
+    ncm_likelihood_priors_add_gauss_param (lh, ncm_model_mvnd_test_id (), ncm_model_vparam_index (mvnd, NCM_MODEL_MVND_TEST_MU, 0), 0.5, 1.5);
+  }
+
+  test->fit_mixed = ncm_fit_new (NCM_FIT_TYPE_GSL_MMS, NULL, lh, test->mset, NCM_FIT_GRAD_NUMDIFF_FORWARD);
+
+  ncm_likelihood_free (lh);
+  ncm_dataset_free (dset);
+
+  test->fparams = ncm_matrix_new (TEST_NCM_FIT_BATCH_NPOINTS, ncm_mset_fparams_len (test->mset));
+  test->p0      = ncm_vector_new (ncm_mset_fparams_len (test->mset));
+
+  for (a = 0; a < TEST_NCM_FIT_BATCH_NPOINTS; a++)
+  {
+    for (i = 0; i < ncm_matrix_ncols (test->fparams); i++)
+      ncm_matrix_set (test->fparams, a, i, g_test_rand_double_range (-3.0, 3.0));
+  }
+
+  for (i = 0; i < ncm_vector_len (test->p0); i++)
+    ncm_vector_set (test->p0, i, g_test_rand_double_range (-1.0, 1.0));
+  ncm_mset_fparams_set_vector (test->mset, test->p0);
+}
+
+void
+test_ncm_fit_free (TestNcmFit *test, gconstpointer pdata)
+{
+  NCM_TEST_FREE (ncm_fit_free, test->fit_mixed);
+  NCM_TEST_FREE (ncm_fit_free, test->fit_cov);
+  NCM_TEST_FREE (ncm_mset_free, test->mset);
+  NCM_TEST_FREE (ncm_data_free, test->data_diag);
+  NCM_TEST_FREE (ncm_data_free, test->data_cov);
+  ncm_matrix_free (test->fparams);
+  ncm_vector_free (test->p0);
+}
+
+static void
+_test_ncm_fit_assert_mset (TestNcmFit *test)
+{
+  guint i;
+
+  for (i = 0; i < ncm_vector_len (test->p0); i++)
+    ncm_assert_cmpdouble (ncm_mset_fparam_get (test->mset, i), ==, ncm_vector_get (test->p0, i));
+}
+
+/*
+ * Compares the batched values with ncm_fit_m2lnL_val() point by point.
+ */
+static void
+_test_ncm_fit_assert_batch (TestNcmFit *test, NcmFit *fit, NcmVector *m2lnL_v, gdouble reltol)
+{
+  guint a;
+
+  for (a = 0; a < TEST_NCM_FIT_BATCH_NPOINTS; a++)
+  {
+    NcmVector *fparams_a = ncm_matrix_get_row (test->fparams, a);
+    gdouble m2lnL_a;
+
+    ncm_mset_fparams_set_vector (test->mset, fparams_a);
+    ncm_fit_m2lnL_val (fit, &m2lnL_a);
+
+    ncm_assert_cmpdouble_e (ncm_vector_get (m2lnL_v, a), ==, m2lnL_a, reltol, 0.0);
+
+    ncm_vector_free (fparams_a);
+  }
+
+  ncm_mset_fparams_set_vector (test->mset, test->p0);
+}
+
+void
+test_ncm_fit_m2lnL_val_batch_vectorised (TestNcmFit *test, gconstpointer pdata)
+{
+  NcmVector *m2lnL_v = ncm_vector_new (TEST_NCM_FIT_BATCH_NPOINTS);
+
+  g_assert (ncm_dataset_has_m2lnL_val_batch (test->fit_cov->lh->dset));
+
+  ncm_fit_m2lnL_val_batch (test->fit_cov, test->fparams, m2lnL_v);
+  _test_ncm_fit_assert_mset (test);
+  _test_ncm_fit_assert_batch (test, test->fit_cov, m2lnL_v, 1.0e-12);
+
+  ncm_vector_free (m2lnL_v);
+}
+
+void
+test_ncm_fit_m2lnL_val_batch_mixed (TestNcmFit *test, gconstpointer pdata)
+{
+  NcmDataset *dset        = test->fit_mixed->lh->dset;
+  NcmVector *m2lnL_v      = ncm_vector_new (TEST_NCM_FIT_BATCH_NPOINTS);
+  NcmVector *dset_m2lnL_v = ncm_vector_new (TEST_NCM_FIT_BATCH_NPOINTS);
+  guint a;
+
+  g_assert (!ncm_data_has_m2lnL_val_batch (test->data_diag));
+  g_assert (ncm_data_has_m2lnL_val_batch (test->data_cov));
+  g_assert (!ncm_dataset_has_m2lnL_val_batch (dset));
+
+  /* Dataset level: the vectorised and the looped data are summed per point. */
+  ncm_dataset_m2lnL_val_batch (dset, test->mset, test->fparams, dset_m2lnL_v);
+  _test_ncm_fit_assert_mset (test);
+
+  for (a = 0; a < TEST_NCM_FIT_BATCH_NPOINTS; a++)
+  {
+    NcmVector *fparams_a = ncm_matrix_get_row (test->fparams, a);
+    gdouble m2lnL_a;
+
+    ncm_mset_fparams_set_vector (test->mset, fparams_a);
+    ncm_dataset_m2lnL_val (dset, test->mset, &m2lnL_a);
+
+    ncm_assert_cmpdouble_e (ncm_vector_get (dset_m2lnL_v, a), ==, m2lnL_a, 1.0e-12, 0.0);
+
+    ncm_vector_free (fparams_a);
+  }
+  ncm_mset_fparams_set_vector (test->mset, test->p0);
+
+  /* Likelihood level, including the prior, in a single thread. */
+  ncm_likelihood_m2lnL_val_batch (test->fit_mixed->lh, test->mset, test->fparams, m2lnL_v);
+  _test_ncm_fit_assert_mset (test);
+  _test_ncm_fit_assert_batch (test, test->fit_mixed, m2lnL_v, 1.0e-12);
+
+  ncm_vector_free (m2lnL_v);
+  ncm_vector_free (dset_m2lnL_v);
+}
+
+void
+test_ncm_fit_m2lnL_val_batch_threaded (TestNcmFit *test, gconstpointer pdata)
+{
+  const gint max_threads = g_thread_pool_get_max_threads (ncm_func_eval_get_pool ());
+  NcmVector *m2lnL_v     = ncm_vector_new (TEST_NCM_FIT_BATCH_NPOINTS);
+  NcmVector *m2lnL_mt_v  = ncm_vector_new (TEST_NCM_FIT_BATCH_NPOINTS);
+  guint func_eval;
+  guint a;
+
+  ncm_func_eval_set_max_threads (1);
+  ncm_fit_m2lnL_val_batch (test->fit_mixed, test->fparams, m2lnL_v);
+  _test_ncm_fit_assert_mset (test);
+
+  /* The points are split among duplicates of the fit. */
+  ncm_func_eval_set_max_threads (TEST_NCM_FIT_NTHREADS);
+  g_assert_cmpuint (TEST_NCM_FIT_BATCH_NPOINTS, >, 2 * TEST_NCM_FIT_NTHREADS);
+
+  func_eval = test->fit_mixed->fstate->func_eval;
+  ncm_fit_m2lnL_val_batch (test->fit_mixed, test->fparams, m2lnL_mt_v);
+  g_assert_cmpuint (test->fit_mixed->fstate->func_eval, ==, func_eval + TEST_NCM_FIT_BATCH_NPOINTS);
+  _test_ncm_fit_assert_mset (test);
+
+  for (a = 0; a < TEST_NCM_FIT_BATCH_NPOINTS; a++)
+    ncm_assert_cmpdouble (ncm_vector_get (m2lnL_mt_v, a), ==, ncm_vector_get (m2lnL_v, a));
+
+  _test_ncm_fit_assert_batch (test, test->fit_mixed, m2lnL_mt_v, 1.0e-12);
+
+  ncm_func_eval_set_max_threads (max_threads);
+
+  ncm_vector_free (m2lnL_v);
+  ncm_vector_free (m2lnL_mt_v);
+}
+
+void
+test_ncm_fit_clone_shared (TestNcmFit *test, gconstpointer pdata)
+{
+  NcmDataGaussCov *gauss = NCM_DATA_GAUSS_COV (test->data_cov);
+  NcmSerialize *ser      = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+  NcmRNG *rng            = ncm_rng_seeded_new (NULL, g_test_rand_int ());
+  NcmVector *y0          = ncm_vector_dup (gauss->y);
+  guint i, j;
+
+  ncm_data_gauss_cov_set_readonly (gauss);
+  g_assert (ncm_vector_is_readonly (gauss->y));
+  g_assert (ncm_matrix_is_readonly (gauss->cov));
+
+  for (i = 0; i < 2; i++)
+  {
+    gdouble clone_time = -1.0;
+    gsize clone_size   = 0;
+    NcmFit *fit_clone  = ncm_fit_clone (test->fit_cov, ser, &clone_time, &clone_size);
+    NcmDataGaussCov *gauss_clone = NCM_DATA_GAUSS_COV (ncm_dataset_peek_data (fit_clone->lh->dset, 0));
+    gdouble m2lnL, m2lnL_clone;
+
+    ncm_serialize_reset (ser, TRUE);
+
+    g_assert_cmpfloat (clone_time, >=, 0.0);
+    g_assert_cmpuint (clone_size, >, 0);
+    g_assert (gauss_clone != gauss);
+    g_assert (fit_clone->mset != test->mset);
+
+    /* The payloads are shared, the workspaces are not. */
+    g_assert (gauss_clone->y == gauss->y);
+    g_assert (gauss_clone->cov == gauss->cov);
+    g_assert (gauss_clone->v != gauss->v);
+
+    ncm_fit_m2lnL_val (test->fit_cov, &m2lnL);
+    ncm_fit_m2lnL_val (fit_clone, &m2lnL_clone);
+    ncm_assert_cmpdouble (m2lnL_clone, ==, m2lnL);
+
+    g_assert (gauss_clone->LLT != NULL);
+    g_assert (gauss_clone->LLT != gauss->LLT);
+
+    /* Resampling a clone does not write on the shared values. */
+    ncm_data_resample (NCM_DATA (gauss_clone), fit_clone->mset, rng);
+    g_assert (gauss_clone->y != gauss->y);
+    g_assert (!ncm_vector_is_readonly (gauss_clone->y));
+    g_assert (gauss_clone->cov == gauss->cov);
+
+    for (j = 0; j < ncm_vector_len (y0); j++)
+      ncm_assert_cmpdouble (ncm_vector_get (gauss->y, j), ==, ncm_vector_get (y0, j));
+
+    ncm_fit_free (fit_clone);
+  }
+
+  /* Without the read-only mark the vector is copied. */
+  ncm_serialize_reset (ser, FALSE);
+  ncm_vector_set_readonly (gauss->y, FALSE);
+  {
+    NcmFit *fit_clone = ncm_fit_clone (test->fit_cov, ser, NULL, NULL);
+    NcmDataGaussCov *gauss_clone = NCM_DATA_GAUSS_COV (ncm_dataset_peek_data (fit_clone->lh->dset, 0));
+
+    g_assert (gauss_clone->y != gauss->y);
+    g_assert (gauss_clone->cov == gauss->cov);
+
+    ncm_fit_free (fit_clone);
+  }
+
+  ncm_vector_free (y0);
+  ncm_rng_free (rng);
+  ncm_serialize_free (ser);
+}
+
+/*
+ * The data loaded from the catalogs is marked read-only by the data class.
+ */
+void
+test_ncm_fit_clone_shared_loaded (TestNcmFit *test, gconstpointer pdata)
+{
+  NcDistance *dist    = nc_distance_new (2.0);
+  NcDataBaoRDV *rdv   = nc_data_bao_rdv_new_from_id (dist, NC_DATA_BAO_RDV_PERCIVAL2010);
+  NcmDataGauss *gauss = NCM_DATA_GAUSS (rdv);
+  NcHICosmo *cosmo    = nc_hicosmo_new_from_name (NC_TYPE_HICOSMO, "NcHICosmoDEXcdm");
+  NcmMSet *mset       = ncm_mset_new (cosmo, NULL);
+  NcmDataset *dset    = ncm_dataset_new ();
+  NcmSerialize *ser   = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+  NcmLikelihood *lh;
+  NcmFit *fit, *fit_clone;
+  NcDataBaoRDV *rdv_clone;
+  gdouble m2lnL, m2lnL_clone;
+
+  g_assert (ncm_vector_is_readonly (gauss->y));
+  g_assert (ncm_matrix_is_readonly (gauss->inv_cov));
+  g_assert (ncm_vector_is_readonly (rdv->x));
+
+  ncm_dataset_append_data (dset, NCM_DATA (rdv));
+  lh  = ncm_likelihood_new (dset);
+  fit = ncm_fit_new (NCM_FIT_TYPE_GSL_MMS, NULL, lh, mset, NCM_FIT_GRAD_NUMDIFF_FORWARD);
+
+  fit_clone = ncm_fit_clone (fit, ser, NULL, NULL);
+  rdv_clone = NC_DATA_BAO_RDV (ncm_dataset_peek_data (fit_clone->lh->dset, 0));
+
+  g_assert (rdv_clone != rdv);
+  g_assert (NCM_DATA_GAUSS (rdv_clone)->y == gauss->y);
+  g_assert (NCM_DATA_GAUSS (rdv_clone)->inv_cov == gauss->inv_cov);
+  g_assert (rdv_clone->x == rdv->x);
+
+  ncm_fit_m2lnL_val (fit, &m2lnL);
+  ncm_fit_m2lnL_val (fit_clone, &m2lnL_clone);
+  ncm_assert_cmpdouble (m2lnL_clone, ==, m2lnL);
+
+  ncm_fit_free (fit_clone);
+  ncm_serialize_free (ser);
+  ncm_fit_free (fit);
+  ncm_likelihood_free (lh);
+  ncm_dataset_free (dset);
+  ncm_mset_free (mset);
+  nc_hicosmo_free (cosmo);
+  ncm_data_free (NCM_DATA (rdv));
+  nc_distance_free (dist);
+}
@@ -0,0 +1,189 @@
+/***************************************************************************
+ *            test_ncm_fit_esmcmc.c
+ *
+ *  Sun October 18 23:20:31 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+
+#include "ncm_model_mvnd_test.h"
+
+#define TEST_NCM_FIT_ESMCMC_NWALKERS 20
+#define TEST_NCM_FIT_ESMCMC_NRUNS 15
+
+typedef struct _TestNcmFitESMCMC
+{
+  NcHICosmo *cosmo;
+  NcDistance *dist;
+  NcmMSet *mset;
+  NcmFit *fit;
+  NcmMSetTransKern *prior;
+  NcmVector *p0;
+  gulong seed;
+} TestNcmFitESMCMC;
+
+void test_ncm_fit_esmcmc_new (TestNcmFitESMCMC *test, gconstpointer pdata);
+void test_ncm_fit_esmcmc_free (TestNcmFitESMCMC *test, gconstpointer pdata);
+
+void test_ncm_fit_esmcmc_nprocs (TestNcmFitESMCMC *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  /* Use the worker program of this build. */
+  {
+    gchar *worker_path = g_build_filename (PACKAGE_BUILD_DIR, "tools", "esmcmc_worker", NULL);
+
+    g_setenv (NCM_FIT_ESMCMC_WORKER_ENV, worker_path, TRUE);
+    g_free (worker_path);
+  }
+
+  g_test_add ("/ncm/fit/esmcmc/nprocs", TestNcmFitESMCMC, NULL,
+              &test_ncm_fit_esmcmc_new,
+              &test_ncm_fit_esmcmc_nprocs,
+              &test_ncm_fit_esmcmc_free);
+
+  g_test_run ();
+}
+
+void
+test_ncm_fit_esmcmc_new (TestNcmFitESMCMC *test, gconstpointer pdata)
+{
+  NcmDataset *dset = ncm_dataset_new ();
+  NcmLikelihood *lh;
+
+  /* The workers rebuild the fit from its serialization, only library types can be used. */
+  test->cosmo = nc_hicosmo_new_from_name (NC_TYPE_HICOSMO, "NcHICosmoDEXcdm");
+  test->dist  = nc_distance_new (2.0);
+  test->mset  = ncm_mset_new (test->cosmo, NULL);
+
+  ncm_model_param_set_ftype (NCM_MODEL (test->cosmo), NC_HICOSMO_DE_OMEGA_C, NCM_PARAM_TYPE_FREE);
+  ncm_model_param_set_ftype (NCM_MODEL (test->cosmo), NC_HICOSMO_DE_OMEGA_X, NCM_PARAM_TYPE_FREE);
+  ncm_model_param_set_ftype (NCM_MODEL (test->cosmo), NC_HICOSMO_DE_XCDM_W,  NCM_PARAM_TYPE_FREE);
+  ncm_mset_prepare_fparam_map (test->mset);
+
+  {
+    NcmData *bao = nc_data_bao_create (test->dist, NC_DATA_BAO_RDV_PERCIVAL2010);
+
+    ncm_dataset_append_data (dset, bao);
+    ncm_data_free (bao);
+  }
+
+  lh        = ncm_likelihood_new (dset);
+  test->fit = ncm_fit_new (NCM_FIT_TYPE_GSL_MMS, NULL, lh, test->mset, NCM_FIT_GRAD_NUMDIFF_FORWARD);
+
+  test->prior = NCM_MSET_TRANS_KERN (ncm_mset_trans_kern_flat_new ());
+  ncm_mset_trans_kern_set_mset (test->prior, test->mset);
+  ncm_mset_trans_kern_set_prior_from_mset (test->prior);
+
+  test->p0   = ncm_vector_new (ncm_mset_fparams_len (test->mset));
+  test->seed = g_test_rand_int ();
+  ncm_mset_fparams_get_vector (test->mset, test->p0);
+
+  ncm_likelihood_free (lh);
+  ncm_dataset_free (dset);
+}
+
+void
+test_ncm_fit_esmcmc_free (TestNcmFitESMCMC *test, gconstpointer pdata)
+{
+  NCM_TEST_FREE (ncm_fit_free, test->fit);
+  NCM_TEST_FREE (ncm_mset_trans_kern_free, test->prior);
+  NCM_TEST_FREE (ncm_mset_free, test->mset);
+  NCM_TEST_FREE (nc_distance_free, test->dist);
+  NCM_TEST_FREE (nc_hicosmo_free, test->cosmo);
+  ncm_vector_free (test->p0);
+}
+
+static NcmMatrix *
+_test_ncm_fit_esmcmc_run (TestNcmFitESMCMC *test, guint nthreads, guint nprocs)
+{
+  const guint nwalkers       = TEST_NCM_FIT_ESMCMC_NWALKERS;
+  const guint fparams_len    = ncm_mset_fparams_len (test->mset);
+  NcmRNG *rng                = ncm_rng_seeded_new (NCM_RNG_PHILOX4X32_NAME, test->seed);
+  NcmFitESMCMCWalker *walker = NCM_FIT_ESMCMC_WALKER (ncm_fit_esmcmc_walker_stretch_new (nwalkers, fparams_len));
+  NcmFitESMCMC *esmcmc;
+  NcmMSetCatalog *mcat;
+  NcmMatrix *res;
+
+  ncm_mset_fparams_set_vector (test->mset, test->p0);
+  esmcmc = ncm_fit_esmcmc_new (test->fit, nwalkers, test->prior, walker, NCM_FIT_RUN_MSGS_NONE);
+
+  ncm_fit_esmcmc_set_rng (esmcmc, rng);
+  ncm_fit_esmcmc_set_nthreads (esmcmc, nthreads);
+  ncm_fit_esmcmc_set_nprocs (esmcmc, nprocs);
+
+  ncm_fit_esmcmc_start_run (esmcmc);
+  ncm_fit_esmcmc_run (esmcmc, nwalkers * TEST_NCM_FIT_ESMCMC_NRUNS);
+  ncm_fit_esmcmc_end_run (esmcmc);
+
+  mcat = ncm_fit_esmcmc_get_catalog (esmcmc);
+  g_assert_cmpuint (ncm_mset_catalog_len (mcat), ==, nwalkers * TEST_NCM_FIT_ESMCMC_NRUNS);
+
+  res = ncm_model_mvnd_test_catalog_to_matrix (mcat);
+
+  ncm_mset_catalog_free (mcat);
+  NCM_TEST_FREE (ncm_fit_esmcmc_free, esmcmc);
+  ncm_fit_esmcmc_walker_free (walker);
+  ncm_rng_free (rng);
+
+  return res;
+}
+
+void
+test_ncm_fit_esmcmc_nprocs (TestNcmFitESMCMC *test, gconstpointer pdata)
+{
+  NcmMatrix *res_serial = _test_ncm_fit_esmcmc_run (test, 1, 0);
+  NcmMatrix *res_procs2 = _test_ncm_fit_esmcmc_run (test, 1, 2);
+  NcmMatrix *res_procs3 = _test_ncm_fit_esmcmc_run (test, 1, 3);
+  guint i, j;
+
+  g_assert_cmpuint (ncm_matrix_nrows (res_procs2), ==, ncm_matrix_nrows (res_serial));
+  g_assert_cmpuint (ncm_matrix_nrows (res_procs3), ==, ncm_matrix_nrows (res_serial));
+  g_assert_cmpuint (ncm_matrix_ncols (res_procs2), ==, ncm_matrix_ncols (res_serial));
+  g_assert_cmpuint (ncm_matrix_ncols (res_procs3), ==, ncm_matrix_ncols (res_serial));
+
+  /* The initial points and the chains must be identical to the serial ones. */
+  for (i = 0; i < ncm_matrix_nrows (res_serial); i++)
+  {
+    for (j = 0; j < ncm_matrix_ncols (res_serial); j++)
+    {
+      ncm_assert_cmpdouble (ncm_matrix_get (res_procs2, i, j), ==, ncm_matrix_get (res_serial, i, j));
+      ncm_assert_cmpdouble (ncm_matrix_get (res_procs3, i, j), ==, ncm_matrix_get (res_serial, i, j));
+    }
+  }
+
+  ncm_matrix_free (res_serial);
+  ncm_matrix_free (res_procs2);
+  ncm_matrix_free (res_procs3);
+}
@@ -0,0 +1,252 @@
+/***************************************************************************
+ *            test_ncm_fit_esmcmc_pt.c
+ *
+ *  Mon October 19 00:05:12 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+#include <gsl/gsl_randist.h>
+
+#include "ncm_model_mvnd_test.h"
+
+#define TEST_NCM_FIT_ESMCMC_PT_NWALKERS 40
+#define TEST_NCM_FIT_ESMCMC_PT_BURNIN 100
+
+typedef struct _TestNcmFitESMCMCPT
+{
+  guint dim;
+  NcmData *data;
+  NcmMSet *mset;
+  NcmFit *fit;
+  NcmMSetTransKern *prior;
+  NcmFitESMCMCWalker *walker;
+  NcmFitESMCMC *esmcmc;
+  NcmRNG *rng;
+} TestNcmFitESMCMCPT;
+
+void test_ncm_fit_esmcmc_pt_new (TestNcmFitESMCMCPT *test, gconstpointer pdata);
+void test_ncm_fit_esmcmc_pt_free (TestNcmFitESMCMCPT *test, gconstpointer pdata);
+
+void test_ncm_fit_esmcmc_pt_swap (TestNcmFitESMCMCPT *test, gconstpointer pdata);
+void test_ncm_fit_esmcmc_pt_adapt (TestNcmFitESMCMCPT *test, gconstpointer pdata);
+void test_ncm_fit_esmcmc_pt_evidence (TestNcmFitESMCMCPT *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add ("/ncm/fit/esmcmc/pt/swap", TestNcmFitESMCMCPT, NULL,
+              &test_ncm_fit_esmcmc_pt_new,
+              &test_ncm_fit_esmcmc_pt_swap,
+              &test_ncm_fit_esmcmc_pt_free);
+
+  g_test_add ("/ncm/fit/esmcmc/pt/adapt", TestNcmFitESMCMCPT, NULL,
+              &test_ncm_fit_esmcmc_pt_new,
+              &test_ncm_fit_esmcmc_pt_adapt,
+              &test_ncm_fit_esmcmc_pt_free);
+
+  g_test_add ("/ncm/fit/esmcmc/pt/evidence", TestNcmFitESMCMCPT, NULL,
+              &test_ncm_fit_esmcmc_pt_new,
+              &test_ncm_fit_esmcmc_pt_evidence,
+              &test_ncm_fit_esmcmc_pt_free);
+
+  g_test_run ();
+}
+
+void
+test_ncm_fit_esmcmc_pt_new (TestNcmFitESMCMCPT *test, gconstpointer pdata)
+{
+  test->dim    = 2;
+  test->data   = ncm_data_gauss_cov_mvnd_test_new (test->dim, 1.0, 0.3);
+  test->mset   = ncm_data_gauss_cov_mvnd_test_mset_new (test->data);
+  test->fit    = ncm_data_gauss_cov_mvnd_test_fit_new (test->data, test->mset);
+  test->rng    = ncm_rng_seeded_new (NCM_RNG_PHILOX4X32_NAME, g_test_rand_int ());
+  test->walker = NCM_FIT_ESMCMC_WALKER (ncm_fit_esmcmc_walker_stretch_new (TEST_NCM_FIT_ESMCMC_PT_NWALKERS, test->dim));
+
+  test->prior = NCM_MSET_TRANS_KERN (ncm_mset_trans_kern_flat_new ());
+  ncm_mset_trans_kern_set_mset (test->prior, test->mset);
+  ncm_mset_trans_kern_set_prior_from_mset (test->prior);
+
+  test->esmcmc = ncm_fit_esmcmc_new (test->fit, TEST_NCM_FIT_ESMCMC_PT_NWALKERS, test->prior, test->walker, NCM_FIT_RUN_MSGS_NONE);
+  ncm_fit_esmcmc_set_rng (test->esmcmc, test->rng);
+}
+
+void
+test_ncm_fit_esmcmc_pt_free (TestNcmFitESMCMCPT *test, gconstpointer pdata)
+{
+  NCM_TEST_FREE (ncm_fit_esmcmc_free, test->esmcmc);
+  NCM_TEST_FREE (ncm_fit_esmcmc_walker_free, test->walker);
+  NCM_TEST_FREE (ncm_mset_trans_kern_free, test->prior);
+  NCM_TEST_FREE (ncm_fit_free, test->fit);
+  NCM_TEST_FREE (ncm_mset_free, test->mset);
+  NCM_TEST_FREE (ncm_data_free, test->data);
+  NCM_TEST_FREE (ncm_rng_free, test->rng);
+}
+
+static gdouble
+_test_ncm_fit_esmcmc_pt_swap_spread (NcmFitESMCMCPT *pt)
+{
+  gdouble min = 1.0, max = 0.0;
+  guint i;
+
+  for (i = 0; i + 1 < ncm_fit_esmcmc_pt_get_ntemps (pt); i++)
+  {
+    const gdouble A_i = ncm_fit_esmcmc_pt_get_swap_accept_ratio (pt, i);
+
+    min = GSL_MIN (min, A_i);
+    max = GSL_MAX (max, A_i);
+  }
+
+  return max - min;
+}
+
+void
+test_ncm_fit_esmcmc_pt_swap (TestNcmFitESMCMCPT *test, gconstpointer pdata)
+{
+  const gdouble tmax = 4.0;
+  const guint nsteps = 600;
+  const guint ndraws = 1000000;
+  NcmFitESMCMCPT *pt = ncm_fit_esmcmc_pt_new (test->esmcmc, 2, tmax);
+  gdouble A_exact    = 0.0;
+  guint a;
+
+  ncm_assert_cmpdouble (ncm_fit_esmcmc_pt_get_beta (pt, 0), ==, 1.0);
+  ncm_assert_cmpdouble_e (ncm_fit_esmcmc_pt_get_beta (pt, 1), ==, 1.0 / tmax, 1.0e-15, 0.0);
+
+  ncm_fit_esmcmc_pt_start_run (pt);
+  ncm_fit_esmcmc_pt_run (pt, TEST_NCM_FIT_ESMCMC_PT_BURNIN);
+  ncm_fit_esmcmc_pt_reset_evidence (pt);
+  ncm_fit_esmcmc_pt_run (pt, nsteps);
+  ncm_fit_esmcmc_pt_end_run (pt);
+
+  /*
+   * The box is much larger than the tempered widths, hence, the chi-squared
+   * at inverse temperature beta is distributed as chi2_d / beta and the
+   * swap acceptance ratio is E[min(1, exp((1 - beta)(X_c - X_h / beta) / 2))].
+   */
+  for (a = 0; a < ndraws; a++)
+  {
+    const gdouble beta = 1.0 / tmax;
+    const gdouble X_c  = gsl_ran_chisq (test->rng->r, test->dim);
+    const gdouble X_h  = gsl_ran_chisq (test->rng->r, test->dim) / beta;
+
+    A_exact += GSL_MIN (1.0, exp (0.5 * (1.0 - beta) * (X_c - X_h)));
+  }
+
+  A_exact /= ndraws;
+
+  g_assert_cmpfloat (A_exact, >, 0.05);
+  g_assert_cmpfloat (A_exact, <, 0.95);
+  ncm_assert_cmpdouble_e (ncm_fit_esmcmc_pt_get_swap_accept_ratio (pt, 0), ==, A_exact, 0.0, 0.05);
+
+  NCM_TEST_FREE (ncm_fit_esmcmc_pt_free, pt);
+}
+
+void
+test_ncm_fit_esmcmc_pt_adapt (TestNcmFitESMCMCPT *test, gconstpointer pdata)
+{
+  const guint ntemps = 5;
+  const gdouble tmax = 1.0e4;
+  const guint nsteps = 300;
+  NcmFitESMCMCPT *pt = ncm_fit_esmcmc_pt_new (test->esmcmc, ntemps, tmax);
+  gdouble spread_geom, spread_adapt;
+  guint i;
+
+  ncm_fit_esmcmc_pt_set_adapt_lag (pt, 100.0);
+  ncm_fit_esmcmc_pt_set_adapt_time (pt, 10.0);
+
+  ncm_fit_esmcmc_pt_start_run (pt);
+
+  /*
+   * The hottest levels are flat in the box and always swap, the geometric
+   * ladder gives very different acceptance ratios between the levels.
+   */
+  ncm_fit_esmcmc_pt_run (pt, TEST_NCM_FIT_ESMCMC_PT_BURNIN);
+  ncm_fit_esmcmc_pt_reset_evidence (pt);
+  ncm_fit_esmcmc_pt_run (pt, TEST_NCM_FIT_ESMCMC_PT_BURNIN + nsteps);
+  spread_geom = _test_ncm_fit_esmcmc_pt_swap_spread (pt);
+
+  ncm_fit_esmcmc_pt_set_adapt (pt, TRUE);
+  g_assert (ncm_fit_esmcmc_pt_get_adapt (pt));
+  ncm_fit_esmcmc_pt_run (pt, TEST_NCM_FIT_ESMCMC_PT_BURNIN + 4 * nsteps);
+
+  /* Disabling the adaptation resets the counters. */
+  ncm_fit_esmcmc_pt_set_adapt (pt, FALSE);
+  for (i = 0; i + 1 < ntemps; i++)
+    ncm_assert_cmpdouble (ncm_fit_esmcmc_pt_get_swap_accept_ratio (pt, i), ==, 0.0);
+
+  ncm_fit_esmcmc_pt_run (pt, TEST_NCM_FIT_ESMCMC_PT_BURNIN + 5 * nsteps);
+  spread_adapt = _test_ncm_fit_esmcmc_pt_swap_spread (pt);
+
+  ncm_fit_esmcmc_pt_end_run (pt);
+
+  /* The extremes are fixed and the ladder stays ordered. */
+  ncm_assert_cmpdouble (ncm_fit_esmcmc_pt_get_beta (pt, 0), ==, 1.0);
+  ncm_assert_cmpdouble_e (ncm_fit_esmcmc_pt_get_beta (pt, ntemps - 1), ==, 1.0 / tmax, 1.0e-15, 0.0);
+
+  for (i = 0; i + 1 < ntemps; i++)
+  {
+    g_assert_cmpfloat (ncm_fit_esmcmc_pt_get_beta (pt, i + 1), <, ncm_fit_esmcmc_pt_get_beta (pt, i));
+    ncm_assert_cmpdouble (ncm_fit_esmcmc_get_beta (ncm_fit_esmcmc_pt_peek_level (pt, i)), ==, ncm_fit_esmcmc_pt_get_beta (pt, i));
+  }
+
+  g_assert_cmpfloat (spread_adapt, <, 0.5 * spread_geom);
+
+  NCM_TEST_FREE (ncm_fit_esmcmc_pt_free, pt);
+}
+
+void
+test_ncm_fit_esmcmc_pt_evidence (TestNcmFitESMCMCPT *test, gconstpointer pdata)
+{
+  const guint ntemps    = 24;
+  const gdouble tmax    = 1.0e3;
+  const guint nsteps    = 400;
+  const gdouble lnZ_exp = -(gdouble) test->dim * log (NCM_MODEL_MVND_TEST_UB - NCM_MODEL_MVND_TEST_LB);
+  NcmFitESMCMCPT *pt    = ncm_fit_esmcmc_pt_new (test->esmcmc, ntemps, tmax);
+  gdouble lnZ, lnZ_err;
+
+  ncm_fit_esmcmc_pt_start_run (pt);
+  ncm_fit_esmcmc_pt_run (pt, TEST_NCM_FIT_ESMCMC_PT_BURNIN);
+  ncm_fit_esmcmc_pt_reset_evidence (pt);
+  ncm_fit_esmcmc_pt_run (pt, TEST_NCM_FIT_ESMCMC_PT_BURNIN + nsteps);
+  ncm_fit_esmcmc_pt_end_run (pt);
+
+  ncm_fit_esmcmc_pt_evidence (pt, &lnZ, &lnZ_err);
+
+  g_assert (gsl_finite (lnZ));
+  g_assert_cmpfloat (lnZ_err, >=, 0.0);
+
+  /* The ladder discretization dominates, the sampling noise is much smaller than 0.1. */
+  g_assert_cmpfloat (fabs (lnZ - lnZ_exp), <, lnZ_err + 0.1);
+
+  NCM_TEST_FREE (ncm_fit_esmcmc_pt_free, pt);
+}
@@ -0,0 +1,255 @@
+/***************************************************************************
+ *            test_ncm_fit_mc.c
+ *
+ *  Sun October 18 21:40:12 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+
+#include "ncm_model_mvnd_test.h"
+
+#define TEST_NCM_FIT_MC_NREAL 40
+#define TEST_NCM_FIT_MCBS_NREAL 8
+#define TEST_NCM_FIT_MCBS_NBSTRAPS 5
+
+typedef struct _TestNcmFitMC
+{
+  NcmData *data;
+  NcmMSet *mset;
+  NcmFit *fit;
+  NcmVector *p0;
+  gulong seed;
+} TestNcmFitMC;
+
+void test_ncm_fit_mc_new (TestNcmFitMC *test, gconstpointer pdata);
+void test_ncm_fit_mc_free (TestNcmFitMC *test, gconstpointer pdata);
+
+void test_ncm_fit_mc_substream_nthreads (TestNcmFitMC *test, gconstpointer pdata);
+void test_ncm_fit_mcbs_nthreads (TestNcmFitMC *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add ("/ncm/fit/mc/substream/nthreads", TestNcmFitMC, NULL,
+              &test_ncm_fit_mc_new,
+              &test_ncm_fit_mc_substream_nthreads,
+              &test_ncm_fit_mc_free);
+
+  g_test_add ("/ncm/fit/mcbs/nthreads", TestNcmFitMC, NULL,
+              &test_ncm_fit_mc_new,
+              &test_ncm_fit_mcbs_nthreads,
+              &test_ncm_fit_mc_free);
+
+  g_test_run ();
+}
+
+void
+test_ncm_fit_mc_new (TestNcmFitMC *test, gconstpointer pdata)
+{
+  const guint dim = g_test_rand_int_range (2, 5);
+
+  test->data = ncm_data_gauss_cov_mvnd_test_new (dim, 1.0, 0.3);
+  test->mset = ncm_data_gauss_cov_mvnd_test_mset_new (test->data);
+  test->fit  = ncm_data_gauss_cov_mvnd_test_fit_new (test->data, test->mset);
+  test->p0   = ncm_vector_new (ncm_mset_total_len (test->mset));
+  test->seed = g_test_rand_int ();
+
+  ncm_mset_param_get_vector (test->mset, test->p0);
+}
+
+void
+test_ncm_fit_mc_free (TestNcmFitMC *test, gconstpointer pdata)
+{
+  NCM_TEST_FREE (ncm_fit_free, test->fit);
+  NCM_TEST_FREE (ncm_mset_free, test->mset);
+  NCM_TEST_FREE (ncm_data_free, test->data);
+  ncm_vector_free (test->p0);
+}
+
+static void
+_test_ncm_fit_mc_assert_rows (NcmMatrix *res, guint offset, NcmMatrix *res_ref)
+{
+  guint i, j;
+
+  g_assert_cmpuint (ncm_matrix_nrows (res) + offset, ==, ncm_matrix_nrows (res_ref));
+  g_assert_cmpuint (ncm_matrix_ncols (res), ==, ncm_matrix_ncols (res_ref));
+
+  for (i = 0; i < ncm_matrix_nrows (res); i++)
+  {
+    for (j = 0; j < ncm_matrix_ncols (res); j++)
+      ncm_assert_cmpdouble (ncm_matrix_get (res, i, j), ==, ncm_matrix_get (res_ref, i + offset, j));
+  }
+}
+
+static NcmMatrix *
+_test_ncm_fit_mc_run (TestNcmFitMC *test, NcmFitMCResampleType rtype, guint nthreads)
+{
+  NcmRNG *rng    = ncm_rng_seeded_new (NCM_RNG_PHILOX4X32_NAME, test->seed);
+  NcmFitMC *mc;
+  NcmMatrix *res;
+  NcmMSetCatalog *mcat;
+
+  /* Every run starts from the same fiducial and initial point. */
+  ncm_mset_param_set_vector (test->mset, test->p0);
+  mc = ncm_fit_mc_new (test->fit, rtype, NCM_FIT_RUN_MSGS_NONE);
+
+  ncm_fit_mc_set_rng (mc, rng);
+  ncm_fit_mc_set_nthreads (mc, nthreads);
+  ncm_fit_mc_keep_order (mc, TRUE);
+
+  ncm_fit_mc_start_run (mc);
+  ncm_fit_mc_run (mc, TEST_NCM_FIT_MC_NREAL);
+  ncm_fit_mc_end_run (mc);
+
+  mcat = ncm_fit_mc_get_catalog (mc);
+  g_assert_cmpuint (ncm_mset_catalog_len (mcat), ==, TEST_NCM_FIT_MC_NREAL);
+
+  res = ncm_model_mvnd_test_catalog_to_matrix (mcat);
+
+  ncm_mset_catalog_free (mcat);
+  NCM_TEST_FREE (ncm_fit_mc_free, mc);
+  ncm_rng_free (rng);
+
+  return res;
+}
+
+void
+test_ncm_fit_mc_substream_nthreads (TestNcmFitMC *test, gconstpointer pdata)
+{
+  NcmMatrix *res_serial = _test_ncm_fit_mc_run (test, NCM_FIT_MC_RESAMPLE_FROM_MODEL, 1);
+  NcmMatrix *res_mt     = _test_ncm_fit_mc_run (test, NCM_FIT_MC_RESAMPLE_FROM_MODEL, 4);
+  NcmMatrix *res_mt3    = _test_ncm_fit_mc_run (test, NCM_FIT_MC_RESAMPLE_FROM_MODEL, 3);
+  guint i, j;
+
+  for (i = 0; i < ncm_matrix_nrows (res_serial); i++)
+  {
+    for (j = 0; j < ncm_matrix_ncols (res_serial); j++)
+    {
+      ncm_assert_cmpdouble (ncm_matrix_get (res_mt, i, j), ==, ncm_matrix_get (res_serial, i, j));
+      ncm_assert_cmpdouble (ncm_matrix_get (res_mt3, i, j), ==, ncm_matrix_get (res_serial, i, j));
+    }
+
+    /* Different realizations must differ. */
+    if (i > 0)
+      g_assert_cmpfloat (ncm_matrix_get (res_serial, i, 0), !=, ncm_matrix_get (res_serial, i - 1, 0));
+  }
+
+  ncm_matrix_free (res_serial);
+  ncm_matrix_free (res_mt);
+  ncm_matrix_free (res_mt3);
+}
+
+static void
+_test_ncm_fit_mcbs_run (TestNcmFitMC *test, guint ni, guint nthreads, guint bsmt, NcmMatrix **res_resample, NcmMatrix **res_bs)
+{
+  NcmRNG *rng      = ncm_rng_seeded_new (NCM_RNG_PHILOX4X32_NAME, test->seed);
+  NcmFitMCBS *mcbs = ncm_fit_mcbs_new (test->fit);
+  NcmMSetCatalog *mcat;
+
+  ncm_mset_param_set_vector (test->mset, test->p0);
+
+  ncm_fit_mcbs_set_rng (mcbs, rng);
+  ncm_fit_mcbs_set_nthreads (mcbs, nthreads);
+  ncm_fit_mcbs_run (mcbs, NULL, ni, TEST_NCM_FIT_MCBS_NREAL, TEST_NCM_FIT_MCBS_NBSTRAPS, 
+                    NCM_FIT_MC_RESAMPLE_BOOTSTRAP_NOMIX, NCM_FIT_RUN_MSGS_NONE, bsmt);
+
+  /* The resample catalog follows the NcmFitMC bookkeeping. */
+  g_assert_cmpint (mcbs->mc_resample->cur_sample_id, ==, TEST_NCM_FIT_MCBS_NREAL - 1);
+  g_assert_cmpint (mcbs->mc_resample->write_index, ==, TEST_NCM_FIT_MCBS_NREAL);
+  g_assert_cmpint (ncm_mset_catalog_get_first_id (mcbs->mc_resample->mcat), ==, ni);
+  g_assert_cmpuint (ncm_mset_catalog_len (mcbs->mc_resample->mcat), ==, TEST_NCM_FIT_MCBS_NREAL - ni);
+
+  *res_resample = ncm_model_mvnd_test_catalog_to_matrix (mcbs->mc_resample->mcat);
+
+  mcat = ncm_fit_mcbs_get_catalog (mcbs);
+  g_assert_cmpuint (ncm_mset_catalog_len (mcat), ==, TEST_NCM_FIT_MCBS_NREAL - ni);
+  *res_bs = ncm_model_mvnd_test_catalog_to_matrix (mcat);
+
+  /* The fit object is left at the initial point. */
+  {
+    NcmVector *p = ncm_vector_new (ncm_mset_total_len (test->mset));
+    guint i;
+
+    ncm_mset_param_get_vector (test->mset, p);
+    for (i = 0; i < ncm_vector_len (p); i++)
+      ncm_assert_cmpdouble (ncm_vector_get (p, i), ==, ncm_vector_get (test->p0, i));
+
+    ncm_vector_free (p);
+  }
+
+  ncm_mset_catalog_free (mcat);
+  NCM_TEST_FREE (ncm_fit_mcbs_free, mcbs);
+  ncm_rng_free (rng);
+}
+
+void
+test_ncm_fit_mcbs_nthreads (TestNcmFitMC *test, gconstpointer pdata)
+{
+  const guint ni = 3;
+  NcmMatrix *resample_serial, *bs_serial;
+  NcmMatrix *resample_mt, *bs_mt;
+  NcmMatrix *resample_ni, *bs_ni;
+  NcmMatrix *resample_bsmt, *bs_bsmt;
+  guint i;
+
+  _test_ncm_fit_mcbs_run (test, 0, 1, 0, &resample_serial, &bs_serial);
+  _test_ncm_fit_mcbs_run (test, 0, 4, 0, &resample_mt, &bs_mt);
+
+  _test_ncm_fit_mc_assert_rows (resample_mt, 0, resample_serial);
+  _test_ncm_fit_mc_assert_rows (bs_mt, 0, bs_serial);
+
+  /* Serial realizations with threaded bootstraps. */
+  _test_ncm_fit_mcbs_run (test, 0, 1, 3, &resample_bsmt, &bs_bsmt);
+
+  _test_ncm_fit_mc_assert_rows (resample_bsmt, 0, resample_serial);
+  _test_ncm_fit_mc_assert_rows (bs_bsmt, 0, bs_serial);
+
+  /* Different realizations must differ. */
+  for (i = 1; i < TEST_NCM_FIT_MCBS_NREAL; i++)
+    g_assert_cmpfloat (ncm_matrix_get (resample_serial, i, 0), !=, ncm_matrix_get (resample_serial, i - 1, 0));
+
+  /* Starting at ni reproduces the realizations ni, ni + 1, ... of the full run. */
+  _test_ncm_fit_mcbs_run (test, ni, 3, 0, &resample_ni, &bs_ni);
+
+  _test_ncm_fit_mc_assert_rows (resample_ni, ni, resample_serial);
+  _test_ncm_fit_mc_assert_rows (bs_ni, ni, bs_serial);
+
+  ncm_matrix_free (resample_serial);
+  ncm_matrix_free (bs_serial);
+  ncm_matrix_free (resample_mt);
+  ncm_matrix_free (bs_mt);
+  ncm_matrix_free (resample_ni);
+  ncm_matrix_free (bs_ni);
+  ncm_matrix_free (resample_bsmt);
+  ncm_matrix_free (bs_bsmt);
+}
@@ -0,0 +1,210 @@
+/***************************************************************************
+ *            test_ncm_fit_mcmc.c
+ *
+ *  Mon October 19 03:05:42 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+#include <gsl/gsl_statistics_double.h>
+
+#include "ncm_model_mvnd_test.h"
+
+#define TEST_NCM_FIT_MCMC_DIM 2
+#define TEST_NCM_FIT_MCMC_SIGMA 1.0
+#define TEST_NCM_FIT_MCMC_RHO 0.3
+#define TEST_NCM_FIT_MCMC_NRUNS 20000
+
+typedef struct _TestNcmFitMCMC
+{
+  NcmData *data;
+  NcmMSet *mset;
+  NcmFit *fit;
+  NcmData *screen_data;
+  NcmMSet *screen_mset;
+  NcmFit *screen;
+  NcmMSetTransKern *tkern;
+  gulong seed;
+} TestNcmFitMCMC;
+
+void test_ncm_fit_mcmc_new (TestNcmFitMCMC *test, gconstpointer pdata);
+void test_ncm_fit_mcmc_free (TestNcmFitMCMC *test, gconstpointer pdata);
+
+void test_ncm_fit_mcmc_screen_biased (TestNcmFitMCMC *test, gconstpointer pdata);
+void test_ncm_fit_mcmc_screen_nthreads (TestNcmFitMCMC *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add ("/ncm/fit/mcmc/screen/biased", TestNcmFitMCMC, NULL,
+              &test_ncm_fit_mcmc_new,
+              &test_ncm_fit_mcmc_screen_biased,
+              &test_ncm_fit_mcmc_free);
+
+  g_test_add ("/ncm/fit/mcmc/screen/nthreads", TestNcmFitMCMC, NULL,
+              &test_ncm_fit_mcmc_new,
+              &test_ncm_fit_mcmc_screen_nthreads,
+              &test_ncm_fit_mcmc_free);
+
+  g_test_run ();
+}
+
+void
+test_ncm_fit_mcmc_new (TestNcmFitMCMC *test, gconstpointer pdata)
+{
+  NcmMatrix *cov = ncm_matrix_new (TEST_NCM_FIT_MCMC_DIM, TEST_NCM_FIT_MCMC_DIM);
+  guint i, j;
+
+  test->data = ncm_data_gauss_cov_mvnd_test_new (TEST_NCM_FIT_MCMC_DIM, TEST_NCM_FIT_MCMC_SIGMA, TEST_NCM_FIT_MCMC_RHO);
+  test->mset = ncm_data_gauss_cov_mvnd_test_mset_new (test->data);
+  test->fit  = ncm_data_gauss_cov_mvnd_test_fit_new (test->data, test->mset);
+  test->seed = g_test_rand_int ();
+
+  /* The screening likelihood is wider, uncorrelated and has a shifted mean. */
+  test->screen_data = ncm_data_gauss_cov_mvnd_test_new (TEST_NCM_FIT_MCMC_DIM, 1.5 * TEST_NCM_FIT_MCMC_SIGMA, 0.0);
+  test->screen_mset = ncm_data_gauss_cov_mvnd_test_mset_new (test->screen_data);
+  test->screen      = ncm_data_gauss_cov_mvnd_test_fit_new (test->screen_data, test->screen_mset);
+  ncm_vector_set_all (NCM_DATA_GAUSS_COV (test->screen_data)->y, 0.5);
+
+  test->tkern = NCM_MSET_TRANS_KERN (ncm_mset_trans_kern_gauss_new (TEST_NCM_FIT_MCMC_DIM));
+  ncm_mset_trans_kern_set_mset (test->tkern, test->mset);
+
+  for (i = 0; i < TEST_NCM_FIT_MCMC_DIM; i++)
+  {
+    for (j = 0; j < TEST_NCM_FIT_MCMC_DIM; j++)
+      ncm_matrix_set (cov, i, j, 2.0 * gsl_pow_2 (TEST_NCM_FIT_MCMC_SIGMA) * gsl_pow_int (TEST_NCM_FIT_MCMC_RHO, ABS ((gint) i - (gint) j)));
+  }
+  ncm_mset_trans_kern_gauss_set_cov (NCM_MSET_TRANS_KERN_GAUSS (test->tkern), cov);
+
+  ncm_matrix_free (cov);
+}
+
+void
+test_ncm_fit_mcmc_free (TestNcmFitMCMC *test, gconstpointer pdata)
+{
+  NCM_TEST_FREE (ncm_mset_trans_kern_free, test->tkern);
+  NCM_TEST_FREE (ncm_fit_free, test->screen);
+  NCM_TEST_FREE (ncm_mset_free, test->screen_mset);
+  NCM_TEST_FREE (ncm_data_free, test->screen_data);
+  NCM_TEST_FREE (ncm_fit_free, test->fit);
+  NCM_TEST_FREE (ncm_mset_free, test->mset);
+  NCM_TEST_FREE (ncm_data_free, test->data);
+}
+
+static NcmFitMCMC *
+_test_ncm_fit_mcmc_run (TestNcmFitMCMC *test, guint nthreads)
+{
+  NcmRNG *rng      = ncm_rng_seeded_new (NCM_RNG_PHILOX4X32_NAME, test->seed);
+  NcmFitMCMC *mcmc = ncm_fit_mcmc_new (test->fit, test->tkern, NCM_FIT_RUN_MSGS_NONE);
+  NcmMSetCatalog *mcat;
+  guint i;
+
+  /* Every run starts at the target mean. */
+  for (i = 0; i < TEST_NCM_FIT_MCMC_DIM; i++)
+    ncm_mset_fparam_set (test->mset, i, 0.0);
+
+  ncm_fit_mcmc_set_rng (mcmc, rng);
+  ncm_fit_mcmc_set_nthreads (mcmc, nthreads);
+  ncm_fit_mcmc_set_screen_fit (mcmc, test->screen);
+  g_assert (ncm_fit_mcmc_peek_screen_fit (mcmc) == test->screen);
+
+  ncm_fit_mcmc_start_run (mcmc);
+  ncm_fit_mcmc_run (mcmc, TEST_NCM_FIT_MCMC_NRUNS);
+  ncm_fit_mcmc_end_run (mcmc);
+
+  mcat = ncm_fit_mcmc_get_catalog (mcmc);
+  g_assert_cmpuint (ncm_mset_catalog_len (mcat), ==, TEST_NCM_FIT_MCMC_NRUNS);
+
+  ncm_mset_catalog_free (mcat);
+  ncm_rng_free (rng);
+
+  return mcmc;
+}
+
+void
+test_ncm_fit_mcmc_screen_biased (TestNcmFitMCMC *test, gconstpointer pdata)
+{
+  NcmFitMCMC *mcmc                  = _test_ncm_fit_mcmc_run (test, 1);
+  NcmMSetCatalog *mcat              = ncm_fit_mcmc_get_catalog (mcmc);
+  NcmMatrix *res                    = ncm_model_mvnd_test_catalog_to_matrix (mcat);
+  const gdouble screen_reject_ratio = ncm_fit_mcmc_get_screen_reject_ratio (mcmc);
+  guint i;
+
+  g_assert_cmpfloat (screen_reject_ratio, >, 0.0);
+  g_assert_cmpfloat (screen_reject_ratio, <, 1.0);
+
+  /* The first column contains -2lnL, the parameters follow. */
+  for (i = 0; i < TEST_NCM_FIT_MCMC_DIM; i++)
+  {
+    NcmVector *theta_i = ncm_matrix_get_col (res, i + 1);
+    const gdouble mean = gsl_stats_mean (ncm_vector_data (theta_i), ncm_vector_stride (theta_i), ncm_vector_len (theta_i));
+    const gdouble var  = gsl_stats_variance_m (ncm_vector_data (theta_i), ncm_vector_stride (theta_i), ncm_vector_len (theta_i), mean);
+
+    /* The screening bias must not leak into the stationary distribution. */
+    g_assert_cmpfloat (fabs (mean), <, 0.1);
+    ncm_assert_cmpdouble_e (var, ==, gsl_pow_2 (TEST_NCM_FIT_MCMC_SIGMA), 0.15, 0.0);
+
+    ncm_vector_free (theta_i);
+  }
+
+  ncm_matrix_free (res);
+  ncm_mset_catalog_free (mcat);
+  NCM_TEST_FREE (ncm_fit_mcmc_free, mcmc);
+}
+
+void
+test_ncm_fit_mcmc_screen_nthreads (TestNcmFitMCMC *test, gconstpointer pdata)
+{
+  NcmFitMCMC *mcmc = _test_ncm_fit_mcmc_run (test, 4);
+
+  /* 
+   * With a screening fit the threaded run falls back to the serial sampler,
+   * hence every proposal goes through the screening and only the ones that
+   * pass it are evaluated by the main fit.
+   */
+  g_assert_cmpuint (mcmc->nscreened, ==, TEST_NCM_FIT_MCMC_NRUNS);
+  g_assert_cmpuint (mcmc->nscreen_rejected, >, 0);
+  g_assert_cmpuint (mcmc->nscreen_rejected, <, mcmc->nscreened);
+  g_assert_cmpuint (mcmc->nfull, ==, mcmc->nscreened - mcmc->nscreen_rejected);
+  g_assert_cmpuint (mcmc->naccepted, <=, mcmc->nfull);
+
+  ncm_assert_cmpdouble (ncm_fit_mcmc_get_screen_reject_ratio (mcmc), ==, mcmc->nscreen_rejected / (1.0 * mcmc->nscreened));
+
+  g_assert_cmpfloat (mcmc->screen_time, >=, 0.0);
+  g_assert_cmpfloat (mcmc->full_time, >=, 0.0);
+  g_assert (gsl_finite (ncm_fit_mcmc_get_screen_time_saved (mcmc)));
+  ncm_assert_cmpdouble_e (ncm_fit_mcmc_get_screen_time_saved (mcmc), ==,
+                          mcmc->nscreen_rejected * mcmc->full_time / mcmc->nfull - mcmc->screen_time,
+                          1.0e-12, 1.0e-15);
+
+  NCM_TEST_FREE (ncm_fit_mcmc_free, mcmc);
+}
@@ -0,0 +1,237 @@
+/***************************************************************************
+ *            test_ncm_fit_nested.c
+ *
+ *  Mon October 19 00:41:27 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+
+#include "ncm_model_mvnd_test.h"
+
+typedef struct _TestNcmFitNested
+{
+  guint dim;
+  NcmData *data;
+  NcmMSet *mset;
+  NcmFit *fit;
+  NcmMSetTransKern *prior;
+  gulong seed;
+} TestNcmFitNested;
+
+typedef struct _TestNcmFitNestedRes
+{
+  gdouble lnZ;
+  gdouble lnZ_err;
+  gdouble H;
+  gulong neval;
+  NcmMatrix *dead;
+} TestNcmFitNestedRes;
+
+void test_ncm_fit_nested_new (TestNcmFitNested *test, gconstpointer pdata);
+void test_ncm_fit_nested_free (TestNcmFitNested *test, gconstpointer pdata);
+
+void test_ncm_fit_nested_gauss_evidence (TestNcmFitNested *test, gconstpointer pdata);
+void test_ncm_fit_nested_gauss_prior_evidence (TestNcmFitNested *test, gconstpointer pdata);
+void test_ncm_fit_nested_nthreads (TestNcmFitNested *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add ("/ncm/fit/nested/gauss/evidence", TestNcmFitNested, NULL,
+              &test_ncm_fit_nested_new,
+              &test_ncm_fit_nested_gauss_evidence,
+              &test_ncm_fit_nested_free);
+
+  g_test_add ("/ncm/fit/nested/gauss_prior/evidence", TestNcmFitNested, NULL,
+              &test_ncm_fit_nested_new,
+              &test_ncm_fit_nested_gauss_prior_evidence,
+              &test_ncm_fit_nested_free);
+
+  g_test_add ("/ncm/fit/nested/nthreads", TestNcmFitNested, NULL,
+              &test_ncm_fit_nested_new,
+              &test_ncm_fit_nested_nthreads,
+              &test_ncm_fit_nested_free);
+
+  g_test_run ();
+}
+
+void
+test_ncm_fit_nested_new (TestNcmFitNested *test, gconstpointer pdata)
+{
+  test->dim  = g_test_rand_int_range (2, 5);
+  test->data = ncm_data_gauss_cov_mvnd_test_new (test->dim, 1.0, 0.3);
+  test->mset = ncm_data_gauss_cov_mvnd_test_mset_new (test->data);
+  test->fit  = ncm_data_gauss_cov_mvnd_test_fit_new (test->data, test->mset);
+  test->seed = g_test_rand_int ();
+
+  /* Flat prior in the parameters box [LB, UB]^d. */
+  test->prior = NCM_MSET_TRANS_KERN (ncm_mset_trans_kern_flat_new ());
+  ncm_mset_trans_kern_set_mset (test->prior, test->mset);
+  ncm_mset_trans_kern_set_prior_from_mset (test->prior);
+}
+
+void
+test_ncm_fit_nested_free (TestNcmFitNested *test, gconstpointer pdata)
+{
+  NCM_TEST_FREE (ncm_mset_trans_kern_free, test->prior);
+  NCM_TEST_FREE (ncm_fit_free, test->fit);
+  NCM_TEST_FREE (ncm_mset_free, test->mset);
+  NCM_TEST_FREE (ncm_data_free, test->data);
+}
+
+static void
+_test_ncm_fit_nested_run (TestNcmFitNested *test, guint nlive, guint nreplace, guint nthreads, TestNcmFitNestedRes *res)
+{
+  NcmRNG *rng          = ncm_rng_seeded_new (NCM_RNG_PHILOX4X32_NAME, test->seed);
+  NcmFitNested *nested = ncm_fit_nested_new (test->fit, test->prior, nlive, NCM_FIT_RUN_MSGS_NONE);
+  NcmMSetCatalog *mcat;
+
+  ncm_fit_nested_set_rng (nested, rng);
+  ncm_fit_nested_set_nreplace (nested, nreplace);
+  ncm_fit_nested_set_nthreads (nested, nthreads);
+
+  ncm_fit_nested_start_run (nested);
+  ncm_fit_nested_run (nested);
+  ncm_fit_nested_end_run (nested);
+
+  ncm_fit_nested_get_evidence (nested, &res->lnZ, &res->lnZ_err);
+  res->H     = ncm_fit_nested_get_information (nested);
+  res->neval = ncm_fit_nested_get_neval (nested);
+
+  mcat = ncm_fit_nested_get_catalog (nested);
+  g_assert_cmpuint (ncm_mset_catalog_len (mcat), >, nlive);
+
+  res->dead = ncm_model_mvnd_test_catalog_to_matrix (mcat);
+
+  ncm_mset_catalog_free (mcat);
+  NCM_TEST_FREE (ncm_fit_nested_free, nested);
+  ncm_rng_free (rng);
+}
+
+void
+test_ncm_fit_nested_gauss_evidence (TestNcmFitNested *test, gconstpointer pdata)
+{
+  /* The likelihood is normalized and the box contains its whole mass. */
+  const gdouble lnZ_exact = -(gdouble) test->dim * log (NCM_MODEL_MVND_TEST_UB - NCM_MODEL_MVND_TEST_LB);
+  TestNcmFitNestedRes res;
+  gdouble sum_w = 0.0;
+  guint i;
+
+  _test_ncm_fit_nested_run (test, 400, 1, 1, &res);
+
+  g_assert_cmpfloat (res.H, >, 0.0);
+  g_assert_cmpfloat (res.lnZ_err, >, 0.0);
+  ncm_assert_cmpdouble_e (res.lnZ_err, ==, sqrt (res.H / 400.0), 1.0e-15, 0.0);
+
+  g_assert_cmpfloat (fabs (res.lnZ - lnZ_exact), <, 4.0 * res.lnZ_err);
+
+  /* The posterior weights are normalized. */
+  for (i = 0; i < ncm_matrix_nrows (res.dead); i++)
+    sum_w += ncm_matrix_get (res.dead, i, 1);
+
+  ncm_assert_cmpdouble_e (sum_w, ==, 1.0, 1.0e-10, 0.0);
+
+  ncm_matrix_free (res.dead);
+}
+
+void
+test_ncm_fit_nested_gauss_prior_evidence (TestNcmFitNested *test, gconstpointer pdata)
+{
+  const gdouble sigma_p = 2.0;
+  NcmMatrix *cov        = ncm_matrix_dup (NCM_DATA_GAUSS_COV (test->data)->cov);
+  NcmMatrix *cov_p      = ncm_matrix_new (test->dim, test->dim);
+  gdouble lnZ_exact     = -0.5 * test->dim * ncm_c_ln2pi ();
+  TestNcmFitNestedRes res;
+  guint i;
+
+  /* Replace the flat prior by N(0, sigma_p^2 I), the bounds are 5 sigma_p away. */
+  NCM_TEST_FREE (ncm_mset_trans_kern_free, test->prior);
+  test->prior = NCM_MSET_TRANS_KERN (ncm_mset_trans_kern_gauss_new (test->dim));
+  ncm_mset_trans_kern_set_mset (test->prior, test->mset);
+
+  ncm_matrix_set_identity (cov_p);
+  ncm_matrix_scale (cov_p, sigma_p * sigma_p);
+  ncm_mset_trans_kern_gauss_set_cov (NCM_MSET_TRANS_KERN_GAUSS (test->prior), cov_p);
+
+  {
+    NcmVector *theta0 = ncm_vector_new (test->dim);
+
+    ncm_vector_set_zero (theta0);
+    ncm_mset_trans_kern_set_prior (test->prior, theta0);
+    ncm_vector_free (theta0);
+  }
+
+  /* Z = N(0; 0, C + sigma_p^2 I) for the normalized likelihood N(theta; 0, C). */
+  ncm_matrix_add_mul (cov, 1.0, cov_p);
+  g_assert_cmpint (ncm_matrix_cholesky_decomp (cov, 'U'), ==, 0);
+  for (i = 0; i < test->dim; i++)
+    lnZ_exact -= log (ncm_matrix_get (cov, i, i));
+
+  _test_ncm_fit_nested_run (test, 400, 1, 1, &res);
+
+  g_assert_cmpfloat (res.lnZ_err, >, 0.0);
+  g_assert_cmpfloat (fabs (res.lnZ - lnZ_exact), <, 4.0 * res.lnZ_err);
+
+  ncm_matrix_free (res.dead);
+  ncm_matrix_free (cov);
+  ncm_matrix_free (cov_p);
+}
+
+void
+test_ncm_fit_nested_nthreads (TestNcmFitNested *test, gconstpointer pdata)
+{
+  const guint nlive    = 200;
+  const guint nreplace = 4;
+  TestNcmFitNestedRes res_serial, res_mt;
+  guint i, j;
+
+  _test_ncm_fit_nested_run (test, nlive, nreplace, 1, &res_serial);
+  _test_ncm_fit_nested_run (test, nlive, nreplace, 4, &res_mt);
+
+  ncm_assert_cmpdouble (res_mt.lnZ, ==, res_serial.lnZ);
+  ncm_assert_cmpdouble (res_mt.lnZ_err, ==, res_serial.lnZ_err);
+  ncm_assert_cmpdouble (res_mt.H, ==, res_serial.H);
+  g_assert_cmpuint (res_mt.neval, ==, res_serial.neval);
+
+  g_assert_cmpuint (ncm_matrix_nrows (res_mt.dead), ==, ncm_matrix_nrows (res_serial.dead));
+  g_assert_cmpuint (ncm_matrix_ncols (res_mt.dead), ==, ncm_matrix_ncols (res_serial.dead));
+
+  for (i = 0; i < ncm_matrix_nrows (res_serial.dead); i++)
+  {
+    for (j = 0; j < ncm_matrix_ncols (res_serial.dead); j++)
+      ncm_assert_cmpdouble (ncm_matrix_get (res_mt.dead, i, j), ==, ncm_matrix_get (res_serial.dead, i, j));
+  }
+
+  ncm_matrix_free (res_serial.dead);
+  ncm_matrix_free (res_mt.dead);
+}
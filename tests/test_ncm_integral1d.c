@@ -52,6 +52,9 @@ void test_ncm_integral1d_x5_2_sinx_hermite_p (TestNcmIntegral1d *test, gconstpoi
 void test_ncm_integral1d_x5_2_sinx_hermite (TestNcmIntegral1d *test, gconstpointer pdata);
 void test_ncm_integral1d_x5_2_sinx_laguerre (TestNcmIntegral1d *test, gconstpointer pdata);
 
+void test_ncm_integral1d_vec (TestNcmIntegral1d *test, gconstpointer pdata);
+void test_ncm_integral1d_vec_zero (TestNcmIntegral1d *test, gconstpointer pdata);
+
 void test_ncm_integral1d_traps (TestNcmIntegral1d *test, gconstpointer pdata);
 void test_ncm_integral1d_invalid_test (TestNcmIntegral1d *test, gconstpointer pdata);
 
@@ -102,6 +105,16 @@ main (gint argc, gchar *argv[])
               &test_ncm_integral1d_x5_2_sinx_laguerre, 
               &test_ncm_integral1d_free);
 
+  g_test_add ("/ncm/integral1d/vec", TestNcmIntegral1d, NULL, 
+              &test_ncm_integral1d_new_sinx, 
+              &test_ncm_integral1d_vec, 
+              &test_ncm_integral1d_free);
+
+  g_test_add ("/ncm/integral1d/vec/zero", TestNcmIntegral1d, NULL, 
+              &test_ncm_integral1d_new_sinx, 
+              &test_ncm_integral1d_vec_zero, 
+              &test_ncm_integral1d_free);
+
   g_test_add ("/ncm/integral1d/traps", TestNcmIntegral1d, NULL,
               &test_ncm_integral1d_new_sinx,
               &test_ncm_integral1d_traps,
@@ -158,6 +171,32 @@ test_ncm_integral1d_new_x5_2_sinx (TestNcmIntegral1d *test, gconstpointer pdata)
 }
 
 
+static void
+test_sin_kx_vec (gpointer userdata, const gdouble *x, const guint len, const guint dim, gdouble *fval)
+{
+  guint i, k;
+
+  for (i = 0; i < len; i++)
+  {
+    for (k = 0; k < dim; k++)
+      fval[i * dim + k] = sin ((k + 1.0) * x[i]);
+  }
+}
+
+static void
+test_sin_kx_zero_vec (gpointer userdata, const gdouble *x, const guint len, const guint dim, gdouble *fval)
+{
+  guint i, k;
+
+  /* The last component is identically zero. */
+  for (i = 0; i < len; i++)
+  {
+    for (k = 0; k < dim - 1; k++)
+      fval[i * dim + k] = sin ((k + 1.0) * x[i]);
+    fval[i * dim + dim - 1] = 0.0;
+  }
+}
+
 void _set_destroyed (gpointer b) { gboolean *destroyed = b; *destroyed = TRUE; }
 
 void
@@ -312,3 +351,60 @@ test_ncm_integral1d_invalid_test (TestNcmIntegral1d *test, gconstpointer pdata)
 {
   g_assert_not_reached ();
 }
+
+void
+test_ncm_integral1d_vec (TestNcmIntegral1d *test, gconstpointer pdata)
+{
+  const guint dim           = 5;
+  const gdouble prec        = 1.0e-11;
+  const gdouble xf          = 1.5;
+  NcmIntegral1dPtr *int1d_v = ncm_integral1d_ptr_new_vec (&test_sin_kx_vec, NULL);
+  NcmVector *result         = ncm_vector_new (dim);
+  NcmVector *err            = ncm_vector_new (dim);
+  guint k;
+
+  ncm_integral1d_set_reltol (NCM_INTEGRAL1D (int1d_v), prec);
+  ncm_integral1d_set_abstol (NCM_INTEGRAL1D (int1d_v), 0.0);
+
+  ncm_integral1d_eval_vec (NCM_INTEGRAL1D (int1d_v), 0.0, xf, result, err);
+
+  for (k = 0; k < dim; k++)
+  {
+    const gdouble kp1 = k + 1.0;
+    ncm_assert_cmpdouble_e (ncm_vector_get (result, k), ==, (1.0 - cos (kp1 * xf)) / kp1, prec * 10.0, 0.0);
+  }
+
+  ncm_vector_free (result);
+  ncm_vector_free (err);
+  NCM_TEST_FREE (ncm_integral1d_ptr_free, int1d_v);
+}
+
+void
+test_ncm_integral1d_vec_zero (TestNcmIntegral1d *test, gconstpointer pdata)
+{
+  const guint dim           = 3;
+  const gdouble prec        = 1.0e-11;
+  const gdouble xf          = 1.5;
+  NcmIntegral1dPtr *int1d_v = ncm_integral1d_ptr_new_vec (&test_sin_kx_zero_vec, NULL);
+  NcmVector *result         = ncm_vector_new (dim);
+  NcmVector *err            = ncm_vector_new (dim);
+  guint k;
+
+  /* With abstol zero the zero component must not prevent the convergence. */
+  ncm_integral1d_set_reltol (NCM_INTEGRAL1D (int1d_v), prec);
+  ncm_integral1d_set_abstol (NCM_INTEGRAL1D (int1d_v), 0.0);
+
+  ncm_integral1d_eval_vec (NCM_INTEGRAL1D (int1d_v), 0.0, xf, result, err);
+
+  for (k = 0; k < dim - 1; k++)
+  {
+    const gdouble kp1 = k + 1.0;
+    ncm_assert_cmpdouble_e (ncm_vector_get (result, k), ==, (1.0 - cos (kp1 * xf)) / kp1, prec * 10.0, 0.0);
+  }
+  ncm_assert_cmpdouble (ncm_vector_get (result, dim - 1), ==, 0.0);
+  ncm_assert_cmpdouble (ncm_vector_get (err, dim - 1), ==, 0.0);
+
+  ncm_vector_free (result);
+  ncm_vector_free (err);
+  NCM_TEST_FREE (ncm_integral1d_ptr_free, int1d_v);
+}
@@ -0,0 +1,245 @@
+/***************************************************************************
+ *            test_ncm_lh_ratio2d.c
+ *
+ *  Mon October 19 01:37:52 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+#include <gsl/gsl_cdf.h>
+
+#include "ncm_model_mvnd_test.h"
+
+#define TEST_NCM_LH_RATIO2D_DIM 3
+#define TEST_NCM_LH_RATIO2D_NP 40
+
+typedef struct _TestNcmLHRatio2d
+{
+  NcmData *data;
+  NcmMSet *mset;
+  NcmFit *fit;
+  NcmLHRatio2d *lhr2d;
+  gdouble sigma;
+  gdouble rho;
+  gdouble bf[2];
+} TestNcmLHRatio2d;
+
+void test_ncm_lh_ratio2d_new (TestNcmLHRatio2d *test, gconstpointer pdata);
+void test_ncm_lh_ratio2d_free (TestNcmLHRatio2d *test, gconstpointer pdata);
+
+void test_ncm_lh_ratio2d_radial (TestNcmLHRatio2d *test, gconstpointer pdata);
+void test_ncm_lh_ratio2d_radial_bounds (TestNcmLHRatio2d *test, gconstpointer pdata);
+void test_ncm_lh_ratio1d_nthreads (TestNcmLHRatio2d *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add ("/ncm/lh_ratio2d/radial", TestNcmLHRatio2d, NULL,
+              &test_ncm_lh_ratio2d_new,
+              &test_ncm_lh_ratio2d_radial,
+              &test_ncm_lh_ratio2d_free);
+
+  g_test_add ("/ncm/lh_ratio2d/radial/bounds", TestNcmLHRatio2d, NULL,
+              &test_ncm_lh_ratio2d_new,
+              &test_ncm_lh_ratio2d_radial_bounds,
+              &test_ncm_lh_ratio2d_free);
+
+  g_test_add ("/ncm/lh_ratio1d/nthreads", TestNcmLHRatio2d, NULL,
+              &test_ncm_lh_ratio2d_new,
+              &test_ncm_lh_ratio1d_nthreads,
+              &test_ncm_lh_ratio2d_free);
+
+  g_test_run ();
+}
+
+void
+test_ncm_lh_ratio2d_new (TestNcmLHRatio2d *test, gconstpointer pdata)
+{
+  test->sigma = 0.5 + g_test_rand_double ();
+  test->rho   = g_test_rand_double_range (-0.6, 0.6);
+  test->data  = ncm_data_gauss_cov_mvnd_test_new (TEST_NCM_LH_RATIO2D_DIM, test->sigma, test->rho);
+  test->mset  = ncm_data_gauss_cov_mvnd_test_mset_new (test->data);
+  test->fit   = ncm_data_gauss_cov_mvnd_test_fit_new (test->data, test->mset);
+
+  ncm_fit_run (test->fit, NCM_FIT_RUN_MSGS_NONE);
+  ncm_fit_obs_fisher (test->fit);
+
+  test->bf[0] = ncm_mset_fparam_get (test->mset, 0);
+  test->bf[1] = ncm_mset_fparam_get (test->mset, 1);
+
+  /* The third parameter is profiled. */
+  test->lhr2d = ncm_lh_ratio2d_new (test->fit,
+                                    ncm_mset_fparam_get_pi (test->mset, 0),
+                                    ncm_mset_fparam_get_pi (test->mset, 1),
+                                    1.0e-5);
+}
+
+void
+test_ncm_lh_ratio2d_free (TestNcmLHRatio2d *test, gconstpointer pdata)
+{
+  NCM_TEST_FREE (ncm_lh_ratio2d_free, test->lhr2d);
+  NCM_TEST_FREE (ncm_fit_free, test->fit);
+  NCM_TEST_FREE (ncm_mset_free, test->mset);
+  NCM_TEST_FREE (ncm_data_free, test->data);
+}
+
+/*
+ * The profile likelihood of a Gaussian is Gaussian with the marginal
+ * covariance, the border is the ellipse x^T C_{12}^{-1} x = chisq.
+ */
+static gdouble
+_test_ncm_lh_ratio2d_quad (TestNcmLHRatio2d *test, const gdouble p1, const gdouble p2)
+{
+  const gdouble x1 = p1 - test->bf[0];
+  const gdouble x2 = p2 - test->bf[1];
+
+  return (x1 * x1 - 2.0 * test->rho * x1 * x2 + x2 * x2) / (test->sigma * test->sigma * (1.0 - test->rho * test->rho));
+}
+
+static gdouble
+_test_ncm_lh_ratio2d_area (NcmLHRatio2dRegion *rg)
+{
+  gdouble area = 0.0;
+  guint i;
+
+  for (i = 0; i + 1 < rg->np; i++)
+  {
+    area += ncm_vector_get (rg->p1, i) * ncm_vector_get (rg->p2, i + 1) -
+            ncm_vector_get (rg->p1, i + 1) * ncm_vector_get (rg->p2, i);
+  }
+
+  return 0.5 * fabs (area);
+}
+
+void
+test_ncm_lh_ratio2d_radial (TestNcmLHRatio2d *test, gconstpointer pdata)
+{
+  const gdouble clevel = ncm_c_stats_1sigma ();
+  const gdouble chisq  = gsl_cdf_chisq_Qinv (1.0 - clevel, 2.0);
+  const gdouble area   = M_PI * chisq * test->sigma * test->sigma * sqrt (1.0 - test->rho * test->rho);
+  NcmLHRatio2dRegion *rg, *rg_border, *rg_serial;
+  guint i;
+
+  ncm_lh_ratio2d_set_nthreads (test->lhr2d, 4);
+  rg = ncm_lh_ratio2d_conf_region_radial (test->lhr2d, clevel, TEST_NCM_LH_RATIO2D_NP, NCM_FIT_RUN_MSGS_NONE);
+
+  g_assert_cmpuint (rg->np, ==, TEST_NCM_LH_RATIO2D_NP + 1);
+  ncm_assert_cmpdouble (rg->clevel, ==, clevel);
+
+  for (i = 0; i < rg->np; i++)
+    ncm_assert_cmpdouble_e (_test_ncm_lh_ratio2d_quad (test, ncm_vector_get (rg->p1, i), ncm_vector_get (rg->p2, i)), ==, chisq, 1.0e-3, 0.0);
+
+  /* Every point found was also appended to the object. */
+  rg_border = ncm_lh_ratio2d_get_border (test->lhr2d);
+  g_assert_cmpuint (rg_border->np, ==, rg->np);
+  for (i = 0; i < rg->np; i++)
+  {
+    ncm_assert_cmpdouble (ncm_vector_get (rg_border->p1, i), ==, ncm_vector_get (rg->p1, i));
+    ncm_assert_cmpdouble (ncm_vector_get (rg_border->p2, i), ==, ncm_vector_get (rg->p2, i));
+  }
+
+  rg_serial = ncm_lh_ratio2d_conf_region (test->lhr2d, clevel, TEST_NCM_LH_RATIO2D_NP, NCM_FIT_RUN_MSGS_NONE);
+
+  for (i = 0; i < rg_serial->np; i++)
+    ncm_assert_cmpdouble_e (_test_ncm_lh_ratio2d_quad (test, ncm_vector_get (rg_serial->p1, i), ncm_vector_get (rg_serial->p2, i)), ==, chisq, 1.0e-3, 0.0);
+
+  /* Both polygons approximate the same ellipse. */
+  ncm_assert_cmpdouble_e (_test_ncm_lh_ratio2d_area (rg), ==, area, 2.0e-2, 0.0);
+  ncm_assert_cmpdouble_e (_test_ncm_lh_ratio2d_area (rg_serial), ==, area, 2.0e-2, 0.0);
+  ncm_assert_cmpdouble_e (_test_ncm_lh_ratio2d_area (rg), ==, _test_ncm_lh_ratio2d_area (rg_serial), 2.0e-2, 0.0);
+
+  ncm_lh_ratio2d_region_free (rg);
+  ncm_lh_ratio2d_region_free (rg_border);
+  ncm_lh_ratio2d_region_free (rg_serial);
+}
+
+void
+test_ncm_lh_ratio2d_radial_bounds (TestNcmLHRatio2d *test, gconstpointer pdata)
+{
+  const gdouble clevel    = ncm_c_stats_1sigma ();
+  const gdouble chisq     = gsl_cdf_chisq_Qinv (1.0 - clevel, 2.0);
+  const gdouble clevel_1d = gsl_cdf_chisq_P (chisq, 1.0);
+  const guint np          = 4 * TEST_NCM_LH_RATIO2D_NP;
+  NcmLHRatio2dRegion *rg;
+  guint k;
+
+  ncm_lh_ratio2d_set_nthreads (test->lhr2d, 4);
+  rg = ncm_lh_ratio2d_conf_region_radial (test->lhr2d, clevel, np, NCM_FIT_RUN_MSGS_NONE);
+
+  /*
+   * The extremes of the border along each parameter are the 1d profile
+   * likelihood bounds with the same chi-squared difference.
+   */
+  for (k = 0; k < 2; k++)
+  {
+    NcmVector *pk       = (k == 0) ? rg->p1 : rg->p2;
+    NcmLHRatio1d *lhr1d = ncm_lh_ratio1d_new (test->fit, ncm_mset_fparam_get_pi (test->mset, k));
+    gdouble lb, ub;
+
+    ncm_lh_ratio1d_find_bounds (lhr1d, clevel_1d, NCM_FIT_RUN_MSGS_NONE, &lb, &ub);
+
+    lb += test->bf[k];
+    ub += test->bf[k];
+
+    ncm_assert_cmpdouble_e (lb, ==, test->bf[k] - sqrt (chisq) * test->sigma, 1.0e-3, 0.0);
+    ncm_assert_cmpdouble_e (ub, ==, test->bf[k] + sqrt (chisq) * test->sigma, 1.0e-3, 0.0);
+
+    ncm_assert_cmpdouble_e (ncm_vector_get_min (pk), ==, lb, 1.0e-2, 0.0);
+    ncm_assert_cmpdouble_e (ncm_vector_get_max (pk), ==, ub, 1.0e-2, 0.0);
+
+    NCM_TEST_FREE (ncm_lh_ratio1d_free, lhr1d);
+  }
+
+  ncm_lh_ratio2d_region_free (rg);
+}
+
+void
+test_ncm_lh_ratio1d_nthreads (TestNcmLHRatio2d *test, gconstpointer pdata)
+{
+  const gdouble clevel = ncm_c_stats_1sigma ();
+  const gdouble chisq  = gsl_cdf_chisq_Qinv (1.0 - clevel, 1.0);
+  NcmLHRatio1d *lhr1d  = ncm_lh_ratio1d_new (test->fit, ncm_mset_fparam_get_pi (test->mset, 0));
+  gdouble lb, ub, lb_mt, ub_mt;
+
+  ncm_lh_ratio1d_find_bounds (lhr1d, clevel, NCM_FIT_RUN_MSGS_NONE, &lb, &ub);
+
+  ncm_lh_ratio1d_set_nthreads (lhr1d, 2);
+  ncm_lh_ratio1d_find_bounds (lhr1d, clevel, NCM_FIT_RUN_MSGS_NONE, &lb_mt, &ub_mt);
+
+  ncm_assert_cmpdouble_e (lb, ==, -sqrt (chisq) * test->sigma, 1.0e-3, 0.0);
+  ncm_assert_cmpdouble_e (ub, ==, +sqrt (chisq) * test->sigma, 1.0e-3, 0.0);
+
+  ncm_assert_cmpdouble_e (lb_mt, ==, lb, 1.0e-4, 0.0);
+  ncm_assert_cmpdouble_e (ub_mt, ==, ub, 1.0e-4, 0.0);
+
+  NCM_TEST_FREE (ncm_lh_ratio1d_free, lhr1d);
+}
@@ -46,6 +46,7 @@ void test_ncm_mset_setpeek (TestNcmMSet *test, gconstpointer pdata);
 void test_ncm_mset_setpospeek (TestNcmMSet *test, gconstpointer pdata);
 void test_ncm_mset_pushpeek (TestNcmMSet *test, gconstpointer pdata);
 void test_ncm_mset_fparams (TestNcmMSet *test, gconstpointer pdata);
+void test_ncm_mset_fparams_bulk (TestNcmMSet *test, gconstpointer pdata);
 void test_ncm_mset_dup (TestNcmMSet *test, gconstpointer pdata);
 void test_ncm_mset_shallow_copy (TestNcmMSet *test, gconstpointer pdata);
 void test_ncm_mset_saveload (TestNcmMSet *test, gconstpointer pdata);
@@ -81,6 +82,11 @@ main (gint argc, gchar *argv[])
               &test_ncm_mset_fparams, 
               &test_ncm_mset_free);
 
+  g_test_add ("/ncm/mset/fparams/bulk", TestNcmMSet, NULL, 
+              &test_ncm_mset_new, 
+              &test_ncm_mset_fparams_bulk, 
+              &test_ncm_mset_free);
+
   g_test_add ("/ncm/mset/dup", TestNcmMSet, NULL, 
               &test_ncm_mset_new, 
               &test_ncm_mset_dup, 
@@ -294,6 +300,62 @@ test_ncm_mset_fparams (TestNcmMSet *test, gconstpointer pdata)
   nc_cluster_mass_free (benson);
 }
 
+void
+test_ncm_mset_fparams_bulk (TestNcmMSet *test, gconstpointer pdata)
+{
+  NcmSerialize *ser = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+  NcmMSet *mset_dup;
+  NcmVector *x;
+  GArray *pkeys = g_array_new (FALSE, FALSE, sizeof (guint64));
+  guint i;
+
+  ncm_mset_param_set_all_ftype (test->mset, NCM_PARAM_TYPE_FREE);
+  ncm_mset_prepare_fparam_map (test->mset);
+  g_assert_cmpuint (ncm_mset_fparam_len (test->mset), >, 0);
+
+  mset_dup = ncm_mset_dup (test->mset, ser);
+  ncm_mset_prepare_fparam_map (mset_dup);
+  g_assert_cmpuint (ncm_mset_fparam_len (test->mset), ==, ncm_mset_fparam_len (mset_dup));
+
+  x = ncm_vector_new (ncm_mset_fparam_len (test->mset));
+  ncm_mset_fparams_get_vector (test->mset, x);
+  for (i = 0; i < ncm_vector_len (x); i++)
+    ncm_vector_set (x, i, ncm_vector_get (x, i) * (1.0 + g_test_rand_double_range (-0.1, 0.1)) + 1.0e-3);
+
+  for (i = 0; i < ncm_mset_nmodels (test->mset); i++)
+  {
+    NcmModel *model = ncm_mset_peek_array_pos (test->mset, i);
+    g_array_append_val (pkeys, model->pkey);
+  }
+
+  ncm_mset_fparams_set_vector (test->mset, x);
+  for (i = 0; i < ncm_mset_fparam_len (mset_dup); i++)
+    ncm_mset_fparam_set (mset_dup, i, ncm_vector_get (x, i));
+
+  for (i = 0; i < ncm_mset_nmodels (test->mset); i++)
+  {
+    NcmModel *model0 = ncm_mset_peek_array_pos (test->mset, i);
+    NcmModel *model1 = ncm_mset_peek_array_pos (mset_dup, i);
+    guint pid;
+
+    g_assert_cmpuint (model0->pkey, ==, g_array_index (pkeys, guint64, i) + 1);
+
+    for (pid = 0; pid < ncm_model_len (model0); pid++)
+    {
+      ncm_assert_cmpdouble (ncm_model_param_get (model0, pid), ==, ncm_model_param_get (model1, pid));
+      ncm_assert_cmpdouble (ncm_model_orig_param_get (model0, pid), ==, ncm_model_orig_param_get (model1, pid));
+    }
+  }
+
+  for (i = 0; i < ncm_mset_fparam_len (test->mset); i++)
+    ncm_assert_cmpdouble (ncm_mset_fparam_get (test->mset, i), ==, ncm_vector_get (x, i));
+
+  g_array_unref (pkeys);
+  ncm_vector_free (x);
+  ncm_mset_clear (&mset_dup);
+  ncm_serialize_clear (&ser);
+}
+
 void
 test_ncm_mset_dup (TestNcmMSet *test, gconstpointer pdata)
 {
@@ -0,0 +1,326 @@
+/***************************************************************************
+ *            test_ncm_mset_catalog.c
+ *
+ *  Sun October 18 22:31:08 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_statistics_double.h>
+
+#define TEST_NCM_MSET_CATALOG_LEN      211
+#define TEST_NCM_MSET_CATALOG_BLOCK    64
+#define TEST_NCM_MSET_CATALOG_NTHREADS 4
+
+typedef struct _TestNcmMSetCatalog
+{
+  NcDistance *dist;
+  NcmMSet *mset;
+  NcmMSetCatalog *mcat;
+  NcmVector *p0;
+  NcmVector *z;
+} TestNcmMSetCatalog;
+
+void test_ncm_mset_catalog_new (TestNcmMSetCatalog *test, gconstpointer pdata);
+void test_ncm_mset_catalog_free (TestNcmMSetCatalog *test, gconstpointer pdata);
+
+void test_ncm_mset_catalog_func_rows (TestNcmMSetCatalog *test, gconstpointer pdata);
+void test_ncm_mset_catalog_func_eval_blocks (TestNcmMSetCatalog *test, gconstpointer pdata);
+void test_ncm_mset_catalog_ci_direct (TestNcmMSetCatalog *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add ("/ncm/mset/catalog/func_rows", TestNcmMSetCatalog, NULL,
+              &test_ncm_mset_catalog_new,
+              &test_ncm_mset_catalog_func_rows,
+              &test_ncm_mset_catalog_free);
+
+  g_test_add ("/ncm/mset/catalog/func_eval/blocks", TestNcmMSetCatalog, NULL,
+              &test_ncm_mset_catalog_new,
+              &test_ncm_mset_catalog_func_eval_blocks,
+              &test_ncm_mset_catalog_free);
+
+  g_test_add ("/ncm/mset/catalog/ci_direct", TestNcmMSetCatalog, NULL,
+              &test_ncm_mset_catalog_new,
+              &test_ncm_mset_catalog_ci_direct,
+              &test_ncm_mset_catalog_free);
+
+  g_test_run ();
+}
+
+void
+test_ncm_mset_catalog_new (TestNcmMSetCatalog *test, gconstpointer pdata)
+{
+  NcHICosmo *cosmo = NC_HICOSMO (nc_hicosmo_de_xcdm_new ());
+  guint i;
+
+  test->dist = nc_distance_new (3.0);
+  test->mset = ncm_mset_new (cosmo, NULL);
+  test->z    = ncm_vector_new (5);
+
+  ncm_model_param_set_ftype (NCM_MODEL (cosmo), NC_HICOSMO_DE_OMEGA_C, NCM_PARAM_TYPE_FREE);
+  ncm_model_param_set_ftype (NCM_MODEL (cosmo), NC_HICOSMO_DE_OMEGA_X, NCM_PARAM_TYPE_FREE);
+  ncm_model_param_set_ftype (NCM_MODEL (cosmo), NC_HICOSMO_DE_XCDM_W,  NCM_PARAM_TYPE_FREE);
+  ncm_mset_prepare_fparam_map (test->mset);
+
+  test->p0   = ncm_vector_new (ncm_mset_fparams_len (test->mset));
+  test->mcat = ncm_mset_catalog_new (test->mset, 1, 1, FALSE, "m2lnL", "-2\\ln(L)", NULL);
+
+  for (i = 0; i < ncm_vector_len (test->z); i++)
+    ncm_vector_set (test->z, i, 0.1 + 0.5 * i);
+
+  for (i = 0; i < TEST_NCM_MSET_CATALOG_LEN; i++)
+  {
+    ncm_model_param_set (NCM_MODEL (cosmo), NC_HICOSMO_DE_OMEGA_C, g_test_rand_double_range (0.20, 0.30));
+    ncm_model_param_set (NCM_MODEL (cosmo), NC_HICOSMO_DE_OMEGA_X, g_test_rand_double_range (0.65, 0.75));
+    ncm_model_param_set (NCM_MODEL (cosmo), NC_HICOSMO_DE_XCDM_W,  g_test_rand_double_range (-1.1, -0.9));
+
+    ncm_mset_catalog_add_from_mset (test->mcat, test->mset, g_test_rand_double (), NULL);
+  }
+
+  /* The catalog evaluation must leave the mset at this point. */
+  ncm_model_param_set (NCM_MODEL (cosmo), NC_HICOSMO_DE_OMEGA_C, 0.25);
+  ncm_model_param_set (NCM_MODEL (cosmo), NC_HICOSMO_DE_OMEGA_X, 0.70);
+  ncm_model_param_set (NCM_MODEL (cosmo), NC_HICOSMO_DE_XCDM_W,  -1.0);
+  ncm_mset_fparams_get_vector (test->mset, test->p0);
+
+  nc_hicosmo_free (cosmo);
+}
+
+void
+test_ncm_mset_catalog_free (TestNcmMSetCatalog *test, gconstpointer pdata)
+{
+  NCM_TEST_FREE (ncm_mset_catalog_free, test->mcat);
+  NCM_TEST_FREE (ncm_mset_free, test->mset);
+  NCM_TEST_FREE (nc_distance_free, test->dist);
+  ncm_vector_free (test->p0);
+  ncm_vector_free (test->z);
+}
+
+static void
+_test_ncm_mset_catalog_assert_mset (TestNcmMSetCatalog *test)
+{
+  NcmVector *p = ncm_vector_new (ncm_mset_fparams_len (test->mset));
+  guint i;
+
+  ncm_mset_fparams_get_vector (test->mset, p);
+  for (i = 0; i < ncm_vector_len (p); i++)
+    ncm_assert_cmpdouble (ncm_vector_get (p, i), ==, ncm_vector_get (test->p0, i));
+
+  ncm_vector_free (p);
+}
+
+/*
+ * Reference values computed row by row in the catalog mset.
+ */
+static NcmMatrix *
+_test_ncm_mset_catalog_func_serial (TestNcmMSetCatalog *test, NcmMSetFunc *func, NcmVector *x_v)
+{
+  const guint cat_len = ncm_mset_catalog_len (test->mcat);
+  const guint ncols   = (x_v != NULL) ? ncm_vector_len (x_v) : ncm_mset_func_get_dim (func);
+  NcmMatrix *res      = ncm_matrix_new (cat_len, ncols);
+  guint i, j;
+
+  for (i = 0; i < cat_len; i++)
+  {
+    NcmVector *row = ncm_mset_catalog_peek_row (test->mcat, i);
+
+    ncm_mset_fparams_set_vector_offset (test->mset, row, 1);
+
+    if (x_v != NULL)
+    {
+      for (j = 0; j < ncols; j++)
+        ncm_mset_func_eval (func, test->mset, ncm_vector_ptr (x_v, j), ncm_matrix_ptr (res, i, j));
+    }
+    else
+      ncm_mset_func_eval (func, test->mset, NULL, ncm_matrix_ptr (res, i, 0));
+  }
+
+  ncm_mset_fparams_set_vector (test->mset, test->p0);
+
+  return res;
+}
+
+static void
+_test_ncm_mset_catalog_assert_rows (NcmMatrix *res, guint row_i, NcmMatrix *res_ref)
+{
+  guint i, j;
+
+  for (i = 0; i < ncm_matrix_nrows (res); i++)
+  {
+    for (j = 0; j < ncm_matrix_ncols (res); j++)
+      ncm_assert_cmpdouble (ncm_matrix_get (res, i, j), ==, ncm_matrix_get (res_ref, row_i + i, j));
+  }
+}
+
+void
+test_ncm_mset_catalog_func_rows (TestNcmMSetCatalog *test, gconstpointer pdata)
+{
+  const guint cat_len   = ncm_mset_catalog_len (test->mcat);
+  NcmMSetFunc *func     = NCM_MSET_FUNC (ncm_mset_func_list_new_ns_name ("NcDistance", "comoving", G_OBJECT (test->dist)));
+  NcmMSetFunc *func_c   = NCM_MSET_FUNC (ncm_mset_func_list_new_ns_name ("NcDistance", "comoving", G_OBJECT (test->dist)));
+  NcmMatrix *res_ref, *res_ref_c;
+  guint nthreads;
+
+  ncm_mset_func_set_eval_x (func_c, ncm_vector_data (test->z), ncm_vector_len (test->z));
+  g_assert (ncm_mset_func_is_const (func_c));
+
+  res_ref   = _test_ncm_mset_catalog_func_serial (test, func, test->z);
+  res_ref_c = _test_ncm_mset_catalog_func_serial (test, func_c, NULL);
+
+  for (nthreads = 1; nthreads <= TEST_NCM_MSET_CATALOG_NTHREADS; nthreads += TEST_NCM_MSET_CATALOG_NTHREADS - 1)
+  {
+    NcmMatrix *res   = ncm_matrix_new (cat_len, ncm_vector_len (test->z));
+    NcmMatrix *res_c = ncm_matrix_new (cat_len, ncm_mset_func_get_dim (func_c));
+    NcmMatrix *res_t = ncm_matrix_new (TEST_NCM_MSET_CATALOG_BLOCK, ncm_vector_len (test->z));
+
+    ncm_mset_catalog_set_nthreads (test->mcat, nthreads);
+    g_assert_cmpuint (ncm_mset_catalog_get_nthreads (test->mcat), ==, nthreads);
+
+    ncm_mset_catalog_calc_func_rows (test->mcat, func, test->z, 0, res);
+    _test_ncm_mset_catalog_assert_mset (test);
+    _test_ncm_mset_catalog_assert_rows (res, 0, res_ref);
+
+    ncm_mset_catalog_calc_func_rows (test->mcat, func_c, NULL, 0, res_c);
+    _test_ncm_mset_catalog_assert_mset (test);
+    _test_ncm_mset_catalog_assert_rows (res_c, 0, res_ref_c);
+
+    /* Last rows of the catalog. */
+    ncm_mset_catalog_calc_func_rows (test->mcat, func, test->z, cat_len - TEST_NCM_MSET_CATALOG_BLOCK, res_t);
+    _test_ncm_mset_catalog_assert_mset (test);
+    _test_ncm_mset_catalog_assert_rows (res_t, cat_len - TEST_NCM_MSET_CATALOG_BLOCK, res_ref);
+
+    ncm_matrix_free (res);
+    ncm_matrix_free (res_c);
+    ncm_matrix_free (res_t);
+  }
+
+  ncm_matrix_free (res_ref);
+  ncm_matrix_free (res_ref_c);
+  ncm_mset_func_free (func);
+  ncm_mset_func_free (func_c);
+}
+
+void
+test_ncm_mset_catalog_func_eval_blocks (TestNcmMSetCatalog *test, gconstpointer pdata)
+{
+  const guint cat_len = ncm_mset_catalog_len (test->mcat);
+  NcmMSetFunc *func   = NCM_MSET_FUNC (ncm_mset_func_list_new_ns_name ("NcDistance", "comoving", G_OBJECT (test->dist)));
+  NcmMatrix *res_ref;
+  NcmMSetCatalogFuncEval *fe;
+  guint bi;
+
+  ncm_mset_func_set_eval_x (func, ncm_vector_data (test->z), ncm_vector_len (test->z));
+  res_ref = _test_ncm_mset_catalog_func_serial (test, func, NULL);
+
+  ncm_mset_catalog_set_nthreads (test->mcat, TEST_NCM_MSET_CATALOG_NTHREADS);
+
+  /* The same context is used for every block, as in mcat_analyze --dist-tab. */
+  fe = ncm_mset_catalog_func_eval_new (test->mcat, func, NULL);
+
+  for (bi = 0; bi < cat_len; bi += TEST_NCM_MSET_CATALOG_BLOCK)
+  {
+    const guint nrows = GSL_MIN (TEST_NCM_MSET_CATALOG_BLOCK, cat_len - bi);
+    NcmMatrix *res    = ncm_matrix_new (nrows, ncm_mset_func_get_dim (func));
+
+    ncm_mset_catalog_func_eval_rows (fe, bi, res);
+    _test_ncm_mset_catalog_assert_mset (test);
+    _test_ncm_mset_catalog_assert_rows (res, bi, res_ref);
+
+    ncm_matrix_free (res);
+  }
+
+  ncm_mset_catalog_func_eval_free (fe);
+
+  ncm_matrix_free (res_ref);
+  ncm_mset_func_free (func);
+}
+
+void
+test_ncm_mset_catalog_ci_direct (TestNcmMSetCatalog *test, gconstpointer pdata)
+{
+  const guint cat_len = ncm_mset_catalog_len (test->mcat);
+  const guint dim     = ncm_vector_len (test->z);
+  const gdouble pv[2] = {0.6827, 0.9545};
+  GArray *p_val       = g_array_new (FALSE, FALSE, sizeof (gdouble));
+  NcmMSetFunc *func   = NCM_MSET_FUNC (ncm_mset_func_list_new_ns_name ("NcDistance", "comoving", G_OBJECT (test->dist)));
+  NcmMatrix *res      = ncm_matrix_new (cat_len, dim);
+  NcmMatrix *ci_serial, *ci_mt;
+  guint i, j;
+
+  g_array_append_vals (p_val, pv, 2);
+
+  ncm_mset_catalog_set_nthreads (test->mcat, 1);
+  ci_serial = ncm_mset_catalog_calc_ci_direct (test->mcat, func, test->z, p_val);
+  _test_ncm_mset_catalog_assert_mset (test);
+
+  ncm_mset_catalog_set_nthreads (test->mcat, TEST_NCM_MSET_CATALOG_NTHREADS);
+  ci_mt = ncm_mset_catalog_calc_ci_direct (test->mcat, func, test->z, p_val);
+  _test_ncm_mset_catalog_assert_mset (test);
+
+  ncm_mset_catalog_calc_func_rows (test->mcat, func, test->z, 0, res);
+
+  for (i = 0; i < dim; i++)
+  {
+    NcmVector *col = ncm_matrix_get_col (res, i);
+    gdouble *col_data;
+
+    for (j = 0; j < ncm_matrix_ncols (ci_serial); j++)
+      ncm_assert_cmpdouble (ncm_matrix_get (ci_mt, i, j), ==, ncm_matrix_get (ci_serial, i, j));
+
+    /* The statistics of the rows computed by calc_func_rows match the serial ones. */
+    col_data = ncm_vector_ptr (col, 0);
+    gsl_sort (col_data, ncm_vector_stride (col), cat_len);
+
+    ncm_assert_cmpdouble (ncm_matrix_get (ci_serial, i, 0), ==, gsl_stats_mean (col_data, ncm_vector_stride (col), cat_len));
+
+    for (j = 0; j < p_val->len; j++)
+    {
+      const gdouble p  = g_array_index (p_val, gdouble, j);
+      const gdouble lb = gsl_stats_quantile_from_sorted_data (col_data, ncm_vector_stride (col), cat_len, (1.0 - p) / 2.0);
+      const gdouble ub = gsl_stats_quantile_from_sorted_data (col_data, ncm_vector_stride (col), cat_len, (1.0 + p) / 2.0);
+
+      ncm_assert_cmpdouble (ncm_matrix_get (ci_serial, i, 1 + 2 * j + 0), ==, lb);
+      ncm_assert_cmpdouble (ncm_matrix_get (ci_serial, i, 1 + 2 * j + 1), ==, ub);
+    }
+
+    ncm_vector_free (col);
+  }
+
+  ncm_matrix_free (ci_serial);
+  ncm_matrix_free (ci_mt);
+  ncm_matrix_free (res);
+  ncm_mset_func_free (func);
+  g_array_unref (p_val);
+}
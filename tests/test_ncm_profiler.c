@@ -0,0 +1,322 @@
+/***************************************************************************
+ *            test_ncm_profiler.c
+ *
+ *  Sun October 18 20:41:07 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <string.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <glib-object.h>
+
+#define TEST_NCM_PROFILER_NTHREADS 4
+#define TEST_NCM_PROFILER_NCALLS   20000
+
+typedef struct _TestNcmProfiler
+{
+  gchar *filename;
+} TestNcmProfiler;
+
+void test_ncm_profiler_new (TestNcmProfiler *test, gconstpointer pdata);
+void test_ncm_profiler_free (TestNcmProfiler *test, gconstpointer pdata);
+
+void test_ncm_profiler_disabled (TestNcmProfiler *test, gconstpointer pdata);
+void test_ncm_profiler_report_json (TestNcmProfiler *test, gconstpointer pdata);
+void test_ncm_profiler_model_ctrl (TestNcmProfiler *test, gconstpointer pdata);
+void test_ncm_profiler_reset (TestNcmProfiler *test, gconstpointer pdata);
+void test_ncm_profiler_reset_threaded (TestNcmProfiler *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add ("/ncm/profiler/disabled", TestNcmProfiler, NULL,
+              &test_ncm_profiler_new,
+              &test_ncm_profiler_disabled,
+              &test_ncm_profiler_free);
+
+  g_test_add ("/ncm/profiler/report_json", TestNcmProfiler, NULL,
+              &test_ncm_profiler_new,
+              &test_ncm_profiler_report_json,
+              &test_ncm_profiler_free);
+
+  g_test_add ("/ncm/profiler/model_ctrl", TestNcmProfiler, NULL,
+              &test_ncm_profiler_new,
+              &test_ncm_profiler_model_ctrl,
+              &test_ncm_profiler_free);
+
+  g_test_add ("/ncm/profiler/reset", TestNcmProfiler, NULL,
+              &test_ncm_profiler_new,
+              &test_ncm_profiler_reset,
+              &test_ncm_profiler_free);
+
+  g_test_add ("/ncm/profiler/reset/threaded", TestNcmProfiler, NULL,
+              &test_ncm_profiler_new,
+              &test_ncm_profiler_reset_threaded,
+              &test_ncm_profiler_free);
+
+  g_test_run ();
+}
+
+void
+test_ncm_profiler_new (TestNcmProfiler *test, gconstpointer pdata)
+{
+  test->filename = g_strdup_printf ("test-ncm-profiler-%d.json", g_test_rand_int_range (0, 1000000));
+
+  ncm_profiler_disable ();
+  ncm_profiler_reset ();
+  ncm_profiler_set_report_file (test->filename);
+}
+
+void
+test_ncm_profiler_free (TestNcmProfiler *test, gconstpointer pdata)
+{
+  ncm_profiler_disable ();
+  ncm_profiler_reset ();
+  ncm_profiler_set_report_file (NULL);
+
+  g_unlink (test->filename);
+  g_free (test->filename);
+}
+
+static void
+_test_ncm_profiler_assert_entry (const gchar *json, const gchar *name, guint64 ncalls, guint64 nhits, guint64 nmisses)
+{
+  gchar *entry = g_strdup_printf ("{\"name\": \"%s\", \"ncalls\": %" G_GUINT64_FORMAT ", \"hits\": %" G_GUINT64_FORMAT ", \"misses\": %" G_GUINT64_FORMAT ",",
+                                  name, ncalls, nhits, nmisses);
+
+  if (strstr (json, entry) == NULL)
+    g_error ("_test_ncm_profiler_assert_entry: entry `%s' not found in report:\n%s", entry, json);
+
+  g_free (entry);
+}
+
+void
+test_ncm_profiler_disabled (TestNcmProfiler *test, gconstpointer pdata)
+{
+  g_assert (!ncm_profiler_is_enabled ());
+
+  {
+    const gdouble t0 = ncm_profiler_start ();
+    ncm_assert_cmpdouble (t0, <, 0.0);
+    ncm_profiler_stop ("test:disabled", t0);
+  }
+
+  {
+    NcmModelCtrl *ctrl = ncm_model_ctrl_new (NULL);
+    NcmModel *model    = NCM_MODEL (nc_hicosmo_lcdm_new ());
+
+    g_assert (ncm_model_ctrl_update (ctrl, model));
+    g_assert (!ncm_model_ctrl_update (ctrl, model));
+
+    NCM_TEST_FREE (ncm_model_ctrl_free, ctrl);
+    NCM_TEST_FREE (ncm_model_free, model);
+  }
+
+  {
+    gchar *json = ncm_profiler_report_json ();
+
+    g_assert (strstr (json, "\"entries\": [\n  ]") != NULL);
+    g_assert (strstr (json, "test:disabled") == NULL);
+    g_assert (strstr (json, "NcHICosmoLCDM") == NULL);
+    g_free (json);
+  }
+
+  ncm_profiler_report_if_enabled ();
+  g_assert (!g_file_test (test->filename, G_FILE_TEST_EXISTS));
+}
+
+void
+test_ncm_profiler_report_json (TestNcmProfiler *test, gconstpointer pdata)
+{
+  guint i;
+
+  ncm_profiler_enable ();
+  g_assert (ncm_profiler_is_enabled ());
+
+  for (i = 0; i < 100; i++)
+    ncm_profiler_add_call ("test:slow", 2.0e-3);
+
+  for (i = 0; i < 10; i++)
+    ncm_profiler_add_call ("test:fast", 1.0e-6 * (i + 1));
+
+  ncm_profiler_add_hit ("test:cache", FALSE);
+  ncm_profiler_add_hit ("test:cache", FALSE);
+  ncm_profiler_add_hit ("test:cache", TRUE);
+
+  {
+    const gdouble t0 = ncm_profiler_start ();
+    ncm_assert_cmpdouble (t0, >=, 0.0);
+    ncm_profiler_stop ("test:\"quoted\"", t0);
+  }
+
+  ncm_profiler_report_if_enabled ();
+  g_assert (g_file_test (test->filename, G_FILE_TEST_EXISTS));
+
+  {
+    GError *error = NULL;
+    gchar *json   = NULL;
+    gchar *slow, *fast;
+
+    if (!g_file_get_contents (test->filename, &json, NULL, &error))
+      g_error ("test_ncm_profiler_report_json: %s", error->message);
+
+    g_assert (g_str_has_prefix (json, "{\n  \"wall-time\": "));
+    g_assert (g_str_has_suffix (json, "\n  ]\n}\n"));
+
+    _test_ncm_profiler_assert_entry (json, "test:slow", 100, 0, 0);
+    _test_ncm_profiler_assert_entry (json, "test:fast", 10, 0, 0);
+    _test_ncm_profiler_assert_entry (json, "test:cache", 0, 2, 1);
+    _test_ncm_profiler_assert_entry (json, "test:\\\"quoted\\\"", 1, 0, 0);
+
+    g_assert (strstr (json, "\"total\": 2.000000000e-01") != NULL);
+    g_assert (strstr (json, "\"mean\": 2.000000000e-03") != NULL);
+    g_assert (strstr (json, "\"min\": 1.000000000e-06") != NULL);
+    g_assert (strstr (json, "\"max\": 1.000000000e-05") != NULL);
+
+    /* Entries are sorted by cumulative time. */
+    slow = strstr (json, "\"test:slow\"");
+    fast = strstr (json, "\"test:fast\"");
+    g_assert (slow != NULL && fast != NULL);
+    g_assert (slow < fast);
+
+    g_free (json);
+  }
+}
+
+void
+test_ncm_profiler_model_ctrl (TestNcmProfiler *test, gconstpointer pdata)
+{
+  NcmModelCtrl *ctrl = ncm_model_ctrl_new (NULL);
+  NcmModel *model    = NCM_MODEL (nc_hicosmo_lcdm_new ());
+
+  ncm_profiler_enable ();
+
+  g_assert (ncm_model_ctrl_update (ctrl, model));
+  g_assert (!ncm_model_ctrl_update (ctrl, model));
+  g_assert (!ncm_model_ctrl_update (ctrl, model));
+
+  ncm_model_orig_param_set (model, 0, ncm_model_orig_param_get (model, 0) * 0.999);
+  g_assert (ncm_model_ctrl_update (ctrl, model));
+
+  {
+    gchar *json = ncm_profiler_report_json ();
+
+    _test_ncm_profiler_assert_entry (json, "NcHICosmoLCDM", 0, 2, 2);
+    g_free (json);
+  }
+
+  NCM_TEST_FREE (ncm_model_ctrl_free, ctrl);
+  NCM_TEST_FREE (ncm_model_free, model);
+}
+
+void
+test_ncm_profiler_reset (TestNcmProfiler *test, gconstpointer pdata)
+{
+  gchar *json;
+
+  ncm_profiler_enable ();
+
+  ncm_profiler_add_call ("test:reset", 1.0);
+  ncm_profiler_add_hit ("test:reset", TRUE);
+
+  json = ncm_profiler_report_json ();
+  _test_ncm_profiler_assert_entry (json, "test:reset", 1, 0, 1);
+  g_free (json);
+
+  ncm_profiler_reset ();
+
+  json = ncm_profiler_report_json ();
+  g_assert (strstr (json, "test:reset") == NULL);
+  g_free (json);
+
+  /* The entry is reused after a reset and its statistics start over. */
+  ncm_profiler_add_call ("test:reset", 3.0e-3);
+
+  json = ncm_profiler_report_json ();
+  _test_ncm_profiler_assert_entry (json, "test:reset", 1, 0, 0);
+  g_assert (strstr (json, "\"min\": 3.000000000e-03") != NULL);
+  g_assert (strstr (json, "\"max\": 3.000000000e-03") != NULL);
+  g_assert (strstr (json, "\"p50\": 3.000000000e-03") != NULL);
+  g_free (json);
+}
+
+static gpointer
+_test_ncm_profiler_add_calls (gpointer data)
+{
+  gint *done = data;
+  guint i;
+
+  for (i = 0; i < TEST_NCM_PROFILER_NCALLS; i++)
+  {
+    ncm_profiler_add_call ("test:threaded", 1.0e-6);
+    ncm_profiler_add_hit ("test:threaded", i % 2);
+  }
+
+  g_atomic_int_inc (done);
+
+  return NULL;
+}
+
+void
+test_ncm_profiler_reset_threaded (TestNcmProfiler *test, gconstpointer pdata)
+{
+  GThread *threads[TEST_NCM_PROFILER_NTHREADS];
+  gint done = 0;
+  guint i;
+
+  ncm_profiler_enable ();
+
+  for (i = 0; i < TEST_NCM_PROFILER_NTHREADS; i++)
+    threads[i] = g_thread_new ("test_ncm_profiler", &_test_ncm_profiler_add_calls, &done);
+
+  while (g_atomic_int_get (&done) < TEST_NCM_PROFILER_NTHREADS)
+  {
+    gchar *json;
+
+    ncm_profiler_reset ();
+    json = ncm_profiler_report_json ();
+    g_free (json);
+  }
+
+  for (i = 0; i < TEST_NCM_PROFILER_NTHREADS; i++)
+    g_thread_join (threads[i]);
+
+  ncm_profiler_reset ();
+  ncm_profiler_add_call ("test:threaded", 1.0e-6);
+
+  {
+    gchar *json = ncm_profiler_report_json ();
+
+    _test_ncm_profiler_assert_entry (json, "test:threaded", 1, 0, 0);
+    g_free (json);
+  }
+}
@@ -0,0 +1,303 @@
+/***************************************************************************
+ *            test_ncm_rng.c
+ *
+ *  Sun October 18 21:24:50 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * numcosmo
+ * Copyright (C) Sandro Dias Pinto Vitenti 2026 <sandro@isoftware.com.br>
+ * numcosmo is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * numcosmo is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#undef GSL_RANGE_CHECK_OFF
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+#include <math.h>
+#include <glib.h>
+#include <glib-object.h>
+
+#define TEST_NCM_RNG_NDRAWS 1031
+
+typedef struct _TestNcmRNG
+{
+  NcmRNG *rng;
+} TestNcmRNG;
+
+void test_ncm_rng_new (TestNcmRNG *test, gconstpointer pdata);
+void test_ncm_rng_free (TestNcmRNG *test, gconstpointer pdata);
+
+void test_ncm_rng_philox_kat (TestNcmRNG *test, gconstpointer pdata);
+void test_ncm_rng_philox_uniform (TestNcmRNG *test, gconstpointer pdata);
+void test_ncm_rng_state_roundtrip (TestNcmRNG *test, gconstpointer pdata);
+void test_ncm_rng_substream (TestNcmRNG *test, gconstpointer pdata);
+void test_ncm_rng_substream_state (TestNcmRNG *test, gconstpointer pdata);
+
+gint
+main (gint argc, gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+  ncm_cfg_init ();
+  ncm_cfg_enable_gsl_err_handler ();
+
+  g_test_add ("/ncm/rng/philox4x32/kat", TestNcmRNG, NULL,
+              &test_ncm_rng_new,
+              &test_ncm_rng_philox_kat,
+              &test_ncm_rng_free);
+
+  g_test_add ("/ncm/rng/philox4x32/uniform", TestNcmRNG, NULL,
+              &test_ncm_rng_new,
+              &test_ncm_rng_philox_uniform,
+              &test_ncm_rng_free);
+
+  g_test_add ("/ncm/rng/philox4x32/state_roundtrip", TestNcmRNG, NULL,
+              &test_ncm_rng_new,
+              &test_ncm_rng_state_roundtrip,
+              &test_ncm_rng_free);
+
+  g_test_add ("/ncm/rng/philox4x32/substream", TestNcmRNG, NULL,
+              &test_ncm_rng_new,
+              &test_ncm_rng_substream,
+              &test_ncm_rng_free);
+
+  g_test_add ("/ncm/rng/philox4x32/substream/state", TestNcmRNG, NULL,
+              &test_ncm_rng_new,
+              &test_ncm_rng_substream_state,
+              &test_ncm_rng_free);
+
+  g_test_run ();
+}
+
+void
+test_ncm_rng_new (TestNcmRNG *test, gconstpointer pdata)
+{
+  test->rng = ncm_rng_seeded_new (NCM_RNG_PHILOX4X32_NAME, g_test_rand_int ());
+
+  g_assert (ncm_rng_has_substreams (test->rng));
+  g_assert_cmpstr (ncm_rng_get_algo (test->rng), ==, NCM_RNG_PHILOX4X32_NAME);
+}
+
+void
+test_ncm_rng_free (TestNcmRNG *test, gconstpointer pdata)
+{
+  NCM_TEST_FREE (ncm_rng_free, test->rng);
+}
+
+/*
+ * The state of the philox4x32 generator is {key[2], ctr[4], out[4], pos},
+ * setting pos = 4 forces the next draw to compute the block of ctr.
+ */
+static void
+_test_ncm_rng_philox_set_block (NcmRNG *rng, const guint32 key[2], const guint32 ctr[4])
+{
+  guint32 state[11] = {key[0], key[1], ctr[0], ctr[1], ctr[2], ctr[3], 0, 0, 0, 0, 4};
+  gchar *state_b64  = g_base64_encode ((const guchar *) state, sizeof (state));
+
+  ncm_rng_set_state (rng, state_b64);
+  g_free (state_b64);
+}
+
+void
+test_ncm_rng_philox_kat (TestNcmRNG *test, gconstpointer pdata)
+{
+  /* Known answer vectors from the Random123 distribution (kat_vectors, philox4x32 10 rounds). */
+  const guint32 kat[3][10] = {
+    {0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+     0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+    {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+     0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+    {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+     0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1},
+  };
+  guint i;
+
+  g_assert_cmpuint (gsl_rng_size (test->rng->r), ==, 11 * sizeof (guint32));
+
+  for (i = 0; i < 3; i++)
+  {
+    const guint32 *ctr = &kat[i][0];
+    const guint32 *key = &kat[i][4];
+    guint j;
+
+    _test_ncm_rng_philox_set_block (test->rng, key, ctr);
+
+    for (j = 0; j < 4; j++)
+      g_assert_cmphex (gsl_rng_get (test->rng->r), ==, kat[i][6 + j]);
+  }
+}
+
+void
+test_ncm_rng_philox_uniform (TestNcmRNG *test, gconstpointer pdata)
+{
+  const guint n = 100000;
+  gdouble mean  = 0.0;
+  gdouble var   = 0.0;
+  guint i;
+
+  for (i = 0; i < n; i++)
+  {
+    const gdouble u = gsl_rng_uniform (test->rng->r);
+
+    g_assert_cmpfloat (u, >=, 0.0);
+    g_assert_cmpfloat (u, <, 1.0);
+
+    mean += u;
+    var  += u * u;
+  }
+
+  mean /= n;
+  var   = var / n - mean * mean;
+
+  /* Five sigma bounds for the sample mean and variance of U(0, 1). */
+  g_assert_cmpfloat (fabs (mean - 0.5), <, 5.0 * sqrt (1.0 / 12.0 / n));
+  g_assert_cmpfloat (fabs (var - 1.0 / 12.0), <, 5.0 * sqrt (1.0 / 180.0 / n));
+}
+
+void
+test_ncm_rng_state_roundtrip (TestNcmRNG *test, gconstpointer pdata)
+{
+  NcmRNG *rng_dup = ncm_rng_new (NCM_RNG_PHILOX4X32_NAME);
+  gulong draws[TEST_NCM_RNG_NDRAWS];
+  gchar *state;
+  guint i;
+
+  /* Leaves the generator in the middle of a block. */
+  for (i = 0; i < (guint) g_test_rand_int_range (1, 4 * 16); i++)
+    gsl_rng_get (test->rng->r);
+
+  state = ncm_rng_get_state (test->rng);
+
+  for (i = 0; i < TEST_NCM_RNG_NDRAWS; i++)
+    draws[i] = gsl_rng_get (test->rng->r);
+
+  ncm_rng_set_state (rng_dup, state);
+  for (i = 0; i < TEST_NCM_RNG_NDRAWS; i++)
+    g_assert_cmpuint (gsl_rng_get (rng_dup->r), ==, draws[i]);
+
+  /* Restoring the state in the original object rewinds it. */
+  ncm_rng_set_state (test->rng, state);
+  for (i = 0; i < TEST_NCM_RNG_NDRAWS; i++)
+    g_assert_cmpuint (gsl_rng_get (test->rng->r), ==, draws[i]);
+
+  /* The state is also carried by the serialized object. */
+  ncm_rng_set_state (test->rng, state);
+  {
+    NcmRNG *rng_ser = NCM_RNG (ncm_serialize_global_dup_obj (G_OBJECT (test->rng)));
+
+    g_assert_cmpstr (ncm_rng_get_algo (rng_ser), ==, NCM_RNG_PHILOX4X32_NAME);
+    for (i = 0; i < TEST_NCM_RNG_NDRAWS; i++)
+      g_assert_cmpuint (gsl_rng_get (rng_ser->r), ==, draws[i]);
+
+    NCM_TEST_FREE (ncm_rng_free, rng_ser);
+  }
+
+  g_free (state);
+  NCM_TEST_FREE (ncm_rng_free, rng_dup);
+}
+
+void
+test_ncm_rng_substream (TestNcmRNG *test, gconstpointer pdata)
+{
+  const guint nsub = 8;
+  gulong draws[8][32];
+  gchar *master_state = ncm_rng_get_state (test->rng);
+  guint k, i;
+
+  for (k = 0; k < nsub; k++)
+  {
+    NcmRNG *sub = ncm_rng_substream_new (test->rng, k);
+
+    g_assert (ncm_rng_has_substreams (sub));
+    for (i = 0; i < 32; i++)
+      draws[k][i] = gsl_rng_get (sub->r);
+
+    NCM_TEST_FREE (ncm_rng_free, sub);
+  }
+
+  /* Setting substreams does not change the master. */
+  {
+    gchar *state = ncm_rng_get_state (test->rng);
+
+    g_assert_cmpstr (state, ==, master_state);
+    g_free (state);
+  }
+
+  /* Substreams depend only on the master key, not on the master counter or on the order. */
+  for (i = 0; i < TEST_NCM_RNG_NDRAWS; i++)
+    gsl_rng_get (test->rng->r);
+
+  {
+    NcmRNG *sub = ncm_rng_new (NCM_RNG_PHILOX4X32_NAME);
+
+    for (k = nsub; k > 0; k--)
+    {
+      ncm_rng_substream_set (test->rng, sub, k - 1);
+      for (i = 0; i < 32; i++)
+        g_assert_cmpuint (gsl_rng_get (sub->r), ==, draws[k - 1][i]);
+    }
+
+    NCM_TEST_FREE (ncm_rng_free, sub);
+  }
+
+  /* Different substreams and the master stream are different sequences. */
+  {
+    NcmRNG *master = ncm_rng_new (NCM_RNG_PHILOX4X32_NAME);
+
+    ncm_rng_set_state (master, master_state);
+    for (i = 0; i < 32; i++)
+    {
+      const gulong m = gsl_rng_get (master->r);
+
+      for (k = 0; k < nsub; k++)
+      {
+        guint l;
+
+        g_assert_cmpuint (draws[k][i], !=, m);
+        for (l = k + 1; l < nsub; l++)
+          g_assert_cmpuint (draws[k][i], !=, draws[l][i]);
+      }
+    }
+
+    NCM_TEST_FREE (ncm_rng_free, master);
+  }
+
+  g_free (master_state);
+}
+
+void
+test_ncm_rng_substream_state (TestNcmRNG *test, gconstpointer pdata)
+{
+  const guint64 stream = g_test_rand_int_range (0, G_MAXINT32);
+  NcmRNG *sub          = ncm_rng_substream_new (test->rng, stream);
+  NcmRNG *sub_dup      = ncm_rng_new (NCM_RNG_PHILOX4X32_NAME);
+  gchar *state;
+  guint i;
+
+  for (i = 0; i < 5; i++)
+    gsl_rng_get (sub->r);
+
+  state = ncm_rng_get_state (sub);
+  ncm_rng_set_state (sub_dup, state);
+
+  for (i = 0; i < TEST_NCM_RNG_NDRAWS; i++)
+    g_assert_cmpuint (gsl_rng_get (sub->r), ==, gsl_rng_get (sub_dup->r));
+
+  g_free (state);
+  NCM_TEST_FREE (ncm_rng_free, sub);
+  NCM_TEST_FREE (ncm_rng_free, sub_dup);
+}
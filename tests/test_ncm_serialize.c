@@ -28,6 +28,7 @@
 #undef GSL_RANGE_CHECK_OFF
 #endif /* HAVE_CONFIG_H */
 #include <numcosmo/numcosmo.h>
+#include <glib/gstdio.h>
 
 typedef struct _TestNcmSerialize
 {
@@ -37,6 +38,7 @@ typedef struct _TestNcmSerialize
 static void test_ncm_serialize_new (TestNcmSerialize *test, gconstpointer pdata);
 void test_ncm_serialize_new_noclean_dup (TestNcmSerialize *test, gconstpointer pdata);
 static void test_ncm_serialize_free (TestNcmSerialize *test, gconstpointer pdata);
+static void test_ncm_serialize_mapped_free (TestNcmSerialize *test, gconstpointer pdata);
 
 static void test_ncm_serialize_global_from_string_plain (TestNcmSerialize *test, gconstpointer pdata);
 static void test_ncm_serialize_global_from_string_params (TestNcmSerialize *test, gconstpointer pdata);
@@ -49,6 +51,7 @@ static void test_ncm_serialize_from_string_nest_samename (TestNcmSerialize *test
 
 static void test_ncm_serialize_to_file_from_file (TestNcmSerialize *test, gconstpointer pdata);
 static void test_ncm_serialize_to_binfile_from_binfile (TestNcmSerialize *test, gconstpointer pdata);
+static void test_ncm_serialize_to_mapped_file_from_mapped_file (TestNcmSerialize *test, gconstpointer pdata);
 
 static void test_ncm_serialize_reset_autosave_only (TestNcmSerialize *test, gconstpointer pdata);
 
@@ -107,6 +110,10 @@ main (gint argc, gchar *argv[])
               &test_ncm_serialize_new_noclean_dup,
               &test_ncm_serialize_to_binfile_from_binfile,
               &test_ncm_serialize_free);
+  g_test_add ("/ncm/serialize/to_mapped_file/from_mapped_file", TestNcmSerialize, NULL,
+              &test_ncm_serialize_new_noclean_dup,
+              &test_ncm_serialize_to_mapped_file_from_mapped_file,
+              &test_ncm_serialize_mapped_free);
 
   g_test_add ("/ncm/serialize/traps", TestNcmSerialize, NULL,
               &test_ncm_serialize_new,
@@ -161,6 +168,13 @@ test_ncm_serialize_free (TestNcmSerialize *test, gconstpointer pdata)
   NCM_TEST_FREE (ncm_serialize_free, ser);
 }
 
+void
+test_ncm_serialize_mapped_free (TestNcmSerialize *test, gconstpointer pdata)
+{
+  g_unlink ("test-serialize-mapped.obj");
+  test_ncm_serialize_free (test, pdata);
+}
+
 void
 test_ncm_serialize_global_from_string_plain (TestNcmSerialize *test, gconstpointer pdata)
 {
@@ -467,6 +481,86 @@ test_ncm_serialize_to_binfile_from_binfile (TestNcmSerialize *test, gconstpointe
   }
 }
 
+static void 
+test_ncm_serialize_to_mapped_file_from_mapped_file (TestNcmSerialize *test, gconstpointer pdata)
+{
+  GObject *obj       = ncm_serialize_from_string (test->ser, "NcHICosmoDEXcdm{'w':<-2.0>}");
+  NcHICosmo *hic     = NC_HICOSMO (obj);
+  gchar *obj_ser     = ncm_serialize_to_string (test->ser, obj, TRUE);
+
+  ncm_serialize_to_mapped_file (test->ser, obj, "test-serialize-mapped.obj");
+  g_assert (ncm_serialize_is_mapped_file ("test-serialize-mapped.obj"));
+  
+  {
+    GObject *obj_new   = ncm_serialize_from_file (test->ser, "test-serialize-mapped.obj");
+    gchar *obj_new_ser = ncm_serialize_to_string (test->ser, obj_new, TRUE);
+
+    g_assert (G_OBJECT_TYPE (obj) == G_OBJECT_TYPE (obj_new));
+    g_assert_cmpstr (obj_ser, ==, obj_new_ser);
+    g_free (obj_ser);
+    g_free (obj_new_ser);
+
+    obj_ser     = ncm_serialize_to_string (test->ser, obj, FALSE);
+    obj_new_ser = ncm_serialize_to_string (test->ser, obj_new, FALSE);
+
+    g_assert_cmpstr (obj_ser, ==, obj_new_ser);
+
+    g_free (obj_ser);
+    g_free (obj_new_ser);
+    g_object_unref (obj_new);
+
+    ncm_serialize_clear_instances (test->ser, FALSE);
+
+    NCM_TEST_FREE (nc_hicosmo_free, hic);
+  }
+
+  {
+    NcmMatrix *m = ncm_matrix_new (13, 7);
+    NcmMatrix *m_new;
+    guint i, j;
+
+    for (i = 0; i < 13; i++)
+      for (j = 0; j < 7; j++)
+        ncm_matrix_set (m, i, j, g_test_rand_double ());
+
+    ncm_serialize_to_mapped_file (test->ser, G_OBJECT (m), "test-serialize-mapped.obj");
+
+    /* The file is only read. */
+    g_assert_cmpint (g_chmod ("test-serialize-mapped.obj", 0444), ==, 0);
+    m_new = NCM_MATRIX (ncm_serialize_from_mapped_file (test->ser, "test-serialize-mapped.obj"));
+
+    g_assert_cmpuint (ncm_matrix_nrows (m_new), ==, 13);
+    g_assert_cmpuint (ncm_matrix_ncols (m_new), ==, 7);
+    /* The values must point to the mapped memory. */
+    g_assert (m_new->type == NCM_MATRIX_DERIVED);
+
+    for (i = 0; i < 13; i++)
+      for (j = 0; j < 7; j++)
+        g_assert_cmpfloat (ncm_matrix_get (m_new, i, j), ==, ncm_matrix_get (m, i, j));
+
+    /* The mapping is private, the objects are writable. */
+    ncm_matrix_set (m_new, 0, 0, 1.0);
+    g_assert_cmpfloat (ncm_matrix_get (m_new, 0, 0), ==, 1.0);
+
+    ncm_serialize_clear_instances (test->ser, FALSE);
+
+    /* and the changes never reach the file. */
+    {
+      NcmMatrix *m_new2 = NCM_MATRIX (ncm_serialize_from_mapped_file (test->ser, "test-serialize-mapped.obj"));
+
+      for (i = 0; i < 13; i++)
+        for (j = 0; j < 7; j++)
+          g_assert_cmpfloat (ncm_matrix_get (m_new2, i, j), ==, ncm_matrix_get (m, i, j));
+
+      ncm_serialize_clear_instances (test->ser, FALSE);
+      NCM_TEST_FREE (ncm_matrix_free, m_new2);
+    }
+
+    NCM_TEST_FREE (ncm_matrix_free, m_new);
+    ncm_matrix_free (m);
+  }
+}
+
 void
 test_ncm_serialize_traps (TestNcmSerialize *test, gconstpointer pdata)
 {
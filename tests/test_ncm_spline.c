@@ -136,6 +136,8 @@ void test_ncm_spline_eval (TestNcmSpline *test, gconstpointer pdata);
 void test_ncm_spline_eval_deriv (TestNcmSpline *test, gconstpointer pdata);
 void test_ncm_spline_eval_deriv2 (TestNcmSpline *test, gconstpointer pdata);
 void test_ncm_spline_eval_int (TestNcmSpline *test, gconstpointer pdata);
+void test_ncm_spline_eval_vec (TestNcmSpline *test, gconstpointer pdata);
+void test_ncm_spline_func_batch (TestNcmSpline *test, gconstpointer pdata);
 void test_ncm_spline_free_empty (TestNcmSpline *test, gconstpointer pdata);
 
 void test_ncm_spline_invalid_vector_sizes (TestNcmSpline *test, gconstpointer pdata);
@@ -182,6 +184,8 @@ TestNcmSplineFunc _test_ncm_spline_tests[] = {
   {&test_ncm_spline_eval_deriv,  "/eval/deriv"},
   {&test_ncm_spline_eval_deriv2, "/eval/deriv2"},
   {&test_ncm_spline_eval_int,    "/int"},
+  {&test_ncm_spline_eval_vec,    "/eval/vec"},
+  {&test_ncm_spline_func_batch,  "/func/batch"},
   {&test_ncm_spline_traps,       "/traps"},
   {NULL}
 };
@@ -773,6 +777,104 @@ test_ncm_spline_eval_int (TestNcmSpline *test, gconstpointer pdata)
   }
 }
 
+void
+test_ncm_spline_eval_vec (TestNcmSpline *test, gconstpointer pdata)
+{
+  const guint npoints = 3 * test->nknots;
+  NcmVector *xv       = ncm_vector_new (test->nknots);
+  NcmVector *yv       = ncm_vector_new (test->nknots);
+  NcmVector *x        = ncm_vector_new (npoints);
+  NcmVector *y        = ncm_vector_new (npoints);
+  NcmVector *y_nosort = ncm_vector_new (npoints);
+  NcmSpline *s;
+  GArray *order;
+  gdouble xl, xu;
+  guint i;
+
+  for (i = 0; i < test->nknots; i++)
+  {
+    ncm_vector_set (xv, i, test->xi + test->dx * i);
+    ncm_vector_set (yv, i, F_sin_poly (ncm_vector_get (xv, i), NULL));
+  }
+
+  s  = ncm_spline_new (test->s_base, xv, yv, TRUE);
+  xl = ncm_vector_get (xv, 0);
+  xu = ncm_vector_get (xv, test->nknots - 1);
+
+  /* Unsorted points including the knots, the bounds and repeated values. */
+  for (i = 0; i < npoints; i++)
+  {
+    switch (g_test_rand_int_range (0, 4))
+    {
+      case 0:
+        ncm_vector_set (x, i, ncm_vector_get (xv, g_test_rand_int_range (0, test->nknots)));
+        break;
+      case 1:
+        ncm_vector_set (x, i, (i > 0) ? ncm_vector_get (x, g_test_rand_int_range (0, i)) : xl);
+        break;
+      default:
+        ncm_vector_set (x, i, g_test_rand_double_range (xl, xu));
+        break;
+    }
+  }
+  ncm_vector_set (x, g_test_rand_int_range (0, npoints), xl);
+  ncm_vector_set (x, g_test_rand_int_range (0, npoints), xu);
+
+  order = ncm_vector_get_sort_index (x);
+
+  ncm_spline_eval_vec (s, x, order, y);
+  ncm_spline_eval_vec (s, x, NULL, y_nosort);
+
+  for (i = 0; i < npoints; i++)
+  {
+    const gdouble y_i = ncm_spline_eval (s, ncm_vector_get (x, i));
+
+    ncm_assert_cmpdouble (ncm_vector_get (y, i), ==, y_i);
+    ncm_assert_cmpdouble (ncm_vector_get (y_nosort, i), ==, y_i);
+  }
+
+  g_array_unref (order);
+  ncm_spline_free (s);
+  ncm_vector_free (xv);
+  ncm_vector_free (yv);
+  ncm_vector_free (x);
+  ncm_vector_free (y);
+  ncm_vector_free (y_nosort);
+}
+
+void
+test_ncm_spline_func_batch (TestNcmSpline *test, gconstpointer pdata)
+{
+  const NcmSplineFuncType ftypes[] = {NCM_SPLINE_FUNCTION_SPLINE, NCM_SPLINE_FUNCTION_SPLINE_SINHKNOT};
+  const gdouble xf = test->xi + (test->dx * ((test->nknots)/100.0 - 1)) * _TEST_EPSILON;
+  gsl_function F;
+  guint j;
+
+  F.function = &F_sin_poly;
+  F.params   = NULL;
+
+  for (j = 0; j < G_N_ELEMENTS (ftypes); j++)
+  {
+    NcmSpline *s    = ncm_spline_copy (test->s_base);
+    NcmSpline *s_mt = ncm_spline_copy (test->s_base);
+    guint i;
+
+    ncm_spline_set_func (s, ftypes[j], &F, test->xi, xf, 0, test->prec);
+    ncm_spline_set_func_mt (s_mt, ftypes[j], &F, test->xi, xf, 0, test->prec);
+
+    g_assert_cmpuint (ncm_spline_get_len (s), ==, ncm_spline_get_len (s_mt));
+
+    for (i = 0; i < ncm_spline_get_len (s); i++)
+    {
+      g_assert_cmpfloat (ncm_vector_get (s->xv, i), ==, ncm_vector_get (s_mt->xv, i));
+      g_assert_cmpfloat (ncm_vector_get (s->yv, i), ==, ncm_vector_get (s_mt->yv, i));
+    }
+
+    ncm_spline_free (s);
+    ncm_spline_free (s_mt);
+  }
+}
+
 void
 test_ncm_spline_invalid_vector_sizes (TestNcmSpline *test, gconstpointer pdata)
 {
@@ -55,11 +55,15 @@ void test_ncm_stats_vec_mean_new (TestNcmStatsVec *test, gconstpointer pdata);
 void test_ncm_stats_vec_var_new (TestNcmStatsVec *test, gconstpointer pdata);
 void test_ncm_stats_vec_cov_new (TestNcmStatsVec *test, gconstpointer pdata);
 void test_ncm_stats_vec_autocorr_new (TestNcmStatsVec *test, gconstpointer pdata);
+void test_ncm_stats_vec_online_autocorr_new (TestNcmStatsVec *test, gconstpointer pdata);
+void test_ncm_stats_vec_lag_windows_new (TestNcmStatsVec *test, gconstpointer pdata);
 void test_ncm_stats_vec_mean_test (TestNcmStatsVec *test, gconstpointer pdata);
 void test_ncm_stats_vec_var_test (TestNcmStatsVec *test, gconstpointer pdata);
 void test_ncm_stats_vec_cov_test (TestNcmStatsVec *test, gconstpointer pdata);
 void test_ncm_stats_vec_autocorr_test (TestNcmStatsVec *test, gconstpointer pdata);
 void test_ncm_stats_vec_subsample_autocorr_test (TestNcmStatsVec *test, gconstpointer pdata);
+void test_ncm_stats_vec_online_autocorr_test (TestNcmStatsVec *test, gconstpointer pdata);
+void test_ncm_stats_vec_lag_windows_diag_test (TestNcmStatsVec *test, gconstpointer pdata);
 void test_ncm_stats_vec_free (TestNcmStatsVec *test, gconstpointer pdata);
 
 void test_ncm_stats_vec_traps (TestNcmStatsVec *test, gconstpointer pdata);
@@ -95,6 +99,14 @@ main (gint argc, gchar *argv[])
               &test_ncm_stats_vec_autocorr_new, 
               &test_ncm_stats_vec_subsample_autocorr_test, 
               &test_ncm_stats_vec_free);
+  g_test_add ("/ncm/stats_vec/online_autocorr", TestNcmStatsVec, NULL, 
+              &test_ncm_stats_vec_online_autocorr_new, 
+              &test_ncm_stats_vec_online_autocorr_test, 
+              &test_ncm_stats_vec_free);
+  g_test_add ("/ncm/stats_vec/lag_windows/diag", TestNcmStatsVec, NULL, 
+              &test_ncm_stats_vec_lag_windows_new, 
+              &test_ncm_stats_vec_lag_windows_diag_test, 
+              &test_ncm_stats_vec_free);
   
 #if GLIB_CHECK_VERSION(2,38,0)
   g_test_add ("/ncm/stats_vec/mean/get_var/subprocess", TestNcmStatsVec, NULL, 
@@ -171,6 +183,36 @@ test_ncm_stats_vec_autocorr_new (TestNcmStatsVec *test, gconstpointer pdata)
   g_assert (NCM_IS_STATS_VEC (test->svec));
 }
 
+void
+test_ncm_stats_vec_online_autocorr_new (TestNcmStatsVec *test, gconstpointer pdata)
+{
+  test->v_size = g_test_rand_int_range (_TEST_NCM_VECTOR_MIN_SIZE, _TEST_NCM_VECTOR_STATIC_SIZE);
+  test->ntests = g_test_rand_int_range (_TEST_NCM_STATS_VEC_NTEST_MIN, _TEST_NCM_STATS_VEC_NTEST_MAX) * 100;
+  test->svec   = ncm_stats_vec_new (test->v_size, NCM_STATS_VEC_VAR, FALSE);
+  test->xs     = NULL;
+  test->mu     = ncm_vector_new (test->v_size);
+  test->w      = NULL;
+
+  ncm_stats_vec_enable_lag_windows (test->svec, 64, 0);
+
+  g_assert (NCM_IS_STATS_VEC (test->svec));
+  g_assert (ncm_stats_vec_has_lag_windows (test->svec));
+}
+
+void
+test_ncm_stats_vec_lag_windows_new (TestNcmStatsVec *test, gconstpointer pdata)
+{
+  /* 2^16 rows, the default windows start at the multiples of 2^12. */
+  test->v_size = g_test_rand_int_range (2, 5);
+  test->ntests = 1 << 16;
+  test->svec   = ncm_stats_vec_new (test->v_size, NCM_STATS_VEC_VAR, TRUE);
+  test->xs     = NULL;
+  test->mu     = ncm_vector_new (test->v_size);
+  test->w      = NULL;
+
+  g_assert (NCM_IS_STATS_VEC (test->svec));
+}
+
 void
 test_ncm_stats_vec_free (TestNcmStatsVec *test, gconstpointer pdata)
 {
@@ -455,6 +497,166 @@ test_ncm_stats_vec_subsample_autocorr_test (TestNcmStatsVec *test, gconstpointer
   ncm_matrix_free (last);
 }
 
+void
+test_ncm_stats_vec_online_autocorr_test (TestNcmStatsVec *test, gconstpointer pdata)
+{
+  NcmRNG *rng = ncm_rng_pool_get ("test_ncm_stats_vec");
+  const gdouble a = 0.9 + fabs (g_test_rand_double ()) * 1.0e-2;
+  const gdouble sigma = fabs (g_test_rand_double ()) * 1.0e-1 + 1.0e-2;
+  const gdouble tau = (1.0 + a) / (1.0 - a);
+  NcmVector *last = ncm_vector_new (test->v_size);
+  guint i;
+
+  for (i = 0; i < test->v_size; i++)
+  {
+    ncm_vector_set (test->mu, i, 1.0 + fabs (g_test_rand_double ()));
+    ncm_vector_set (last, i, ncm_vector_get (test->mu, i) / (1.0 - a));
+  }
+
+  for (i = 0; i < test->ntests; i++)
+  {  
+    guint j;
+    for (j = 0; j < test->v_size; j++)
+    {
+      const gdouble epsilon_j = ncm_vector_get (test->mu, j) + sigma * gsl_ran_ugaussian (rng->r);
+      const gdouble x_j       = (a * ncm_vector_get (last, j) + epsilon_j);
+
+      ncm_vector_set (last, j, x_j);
+      ncm_stats_vec_set (test->svec, j, x_j);
+    }
+    ncm_stats_vec_update (test->svec);
+  }
+
+  for (i = 0; i < test->v_size; i++)
+  {
+    {
+      NcmVector *ac = ncm_stats_vec_get_autocorr (test->svec, i);
+      guint j;
+
+      g_assert_cmpuint (ncm_vector_len (ac), ==, 65);
+      for (j = 0; j < 10; j++)
+      {
+        ncm_assert_cmpdouble_e (ncm_vector_get (ac, j), ==, pow (a, j), 1.0e-1, 0.0);
+      }
+      ncm_vector_free (ac);
+    }
+
+    {
+      gdouble spec0   = 0.0;
+      guint c_order   = 0;
+      const gdouble ess = ncm_stats_vec_ar_ess (test->svec, i, NCM_STATS_VEC_AR_AICC, &spec0, &c_order);
+
+      ncm_assert_cmpdouble_e (ncm_stats_vec_get_autocorr_tau (test->svec, i, 0), ==, tau, 2.0e-1, 0.0);
+      ncm_assert_cmpdouble_e (ncm_stats_vec_get_batch_means_tau (test->svec, i), ==, tau, 2.0e-1, 0.0);
+      ncm_assert_cmpdouble_e (test->ntests / ess, ==, tau, 2.0e-1, 0.0);
+    }
+  }
+  
+  ncm_vector_free (last);
+}
+
+void
+test_ncm_stats_vec_lag_windows_diag_test (TestNcmStatsVec *test, gconstpointer pdata)
+{
+  NcmRNG *rng          = ncm_rng_pool_get ("test_ncm_stats_vec");
+  const gdouble a      = 0.9 + fabs (g_test_rand_double ()) * 1.0e-2;
+  const gdouble sigma  = fabs (g_test_rand_double ()) * 1.0e-1 + 1.0e-2;
+  const gdouble sd     = sigma / sqrt (1.0 - a * a);
+  const gdouble tau    = (1.0 + a) / (1.0 - a);
+  const guint burnin   = test->ntests / 4;
+  NcmVector *last      = ncm_vector_new (test->v_size);
+  NcmVector *ess_chunk, *ess_lag, *pvals_chunk, *pvals_lag;
+  gint bindex_chunk, bindex_lag, hbindex_chunk, hbindex_lag;
+  guint wp_chunk, wp_lag, wp_order_chunk, wp_order_lag;
+  gdouble wp_ess_chunk, wp_ess_lag, wp_pvalue_chunk, wp_pvalue_lag;
+  guint i;
+
+  for (i = 0; i < test->v_size; i++)
+  {
+    ncm_vector_set (test->mu, i, 1.0 + fabs (g_test_rand_double ()));
+    ncm_vector_set (last, i, ncm_vector_get (test->mu, i) / (1.0 - a));
+  }
+
+  /* Stationary AR(1) chain shifted by 50 sd during the first quarter. */
+  for (i = 0; i < test->ntests; i++)
+  {  
+    const gdouble shift = (i < burnin) ? 50.0 * sd : 0.0;
+    guint j;
+
+    for (j = 0; j < test->v_size; j++)
+    {
+      const gdouble epsilon_j = ncm_vector_get (test->mu, j) + sigma * gsl_ran_ugaussian (rng->r);
+      const gdouble x_j       = (a * ncm_vector_get (last, j) + epsilon_j);
+
+      ncm_vector_set (last, j, x_j);
+      ncm_stats_vec_set (test->svec, j, x_j + shift);
+    }
+    ncm_stats_vec_update (test->svec);
+  }
+
+  ess_chunk   = ncm_stats_vec_max_ess_time (test->svec, 0, &bindex_chunk, &wp_chunk, &wp_order_chunk, &wp_ess_chunk);
+  pvals_chunk = ncm_stats_vec_heidel_diag (test->svec, 0, 0.0, &hbindex_chunk, &wp_chunk, &wp_order_chunk, &wp_pvalue_chunk);
+
+  ncm_stats_vec_enable_lag_windows (test->svec, 64, 0);
+  g_assert (ncm_stats_vec_has_lag_windows (test->svec));
+
+  ess_lag   = ncm_stats_vec_max_ess_time (test->svec, 0, &bindex_lag, &wp_lag, &wp_order_lag, &wp_ess_lag);
+  pvals_lag = ncm_stats_vec_heidel_diag (test->svec, 0, 0.0, &hbindex_lag, &wp_lag, &wp_order_lag, &wp_pvalue_lag);
+
+  /* 
+   * Both searches must discard the shifted rows, the candidates differ
+   * (tenths of the chain vs. window starts), so the ESS are compared
+   * against the AR(1) value for the rows left.
+   */
+  g_assert_cmpint (bindex_chunk, >=, burnin);
+  g_assert_cmpint (bindex_lag, >=, burnin);
+  g_assert_cmpint (bindex_chunk, <, test->ntests / 2);
+  g_assert_cmpint (bindex_lag, <, test->ntests / 2);
+
+  for (i = 0; i < test->v_size; i++)
+  {
+    ncm_assert_cmpdouble_e (ncm_vector_get (ess_chunk, i), ==, (test->ntests - bindex_chunk) / tau, 2.0e-1, 0.0);
+    ncm_assert_cmpdouble_e (ncm_vector_get (ess_lag, i), ==, (test->ntests - bindex_lag) / tau, 2.0e-1, 0.0);
+  }
+
+  /* The window ESS must match the one computed from the saved rows. */
+  {
+    NcmStatsVec *chunk = ncm_stats_vec_new (test->v_size, NCM_STATS_VEC_VAR, TRUE);
+
+    for (i = bindex_lag; i < test->ntests; i++)
+      ncm_stats_vec_append (chunk, ncm_stats_vec_peek_row (test->svec, i), FALSE);
+
+    for (i = 0; i < test->v_size; i++)
+    {
+      gdouble spec0 = 0.0;
+      guint c_order = 0;
+      const gdouble ess = ncm_stats_vec_ar_ess (chunk, i, NCM_STATS_VEC_AR_AICC, &spec0, &c_order);
+
+      ncm_assert_cmpdouble_e (ncm_vector_get (ess_lag, i), ==, ess, 1.0e-6, 0.0);
+    }
+
+    ncm_stats_vec_clear (&chunk);
+  }
+
+  /* 
+   * The window closest to the middle starts exactly at the middle, hence 
+   * the spectral densities and the diagnostic must agree.
+   */
+  g_assert_cmpint (hbindex_lag, ==, hbindex_chunk);
+  g_assert_cmpuint (wp_lag, ==, wp_chunk);
+  g_assert_cmpuint (wp_order_lag, ==, wp_order_chunk);
+  g_assert (hbindex_chunk == -1 || hbindex_chunk >= burnin);
+
+  for (i = 0; i < test->v_size; i++)
+    ncm_assert_cmpdouble_e (ncm_vector_get (pvals_lag, i), ==, ncm_vector_get (pvals_chunk, i), 1.0e-6, 1.0e-10);
+
+  ncm_vector_free (ess_chunk);
+  ncm_vector_free (ess_lag);
+  ncm_vector_free (pvals_chunk);
+  ncm_vector_free (pvals_lag);
+  ncm_vector_free (last);
+}
+
 void
 test_ncm_stats_vec_invalid_get_var (TestNcmStatsVec *test, gconstpointer pdata)
 {
@@ -62,6 +62,7 @@ void test_ncm_vector_operations (TestNcmVector *test, gconstpointer pdata);
 void test_ncm_vector_subvector (TestNcmVector *test, gconstpointer pdata);
 void test_ncm_vector_variant (TestNcmVector *test, gconstpointer pdata);
 void test_ncm_vector_serialization (TestNcmVector *test, gconstpointer pdata);
+void test_ncm_vector_sort_index (TestNcmVector *test, gconstpointer pdata);
 void test_ncm_vector_data_const_sanity (TestNcmVector *test, gconstpointer pdata);
 
 gint
@@ -98,6 +99,11 @@ main (gint argc, gchar *argv[])
               &test_ncm_vector_serialization,
               &test_ncm_vector_free);
 
+  g_test_add ("/ncm/vector/default/sort_index", TestNcmVector, NULL, 
+              &test_ncm_vector_new, 
+              &test_ncm_vector_sort_index,
+              &test_ncm_vector_free);
+
   /* GSL vector allocation */
 
   g_test_add ("/ncm/vector/gsl/sanity", TestNcmVector, NULL, 
@@ -125,6 +131,11 @@ main (gint argc, gchar *argv[])
               &test_ncm_vector_serialization,
               &test_ncm_vector_gsl_free);
 
+  g_test_add ("/ncm/vector/gsl/sort_index", TestNcmVector, NULL, 
+              &test_ncm_vector_gsl_new, 
+              &test_ncm_vector_sort_index,
+              &test_ncm_vector_gsl_free);
+
   /* Array vector allocation */
 
   g_test_add ("/ncm/vector/array/sanity", TestNcmVector, NULL, 
@@ -566,6 +577,74 @@ test_ncm_vector_subvector (TestNcmVector *test, gconstpointer pdata)
   NCM_TEST_FREE (ncm_vector_free, sv);
 }
 
+static void
+_test_ncm_vector_assert_sort_index (NcmVector *v)
+{
+  const guint len   = ncm_vector_len (v);
+  GArray *order     = ncm_vector_get_sort_index (v);
+  gboolean *visited = g_new0 (gboolean, len);
+  guint i;
+
+  g_assert_cmpuint (order->len, ==, len);
+
+  for (i = 0; i < len; i++)
+  {
+    const guint p_i = g_array_index (order, guint, i);
+
+    g_assert_cmpuint (p_i, <, len);
+    g_assert (!visited[p_i]);
+    visited[p_i] = TRUE;
+
+    if (i > 0)
+      g_assert_cmpfloat (ncm_vector_get (v, g_array_index (order, guint, i - 1)), <=, ncm_vector_get (v, p_i));
+  }
+
+  g_free (visited);
+  g_array_unref (order);
+}
+
+void
+test_ncm_vector_sort_index (TestNcmVector *test, gconstpointer pdata)
+{
+  NcmVector *v = test->v;
+  guint i;
+
+  /* Unsorted input with repeated values. */
+  _test_ncm_vector_assert_sort_index (v);
+
+  for (i = 0; i < test->v_size / 2; i++)
+    ncm_vector_set (v, g_test_rand_int_range (0, test->v_size), ncm_vector_get (v, g_test_rand_int_range (0, test->v_size)));
+  _test_ncm_vector_assert_sort_index (v);
+
+  /* Sorted and reversed input. */
+  for (i = 0; i < test->v_size; i++)
+    ncm_vector_set (v, i, test->v_size - i);
+  _test_ncm_vector_assert_sort_index (v);
+  {
+    GArray *order = ncm_vector_get_sort_index (v);
+
+    for (i = 0; i < test->v_size; i++)
+      g_assert_cmpuint (g_array_index (order, guint, i), ==, test->v_size - 1 - i);
+    g_array_unref (order);
+  }
+
+  /* Non-unitary stride. */
+  {
+    NcmMatrix *m = ncm_matrix_new (test->v_size, 3);
+    NcmVector *c;
+
+    for (i = 0; i < test->v_size * 3; i++)
+      ncm_matrix_data (m)[i] = g_test_rand_double ();
+
+    c = ncm_matrix_get_col (m, 1);
+    g_assert_cmpuint (ncm_vector_stride (c), ==, 3);
+    _test_ncm_vector_assert_sort_index (c);
+
+    ncm_vector_free (c);
+    ncm_matrix_free (m);
+  }
+}
+
 void
 test_ncm_vector_variant (TestNcmVector *test, gconstpointer pdata)
 {
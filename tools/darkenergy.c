@@ -931,6 +931,8 @@ main (gint argc, gchar *argv[])
 
     if (de_fit.mc_nthreads > 1)
       ncm_fit_esmcmc_set_nthreads (esmcmc, de_fit.mc_nthreads);
+    if (de_fit.mc_nprocs > 1)
+      ncm_fit_esmcmc_set_nprocs (esmcmc, de_fit.mc_nprocs);
     
     if (de_fit.fisher)
     {
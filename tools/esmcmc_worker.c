@@ -0,0 +1,76 @@
+/***************************************************************************
+ *            esmcmc_worker.c
+ *
+ *  Sun October 18 23:12:40 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * esmcmc_worker.c
+ *
+ * Copyright (C) 2026 - Sandro Dias Pinto Vitenti
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Worker process launched by NcmFitESMCMC when the number of processes is
+ * larger than one, see ncm_fit_esmcmc_set_nprocs().
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+gint
+main (gint argc, gchar *argv[])
+{
+  gint fd = -1;
+
+  GError *error = NULL;
+  GOptionContext *context;
+  GOptionEntry entries[] =
+  {
+    { "fd", 'f', 0, G_OPTION_ARG_INT, &fd, "Socket file descriptor connected to the master process.", NULL },
+    { NULL }
+  };
+
+  ncm_cfg_init ();
+
+  context = g_option_context_new ("- NcmFitESMCMC worker process.");
+  g_option_context_set_summary (context, "ensemble sampler worker");
+  g_option_context_set_description (context,
+                                    "This program is launched by NcmFitESMCMC, it should not be run directly.");
+
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+  {
+    g_print ("option parsing failed: %s\n", error->message);
+    exit (1);
+  }
+
+  if (fd < 0)
+  {
+    g_print ("The socket file descriptor is required, use --fd/-f.\n");
+    exit (1);
+  }
+
+  ncm_fit_esmcmc_proc_worker (fd);
+
+  g_option_context_free (context);
+
+  return 0;
+}
@@ -96,6 +96,7 @@ main (gint argc, gchar *argv[])
   gint nsteps = 100;
   gint burnin = 0;
   gint ntests = 100;
+  gint nthreads = 0;
   gchar **funcs          = NULL;
   gchar **distribs       = NULL;
   gchar **dist_tab       = NULL;
@@ -142,6 +143,7 @@ main (gint argc, gchar *argv[])
     { "dump",           'D', 0, G_OPTION_ARG_NONE,         &dump,           "Print all chains interweaved.", NULL },
     { "dump-chain",       0, 0, G_OPTION_ARG_INT,          &dump_chain,     "Print all points from the N-th chain.", "N"},
     { "trim",           't', 0, G_OPTION_ARG_INT,          &trim,           "Trim the catalog at T.", "T" },
+    { "nthreads",         0, 0, G_OPTION_ARG_INT,          &nthreads,       "Number of threads used to evaluate the functions over the catalog (default 0, serial).", "N" },
     { NULL }
   };
 
@@ -225,6 +227,9 @@ main (gint argc, gchar *argv[])
     NcmMSetCatalog *mcat = ncm_mset_catalog_new_from_file_ro (cat_filename, burnin);
     NcmMSet *mset = ncm_mset_catalog_get_mset (mcat);
 
+    if (nthreads > 1)
+      ncm_mset_catalog_set_nthreads (mcat, nthreads);
+
     if (auto_trim)
     {
       ncm_mset_catalog_trim_by_type (mcat, ntests, NCM_MSET_CATALOG_TRIM_TYPE_ESS, NCM_FIT_RUN_MSGS_FULL);
@@ -484,7 +489,6 @@ main (gint argc, gchar *argv[])
       NcDistance *dist           = nc_distance_new (zf + 0.2);
       GPtrArray *mset_func_array = g_ptr_array_new ();
       GString *header            = g_string_new (NULL);
-      guint max_dim              = 0;
 
       g_ptr_array_set_free_func (mset_func_array, (GDestroyNotify) ncm_mset_func_free);
       g_string_append_printf (header, "#");
@@ -542,7 +546,6 @@ main (gint argc, gchar *argv[])
         }
 
         dim     = ncm_mset_func_get_dim (mset_func);
-        max_dim = GSL_MAX (max_dim, dim);
         g_ptr_array_add (mset_func_array, mset_func);
 
         for (j = 0; j < dim; j++)
@@ -554,33 +557,51 @@ main (gint argc, gchar *argv[])
       g_message ("%s\n", header->str);
 
       {
-        const guint cat_len = ncm_mset_catalog_len (mcat);
-        NcmVector *res_v    = ncm_vector_new (max_dim);
-        guint i;
-        
-        for (i = 0; i < cat_len; i++)
+        const guint cat_len   = ncm_mset_catalog_len (mcat);
+        const guint block_len = 1024 * 16;
+        GPtrArray *res_array  = g_ptr_array_new_with_free_func ((GDestroyNotify) ncm_matrix_free);
+        GPtrArray *fe_array   = g_ptr_array_new_with_free_func ((GDestroyNotify) ncm_mset_catalog_func_eval_free);
+        guint bi;
+
+        for (i = 0; i < mset_func_array->len; i++)
+          g_ptr_array_add (fe_array, ncm_mset_catalog_func_eval_new (mcat, g_ptr_array_index (mset_func_array, i), NULL));
+
+        for (bi = 0; bi < cat_len; bi += block_len)
         {
-          NcmVector *row = ncm_mset_catalog_peek_row (mcat, i);
-          guint j;
-          
-          ncm_mset_fparams_set_vector_offset (mcat->mset, row, mcat->nadd_vals);
+          const guint nrows = GSL_MIN (block_len, cat_len - bi);
+          guint i;
 
-          g_message (" ");
-          for (j = 0; j < mset_func_array->len; j++)
+          g_ptr_array_set_size (res_array, 0);
+          for (i = 0; i < mset_func_array->len; i++)
           {
-            NcmMSetFunc *mset_func = g_ptr_array_index (mset_func_array, j);
-            const guint dim        = ncm_mset_func_get_dim (mset_func);
-            guint k;
+            NcmMSetFunc *mset_func = g_ptr_array_index (mset_func_array, i);
+            NcmMatrix *res         = ncm_matrix_new (nrows, ncm_mset_func_get_dim (mset_func));
 
-            ncm_mset_func_eval (mset_func, mcat->mset, NULL, ncm_vector_data (res_v));
-            for (k = 0; k < dim; k++)
+            ncm_mset_catalog_func_eval_rows (g_ptr_array_index (fe_array, i), bi, res);
+            g_ptr_array_add (res_array, res);
+          }
+
+          for (i = 0; i < nrows; i++)
+          {
+            guint j;
+
+            g_message (" ");
+            for (j = 0; j < res_array->len; j++)
             {
-              g_message (" % 22.15g", ncm_vector_get (res_v, k));
+              NcmMatrix *res = g_ptr_array_index (res_array, j);
+              guint k;
+
+              for (k = 0; k < ncm_matrix_ncols (res); k++)
+              {
+                g_message (" % 22.15g", ncm_matrix_get (res, i, k));
+              }
             }
+            g_message ("\n");
           }
-          g_message ("\n");
         }
 
+        g_ptr_array_unref (res_array);
+        g_ptr_array_unref (fe_array);
       }
       
       nc_distance_clear (&dist);
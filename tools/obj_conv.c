@@ -0,0 +1,105 @@
+/***************************************************************************
+ *            obj_conv.c
+ *
+ *  Sun October 18 14:02:21 2026
+ *  Copyright  2026  Sandro Dias Pinto Vitenti
+ *  <sandro@isoftware.com.br>
+ ****************************************************************************/
+/*
+ * obj_conv.c
+ *
+ * Copyright (C) 2026 - Sandro Dias Pinto Vitenti
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif /* HAVE_CONFIG_H */
+#include <numcosmo/numcosmo.h>
+
+gint
+main (gint argc, gchar *argv[])
+{
+  gchar *in        = NULL;
+  gchar *out       = NULL;
+  gchar *to        = NULL;
+  gboolean in_bin  = FALSE;
+  
+  GError *error = NULL;
+  GOptionContext *context;
+  GOptionEntry entries[] =
+  {
+    { "in",            'i', 0, G_OPTION_ARG_FILENAME, &in,     "Input object file.", NULL },
+    { "binary-input",  'b', 0, G_OPTION_ARG_NONE,     &in_bin, "Input is a raw binary file (ncm_serialize_to_binfile).", NULL },
+    { "out",           'o', 0, G_OPTION_ARG_FILENAME, &out,    "Output object file.", NULL },
+    { "to",            't', 0, G_OPTION_ARG_STRING,   &to,     "Output format: text, binary or mapped (default mapped).", NULL },
+    { NULL }
+  };
+
+  ncm_cfg_init ();
+  
+  context = g_option_context_new ("- convert serialized objects between the NumCosmo formats.");
+  g_option_context_set_summary (context, "object converter");
+  g_option_context_set_description (context, 
+                                    "Mapped containers are detected automatically, text and raw binary\n"
+                                    "inputs are distinguished using --binary-input.");
+
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+  {
+    g_print ("option parsing failed: %s\n", error->message);
+    exit (1);
+  }
+
+  if ((in == NULL) || (out == NULL))
+  {
+    g_print ("Input and output files are required, use --in/-i and --out/-o.\n");
+    exit (1);
+  }
+  else
+  {
+    NcmSerialize *ser = ncm_serialize_new (NCM_SERIALIZE_OPT_CLEAN_DUP);
+    GObject *obj;
+
+    if (ncm_serialize_is_mapped_file (in))
+      obj = ncm_serialize_from_mapped_file (ser, in);
+    else if (in_bin)
+      obj = ncm_serialize_from_binfile (ser, in);
+    else
+      obj = ncm_serialize_from_file (ser, in);
+
+    ncm_serialize_reset (ser, TRUE);
+
+    if ((to == NULL) || (strcmp (to, "mapped") == 0))
+      ncm_serialize_to_mapped_file (ser, obj, out);
+    else if (strcmp (to, "binary") == 0)
+      ncm_serialize_to_binfile (ser, obj, out);
+    else if (strcmp (to, "text") == 0)
+      ncm_serialize_to_file (ser, obj, out);
+    else
+    {
+      g_print ("Unknown output format `%s', use text, binary or mapped.\n", to);
+      exit (1);
+    }
+
+    g_object_unref (obj);
+    ncm_serialize_free (ser);
+  }
+
+  g_option_context_free (context);
+
+  return 0;
+}